@@ -0,0 +1,144 @@
+%srsChannelImpairments Native timing offset, frequency offset and AWGN impairments.
+%   User-friendly interface to a C++ impairment stage, which is wrapped by the
+%   MEX static method channel_impairments_mex. The stage delays the waveform,
+%   rotates it according to a carrier frequency offset and adds white Gaussian
+%   noise, in this order. The noise of each port is drawn from an independent
+%   stream, so that ports are processed in parallel and the result does not
+%   depend on the number of threads nor on the MATLAB global random generator.
+%
+%   IMPAIR = srsChannelImpairments creates an impairment stage object, IMPAIR.
+%
+%   IMPAIR = srsChannelImpairments(NAME, VALUE, ...) creates an impairment stage
+%   object with properties (see below) set according to the NAME-VALUE pairs.
+%
+%   srsChannelImpairments Methods:
+%
+%   step    - Applies the impairments to a waveform.
+%   reset   - Resets the time, the delay line and the noise generators.
+%   reseed  - Resets the impairment stage with a new seed.
+%
+%   Step method syntax
+%
+%   OUTWAVEFORM = step(IMPAIR, INWAVEFORM, NOISEVAR) applies the impairments to
+%   the waveform INWAVEFORM (one column per port) and returns the impaired waveform
+%   OUTWAVEFORM, of the same size. NOISEVAR is the variance of the complex noise
+%   samples, either a scalar or a row with one value for each port. The stage keeps
+%   the time, the delay line and the state of the noise generators between calls,
+%   so that a long waveform can be processed in blocks (e.g., one slot at a time).
+%
+%   srsChannelImpairments properties (nontunable):
+%
+%   SampleRate              - Sampling rate in hertz.
+%   CarrierFrequencyOffset  - Carrier frequency offset in hertz.
+%   TimingOffset            - Timing offset (delay) in samples, possibly fractional.
+%   Seed                    - Seed of the noise generators.
+%   NumThreads              - Number of worker threads (0, default, for as many as hardware threads).
+%
+%   Fractional timing offsets are implemented by a causal windowed-sinc filter
+%   with 8 taps on each side: they are accurate for offsets larger than 8 samples.
+%
+%   See also srsMEX.channel.srsFadingChannel.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
+
+classdef srsChannelImpairments < matlab.System
+    properties (Nontunable)
+        %Sampling rate in hertz.
+        SampleRate (1, 1) double {mustBeReal, mustBePositive} = 30.72e6
+        %Carrier frequency offset in hertz.
+        CarrierFrequencyOffset (1, 1) double {mustBeReal} = 0
+        %Timing offset (delay) in samples, possibly fractional.
+        TimingOffset (1, 1) double {mustBeReal, mustBeNonnegative} = 0
+        %Seed of the noise generators.
+        Seed (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
+        %Number of worker threads (0 for as many as hardware threads).
+        NumThreads (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
+    end % of properties (Nontunable)
+
+    properties (Access = private)
+        %Unique identifier of the impairment stage inside the MEX function.
+        ImpairmentsID (1, 1) uint64 = 0
+    end % of properties (Access = private)
+
+    methods
+        function obj = srsChannelImpairments(varargin)
+        %Constructor: sets nontunable properties.
+            setProperties(obj, nargin, varargin{:});
+        end
+
+        function reseed(obj, seed)
+        %Resets the impairment stage with a new seed.
+        %   reseed(IMPAIR, SEED) resets the time and the delay line of IMPAIR and restarts
+        %   the noise generators from SEED. The Seed property is not modified. The
+        %   object must be locked, i.e., it must have processed at least one waveform.
+            arguments
+                obj  (1, 1) srsMEX.channel.srsChannelImpairments
+                seed (1, 1) double {mustBeInteger, mustBeNonnegative}
+            end
+
+            assert(isLocked(obj), 'srsran_matlab:srsChannelImpairments', ...
+                'The object must be locked before it can be reseeded.');
+            obj.channel_impairments_mex('reset', obj.ImpairmentsID, seed);
+        end % of function reseed(obj, seed)
+    end % of public methods
+
+    methods (Access = protected)
+        function setupImpl(obj, inWaveform, ~)
+        %Creates the impairment stage inside the MEX function, with as many ports as waveform columns.
+            config = struct( ...
+                'NumPorts', size(inWaveform, 2), ...
+                'SampleRate', obj.SampleRate, ...
+                'CarrierFrequencyOffset', obj.CarrierFrequencyOffset, ...
+                'TimingOffset', obj.TimingOffset, ...
+                'Seed', obj.Seed, ...
+                'NumThreads', obj.NumThreads);
+            obj.ImpairmentsID = obj.channel_impairments_mex('new', config);
+        end % of function setupImpl(obj, inWaveform, ~)
+
+        function outWaveform = stepImpl(obj, inWaveform, noiseVar)
+            arguments
+                obj        (1, 1) srsMEX.channel.srsChannelImpairments
+                inWaveform (:, :) double
+                noiseVar   (1, :) double {mustBeNonnegative}
+            end
+
+            outWaveform = obj.channel_impairments_mex('step', obj.ImpairmentsID, single(complex(inWaveform)), noiseVar);
+            outWaveform = double(outWaveform);
+        end % of function stepImpl(...)
+
+        function resetImpl(obj)
+        %Resets the time, the delay line and the noise generators.
+            if (obj.ImpairmentsID == 0)
+                return;
+            end
+            obj.channel_impairments_mex('reset', obj.ImpairmentsID, obj.Seed);
+        end % of function resetImpl(obj)
+
+        function releaseImpl(obj)
+        %Releases the impairment stage inside the MEX function.
+            if (obj.ImpairmentsID == 0)
+                return;
+            end
+            obj.channel_impairments_mex('release', obj.ImpairmentsID);
+            obj.ImpairmentsID = 0;
+        end % of function releaseImpl(obj)
+    end % of methods (Access = protected)
+
+    methods (Access = private, Static)
+        %MEX function doing the actual work. See the Doxygen documentation.
+        varargout = channel_impairments_mex(varargin)
+    end % of methods (Access = private, Static)
+end % of classdef srsChannelImpairments < matlab.System
@@ -0,0 +1,305 @@
+%srsFadingChannel Native tapped delay line (TDL) fading channel.
+%   User-friendly interface to a C++ TDL fading channel, which is wrapped by the
+%   MEX static method fading_channel_mex. The object is meant as a faster
+%   replacement of nrTDLChannel in the simulators: it supports the same delay
+%   profiles, Rayleigh fading with Jakes Doppler spectrum generated by a sum of
+%   sinusoids and spatial correlation between antennas (Kronecker model).
+%
+%   CHAN = srsFadingChannel creates a fading channel object, CHAN.
+%
+%   CHAN = srsFadingChannel(NAME, VALUE, ...) creates a fading channel object with
+%   properties (see below) set according to the NAME-VALUE pairs.
+%
+%   srsFadingChannel Methods:
+%
+%   step            - Passes a waveform through the channel.
+%   reset           - Resets the fading time and the filter memory.
+%   reseed          - Resets the channel with a new seed.
+%   info            - Returns information about the channel.
+%   getPathFilters  - Returns the path filters.
+%
+%   Step method syntax
+%
+%   RXWAVEFORM = step(CHAN, TXWAVEFORM) passes the waveform TXWAVEFORM (one column
+%   per transmit antenna) through the channel CHAN and returns the received waveform
+%   RXWAVEFORM (one column per receive antenna). The channel keeps the fading time
+%   and the filter memory between calls, so that a long waveform can be processed
+%   in blocks (e.g., one slot at a time).
+%
+%   [RXWAVEFORM, PATHGAINS, SAMPLETIMES] = step(CHAN, TXWAVEFORM) also returns the
+%   path gain snapshots PATHGAINS (an array of size NCS-by-NP-by-NT-by-NR with NCS
+%   snapshots, NP paths, NT transmit and NR receive antennas) and their sampling
+%   instants SAMPLETIMES (a column vector in seconds). Between snapshots, the path
+%   gains are linearly interpolated. The outputs can be used with
+%   nrPerfectTimingEstimate and nrPerfectChannelEstimate, as those of nrTDLChannel.
+%
+%   srsFadingChannel properties (nontunable):
+%
+%   DelayProfile             - Delay profile ('TDL-A', 'TDL-B', 'TDL-C', 'TDLA30',
+%                              'TDLB100', 'TDLC300', 'custom').
+%   DelaySpread              - Delay spread in seconds ('TDL-A', 'TDL-B', 'TDL-C' only).
+%   PathDelays               - Path delays in seconds ('custom' only).
+%   AveragePathGains         - Average path gains in dB ('custom' only).
+%   MaximumDopplerShift      - Maximum Doppler shift in hertz.
+%   SampleRate               - Sampling rate in hertz.
+%   NumTransmitAntennas      - Number of transmit antennas.
+%   NumReceiveAntennas       - Number of receive antennas.
+%   MIMOCorrelation          - Antenna correlation ('Low', 'Medium', 'High', 'Custom').
+%   TransmitCorrelation      - Correlation between the first and last transmit antennas
+%                              ('Custom' MIMO correlation only).
+%   ReceiveCorrelation       - Correlation between the first and last receive antennas
+%                              ('Custom' MIMO correlation only).
+%   NumSinusoids             - Number of sinusoids of each fading process.
+%   SampleDensity            - Number of path gain snapshots per half period of the
+%                              maximum Doppler shift.
+%   NormalizePathGains       - Flag for normalizing the total power of the average path gains to one.
+%   NormalizeChannelOutputs  - Flag for normalizing the outputs by the number of receive antennas.
+%   Seed                     - Seed of the fading processes.
+%
+%   The 'Low', 'Medium' and 'High' MIMO correlations follow TS38.104 Annex G.2.3
+%   for the uplink: the UE (transmit) and gNB (receive) correlation coefficients
+%   are 0 and 0, 0.3 and 0.9, and 0.9 and 0.9, respectively.
+%
+%   See also nrTDLChannel.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
+
+classdef srsFadingChannel < matlab.System
+    properties (Nontunable)
+        %Delay profile ('TDL-A', 'TDL-B', 'TDL-C', 'TDLA30', 'TDLB100', 'TDLC300', 'custom').
+        DelayProfile (1, :) char {mustBeMember(DelayProfile, {'TDL-A', 'TDL-B', 'TDL-C', ...
+            'TDLA30', 'TDLB100', 'TDLC300', 'custom'})} = 'TDL-A'
+        %Delay spread in seconds ('TDL-A', 'TDL-B', 'TDL-C' only).
+        DelaySpread (1, 1) double {mustBeReal, mustBeNonnegative} = 30e-9
+        %Path delays in seconds ('custom' only).
+        PathDelays (1, :) double {mustBeReal, mustBeNonnegative} = 0
+        %Average path gains in dB ('custom' only).
+        AveragePathGains (1, :) double {mustBeReal} = 0
+        %Maximum Doppler shift in hertz.
+        MaximumDopplerShift (1, 1) double {mustBeReal, mustBeNonnegative} = 5
+        %Sampling rate in hertz.
+        SampleRate (1, 1) double {mustBeReal, mustBePositive} = 30.72e6
+        %Number of transmit antennas.
+        NumTransmitAntennas (1, 1) double {mustBeInteger, mustBePositive} = 1
+        %Number of receive antennas.
+        NumReceiveAntennas (1, 1) double {mustBeInteger, mustBePositive} = 2
+        %Antenna correlation ('Low', 'Medium', 'High', 'Custom').
+        MIMOCorrelation (1, :) char {mustBeMember(MIMOCorrelation, {'Low', 'Medium', 'High', 'Custom'})} = 'Low'
+        %Correlation between the first and last transmit antennas ('Custom' MIMO correlation only).
+        TransmitCorrelation (1, 1) double {mustBeInRange(TransmitCorrelation, 0, 1)} = 0
+        %Correlation between the first and last receive antennas ('Custom' MIMO correlation only).
+        ReceiveCorrelation (1, 1) double {mustBeInRange(ReceiveCorrelation, 0, 1)} = 0
+        %Number of sinusoids of each fading process.
+        NumSinusoids (1, 1) double {mustBeInteger, mustBePositive} = 48
+        %Number of path gain snapshots per half period of the maximum Doppler shift.
+        SampleDensity (1, 1) double {mustBeInteger, mustBePositive} = 64
+        %Flag for normalizing the total power of the average path gains to one.
+        NormalizePathGains (1, 1) logical = true
+        %Flag for normalizing the outputs by the number of receive antennas.
+        NormalizeChannelOutputs (1, 1) logical = true
+        %Seed of the fading processes.
+        Seed (1, 1) double {mustBeInteger, mustBeNonnegative} = 73
+    end % of properties (Nontunable)
+
+    properties (Access = private)
+        %Unique identifier of the channel inside the MEX function.
+        ChannelID (1, 1) uint64 = 0
+    end % of properties (Access = private)
+
+    methods
+        function obj = srsFadingChannel(varargin)
+        %Constructor: sets nontunable properties.
+            setProperties(obj, nargin, varargin{:});
+        end
+
+        function reseed(obj, seed, snrIndex, item, slot)
+        %Resets the channel with a new seed.
+        %   reseed(CHAN, SEED) resets the fading time and the filter memory of CHAN
+        %   and draws new fading processes from SEED. The Seed property is not modified.
+        %
+        %   reseed(CHAN, SEED, SNRINDEX, ITEM, SLOT) draws the new fading processes from
+        %   the random stream identified by SEED, the (0-based) SNR index SNRINDEX, the
+        %   (0-based) item index ITEM (e.g., the frame or the PRACH occasion) and the
+        %   (0-based) slot index SLOT within the item. The stream does not depend on any
+        %   other random generator and it is the same the native simulation engines use
+        %   for the same indices.
+            arguments
+                obj      (1, 1) srsMEX.channel.srsFadingChannel
+                seed     (1, 1) double {mustBeInteger, mustBeNonnegative}
+                snrIndex (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
+                item     (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
+                slot     (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
+            end
+
+            if ~isLocked(obj)
+                setup(obj, zeros(0, obj.NumTransmitAntennas));
+            end
+            if (nargin == 2)
+                obj.fading_channel_mex('reset', obj.ChannelID, seed);
+            else
+                obj.fading_channel_mex('reset', obj.ChannelID, seed, [snrIndex, item, slot]);
+            end
+        end % of function reseed(...)
+
+        function pathFilters = getPathFilters(obj)
+        %Returns the path filters.
+        %   PATHFILTERS = getPathFilters(CHAN) returns the path filters of the channel
+        %   as an NH-by-NP matrix, with NH taps and NP paths.
+            chInfo = info(obj);
+            pathFilters = chInfo.PathFilters.';
+        end % of function getPathFilters(obj)
+    end % of public methods
+
+    methods (Access = protected)
+        function setupImpl(obj)
+        %Creates the channel inside the MEX function.
+            obj.ChannelID = obj.fading_channel_mex('new', obj.createConfiguration);
+        end % of function setupImpl(obj)
+
+        function [rxWaveform, pathGains, sampleTimes] = stepImpl(obj, txWaveform)
+            arguments
+                obj        (1, 1) srsMEX.channel.srsFadingChannel
+                txWaveform (:, :) double
+            end
+
+            assert(size(txWaveform, 2) == obj.NumTransmitAntennas, 'srsran_matlab:srsFadingChannel', ...
+                'The waveform has %d columns, but the channel has %d transmit antennas.', ...
+                size(txWaveform, 2), obj.NumTransmitAntennas);
+
+            if (nargout < 2)
+                rxWaveform = obj.fading_channel_mex('step', obj.ChannelID, single(complex(txWaveform)));
+            elseif (nargout == 2)
+                [rxWaveform, pathGains] = obj.fading_channel_mex('step', obj.ChannelID, single(complex(txWaveform)));
+                pathGains = double(pathGains);
+            else
+                [rxWaveform, pathGains, sampleTimes] = obj.fading_channel_mex('step', obj.ChannelID, ...
+                    single(complex(txWaveform)));
+                pathGains = double(pathGains);
+            end
+            rxWaveform = double(rxWaveform);
+        end % of function stepImpl(...)
+
+        function resetImpl(obj)
+        %Resets the fading time and the filter memory.
+            if (obj.ChannelID == 0)
+                return;
+            end
+            obj.fading_channel_mex('reset', obj.ChannelID, obj.Seed);
+        end % of function resetImpl(obj)
+
+        function releaseImpl(obj)
+        %Releases the channel inside the MEX function.
+            if (obj.ChannelID == 0)
+                return;
+            end
+            obj.fading_channel_mex('release', obj.ChannelID);
+            obj.ChannelID = 0;
+        end % of function releaseImpl(obj)
+
+        function s = infoImpl(obj)
+        %Returns information about the channel.
+        %   The structure has fields PathDelays, AveragePathGains, ChannelFilterDelay,
+        %   MaximumChannelDelay (in samples) and PathFilters (one row per path).
+            if (obj.ChannelID == 0)
+                channelID = obj.fading_channel_mex('new', obj.createConfiguration);
+                s = obj.fading_channel_mex('info', channelID);
+                obj.fading_channel_mex('release', channelID);
+            else
+                s = obj.fading_channel_mex('info', obj.ChannelID);
+            end
+            s.MaximumChannelDelay = ceil(max(s.PathDelays * obj.SampleRate)) + s.ChannelFilterDelay;
+        end % of function infoImpl(obj)
+
+        function flag = isInactivePropertyImpl(obj, property)
+            switch property
+                case 'DelaySpread'
+                    flag = ~ismember(obj.DelayProfile, {'TDL-A', 'TDL-B', 'TDL-C'});
+                case {'PathDelays', 'AveragePathGains'}
+                    flag = ~strcmp(obj.DelayProfile, 'custom');
+                case {'TransmitCorrelation', 'ReceiveCorrelation'}
+                    flag = ~strcmp(obj.MIMOCorrelation, 'Custom');
+                otherwise
+                    flag = false;
+            end
+        end % of function isInactivePropertyImpl(obj, property)
+
+        function validatePropertiesImpl(obj)
+            if strcmp(obj.DelayProfile, 'custom')
+                assert(numel(obj.PathDelays) == numel(obj.AveragePathGains), 'srsran_matlab:srsFadingChannel', ...
+                    'PathDelays and AveragePathGains must have the same number of elements.');
+            end
+        end % of function validatePropertiesImpl(obj)
+
+        function s = saveObjectImpl(obj)
+        % Save all public properties.
+        % Note: The state of the channel lives inside the MEX, only the configuration is saved.
+            s = saveObjectImpl@matlab.System(obj);
+        end
+
+        function loadObjectImpl(obj, s, wasInUse)
+        % Loads an srsFadingChannel object from a file.
+        % Note: Only the configuration is saved. If the object was saved in the locked state,
+        % the loaded channel starts again from time zero.
+            loadObjectImpl@matlab.System(obj, s, wasInUse);
+
+            if wasInUse
+                setupImpl(obj);
+            end
+        end
+    end % of methods (Access = protected)
+
+    methods (Access = private)
+        function config = createConfiguration(obj)
+        %Creates the configuration structure for the MEX function.
+            switch obj.MIMOCorrelation
+                case 'Low'
+                    txCorr = 0;
+                    rxCorr = 0;
+                case 'Medium'
+                    txCorr = 0.3;
+                    rxCorr = 0.9;
+                case 'High'
+                    txCorr = 0.9;
+                    rxCorr = 0.9;
+                otherwise
+                    txCorr = obj.TransmitCorrelation;
+                    rxCorr = obj.ReceiveCorrelation;
+            end
+
+            config = struct( ...
+                'DelayProfile', obj.DelayProfile, ...
+                'DelaySpread', obj.DelaySpread, ...
+                'PathDelays', obj.PathDelays, ...
+                'AveragePathGains', obj.AveragePathGains, ...
+                'MaximumDopplerShift', obj.MaximumDopplerShift, ...
+                'SampleRate', obj.SampleRate, ...
+                'NumTransmitAntennas', obj.NumTransmitAntennas, ...
+                'NumReceiveAntennas', obj.NumReceiveAntennas, ...
+                'TransmitCorrelation', txCorr, ...
+                'ReceiveCorrelation', rxCorr, ...
+                'NumSinusoids', obj.NumSinusoids, ...
+                'SampleDensity', obj.SampleDensity, ...
+                'NormalizePathGains', obj.NormalizePathGains, ...
+                'NormalizeChannelOutputs', obj.NormalizeChannelOutputs, ...
+                'Seed', obj.Seed);
+        end % of function createConfiguration(obj)
+    end % of methods (Access = private)
+
+    methods (Access = private, Static)
+        %MEX function doing the actual work. See the Doxygen documentation.
+        varargout = fading_channel_mex(varargin)
+    end % of methods (Access = private, Static)
+end % of classdef srsFadingChannel < matlab.System
@@ -0,0 +1,105 @@
+%srsChannelEqualizer MATLAB interface to srsRAN channel equalizer.
+%   User-friendly interface to the srsRAN channel equalizer class, which is wrapped
+%   by the MEX static method channel_equalizer_mex.
+%
+%   EQUALIZER = srsChannelEqualizer creates a PHY channel equalizer object.
+%
+%   EQUALIZER = srsChannelEqualizer(NAME, VALUE, ...) creates a PHY channel equalizer
+%   object with properties (see below) set according to the NAME-VALUE pairs.
+%
+%   srsChannelEqualizer Methods:
+%
+%   step  - Equalizes a set of resource elements.
+%
+%   Step method syntax
+%
+%   [EQSYMBOLS, EQNOISEVARS] = step(EQUALIZER, RXSYMBOLS, CHESTS, NOISEVAR, TXSCALING)
+%   uses the object EQUALIZER to equalize the received symbols RXSYMBOLS (an
+%   array of REs by Rx ports) given the channel estimates CHESTS (an array of REs by
+%   Rx ports by Tx layers), the noise variance NOISEVAR (either a scalar or a vector
+%   with one entry per Rx port) and the scaling factor TXSCALING applied to the
+%   transmitted symbols (default is 1). The REs can be any set of resource elements
+%   (not necessarily contiguous) sharing the same noise variance. The equalized
+%   symbols EQSYMBOLS and the post-equalization noise variances EQNOISEVARS are
+%   arrays of REs by Tx layers.
+%
+%   srsChannelEqualizer properties (nontunable):
+%
+%   EqualizerType  - Equalization algorithm ('MMSE', 'ZF').
+%
+%   See also srsLib.phy.upper.equalization.srsChannelEqualizer.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
+
+classdef srsChannelEqualizer < matlab.System
+    properties (Nontunable)
+        %Equalization algorithm ('MMSE', 'ZF').
+        EqualizerType (1, :) char {mustBeMember(EqualizerType, {'MMSE', 'ZF'})} = 'MMSE'
+    end
+
+    methods
+        function obj = srsChannelEqualizer(varargin)
+        %Constructor: sets nontunable properties.
+            setProperties(obj, nargin, varargin{:});
+        end
+    end % of public methods
+
+    methods (Access = protected)
+        function setupImpl(obj)
+        %Creates the channel equalizer inside the MEX function.
+            obj.channel_equalizer_mex('new', obj.EqualizerType);
+        end % of function setupImpl(obj)
+
+        function [eqSymbols, eqNoiseVars] = stepImpl(obj, rxSymbols, chEsts, noiseVar, txScaling)
+            arguments
+                obj       (1, 1)    srsMEX.phy.srsChannelEqualizer
+                rxSymbols (:, :)    double {mustBeNumeric}
+                chEsts    (:, :, :) double {mustBeNumeric}
+                noiseVar  (:, 1)    double {mustBePositive}
+                txScaling (1, 1)    double {mustBePositive} = 1
+            end
+
+            [nRE, nRxPorts] = size(rxSymbols);
+            nLayers = size(chEsts, 3);
+            assert((size(chEsts, 1) == nRE) && (size(chEsts, 2) == nRxPorts), 'srsran_matlab:srsChannelEqualizer', ...
+                'The channel estimates size [%s] does not match the received symbols size [%d, %d].', ...
+                num2str(size(chEsts)), nRE, nRxPorts);
+            assert(nLayers <= 4, 'srsran_matlab:srsChannelEqualizer', ...
+                'Currently, max 4 layers supported, provided %d.', nLayers);
+            assert(nRxPorts <= 8, 'srsran_matlab:srsChannelEqualizer', ...
+                'Currently, max 8 Rx ports supported, provided %d.', nRxPorts);
+
+            if isscalar(noiseVar)
+                noiseVar = noiseVar * ones(nRxPorts, 1);
+            end
+            assert(numel(noiseVar) == nRxPorts, 'srsran_matlab:srsChannelEqualizer', ...
+                'The number of noise variances, %d, does not match the number of Rx ports, %d.', ...
+                numel(noiseVar), nRxPorts);
+
+            [eqSymbolsS, eqNoiseVarsS] = obj.channel_equalizer_mex('step', single(rxSymbols), single(chEsts), ...
+                single(noiseVar), single(txScaling));
+
+            % The MEX returns the symbols interleaved by layer.
+            eqSymbols = double(eqSymbolsS.');
+            eqNoiseVars = double(eqNoiseVarsS.');
+        end % of function stepImpl(...)
+    end % of methods (Access = protected)
+
+    methods (Access = private, Static)
+        %MEX function doing the actual work. See the Doxygen documentation.
+        varargout = channel_equalizer_mex(varargin)
+    end % of methods (Access = private, Static)
+end % of classdef srsChannelEqualizer < matlab.System
@@ -0,0 +1,85 @@
+%srsDemodulationMapper MATLAB interface to srsRAN demodulation mapper.
+%   User-friendly interface to the srsRAN demodulation mapper class, which is
+%   wrapped by the MEX static method demodulation_mapper_mex. Long sequences of
+%   symbols are split into blocks that are demodulated in parallel.
+%
+%   DEMAPPER = srsDemodulationMapper creates a PHY demodulation mapper object.
+%
+%   DEMAPPER = srsDemodulationMapper(NAME, VALUE, ...) creates a PHY demodulation
+%   mapper object with properties (see below) set according to the NAME-VALUE pairs.
+%
+%   srsDemodulationMapper Methods:
+%
+%   step  - Computes the log-likelihood ratios of a sequence of symbols.
+%
+%   Step method syntax
+%
+%   LLRS = step(DEMAPPER, SYMBOLS, MODULATION, NOISEVAR) uses the object DEMAPPER
+%   to compute the log-likelihood ratios LLRS of the equalized symbols SYMBOLS
+%   (an array of complex values) modulated with MODULATION (one of 'BPSK',
+%   'pi/2-BPSK', 'QPSK', '16QAM', '64QAM' and '256QAM'). NOISEVAR is either an
+%   array with the noise variance of each symbol (same number of elements as
+%   SYMBOLS) or a scalar if all symbols have the same noise variance. LLRS is a
+%   column vector of int8 with the saturated, quantized log-likelihood ratios,
+%   equivalent to those returned by srsDemodulator(SYMBOLS, MODULATION, NOISEVAR).
+%
+%   srsDemodulationMapper properties (nontunable):
+%
+%   NumThreads  - Number of worker threads (0, default, for as many as hardware threads).
+%
+%   See also srsLib.phy.upper.channel_modulation.srsDemodulator.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
+
+classdef srsDemodulationMapper < matlab.System
+    properties (Nontunable)
+        %Number of worker threads (0 for as many as hardware threads).
+        NumThreads (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
+    end
+
+    methods
+        function obj = srsDemodulationMapper(varargin)
+        %Constructor: sets nontunable properties.
+            setProperties(obj, nargin, varargin{:});
+        end
+    end % of public methods
+
+    methods (Access = protected)
+        function setupImpl(obj)
+        %Creates the pool of demodulation mappers inside the MEX function.
+            obj.demodulation_mapper_mex('new', obj.NumThreads);
+        end % of function setupImpl(obj)
+
+        function llrs = stepImpl(obj, symbols, modulation, noiseVar)
+            arguments
+                obj        (1, 1) srsMEX.phy.srsDemodulationMapper
+                symbols    {mustBeNumeric}
+                modulation (1, :) char {mustBeMember(modulation, {'BPSK', 'pi/2-BPSK', 'QPSK', '16QAM', '64QAM', '256QAM'})}
+                noiseVar   {mustBeNumeric, mustBePositive}
+            end
+
+            assert(isscalar(noiseVar) || (numel(noiseVar) == numel(symbols)), 'srsran_matlab:srsDemodulationMapper', ...
+                'The noise variance must be a scalar or have one entry for each symbol.');
+
+            llrs = obj.demodulation_mapper_mex('step', single(complex(symbols(:))), single(noiseVar(:)), modulation);
+        end % of function stepImpl(...)
+    end % of methods (Access = protected)
+
+    methods (Access = private, Static)
+        %MEX function doing the actual work. See the Doxygen documentation.
+        varargout = demodulation_mapper_mex(varargin)
+    end % of methods (Access = private, Static)
+end % of classdef srsDemodulationMapper < matlab.System
@@ -0,0 +1,196 @@
+%srsNZPCSIRSGenerator MATLAB interface to srsRAN NZP-CSI-RS generator.
+%   User-friendly interface to the srsRAN NZP-CSI-RS generator class, which is
+%   wrapped by the MEX static method nzp_csi_rs_generator_mex. All the resources of
+%   a CSI-RS resource set, whatever their number of ports, density and CDM type, are
+%   mapped into the same resource grid with one call. The object also returns the
+%   resource elements occupied by each resource as a bitmap, which can be used as a
+%   reserved-RE pattern.
+%
+%   CSIRSGEN = srsNZPCSIRSGenerator creates a PHY NZP-CSI-RS generator object.
+%
+%   CSIRSGEN = srsNZPCSIRSGenerator(NAME, VALUE, ...) creates a PHY NZP-CSI-RS
+%   generator object with properties (see below) set according to the NAME-VALUE
+%   pairs.
+%
+%   srsNZPCSIRSGenerator Methods:
+%
+%   step  - Maps a set of CSI-RS resources into a resource grid.
+%
+%   Step method syntax
+%
+%   [TXGRID, RESERVED] = step(CSIRSGEN, CARRIER, CSIRS) uses the object CSIRSGEN to
+%   map the CSI-RS resources described by CSIRS into the resource grid TXGRID, a
+%   complex array spanning the slot CARRIER.NSlot of the carrier (dimensions are
+%   subcarriers, OFDM symbols and antenna ports, as many as the maximum number of
+%   CSI-RS ports of the resources). CARRIER is an nrCarrierConfig object and CSIRS
+%   is either an nrCSIRSConfig object, possibly describing multiple resources, or a
+%   cell array of nrCSIRSConfig objects. As in nrCSIRS, zero-power resources and
+%   resources that are not active in the slot are not mapped, and the ports of each
+%   resource are mapped onto the first ports of TXGRID. Overlapping resources are
+%   superimposed.
+%
+%   RESERVED is a logical array with the resource elements occupied by each CSI-RS
+%   resource, zero-power ones included, on any of its ports (dimensions are
+%   subcarriers, OFDM symbols and resources). Resources that are not active in the
+%   slot do not occupy any resource element.
+%
+%   srsNZPCSIRSGenerator properties (nontunable):
+%
+%   Amplitude   - Amplitude of the CSI-RS symbols (default 1).
+%   NumThreads  - Number of worker threads (0, default, for as many as hardware threads).
+%
+%   See also nrCSIRS, nrCSIRSIndices, nrCSIRSConfig, srsLib.phy.upper.signal_processors.srsCSIRSnzp,
+%   srsLib.phy.helpers.srsCSIRS2ReservedCell.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
+
+classdef srsNZPCSIRSGenerator < matlab.System
+    properties (Nontunable)
+        %Amplitude of the CSI-RS symbols.
+        Amplitude  (1, 1) double {mustBeReal, mustBePositive, mustBeFinite} = 1
+        %Number of worker threads (0 for as many as hardware threads).
+        NumThreads (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
+    end
+
+    methods
+        function obj = srsNZPCSIRSGenerator(varargin)
+        %Constructor: sets nontunable properties.
+            setProperties(obj, nargin, varargin{:});
+        end
+    end % of public methods
+
+    methods (Access = protected)
+        function setupImpl(obj)
+        %Creates the pool of NZP-CSI-RS generators inside the MEX function.
+            obj.nzp_csi_rs_generator_mex('new', obj.NumThreads);
+        end % of function setupImpl(obj)
+
+        function [txGrid, reserved] = stepImpl(obj, carrier, csirs)
+            arguments
+                obj     (1, 1) srsMEX.phy.srsNZPCSIRSGenerator
+                carrier (1, 1) nrCarrierConfig
+                csirs
+            end
+
+            if ~iscell(csirs)
+                csirs = {csirs};
+            end
+
+            % Flatten the list of resources.
+            resources = {};
+            for iConfig = 1:numel(csirs)
+                assert(isa(csirs{iConfig}, 'nrCSIRSConfig'), 'srsran_matlab:srsNZPCSIRSGenerator', ...
+                    'CSI-RS configurations must be nrCSIRSConfig objects.');
+                resources = [resources; obj.splitResources(carrier, csirs{iConfig})]; %#ok<AGROW>
+            end
+
+            nResources = numel(resources);
+            isActive = cellfun(@(r) r.IsActive, resources);
+            nPorts = max(cellfun(@(r) r.Config.NumCSIRSPorts, resources));
+            nSubcarriers = carrier.NSizeGrid * 12;
+
+            % The MEX grid starts at CRB 0, so that the sequences are indexed as in TS38.211.
+            firstSubcarrier = carrier.NStartGrid * 12;
+            gridConfig = struct( ...
+                'NSizeGrid', carrier.NStartGrid + carrier.NSizeGrid, ...
+                'CyclicPrefix', carrier.CyclicPrefix, ...
+                'NumPorts', nPorts);
+
+            txGrid = complex(zeros(nSubcarriers, carrier.SymbolsPerSlot, nPorts, 'single'));
+            reserved = false(nSubcarriers, carrier.SymbolsPerSlot, nResources);
+            if ~any(isActive)
+                return;
+            end
+
+            activeConfigs = cellfun(@(r) r.Config, resources(isActive), 'UniformOutput', false);
+            activeConfigs = vertcat(activeConfigs{:});
+            for iResource = 1:numel(activeConfigs)
+                activeConfigs(iResource).RBOffset = activeConfigs(iResource).RBOffset + carrier.NStartGrid;
+                activeConfigs(iResource).Amplitude = obj.Amplitude;
+            end
+
+            subcarriers = firstSubcarrier + (1:nSubcarriers);
+            if nargout < 2
+                txGridCRB0 = obj.nzp_csi_rs_generator_mex('step', gridConfig, activeConfigs);
+            else
+                [txGridCRB0, reservedCRB0] = obj.nzp_csi_rs_generator_mex('step', gridConfig, activeConfigs);
+                reserved(:, :, isActive) = reservedCRB0(subcarriers, :, :);
+            end
+            txGrid = txGridCRB0(subcarriers, :, :);
+        end % of function stepImpl(...)
+
+        function nOut = getNumOutputsImpl(~)
+            nOut = 2;
+        end
+    end % of methods (Access = protected)
+
+    methods (Access = private, Static)
+        function resources = splitResources(carrier, csirs)
+        %Splits an nrCSIRSConfig object into a cell array of single-resource MEX configurations.
+            nResources = numel(csirs.RowNumber);
+            resources = cell(nResources, 1);
+            for iResource = 1:nResources
+                % Vector properties have one entry per resource, while the periodicity and the locations of
+                % multiple resources are given as cell arrays.
+                getValue = @(value) srsMEX.phy.srsNZPCSIRSGenerator.getResourceValue(value, iResource, nResources);
+                getCellValue = @(value) srsMEX.phy.srsNZPCSIRSGenerator.getResourceValue(value, iResource, 1);
+
+                % CSI-RS occasions, TS38.211 Section 7.4.1.5.3.
+                period = getCellValue(csirs.CSIRSPeriod);
+                if ischar(period) || isstring(period)
+                    isActive = strcmp(period, 'on');
+                else
+                    isActive = (mod(carrier.SlotsPerFrame * carrier.NFrame + carrier.NSlot - period(2), period(1)) == 0);
+                end
+
+                symbolLocations = getCellValue(csirs.SymbolLocations);
+                subcarrierLocations = getCellValue(csirs.SubcarrierLocations);
+
+                config = struct( ...
+                    'SubcarrierSpacing', carrier.SubcarrierSpacing, ...
+                    'NFrame', mod(carrier.NFrame, 1024), ...
+                    'NSlot', mod(carrier.NSlot, carrier.SlotsPerFrame), ...
+                    'RowNumber', getValue(csirs.RowNumber), ...
+                    'NumCSIRSPorts', getValue(csirs.NumCSIRSPorts), ...
+                    'Density', getValue(csirs.Density), ...
+                    'CDMType', getValue(csirs.CDMType), ...
+                    'SubcarrierLocations', double(subcarrierLocations(:)), ...
+                    'SymbolLocations', double(symbolLocations(:)), ...
+                    'RBOffset', getValue(csirs.RBOffset), ...
+                    'NumRB', getValue(csirs.NumRB), ...
+                    'NID', getValue(csirs.NID), ...
+                    'Amplitude', 1, ...
+                    'ZeroPower', double(strcmp(getValue(csirs.CSIRSType), 'zp')));
+
+                resources{iResource} = struct('Config', config, 'IsActive', isActive);
+            end
+        end % of function resources = splitResources(carrier, csirs)
+
+        function value = getResourceValue(values, iResource, nResources)
+        %Returns the value of a property for the given resource.
+            if iscell(values)
+                value = values{iResource};
+            elseif (nResources > 1) && (numel(values) == nResources)
+                value = values(iResource);
+            else
+                value = values;
+            end
+        end
+
+        %MEX function doing the actual work. See the Doxygen documentation.
+        varargout = nzp_csi_rs_generator_mex(varargin)
+    end % of methods (Access = private, Static)
+end % of classdef srsNZPCSIRSGenerator < matlab.System
@@ -0,0 +1,206 @@
+%srsPDCCHProcessor MATLAB interface to srsRAN PDCCH processor.
+%   User-friendly interface to the srsRAN PDCCH processor class, which is wrapped
+%   by the MEX static method pdcch_processor_mex. Multiple DCI messages are
+%   encoded, modulated and mapped into the same resource grid in parallel with one
+%   call. The class also computes the PDCCH candidates of a search space for a large
+%   number of UEs at once, which is what PDCCH blocking studies need.
+%
+%   PDCCHPROC = srsPDCCHProcessor creates a PHY PDCCH processor object.
+%
+%   PDCCHPROC = srsPDCCHProcessor(NAME, VALUE, ...) creates a PHY PDCCH processor
+%   object with properties (see below) set according to the NAME-VALUE pairs.
+%
+%   srsPDCCHProcessor Methods:
+%
+%   step           - Encodes, modulates and maps a list of DCI messages.
+%   getCandidates  - Computes the PDCCH candidates of a list of UEs (static).
+%
+%   Step method syntax
+%
+%   TXGRID = step(PDCCHPROC, CARRIER, PDCCH, DCIBITS) uses the object PDCCHPROC to
+%   encode the DCI payload DCIBITS, a column vector of (unpacked) bits, and to map
+%   the resulting PDCCH transmission, DM-RS included, into the resource grid TXGRID,
+%   a single-port complex array (dimensions are subcarriers and OFDM symbols).
+%   CARRIER is an nrCarrierConfig object, with the grid assumed to start at CRB 0,
+%   and PDCCH is an nrPDCCHConfig object. The PDCCH candidate is selected by the
+%   properties AggregationLevel and AllocatedCandidate of PDCCH. As in nrPDCCH, the
+%   data and DM-RS are scrambled with PDCCH.DMRSScramblingID and PDCCH.RNTI if the
+%   scrambling identity is set, with the cell identity and a zero RNTI otherwise.
+%
+%   To map several DCI messages into the same grid, PDCCH and DCIBITS are cell
+%   arrays with one entry for each message. Messages allocated to overlapping CCEs
+%   are superimposed.
+%
+%   CANDIDATES = srsPDCCHProcessor.getCandidates(CARRIER, CORESET, SEARCHSPACE, RNTI)
+%   returns the lowest CCE index of the PDCCH candidates of search space SEARCHSPACE
+%   (an nrSearchSpaceConfig object) in CORESET (an nrCORESETConfig object) for the
+%   slot CARRIER.NSlot and for all the UEs in the array RNTI. CANDIDATES is a cell
+%   array with one entry for each aggregation level (1, 2, 4, 8 and 16). Each entry
+%   is a uint32 array with as many rows as candidates for the aggregation level and
+%   one column for each RNTI.
+%
+%   srsPDCCHProcessor properties (nontunable):
+%
+%   NumThreads       - Number of worker threads (0, default, for as many as hardware threads).
+%   DMRSPowerOffset  - DM-RS power offset in dB (default 0).
+%   DataPowerOffset  - Data power offset in dB (default 0).
+%
+%   See also nrDCIEncode, nrPDCCH, nrPDCCHResources, nrPDCCHSpace.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
+
+classdef srsPDCCHProcessor < matlab.System
+    properties (Nontunable)
+        %Number of worker threads (0 for as many as hardware threads).
+        NumThreads      (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
+        %DM-RS power offset in dB.
+        DMRSPowerOffset (1, 1) double {mustBeReal, mustBeFinite} = 0
+        %Data power offset in dB.
+        DataPowerOffset (1, 1) double {mustBeReal, mustBeFinite} = 0
+    end
+
+    methods
+        function obj = srsPDCCHProcessor(varargin)
+        %Constructor: sets nontunable properties.
+            setProperties(obj, nargin, varargin{:});
+        end
+    end % of public methods
+
+    methods (Static)
+        function candidates = getCandidates(carrier, coreset, searchSpace, rnti)
+        %Computes the PDCCH candidates of a list of UEs.
+            arguments
+                carrier     (1, 1) nrCarrierConfig
+                coreset     (1, 1) nrCORESETConfig
+                searchSpace (1, 1) nrSearchSpaceConfig
+                rnti        (:, 1) double {mustBeInteger, mustBeInRange(rnti, 0, 65535)}
+            end
+
+            searchSpaceConfig = struct( ...
+                'NumCCEs', coreset.NCCE, ...
+                'NumCandidates', searchSpace.NumCandidates, ...
+                'SearchSpaceType', searchSpace.SearchSpaceType, ...
+                'CORESETID', coreset.CORESETID, ...
+                'NSlot', mod(carrier.NSlot, carrier.SlotsPerFrame));
+
+            candidates = srsMEX.phy.srsPDCCHProcessor.pdcch_processor_mex('candidates', searchSpaceConfig, rnti);
+        end % of function candidates = getCandidates(carrier, coreset, searchSpace, rnti)
+    end % of methods (Static)
+
+    methods (Access = protected)
+        function setupImpl(obj)
+        %Creates the pool of PDCCH processors inside the MEX function.
+            obj.pdcch_processor_mex('new', obj.NumThreads);
+        end % of function setupImpl(obj)
+
+        function txGrid = stepImpl(obj, carrier, pdcch, dciBits)
+            arguments
+                obj     (1, 1) srsMEX.phy.srsPDCCHProcessor
+                carrier (1, 1) nrCarrierConfig
+                pdcch
+                dciBits
+            end
+
+            if ~iscell(pdcch)
+                pdcch = {pdcch};
+            end
+            if ~iscell(dciBits)
+                dciBits = {dciBits};
+            end
+
+            nDCI = numel(pdcch);
+            assert(numel(dciBits) == nDCI, 'srsran_matlab:srsPDCCHProcessor', ...
+                'The number of PDCCH configurations and DCI payloads must match.');
+
+            payloads = cell(nDCI, 1);
+            pdcchConfigs = cell(nDCI, 1);
+            for iDCI = 1:nDCI
+                pdcchCfg = pdcch{iDCI};
+                assert(isa(pdcchCfg, 'nrPDCCHConfig'), 'srsran_matlab:srsPDCCHProcessor', ...
+                    'PDCCH configurations must be nrPDCCHConfig objects.');
+
+                coreset = pdcchCfg.CORESET;
+                searchSpace = pdcchCfg.SearchSpace;
+
+                % Select the lowest CCE of the allocated candidate.
+                iAL = log2(pdcchCfg.AggregationLevel) + 1;
+                candidates = obj.getCandidates(carrier, coreset, searchSpace, pdcchCfg.RNTI);
+                assert(pdcchCfg.AllocatedCandidate <= numel(candidates{iAL}), 'srsran_matlab:srsPDCCHProcessor', ...
+                    'The allocated candidate, %d, is not in the search space (PDCCH %d).', ...
+                    pdcchCfg.AllocatedCandidate, iDCI);
+                cceIndex = double(candidates{iAL}(pdcchCfg.AllocatedCandidate));
+
+                [nStartBWP, nSizeBWP] = obj.getBWP(carrier, pdcchCfg);
+
+                % Scrambling identities, TS38.211 Sections 7.3.2.3 and 7.4.1.3.1.
+                if isempty(pdcchCfg.DMRSScramblingID)
+                    nID = carrier.NCellID;
+                    nRNTI = 0;
+                else
+                    nID = pdcchCfg.DMRSScramblingID;
+                    nRNTI = pdcchCfg.RNTI;
+                end
+
+                pdcchConfigs{iDCI} = struct( ...
+                    'SubcarrierSpacing', carrier.SubcarrierSpacing, ...
+                    'NSlot', mod(carrier.NSlot, carrier.SlotsPerFrame), ...
+                    'NSizeBWP', nSizeBWP, ...
+                    'NStartBWP', nStartBWP, ...
+                    'StartSymbolIndex', searchSpace.StartSymbolWithinSlot, ...
+                    'Duration', coreset.Duration, ...
+                    'FrequencyResources', logical(coreset.FrequencyResources(:)), ...
+                    'CCEREGMapping', coreset.CCEREGMapping, ...
+                    'REGBundleSize', coreset.REGBundleSize, ...
+                    'InterleaverSize', coreset.InterleaverSize, ...
+                    'ShiftIndex', coreset.ShiftIndex, ...
+                    'RNTI', pdcchCfg.RNTI, ...
+                    'NIDDMRS', nID, ...
+                    'NIDData', nID, ...
+                    'NRNTI', nRNTI, ...
+                    'CCEIndex', cceIndex, ...
+                    'AggregationLevel', pdcchCfg.AggregationLevel, ...
+                    'DMRSPowerOffset', obj.DMRSPowerOffset, ...
+                    'DataPowerOffset', obj.DataPowerOffset);
+
+                payloads{iDCI} = uint8(dciBits{iDCI}(:));
+            end
+
+            gridConfig = struct( ...
+                'NSizeGrid', carrier.NSizeGrid, ...
+                'CyclicPrefix', carrier.CyclicPrefix, ...
+                'NumPorts', 1);
+
+            txGrid = obj.pdcch_processor_mex('step', gridConfig, payloads, vertcat(pdcchConfigs{:}));
+        end % of function stepImpl(...)
+    end % of methods (Access = protected)
+
+    methods (Access = private, Static)
+        function [nStartBWP, nSizeBWP] = getBWP(carrier, pdcch)
+        %Returns the BWP of the PDCCH (the carrier grid if not configured).
+            nStartBWP = pdcch.NStartBWP;
+            nSizeBWP = pdcch.NSizeBWP;
+            if isempty(nStartBWP)
+                nStartBWP = carrier.NStartGrid;
+            end
+            if isempty(nSizeBWP)
+                nSizeBWP = carrier.NSizeGrid;
+            end
+        end
+
+        %MEX function doing the actual work. See the Doxygen documentation.
+        varargout = pdcch_processor_mex(varargin)
+    end % of methods (Access = private, Static)
+end % of classdef srsPDCCHProcessor < matlab.System
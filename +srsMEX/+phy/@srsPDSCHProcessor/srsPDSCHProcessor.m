@@ -0,0 +1,195 @@
+%srsPDSCHProcessor MATLAB interface to srsRAN PDSCH processor.
+%   User-friendly interface to the srsRAN PDSCH processor class, which is wrapped
+%   by the MEX static method pdsch_processor_mex. Multiple PDSCH transmissions are
+%   encoded, modulated and mapped into the same resource grid in parallel with one
+%   call.
+%
+%   PDSCHPROC = srsPDSCHProcessor creates a PHY PDSCH processor object.
+%
+%   PDSCHPROC = srsPDSCHProcessor(NAME, VALUE, ...) creates a PHY PDSCH processor
+%   object with properties (see below) set according to the NAME-VALUE pairs.
+%
+%   srsPDSCHProcessor Methods:
+%
+%   step  - Encodes, modulates and maps a list of PDSCH transmissions.
+%
+%   Step method syntax
+%
+%   TXGRID = step(PDSCHPROC, CARRIER, PDSCH, TRBLK, TARGETCODERATE, RV) uses the object
+%   PDSCHPROC to encode the transport block TRBLK, a column vector of (unpacked) bits,
+%   and to map the resulting PDSCH transmission, DM-RS included, into the resource
+%   grid TXGRID. TXGRID is a three-dimensional complex array (dimensions are
+%   subcarriers, OFDM symbols and antenna ports), where layer i is mapped onto port i.
+%   CARRIER is an nrCarrierConfig object, with the grid assumed to start at CRB 0,
+%   PDSCH is an nrPDSCHConfig object (with contiguous PRBSet), TARGETCODERATE is the
+%   target code rate (used to select the LDPC base graph) and RV is the redundancy
+%   version.
+%
+%   To map several PDSCH transmissions into the same grid, PDSCH and TRBLK are cell
+%   arrays with one entry for each transmission, while TARGETCODERATE and RV are
+%   numeric arrays with one entry for each transmission. The PDSCH transmissions must
+%   not overlap.
+%
+%   srsPDSCHProcessor properties (nontunable):
+%
+%   NumThreads       - Number of worker threads (0, default, for as many as hardware threads).
+%   DMRSPowerOffset  - DM-RS power offset in dB (default 0).
+%   DataPowerOffset  - Data power offset in dB (default 0).
+%
+%   See also nrDLSCH, nrPDSCH, nrPDSCHDMRS.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
+
+classdef srsPDSCHProcessor < matlab.System
+    properties (Nontunable)
+        %Number of worker threads (0 for as many as hardware threads).
+        NumThreads      (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
+        %DM-RS power offset in dB.
+        DMRSPowerOffset (1, 1) double {mustBeReal, mustBeFinite} = 0
+        %Data power offset in dB.
+        DataPowerOffset (1, 1) double {mustBeReal, mustBeFinite} = 0
+    end
+
+    properties (Constant, Hidden)
+        %Transport block size for limited buffer rate matching, in bytes.
+        TBSLBRM = nrTBS('256QAM', 4, 273, 156, 948 / 1024) / 8
+    end
+
+    methods
+        function obj = srsPDSCHProcessor(varargin)
+        %Constructor: sets nontunable properties.
+            setProperties(obj, nargin, varargin{:});
+        end
+    end % of public methods
+
+    methods (Access = protected)
+        function setupImpl(obj)
+        %Creates the pool of PDSCH processors inside the MEX function.
+            obj.pdsch_processor_mex('new', obj.NumThreads);
+        end % of function setupImpl(obj)
+
+        function txGrid = stepImpl(obj, carrier, pdsch, trBlk, targetCodeRate, rv)
+            arguments
+                obj            (1, 1) srsMEX.phy.srsPDSCHProcessor
+                carrier        (1, 1) nrCarrierConfig
+                pdsch
+                trBlk
+                targetCodeRate (:, 1) double {mustBeInRange(targetCodeRate, 0, 1, 'exclusive')}
+                rv             (:, 1) double {mustBeMember(rv, [0, 1, 2, 3])}
+            end
+
+            if ~iscell(pdsch)
+                pdsch = {pdsch};
+            end
+            if ~iscell(trBlk)
+                trBlk = {trBlk};
+            end
+
+            nPDSCH = numel(pdsch);
+            assert((numel(trBlk) == nPDSCH) && (numel(targetCodeRate) == nPDSCH) && (numel(rv) == nPDSCH), ...
+                'srsran_matlab:srsPDSCHProcessor', ...
+                'The number of PDSCH configurations, transport blocks, target code rates and RVs must match.');
+
+            trBlkPacked = cell(nPDSCH, 1);
+            pdschConfigs = cell(nPDSCH, 1);
+            for iPDSCH = 1:nPDSCH
+                pdschCfg = pdsch{iPDSCH};
+                assert(isa(pdschCfg, 'nrPDSCHConfig'), 'srsran_matlab:srsPDSCHProcessor', ...
+                    'PDSCH configurations must be nrPDSCHConfig objects.');
+                assert(all(diff(pdschCfg.PRBSet) == 1), 'srsran_matlab:srsPDSCHProcessor', ...
+                    'Only contiguous PRB allocations are supported (PDSCH %d).', iPDSCH);
+                assert(mod(numel(trBlk{iPDSCH}), 8) == 0, 'srsran_matlab:srsPDSCHProcessor', ...
+                    'The transport block size, %d, is not a multiple of 8 (PDSCH %d).', numel(trBlk{iPDSCH}), iPDSCH);
+
+                % Generate a DM-RS symbol mask.
+                dmrsIndices = nrPDSCHDMRSIndices(carrier, pdschCfg, 'IndexStyle', 'subscript', 'IndexBase', '0based');
+                dmrsSymbolMask = false(carrier.SymbolsPerSlot, 1);
+                dmrsSymbolMask(unique(dmrsIndices(:, 2)) + 1) = true;
+
+                dlschInfo = nrDLSCHInfo(numel(trBlk{iPDSCH}), targetCodeRate(iPDSCH));
+
+                [nStartBWP, nSizeBWP] = obj.getBWP(carrier, pdschCfg);
+
+                pdschConfigs{iPDSCH} = struct( ...
+                    'SubcarrierSpacing', carrier.SubcarrierSpacing, ...
+                    'NSlot', mod(carrier.NSlot, carrier.SlotsPerFrame), ...
+                    'RNTI', pdschCfg.RNTI, ...
+                    'NSizeBWP', nSizeBWP, ...
+                    'NStartBWP', nStartBWP, ...
+                    'Modulation', pdschCfg.Modulation, ...
+                    'RV', rv(iPDSCH), ...
+                    'NID', obj.getScramblingID(carrier, pdschCfg), ...
+                    'DMRSReferencePoint', pdschCfg.DMRS.DMRSReferencePoint, ...
+                    'DMRSSymbPos', dmrsSymbolMask, ...
+                    'DMRSConfigType', pdschCfg.DMRS.DMRSConfigurationType, ...
+                    'NIDNSCID', obj.getDMRSScramblingID(carrier, pdschCfg), ...
+                    'NSCID', pdschCfg.DMRS.NSCID, ...
+                    'NumCDMGroupsWithoutData', pdschCfg.DMRS.NumCDMGroupsWithoutData, ...
+                    'PRBStart', pdschCfg.PRBSet(1), ...
+                    'NumPRB', numel(pdschCfg.PRBSet), ...
+                    'StartSymbolIndex', pdschCfg.SymbolAllocation(1), ...
+                    'NumSymbols', pdschCfg.SymbolAllocation(2), ...
+                    'BGN', dlschInfo.BGN, ...
+                    'TBSLBRM', obj.TBSLBRM, ...
+                    'DMRSPowerOffset', obj.DMRSPowerOffset, ...
+                    'DataPowerOffset', obj.DataPowerOffset, ...
+                    'NumLayers', pdschCfg.NumLayers);
+
+                trBlkPacked{iPDSCH} = uint8(srsTest.helpers.bitPack(trBlk{iPDSCH}));
+            end
+
+            gridConfig = struct( ...
+                'NSizeGrid', carrier.NSizeGrid, ...
+                'CyclicPrefix', carrier.CyclicPrefix, ...
+                'NumPorts', max(cellfun(@(x) x.NumLayers, pdsch)));
+
+            txGrid = obj.pdsch_processor_mex('step', gridConfig, trBlkPacked, vertcat(pdschConfigs{:}));
+        end % of function stepImpl(...)
+    end % of methods (Access = protected)
+
+    methods (Access = private, Static)
+        function [nStartBWP, nSizeBWP] = getBWP(carrier, pdsch)
+        %Returns the BWP of the PDSCH (the carrier grid if not configured).
+            nStartBWP = pdsch.NStartBWP;
+            nSizeBWP = pdsch.NSizeBWP;
+            if isempty(nStartBWP)
+                nStartBWP = carrier.NStartGrid;
+            end
+            if isempty(nSizeBWP)
+                nSizeBWP = carrier.NSizeGrid;
+            end
+        end
+
+        function nid = getScramblingID(carrier, pdsch)
+        %Returns the data scrambling identifier (the cell ID if not configured).
+            nid = pdsch.NID;
+            if isempty(nid)
+                nid = carrier.NCellID;
+            end
+        end
+
+        function nid = getDMRSScramblingID(carrier, pdsch)
+        %Returns the DM-RS scrambling identifier (the cell ID if not configured).
+            nid = pdsch.DMRS.NIDNSCID;
+            if isempty(nid)
+                nid = carrier.NCellID;
+            end
+        end
+
+        %MEX function doing the actual work. See the Doxygen documentation.
+        varargout = pdsch_processor_mex(varargin)
+    end % of methods (Access = private, Static)
+end % of classdef srsPDSCHProcessor < matlab.System
@@ -0,0 +1,141 @@
+%srsPRACHDemodulator MATLAB interface to srsRAN OFDM PRACH demodulator.
+%   User-friendly interface to the srsRAN OFDM PRACH demodulator class, which is
+%   wrapped by the MEX static method prach_demodulator_mex. Optionally, the
+%   demodulated PRACH occasions are passed to the srsRAN PRACH detector within the
+%   same call, without going through an intermediate MATLAB array.
+%
+%   PRACHDEMOD = srsPRACHDemodulator creates a PHY PRACH demodulator object.
+%
+%   PRACHDEMOD = srsPRACHDemodulator(NAME, VALUE, ...) creates a PHY PRACH demodulator
+%   object with properties (see below) set according to the NAME-VALUE pairs.
+%
+%   srsPRACHDemodulator Methods:
+%
+%   step  - Demodulates the PRACH occasions of a time-domain waveform.
+%
+%   Step method syntax
+%
+%   SYMBOLS = step(PRACHDEMOD, WAVEFORM, CARRIER, PRACH) uses the object PRACHDEMOD
+%   to demodulate the PRACH occasions of the time-domain signal WAVEFORM (an array of
+%   samples by Rx antennas starting at the beginning of the PRACH slot, as returned
+%   by srsPRACHgenerator). CARRIER is an nrCarrierConfig object and PRACH is an
+%   nrPRACHConfig object. The demodulated PRACH symbols SYMBOLS are a five-dimensional
+%   array (dimensions are sequence elements, OFDM symbols, Rx antennas,
+%   frequency-domain occasions and time-domain occasions). Note that the srsRAN
+%   demodulator uses an isometric DFT, that is the energy of each demodulated PRACH
+%   symbol is equal to the energy of the corresponding portion of WAVEFORM.
+%
+%   [DETECTIONRESULTS, SYMBOLS] = step(PRACHDEMOD, WAVEFORM, CARRIER, PRACH) with the
+%   Detection property set to true also runs the srsRAN PRACH detector on all the
+%   demodulated occasions. DETECTIONRESULTS is a structure array (frequency-domain
+%   occasions by time-domain occasions) with the same fields as the output of
+%   srsPRACHDetector. The output SYMBOLS is optional and, when not requested, the
+%   demodulated symbols are not copied to MATLAB at all.
+%
+%   srsPRACHDemodulator properties (nontunable):
+%
+%   NumFreqOccasions  - Number of frequency-domain PRACH occasions (default 1).
+%   Detection         - PRACH detection flag (default false).
+%
+%   See also srsLib.phy.lower.modulation.srsPRACHdemodulator, srsPRACHDetector,
+%   nrPRACHConfig.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
+
+classdef srsPRACHDemodulator < matlab.System
+    properties (Nontunable)
+        %Number of frequency-domain PRACH occasions.
+        NumFreqOccasions (1, 1) double {mustBeInteger, mustBeInRange(NumFreqOccasions, 1, 8)} = 1
+        %PRACH detection flag.
+        Detection        (1, 1) logical = false
+    end
+
+    methods
+        function obj = srsPRACHDemodulator(varargin)
+        %Constructor: sets nontunable properties.
+            setProperties(obj, nargin, varargin{:});
+        end
+    end % of public methods
+
+    methods (Access = protected)
+        function num = getNumOutputsImpl(obj)
+        %The detection results are only returned when detection is enabled.
+            num = 1 + obj.Detection;
+        end
+
+        function [out, symbols] = stepImpl(obj, waveform, carrier, prach)
+            arguments
+                obj      (1, 1) srsMEX.phy.srsPRACHDemodulator
+                waveform (:, :) double {mustBeNumeric}
+                carrier  (1, 1) nrCarrierConfig
+                prach    (1, 1) nrPRACHConfig
+            end
+
+            [demodConfig, detectorConfig] = srsMEX.phy.srsPRACHDemodulator.getMEXConfig(carrier, prach, ...
+                obj.NumFreqOccasions);
+
+            if ~obj.Detection
+                out = double(obj.prach_demodulator_mex('step', single(waveform), demodConfig));
+                return;
+            end
+
+            if nargout == 2
+                [out, symbols] = obj.prach_demodulator_mex('step', single(waveform), demodConfig, detectorConfig);
+                symbols = double(symbols);
+            else
+                out = obj.prach_demodulator_mex('step', single(waveform), demodConfig, detectorConfig);
+            end
+        end % of function stepImpl(...)
+    end % of methods (Access = protected)
+
+    methods (Static, Hidden)
+        function [demodConfig, detectorConfig] = getMEXConfig(carrier, prach, numFreqOccasions)
+        %Builds the demodulator and detector configuration structures expected by the MEX functions.
+        %   Also used by the PRACH simulation engine, which adds its own fields to the
+        %   demodulator configuration.
+            ofdmInfo = nrPRACHOFDMInfo(carrier, prach);
+
+            % Select the starting symbol within the slot.
+            startSymbol = mod(prach.SymbolLocation, 14);
+            if strcmp(prach.Format, 'C0')
+                % Undoes MATLAB constraint, explained in nrPRACHConfig help.
+                startSymbol = mod(prach.SymbolLocation * 2, 14);
+            end
+
+            demodConfig = struct( ...
+                'SampleRate', ofdmInfo.SampleRate, ...
+                'SubcarrierSpacing', carrier.SubcarrierSpacing, ...
+                'NSlot', prach.NPRACHSlot, ...
+                'NSizeGrid', carrier.NSizeGrid, ...
+                'Format', prach.Format, ...
+                'PRACHSubcarrierSpacing', prach.SubcarrierSpacing, ...
+                'NumTimeOccasions', max(1, prach.NumTimeOccasions), ...
+                'NumFreqOccasions', numFreqOccasions, ...
+                'StartSymbol', startSymbol, ...
+                'RBOffset', prach.RBOffset);
+
+            detectorConfig = struct( ...
+                'SequenceIndex', prach.SequenceIndex, ...
+                'RestrictedSet', prach.RestrictedSet, ...
+                'ZeroCorrelationZone', prach.ZeroCorrelationZone);
+        end % of function getMEXConfig(carrier, prach, numFreqOccasions)
+    end % of methods (Static, Hidden)
+
+    methods (Access = private, Static)
+        %MEX function doing the actual work. See the Doxygen documentation.
+        varargout = prach_demodulator_mex(varargin)
+    end % of methods (Access = private, Static)
+end % of classdef srsPRACHDemodulator < matlab.System
@@ -0,0 +1,110 @@
+%srsPRACHGenerator MATLAB interface to srsRAN PRACH generator.
+%   User-friendly interface to the srsRAN PRACH generator class, which is wrapped
+%   by the MEX static method prach_generator_mex. The generated frequency-domain
+%   sequences are stored in a least-recently-used cache inside the MEX, so that
+%   repeated requests for the same preamble are served without recomputing the
+%   Zadoff-Chu sequence.
+%
+%   PRACHGEN = srsPRACHGenerator creates a PHY PRACH generator object.
+%
+%   PRACHGEN = srsPRACHGenerator(NAME, VALUE, ...) creates a PHY PRACH generator
+%   object with properties (see below) set according to the NAME-VALUE pairs.
+%
+%   srsPRACHGenerator Methods:
+%
+%   step             - Generates one or more PRACH frequency-domain sequences.
+%   cacheStatistics  - Returns the statistics of the sequence cache.
+%
+%   Step method syntax
+%
+%   SEQUENCE = step(PRACHGEN, PRACH) uses the object PRACHGEN to generate the
+%   frequency-domain PRACH sequence described by the nrPRACHConfig object PRACH
+%   (only the properties Format, SequenceIndex, PreambleIndex, RestrictedSet and
+%   ZeroCorrelationZone are relevant). SEQUENCE is a column vector of length
+%   PRACH.LRA, equivalent to the first PRACH.LRA PRACH symbols returned by
+%   srsPRACHgenerator.
+%
+%   SEQUENCES = step(PRACHGEN, PRACHLIST) generates one sequence for each of the
+%   nrPRACHConfig objects in the cell array PRACHLIST. SEQUENCES is a matrix with
+%   one sequence per column. All the configurations must result in sequences with
+%   the same length.
+%
+%   srsPRACHGenerator properties (nontunable):
+%
+%   CacheSize  - Maximum number of cached sequences (default 1024).
+%
+%   See also srsLib.phy.upper.channel_processors.srsPRACHgenerator, nrPRACHConfig.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
+
+classdef srsPRACHGenerator < matlab.System
+    properties (Nontunable)
+        %Maximum number of cached sequences.
+        CacheSize (1, 1) double {mustBeInteger, mustBePositive} = 1024
+    end
+
+    methods
+        function obj = srsPRACHGenerator(varargin)
+        %Constructor: sets nontunable properties.
+            setProperties(obj, nargin, varargin{:});
+        end
+
+        function stats = cacheStatistics(obj)
+        %cacheStatistics Returns the statistics of the sequence cache.
+        %   STATS = cacheStatistics(PRACHGEN) returns a structure with fields Size,
+        %   Capacity, Hits, Misses and Evictions.
+            stats = obj.prach_generator_mex('stats');
+        end
+    end % of public methods
+
+    methods (Access = protected)
+        function setupImpl(obj)
+        %Creates the sequence cache inside the MEX function.
+            obj.prach_generator_mex('new', obj.CacheSize);
+        end % of function setupImpl(obj)
+
+        function sequences = stepImpl(obj, prach)
+            arguments
+                obj   (1, 1) srsMEX.phy.srsPRACHGenerator
+                prach
+            end
+
+            if ~iscell(prach)
+                prach = {prach};
+            end
+
+            nSequences = numel(prach);
+            configs = cell(nSequences, 1);
+            for iSequence = 1:nSequences
+                assert(isa(prach{iSequence}, 'nrPRACHConfig'), 'srsran_matlab:srsPRACHGenerator', ...
+                    'PRACH configurations must be nrPRACHConfig objects (entry %d).', iSequence);
+                configs{iSequence} = struct( ...
+                    'Format', prach{iSequence}.Format, ...
+                    'SequenceIndex', prach{iSequence}.SequenceIndex, ...
+                    'PreambleIndex', prach{iSequence}.PreambleIndex, ...
+                    'RestrictedSet', prach{iSequence}.RestrictedSet, ...
+                    'ZeroCorrelationZone', prach{iSequence}.ZeroCorrelationZone);
+            end
+
+            sequences = double(obj.prach_generator_mex('step', vertcat(configs{:})));
+        end % of function stepImpl(...)
+    end % of methods (Access = protected)
+
+    methods (Access = private, Static)
+        %MEX function doing the actual work. See the Doxygen documentation.
+        varargout = prach_generator_mex(varargin)
+    end % of methods (Access = private, Static)
+end % of classdef srsPRACHGenerator < matlab.System
@@ -77,16 +77,37 @@ classdef srsPUCCHProcessor < matlab.System
             end
 
             gridDims = size(rxGrid);
-            secondHop = [];
-            if ~strcmp(pucchConfig.FrequencyHopping, 'neither')
-                secondHop = pucchConfig.SecondHopStartPRB;
-            end
 
             numRxPorts = 1;
             if (numel(gridDims) == 3)
                 numRxPorts = gridDims(3);
             end
 
+            assert(isempty(uciSizes.MuxFormat1) || isa(pucchConfig, 'nrPUCCH1Config'), 'srsRAN-matlab:srsPUCCHProcessor', ...
+                'Input MuxFormat1 should be empty for PUCCH Formats 0, 2, 3 and 4.');
+
+            mexConfig = srsMEX.phy.srsPUCCHProcessor.getMEXConfig(carrierConfig, pucchConfig, numRxPorts, uciSizes);
+
+            uci = obj.pucch_processor_mex('step', single(rxGrid), mexConfig, uciSizes.MuxFormat1);
+
+            nResults = length(uci);
+
+            assert((nResults == 1) || (mexConfig.Format == 1) && (length(uciSizes.MuxFormat1) == nResults));
+        end % of function [uci, csi] = stepImpl(obj, pucchConfig, carrierConfig)
+    end % of methods (Access = protected)
+
+    methods (Static, Hidden)
+        function mexConfig = getMEXConfig(carrierConfig, pucchConfig, numRxPorts, uciSizes)
+        %Builds the PUCCH configuration structure expected by the MEX functions.
+        %   Also used by the PUCCH simulation engine, which processes many PUCCH
+        %   transmissions with the same configuration. Field NSlot is set as in the
+        %   CARRIERCONFIG object. Input UCISIZES is a structure with fields 'NumHARQAck',
+        %   'NumSR', 'NumCSIPart1' and 'NumCSIPart2'.
+            secondHop = [];
+            if ~strcmp(pucchConfig.FrequencyHopping, 'neither')
+                secondHop = pucchConfig.SecondHopStartPRB;
+            end
+
             if ~isempty(pucchConfig.NSizeBWP)
                 nSizeBWP = pucchConfig.NSizeBWP;
             else
@@ -134,8 +155,6 @@ classdef srsPUCCHProcessor < matlab.System
                     'NIDScrambling', [], ...    only PUCCH F3 and F4
                     'SpreadingFactor', [] ...   only PUCCH F4
                 );
-
-                assert(isempty(uciSizes.MuxFormat1), 'srsRAN-matlab:srsPUCCHProcessor', 'Input MuxFormat1 should be empty for PUCCH Format 0');
             elseif isa(pucchConfig, 'nrPUCCH1Config')
                 if ~isempty(pucchConfig.HoppingID)
                     nid = pucchConfig.HoppingID;
@@ -201,8 +220,6 @@ classdef srsPUCCHProcessor < matlab.System
                     'NIDScrambling', [], ...      only PUCCH F3 and F4
                     'SpreadingFactor', [] ...     only PUCCH F4
                     );
-
-                assert(isempty(uciSizes.MuxFormat1), 'srsRAN-matlab:srsPUCCHProcessor', 'Input MuxFormat1 should be empty for PUCCH Format 2');
             elseif isa(pucchConfig, 'nrPUCCH3Config')
                 if ~isempty(pucchConfig.NID)
                     nid = pucchConfig.NID;
@@ -238,8 +255,6 @@ classdef srsPUCCHProcessor < matlab.System
                     'NID0', [], ...               only PUCCH F2
                     'SpreadingFactor', [] ...     only PUCCH F4
                     );
-
-                assert(isempty(uciSizes.MuxFormat1), 'srsRAN-matlab:srsPUCCHProcessor', 'Input MuxFormat1 should be empty for PUCCH Format 3');
             else
                 if ~isempty(pucchConfig.NID)
                     nid = pucchConfig.NID;
@@ -275,17 +290,9 @@ classdef srsPUCCHProcessor < matlab.System
                     'NumPRBs', [], ...            only PUCCH F2 and F3
                     'NID0', [] ...                only PUCCH F2
                     );
-
-                assert(isempty(uciSizes.MuxFormat1), 'srsRAN-matlab:srsPUCCHProcessor', 'Input MuxFormat1 should be empty for PUCCH Format 4');
             end
-
-            uci = obj.pucch_processor_mex('step', single(rxGrid), mexConfig, uciSizes.MuxFormat1);
-
-            nResults = length(uci);
-
-            assert((nResults == 1) || (mexConfig.Format == 1) && (length(uciSizes.MuxFormat1) == nResults));
-        end % of function [uci, csi] = stepImpl(obj, pucchConfig, carrierConfig)
-    end % of methods (Access = protected)
+        end % of function getMEXConfig(carrierConfig, pucchConfig, numRxPorts, uciSizes)
+    end % of methods (Static, Hidden)
 
     methods (Access = private, Static)
         %MEX function doing the actual work. See the Doxygen documentation.
@@ -12,10 +12,29 @@
 %
 %   srsPUSCHDecoder Properties (Nontunable):
 %
-%   MaxCodeblockSize - Maximum size of the codeblocks stored in the pool (default 1000).
-%   MaxSoftbuffers   - Maximum number of softbuffers managed by the pool (default 1).
-%   MaxCodeblocks    - Maximum number of codeblocks managed by the pool
-%                      (shared by all softbuffers, default 1).
+%   MaxCodeblockSize    - Maximum size of the codeblocks stored in the pool (default 1000).
+%   MaxSoftbuffers      - Maximum number of softbuffers managed by the pool (default 1).
+%   MaxCodeblocks       - Maximum number of codeblocks managed by the pool
+%                         (shared by all softbuffers, default 1).
+%   ExpireTimeoutSlots  - Number of slots after which an unused softbuffer is
+%                         released by the pool (default 10).
+%   AutoAdvanceSlot     - Increases Slot by one after every decoded codeword
+%                         (default true).
+%   SoftbitWidth        - Number of bits of the soft bits stored in the pool (8, 6
+%                         or 4, default 8).
+%   CheckpointFile      - File where the state of the softbuffer pool is saved with
+%                         the object (default '', no checkpoints).
+%   NativeHARQ          - Enables the native HARQ entity (default false).
+%   RNTI                - UE RNTI (native HARQ entity only, default 1).
+%   HARQProcessSequence - Fixed sequence of HARQ process IDs (native HARQ entity
+%                         only, default 0).
+%   RVSequence          - Redundancy version sequence shared by all HARQ processes
+%                         (native HARQ entity only, default 0).
+%
+%   srsPUSCHDecoder Properties (Tunable):
+%
+%   Slot                - Current slot, counted from the creation of the softbuffer
+%                         pool (default 0).
 %
 %   srsPUSCHDecoder Properties (Access = private):
 %
@@ -23,12 +42,17 @@
 %
 %   srsPUSCHDecoder Methods:
 %
-%   step               - Decodes one PUSCH codeword.
-%   resetCRCS          - Resets the CRC state of a softbuffer.
-%   release            - Allows reconfiguration.
-%   reset              - Clears the content of the softbuffer pool.
-%   isLocked           - Locked status (logical).
-%   configureSegment   - Static helper method for filling the SEGCONFIG input of "step".
+%   step                - Decodes one PUSCH codeword.
+%   resetCRCS           - Resets the CRC state of a softbuffer.
+%   getHARQTransmission - Returns the HARQ information of the next transmission
+%                         (native HARQ entity only).
+%   getHARQStatistics   - Returns the statistics of the HARQ processes (native HARQ
+%                         entity only).
+%   getPoolStatus       - Returns the occupancy of the softbuffer pool.
+%   release             - Allows reconfiguration.
+%   reset               - Clears the content of the softbuffer pool.
+%   isLocked            - Locked status (logical).
+%   configureSegment    - Static helper method for filling the SEGCONFIG input of "step".
 %
 %   Step method syntax
 %
@@ -63,6 +87,74 @@
 %                            of the transport block;
 %      LDPCIterationsMean  - average number of LDPC iterations across all codeblocks
 %                            of the transport block.
+%
+%   Native HARQ entity
+%
+%   When NativeHARQ is true, the softbuffer pool comes with a native HARQ entity
+%   for the UE with identifier RNTI. As the HARQEntity class of the PUSCHBLER
+%   simulator, the entity cycles through the HARQ processes in HARQProcessSequence
+%   and moves a process along RVSequence until the transport block is received
+%   successfully or the sequence times out. The entity also manages the softbuffers:
+%   there is no need to call resetCRCS. The step method syntax becomes
+%
+%   [TBK, STATS, HARQINFO] = step(PUSCHDEC, LLRS, SEGCONFIG) decodes the codeword
+%   LLRS of the current transmission. The HARQ process, the redundancy version and
+%   the new data flag are decided by the HARQ entity: the field RV of SEGCONFIG is
+%   ignored and the field NumCodeblocks (as returned by configureSegment) is needed.
+%   TBK and STATS are as above. HARQINFO is a structure with the HARQ information
+%   of the next transmission and fields
+%      HARQProcessID       - the ID of the HARQ process;
+%      TransmissionNumber  - the transmission number in the RV sequence (0-based);
+%      RedundancyVersion   - the redundancy version;
+%      NewData             - equal to true if the transmission starts a new RV sequence;
+%      SequenceTimeout     - equal to true if the previous RV sequence of the process
+%                            ended without success.
+%   A single call per slot thus decodes the received codeword and tells the
+%   transmitter what to send next.
+%
+%   Softbuffer expiration
+%
+%   The softbuffer pool keeps track of time with the property Slot. By default
+%   (AutoAdvanceSlot = true), every call to step decodes the codeword at the
+%   current Slot and then increases Slot by one, so that each decoded codeword
+%   takes one slot. Callers that know the actual slot of the transmissions can
+%   set Slot before every call (and AutoAdvanceSlot to false, if they decode more
+%   than one codeword per slot). Every time a softbuffer is used, its expiration is
+%   set to ExpireTimeoutSlots slots later: the softbuffers that are not used again
+%   before their expiration (e.g., because the retransmission was never received)
+%   are released by the pool at the first call with a later Slot. The method
+%   getPoolStatus reports the occupancy of the pool and the number of expired
+%   softbuffers.
+%
+%   Compressed softbuffers
+%
+%   With SoftbitWidth set to 6 or 4, the softbuffers store the combined soft bits
+%   with a reduced resolution (uniform quantization over the whole LLR range), which
+%   reduces the memory taken by each codeblock and, for the same memory, allows
+%   more codeblocks (i.e., more HARQ processes) per pool. Decoding always works on
+%   full-width soft bits: only the soft combining of retransmissions is affected
+%   by the quantization. The fields StorageBytes and FullWidthStorageBytes of the
+%   structure returned by getPoolStatus compare the memory of the pool with the
+%   one of a full-width pool.
+%
+%   Checkpoints
+%
+%   The softbuffer pool lives in the memory of the MEX and is lost on "clear mex"
+%   or when MATLAB exits. If CheckpointFile is not empty, saving a locked object
+%   (e.g., with the save function) also writes the state of the pool to
+%   CheckpointFile: the reserved softbuffers, their expiration, the pool counters
+%   and, with NativeHARQ, the state and statistics of the HARQ entity. Loading the
+%   object restores the pool from CheckpointFile, so that decoding resumes in the
+%   middle of the RV sequences. The checkpoint is a compact binary file, meant to
+%   be loaded on the machine that wrote it. Each save writes a new checkpoint
+%   identifier (a hash of the pool state) both in CheckpointFile and in the saved
+%   object: loading an object whose checkpoint was overwritten by a later save
+%   with the same CheckpointFile fails with an error.
+%
+%   The state of the srsRAN softbuffer pool is not accessible. With CheckpointFile
+%   set, the decoder thus stores the soft bits in the srsRAN-matlab pool used for
+%   the compressed softbuffers, with full-width soft bits if SoftbitWidth is 8:
+%   the decoding results are the same as with the srsRAN pool.
 
 %   Copyright 2021-2025 Software Radio Systems Limited
 %
@@ -87,8 +179,29 @@ classdef srsPUSCHDecoder < matlab.System
         MaxSoftbuffers   (1, 1) double {mustBePositive, mustBeInteger} = 1
         %Maximum number of codeblocks managed by the pool (shared by all softbuffers).
         MaxCodeblocks    (1, 1) double {mustBePositive, mustBeInteger} = 1
+        %Number of slots after which an unused softbuffer is released by the pool.
+        ExpireTimeoutSlots (1, 1) double {mustBePositive, mustBeInteger} = 10
+        %Increases Slot by one after every decoded codeword.
+        AutoAdvanceSlot  (1, 1) logical = true
+        %Number of bits of the soft bits stored in the pool.
+        SoftbitWidth     (1, 1) double {mustBeMember(SoftbitWidth, [4 6 8])} = 8
+        %File where the state of the softbuffer pool is saved with the object (empty for no checkpoints).
+        CheckpointFile   (1, :) char = ''
+        %Enables the native HARQ entity.
+        NativeHARQ       (1, 1) logical = false
+        %UE RNTI (native HARQ entity only).
+        RNTI             (1, 1) double {mustBeInteger, mustBeInRange(RNTI, 0, 65535)} = 1
+        %Fixed sequence of HARQ process IDs (native HARQ entity only).
+        HARQProcessSequence (1, :) double {mustBeNonempty, mustBeInteger, mustBeNonnegative} = 0
+        %Redundancy version sequence shared by all HARQ processes (native HARQ entity only).
+        RVSequence       (1, :) double {mustBeNonempty, mustBeMember(RVSequence, 0:3)} = 0
     end % properties (Nontunable)
 
+    properties
+        %Current slot, counted from the creation of the softbuffer pool.
+        Slot (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
+    end % properties
+
     properties (Access = private)
         %Unique identifier of the softbuffer pool used by the current PUSCH decoder.
         SoftbufferPoolID (1, 1) uint64 = 0
@@ -127,9 +240,100 @@ classdef srsPUSCHDecoder < matlab.System
             validateattributes(harqBufID.NumCodeblocks, {'double'}, {'scalar', 'integer', 'positive'}, ...
                 fcnName, 'NumCodeblocks');
 
-            obj.pusch_decoder_mex('reset_crcs', obj.SoftbufferPoolID, harqBufID);
+            obj.pusch_decoder_mex('reset_crcs', obj.SoftbufferPoolID, harqBufID, obj.Slot);
         end % of function resetCRCS
 
+        function harqInfo = getHARQTransmission(obj)
+        %Returns the HARQ information of the next transmission.
+        %   HARQINFO = getHARQTransmission(PUSCHDEC) returns the HARQ information of the
+        %   next transmission scheduled by the native HARQ entity of the PUSCH decoder
+        %   object PUSCHDEC (see the step method for the fields of HARQINFO).
+
+            arguments
+                obj (1, 1) srsMEX.phy.srsPUSCHDecoder
+            end
+
+            if ~obj.NativeHARQ
+                error('srsPUSCHDecoder:NoHARQ', 'The native HARQ entity is not enabled.');
+            end
+
+            % Before setup, the entity is in its initial state.
+            if ~isLocked(obj)
+                harqInfo = struct('HARQProcessID', obj.HARQProcessSequence(1), 'TransmissionNumber', 0, ...
+                    'RedundancyVersion', obj.RVSequence(1), 'NewData', true, 'SequenceTimeout', false);
+                return;
+            end
+
+            [harqInfo, ~] = obj.pusch_decoder_mex('harq_status', obj.SoftbufferPoolID);
+        end % of function getHARQTransmission
+
+        function stats = getHARQStatistics(obj)
+        %Returns the statistics of the HARQ processes.
+        %   STATS = getHARQStatistics(PUSCHDEC) returns the statistics of the HARQ
+        %   processes of the native HARQ entity of the PUSCH decoder object PUSCHDEC.
+        %   STATS is a structure array with one entry for each HARQ process, sorted by
+        %   HARQ process ID, and fields
+        %      HARQProcessID        - the ID of the HARQ process;
+        %      NumTransmissions     - the number of transmissions, including retransmissions;
+        %      NumNewTransmissions  - the number of new data transmissions;
+        %      NumTimeouts          - the number of RV sequences that ended without success;
+        %      TotalBits            - the number of transmitted information bits;
+        %      SuccessfulBits       - the number of successfully received information bits;
+        %      NumSuccesses         - the number of successful receptions for each
+        %                             transmission number in the RV sequence.
+
+            arguments
+                obj (1, 1) srsMEX.phy.srsPUSCHDecoder
+            end
+
+            if ~obj.NativeHARQ
+                error('srsPUSCHDecoder:NoHARQ', 'The native HARQ entity is not enabled.');
+            end
+
+            % Before setup, no process has transmitted yet.
+            if ~isLocked(obj)
+                processIDs = unique(obj.HARQProcessSequence);
+                stats = struct('HARQProcessID', num2cell(processIDs), 'NumTransmissions', 0, ...
+                    'NumNewTransmissions', 0, 'NumTimeouts', 0, 'TotalBits', 0, 'SuccessfulBits', 0, ...
+                    'NumSuccesses', zeros(1, numel(obj.RVSequence)));
+                return;
+            end
+
+            [~, stats] = obj.pusch_decoder_mex('harq_status', obj.SoftbufferPoolID);
+        end % of function getHARQStatistics
+
+        function status = getPoolStatus(obj)
+        %Returns the occupancy of the softbuffer pool.
+        %   STATUS = getPoolStatus(PUSCHDEC) advances the softbuffer pool of the PUSCH
+        %   decoder object PUSCHDEC to the current slot (thus releasing the expired
+        %   softbuffers) and returns a structure with fields
+        %      Slot               - the current slot;
+        %      NumBuffers         - the number of reserved softbuffers;
+        %      NumCodeblocks      - the number of codeblocks of the reserved softbuffers;
+        %      MaxNumBuffers      - the maximum number of softbuffers reserved at the
+        %                           same time;
+        %      MaxNumCodeblocks   - the maximum number of codeblocks reserved at the
+        %                           same time;
+        %      NumExpiredBuffers  - the number of softbuffers released because they
+        %                           expired;
+        %      StorageBytes       - the number of bytes storing soft bits;
+        %      FullWidthStorageBytes - the number of bytes a pool with full-width
+        %                           soft bits would take.
+
+            arguments
+                obj (1, 1) srsMEX.phy.srsPUSCHDecoder
+            end
+
+            % Before setup, the pool is empty.
+            if ~isLocked(obj)
+                status = struct('Slot', obj.Slot, 'NumBuffers', 0, 'NumCodeblocks', 0, 'MaxNumBuffers', 0, ...
+                    'MaxNumCodeblocks', 0, 'NumExpiredBuffers', 0, 'StorageBytes', 0, 'FullWidthStorageBytes', 0);
+                return;
+            end
+
+            status = obj.pusch_decoder_mex('pool_status', obj.SoftbufferPoolID, obj.Slot);
+        end % of function getPoolStatus
+
         function configure(obj, carrier, pusch, TargetCodeRate, NHARQProcesses, XOverhead)
             arguments
                 obj            (1, 1) srsMEX.phy.srsPUSCHDecoder
@@ -155,61 +359,39 @@ classdef srsPUSCHDecoder < matlab.System
     methods (Access = protected)
         function setupImpl(obj)
         %Creates a softbuffer pool with the given characteristics and stores its ID.
-            sbpdesc = obj.createSoftBufferDptn;
-
-            id = obj.pusch_decoder_mex('new', sbpdesc);
-
-            obj.SoftbufferPoolID = id;
+            obj.SoftbufferPoolID = createPool(obj, 'new');
         end % of setupImpl
 
-        function [transportBlock, stats] = stepImpl(obj, llrs, newData, segConfig, harqBufID, dataType)
-            arguments
-                obj       (1, 1) srsMEX.phy.srsPUSCHDecoder
-                llrs      (:, 1) int8
-                newData   (1, 1) logical
-                segConfig (1, 1) struct
-                harqBufID (1, 1) struct
-                dataType  (1, :) char {mustBeMember(dataType, {'packed', 'unpacked'})} = 'packed'
+        function varargout = stepImpl(obj, llrs, varargin)
+            if obj.NativeHARQ
+                [varargout{1:nargout}] = stepHARQ(obj, llrs, varargin{:});
+            else
+                [varargout{1:nargout}] = stepBuffer(obj, llrs, varargin{:});
             end
+        end % function stepImpl(...)
 
-            fcnName = [class(obj) '/step'];
-
-            validateattributes(segConfig.NumLayers, {'double'}, {'scalar', 'integer', 'positive'}, ...
-                fcnName, 'NumLayers');
-            validateattributes(segConfig.RV, {'double'}, {'scalar', 'integer', 'nonnegative'}, ...
-                fcnName, 'RV');
-            validateattributes(segConfig.LimitedBufferSize, {'double'}, {'scalar', 'integer', 'nonnegative'}, ...
-                fcnName, 'LimitedBufferSize');
-            validateattributes(segConfig.NumChSymbols, {'double'}, {'scalar', 'integer', 'positive'}, ...
-                fcnName, 'NumChSymbols');
-            modList = {'pi/2-BPSK', 'BPSK', 'QPSK', '16QAM', '64QAM', '256QAM'};
-            validatestring(segConfig.Modulation, modList, fcnName, 'MODULATION');
-            validateattributes(segConfig.MaximumLDPCIterationCount, {'double'}, {'scalar', 'integer', 'positive'}, ...
-                fcnName, 'MaximumLDPCIterationCount');
-
-            validateattributes(harqBufID.HARQProcessID, {'double'}, {'scalar', 'integer', 'nonnegative'}, ...
-                fcnName, 'HARQ_ACK_ID');
-            validateattributes(harqBufID.RNTI, {'double'}, {'scalar', 'integer', 'positive'}, ...
-                fcnName, 'RNTI');
-            validateattributes(harqBufID.NumCodeblocks, {'double'}, {'scalar', 'integer', 'positive'}, ...
-                fcnName, 'NOF_CODEBLOCKS');
-
-            bpsList = [1, 1, 2, 4, 6, 8];
-            ind = strcmpi(modList, segConfig.Modulation);
-            tmp = bpsList(ind);
-            bps = tmp(1);
-
-            nLLRS = segConfig.NumChSymbols * segConfig.NumLayers * bps;
-
-            validateattributes(llrs, {'int8'}, {'numel', nLLRS}, fcnName, 'LLRS');
+        function nInputs = getNumInputsImpl(obj)
+        %With the native HARQ entity, the entity provides the new data flag and the buffer ID.
+            if obj.NativeHARQ
+                nInputs = 2;
+            else
+                nInputs = 5;
+            end
+        end
 
-            [transportBlock, stats] = obj.pusch_decoder_mex('step', obj.SoftbufferPoolID, ...
-               llrs, newData, segConfig, harqBufID);
+        function nOutputs = getNumOutputsImpl(obj)
+        %With the native HARQ entity, the decoder also returns the next HARQ transmission.
+            nOutputs = 2 + obj.NativeHARQ;
+        end
 
-           if strcmp(dataType, 'unpacked')
-               transportBlock = srsTest.helpers.bitUnpack(transportBlock);
-           end
-        end % function stepImpl(...)
+        function flag = isInactivePropertyImpl(obj, property)
+            switch property
+                case {'RNTI', 'HARQProcessSequence', 'RVSequence'}
+                    flag = ~obj.NativeHARQ;
+                otherwise
+                    flag = false;
+            end
+        end
 
         function resetImpl(obj)
         % Releases the softbuffer pool and creates a new one.
@@ -233,33 +415,116 @@ classdef srsPUSCHDecoder < matlab.System
 
         function s = saveObjectImpl(obj)
         % Save all public properties.
-        % Note: At the moment we have no access to the internal memory of the MEX block and
-        % we can only save the configuration of the decoder, not its state.
+        % Note: The state of the softbuffer pool lives in the memory of the MEX block. It is
+        % written to CheckpointFile, if set, and the saved structure only keeps the identifier
+        % of the checkpoint.
             s = saveObjectImpl@matlab.System(obj);
+
+            if isLocked(obj) && ~isempty(obj.CheckpointFile)
+                s.CheckpointID = obj.pusch_decoder_mex('save', obj.SoftbufferPoolID, obj.CheckpointFile);
+            end
         end
 
         function loadObjectImpl(obj, s, wasInUse)
         % Loads an srsPUSCHDecoder object from a file.
-        % Note: Due to the limitations of the mex, we can only save the configuration of
-        % the decoder, not its internal (MEX) state. Therefore, even if the object was
-        % saved in the locked state, this function returns an object with an empty
-        % softbuffer pool.
+        % Note: If the object was saved in the locked state, the softbuffer pool is restored
+        % from CheckpointFile, if set, which must still hold the checkpoint written when the
+        % object was saved. Otherwise, this function returns an object with an empty softbuffer
+        % pool.
             loadObjectImpl@matlab.System(obj, s, wasInUse);
 
             if wasInUse
-                setupImpl(obj);
+                if isfield(s, 'CheckpointID')
+                    obj.SoftbufferPoolID = createPool(obj, 'load', obj.CheckpointFile, s.CheckpointID);
+                else
+                    setupImpl(obj);
+                end
             end
         end
     end % of methods (Access = protected)
 
     methods (Access = private)
+        function [transportBlock, stats] = stepBuffer(obj, llrs, newData, segConfig, harqBufID, dataType)
+        %Decodes one codeword with the softbuffer identified by HARQBUFID.
+            arguments
+                obj       (1, 1) srsMEX.phy.srsPUSCHDecoder
+                llrs      (:, 1) int8
+                newData   (1, 1) logical
+                segConfig (1, 1) struct
+                harqBufID (1, 1) struct
+                dataType  (1, :) char {mustBeMember(dataType, {'packed', 'unpacked'})} = 'packed'
+            end
+
+            fcnName = [class(obj) '/step'];
+
+            validateSegment(llrs, segConfig, fcnName);
+
+            validateattributes(harqBufID.HARQProcessID, {'double'}, {'scalar', 'integer', 'nonnegative'}, ...
+                fcnName, 'HARQ_ACK_ID');
+            validateattributes(harqBufID.RNTI, {'double'}, {'scalar', 'integer', 'positive'}, ...
+                fcnName, 'RNTI');
+            validateattributes(harqBufID.NumCodeblocks, {'double'}, {'scalar', 'integer', 'positive'}, ...
+                fcnName, 'NOF_CODEBLOCKS');
+
+            [transportBlock, stats] = obj.pusch_decoder_mex('step', obj.SoftbufferPoolID, ...
+               llrs, newData, segConfig, harqBufID, obj.Slot);
+            advanceSlot(obj);
+
+           if strcmp(dataType, 'unpacked')
+               transportBlock = srsTest.helpers.bitUnpack(transportBlock);
+           end
+        end % of function stepBuffer(...)
+
+        function [transportBlock, stats, harqInfo] = stepHARQ(obj, llrs, segConfig)
+        %Decodes the codeword of the current transmission of the native HARQ entity.
+            arguments
+                obj       (1, 1) srsMEX.phy.srsPUSCHDecoder
+                llrs      (:, 1) int8
+                segConfig (1, 1) struct
+            end
+
+            fcnName = [class(obj) '/step'];
+
+            validateSegment(llrs, segConfig, fcnName);
+
+            validateattributes(segConfig.NumCodeblocks, {'double'}, {'scalar', 'integer', 'positive'}, ...
+                fcnName, 'NOF_CODEBLOCKS');
+
+            [transportBlock, stats, harqInfo] = obj.pusch_decoder_mex('step_harq', obj.SoftbufferPoolID, ...
+               llrs, segConfig, obj.Slot);
+            advanceSlot(obj);
+        end % of function stepHARQ(...)
+
+        function advanceSlot(obj)
+        %Moves to the next slot after a decoded codeword, if AutoAdvanceSlot is true.
+            if obj.AutoAdvanceSlot
+                obj.Slot = obj.Slot + 1;
+            end
+        end
+
+        function id = createPool(obj, method, varargin)
+        %Creates a softbuffer pool with the MEX method METHOD ('new' or 'load') and returns its ID.
+        %   Additional inputs are passed to the MEX method before the pool configuration.
+            sbpdesc = obj.createSoftBufferDptn;
+
+            if obj.NativeHARQ
+                harqConfig.RNTI = obj.RNTI;
+                harqConfig.HARQProcessSequence = obj.HARQProcessSequence;
+                harqConfig.RVSequence = obj.RVSequence;
+                id = obj.pusch_decoder_mex(method, varargin{:}, sbpdesc, harqConfig);
+            else
+                id = obj.pusch_decoder_mex(method, varargin{:}, sbpdesc);
+            end
+        end
+
         function softbufferDptn = createSoftBufferDptn(obj)
         %Creates a softbuffer configuration structure.
             softbufferDptn.MaxCodeblockSize = obj.MaxCodeblockSize;
             softbufferDptn.MaxSoftbuffers = obj.MaxSoftbuffers;
             softbufferDptn.MaxCodeblocks = obj.MaxCodeblocks;
-            % Not used (for now), but we need to set it to a value larger than 0.
-            softbufferDptn.ExpireTimeoutSlots = 10;
+            softbufferDptn.ExpireTimeoutSlots = obj.ExpireTimeoutSlots;
+            softbufferDptn.SoftbitWidth = obj.SoftbitWidth;
+            softbufferDptn.EnableCheckpoints = ~isempty(obj.CheckpointFile);
         end
     end % of methods (Access = private)
 
@@ -309,3 +574,28 @@ classdef srsPUSCHDecoder < matlab.System
         end % of function configureSegment(...)
     end % of methods (Static)
 end % of classdef srsPUSCHDecoder < matlab.System
+
+% Validates the segment configuration and the number of LLRs.
+function validateSegment(llrs, segConfig, fcnName)
+    validateattributes(segConfig.NumLayers, {'double'}, {'scalar', 'integer', 'positive'}, ...
+        fcnName, 'NumLayers');
+    validateattributes(segConfig.RV, {'double'}, {'scalar', 'integer', 'nonnegative'}, ...
+        fcnName, 'RV');
+    validateattributes(segConfig.LimitedBufferSize, {'double'}, {'scalar', 'integer', 'nonnegative'}, ...
+        fcnName, 'LimitedBufferSize');
+    validateattributes(segConfig.NumChSymbols, {'double'}, {'scalar', 'integer', 'positive'}, ...
+        fcnName, 'NumChSymbols');
+    modList = {'pi/2-BPSK', 'BPSK', 'QPSK', '16QAM', '64QAM', '256QAM'};
+    validatestring(segConfig.Modulation, modList, fcnName, 'MODULATION');
+    validateattributes(segConfig.MaximumLDPCIterationCount, {'double'}, {'scalar', 'integer', 'positive'}, ...
+        fcnName, 'MaximumLDPCIterationCount');
+
+    bpsList = [1, 1, 2, 4, 6, 8];
+    ind = strcmpi(modList, segConfig.Modulation);
+    tmp = bpsList(ind);
+    bps = tmp(1);
+
+    nLLRS = segConfig.NumChSymbols * segConfig.NumLayers * bps;
+
+    validateattributes(llrs, {'int8'}, {'numel', nLLRS}, fcnName, 'LLRS');
+end % of function validateSegment(llrs, segConfig, fcnName)
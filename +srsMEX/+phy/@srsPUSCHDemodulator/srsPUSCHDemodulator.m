@@ -37,9 +37,17 @@
 %
 %   RXPORTS is an array of 0-based indices of the Rx-side antenna ports.
 %
+%   [SCHSOFTBITS, HARQACK, CSIPART1, CSIPART2] = step(PUSCHDEMODULATOR, RXSYMBOLS, CE, NOISEVAR, ...
+%                      PUSCH, PUSCHINDICES, PUSCHDMRSINDICES, RXPORTS, DEMUXCONFIG)
+%   with property DemultiplexUCI set to true, also demultiplexes the soft bits as they
+%   are demodulated and returns the UL-SCH data SCHSOFTBITS separated from the HARQ-ACK
+%   HARQACK, CSI Part 1 CSIPART1 and CSI Part 2 CSIPART2 soft bits. DEMUXCONFIG is the
+%   configuration structure returned by srsMEX.phy.srsULSCHDemultiplex.createConfiguration.
+%
 %   srsPUSCHDemodulator properties (nontunable):
 %
 %   EqualizerStrategy  - Equalizer strategy ('ZF', 'MMSE').
+%   DemultiplexUCI     - Demultiplexing flag: true for separating UL-SCH data and UCI soft bits.
 
 %   Copyright 2021-2025 Software Radio Systems Limited
 %
@@ -59,6 +67,8 @@
 classdef srsPUSCHDemodulator < matlab.System
     properties (Nontunable)
         EqualizerStrategy (1, :) char {mustBeMember(EqualizerStrategy, {'ZF', 'MMSE'})} = 'ZF'
+        %Demultiplexing flag: true for separating UL-SCH data and UCI soft bits.
+        DemultiplexUCI (1, 1) logical = false
     end
 
     methods
@@ -73,7 +83,8 @@ classdef srsPUSCHDemodulator < matlab.System
             obj.pusch_demodulator_mex('new', obj.EqualizerStrategy);
         end
 
-        function schSoftBits = stepImpl(obj, rxSymbols, cest, noiseVar, pusch, puschIndices, puschDMRSIndices, rxPorts)
+        function [schSoftBits, harqAck, csiPart1, csiPart2] = stepImpl(obj, rxSymbols, cest, noiseVar, pusch, ...
+                puschIndices, puschDMRSIndices, rxPorts, demuxConfig)
             arguments
                 obj               (1, 1)        srsMEX.phy.srsPUSCHDemodulator
                 rxSymbols         (:, 14, :)    double {srsTest.helpers.mustBeResourceGrid}
@@ -83,6 +94,7 @@ classdef srsPUSCHDemodulator < matlab.System
                 puschIndices                    double {mustBeInteger, mustBePositive}
                 puschDMRSIndices                double {mustBeInteger, mustBePositive}
                 rxPorts           (:, 1)        double {mustBeInteger, mustBeNonnegative}
+                demuxConfig                     struct = struct([])
             end
 
             gridSize = size(rxSymbols);
@@ -153,9 +165,26 @@ classdef srsPUSCHDemodulator < matlab.System
                 'RxPorts', rxPorts, ...
                 'NumOutputLLR', numel(puschIndices) * srsLib.phy.helpers.srsGetBitsSymbol(pusch.Modulation));
 
-            schSoftBits = obj.pusch_demodulator_mex('step', single(rxSymbols), cest, noiseVar, ...
-                PUSCHDemConfig);
+            if obj.DemultiplexUCI
+                [schSoftBits, harqAck, csiPart1, csiPart2] = obj.pusch_demodulator_mex('step', ...
+                    single(rxSymbols), cest, noiseVar, PUSCHDemConfig, demuxConfig);
+            else
+                schSoftBits = obj.pusch_demodulator_mex('step', single(rxSymbols), cest, noiseVar, ...
+                    PUSCHDemConfig);
+            end
         end % function step(...)
+
+        function nInputs = getNumInputsImpl(obj)
+            nInputs = 7 + obj.DemultiplexUCI;
+        end
+
+        function nOutputs = getNumOutputsImpl(obj)
+            if obj.DemultiplexUCI
+                nOutputs = 4;
+            else
+                nOutputs = 1;
+            end
+        end
     end % of methods (Access = protected)
 
     methods (Access = private, Static)
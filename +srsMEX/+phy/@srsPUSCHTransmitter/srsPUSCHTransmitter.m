@@ -0,0 +1,150 @@
+%srsPUSCHTransmitter MATLAB interface to a PUSCH transmitter built from srsRAN components.
+%   User-friendly interface to a PUSCH transmitter assembled from srsRAN components
+%   (UL-SCH encoder, scrambler, modulation mapper, layer mapper, transform precoder
+%   and DM-RS generator), which is wrapped by the MEX static method pusch_transmitter_mex.
+%
+%   PUSCHTX = srsPUSCHTransmitter creates a PHY PUSCH transmitter object.
+%
+%   PUSCHTX = srsPUSCHTransmitter(NAME, VALUE, ...) creates a PHY PUSCH transmitter object
+%   with properties (see below) set according to the NAME-VALUE pairs.
+%
+%   srsPUSCHTransmitter Methods:
+%
+%   step               - Encodes, modulates and maps a PUSCH transmission.
+%
+%   Step method syntax
+%
+%   TXGRID = step(PUSCHTX, CARRIER, PUSCH, TRBLK, SEGCONFIG) uses the object PUSCHTX
+%   to encode the transport block TRBLK, a column vector of (unpacked) bits, and to map
+%   the resulting PUSCH transmission, DM-RS included, into the resource grid TXGRID.
+%   TXGRID is a three-dimensional complex array (dimensions are subcarriers, OFDM
+%   symbols and transmission layers), where layer i is mapped onto port i.
+%
+%   CARRIER is an nrCarrierConfig object, with the grid assumed to start at CRB 0.
+%
+%   PUSCH is an nrPUSCHConfig object (the relevant properties are PRBSet, which must
+%   be contiguous, RNTI, NID, Modulation, SymbolAllocation, NumLayers, TransformPrecoding,
+%   DMRS.DMRSConfigurationType, DMRS.NumCDMGroupsWithoutData, DMRS.NIDNSCID, DMRS.NSCID
+%   and DMRS.NRSID).
+%
+%   SEGCONFIG is a structure describing the transport block segmentation, as returned
+%   by srsPUSCHDecoder.configureSegment (the relevant fields are BGN, RV and
+%   LimitedBufferSize).
+%
+%   srsPUSCHTransmitter properties (nontunable):
+%
+%   DMRSAmplitude  - Linear amplitude of the DM-RS with respect to data (default 1).
+%
+%   See also srsPUSCHDecoder, nrPUSCH, nrPUSCHDMRS.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
+
+classdef srsPUSCHTransmitter < matlab.System
+    properties (Nontunable)
+        %Linear amplitude of the DM-RS with respect to data.
+        DMRSAmplitude (1, 1) double {mustBePositive} = 1
+    end
+
+    methods
+        function obj = srsPUSCHTransmitter(varargin)
+            setProperties(obj, nargin, varargin{:});
+        end
+    end
+
+    methods (Access = protected)
+        function txGrid = stepImpl(obj, carrier, pusch, trBlk, segConfig)
+            arguments
+                obj       (1, 1) srsMEX.phy.srsPUSCHTransmitter
+                carrier   (1, 1) nrCarrierConfig
+                pusch     (1, 1) nrPUSCHConfig
+                trBlk     (:, 1) double {mustBeMember(trBlk, [0, 1])}
+                segConfig (1, 1) struct
+            end
+
+            assert(mod(numel(trBlk), 8) == 0, 'srsran_matlab:srsPUSCHTransmitter', ...
+                'The transport block size, %d, is not a multiple of 8.', numel(trBlk));
+            assert(all(diff(pusch.PRBSet) == 1), 'srsran_matlab:srsPUSCHTransmitter', ...
+                'Only contiguous PRB allocations are supported.');
+            assert(~pusch.TransformPrecoding || (pusch.NumLayers == 1), 'srsran_matlab:srsPUSCHTransmitter', ...
+                'Transform precoding requires a single layer.');
+
+            % Generate a PUSCH RB allocation mask.
+            rbAllocationMask = false(carrier.NSizeGrid, 1);
+            rbAllocationMask(pusch.PRBSet + 1) = true;
+
+            % Generate a DM-RS symbol mask.
+            dmrsIndices = nrPUSCHDMRSIndices(carrier, pusch, 'IndexStyle', 'subscript', 'IndexBase', '0based');
+            dmrsSymbolMask = false(carrier.SymbolsPerSlot, 1);
+            dmrsSymbolMask(unique(dmrsIndices(:, 2)) + 1) = true;
+
+            % Fill the configuration structure.
+            PUSCHTxConfig = struct( ...
+                'NSizeGrid', carrier.NSizeGrid, ...
+                'CyclicPrefix', carrier.CyclicPrefix, ...
+                'SubcarrierSpacing', carrier.SubcarrierSpacing, ...
+                'NSlot', mod(carrier.NSlot, carrier.SlotsPerFrame), ...
+                'RNTI', pusch.RNTI, ...
+                'NID', obj.getScramblingID(carrier, pusch), ...
+                'RBMask', rbAllocationMask, ...
+                'Modulation', pusch.Modulation, ...
+                'StartSymbolIndex', pusch.SymbolAllocation(1), ...
+                'NumSymbols', pusch.SymbolAllocation(2), ...
+                'DMRSSymbPos', dmrsSymbolMask, ...
+                'DMRSConfigType', pusch.DMRS.DMRSConfigurationType, ...
+                'NumCDMGroupsWithoutData', pusch.DMRS.NumCDMGroupsWithoutData, ...
+                'NIDNSCID', obj.getDMRSScramblingID(carrier, pusch), ...
+                'NSCID', pusch.DMRS.NSCID, ...
+                'NRSID', obj.getLowPAPRID(carrier, pusch), ...
+                'DMRSAmplitude', obj.DMRSAmplitude, ...
+                'NumLayers', pusch.NumLayers, ...
+                'TransformPrecoding', logical(pusch.TransformPrecoding), ...
+                'BGN', segConfig.BGN, ...
+                'RV', segConfig.RV, ...
+                'LimitedBufferSize', segConfig.LimitedBufferSize);
+
+            txGrid = obj.pusch_transmitter_mex('step', uint8(srsTest.helpers.bitPack(trBlk)), PUSCHTxConfig);
+        end % function step(...)
+    end % of methods (Access = protected)
+
+    methods (Access = private, Static)
+        function nid = getScramblingID(carrier, pusch)
+        %Returns the data scrambling identifier (the cell ID if not configured).
+            nid = pusch.NID;
+            if isempty(nid)
+                nid = carrier.NCellID;
+            end
+        end
+
+        function nid = getDMRSScramblingID(carrier, pusch)
+        %Returns the DM-RS scrambling identifier (the cell ID if not configured).
+            nid = pusch.DMRS.NIDNSCID;
+            if isempty(nid)
+                nid = carrier.NCellID;
+            end
+        end
+
+        function nid = getLowPAPRID(carrier, pusch)
+        %Returns the low-PAPR sequence identifier (the cell ID if not configured).
+            nid = pusch.DMRS.NRSID;
+            if isempty(nid)
+                nid = carrier.NCellID;
+            end
+        end
+
+        %MEX function doing the actual work. See the Doxygen documentation.
+        varargout = pusch_transmitter_mex(varargin)
+    end % of methods (Access = private, Static)
+end % of classdef srsPUSCHTransmitter < matlab.System
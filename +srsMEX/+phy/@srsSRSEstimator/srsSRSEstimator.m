@@ -0,0 +1,121 @@
+%srsSRSEstimator MATLAB interface to srsRAN SRS channel estimator.
+%   User-friendly interface to the srsRAN SRS channel estimator class, which is
+%   wrapped by the MEX static method srs_estimator_mex. The channels of multiple
+%   SRS transmissions sharing the same resource grid (e.g., from multiple UEs) are
+%   estimated in parallel with one call.
+%
+%   SRSEST = srsSRSEstimator creates a PHY SRS channel estimator object.
+%
+%   SRSEST = srsSRSEstimator(NAME, VALUE, ...) creates a PHY SRS channel estimator
+%   object with properties (see below) set according to the NAME-VALUE pairs.
+%
+%   srsSRSEstimator Methods:
+%
+%   step  - Estimates the channel of a list of SRS transmissions.
+%
+%   Step method syntax
+%
+%   EST = step(SRSEST, RXGRID, CARRIER, SRS) uses the object SRSEST to estimate the
+%   channels of the SRS transmissions described by SRS, a single nrSRSConfig object
+%   or a cell array of nrSRSConfig objects, from the received resource grid RXGRID
+%   (dimensions are subcarriers, OFDM symbols and Rx antenna ports). CARRIER is an
+%   nrCarrierConfig object, with the grid assumed to start at CRB 0. EST is a column
+%   structure array with one entry for each SRS transmission and fields
+%
+%   ChannelMatrix  - Wideband channel matrix (Rx ports by SRS ports).
+%   EPRE           - Estimated energy per resource element in decibel.
+%   NoiseVariance  - Estimated noise variance.
+%   TimeAlignment  - Estimated time alignment in seconds.
+%
+%   srsSRSEstimator properties (nontunable):
+%
+%   NumThreads  - Number of worker threads (0, default, for as many as hardware threads).
+%
+%   See also nrSRSConfig, nrSRS.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
+
+classdef srsSRSEstimator < matlab.System
+    properties (Nontunable)
+        %Number of worker threads (0 for as many as hardware threads).
+        NumThreads (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
+    end
+
+    methods
+        function obj = srsSRSEstimator(varargin)
+        %Constructor: sets nontunable properties.
+            setProperties(obj, nargin, varargin{:});
+        end
+    end % of public methods
+
+    methods (Access = protected)
+        function setupImpl(obj)
+        %Creates the pool of SRS estimators inside the MEX function.
+            obj.srs_estimator_mex('new', obj.NumThreads);
+        end % of function setupImpl(obj)
+
+        function est = stepImpl(obj, rxGrid, carrier, srs)
+            arguments
+                obj     (1, 1)     srsMEX.phy.srsSRSEstimator
+                rxGrid  (:, :, :)  double {srsTest.helpers.mustBeResourceGrid}
+                carrier (1, 1)     nrCarrierConfig
+                srs
+            end
+
+            if ~iscell(srs)
+                srs = {srs};
+            end
+
+            nSRS = numel(srs);
+            srsConfigs = cell(nSRS, 1);
+            for iSRS = 1:nSRS
+                srsCfg = srs{iSRS};
+                assert(isa(srsCfg, 'nrSRSConfig'), 'srsran_matlab:srsSRSEstimator', ...
+                    'SRS configurations must be nrSRSConfig objects.');
+                assert(srsCfg.BHop >= srsCfg.BSRS, 'srsran_matlab:srsSRSEstimator', ...
+                    'Frequency hopping is not supported (SRS configuration %d).', iSRS);
+
+                srsConfigs{iSRS} = struct( ...
+                    'NumSRSPorts', srsCfg.NumSRSPorts, ...
+                    'NumSRSSymbols', srsCfg.NumSRSSymbols, ...
+                    'SymbolStart', srsCfg.SymbolStart, ...
+                    'CSRS', srsCfg.CSRS, ...
+                    'NSRSID', srsCfg.NSRSID, ...
+                    'BSRS', srsCfg.BSRS, ...
+                    'KTC', srsCfg.KTC, ...
+                    'KBarTC', srsCfg.KBarTC, ...
+                    'CyclicShift', srsCfg.CyclicShift, ...
+                    'NRRC', srsCfg.NRRC, ...
+                    'FrequencyStart', srsCfg.FrequencyStart, ...
+                    'BHop', srsCfg.BHop, ...
+                    'GroupSeqHopping', srsCfg.GroupSeqHopping, ...
+                    'ResourceType', srsCfg.ResourceType);
+            end
+
+            slotConfig = struct( ...
+                'SubcarrierSpacing', carrier.SubcarrierSpacing, ...
+                'NFrame', mod(carrier.NFrame, 1024), ...
+                'NSlot', mod(carrier.NSlot, carrier.SlotsPerFrame));
+
+            est = obj.srs_estimator_mex('step', single(rxGrid), slotConfig, vertcat(srsConfigs{:}));
+        end % of function stepImpl(...)
+    end % of methods (Access = protected)
+
+    methods (Access = private, Static)
+        %MEX function doing the actual work. See the Doxygen documentation.
+        varargout = srs_estimator_mex(varargin)
+    end % of methods (Access = private, Static)
+end % of classdef srsSRSEstimator < matlab.System
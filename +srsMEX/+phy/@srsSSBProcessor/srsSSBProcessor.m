@@ -0,0 +1,144 @@
+%srsSSBProcessor MATLAB interface to srsRAN SSB processor.
+%   User-friendly interface to the srsRAN SSB processing blocks, which are wrapped
+%   by the MEX static method ssb_processor_mex. All the SS/PBCH blocks of a burst,
+%   possibly of different cells, are mapped into the same half-frame resource grid
+%   with one call. The PSS, SSS and PBCH DM-RS of each block are stored in a
+%   least-recently-used cache inside the MEX, so that only the PBCH is encoded and
+%   modulated when the same cells are processed again.
+%
+%   SSBPROC = srsSSBProcessor creates a PHY SSB processor object.
+%
+%   SSBPROC = srsSSBProcessor(NAME, VALUE, ...) creates a PHY SSB processor object
+%   with properties (see below) set according to the NAME-VALUE pairs.
+%
+%   srsSSBProcessor Methods:
+%
+%   step             - Maps a list of SS/PBCH blocks into a half-frame resource grid.
+%   cacheStatistics  - Returns the statistics of the signal cache.
+%
+%   Step method syntax
+%
+%   TXGRID = step(SSBPROC, CARRIER, SSB) uses the object SSBPROC to map the SS/PBCH
+%   blocks described by the structure array SSB into the resource grid TXGRID, a
+%   complex array spanning the CARRIER.NSizeGrid resource blocks and the OFDM
+%   symbols of one half frame (dimensions are subcarriers, OFDM symbols and antenna
+%   ports). CARRIER is an nrCarrierConfig object with the subcarrier spacing of the
+%   SS/PBCH blocks, with the grid assumed to start at Point A. Each entry of SSB
+%   describes one block with the fields
+%
+%   NCellID         - Physical cell identifier (0...1007).
+%   SSBPattern      - SS/PBCH block pattern ('A', 'B', 'C', 'D' or 'E').
+%   Lmax            - Maximum number of SS/PBCH blocks in a burst (4, 8 or 64).
+%   SSBIndex        - SS/PBCH block index (0...Lmax-1).
+%   SFN             - System frame number (0...1023).
+%   HalfFrame       - Half-frame bit (0 or 1).
+%   KSSB            - Subcarrier offset k_SSB (0...23).
+%   PointAOffset    - Offset between Point A and the SS/PBCH block, in resource blocks.
+%   MIB             - BCH payload as a column vector of 24 unpacked bits.
+%   PSSPowerOffset  - PSS power relative to the SSS in dB (0 or -3).
+%   Port            - Antenna port the block is mapped onto.
+%
+%   Blocks overlapping in the resource grid (e.g., of different cells) are
+%   superimposed.
+%
+%   srsSSBProcessor properties (nontunable):
+%
+%   CacheSize   - Maximum number of cached SS/PBCH block signals (default 1024).
+%   NumThreads  - Number of worker threads (0, default, for as many as hardware threads).
+%
+%   See also srsLib.phy.upper.signal_processors.srsPSS, srsLib.phy.upper.signal_processors.srsSSS,
+%   srsLib.phy.upper.signal_processors.srsPBCHdmrs, srsLib.phy.upper.channel_processors.ssb.srsPBCHencoder,
+%   srsLib.phy.upper.channel_processors.ssb.srsPBCHmodulator.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
+
+classdef srsSSBProcessor < matlab.System
+    properties (Nontunable)
+        %Maximum number of cached SS/PBCH block signals.
+        CacheSize  (1, 1) double {mustBeInteger, mustBePositive} = 1024
+        %Number of worker threads (0 for as many as hardware threads).
+        NumThreads (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
+    end
+
+    methods
+        function obj = srsSSBProcessor(varargin)
+        %Constructor: sets nontunable properties.
+            setProperties(obj, nargin, varargin{:});
+        end
+
+        function stats = cacheStatistics(obj)
+        %cacheStatistics Returns the statistics of the signal cache.
+        %   STATS = cacheStatistics(SSBPROC) returns a structure with fields Size,
+        %   Capacity, Hits, Misses and Evictions.
+            stats = obj.ssb_processor_mex('stats');
+        end
+    end % of public methods
+
+    methods (Access = protected)
+        function setupImpl(obj)
+        %Creates the signal cache and the pool of PBCH workers inside the MEX function.
+            obj.ssb_processor_mex('new', obj.CacheSize, obj.NumThreads);
+        end % of function setupImpl(obj)
+
+        function txGrid = stepImpl(obj, carrier, ssb)
+            arguments
+                obj     (1, 1) srsMEX.phy.srsSSBProcessor
+                carrier (1, 1) nrCarrierConfig
+                ssb     (:, 1) struct
+            end
+
+            import srsLib.phy.helpers.srsSSBgetNumerology
+            import srsLib.phy.helpers.srsSSBgetFirstSymbolIndex
+            import srsLib.phy.helpers.srsSSBgetFirstSubcarrierIndex
+
+            nSSB = numel(ssb);
+            ssbConfigs = cell(nSSB, 1);
+            for iSSB = 1:nSSB
+                ssbCfg = ssb(iSSB);
+
+                numerology = srsSSBgetNumerology(ssbCfg.SSBPattern);
+                assert(carrier.SubcarrierSpacing == 15 * 2^numerology, 'srsran_matlab:srsSSBProcessor', ...
+                    'SSB %d: the carrier subcarrier spacing does not match SS/PBCH block pattern %s.', ...
+                    iSSB, ssbCfg.SSBPattern);
+
+                ssbConfigs{iSSB} = struct( ...
+                    'NCellID', ssbCfg.NCellID, ...
+                    'SSBIndex', ssbCfg.SSBIndex, ...
+                    'Lmax', ssbCfg.Lmax, ...
+                    'SFN', ssbCfg.SFN, ...
+                    'HalfFrame', ssbCfg.HalfFrame, ...
+                    'KSSB', ssbCfg.KSSB, ...
+                    'MIB', double(ssbCfg.MIB(:)), ...
+                    'PSSPowerOffset', ssbCfg.PSSPowerOffset, ...
+                    'FirstSubcarrier', srsSSBgetFirstSubcarrierIndex(numerology, ssbCfg.PointAOffset, ssbCfg.KSSB), ...
+                    'FirstSymbol', srsSSBgetFirstSymbolIndex(ssbCfg.SSBPattern, ssbCfg.SSBIndex), ...
+                    'Port', ssbCfg.Port);
+            end
+
+            gridConfig = struct( ...
+                'NumSubcarriers', carrier.NSizeGrid * 12, ...
+                'NumSymbols', carrier.SymbolsPerSlot * carrier.SlotsPerSubframe * 5, ...
+                'NumPorts', max([ssb.Port]) + 1);
+
+            txGrid = obj.ssb_processor_mex('step', gridConfig, vertcat(ssbConfigs{:}));
+        end % of function stepImpl(...)
+    end % of methods (Access = protected)
+
+    methods (Access = private, Static)
+        %MEX function doing the actual work. See the Doxygen documentation.
+        varargout = ssb_processor_mex(varargin)
+    end % of methods (Access = private, Static)
+end % of classdef srsSSBProcessor < matlab.System
@@ -0,0 +1,113 @@
+%srsTransformPrecoder MATLAB interface to srsRAN transform precoder.
+%   User-friendly interface to the srsRAN transform precoding DFT, which is wrapped
+%   by the MEX static method transform_precoder_mex. The DFT plans of all valid
+%   allocation sizes are created once, and all the OFDM symbols of a slot are
+%   processed with one call.
+%
+%   PRECODER = srsTransformPrecoder creates a PHY transform precoder object.
+%
+%   PRECODER = srsTransformPrecoder(NAME, VALUE, ...) creates a PHY transform precoder
+%   object with properties (see below) set according to the NAME-VALUE pairs.
+%
+%   srsTransformPrecoder Methods:
+%
+%   step  - Applies or reverts transform precoding.
+%
+%   Step method syntax
+%
+%   Y = step(PRECODER, X, NUMPRB) uses the object PRECODER, with Direction set to
+%   'precode', to apply transform precoding to the modulated symbols X, a column
+%   vector spanning an integer number of OFDM symbols of NUMPRB resource blocks.
+%   The result Y matches that of nrTransformPrecode(X, NUMPRB).
+%
+%   [Y, NOISEVAR] = step(PRECODER, X, NUMPRB, EQNOISEVAR) uses the object PRECODER,
+%   with Direction set to 'deprecode', to revert transform precoding on the equalized
+%   symbols X, with noise variances EQNOISEVAR (same size as X). The deprecoded noise
+%   variances NOISEVAR are averaged across the subcarriers of each OFDM symbol. The
+%   results match those of srsTransformDeprecode(X, EQNOISEVAR, NUMPRB, 1).
+%
+%   srsTransformPrecoder properties (nontunable):
+%
+%   Direction  - Processing direction ('precode', 'deprecode').
+%
+%   See also nrTransformPrecode, nrTransformDeprecode,
+%   srsLib.phy.generic_functions.transform_precoding.srsTransformDeprecode.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
+
+classdef srsTransformPrecoder < matlab.System
+    properties (Nontunable)
+        %Processing direction ('precode', 'deprecode').
+        Direction (1, :) char {mustBeMember(Direction, {'precode', 'deprecode'})} = 'deprecode'
+    end
+
+    methods
+        function obj = srsTransformPrecoder(varargin)
+        %Constructor: sets nontunable properties.
+            setProperties(obj, nargin, varargin{:});
+        end
+    end % of public methods
+
+    methods (Access = protected)
+        function num = getNumInputsImpl(obj)
+        %The noise variances are only needed when deprecoding.
+            num = 2 + strcmp(obj.Direction, 'deprecode');
+        end
+
+        function num = getNumOutputsImpl(obj)
+        %The noise variances are only returned when deprecoding.
+            num = 1 + strcmp(obj.Direction, 'deprecode');
+        end
+
+        function [y, noiseVar] = stepImpl(obj, x, numPRB, eqNoiseVar)
+            arguments
+                obj        (1, 1) srsMEX.phy.srsTransformPrecoder
+                x          (:, 1) double {mustBeNumeric}
+                numPRB     (1, 1) double {mustBeInteger, mustBePositive}
+                eqNoiseVar (:, 1) double {mustBeNonnegative} = []
+            end
+
+            numSubC = 12 * numPRB;
+            assert(mod(numel(x), numSubC) == 0, 'srsran_matlab:srsTransformPrecoder', ...
+                'The number of symbols, %d, is not a multiple of the number of allocated subcarriers, %d.', ...
+                numel(x), numSubC);
+            numSymbols = numel(x) / numSubC;
+
+            % The MEX processes all OFDM symbols at once, one per column.
+            xSymbols = single(reshape(x, numSubC, numSymbols));
+
+            if strcmp(obj.Direction, 'precode')
+                y = obj.transform_precoder_mex('precode', xSymbols);
+                y = double(y(:));
+                return;
+            end
+
+            assert(numel(eqNoiseVar) == numel(x), 'srsran_matlab:srsTransformPrecoder', ...
+                'The number of noise variances, %d, does not match the number of symbols, %d.', ...
+                numel(eqNoiseVar), numel(x));
+
+            [y, noiseVar] = obj.transform_precoder_mex('deprecode', xSymbols, ...
+                single(reshape(eqNoiseVar, numSubC, numSymbols)));
+            y = double(y(:));
+            noiseVar = double(noiseVar(:));
+        end % of function stepImpl(...)
+    end % of methods (Access = protected)
+
+    methods (Access = private, Static)
+        %MEX function doing the actual work. See the Doxygen documentation.
+        varargout = transform_precoder_mex(varargin)
+    end % of methods (Access = private, Static)
+end % of classdef srsTransformPrecoder < matlab.System
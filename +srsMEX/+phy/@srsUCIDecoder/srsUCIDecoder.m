@@ -0,0 +1,116 @@
+%srsUCIDecoder MATLAB interface to srsRAN UCI decoder.
+%   User-friendly interface to the srsRAN UCI decoder class, which is wrapped
+%   by the MEX static method uci_decoder_mex. Multiple UCI codewords (e.g., the
+%   HARQ-ACK, CSI Part 1 and CSI Part 2 fields of many UEs) are decoded in parallel
+%   with one call.
+%
+%   UCIDEC = srsUCIDecoder creates a PHY UCI decoder object.
+%
+%   UCIDEC = srsUCIDecoder(NAME, VALUE, ...) creates a PHY UCI decoder object with
+%   properties (see below) set according to the NAME-VALUE pairs.
+%
+%   srsUCIDecoder Methods:
+%
+%   step  - Decodes a list of UCI codewords.
+%
+%   Step method syntax
+%
+%   [UCIBITS, ISVALID] = step(UCIDEC, LLRS, A, MODULATION) uses the object UCIDEC to
+%   decode the UCI codeword LLRS, a column vector of int8 with (quantized) log-likelihood
+%   ratios, into the UCI message UCIBITS of length A. MODULATION is the modulation
+%   scheme used to transmit the codeword (one of 'pi/2-BPSK', 'QPSK', '16QAM', '64QAM'
+%   and '256QAM'). ISVALID is true if the message was decoded successfully. The
+%   decoded message UCIBITS is equivalent to that of nrUCIDecode(LLRS, A, MODULATION).
+%
+%   To decode several UCI codewords at once, LLRS is a cell array with one entry for
+%   each codeword, A is a numeric array with one entry for each codeword and MODULATION
+%   is either a character array (same modulation for all codewords) or a cell array
+%   with one entry for each codeword. UCIBITS is then a cell array and ISVALID a
+%   logical array, with one entry for each codeword.
+%
+%   srsUCIDecoder properties (nontunable):
+%
+%   NumThreads  - Number of worker threads (0, default, for as many as hardware threads).
+%
+%   See also nrUCIDecode.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
+
+classdef srsUCIDecoder < matlab.System
+    properties (Nontunable)
+        %Number of worker threads (0 for as many as hardware threads).
+        NumThreads (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
+    end
+
+    methods
+        function obj = srsUCIDecoder(varargin)
+        %Constructor: sets nontunable properties.
+            setProperties(obj, nargin, varargin{:});
+        end
+    end % of public methods
+
+    methods (Access = protected)
+        function setupImpl(obj)
+        %Creates the pool of UCI decoders inside the MEX function.
+            obj.uci_decoder_mex('new', obj.NumThreads);
+        end % of function setupImpl(obj)
+
+        function [uciBits, isValid] = stepImpl(obj, llrs, A, modulation)
+            arguments
+                obj        (1, 1) srsMEX.phy.srsUCIDecoder
+                llrs
+                A          (:, 1) double {mustBeInteger, mustBeInRange(A, 1, 1706)}
+                modulation
+            end
+
+            isBatch = iscell(llrs);
+            if ~isBatch
+                llrs = {llrs};
+            end
+
+            nUCI = numel(llrs);
+            if ~iscell(modulation)
+                modulation = repmat({modulation}, nUCI, 1);
+            end
+            assert((numel(A) == nUCI) && (numel(modulation) == nUCI), 'srsran_matlab:srsUCIDecoder', ...
+                'The number of LLR arrays, message lengths and modulations must match.');
+
+            uciConfigs = cell(nUCI, 1);
+            for iUCI = 1:nUCI
+                assert(isa(llrs{iUCI}, 'int8'), 'srsran_matlab:srsUCIDecoder', ...
+                    'LLRs must be arrays of int8 (codeword %d).', iUCI);
+                llrs{iUCI} = llrs{iUCI}(:);
+
+                uciConfigs{iUCI} = struct( ...
+                    'MessageLength', A(iUCI), ...
+                    'Modulation', modulation{iUCI});
+            end
+
+            msg = obj.uci_decoder_mex('step', llrs, vertcat(uciConfigs{:}));
+
+            uciBits = arrayfun(@(x) double(x.Message), msg, 'UniformOutput', false);
+            isValid = [msg.isValid].';
+            if ~isBatch
+                uciBits = uciBits{1};
+            end
+        end % of function stepImpl(...)
+    end % of methods (Access = protected)
+
+    methods (Access = private, Static)
+        %MEX function doing the actual work. See the Doxygen documentation.
+        varargout = uci_decoder_mex(varargin)
+    end % of methods (Access = private, Static)
+end % of classdef srsUCIDecoder < matlab.System
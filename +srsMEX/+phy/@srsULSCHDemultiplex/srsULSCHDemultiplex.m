@@ -0,0 +1,127 @@
+%srsULSCHDemultiplex MATLAB interface to srsRAN UL-SCH demultiplexer.
+%   User-friendly interface to the srsRAN UL-SCH demultiplexer class, which is
+%   wrapped by the MEX static method ulsch_demultiplex_mex. The demultiplexer
+%   separates, in a single pass, the UL-SCH data and the UCI (HARQ-ACK, CSI Part 1
+%   and CSI Part 2) soft bits of a PUSCH codeword.
+%
+%   DEMUX = srsULSCHDemultiplex creates a UL-SCH demultiplexer object.
+%
+%   srsULSCHDemultiplex Methods:
+%
+%   step                 - Demultiplexes a PUSCH codeword.
+%   createConfiguration  - Creates the demultiplexer configuration (static).
+%
+%   Step method syntax
+%
+%   [SCHDATA, HARQACK, CSIPART1, CSIPART2] = step(DEMUX, CODEWORD, PUSCH, DEMUXCONFIG)
+%   demultiplexes the descrambled soft bits CODEWORD (an int8 column array, as
+%   returned by srsPUSCHDemodulator) of a PUSCH transmission configured by PUSCH
+%   (an nrPUSCHConfig object, only properties RNTI and NID are relevant). DEMUXCONFIG
+%   is the configuration structure returned by createConfiguration. The outputs are
+%   int8 column arrays with the soft bits of the UL-SCH data SCHDATA, of the HARQ-ACK
+%   HARQACK, of the CSI Part 1 CSIPART1 and of the CSI Part 2 CSIPART2, equivalent
+%   to those returned by nrULSCHDemultiplex after reverting the scrambling
+%   placeholders.
+%
+%   DEMUXCONFIG = srsULSCHDemultiplex.createConfiguration(CARRIER, PUSCH, TCR, TBS, OACK, OCSI1, OCSI2)
+%   creates the demultiplexer configuration for the carrier CARRIER (an nrCarrierConfig
+%   object), the PUSCH configuration PUSCH (an nrPUSCHConfig object), the target code
+%   rate TCR, the transport block size TBS and the number of HARQ-ACK, CSI Part 1
+%   and CSI Part 2 bits OACK, OCSI1 and OCSI2, respectively. The configuration does
+%   not change as long as the allocation and the UCI sizes do not, so it can be
+%   computed once and reused for all slots. It can also be passed to srsPUSCHDemodulator
+%   to demultiplex the codeword as part of the demodulation.
+%
+%   See also nrULSCHDemultiplex, nrULSCHInfo, srsMEX.phy.srsPUSCHDemodulator.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
+
+classdef srsULSCHDemultiplex < matlab.System
+    methods
+        function obj = srsULSCHDemultiplex(varargin)
+        %Constructor: sets nontunable properties.
+            setProperties(obj, nargin, varargin{:});
+        end
+    end % of public methods
+
+    methods (Static)
+        function demuxConfig = createConfiguration(carrier, pusch, tcr, tbs, oAck, oCsi1, oCsi2)
+        %Creates the UL-SCH demultiplexer configuration.
+            arguments
+                carrier (1, 1) nrCarrierConfig
+                pusch   (1, 1) nrPUSCHConfig
+                tcr     (1, 1) double {mustBeInRange(tcr, 0, 1)}
+                tbs     (1, 1) double {mustBeInteger, mustBePositive}
+                oAck    (1, 1) double {mustBeInteger, mustBeNonnegative}
+                oCsi1   (1, 1) double {mustBeInteger, mustBeNonnegative}
+                oCsi2   (1, 1) double {mustBeInteger, mustBeNonnegative}
+            end
+
+            [~, puschInfo] = nrPUSCHIndices(carrier, pusch);
+            ulschInfo = nrULSCHInfo(pusch, tcr, tbs, oAck, oCsi1, oCsi2);
+
+            % Generate a DM-RS symbol mask.
+            dmrsSymbolMask = false(14, 1);
+            dmrsSymbolMask(puschInfo.DMRSSymbolSet + 1) = true;
+
+            demuxConfig = struct( ...
+                'Modulation', pusch.Modulation, ...
+                'NumLayers', pusch.NumLayers, ...
+                'NumPRB', numel(pusch.PRBSet), ...
+                'StartSymbolIndex', pusch.SymbolAllocation(1), ...
+                'NumSymbols', pusch.SymbolAllocation(2), ...
+                'NumHARQAckReserved', ulschInfo.GACKRvd, ...
+                'DMRSConfigType', pusch.DMRS.DMRSConfigurationType, ...
+                'DMRSSymbPos', dmrsSymbolMask, ...
+                'NumCDMGroupsWithoutData', pusch.DMRS.NumCDMGroupsWithoutData, ...
+                'NumHARQAck', oAck, ...
+                'NumEncHARQAck', ulschInfo.GACK, ...
+                'NumCSIPart1', oCsi1, ...
+                'NumEncCSIPart1', ulschInfo.GCSI1, ...
+                'NumCSIPart2', oCsi2, ...
+                'NumEncCSIPart2', ulschInfo.GCSI2, ...
+                'NumEncULSCH', ulschInfo.GULSCH);
+        end % of function demuxConfig = createConfiguration(...)
+    end % of methods (Static)
+
+    methods (Access = protected)
+        function setupImpl(obj)
+        %Creates the UL-SCH demultiplexer inside the MEX function.
+            obj.ulsch_demultiplex_mex('new');
+        end % of function setupImpl(obj)
+
+        function [schData, harqAck, csiPart1, csiPart2] = stepImpl(obj, codeword, pusch, demuxConfig)
+            arguments
+                obj         (1, 1) srsMEX.phy.srsULSCHDemultiplex
+                codeword    (:, 1) int8
+                pusch       (1, 1) nrPUSCHConfig
+                demuxConfig (1, 1) struct
+            end
+
+            assert(~isempty(pusch.NID), 'srsran_matlab:srsULSCHDemultiplex', ...
+                'The PUSCH scrambling identity NID must be set.');
+            scramblingConfig = struct('RNTI', pusch.RNTI, 'NID', pusch.NID);
+
+            [schData, harqAck, csiPart1, csiPart2] = obj.ulsch_demultiplex_mex('step', codeword, demuxConfig, ...
+                scramblingConfig);
+        end % of function stepImpl(...)
+    end % of methods (Access = protected)
+
+    methods (Access = private, Static)
+        %MEX function doing the actual work. See the Doxygen documentation.
+        varargout = ulsch_demultiplex_mex(varargin)
+    end % of methods (Access = private, Static)
+end % of classdef srsULSCHDemultiplex < matlab.System
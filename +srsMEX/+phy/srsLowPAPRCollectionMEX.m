@@ -0,0 +1,28 @@
+%srsLowPAPRCollectionMEX Low-PAPR sequence collection
+%   SEQUENCES = srsLowPAPRCollectionMEX(M, DELTA, ALPHAS, CACHEDIR) returns all the
+%   sequences of the srsRAN low-PAPR sequence collection with parameters M and DELTA
+%   (see TS38.211 Section 5.2.2) and cyclic shifts ALPHAS (single-precision row, in
+%   radians). SEQUENCES is a complex single-precision array of size
+%   [MZC, numel(ALPHAS), 2, 30], with MZC = M * 12 / 2^DELTA, indexed by sample,
+%   cyclic shift, sequence base v and sequence group u.
+%
+%   If CACHEDIR is empty, the collection is generated by the srsRAN software factory.
+%   Otherwise, it is mapped from the cache files in CACHEDIR, as done by the PUCCH
+%   processor, and the missing cache file is built first. CACHEDIR is created with
+%   permissions 0700 if it does not exist, and it is not used if it is not owned by
+%   the user or if other users can write to it.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
@@ -0,0 +1,118 @@
+%srsPRACHPERFEngine Native multi-threaded PRACH performance simulation engine.
+%   User-friendly interface to a C++ simulation engine, which is wrapped by the
+%   MEX static method prach_perf_engine_mex. The engine simulates the PRACH link
+%   of the PRACHPERF simulator (timing offset, fading channel or AWGN, frequency
+%   offset, srsRAN OFDM PRACH demodulation and detection) on a pool of worker
+%   threads, each one owning its own channel and receiver.
+%
+%   ENGINE = srsPRACHPERFEngine creates a simulation engine object, ENGINE.
+%
+%   ENGINE = srsPRACHPERFEngine(NAME, VALUE, ...) creates a simulation engine
+%   object with properties (see below) set according to the NAME-VALUE pairs.
+%
+%   srsPRACHPERFEngine Methods:
+%
+%   step  - Simulates the PRACH link for a list of SNR values.
+%
+%   Step method syntax
+%
+%   COUNTERS = step(ENGINE, CONFIG, WAVEFORM, SNRIN, NOCCASIONS, MAXFAILURES, THRESHOLDS, EDGES)
+%   simulates NOCCASIONS PRACH occasions of the link described by the structure
+%   CONFIG for each SNR value (in dB) in SNRIN. The SNR is defined as in PRACHPERF,
+%   i.e., per resource element and per receive antenna. srsRAN does not provide a
+%   time-domain PRACH modulator: WAVEFORM is the column vector returned by
+%   srsPRACHgenerator, which the engine delays by the timing offsets in
+%   CONFIG.TimingOffsets, one after the other.
+%
+%   The detection outcome of each occasion is evaluated against all the detection
+%   thresholds in THRESHOLDS at once. Thresholds are normalized to the srsRAN
+%   detection threshold and cannot be lower than one (the srsRAN default). When
+%   MAXFAILURES is positive, the simulation of an SNR value stops at the occasion
+%   where the number of failures with the first threshold (missed detections in
+%   detection tests, false detections in false alarm tests) exceeds MAXFAILURES.
+%   EDGES are the edges, in microseconds, of the bins of the timing error histogram
+%   (as in histcounts), possibly empty. COUNTERS is a structure array with one
+%   entry for each SNR value and fields
+%      NumOccasions          - Number of simulated PRACH occasions.
+%      Detected              - Number of detected occasions (any preamble in false
+%                              alarm tests, the transmitted one in detection tests).
+%      DetectedPerfect       - Number of occasions where the transmitted preamble is
+%                              detected with a timing error within tolerance.
+%      TimingErrorSum        - Sum of the timing errors (microseconds) of the
+%                              detected occasions.
+%      TimingErrorSqSum      - Sum of the squared timing errors of the detected occasions.
+%      TimingErrorHistogram  - Histogram of the timing errors of the detected occasions.
+%   All fields but NumOccasions have one entry for each threshold (one column for
+%   each threshold and one row for each histogram bin, for TimingErrorHistogram).
+%
+%   The fields of CONFIG are described in the Doxygen documentation of the MEX
+%   function. The fading channel and the random generators restart at every
+%   occasion, with counter-based random streams identified by CONFIG.Seed and the
+%   SNR and occasion indices: the results do not depend on the number of threads
+%   nor on the MATLAB global random generator.
+%
+%   srsPRACHPERFEngine properties (nontunable):
+%
+%   NumThreads  - Number of worker threads (0, default, for as many as hardware threads).
+%
+%   See also PRACHPERF, PRACHthresholds, srsPRACHDemodulator.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
+
+classdef srsPRACHPERFEngine < matlab.System
+    properties (Nontunable)
+        %Number of worker threads (0 for as many as hardware threads).
+        NumThreads (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
+    end % of properties (Nontunable)
+
+    methods
+        function obj = srsPRACHPERFEngine(varargin)
+        %Constructor: sets nontunable properties.
+            setProperties(obj, nargin, varargin{:});
+        end
+    end % of public methods
+
+    methods (Access = protected)
+        function setupImpl(obj, ~, ~, ~, ~, ~, ~, ~)
+        %Sets the number of workers inside the MEX function.
+            obj.prach_perf_engine_mex('new', obj.NumThreads);
+        end % of function setupImpl(obj, ~, ~, ~, ~, ~, ~, ~)
+
+        function counters = stepImpl(obj, config, waveform, SNRIn, nOccasions, maxFailures, thresholds, edges)
+            arguments
+                obj         (1, 1) srsMEX.simulators.srsPRACHPERFEngine
+                config      (1, 1) struct
+                waveform    (:, 1) {mustBeNumeric}
+                SNRIn       (1, :) double {mustBeReal, mustBeFinite}
+                nOccasions  (1, 1) double {mustBeInteger, mustBePositive}
+                maxFailures (1, 1) double {mustBeInteger, mustBeNonnegative}
+                thresholds  (1, :) double {mustBeNonempty, mustBeFinite, mustBeGreaterThanOrEqual(thresholds, 1)}
+                edges       (1, :) double {mustBeReal, mustBeFinite}
+            end
+
+            % The MEX expects a complex single-precision waveform.
+            waveform = complex(single(waveform));
+
+            counters = obj.prach_perf_engine_mex('step', config, waveform, SNRIn, nOccasions, maxFailures, ...
+                thresholds, edges);
+        end % of function stepImpl(...)
+    end % of methods (Access = protected)
+
+    methods (Access = private, Static)
+        %MEX function doing the actual work. See the Doxygen documentation.
+        varargout = prach_perf_engine_mex(varargin)
+    end % of methods (Access = private, Static)
+end % of classdef srsPRACHPERFEngine < matlab.System
@@ -0,0 +1,141 @@
+%srsPUCCHPERFEngine Native multi-threaded PUCCH performance simulation engine.
+%   User-friendly interface to a C++ simulation engine, which is wrapped by the
+%   MEX static method pucch_perf_engine_mex. The engine simulates the PUCCH link
+%   of the PUCCHPERF simulator (OFDM modulation, fading channel and AWGN, OFDM
+%   demodulation and srsRAN PUCCH processing) for all PUCCH formats on a pool of
+%   worker threads, each one owning its own channel and receiver.
+%
+%   ENGINE = srsPUCCHPERFEngine creates a simulation engine object, ENGINE.
+%
+%   ENGINE = srsPUCCHPERFEngine(NAME, VALUE, ...) creates a simulation engine
+%   object with properties (see below) set according to the NAME-VALUE pairs.
+%
+%   srsPUCCHPERFEngine Methods:
+%
+%   step  - Simulates the PUCCH link for a list of SNR values.
+%
+%   Step method syntax
+%
+%   COUNTERS = step(ENGINE, CONFIG, TXGRIDS, PAYLOADS, SNRIN, NFRAMES, MAXERRORS)
+%   simulates NFRAMES frames of the PUCCH link described by the structure CONFIG
+%   for each SNR value (in dB) in SNRIN. The SNR is defined as in PUCCHPERF, i.e.,
+%   per resource element and per receive antenna. srsRAN does not provide PUCCH
+%   modulators: the transmitted signal is taken from a codebook made of the UCI
+%   payloads in the columns of the int8 matrix PAYLOADS and of the resource grids
+%   in TXGRIDS, a complex single array of size NumSubcarriers-by-NumSymbols-by-
+%   NumCodewords-by-SlotsPerFrame, where TXGRIDS(:, :, c, s) carries payload c in
+%   slot s-1 of a frame. Each slot carries one PUCCH transmission with a randomly
+%   selected payload. When MAXERRORS is positive, the simulation of an SNR value
+%   stops at the frame where the number of errors reaches MAXERRORS. When
+%   TargetWidth or TargetRelativeWidth are positive, the simulation of an SNR value
+%   also stops at the frame where the confidence interval of the error rate is
+%   narrow enough (see below), and the workers move to the SNR values that are
+%   still running. In all cases, NFRAMES is the maximum number of frames of each
+%   SNR value. COUNTERS is a structure array with one entry for each SNR value and
+%   fields
+%      NumOccasions      - Number of simulated PUCCH occasions.
+%      NumACKs           - Number of transmitted HARQ-ACK bits set to one.
+%      NumNACKs          - Number of transmitted HARQ-ACK bits set to zero.
+%      MissedDetections  - Number of transmissions that were not detected.
+%      ACKErrors         - Number of erroneous HARQ-ACK bits.
+%      SRErrors          - Number of erroneous SR bits.
+%      MissedACKs        - Number of ACKs received as NACKs or not detected.
+%      NACK2ACKs         - Number of NACKs received as ACKs.
+%      BlockErrors       - Number of UCI messages not detected or with any erroneous bit.
+%      FalseDetections   - Number of UCI messages detected when only noise is received.
+%      FalseACKs         - Number of ACKs detected when only noise is received.
+%
+%   The fields of CONFIG and the errors counted for MAXERRORS are described in the
+%   Doxygen documentation of the MEX function. The fading channel and the random
+%   generators restart at every frame, with counter-based random streams identified
+%   by CONFIG.Seed and the SNR and frame indices: the results do not depend on the
+%   number of threads nor on the MATLAB global random generator.
+%
+%   srsPUCCHPERFEngine properties (nontunable):
+%
+%   NumThreads           - Number of worker threads (0, default, for as many as hardware threads).
+%   ConfidenceLevel      - Confidence level of the error rate confidence interval (default 0.95).
+%   IntervalType         - Method for computing the error rate confidence interval ('Wilson',
+%                          default, 'Clopper-Pearson').
+%   TargetWidth          - Target absolute width of the error rate confidence interval (0, default,
+%                          for no target).
+%   TargetRelativeWidth  - Target width of the error rate confidence interval relative to the error
+%                          rate (0, default, for no target).
+%
+%   An SNR value is accurate enough when the width of the confidence interval of
+%   its error rate (the rate of the errors counted for MAXERRORS) does not exceed
+%   TargetWidth or TargetRelativeWidth times the error rate.
+%
+%   See also PUCCHPERF, srsPUCCHProcessor.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
+
+classdef srsPUCCHPERFEngine < matlab.System
+    properties (Nontunable)
+        %Number of worker threads (0 for as many as hardware threads).
+        NumThreads (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
+        %Confidence level of the error rate confidence interval.
+        ConfidenceLevel (1, 1) double {mustBeGreaterThan(ConfidenceLevel, 0), mustBeLessThan(ConfidenceLevel, 1)} = 0.95
+        %Method for computing the error rate confidence interval ('Wilson', 'Clopper-Pearson').
+        IntervalType (1, :) char {mustBeMember(IntervalType, {'Wilson', 'Clopper-Pearson'})} = 'Wilson'
+        %Target absolute width of the error rate confidence interval (0 for no target).
+        TargetWidth (1, 1) double {mustBeReal, mustBeNonnegative} = 0
+        %Target width of the error rate confidence interval relative to the error rate (0 for no target).
+        TargetRelativeWidth (1, 1) double {mustBeReal, mustBeNonnegative} = 0
+    end % of properties (Nontunable)
+
+    methods
+        function obj = srsPUCCHPERFEngine(varargin)
+        %Constructor: sets nontunable properties.
+            setProperties(obj, nargin, varargin{:});
+        end
+    end % of public methods
+
+    methods (Access = protected)
+        function setupImpl(obj, ~, ~, ~, ~, ~, ~)
+        %Sets the number of workers inside the MEX function.
+            obj.pucch_perf_engine_mex('new', obj.NumThreads);
+        end % of function setupImpl(obj, ~, ~, ~, ~, ~, ~)
+
+        function counters = stepImpl(obj, config, txGrids, payloads, SNRIn, nFrames, maxErrors)
+            arguments
+                obj       (1, 1) srsMEX.simulators.srsPUCCHPERFEngine
+                config    (1, 1) struct
+                txGrids   (:, :, :, :) single
+                payloads  (:, :) int8
+                SNRIn     (1, :) double {mustBeReal, mustBeFinite}
+                nFrames   (1, 1) double {mustBeInteger, mustBePositive}
+                maxErrors (1, 1) double {mustBeInteger, mustBeNonnegative}
+            end
+
+            % The MEX expects a complex array, even if all grids are real.
+            if isreal(txGrids)
+                txGrids = complex(txGrids);
+            end
+
+            stopping = struct('ConfidenceLevel', obj.ConfidenceLevel, 'IntervalType', obj.IntervalType, ...
+                'TargetWidth', obj.TargetWidth, 'TargetRelativeWidth', obj.TargetRelativeWidth);
+
+            counters = obj.pucch_perf_engine_mex('step', config, txGrids, payloads, SNRIn, nFrames, maxErrors, ...
+                stopping);
+        end % of function stepImpl(...)
+    end % of methods (Access = protected)
+
+    methods (Access = private, Static)
+        %MEX function doing the actual work. See the Doxygen documentation.
+        varargout = pucch_perf_engine_mex(varargin)
+    end % of methods (Access = private, Static)
+end % of classdef srsPUCCHPERFEngine < matlab.System
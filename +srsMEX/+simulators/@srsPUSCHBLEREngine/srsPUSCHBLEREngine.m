@@ -0,0 +1,129 @@
+%srsPUSCHBLEREngine Native multi-threaded PUSCH BLER simulation engine.
+%   User-friendly interface to a C++ simulation engine, which is wrapped by the
+%   MEX static method pusch_bler_engine_mex. The engine simulates the complete
+%   PUSCH link of the PUSCHBLER simulator (transmitter, fading channel, CFO and
+%   AWGN, OFDM demodulation, channel estimation, demodulation and decoding with
+%   HARQ) on a pool of worker threads, each one owning its own transmitter,
+%   channel, receiver and softbuffer pool.
+%
+%   ENGINE = srsPUSCHBLEREngine creates a simulation engine object, ENGINE.
+%
+%   ENGINE = srsPUSCHBLEREngine(NAME, VALUE, ...) creates a simulation engine
+%   object with properties (see below) set according to the NAME-VALUE pairs.
+%
+%   srsPUSCHBLEREngine Methods:
+%
+%   step  - Simulates the PUSCH link for a list of SNR values.
+%
+%   Step method syntax
+%
+%   COUNTERS = step(ENGINE, CONFIG, SNRIN, NFRAMES, MAXMISSED) simulates NFRAMES
+%   frames of the PUSCH link described by the structure CONFIG for each SNR value
+%   (in dB) in SNRIN. The SNR is defined as in PUSCHBLER, i.e., per resource
+%   element and per receive antenna. When MAXMISSED is positive, the simulation of
+%   an SNR value stops at the frame where the number of missed transport blocks
+%   reaches MAXMISSED. When TargetWidth or TargetRelativeWidth are positive, the
+%   simulation of an SNR value also stops at the frame where the confidence
+%   interval of the BLER is narrow enough (see below), and the workers move to the
+%   SNR values that are still running. In all cases, NFRAMES is the maximum number
+%   of frames of each SNR value. COUNTERS is a structure array with one entry for
+%   each SNR value and fields
+%      NumFrames           - Number of simulated frames.
+%      NumSlots            - Number of simulated slots, including those that complete the
+%                            retransmissions after the end of a frame.
+%      MaxThroughput       - Number of transmitted bits.
+%      Throughput          - Number of correctly received bits.
+%      TotalBlocks         - Number of transport blocks.
+%      MissedBlocks        - Number of transport blocks missed after all retransmissions.
+%      DecIterations       - Sum of the average LDPC iterations of all transmissions.
+%      DecIterationsCRCOK  - Sum of the average LDPC iterations of the transmissions with valid CRC.
+%      RSRP                - Sum of the RSRP estimated in every slot.
+%      NoiseVar            - Sum of the noise variance estimated in every slot.
+%
+%   The fields of CONFIG are described in the Doxygen documentation of the MEX
+%   function. The HARQ processes, the fading channel and the random generators
+%   restart at every frame, with counter-based random streams identified by
+%   CONFIG.Seed and the SNR and frame indices: the results do not depend on the
+%   number of threads nor on the MATLAB global random generator.
+%
+%   srsPUSCHBLEREngine properties (nontunable):
+%
+%   NumThreads           - Number of worker threads (0, default, for as many as hardware threads).
+%   ConfidenceLevel      - Confidence level of the BLER confidence interval (default 0.95).
+%   IntervalType         - Method for computing the BLER confidence interval ('Wilson', default,
+%                          'Clopper-Pearson').
+%   TargetWidth          - Target absolute width of the BLER confidence interval (0, default, for
+%                          no target).
+%   TargetRelativeWidth  - Target width of the BLER confidence interval relative to the BLER
+%                          (0, default, for no target).
+%
+%   An SNR value is accurate enough when the width of the confidence interval of
+%   its BLER does not exceed TargetWidth or TargetRelativeWidth times the BLER. The
+%   absolute target stops the SNR values with few or no errors, the relative one
+%   stops the SNR values in the waterfall region of the BLER curve.
+%
+%   See also PUSCHBLER.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
+
+classdef srsPUSCHBLEREngine < matlab.System
+    properties (Nontunable)
+        %Number of worker threads (0 for as many as hardware threads).
+        NumThreads (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
+        %Confidence level of the BLER confidence interval.
+        ConfidenceLevel (1, 1) double {mustBeGreaterThan(ConfidenceLevel, 0), mustBeLessThan(ConfidenceLevel, 1)} = 0.95
+        %Method for computing the BLER confidence interval ('Wilson', 'Clopper-Pearson').
+        IntervalType (1, :) char {mustBeMember(IntervalType, {'Wilson', 'Clopper-Pearson'})} = 'Wilson'
+        %Target absolute width of the BLER confidence interval (0 for no target).
+        TargetWidth (1, 1) double {mustBeReal, mustBeNonnegative} = 0
+        %Target width of the BLER confidence interval relative to the BLER (0 for no target).
+        TargetRelativeWidth (1, 1) double {mustBeReal, mustBeNonnegative} = 0
+    end % of properties (Nontunable)
+
+    methods
+        function obj = srsPUSCHBLEREngine(varargin)
+        %Constructor: sets nontunable properties.
+            setProperties(obj, nargin, varargin{:});
+        end
+    end % of public methods
+
+    methods (Access = protected)
+        function setupImpl(obj, ~, ~, ~, ~)
+        %Sets the number of workers inside the MEX function.
+            obj.pusch_bler_engine_mex('new', obj.NumThreads);
+        end % of function setupImpl(obj, ~, ~, ~, ~)
+
+        function counters = stepImpl(obj, config, SNRIn, nFrames, maxMissed)
+            arguments
+                obj       (1, 1) srsMEX.simulators.srsPUSCHBLEREngine
+                config    (1, 1) struct
+                SNRIn     (1, :) double {mustBeReal, mustBeFinite}
+                nFrames   (1, 1) double {mustBeInteger, mustBePositive}
+                maxMissed (1, 1) double {mustBeInteger, mustBeNonnegative}
+            end
+
+            stopping = struct('ConfidenceLevel', obj.ConfidenceLevel, 'IntervalType', obj.IntervalType, ...
+                'TargetWidth', obj.TargetWidth, 'TargetRelativeWidth', obj.TargetRelativeWidth);
+
+            counters = obj.pusch_bler_engine_mex('step', config, SNRIn, nFrames, maxMissed, stopping);
+        end % of function stepImpl(...)
+    end % of methods (Access = protected)
+
+    methods (Access = private, Static)
+        %MEX function doing the actual work. See the Doxygen documentation.
+        varargout = pusch_bler_engine_mex(varargin)
+    end % of methods (Access = private, Static)
+end % of classdef srsPUSCHBLEREngine < matlab.System
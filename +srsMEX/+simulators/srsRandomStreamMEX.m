@@ -0,0 +1,29 @@
+%srsRandomStreamMEX Counter-based random streams of the native simulation engines.
+%   Gives access to the Philox4x32-10 random streams used by the native channel
+%   models and simulation engines, mainly for testing purposes.
+%
+%   BLOCK = srsRandomStreamMEX('block', COUNTER, KEY) returns the Philox4x32-10
+%   block of the counter COUNTER (four uint32 words) and the key KEY (two uint32
+%   words), least significant word first. BLOCK is a row of four uint32 words.
+%
+%   WORDS = srsRandomStreamMEX('stream', STREAMID, NWORDS) returns the first NWORDS
+%   64-bit words (uint64 column) of the random stream identified by STREAMID, a
+%   uint64 array with the seed, the SNR index, the item index (e.g., the frame),
+%   the slot index, the purpose (0 generic, 1 transport block, 2 payload, 3 fading,
+%   4 noise) and the substream index. Each 64-bit word packs two consecutive
+%   32-bit words of the block, the first one being the most significant.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
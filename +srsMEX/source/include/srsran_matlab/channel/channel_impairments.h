@@ -0,0 +1,150 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Channel impairments (timing offset, carrier frequency offset and AWGN) declaration.
+
+#pragma once
+
+#include "srsran_matlab/support/random_stream.h"
+#include "srsran/adt/complex.h"
+#include "srsran/adt/span.h"
+#include <cstdint>
+#include <vector>
+
+namespace srsran_matlab {
+
+/// \brief Complex Gaussian noise generator.
+///
+/// The generator draws blocks of uniform random numbers from a counter-based random stream and transforms them into
+/// Gaussian ones with the Box&ndash;Muller method, one complex sample for each 64-bit random word. Generators with
+/// different stream identifiers are independent: they can be run concurrently by different threads and the result
+/// does not depend on the number of threads.
+class gaussian_noise_generator
+{
+public:
+  /// Creates a generator for the given random stream.
+  explicit gaussian_noise_generator(const random_stream_id& id = {}) { reset(id); }
+
+  /// Restarts the generator from the given random stream.
+  void reset(const random_stream_id& id) { engine.reset(id); }
+
+  /// \brief Adds circularly-symmetric complex Gaussian noise to a buffer.
+  ///
+  /// \param[in,out] buffer     Samples the noise is added to.
+  /// \param[in]     noise_var  Noise variance, i.e., the average power of the complex noise samples.
+  void add_noise(srsran::span<srsran::cf_t> buffer, float noise_var);
+
+private:
+  /// Number of samples generated at once.
+  static constexpr unsigned BLOCK_SIZE = 1024;
+
+  /// Random stream.
+  random_stream engine;
+  /// Random words of the current block.
+  std::vector<uint64_t> words = std::vector<uint64_t>(BLOCK_SIZE);
+};
+
+/// Channel impairments configuration.
+struct channel_impairments_config {
+  /// Number of antenna ports.
+  unsigned nof_ports = 1;
+  /// Sampling rate in hertz.
+  double sampling_rate = 30.72e6;
+  /// Carrier frequency offset in hertz.
+  double cfo = 0;
+  /// Timing offset (delay) in samples, possibly fractional.
+  double timing_offset = 0;
+  /// Seed of the noise generators.
+  uint64_t seed = 0;
+};
+
+/// \brief Channel impairments.
+///
+/// Applies, in this order, a timing offset (delay), a carrier frequency offset and additive white Gaussian noise to a
+/// multiport waveform. The stage keeps the delay line memory and the phase of the frequency offset between calls to
+/// run(), so that a long waveform can be processed in consecutive blocks (e.g., slots). The noise of each port is
+/// drawn from an independent random stream, namely the stream of the stage with the port index as substream, which
+/// makes it possible to process the ports concurrently without sharing any random generator state.
+///
+/// Integer timing offsets are pure delays. Fractional ones are implemented by a windowed-sinc filter centered at the
+/// timing offset. Since the filter is causal, it is truncated when the timing offset is lower than \ref
+/// FILTER_HALF_LENGTH samples: for an accurate fractional delay, the timing offset should be larger than that.
+class channel_impairments
+{
+public:
+  /// Maximum distance, in samples, between the center and the last nonzero tap of the fractional delay filter.
+  static constexpr unsigned FILTER_HALF_LENGTH = 8;
+
+  /// Creates a channel impairment stage at time zero.
+  explicit channel_impairments(const channel_impairments_config& config_);
+
+  /// Sets the time to zero, clears the delay line and restarts the noise generators from the seed.
+  void reset();
+
+  /// Same as reset(), but with a new seed.
+  void reset(uint64_t seed);
+
+  /// \brief Same as reset(), but with a new random stream.
+  ///
+  /// The seed of the stage becomes the seed of the stream. The substream field is ignored, since it is replaced by the
+  /// port index.
+  void reset(const random_stream_id& id);
+
+  /// \brief Applies the impairments to a block of samples of a single port, in place.
+  ///
+  /// The ports of a block can be processed in any order and concurrently, as long as each port is processed once.
+  /// The block is over when advance() is called.
+  ///
+  /// \param[in,out] buffer     Samples of the port.
+  /// \param[in]     i_port     Port index.
+  /// \param[in]     noise_var  Noise variance of the port. No noise is added if it is zero.
+  void run(srsran::span<srsran::cf_t> buffer, unsigned i_port, float noise_var);
+
+  /// Moves the time forward by a number of samples, typically the size of the block processed by run().
+  void advance(unsigned nof_samples) { sample_index += nof_samples; }
+
+  /// Returns the configuration.
+  const channel_impairments_config& get_config() const { return config; }
+
+private:
+  /// Applies the timing offset, in place.
+  void apply_delay(srsran::span<srsran::cf_t> buffer, unsigned i_port);
+
+  /// Applies the carrier frequency offset, in place.
+  void apply_cfo(srsran::span<srsran::cf_t> buffer) const;
+
+  /// Configuration.
+  channel_impairments_config config;
+  /// Index of the first sample of the current block since the last reset.
+  uint64_t sample_index = 0;
+  /// Delay filter taps. A single tap for integer timing offsets.
+  std::vector<float> delay_taps;
+  /// Index of the first delay filter tap, i.e., delay of the first tap in samples.
+  unsigned delay_offset;
+  /// Delay line of each port: the last <tt>delay_offset + delay_taps.size() - 1</tt> samples of the previous block,
+  /// followed by the current block.
+  std::vector<std::vector<srsran::cf_t>> delay_lines;
+  /// Random stream of the noise generators, with the substream set to zero.
+  random_stream_id noise_stream;
+  /// Noise generators, one for each port.
+  std::vector<gaussian_noise_generator> noise_generators;
+};
+
+} // namespace srsran_matlab
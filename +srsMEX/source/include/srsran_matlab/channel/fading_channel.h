@@ -0,0 +1,192 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Tapped delay line (TDL) fading channel declaration.
+
+#pragma once
+
+#include "srsran_matlab/support/random_stream.h"
+#include "srsran/adt/complex.h"
+#include "srsran/adt/span.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace srsran_matlab {
+
+/// Fading channel configuration.
+struct fading_channel_config {
+  /// Path delays in seconds.
+  std::vector<double> path_delays = {0};
+  /// Average path gains in decibel, one for each path.
+  std::vector<double> average_path_gains = {0};
+  /// Maximum Doppler shift in hertz.
+  double max_doppler_shift = 0;
+  /// Sampling rate in hertz.
+  double sampling_rate = 30.72e6;
+  /// Number of transmit antenna ports.
+  unsigned nof_tx_ports = 1;
+  /// Number of receive antenna ports.
+  unsigned nof_rx_ports = 1;
+  /// \brief Correlation coefficient between the first and the last transmit antennas.
+  ///
+  /// The correlation between antennas \f$i\f$ and \f$j\f$ is \f$\rho^{((i-j)/(N-1))^2}\f$, as in TS38.104 Annex G.
+  double tx_correlation = 0;
+  /// Correlation coefficient between the first and the last receive antennas (see \ref tx_correlation).
+  double rx_correlation = 0;
+  /// Number of sinusoids per fading process.
+  unsigned nof_sinusoids = 48;
+  /// Number of path gain snapshots per half period of the maximum Doppler shift.
+  unsigned sample_density = 64;
+  /// Set to \c true to scale the average path gains so that their total power is one.
+  bool normalize_path_gains = true;
+  /// Set to \c true to scale the channel output by the square root of the number of receive ports.
+  bool normalize_outputs = true;
+  /// Seed of the random parameters (angles of arrival and phases) of the fading processes.
+  uint64_t seed = 73;
+};
+
+/// \brief Fills the path delays and average gains of a standard delay profile.
+///
+/// Supported profiles are <tt>"TDL-A"</tt>, <tt>"TDL-B"</tt> and <tt>"TDL-C"</tt> from TR38.901 Section 7.7.2, whose
+/// normalized delays are scaled by \c delay_spread, and the simplified profiles <tt>"TDLA30"</tt>,
+/// <tt>"TDLB100"</tt> and <tt>"TDLC300"</tt> from TS38.104 Annex G.2, which ignore \c delay_spread.
+/// \param[out] config        Fading channel configuration whose paths are set.
+/// \param[in]  profile       Delay profile name.
+/// \param[in]  delay_spread  Delay spread in seconds.
+/// \return \c true if the profile is known, \c false otherwise (\c config is not modified).
+bool set_tdl_delay_profile(fading_channel_config& config, const std::string& profile, double delay_spread);
+
+/// \brief Tapped delay line fading channel.
+///
+/// Each path is a Rayleigh fading process generated by a sum of sinusoids (generalized method of exact Doppler
+/// spread), which results in the Jakes Doppler spectrum. The fading processes of the transmit&ndash;receive links of
+/// a path are spatially correlated according to the Kronecker model. The path gains are computed at a rate of
+/// \ref fading_channel_config::sample_density snapshots per half period of the maximum Doppler shift and linearly
+/// interpolated in between.
+///
+/// The path delays are implemented by windowed-sinc fractional delay filters, all of them with the same
+/// implementation delay of \ref FILTER_DELAY samples. The channel keeps the filter memory and the fading time
+/// between calls to run(), so that a long waveform can be processed in consecutive blocks (e.g., slots).
+class fading_channel
+{
+public:
+  /// Implementation delay of the path filters in samples.
+  static constexpr unsigned FILTER_DELAY = 7;
+
+  /// Creates a fading channel, with the fading time set to zero.
+  explicit fading_channel(const fading_channel_config& config_);
+
+  /// Sets the fading time to zero, clears the filter memory and draws again the fading processes from the seed.
+  void reset();
+
+  /// Same as reset(), but with a new seed.
+  void reset(uint64_t seed);
+
+  /// Same as reset(), but with a new random stream. The seed of the channel becomes the seed of the stream.
+  void reset(const random_stream_id& id);
+
+  /// \brief Passes a block of samples through the channel.
+  ///
+  /// \param[out] output  Received samples, \c nof_samples for each receive port, one port after the other.
+  /// \param[in]  input   Transmitted samples, \c nof_samples for each transmit port, one port after the other.
+  /// \remark The number of samples is inferred from the size of \c input.
+  void run(srsran::span<srsran::cf_t> output, srsran::span<const srsran::cf_t> input);
+
+  /// Returns the channel configuration, with the path gains normalized if requested.
+  const fading_channel_config& get_config() const { return config; }
+
+  /// Returns the number of paths.
+  unsigned get_nof_paths() const { return config.path_delays.size(); }
+
+  /// Returns the number of taps of the path filters.
+  unsigned get_filter_length() const { return filter_length; }
+
+  /// \brief Returns the path filters.
+  ///
+  /// The filters are stored one after the other, \ref get_filter_length() taps each.
+  std::vector<float> get_path_filters() const;
+
+  /// Returns the number of path gain snapshots computed by the last call to run().
+  unsigned get_nof_snapshots() const { return snapshot_times.size(); }
+
+  /// Returns the sampling instants, in seconds, of the path gain snapshots computed by the last call to run().
+  srsran::span<const double> get_snapshot_times() const { return snapshot_times; }
+
+  /// \brief Returns the path gain snapshots computed by the last call to run().
+  ///
+  /// The gains are indexed as <tt>[snapshot][path][tx port][rx port]</tt>, with the receive port index running the
+  /// fastest.
+  srsran::span<const srsran::cf_t> get_path_gains() const { return snapshot_gains; }
+
+private:
+  /// Maximum distance, in samples, between the center and the last nonzero tap of a path filter.
+  static constexpr unsigned FILTER_HALF_LENGTH = 8;
+
+  /// Path filter, with only nonzero taps.
+  struct path_filter {
+    /// Index of the first tap in the full-length filter.
+    unsigned offset;
+    /// Filter taps.
+    std::vector<float> taps;
+  };
+
+  /// Draws the parameters of the sum-of-sinusoids processes from the random generator.
+  void draw_fading_processes();
+
+  /// \brief Computes the correlated path gains at a given time instant.
+  ///
+  /// \param[out] gains  Path gains, indexed as <tt>[path][tx port][rx port]</tt>.
+  /// \param[in]  time   Time instant in seconds.
+  void compute_path_gains(srsran::span<srsran::cf_t> gains, double time) const;
+
+  /// Channel configuration.
+  fading_channel_config config;
+  /// Number of transmit&ndash;receive links.
+  unsigned nof_links;
+  /// Amplitude of each path, that is the square root of its average power.
+  std::vector<float> path_amplitudes;
+  /// Lower triangular Cholesky factor of the spatial correlation matrix, \c nof_links by \c nof_links, row-major.
+  std::vector<float> correlation_factor;
+  /// Path filters.
+  std::vector<path_filter> filters;
+  /// Number of taps of the longest path filter.
+  unsigned filter_length;
+  /// Random stream of the fading processes.
+  random_stream_id fading_stream;
+  /// Doppler frequencies (in hertz) of the sinusoids, indexed as <tt>[path][link][real/imag][sinusoid]</tt>.
+  std::vector<double> sinusoid_frequencies;
+  /// Initial phases of the sinusoids, same indexing as \ref sinusoid_frequencies.
+  std::vector<double> sinusoid_phases;
+  /// Distance, in samples, between two path gain snapshots.
+  double snapshot_period;
+  /// Index of the next input sample since the last reset.
+  uint64_t sample_index = 0;
+  /// Last <tt>filter_length - 1</tt> input samples of each transmit port, followed by the current input block.
+  std::vector<std::vector<srsran::cf_t>> input_buffers;
+  /// Output of a path filter for the current block.
+  std::vector<srsran::cf_t> filtered;
+  /// Sampling instants of the path gain snapshots of the current block.
+  std::vector<double> snapshot_times;
+  /// Path gain snapshots of the current block.
+  std::vector<srsran::cf_t> snapshot_gains;
+};
+
+} // namespace srsran_matlab
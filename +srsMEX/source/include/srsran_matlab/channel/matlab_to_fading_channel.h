@@ -0,0 +1,68 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+/// \file
+/// \brief Conversion of the fading channel delay profile from its MATLAB description.
+
+#pragma once
+
+#include "srsran_matlab/channel/fading_channel.h"
+#include "fmt/format.h"
+#include <MatlabDataArray.hpp>
+#include <string>
+
+namespace srsran_matlab {
+
+/// \brief Reads the paths and the maximum Doppler shift of a fading channel from a MATLAB structure.
+///
+/// The structure has the fields
+///   - \c DelayProfile, either <tt>"custom"</tt> or one of the profiles supported by set_tdl_delay_profile();
+///   - \c PathDelays and \c AveragePathGains, the path delays in seconds and the average path gains in decibel (only
+///     read for the <tt>"custom"</tt> profile, nonempty and with the same number of elements);
+///   - \c DelaySpread, the delay spread in seconds (only read for the standard profiles);
+///   - \c MaximumDopplerShift, the maximum Doppler shift in hertz.
+///
+/// \param[out] config    Fading channel configuration whose paths and maximum Doppler shift are set.
+/// \param[in]  in_cfg    MATLAB structure describing the fading channel.
+/// \param[in]  on_error  Error handler, called with the error message if a field is not valid. It is expected to raise
+///                       a MATLAB error (see srsran_mex_dispatcher::mex_abort()) and not to return.
+template <typename ErrorHandler>
+void matlab_to_fading_profile(fading_channel_config&      config,
+                              const matlab::data::Struct& in_cfg,
+                              ErrorHandler&&              on_error)
+{
+  const matlab::data::CharArray in_profile = in_cfg["DelayProfile"];
+  const std::string             profile    = in_profile.toAscii();
+  if (profile == "custom") {
+    const matlab::data::TypedArray<double> in_delays = in_cfg["PathDelays"];
+    const matlab::data::TypedArray<double> in_gains  = in_cfg["AveragePathGains"];
+    std::size_t                            nof_paths = in_delays.getNumberOfElements();
+    if ((nof_paths == 0) || (nof_paths != in_gains.getNumberOfElements())) {
+      on_error(std::string(
+          "Fields 'PathDelays' and 'AveragePathGains' must be nonempty and have the same number of elements."));
+    }
+    config.path_delays.assign(in_delays.cbegin(), in_delays.cend());
+    config.average_path_gains.assign(in_gains.cbegin(), in_gains.cend());
+  } else if (!set_tdl_delay_profile(config, profile, static_cast<double>(in_cfg["DelaySpread"][0]))) {
+    on_error(fmt::format("Unknown delay profile {}.", profile));
+  }
+
+  config.max_doppler_shift = in_cfg["MaximumDopplerShift"][0];
+}
+
+} // namespace srsran_matlab
@@ -0,0 +1,140 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief PDCCH candidate calculator for large UE populations.
+
+#pragma once
+
+#include "srsran/adt/span.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace srsran_matlab {
+
+/// Number of PDCCH aggregation levels.
+constexpr unsigned PDCCH_NOF_AGGREGATION_LEVELS = 5;
+
+/// PDCCH aggregation levels, in increasing order.
+constexpr std::array<unsigned, PDCCH_NOF_AGGREGATION_LEVELS> PDCCH_AGGREGATION_LEVELS = {1, 2, 4, 8, 16};
+
+/// Maximum number of PDCCH candidates for one aggregation level in a search space.
+constexpr unsigned PDCCH_MAX_NOF_CANDIDATES = 8;
+
+/// Maximum number of slots in a frame, for all numerologies.
+constexpr unsigned PDCCH_MAX_NOF_SLOTS_PER_FRAME = 640;
+
+namespace detail {
+
+/// Number of distinct hashing coefficients \f$A_p\f$, TS38.213 Section 10.1.
+constexpr unsigned PDCCH_NOF_HASHING_COEFFICIENTS = 3;
+
+/// Modulus \f$D\f$ of the UE-specific search space hashing function, TS38.213 Section 10.1.
+constexpr uint64_t PDCCH_HASHING_MODULUS = 65537;
+
+/// \brief Table of the hashing factors \f$A_p^{n+1} \bmod D\f$.
+///
+/// Since \f$Y_{p,n} = (A_p Y_{p,n-1}) \bmod D\f$ with \f$Y_{p,-1} = n_{\textup{RNTI}}\f$, the hashing value of slot
+/// \f$n\f$ is \f$Y_{p,n} = (A_p^{n+1} \bmod D) \cdot n_{\textup{RNTI}} \bmod D\f$. Entry <tt>[p][n]</tt> of the table
+/// holds the first factor, so that the hashing value of any RNTI and slot costs one product and one modulo.
+using pdcch_hashing_table =
+    std::array<std::array<uint32_t, PDCCH_MAX_NOF_SLOTS_PER_FRAME>, PDCCH_NOF_HASHING_COEFFICIENTS>;
+
+/// Generates the hashing factor table at compile time.
+constexpr pdcch_hashing_table generate_pdcch_hashing_table()
+{
+  constexpr std::array<uint64_t, PDCCH_NOF_HASHING_COEFFICIENTS> coefficients = {39827, 39829, 39839};
+
+  pdcch_hashing_table table = {};
+  for (unsigned p = 0; p != PDCCH_NOF_HASHING_COEFFICIENTS; ++p) {
+    uint64_t factor = 1;
+    for (unsigned n = 0; n != PDCCH_MAX_NOF_SLOTS_PER_FRAME; ++n) {
+      factor      = (factor * coefficients[p]) % PDCCH_HASHING_MODULUS;
+      table[p][n] = static_cast<uint32_t>(factor);
+    }
+  }
+  return table;
+}
+
+/// Hashing factor table.
+constexpr pdcch_hashing_table PDCCH_HASHING_TABLE = generate_pdcch_hashing_table();
+
+} // namespace detail
+
+/// \brief Computes the hashing value \f$Y_{p,n}\f$ of a UE-specific search space, TS38.213 Section 10.1.
+///
+/// \param[in] coreset_id  CORESET identifier \f$p\f$.
+/// \param[in] rnti        Radio network temporary identifier \f$n_{\textup{RNTI}}\f$.
+/// \param[in] slot_index  Slot index within the frame \f$n\f$, lower than \ref PDCCH_MAX_NOF_SLOTS_PER_FRAME.
+constexpr unsigned pdcch_ue_hashing_value(unsigned coreset_id, unsigned rnti, unsigned slot_index)
+{
+  const uint64_t factor = detail::PDCCH_HASHING_TABLE[coreset_id % detail::PDCCH_NOF_HASHING_COEFFICIENTS][slot_index];
+  return static_cast<unsigned>((factor * rnti) % detail::PDCCH_HASHING_MODULUS);
+}
+
+/// \brief PDCCH candidate calculator.
+///
+/// Computes the lowest CCE index of the PDCCH candidates of one aggregation level, TS38.213 Section 10.1, with
+/// \f$n_{CI} = 0\f$. The terms that do not depend on the UE are computed once at construction, so that the candidates
+/// of a UE cost one hashing value and one modulo per candidate. The calculator is immutable and can be shared by
+/// several threads.
+class pdcch_candidate_calculator
+{
+public:
+  /// \brief Creates a candidate calculator.
+  ///
+  /// \param[in] nof_cce            Number of CCEs of the CORESET.
+  /// \param[in] aggregation_level  Aggregation level \f$L\f$.
+  /// \param[in] nof_candidates     Number of candidates \f$M\f$, up to \ref PDCCH_MAX_NOF_CANDIDATES.
+  /// \remark The CORESET must contain at least \f$L\f$ CCEs if \f$M\f$ is not zero.
+  pdcch_candidate_calculator(unsigned nof_cce, unsigned aggregation_level, unsigned nof_candidates) :
+    L(aggregation_level), nof_positions(nof_cce / aggregation_level), offsets(nof_candidates)
+  {
+    for (unsigned i_candidate = 0; i_candidate != nof_candidates; ++i_candidate) {
+      offsets[i_candidate] = (i_candidate * nof_cce) / (aggregation_level * nof_candidates);
+    }
+  }
+
+  /// Returns the number of candidates.
+  unsigned get_nof_candidates() const { return offsets.size(); }
+
+  /// \brief Computes the lowest CCE index of each candidate for a given hashing value.
+  ///
+  /// \param[out] cce_indices    Lowest CCE index of each candidate, one entry for each candidate.
+  /// \param[in]  hashing_value  Hashing value \f$Y_{p,n}\f$: zero for common search spaces, pdcch_ue_hashing_value()
+  ///                            for UE-specific ones.
+  template <typename T>
+  void get_candidates(srsran::span<T> cce_indices, unsigned hashing_value) const
+  {
+    for (unsigned i_candidate = 0, nof_candidates = offsets.size(); i_candidate != nof_candidates; ++i_candidate) {
+      cce_indices[i_candidate] = static_cast<T>(L * ((hashing_value + offsets[i_candidate]) % nof_positions));
+    }
+  }
+
+private:
+  /// Aggregation level.
+  unsigned L;
+  /// Number of possible candidate positions, i.e., \f$\lfloor N_{CCE}/L \rfloor\f$.
+  unsigned nof_positions;
+  /// Candidate offsets \f$\lfloor m N_{CCE} / (L M) \rfloor\f$.
+  std::vector<unsigned> offsets;
+};
+
+} // namespace srsran_matlab
@@ -0,0 +1,73 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Conversion of the confidence-based stopping criterion from its MATLAB description.
+
+#pragma once
+
+#include "srsran_matlab/simulators/trial_scheduler.h"
+#include "fmt/format.h"
+#include <MatlabDataArray.hpp>
+#include <string>
+
+namespace srsran_matlab {
+
+/// \brief Reads a confidence-based stopping criterion from a MATLAB structure.
+///
+/// The structure has the fields
+///   - \c ConfidenceLevel, the confidence level of the interval, in (0, 1);
+///   - \c IntervalType, the method for computing the interval, either <tt>"Wilson"</tt> or <tt>"Clopper-Pearson"</tt>;
+///   - \c TargetWidth, the target absolute width of the interval (zero for no target);
+///   - \c TargetRelativeWidth, the target relative width of the interval (zero for no target).
+///
+/// \param[in] in_stopping  MATLAB structure describing the stopping criterion.
+/// \param[in] on_error     Error handler, called with the error message if a field is not valid. It is expected to raise
+///                         a MATLAB error (see srsran_mex_dispatcher::mex_abort()) and not to return.
+/// \return The configuration of the stopping criterion.
+template <typename ErrorHandler>
+stopping_criterion_config matlab_to_stopping_criterion(const matlab::data::Struct& in_stopping, ErrorHandler&& on_error)
+{
+  stopping_criterion_config criterion;
+
+  criterion.confidence_level = in_stopping["ConfidenceLevel"][0];
+  if (!(criterion.confidence_level > 0) || !(criterion.confidence_level < 1)) {
+    on_error(fmt::format("The confidence level should be in (0, 1), provided {}.", criterion.confidence_level));
+  }
+
+  const matlab::data::CharArray in_type = in_stopping["IntervalType"];
+  const std::string             type    = in_type.toAscii();
+  if (type == "Wilson") {
+    criterion.type = confidence_interval_type::wilson;
+  } else if (type == "Clopper-Pearson") {
+    criterion.type = confidence_interval_type::clopper_pearson;
+  } else {
+    on_error(fmt::format("Unknown confidence interval type {}.", type));
+  }
+
+  criterion.target_width          = in_stopping["TargetWidth"][0];
+  criterion.target_relative_width = in_stopping["TargetRelativeWidth"][0];
+  if (!(criterion.target_width >= 0) || !(criterion.target_relative_width >= 0)) {
+    on_error(std::string("The target widths of the confidence interval should be nonnegative."));
+  }
+
+  return criterion;
+}
+
+} // namespace srsran_matlab
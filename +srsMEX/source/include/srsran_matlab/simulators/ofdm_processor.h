@@ -0,0 +1,116 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief OFDM slot modulator and demodulator declaration.
+
+#pragma once
+
+#include "srsran/adt/complex.h"
+#include "srsran/adt/span.h"
+#include "srsran/phy/generic_functions/dft_processor.h"
+#include "srsran/phy/support/resource_grid_reader.h"
+#include "srsran/phy/support/resource_grid_writer.h"
+#include "srsran/ran/cyclic_prefix.h"
+#include "srsran/ran/subcarrier_spacing.h"
+#include <memory>
+#include <vector>
+
+namespace srsran_matlab {
+
+/// OFDM processor configuration.
+struct ofdm_processor_config {
+  /// Number of subcarriers of the resource grid.
+  unsigned nof_subcarriers = 624;
+  /// DFT size.
+  unsigned dft_size = 1024;
+  /// Subcarrier spacing.
+  srsran::subcarrier_spacing scs = srsran::subcarrier_spacing::kHz15;
+  /// Cyclic prefix.
+  srsran::cyclic_prefix cp = srsran::cyclic_prefix::NORMAL;
+  /// \brief Position of the demodulation DFT window inside the cyclic prefix, as a fraction of its length.
+  ///
+  /// Zero starts the window at the beginning of the cyclic prefix, one right after it.
+  double cp_fraction = 0.5;
+};
+
+/// \brief OFDM slot modulator and demodulator.
+///
+/// The processor follows the conventions of the MATLAB functions \c nrOFDMModulate and \c nrOFDMDemodulate, so that
+/// waveforms, noise levels and SNR definitions are interchangeable with those of the MATLAB simulators: the resource
+/// grid is centered around the DC subcarrier, the modulator scales the inverse DFT by the DFT size and the demodulator
+/// applies no scaling. The demodulator takes the DFT window at a fraction of the cyclic prefix and compensates the
+/// resulting phase rotation, which makes it robust to the delay of the channel filters without any timing estimation.
+class ofdm_processor
+{
+public:
+  /// \brief Creates an OFDM processor.
+  ///
+  /// The DFT processors are created from \c dft_factory. Since DFT planning may not be thread-safe, processors meant to
+  /// run concurrently should be created in the same thread.
+  ofdm_processor(const ofdm_processor_config& config_, srsran::dft_processor_factory& dft_factory);
+
+  /// Returns \c true if the DFT processors were created successfully.
+  bool is_valid() const { return idft && dft; }
+
+  /// Returns the sampling rate in hertz.
+  double get_sampling_rate() const { return sampling_rate; }
+
+  /// Returns the number of samples of a slot, which depends on the slot index for some numerologies.
+  unsigned get_slot_size(unsigned i_slot) const;
+
+  /// \brief Modulates one slot of one port of a resource grid.
+  ///
+  /// \param[out] output  Time-domain samples, get_slot_size() of them.
+  /// \param[in]  grid    Resource grid, with at least the configured number of subcarriers.
+  /// \param[in]  i_port  Port index.
+  /// \param[in]  i_slot  Slot index (only its position within the subframe matters).
+  void modulate(srsran::span<srsran::cf_t>           output,
+                const srsran::resource_grid_reader& grid,
+                unsigned                            i_port,
+                unsigned                            i_slot);
+
+  /// \brief Demodulates one slot of one port into a resource grid.
+  ///
+  /// \param[out] grid    Resource grid, with at least the configured number of subcarriers.
+  /// \param[in]  input   Time-domain samples, get_slot_size() of them.
+  /// \param[in]  i_port  Port index.
+  /// \param[in]  i_slot  Slot index (only its position within the subframe matters).
+  void demodulate(srsran::resource_grid_writer&    grid,
+                  srsran::span<const srsran::cf_t> input,
+                  unsigned                         i_port,
+                  unsigned                         i_slot);
+
+private:
+  /// Returns the cyclic prefix length, in samples, of an OFDM symbol of a slot.
+  unsigned get_cp_length(unsigned i_slot, unsigned i_symbol) const;
+
+  /// Configuration.
+  ofdm_processor_config config;
+  /// Sampling rate in hertz.
+  double sampling_rate;
+  /// Inverse DFT, for modulation.
+  std::unique_ptr<srsran::dft_processor> idft;
+  /// Direct DFT, for demodulation.
+  std::unique_ptr<srsran::dft_processor> dft;
+  /// One OFDM symbol of the resource grid.
+  std::vector<srsran::cf_t> symbol_buffer;
+};
+
+} // namespace srsran_matlab
@@ -0,0 +1,334 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Adaptive allocation of the trials of a simulation to its SNR points.
+
+#pragma once
+
+#include "srsran/support/srsran_assert.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace srsran_matlab {
+
+/// Confidence interval of the probability of a binomial random variable.
+struct confidence_interval {
+  /// Lower bound.
+  double lower = 0;
+  /// Upper bound.
+  double upper = 1;
+
+  /// Returns the width of the interval.
+  double width() const { return upper - lower; }
+};
+
+/// Methods for computing the confidence interval of a binomial probability.
+enum class confidence_interval_type { wilson, clopper_pearson };
+
+/// \brief Returns the quantile of the standard normal distribution.
+///
+/// The quantile is found by bisection of the complementary error function, which is accurate to the last bit and fast
+/// enough for a value that is computed once per simulation.
+inline double normal_quantile(double probability)
+{
+  srsran_assert((probability > 0) && (probability < 1), "The probability must be in (0, 1).");
+
+  double lower = -40;
+  double upper = 40;
+  for (unsigned i_iter = 0; i_iter != 100; ++i_iter) {
+    double middle = (lower + upper) / 2;
+    if (0.5 * std::erfc(-middle / M_SQRT2) < probability) {
+      lower = middle;
+    } else {
+      upper = middle;
+    }
+  }
+  return (lower + upper) / 2;
+}
+
+/// \brief Returns the Wilson score interval of a binomial probability.
+///
+/// \param[in] nof_errors  Number of observed errors.
+/// \param[in] nof_trials  Number of trials.
+/// \param[in] z           Quantile of the standard normal distribution for the desired confidence level, e.g., 1.96
+///                        for a two-sided 95% interval.
+inline confidence_interval wilson_interval(uint64_t nof_errors, uint64_t nof_trials, double z)
+{
+  if (nof_trials == 0) {
+    return {};
+  }
+
+  double n      = static_cast<double>(nof_trials);
+  double p      = static_cast<double>(nof_errors) / n;
+  double z2     = z * z;
+  double center = (p + z2 / (2 * n)) / (1 + z2 / n);
+  double half   = z / (1 + z2 / n) * std::sqrt(p * (1 - p) / n + z2 / (4 * n * n));
+  return {std::max(0.0, center - half), std::min(1.0, center + half)};
+}
+
+namespace detail {
+
+/// \brief Returns the regularized incomplete beta function \f$I_x(a, b)\f$.
+///
+/// The function is evaluated by the continued fraction of W. H. Press et al., "Numerical Recipes," Section 6.4, with
+/// the modified Lentz method.
+inline double incomplete_beta(double a, double b, double x)
+{
+  if (x <= 0) {
+    return 0;
+  }
+  if (x >= 1) {
+    return 1;
+  }
+
+  // The continued fraction converges quickly for x < (a + 1) / (a + b + 2). Otherwise, use the symmetry relation.
+  if (x > (a + 1) / (a + b + 2)) {
+    return 1 - incomplete_beta(b, a, 1 - x);
+  }
+
+  constexpr double tiny      = 1e-300;
+  constexpr double tolerance = 1e-14;
+
+  double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) + a * std::log(x) + b * std::log1p(-x));
+
+  double c = 1;
+  double d = 1 - (a + b) * x / (a + 1);
+  d        = 1 / ((std::abs(d) < tiny) ? tiny : d);
+  double f = d;
+  for (unsigned m = 1; m != 10000; ++m) {
+    // Even and odd steps of the continued fraction.
+    for (double numerator : {m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m)),
+                             -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1))}) {
+      d            = 1 + numerator * d;
+      d            = 1 / ((std::abs(d) < tiny) ? tiny : d);
+      c            = 1 + numerator / c;
+      c            = (std::abs(c) < tiny) ? tiny : c;
+      double delta = c * d;
+      f *= delta;
+      if (std::abs(delta - 1) < tolerance) {
+        return front * f / a;
+      }
+    }
+  }
+  return front * f / a;
+}
+
+/// Returns the quantile of the beta distribution with parameters \c a and \c b, by bisection.
+inline double beta_quantile(double probability, double a, double b)
+{
+  double lower = 0;
+  double upper = 1;
+  for (unsigned i_iter = 0; i_iter != 60; ++i_iter) {
+    double middle = (lower + upper) / 2;
+    if (incomplete_beta(a, b, middle) < probability) {
+      lower = middle;
+    } else {
+      upper = middle;
+    }
+  }
+  return (lower + upper) / 2;
+}
+
+} // namespace detail
+
+/// \brief Returns the Clopper&ndash;Pearson (exact) interval of a binomial probability.
+///
+/// \param[in] nof_errors        Number of observed errors.
+/// \param[in] nof_trials        Number of trials.
+/// \param[in] confidence_level  Confidence level of the two-sided interval, e.g., 0.95.
+inline confidence_interval clopper_pearson_interval(uint64_t nof_errors, uint64_t nof_trials, double confidence_level)
+{
+  if (nof_trials == 0) {
+    return {};
+  }
+
+  double alpha = 1 - confidence_level;
+  double x     = static_cast<double>(nof_errors);
+  double n     = static_cast<double>(nof_trials);
+
+  confidence_interval interval;
+  interval.lower = (nof_errors == 0) ? 0.0 : detail::beta_quantile(alpha / 2, x, n - x + 1);
+  interval.upper = (nof_errors == nof_trials) ? 1.0 : detail::beta_quantile(1 - alpha / 2, x + 1, n - x);
+  return interval;
+}
+
+/// Criterion for stopping the simulation of an SNR point once its error probability is known accurately enough.
+struct stopping_criterion_config {
+  /// Confidence level of the two-sided confidence interval.
+  double confidence_level = 0.95;
+  /// Method for computing the confidence interval.
+  confidence_interval_type type = confidence_interval_type::wilson;
+  /// Target absolute width of the confidence interval. Zero for no absolute target.
+  double target_width = 0;
+  /// Target width of the confidence interval relative to the estimated error probability. Zero for no relative target.
+  double target_relative_width = 0;
+};
+
+/// \brief Confidence-based stopping criterion.
+///
+/// A point is accurate enough when the width of the confidence interval of its error probability does not exceed the
+/// largest of the absolute target width and the relative target width times the estimated error probability, i.e.,
+/// when any of the two targets is met. The absolute target stops the points with few or no errors (e.g., high SNR) once
+/// the interval is narrow in absolute terms, the relative target stops the points with high error probability (e.g.,
+/// the waterfall region) once the interval is narrow compared to the estimate.
+class stopping_criterion
+{
+public:
+  /// Creates a stopping criterion. The criterion is disabled if both targets are zero.
+  explicit stopping_criterion(const stopping_criterion_config& config_ = {}) : config(config_)
+  {
+    srsran_assert((config.confidence_level > 0) && (config.confidence_level < 1),
+                  "The confidence level must be in (0, 1).");
+    srsran_assert((config.target_width >= 0) && (config.target_relative_width >= 0),
+                  "The target widths cannot be negative.");
+    z = normal_quantile(1 - (1 - config.confidence_level) / 2);
+  }
+
+  /// Returns \c true if the criterion can stop a simulation, that is if any of the targets is positive.
+  bool is_enabled() const { return (config.target_width > 0) || (config.target_relative_width > 0); }
+
+  /// Returns the confidence interval of the error probability.
+  confidence_interval get_interval(uint64_t nof_errors, uint64_t nof_trials) const
+  {
+    if (config.type == confidence_interval_type::clopper_pearson) {
+      return clopper_pearson_interval(nof_errors, nof_trials, config.confidence_level);
+    }
+    return wilson_interval(nof_errors, nof_trials, z);
+  }
+
+  /// Returns \c true if the error probability is known accurately enough.
+  bool is_met(uint64_t nof_errors, uint64_t nof_trials) const
+  {
+    if (!is_enabled() || (nof_trials == 0)) {
+      return false;
+    }
+    double target = std::max(config.target_width,
+                              config.target_relative_width * static_cast<double>(nof_errors) / nof_trials);
+    return get_interval(nof_errors, nof_trials).width() <= target;
+  }
+
+private:
+  /// Criterion configuration.
+  stopping_criterion_config config;
+  /// Quantile of the standard normal distribution for the confidence level (Wilson interval).
+  double z;
+};
+
+/// \brief Allocates the trials of a simulation to its SNR points.
+///
+/// Each SNR point has up to a maximum number of items (e.g., frames), which are simulated in increasing order. Items
+/// are handed out in batches: each batch is shared as evenly as possible among the points that are not stopped yet, in
+/// a round-robin fashion across batches, so that the workers move to the points that still need trials as soon as the
+/// other points are accurate enough. Since
+/// the items of each point come in order, the caller can accumulate them in order and stop a point at the very item
+/// that meets its target: the results do not depend on the batch size nor on the number of workers.
+class trial_scheduler
+{
+public:
+  /// Item of an SNR point.
+  struct trial {
+    /// SNR point index.
+    unsigned i_point;
+    /// Item index within the SNR point.
+    unsigned i_item;
+  };
+
+  /// \brief Creates a scheduler.
+  ///
+  /// \param[in] nof_points   Number of SNR points.
+  /// \param[in] nof_items    Maximum number of items of each SNR point.
+  /// \param[in] batch_size_ Maximum number of items in a batch.
+  trial_scheduler(unsigned nof_points, unsigned nof_items, unsigned batch_size_) :
+    max_items(nof_items), batch_size(std::max(1U, batch_size_)), next_items(nof_points, 0), stopped(nof_points, false)
+  {
+  }
+
+  /// Returns \c true if all the SNR points are stopped or have no more items.
+  bool is_done() const
+  {
+    for (unsigned i_point = 0, nof_points = next_items.size(); i_point != nof_points; ++i_point) {
+      if (is_active(i_point)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// Stops an SNR point: no more items of the point are scheduled.
+  void stop(unsigned i_point) { stopped[i_point] = true; }
+
+  /// Returns \c true if the SNR point is stopped.
+  bool is_stopped(unsigned i_point) const { return stopped[i_point]; }
+
+  /// \brief Returns the next batch of items.
+  ///
+  /// The items are grouped by SNR point, in increasing point order, and the items of each point are consecutive and
+  /// follow the items of the previous batches. The batch is empty if the scheduler is done.
+  const std::vector<trial>& next_batch()
+  {
+    unsigned nof_points = next_items.size();
+
+    // Share the batch among the active points, one item at a time, starting from where the previous batch stopped.
+    std::vector<unsigned> nof_point_items(nof_points, 0);
+    unsigned              nof_batch_items = 0;
+    unsigned              nof_idle_points = 0;
+    unsigned              i_point         = first_point;
+    while ((nof_batch_items != batch_size) && (nof_idle_points < nof_points)) {
+      if (is_active(i_point) && (next_items[i_point] + nof_point_items[i_point] < max_items)) {
+        ++nof_point_items[i_point];
+        ++nof_batch_items;
+        nof_idle_points = 0;
+        first_point     = (i_point + 1) % nof_points;
+      } else {
+        ++nof_idle_points;
+      }
+      i_point = (i_point + 1) % nof_points;
+    }
+
+    batch.clear();
+    for (unsigned i_point = 0; i_point != nof_points; ++i_point) {
+      for (unsigned i_item = 0; i_item != nof_point_items[i_point]; ++i_item) {
+        batch.push_back({i_point, next_items[i_point]++});
+      }
+    }
+    return batch;
+  }
+
+private:
+  /// Returns \c true if the SNR point is not stopped and has items left.
+  bool is_active(unsigned i_point) const { return !stopped[i_point] && (next_items[i_point] < max_items); }
+
+  /// Maximum number of items of each SNR point.
+  unsigned max_items;
+  /// Maximum number of items in a batch.
+  unsigned batch_size;
+  /// Index of the next item of each SNR point.
+  std::vector<unsigned> next_items;
+  /// Stop flag of each SNR point.
+  std::vector<bool> stopped;
+  /// First SNR point to receive an item in the next batch.
+  unsigned first_point = 0;
+  /// Current batch.
+  std::vector<trial> batch;
+};
+
+} // namespace srsran_matlab
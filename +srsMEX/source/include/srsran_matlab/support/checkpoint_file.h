@@ -0,0 +1,289 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Binary checkpoint files.
+///
+/// A checkpoint file starts with a short header (a file identifier, a format version and a checkpoint identifier)
+/// followed by the raw bytes of the values written by the objects that save their state. The checkpoint identifier is
+/// a hash of the values: it tells the checkpoints written to the same file apart. Values are stored with the native
+/// byte order and size: a checkpoint is meant to be restored on the machine that wrote it, by the same build of the
+/// MEX. The same format serves as a cache for read-only tables, which are mapped into memory without being copied.
+
+#pragma once
+
+#include "srsran/adt/span.h"
+#include "srsran/ran/slot_point.h"
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+#include <vector>
+
+namespace srsran_matlab {
+
+/// Identifier at the beginning of every checkpoint file.
+constexpr std::array<char, 8> checkpoint_file_id = {'S', 'R', 'S', 'C', 'K', 'P', 'T', '\0'};
+
+/// Version of the checkpoint file format.
+constexpr uint32_t checkpoint_file_version = 2;
+
+/// \brief Checkpoint file writer.
+///
+/// Collects the values in memory and writes the whole file at once.
+class checkpoint_writer
+{
+public:
+  /// Creates a writer with the checkpoint file header.
+  checkpoint_writer()
+  {
+    write_values(srsran::span<const char>(checkpoint_file_id));
+    write(checkpoint_file_version);
+    header_size = data.size();
+    write<uint64_t>(0);
+  }
+
+  /// Returns the checkpoint identifier, i.e., the 64-bit FNV-1a hash of the values written so far.
+  uint64_t get_checkpoint_id() const
+  {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (auto it = data.begin() + header_size + sizeof(uint64_t), it_end = data.end(); it != it_end; ++it) {
+      hash = (hash ^ *it) * 0x100000001b3ULL;
+    }
+    return hash;
+  }
+
+  /// Appends a value.
+  template <typename T>
+  void write(const T& value)
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written.");
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+  }
+
+  /// Appends a sequence of values (without its size).
+  template <typename T>
+  void write_values(srsran::span<const T> values)
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written.");
+    const auto* bytes = reinterpret_cast<const uint8_t*>(values.data());
+    data.insert(data.end(), bytes, bytes + values.size() * sizeof(T));
+  }
+
+  /// Pads the file with zeros up to a multiple of the given alignment (in bytes).
+  void align(std::size_t alignment) { data.resize((data.size() + alignment - 1) / alignment * alignment, 0); }
+
+  /// Appends a slot point (possibly invalid).
+  void write_slot(const srsran::slot_point& slot)
+  {
+    write<uint8_t>(slot.valid());
+    if (slot.valid()) {
+      write<uint32_t>(slot.numerology());
+      write<uint32_t>(slot.to_uint());
+    }
+  }
+
+  /// \brief Writes the checkpoint file, with the checkpoint identifier in its header (see get_checkpoint_id()).
+  ///
+  /// The data are first written to a temporary file that then replaces the given one: an interrupted write does not
+  /// corrupt the previous checkpoint, and processes writing the same file at the same time do not mix their data. The
+  /// temporary file is created exclusively, with permissions 0600: an existing file or symbolic link with the same name
+  /// is removed rather than followed.
+  /// \return True on success, false otherwise.
+  bool save(const std::string& path) const
+  {
+    std::string tmp_path = path + "." + std::to_string(::getpid()) + ".tmp";
+    std::remove(tmp_path.c_str());
+    int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+      return false;
+    }
+    std::FILE* file = ::fdopen(fd, "wb");
+    if (file == nullptr) {
+      ::close(fd);
+      std::remove(tmp_path.c_str());
+      return false;
+    }
+    uint64_t                    checkpoint_id = get_checkpoint_id();
+    srsran::span<const uint8_t> values = srsran::span<const uint8_t>(data).subspan(header_size + sizeof(checkpoint_id));
+    bool                        success = (std::fwrite(data.data(), 1, header_size, file) == header_size);
+    success = success && (std::fwrite(&checkpoint_id, sizeof(checkpoint_id), 1, file) == 1);
+    success = success && (std::fwrite(values.data(), 1, values.size(), file) == values.size());
+    success = (std::fclose(file) == 0) && success;
+    if (!success || (std::rename(tmp_path.c_str(), path.c_str()) != 0)) {
+      std::remove(tmp_path.c_str());
+      return false;
+    }
+    return true;
+  }
+
+private:
+  /// File content, with a placeholder for the checkpoint identifier.
+  std::vector<uint8_t> data;
+  /// Size of the header before the checkpoint identifier, in bytes.
+  std::size_t header_size;
+};
+
+/// \brief Checkpoint file reader.
+///
+/// Maps the file into memory (read-only and shared, so that all the processes reading the same file share its pages)
+/// and reads the values in the order they were written. Reading past the end of the file invalidates the reader: the
+/// values read afterwards are zero.
+class checkpoint_reader
+{
+public:
+  /// Maps the checkpoint file into memory and checks its header.
+  explicit checkpoint_reader(const std::string& path)
+  {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return;
+    }
+    struct stat file_stat = {};
+    if ((::fstat(fd, &file_stat) == 0) && (file_stat.st_size > 0)) {
+      void* address = ::mmap(nullptr, file_stat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+      if (address != MAP_FAILED) {
+        mapping = static_cast<const uint8_t*>(address);
+        size    = file_stat.st_size;
+      }
+    }
+    ::close(fd);
+
+    valid = (mapping != nullptr);
+    std::array<char, 8> file_id;
+    read_bytes(file_id.data(), file_id.size());
+    valid         = valid && (file_id == checkpoint_file_id) && (read<uint32_t>() == checkpoint_file_version);
+    checkpoint_id = read<uint64_t>();
+  }
+
+  checkpoint_reader(const checkpoint_reader&)            = delete;
+  checkpoint_reader& operator=(const checkpoint_reader&) = delete;
+
+  /// Unmaps the checkpoint file.
+  ~checkpoint_reader()
+  {
+    if (mapping != nullptr) {
+      ::munmap(const_cast<uint8_t*>(mapping), size);
+    }
+  }
+
+  /// Returns true if the file has a valid header and no read went past its end.
+  bool is_valid() const { return valid; }
+
+  /// Returns the checkpoint identifier stored in the file header (see checkpoint_writer::get_checkpoint_id()).
+  uint64_t get_checkpoint_id() const { return checkpoint_id; }
+
+  /// Reads a value.
+  template <typename T>
+  T read()
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read.");
+    T value = {};
+    read_bytes(&value, sizeof(T));
+    return value;
+  }
+
+  /// Reads a sequence of values, as many as the size of \c values.
+  template <typename T>
+  bool read_values(srsran::span<T> values)
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read.");
+    return read_bytes(values.data(), values.size() * sizeof(T));
+  }
+
+  /// \brief Maps a sequence of values of the file without copying them.
+  ///
+  /// The values must be aligned in the file (see checkpoint_writer::align()). The returned view is valid as long as the
+  /// reader exists.
+  template <typename T>
+  srsran::span<const T> map_values(std::size_t nof_values)
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be mapped.");
+    if (!valid || ((offset % alignof(T)) != 0) || (nof_values > (size - offset) / sizeof(T))) {
+      valid = false;
+      return {};
+    }
+    srsran::span<const T> values(reinterpret_cast<const T*>(mapping + offset), nof_values);
+    offset += nof_values * sizeof(T);
+    return values;
+  }
+
+  /// Skips the padding up to a multiple of the given alignment (in bytes), see checkpoint_writer::align().
+  void align(std::size_t alignment)
+  {
+    std::size_t aligned_offset = (offset + alignment - 1) / alignment * alignment;
+    if (!valid || (aligned_offset > size)) {
+      valid = false;
+      return;
+    }
+    offset = aligned_offset;
+  }
+
+  /// Reads a slot point (possibly invalid). A slot point with an invalid numerology or count invalidates the reader.
+  srsran::slot_point read_slot()
+  {
+    if (read<uint8_t>() == 0) {
+      return {};
+    }
+    uint32_t numerology = read<uint32_t>();
+    uint32_t count      = read<uint32_t>();
+    if ((numerology > max_numerology) ||
+        (count >= srsran::slot_point(numerology, 0).nof_slots_per_hyper_system_frame())) {
+      valid = false;
+      return {};
+    }
+    return {numerology, count};
+  }
+
+private:
+  /// Largest subcarrier spacing numerology (TS38.211 Section 4.2).
+  static constexpr uint32_t max_numerology = 4;
+
+  /// Copies the next bytes of the file, invalidating the reader if there are not enough.
+  bool read_bytes(void* destination, std::size_t nof_bytes)
+  {
+    if (!valid || (nof_bytes > size - offset)) {
+      valid = false;
+      return false;
+    }
+    std::memcpy(destination, mapping + offset, nof_bytes);
+    offset += nof_bytes;
+    return true;
+  }
+
+  /// File mapped into memory.
+  const uint8_t* mapping = nullptr;
+  /// File size in bytes.
+  std::size_t size = 0;
+  /// Read position.
+  std::size_t offset = 0;
+  /// Validity flag.
+  bool valid = false;
+  /// Checkpoint identifier.
+  uint64_t checkpoint_id = 0;
+};
+
+} // namespace srsran_matlab
@@ -0,0 +1,563 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Receive buffer pool storing the soft bits with a reduced bit width.
+
+#pragma once
+
+#include "srsran_matlab/support/checkpoint_file.h"
+#include "srsran/adt/bit_buffer.h"
+#include "srsran/adt/span.h"
+#include "srsran/phy/upper/log_likelihood_ratio.h"
+#include "srsran/phy/upper/rx_buffer_pool.h"
+#include "srsran/phy/upper/trx_buffer_identifier.h"
+#include "srsran/phy/upper/unique_rx_buffer.h"
+#include "srsran/ran/slot_point.h"
+#include "srsran/support/srsran_assert.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace srsran_matlab {
+
+/// \brief Soft bit compressor.
+///
+/// Quantizes log-likelihood ratios (LLRs) uniformly onto signed integers of 4, 6 or 8 bits, covering the whole LLR
+/// range: the largest levels represent saturated LLRs. The 8-bit compressor is lossless. The LLRs are packed in groups
+/// of \ref group_size, each group filling an integer number of bytes. Quantization and reconstruction use lookup
+/// tables, so that packing and unpacking are branch-free scalar loops.
+class softbit_compressor
+{
+public:
+  /// Number of LLRs packed together: four 6-bit LLRs fill three bytes.
+  static constexpr unsigned group_size = 4;
+
+  /// Creates a compressor for the given bit width (4, 6 or 8).
+  explicit softbit_compressor(unsigned bit_width_) : bit_width(bit_width_)
+  {
+    srsran_assert((bit_width == 4) || (bit_width == 6) || (bit_width == 8), "Invalid bit width {}.", bit_width);
+
+    int max_llr   = srsran::log_likelihood_ratio::infinity().to_value_type();
+    int max_level = (1 << (bit_width - 1)) - 1;
+    int step      = (max_llr + max_level - 1) / max_level;
+    int mask      = (1 << bit_width) - 1;
+
+    // Round to the nearest level, with saturation.
+    for (int value = -128; value != 128; ++value) {
+      int level = std::min((std::abs(value) + step / 2) / step, max_level);
+      level     = (value < 0) ? -level : level;
+      encode_table[static_cast<uint8_t>(value)] = static_cast<uint8_t>(level & mask);
+    }
+
+    // Reconstruct the level value, without exceeding the LLR range.
+    for (int code = 0; code != (1 << bit_width); ++code) {
+      int level          = (code > max_level) ? (code - (1 << bit_width)) : code;
+      int value          = std::clamp(level * step, -max_llr, max_llr);
+      decode_table[code] = srsran::log_likelihood_ratio(static_cast<int8_t>(value));
+    }
+  }
+
+  /// Returns the number of bits per compressed LLR.
+  unsigned get_bit_width() const { return bit_width; }
+
+  /// Returns the number of bytes storing the given number of LLRs, which must be a multiple of \ref group_size.
+  unsigned get_packed_size(unsigned nof_llrs) const
+  {
+    srsran_assert(nof_llrs % group_size == 0, "The number of LLRs {} is not a multiple of {}.", nof_llrs, group_size);
+    return nof_llrs * bit_width / 8;
+  }
+
+  /// \brief Compresses LLRs.
+  ///
+  /// \param[out] packed  Compressed LLRs, as many bytes as get_packed_size(llrs.size()).
+  /// \param[in]  llrs    LLRs to compress, a multiple of \ref group_size.
+  void pack(srsran::span<uint8_t> packed, srsran::span<const srsran::log_likelihood_ratio> llrs) const
+  {
+    srsran_assert(packed.size() == get_packed_size(llrs.size()), "Packed and unpacked sizes do not match.");
+
+    auto code = [this](srsran::log_likelihood_ratio llr) -> unsigned {
+      return encode_table[static_cast<uint8_t>(llr.to_value_type())];
+    };
+
+    unsigned nof_groups = llrs.size() / group_size;
+    switch (bit_width) {
+      case 4:
+        for (unsigned i_group = 0; i_group != nof_groups; ++i_group) {
+          const srsran::log_likelihood_ratio* in  = &llrs[group_size * i_group];
+          uint8_t*                            out = &packed[2 * i_group];
+
+          out[0] = code(in[0]) | (code(in[1]) << 4);
+          out[1] = code(in[2]) | (code(in[3]) << 4);
+        }
+        break;
+      case 6:
+        for (unsigned i_group = 0; i_group != nof_groups; ++i_group) {
+          const srsran::log_likelihood_ratio* in  = &llrs[group_size * i_group];
+          uint8_t*                            out = &packed[3 * i_group];
+
+          uint32_t word = code(in[0]) | (code(in[1]) << 6) | (code(in[2]) << 12) | (code(in[3]) << 18);
+          out[0]        = word;
+          out[1]        = word >> 8;
+          out[2]        = word >> 16;
+        }
+        break;
+      default:
+        std::transform(llrs.begin(), llrs.end(), packed.begin(), code);
+    }
+  }
+
+  /// \brief Decompresses LLRs.
+  ///
+  /// \param[out] llrs    Decompressed LLRs, a multiple of \ref group_size.
+  /// \param[in]  packed  Compressed LLRs, as many bytes as get_packed_size(llrs.size()).
+  void unpack(srsran::span<srsran::log_likelihood_ratio> llrs, srsran::span<const uint8_t> packed) const
+  {
+    srsran_assert(packed.size() == get_packed_size(llrs.size()), "Packed and unpacked sizes do not match.");
+
+    unsigned nof_groups = llrs.size() / group_size;
+    switch (bit_width) {
+      case 4:
+        for (unsigned i_group = 0; i_group != nof_groups; ++i_group) {
+          const uint8_t*                in  = &packed[2 * i_group];
+          srsran::log_likelihood_ratio* out = &llrs[group_size * i_group];
+
+          out[0] = decode_table[in[0] & 0xf];
+          out[1] = decode_table[in[0] >> 4];
+          out[2] = decode_table[in[1] & 0xf];
+          out[3] = decode_table[in[1] >> 4];
+        }
+        break;
+      case 6:
+        for (unsigned i_group = 0; i_group != nof_groups; ++i_group) {
+          const uint8_t*                in  = &packed[3 * i_group];
+          srsran::log_likelihood_ratio* out = &llrs[group_size * i_group];
+
+          uint32_t word = in[0] | (in[1] << 8) | (in[2] << 16);
+          out[0]        = decode_table[word & 0x3f];
+          out[1]        = decode_table[(word >> 6) & 0x3f];
+          out[2]        = decode_table[(word >> 12) & 0x3f];
+          out[3]        = decode_table[word >> 18];
+        }
+        break;
+      default:
+        std::transform(
+            packed.begin(), packed.end(), llrs.begin(), [this](uint8_t code) { return decode_table[code]; });
+    }
+  }
+
+private:
+  /// Number of bits per compressed LLR.
+  unsigned bit_width;
+  /// Compressed code of each LLR value, indexed by the LLR value bits.
+  std::array<uint8_t, 256> encode_table;
+  /// Reconstructed LLR value of each compressed code.
+  std::array<srsran::log_likelihood_ratio, 256> decode_table;
+};
+
+/// \brief Receive buffer pool with compressed soft bits.
+///
+/// Behaves as the srsRAN receive buffer pool (see srsran::rx_buffer_pool) but stores the soft bits of the codeblocks
+/// compressed by a softbit_compressor. The soft bits of the locked buffer are decompressed, on demand, into a
+/// full-width working area that the PUSCH decoder combines in place: they are compressed back when the buffer is
+/// unlocked. Hence, only the combined soft bits of pending retransmissions are quantized, never the soft bits of the
+/// transmission being decoded. The working area holds the codeblocks of a single buffer, which is why only one buffer
+/// can be locked at a time. The CRC flags and the decoded data bits are stored without compression.
+///
+/// \remark The pool is not thread-safe.
+class compressed_rx_buffer_pool
+{
+public:
+  /// \brief Creates a pool.
+  ///
+  /// \param[in] config     Pool configuration, as for the srsRAN pool.
+  /// \param[in] bit_width  Number of bits per stored soft bit (4, 6 or 8).
+  compressed_rx_buffer_pool(const srsran::rx_buffer_pool_config& config, unsigned bit_width) :
+    compressor(bit_width),
+    expire_timeout_slots(config.expire_timeout_slots),
+    codeblock_stride(
+        (config.max_codeblock_size + softbit_compressor::group_size - 1) / softbit_compressor::group_size *
+        softbit_compressor::group_size),
+    packed_stride(compressor.get_packed_size(codeblock_stride)),
+    data_stride((config.max_codeblock_size + 7) / 8),
+    packed_softbits(static_cast<std::size_t>(config.nof_codeblocks) * packed_stride),
+    data_bits(static_cast<std::size_t>(config.nof_codeblocks) * data_stride)
+  {
+    free_codeblocks.reserve(config.nof_codeblocks);
+    for (unsigned i_cb = config.nof_codeblocks; i_cb != 0; --i_cb) {
+      free_codeblocks.push_back(i_cb - 1);
+    }
+
+    buffers.reserve(config.nof_buffers);
+    for (unsigned i_buffer = 0; i_buffer != config.nof_buffers; ++i_buffer) {
+      buffers.push_back(std::make_unique<buffer>(*this, config.nof_codeblocks));
+    }
+  }
+
+  /// \brief Reserves a buffer, as srsran::rx_buffer_pool::reserve() does.
+  ///
+  /// \return A valid buffer if the reservation is successful, an invalid one otherwise. A failed reservation leaves
+  /// the pool unchanged.
+  srsran::unique_rx_buffer reserve(const srsran::slot_point&            slot,
+                                   const srsran::trx_buffer_identifier& id,
+                                   unsigned                             nof_codeblocks,
+                                   bool                                 new_data)
+  {
+    std::pair<uint16_t, unsigned> key = {id.get_rnti(), id.get_harq()};
+
+    // Renew the reservation of the buffer with the same identifier, if any.
+    auto it = std::find_if(buffers.begin(), buffers.end(), [&key](const std::unique_ptr<buffer>& b) {
+      return b->is_reserved() && (b->get_key() == key);
+    });
+    if (it != buffers.end()) {
+      buffer& b = **it;
+      if (b.is_locked() || (!new_data && (b.get_nof_codeblocks() != nof_codeblocks))) {
+        return {};
+      }
+      if ((b.get_nof_codeblocks() != nof_codeblocks) && !b.allocate(nof_codeblocks)) {
+        return {};
+      }
+      b.reserve(key, slot + static_cast<int>(expire_timeout_slots), new_data);
+      return srsran::unique_rx_buffer(b);
+    }
+
+    // Otherwise, take an available buffer.
+    it = std::find_if(
+        buffers.begin(), buffers.end(), [](const std::unique_ptr<buffer>& b) { return !b->is_reserved(); });
+    if ((it == buffers.end()) || !(*it)->allocate(nof_codeblocks)) {
+      return {};
+    }
+    buffer& b = **it;
+    b.reserve(key, slot + static_cast<int>(expire_timeout_slots), /* new_data = */ true);
+    return srsran::unique_rx_buffer(b);
+  }
+
+  /// Releases the unlocked buffers that expire at or before the given slot.
+  void run_slot(const srsran::slot_point& slot)
+  {
+    for (std::unique_ptr<buffer>& b : buffers) {
+      if (b->is_reserved() && !b->is_locked() && (b->get_expiration() <= slot)) {
+        b->free();
+      }
+    }
+  }
+
+  /// \brief Returns the number of bytes storing the compressed soft bits of the pool.
+  ///
+  /// The working area of the locked buffer is not counted: its size depends on the buffers decoded so far, not on the
+  /// pool configuration.
+  std::size_t get_softbit_storage_size() const { return packed_softbits.size(); }
+
+  /// \brief Writes the state of the pool to a checkpoint.
+  ///
+  /// Only the reserved buffers are written, with the compressed soft bits of the codeblocks that store some and the
+  /// data bits of the codeblocks that passed the CRC. No buffer can be locked.
+  void save(checkpoint_writer& writer) const
+  {
+    srsran_assert(locked_buffer == nullptr, "Cannot save a pool with a locked buffer.");
+
+    writer.write<uint32_t>(compressor.get_bit_width());
+    writer.write<uint32_t>(codeblock_stride);
+    writer.write<uint32_t>(data_stride);
+    writer.write<uint32_t>(packed_softbits.size() / packed_stride);
+    writer.write<uint32_t>(buffers.size());
+
+    unsigned nof_reserved = std::count_if(
+        buffers.begin(), buffers.end(), [](const std::unique_ptr<buffer>& b) { return b->is_reserved(); });
+    writer.write<uint32_t>(nof_reserved);
+    for (const std::unique_ptr<buffer>& b : buffers) {
+      if (b->is_reserved()) {
+        b->save(writer);
+      }
+    }
+  }
+
+  /// \brief Restores the state of the pool from a checkpoint.
+  ///
+  /// The checkpoint must come from a pool with the same configuration. The buffers of the pool are all freed first and
+  /// no buffer can be locked.
+  /// \return True on success, false if the checkpoint is not valid for the pool (the pool is then empty).
+  bool load(checkpoint_reader& reader)
+  {
+    srsran_assert(locked_buffer == nullptr, "Cannot load a pool with a locked buffer.");
+
+    for (std::unique_ptr<buffer>& b : buffers) {
+      b->free();
+    }
+
+    bool valid = (reader.read<uint32_t>() == compressor.get_bit_width()) &&
+                 (reader.read<uint32_t>() == codeblock_stride) && (reader.read<uint32_t>() == data_stride) &&
+                 (reader.read<uint32_t>() == packed_softbits.size() / packed_stride) &&
+                 (reader.read<uint32_t>() == buffers.size());
+
+    unsigned nof_reserved = reader.read<uint32_t>();
+    valid                 = valid && (nof_reserved <= buffers.size());
+    for (unsigned i_buffer = 0; valid && (i_buffer != nof_reserved); ++i_buffer) {
+      valid = buffers[i_buffer]->load(reader);
+    }
+
+    if (!valid || !reader.is_valid()) {
+      for (std::unique_ptr<buffer>& b : buffers) {
+        b->free();
+      }
+      return false;
+    }
+    return true;
+  }
+
+private:
+  /// Receive buffer of a compressed_rx_buffer_pool.
+  class buffer : public srsran::unique_rx_buffer::callback
+  {
+  public:
+    /// Creates an unreserved buffer of the given pool, with up to \c max_nof_codeblocks codeblocks.
+    buffer(compressed_rx_buffer_pool& pool_, unsigned max_nof_codeblocks) :
+      pool(pool_), crcs(std::make_unique<bool[]>(max_nof_codeblocks))
+    {
+    }
+
+    bool                                 is_reserved() const { return reserved; }
+    bool                                 is_locked() const { return locked; }
+    const std::pair<uint16_t, unsigned>& get_key() const { return key; }
+    const srsran::slot_point&            get_expiration() const { return expiration; }
+
+    /// \brief Allocates the given number of codeblocks to the buffer, returning the previous ones to the pool.
+    ///
+    /// \return True on success, false if the pool has not enough codeblocks (the buffer is then left unchanged).
+    bool allocate(unsigned nof_codeblocks)
+    {
+      if (nof_codeblocks > pool.free_codeblocks.size() + codeblock_ids.size()) {
+        return false;
+      }
+      release_codeblocks();
+      for (unsigned i_cb = 0; i_cb != nof_codeblocks; ++i_cb) {
+        codeblock_ids.push_back(pool.free_codeblocks.back());
+        pool.free_codeblocks.pop_back();
+      }
+      std::fill(crcs.get(), crcs.get() + nof_codeblocks, false);
+      return true;
+    }
+
+    /// \brief Reserves the buffer until the given expiration slot.
+    ///
+    /// The stored soft bits of a buffer reserved for new data are discarded: the decoder overwrites them.
+    void reserve(const std::pair<uint16_t, unsigned>& key_, const srsran::slot_point& expiration_, bool new_data)
+    {
+      reserved   = true;
+      key        = key_;
+      expiration = expiration_;
+      if (new_data) {
+        has_softbits.assign(codeblock_ids.size(), false);
+      }
+    }
+
+    /// Frees the buffer and returns its codeblocks to the pool.
+    void free()
+    {
+      release_codeblocks();
+      reserved = false;
+    }
+
+    /// Writes the reservation and the codeblocks of the buffer to a checkpoint.
+    void save(checkpoint_writer& writer) const
+    {
+      writer.write<uint16_t>(key.first);
+      writer.write<uint32_t>(key.second);
+      writer.write_slot(expiration);
+      writer.write<uint32_t>(codeblock_ids.size());
+      for (unsigned i_cb = 0, nof_cbs = codeblock_ids.size(); i_cb != nof_cbs; ++i_cb) {
+        writer.write<uint8_t>(static_cast<uint8_t>(crcs[i_cb]) | (static_cast<uint8_t>(has_softbits[i_cb]) << 1U));
+        if (has_softbits[i_cb]) {
+          writer.write_values(srsran::span<const uint8_t>(pool.get_packed_softbits(codeblock_ids[i_cb])));
+        }
+        if (crcs[i_cb]) {
+          writer.write_values(srsran::span<const uint8_t>(pool.get_data_bits(codeblock_ids[i_cb])));
+        }
+      }
+    }
+
+    /// \brief Reserves the buffer and restores its codeblocks from a checkpoint.
+    ///
+    /// The codeblocks are allocated anew: their absolute identifiers may differ from the ones of the saved buffer.
+    /// \return True on success, false if the checkpoint is not valid or the pool has not enough codeblocks.
+    bool load(checkpoint_reader& reader)
+    {
+      std::pair<uint16_t, unsigned> key_        = {reader.read<uint16_t>(), reader.read<uint32_t>()};
+      srsran::slot_point            expiration_ = reader.read_slot();
+      unsigned                      nof_cbs     = reader.read<uint32_t>();
+      if (!reader.is_valid() || !allocate(nof_cbs)) {
+        return false;
+      }
+      reserve(key_, expiration_, /* new_data = */ true);
+
+      for (unsigned i_cb = 0; i_cb != nof_cbs; ++i_cb) {
+        uint8_t flags      = reader.read<uint8_t>();
+        crcs[i_cb]         = ((flags & 1U) != 0);
+        has_softbits[i_cb] = ((flags & 2U) != 0);
+        if (has_softbits[i_cb]) {
+          reader.read_values(pool.get_packed_softbits(codeblock_ids[i_cb]));
+        }
+        if (crcs[i_cb]) {
+          reader.read_values(pool.get_data_bits(codeblock_ids[i_cb]));
+        }
+      }
+      return reader.is_valid();
+    }
+
+    // See srsran::rx_buffer for the documentation.
+    unsigned get_nof_codeblocks() const override { return codeblock_ids.size(); }
+
+    void reset_codeblocks_crc() override { std::fill(crcs.get(), crcs.get() + codeblock_ids.size(), false); }
+
+    srsran::span<bool> get_codeblocks_crc() override { return {crcs.get(), codeblock_ids.size()}; }
+
+    unsigned get_absolute_codeblock_id(unsigned codeblock_id) const override { return codeblock_ids[codeblock_id]; }
+
+    srsran::span<srsran::log_likelihood_ratio> get_codeblock_soft_bits(unsigned codeblock_id,
+                                                                       unsigned codeblock_size) override
+    {
+      srsran_assert(locked, "The buffer is not locked.");
+      srsran_assert(codeblock_size <= pool.codeblock_stride, "Invalid codeblock size {}.", codeblock_size);
+
+      srsran::span<srsran::log_likelihood_ratio> softbits = pool.get_working_softbits(codeblock_id);
+      if (!unpacked[codeblock_id]) {
+        if (has_softbits[codeblock_id]) {
+          pool.compressor.unpack(softbits, pool.get_packed_softbits(codeblock_ids[codeblock_id]));
+        }
+        unpacked[codeblock_id]     = true;
+        has_softbits[codeblock_id] = true;
+      }
+      return softbits.first(codeblock_size);
+    }
+
+    srsran::bit_buffer get_codeblock_data_bits(unsigned codeblock_id, unsigned data_size) override
+    {
+      srsran_assert(data_size <= 8 * pool.data_stride, "Invalid data size {}.", data_size);
+      return srsran::bit_buffer::from_bytes(pool.get_data_bits(codeblock_ids[codeblock_id])).first(data_size);
+    }
+
+    // See srsran::unique_rx_buffer::callback for the documentation.
+    void lock() override
+    {
+      srsran_assert(reserved && !locked, "The buffer must be reserved and unlocked.");
+      srsran_assert(pool.locked_buffer == nullptr, "Only one buffer can be locked at a time.");
+      locked             = true;
+      pool.locked_buffer = this;
+      pool.working_softbits.resize(
+          std::max(pool.working_softbits.size(), codeblock_ids.size() * std::size_t{pool.codeblock_stride}));
+      unpacked.assign(codeblock_ids.size(), false);
+    }
+
+    void unlock() override
+    {
+      // Compress the soft bits the decoder has accessed.
+      for (unsigned i_cb = 0, nof_cbs = codeblock_ids.size(); i_cb != nof_cbs; ++i_cb) {
+        if (unpacked[i_cb]) {
+          pool.compressor.pack(pool.get_packed_softbits(codeblock_ids[i_cb]), pool.get_working_softbits(i_cb));
+        }
+      }
+      locked             = false;
+      pool.locked_buffer = nullptr;
+    }
+
+    void release() override
+    {
+      locked             = false;
+      pool.locked_buffer = nullptr;
+      free();
+    }
+
+  private:
+    /// Returns the codeblocks to the pool.
+    void release_codeblocks()
+    {
+      pool.free_codeblocks.insert(pool.free_codeblocks.end(), codeblock_ids.rbegin(), codeblock_ids.rend());
+      codeblock_ids.clear();
+      has_softbits.clear();
+    }
+
+    /// Pool the buffer belongs to.
+    compressed_rx_buffer_pool& pool;
+    /// Reservation flag.
+    bool reserved = false;
+    /// Lock flag.
+    bool locked = false;
+    /// Buffer identifier (RNTI and HARQ process ID).
+    std::pair<uint16_t, unsigned> key;
+    /// Slot at which the reservation expires.
+    srsran::slot_point expiration;
+    /// Indices of the codeblocks of the buffer within the pool.
+    std::vector<unsigned> codeblock_ids;
+    /// Codeblock CRC flags.
+    std::unique_ptr<bool[]> crcs;
+    /// Whether each codeblock stores soft bits from a previous transmission.
+    std::vector<bool> has_softbits;
+    /// Whether each codeblock is decompressed in the working area (locked buffer only).
+    std::vector<bool> unpacked;
+  };
+
+  /// Returns the compressed soft bits of a codeblock of the pool.
+  srsran::span<uint8_t> get_packed_softbits(unsigned absolute_codeblock_id)
+  {
+    return srsran::span<uint8_t>(packed_softbits).subspan(std::size_t{absolute_codeblock_id} * packed_stride,
+                                                          packed_stride);
+  }
+
+  /// Returns the data bits of a codeblock of the pool.
+  srsran::span<uint8_t> get_data_bits(unsigned absolute_codeblock_id)
+  {
+    return srsran::span<uint8_t>(data_bits).subspan(std::size_t{absolute_codeblock_id} * data_stride, data_stride);
+  }
+
+  /// Returns the working soft bits of a codeblock of the locked buffer.
+  srsran::span<srsran::log_likelihood_ratio> get_working_softbits(unsigned codeblock_id)
+  {
+    return srsran::span<srsran::log_likelihood_ratio>(working_softbits)
+        .subspan(std::size_t{codeblock_id} * codeblock_stride, codeblock_stride);
+  }
+
+  /// Soft bit compressor.
+  softbit_compressor compressor;
+  /// Buffer expiration time as a number of slots.
+  unsigned expire_timeout_slots;
+  /// Number of soft bits per codeblock (the maximum codeblock size, rounded up to a group of compressed LLRs).
+  unsigned codeblock_stride;
+  /// Number of bytes storing the compressed soft bits of a codeblock.
+  unsigned packed_stride;
+  /// Number of bytes storing the data bits of a codeblock.
+  unsigned data_stride;
+  /// Compressed soft bits of all codeblocks.
+  std::vector<uint8_t> packed_softbits;
+  /// Data bits of all codeblocks.
+  std::vector<uint8_t> data_bits;
+  /// Full-width soft bits of the codeblocks of the locked buffer.
+  std::vector<srsran::log_likelihood_ratio> working_softbits;
+  /// Indices of the codeblocks that are not allocated to any buffer.
+  std::vector<unsigned> free_codeblocks;
+  /// Buffers of the pool.
+  std::vector<std::unique_ptr<buffer>> buffers;
+  /// Currently locked buffer, if any.
+  buffer* locked_buffer = nullptr;
+};
+
+} // namespace srsran_matlab
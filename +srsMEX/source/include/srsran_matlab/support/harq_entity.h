@@ -0,0 +1,276 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief HARQ entity for a set of stop-and-wait HARQ processes.
+
+#pragma once
+
+#include "srsran_matlab/support/checkpoint_file.h"
+#include "srsran/support/srsran_assert.h"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace srsran_matlab {
+
+/// HARQ information of a transmission.
+struct harq_transmission {
+  /// HARQ process identifier.
+  unsigned harq_process_id = 0;
+  /// Transmission number within the redundancy version sequence (0 for new data).
+  unsigned transmission_number = 0;
+  /// Redundancy version.
+  unsigned rv = 0;
+  /// New data flag: true if the transmission starts a new redundancy version sequence.
+  bool new_data = true;
+  /// Timeout flag: true if the previous redundancy version sequence of the process ended without success.
+  bool sequence_timeout = false;
+};
+
+/// Statistics of a HARQ process.
+struct harq_process_statistics {
+  /// HARQ process identifier.
+  unsigned harq_process_id = 0;
+  /// Number of transmissions, including retransmissions.
+  uint64_t nof_transmissions = 0;
+  /// Number of new data transmissions.
+  uint64_t nof_new_transmissions = 0;
+  /// Number of redundancy version sequences that ended without success.
+  uint64_t nof_timeouts = 0;
+  /// Number of transmitted information bits (retransmissions included).
+  uint64_t total_bits = 0;
+  /// Number of successfully received information bits.
+  uint64_t successful_bits = 0;
+  /// Number of successful receptions for each transmission number of the redundancy version sequence.
+  std::vector<uint64_t> nof_successes;
+};
+
+/// \brief HARQ entity.
+///
+/// Manages a set of parallel stop-and-wait HARQ processes for a single UE, as the MATLAB class \c HARQEntity of the
+/// PUSCHBLER simulator does. The processes are scheduled according to a fixed sequence of HARQ process identifiers and
+/// share the same redundancy version (RV) sequence. A process moves to the next RV of the sequence after a failed
+/// reception and starts a new sequence after a successful reception or after the last RV of the sequence.
+class harq_entity
+{
+public:
+  /// \brief Creates a HARQ entity.
+  ///
+  /// \param[in] rnti_              UE RNTI.
+  /// \param[in] process_sequence_  Fixed sequence of HARQ process identifiers (may contain repetitions).
+  /// \param[in] rv_sequence_       Redundancy version sequence shared by all processes.
+  harq_entity(uint16_t rnti_, std::vector<unsigned> process_sequence_, std::vector<unsigned> rv_sequence_) :
+    rnti(rnti_), process_sequence(std::move(process_sequence_)), rv_sequence(std::move(rv_sequence_))
+  {
+    srsran_assert(!process_sequence.empty(), "The HARQ process sequence is empty.");
+    srsran_assert(!rv_sequence.empty(), "The RV sequence is empty.");
+
+    // Map each position of the sequence onto the state of its process, sorted by process identifier.
+    std::vector<unsigned> process_ids = process_sequence;
+    std::sort(process_ids.begin(), process_ids.end());
+    process_ids.erase(std::unique(process_ids.begin(), process_ids.end()), process_ids.end());
+
+    state_order.reserve(process_sequence.size());
+    for (unsigned id : process_sequence) {
+      state_order.push_back(std::lower_bound(process_ids.begin(), process_ids.end(), id) - process_ids.begin());
+    }
+
+    states.resize(process_ids.size());
+    statistics.resize(process_ids.size());
+    for (unsigned i_process = 0, nof_processes = process_ids.size(); i_process != nof_processes; ++i_process) {
+      statistics[i_process].harq_process_id = process_ids[i_process];
+      statistics[i_process].nof_successes.resize(rv_sequence.size(), 0);
+    }
+
+    load_current();
+  }
+
+  /// Returns the UE RNTI.
+  uint16_t get_rnti() const { return rnti; }
+
+  /// Returns the HARQ information of the current transmission.
+  const harq_transmission& get_transmission() const { return current; }
+
+  /// Returns true if the current transmission is the last one of the RV sequence of its process.
+  bool is_last_transmission() const { return current.transmission_number + 1 == rv_sequence.size(); }
+
+  /// \brief Returns the transport block size of the current process, in bits.
+  ///
+  /// The size is the one of the last new data transmission of the process, zero if the process never transmitted.
+  unsigned get_tbs() const { return states[state_order[i_sequence]].tbs; }
+
+  /// Returns the statistics of all HARQ processes, sorted by HARQ process identifier.
+  const std::vector<harq_process_statistics>& get_statistics() const { return statistics; }
+
+  /// \brief Updates the current process with the reception outcome and advances to the next process of the sequence.
+  ///
+  /// \param[in] crc_ok  Reception outcome: true if the transport block CRC is valid.
+  /// \param[in] tbs     Transport block size, in bits.
+  /// \return True if the RV sequence of the updated process timed out, i.e., if the last RV of the sequence failed.
+  bool update(bool crc_ok, unsigned tbs)
+  {
+    process_state&           state = states[state_order[i_sequence]];
+    harq_process_statistics& stats = statistics[state_order[i_sequence]];
+
+    if (current.new_data) {
+      state.tbs = tbs;
+      ++stats.nof_new_transmissions;
+    }
+    ++stats.nof_transmissions;
+    stats.total_bits += tbs;
+
+    bool timeout = false;
+    if (crc_ok) {
+      ++stats.nof_successes[state.rv_index];
+      stats.successful_bits += tbs;
+      state.rv_index = 0;
+    } else if (++state.rv_index == rv_sequence.size()) {
+      state.rv_index = 0;
+      timeout        = true;
+      ++stats.nof_timeouts;
+    }
+    state.timeout = timeout;
+
+    i_sequence = (i_sequence + 1) % process_sequence.size();
+    load_current();
+
+    return timeout;
+  }
+
+  /// Writes the configuration, the state and the statistics of the entity to a checkpoint.
+  void save(checkpoint_writer& writer) const
+  {
+    writer.write(rnti);
+    writer.write<uint32_t>(process_sequence.size());
+    writer.write_values(srsran::span<const unsigned>(process_sequence));
+    writer.write<uint32_t>(rv_sequence.size());
+    writer.write_values(srsran::span<const unsigned>(rv_sequence));
+    writer.write<uint32_t>(i_sequence);
+
+    for (const process_state& state : states) {
+      writer.write<uint32_t>(state.rv_index);
+      writer.write<uint8_t>(state.timeout);
+      writer.write<uint32_t>(state.tbs);
+    }
+
+    for (const harq_process_statistics& stats : statistics) {
+      writer.write(stats.nof_transmissions);
+      writer.write(stats.nof_new_transmissions);
+      writer.write(stats.nof_timeouts);
+      writer.write(stats.total_bits);
+      writer.write(stats.successful_bits);
+      writer.write_values(srsran::span<const uint64_t>(stats.nof_successes));
+    }
+  }
+
+  /// \brief Restores the state and the statistics of the entity from a checkpoint.
+  ///
+  /// The checkpoint must come from an entity with the same configuration (RNTI, process and RV sequences).
+  /// \return True on success, false if the checkpoint is not valid for the entity (the entity is then in an
+  /// unspecified state).
+  bool load(checkpoint_reader& reader)
+  {
+    if ((reader.read<uint16_t>() != rnti) || !check_sequence(reader, process_sequence) ||
+        !check_sequence(reader, rv_sequence)) {
+      return false;
+    }
+
+    i_sequence = reader.read<uint32_t>();
+    if (i_sequence >= process_sequence.size()) {
+      return false;
+    }
+
+    for (process_state& state : states) {
+      state.rv_index = reader.read<uint32_t>();
+      state.timeout  = (reader.read<uint8_t>() != 0);
+      state.tbs      = reader.read<uint32_t>();
+      if (state.rv_index >= rv_sequence.size()) {
+        return false;
+      }
+    }
+
+    for (harq_process_statistics& stats : statistics) {
+      stats.nof_transmissions     = reader.read<uint64_t>();
+      stats.nof_new_transmissions = reader.read<uint64_t>();
+      stats.nof_timeouts          = reader.read<uint64_t>();
+      stats.total_bits            = reader.read<uint64_t>();
+      stats.successful_bits       = reader.read<uint64_t>();
+      reader.read_values(srsran::span<uint64_t>(stats.nof_successes));
+    }
+
+    if (!reader.is_valid()) {
+      return false;
+    }
+    load_current();
+    return true;
+  }
+
+private:
+  /// Checks that the sequence read from a checkpoint is equal to the given one.
+  static bool check_sequence(checkpoint_reader& reader, const std::vector<unsigned>& sequence)
+  {
+    if (reader.read<uint32_t>() != sequence.size()) {
+      return false;
+    }
+    std::vector<unsigned> saved_sequence(sequence.size());
+    return reader.read_values(srsran::span<unsigned>(saved_sequence)) && (saved_sequence == sequence);
+  }
+
+  /// State of a HARQ process.
+  struct process_state {
+    /// Index of the next transmission in the RV sequence.
+    unsigned rv_index = 0;
+    /// Whether the last RV sequence ended without success.
+    bool timeout = false;
+    /// Transport block size of the last new data transmission.
+    unsigned tbs = 0;
+  };
+
+  /// Loads the HARQ information of the current position of the process sequence.
+  void load_current()
+  {
+    const process_state& state  = states[state_order[i_sequence]];
+    current.harq_process_id     = process_sequence[i_sequence];
+    current.transmission_number = state.rv_index;
+    current.rv                  = rv_sequence[state.rv_index];
+    current.new_data            = (state.rv_index == 0);
+    current.sequence_timeout    = state.timeout;
+  }
+
+  /// UE RNTI.
+  uint16_t rnti;
+  /// Fixed sequence of HARQ process identifiers.
+  std::vector<unsigned> process_sequence;
+  /// RV sequence shared by all processes.
+  std::vector<unsigned> rv_sequence;
+  /// Index of the state of the process at each position of the process sequence.
+  std::vector<unsigned> state_order;
+  /// States of the HARQ processes, sorted by HARQ process identifier.
+  std::vector<process_state> states;
+  /// Statistics of the HARQ processes, sorted by HARQ process identifier.
+  std::vector<harq_process_statistics> statistics;
+  /// Current position in the process sequence.
+  unsigned i_sequence = 0;
+  /// HARQ information of the current transmission.
+  harq_transmission current;
+};
+
+} // namespace srsran_matlab
@@ -0,0 +1,324 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Low-PAPR sequence collections shared by all the MEX processes of a user.
+///
+/// Every MEX process (e.g., every \c parfor worker) builds its own low-PAPR sequence collections, one for each PUCCH
+/// detector or DM-RS estimator. The collections are immutable: the factory defined here builds each of them once per
+/// user and srsRAN version, stores it in a cache file and maps the file read-only into the memory of the processes
+/// that need it. The processes thus share the same physical pages and skip the generation of the sequences.
+
+#pragma once
+
+#include "srsran_matlab/support/checkpoint_file.h"
+#include "srsran/adt/complex.h"
+#include "srsran/adt/span.h"
+#include "srsran/phy/upper/sequence_generators/low_papr_sequence_collection.h"
+#include "srsran/phy/upper/sequence_generators/sequence_generator_factories.h"
+#include "srsran/support/srsran_assert.h"
+#include "fmt/format.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+#include <vector>
+
+namespace srsran_matlab {
+
+/// \brief Returns the directory of the table cache files of the user.
+///
+/// The directory is given by the environment variable \c SRSRAN_MATLAB_CACHE_DIR, if set, or it is the subdirectory
+/// \c srsran_matlab_cache_<uid> of the temporary directory, where \c uid is the user ID. An empty string means that no
+/// cache directory is available. See prepare_table_cache_directory() for its creation.
+inline std::string get_table_cache_directory()
+{
+  if (const char* env_directory = std::getenv("SRSRAN_MATLAB_CACHE_DIR"); env_directory != nullptr) {
+    return env_directory;
+  }
+  std::error_code       error;
+  std::filesystem::path directory = std::filesystem::temp_directory_path(error);
+  if (error) {
+    return {};
+  }
+  return (directory / fmt::format("srsran_matlab_cache_{}", ::geteuid())).string();
+}
+
+/// \brief Creates the given table cache directory, if it does not exist, and checks that it is private.
+///
+/// The directory is created with permissions 0700 (its parent must exist). An existing directory must be a directory,
+/// not a symbolic link, owned by the user and not writable by the group or by other users: the files of a cache
+/// directory that other users can modify cannot be trusted.
+/// \return True if the directory can be used as a cache, false otherwise.
+inline bool prepare_table_cache_directory(const std::string& directory)
+{
+  if (directory.empty() || ((::mkdir(directory.c_str(), S_IRWXU) != 0) && (errno != EEXIST))) {
+    return false;
+  }
+  struct stat directory_stat = {};
+  return (::lstat(directory.c_str(), &directory_stat) == 0) && S_ISDIR(directory_stat.st_mode) &&
+         (directory_stat.st_uid == ::geteuid()) && ((directory_stat.st_mode & (S_IWGRP | S_IWOTH)) == 0);
+}
+
+/// \brief Low-PAPR sequence collection mapped from a cache file.
+///
+/// The sequences of all groups, bases and cyclic shifts are stored contiguously in the file, which is mapped read-only.
+class mapped_low_papr_sequence_collection : public srsran::low_papr_sequence_collection
+{
+public:
+  /// Number of sequence groups \f$u\f$ (TS38.211 Section 5.2.2.1).
+  static constexpr unsigned nof_groups = 30;
+  /// Number of sequence bases \f$v\f$ within a group (TS38.211 Section 5.2.2.1).
+  static constexpr unsigned nof_bases = 2;
+
+  /// \brief Writes all the sequences of a collection to a cache file.
+  ///
+  /// \param[in] path        Cache file name.
+  /// \param[in] collection  Low-PAPR sequence collection.
+  /// \param[in] m           Collection parameter \f$m\f$, as in the factory.
+  /// \param[in] delta       Collection parameter \f$\delta\f$, as in the factory.
+  /// \param[in] alphas      Cyclic shifts of the collection, as in the factory.
+  /// \return True on success, false otherwise.
+  static bool save(const std::string&                         path,
+                   const srsran::low_papr_sequence_collection& collection,
+                   unsigned                                   m,
+                   unsigned                                   delta,
+                   srsran::span<const float>                  alphas)
+  {
+    unsigned sequence_length = collection.get(0, 0, 0).size();
+
+    checkpoint_writer writer;
+    writer.write<uint32_t>(m);
+    writer.write<uint32_t>(delta);
+    writer.write<uint32_t>(alphas.size());
+    writer.write_values(alphas);
+    writer.write<uint32_t>(sequence_length);
+    writer.align(cache_alignment);
+    for (unsigned u = 0; u != nof_groups; ++u) {
+      for (unsigned v = 0; v != nof_bases; ++v) {
+        for (unsigned alpha_idx = 0, nof_alphas = alphas.size(); alpha_idx != nof_alphas; ++alpha_idx) {
+          writer.write_values(collection.get(u, v, alpha_idx));
+        }
+      }
+    }
+    return writer.save(path);
+  }
+
+  /// \brief Maps a collection from a cache file.
+  ///
+  /// \return A collection pointing to the sequences of the file, \c nullptr if the file does not exist or if it does
+  /// not store a collection with the given parameters.
+  static std::unique_ptr<mapped_low_papr_sequence_collection>
+  load(const std::string& path, unsigned m, unsigned delta, srsran::span<const float> alphas)
+  {
+    auto reader = std::make_unique<checkpoint_reader>(path);
+    if (!reader->is_valid() || (reader->read<uint32_t>() != m) || (reader->read<uint32_t>() != delta) ||
+        (reader->read<uint32_t>() != alphas.size())) {
+      return nullptr;
+    }
+
+    std::vector<float> saved_alphas(alphas.size());
+    reader->read_values(srsran::span<float>(saved_alphas));
+    if (!std::equal(alphas.begin(), alphas.end(), saved_alphas.begin())) {
+      return nullptr;
+    }
+
+    unsigned sequence_length = reader->read<uint32_t>();
+    reader->align(cache_alignment);
+    srsran::span<const srsran::cf_t> sequences =
+        reader->map_values<srsran::cf_t>(std::size_t{nof_groups} * nof_bases * alphas.size() * sequence_length);
+    if (!reader->is_valid() || (sequence_length == 0)) {
+      return nullptr;
+    }
+
+    return std::make_unique<mapped_low_papr_sequence_collection>(
+        std::move(reader), sequences, sequence_length, alphas.size());
+  }
+
+  /// \brief Creates a collection from the sequences mapped by a cache file reader (see load()).
+  ///
+  /// \param[in] reader_           Reader of the cache file, which keeps the file mapped.
+  /// \param[in] sequences_        Mapped sequences, sorted by group, base and cyclic shift.
+  /// \param[in] sequence_length_  Length of the sequences.
+  /// \param[in] nof_alphas_       Number of cyclic shifts.
+  mapped_low_papr_sequence_collection(std::unique_ptr<checkpoint_reader> reader_,
+                                      srsran::span<const srsran::cf_t>   sequences_,
+                                      unsigned                           sequence_length_,
+                                      unsigned                           nof_alphas_) :
+    reader(std::move(reader_)), sequences(sequences_), sequence_length(sequence_length_), nof_alphas(nof_alphas_)
+  {
+  }
+
+  // See interface for documentation.
+  srsran::span<const srsran::cf_t> get(unsigned u, unsigned v, unsigned alpha_idx) const override
+  {
+    srsran_assert((u < nof_groups) && (v < nof_bases) && (alpha_idx < nof_alphas),
+                  "Invalid sequence indices (u={}, v={}, alpha_idx={}).",
+                  u,
+                  v,
+                  alpha_idx);
+    return sequences.subspan(((std::size_t{u} * nof_bases + v) * nof_alphas + alpha_idx) * sequence_length,
+                             sequence_length);
+  }
+
+private:
+  /// Alignment of the sequences within the cache file, in bytes.
+  static constexpr std::size_t cache_alignment = 64;
+
+  /// Reader of the cache file, which keeps the file mapped.
+  std::unique_ptr<checkpoint_reader> reader;
+  /// Mapped sequences.
+  srsran::span<const srsran::cf_t> sequences;
+  /// Length of the sequences.
+  unsigned sequence_length;
+  /// Number of cyclic shifts.
+  unsigned nof_alphas;
+};
+
+/// \brief Low-PAPR sequence collection factory with a per-user cache.
+///
+/// Creates collections mapped from the cache files of the user (see mapped_low_papr_sequence_collection). A missing
+/// cache file is built with the collections of the wrapped factory. If the cache is not available (e.g., on a
+/// read-only file system or if the cache directory is not private, see prepare_table_cache_directory()), the factory
+/// returns the collections of the wrapped factory.
+///
+/// A different srsRAN version may generate different sequences. The cache files are thus keyed on a fingerprint of the
+/// wrapped factory, i.e., a hash of a few short collections it generates: all the builds of the MEX linked against
+/// the same srsRAN sequence generators share the same files.
+class low_papr_sequence_collection_cached_factory : public srsran::low_papr_sequence_collection_factory
+{
+public:
+  /// \brief Creates a factory.
+  ///
+  /// \param[in] factory_          Factory of the collections stored in the cache.
+  /// \param[in] cache_directory_  Directory of the cache files (no cache if empty).
+  low_papr_sequence_collection_cached_factory(std::shared_ptr<srsran::low_papr_sequence_collection_factory> factory_,
+                                              std::string cache_directory_) :
+    factory(std::move(factory_)), cache_directory(std::move(cache_directory_))
+  {
+    srsran_assert(factory, "Invalid low-PAPR sequence collection factory.");
+    if (!prepare_table_cache_directory(cache_directory)) {
+      cache_directory.clear();
+      return;
+    }
+    factory_fingerprint = compute_factory_fingerprint();
+  }
+
+  // See interface for documentation.
+  std::unique_ptr<srsran::low_papr_sequence_collection>
+  create(unsigned m, unsigned delta, srsran::span<const float> alphas) override
+  {
+    if (cache_directory.empty()) {
+      return factory->create(m, delta, alphas);
+    }
+
+    // The threads of the process write the cache file through the same temporary file.
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::string path = get_cache_path(m, delta, alphas);
+    if (std::unique_ptr<srsran::low_papr_sequence_collection> mapped =
+            mapped_low_papr_sequence_collection::load(path, m, delta, alphas)) {
+      return mapped;
+    }
+
+    std::unique_ptr<srsran::low_papr_sequence_collection> collection = factory->create(m, delta, alphas);
+    if (collection && mapped_low_papr_sequence_collection::save(path, *collection, m, delta, alphas)) {
+      if (std::unique_ptr<srsran::low_papr_sequence_collection> mapped =
+              mapped_low_papr_sequence_collection::load(path, m, delta, alphas)) {
+        return mapped;
+      }
+    }
+    return collection;
+  }
+
+private:
+  /// Adds the bytes of a sequence of values to a 64-bit FNV-1a hash.
+  template <typename T>
+  static uint64_t add_to_hash(uint64_t hash, srsran::span<const T> values)
+  {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(values.data());
+    for (std::size_t i_byte = 0, nof_bytes = values.size() * sizeof(T); i_byte != nof_bytes; ++i_byte) {
+      hash = (hash ^ bytes[i_byte]) * 0x100000001b3ULL;
+    }
+    return hash;
+  }
+
+  /// \brief Returns a hash of the sequences of two short collections of the wrapped factory.
+  ///
+  /// The collections cover a length generated from the tables of TS38.211 Section 5.2.2.2 and one generated from a
+  /// Zadoff-Chu sequence (Section 5.2.2.1), so that any change in either kind of sequence changes the fingerprint.
+  uint64_t compute_factory_fingerprint() const
+  {
+    static constexpr std::array<float, 2> fingerprint_alphas = {0.0F, 1.0F};
+    uint64_t                              hash               = 0xcbf29ce484222325ULL;
+    for (unsigned m : {1U, 3U}) {
+      std::unique_ptr<srsran::low_papr_sequence_collection> collection =
+          factory->create(m, 0, srsran::span<const float>(fingerprint_alphas));
+      for (unsigned u = 0; u != mapped_low_papr_sequence_collection::nof_groups; ++u) {
+        for (unsigned v = 0; v != mapped_low_papr_sequence_collection::nof_bases; ++v) {
+          for (unsigned alpha_idx = 0; alpha_idx != fingerprint_alphas.size(); ++alpha_idx) {
+            hash = add_to_hash(hash, collection->get(u, v, alpha_idx));
+          }
+        }
+      }
+    }
+    return hash;
+  }
+
+  /// \brief Returns the cache file name of a collection.
+  ///
+  /// The name depends on the collection parameters and on the wrapped factory, through a hash of the cyclic shifts and
+  /// of the factory fingerprint.
+  std::string get_cache_path(unsigned m, unsigned delta, srsran::span<const float> alphas) const
+  {
+    uint64_t hash = add_to_hash(factory_fingerprint, alphas);
+    return fmt::format("{}/low_papr_m{}_d{}_{:016x}.bin", cache_directory, m, delta, hash);
+  }
+
+  /// Factory of the collections stored in the cache.
+  std::shared_ptr<srsran::low_papr_sequence_collection_factory> factory;
+  /// Directory of the cache files.
+  std::string cache_directory;
+  /// Fingerprint of the wrapped factory (see compute_factory_fingerprint()).
+  uint64_t factory_fingerprint = 0;
+  /// Protects the cache files from concurrent writes by the threads of the process.
+  std::mutex mutex;
+};
+
+/// \brief Creates a low-PAPR sequence collection factory with a per-user cache.
+///
+/// The collections are generated by the srsRAN software factory with the given generator factory and cached in the
+/// directory returned by get_table_cache_directory().
+inline std::shared_ptr<srsran::low_papr_sequence_collection_factory> create_low_papr_sequence_collection_cached_factory(
+    std::shared_ptr<srsran::low_papr_sequence_generator_factory> generator_factory)
+{
+  return std::make_shared<low_papr_sequence_collection_cached_factory>(
+      srsran::create_low_papr_sequence_collection_sw_factory(std::move(generator_factory)),
+      get_table_cache_directory());
+}
+
+} // namespace srsran_matlab
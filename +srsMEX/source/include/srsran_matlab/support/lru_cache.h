@@ -0,0 +1,133 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Least-recently-used cache.
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace srsran_matlab {
+
+/// \brief Least-recently-used (LRU) cache.
+///
+/// Stores up to a given number of key&ndash;value pairs. When the cache is full, inserting a new entry evicts the
+/// entry that was accessed least recently.
+///
+/// \tparam Key    Key type, it must be equality comparable.
+/// \tparam Value  Value type.
+/// \tparam Hash   Hash function object for \c Key.
+/// \remark The cache is not thread-safe.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class lru_cache
+{
+public:
+  /// Creates a cache with the given capacity (at least one entry).
+  explicit lru_cache(unsigned capacity_) : capacity(std::max(1U, capacity_)) {}
+
+  /// \brief Looks for an entry in the cache.
+  ///
+  /// If found, the entry becomes the most recently used one.
+  /// \return A pointer to the cached value, or \c nullptr if the key is not in the cache. The pointer is valid until
+  /// the entry is evicted.
+  const Value* find(const Key& key)
+  {
+    auto it = index.find(key);
+    if (it == index.end()) {
+      ++nof_misses;
+      return nullptr;
+    }
+    ++nof_hits;
+    entries.splice(entries.begin(), entries, it->second);
+    return &it->second->second;
+  }
+
+  /// \brief Inserts an entry in the cache, evicting the least recently used one if the cache is full.
+  ///
+  /// If the key is already in the cache, its value is replaced.
+  /// \return A reference to the cached value, valid until the entry is evicted.
+  const Value& insert(const Key& key, Value value)
+  {
+    auto it = index.find(key);
+    if (it != index.end()) {
+      it->second->second = std::move(value);
+      entries.splice(entries.begin(), entries, it->second);
+      return it->second->second;
+    }
+
+    if (entries.size() == capacity) {
+      index.erase(entries.back().first);
+      entries.pop_back();
+      ++nof_evictions;
+    }
+
+    entries.emplace_front(key, std::move(value));
+    index.emplace(key, entries.begin());
+    return entries.front().second;
+  }
+
+  /// Removes all entries from the cache and resets the statistics.
+  void clear()
+  {
+    entries.clear();
+    index.clear();
+    nof_hits      = 0;
+    nof_misses    = 0;
+    nof_evictions = 0;
+  }
+
+  /// Returns the number of entries in the cache.
+  unsigned size() const { return entries.size(); }
+
+  /// Returns the maximum number of entries in the cache.
+  unsigned get_capacity() const { return capacity; }
+
+  /// Returns the number of successful lookups since the last clear.
+  unsigned long get_nof_hits() const { return nof_hits; }
+
+  /// Returns the number of failed lookups since the last clear.
+  unsigned long get_nof_misses() const { return nof_misses; }
+
+  /// Returns the number of evicted entries since the last clear.
+  unsigned long get_nof_evictions() const { return nof_evictions; }
+
+private:
+  /// Cache entry type.
+  using entry_type = std::pair<Key, Value>;
+
+  /// Maximum number of entries.
+  unsigned capacity;
+  /// Cache entries, from the most recently used to the least recently used.
+  std::list<entry_type> entries;
+  /// Index of the cache entries.
+  std::unordered_map<Key, typename std::list<entry_type>::iterator, Hash> index;
+  /// Number of successful lookups.
+  unsigned long nof_hits = 0;
+  /// Number of failed lookups.
+  unsigned long nof_misses = 0;
+  /// Number of evicted entries.
+  unsigned long nof_evictions = 0;
+};
+
+} // namespace srsran_matlab
@@ -23,6 +23,7 @@
 #pragma once
 
 #include "srsran/phy/upper/dmrs_mapping.h"
+#include "srsran/ran/csi_rs/csi_rs_types.h"
 #include "srsran/ran/cyclic_prefix.h"
 #include "srsran/ran/prach/prach_format_type.h"
 #include "srsran/ran/prach/restricted_set_config.h"
@@ -150,4 +151,44 @@ inline srsran::subcarrier_spacing matlab_to_srs_subcarrier_spacing(unsigned scs_
   srsran::srsran_terminate("Unknown subcarrier spacing {} kHz.", scs_kHz);
 }
 
+/// \brief Converts a MATLAB CSI-RS CDM type string into an srsRAN CSI-RS CDM type.
+/// \param[in] cdm A CDM type string in <tt>{"noCDM", "FD-CDM2", "CDM4", "CDM8"}</tt>.
+/// \return A CSI-RS CDM type identifier according to srsRAN convention.
+inline srsran::csi_rs_cdm_type matlab_to_srs_csi_rs_cdm_type(const std::string& cdm)
+{
+  if (cdm == "noCDM") {
+    return srsran::csi_rs_cdm_type::no_CDM;
+  }
+  if (cdm == "FD-CDM2") {
+    return srsran::csi_rs_cdm_type::fd_CDM2;
+  }
+  if (cdm == "CDM4") {
+    return srsran::csi_rs_cdm_type::cdm4_FD2_TD2;
+  }
+  if (cdm == "CDM8") {
+    return srsran::csi_rs_cdm_type::cdm8_FD2_TD4;
+  }
+  srsran::srsran_terminate("Unknown CSI-RS CDM type {}.", cdm);
+}
+
+/// \brief Converts a MATLAB CSI-RS density string into an srsRAN CSI-RS frequency density.
+/// \param[in] density A density string in <tt>{"one", "three", "dot5even", "dot5odd"}</tt>.
+/// \return A CSI-RS frequency density identifier according to srsRAN convention.
+inline srsran::csi_rs_freq_density_type matlab_to_srs_csi_rs_density(const std::string& density)
+{
+  if (density == "one") {
+    return srsran::csi_rs_freq_density_type::one;
+  }
+  if (density == "three") {
+    return srsran::csi_rs_freq_density_type::three;
+  }
+  if (density == "dot5even") {
+    return srsran::csi_rs_freq_density_type::dot5_even_RB;
+  }
+  if (density == "dot5odd") {
+    return srsran::csi_rs_freq_density_type::dot5_odd_RB;
+  }
+  srsran::srsran_terminate("Unknown CSI-RS density {}.", density);
+}
+
 } // namespace srsran_matlab
@@ -0,0 +1,102 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Utilities to process independent items on a pool of worker threads.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace srsran_matlab {
+
+/// \brief Returns the default number of worker threads.
+///
+/// The default is the number of hardware threads reported by the system, or one if it cannot be determined.
+inline unsigned default_nof_workers()
+{
+  return std::max(1U, std::thread::hardware_concurrency());
+}
+
+/// \brief Processes a number of independent items on a pool of worker threads.
+///
+/// Items are handed to the workers dynamically, so that each worker picks the next unprocessed item as soon as it is
+/// done with the previous one. The task is called as <tt>task(i_item, i_worker)</tt>, where \c i_worker identifies the
+/// calling worker and can be used to index per-worker resources (e.g., one srsRAN processor per worker), since a
+/// worker never processes two items at the same time. The function returns when all items have been processed.
+///
+/// \param[in] nof_items    Number of items to process.
+/// \param[in] nof_workers  Maximum number of worker threads. When one, the items are processed in the calling thread.
+/// \param[in] task         Callable processing one item.
+///
+/// \remark The MATLAB API is not thread-safe: \c task must not create MATLAB arrays nor call \c mex_abort. If \c task
+/// throws, the remaining items are skipped and the first exception is rethrown in the calling thread.
+template <typename Task>
+void parallel_for(unsigned nof_items, unsigned nof_workers, const Task& task)
+{
+  nof_workers = std::max(1U, std::min(nof_workers, nof_items));
+
+  if (nof_workers == 1) {
+    for (unsigned i_item = 0; i_item != nof_items; ++i_item) {
+      task(i_item, 0U);
+    }
+    return;
+  }
+
+  std::atomic<unsigned> next_item = {0};
+  std::atomic<bool>     abort    = {false};
+  std::exception_ptr    error    = nullptr;
+  std::mutex            error_mutex;
+
+  auto worker = [&](unsigned i_worker) {
+    for (unsigned i_item = next_item++; (i_item < nof_items) && !abort; i_item = next_item++) {
+      try {
+        task(i_item, i_worker);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+        abort = true;
+      }
+    }
+  };
+
+  // The calling thread acts as worker 0.
+  std::vector<std::thread> threads;
+  threads.reserve(nof_workers - 1);
+  for (unsigned i_worker = 1; i_worker != nof_workers; ++i_worker) {
+    threads.emplace_back(worker, i_worker);
+  }
+  worker(0);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+} // namespace srsran_matlab
@@ -0,0 +1,329 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Helpers shared by the MEX functions that configure the PUCCH processor from a MATLAB structure.
+///
+/// The fields of the MATLAB structure are described in the documentation of the PUCCH processor MEX method_step().
+
+#pragma once
+
+#include "srsran_matlab/support/matlab_to_srs.h"
+#include "srsran/phy/upper/channel_processors/pucch/pucch_processor.h"
+#include <MatlabDataArray.hpp>
+#include <optional>
+
+namespace srsran_matlab {
+
+/// Builds a PUCCH Format 0 processor configuration from a MATLAB structure (see pucch_processor_mex).
+inline srsran::pucch_processor::format0_configuration
+populate_pucch_f0_configuration(const matlab::data::Struct& in_cfg)
+{
+  // Create a PUCCH F0 configuration object.
+  srsran::pucch_processor::format0_configuration cfg = {};
+
+  cfg.context = std::nullopt;
+
+  // Set the slot point.
+  unsigned scs_kHz    = in_cfg["SubcarrierSpacing"][0];
+  unsigned slot_count = in_cfg["NSlot"][0];
+  cfg.slot            = {matlab_to_srs_subcarrier_spacing(scs_kHz), slot_count};
+
+  // Set the cyclic prefix.
+  const matlab::data::CharArray in_cp = in_cfg["CP"];
+  cfg.cp                              = matlab_to_srs_cyclic_prefix(in_cp.toAscii());
+
+  // Set the port indices.
+  unsigned nof_ports = in_cfg["NRxPorts"][0];
+  cfg.ports.clear();
+  for (unsigned i_port = 0; i_port != nof_ports; ++i_port) {
+    cfg.ports.push_back(i_port);
+  }
+
+  // Set the BWP.
+  cfg.bwp_size_rb  = static_cast<unsigned>(in_cfg["NSizeBWP"][0]);
+  cfg.bwp_start_rb = static_cast<unsigned>(in_cfg["NStartBWP"][0]);
+
+  // Set the frequency allocation.
+  cfg.starting_prb   = static_cast<unsigned>(in_cfg["StartPRB"][0]);
+  cfg.second_hop_prb = std::nullopt;
+  if (!in_cfg["SecondHopStartPRB"].isEmpty()) {
+    cfg.second_hop_prb = static_cast<unsigned>(in_cfg["SecondHopStartPRB"][0]);
+  }
+
+  // Set the time allocation.
+  cfg.start_symbol_index = static_cast<unsigned>(in_cfg["StartSymbolIndex"][0]);
+  cfg.nof_symbols        = static_cast<unsigned>(in_cfg["NumOFDMSymbols"][0]);
+
+  // Set the initial cyclic shift.
+  cfg.initial_cyclic_shift = static_cast<unsigned>(in_cfg["InitialCyclicShift"][0]);
+
+  // Set the scrambling identifier.
+  cfg.n_id = static_cast<unsigned>(in_cfg["NID"][0]);
+
+  // Set the lengths of UCI fields.
+  cfg.nof_harq_ack = static_cast<unsigned>(in_cfg["NumHARQAck"][0]);
+
+  // Set the SR opportunity.
+  cfg.sr_opportunity = (static_cast<unsigned>(in_cfg["NumSR"][0]) == 1);
+
+  return cfg;
+}
+
+/// Builds a PUCCH Format 1 processor configuration from a MATLAB structure (see pucch_processor_mex).
+inline srsran::pucch_processor::format1_configuration
+populate_pucch_f1_configuration(const matlab::data::Struct& in_cfg)
+{
+  // Create a PUCCH F1 configuration object.
+  srsran::pucch_processor::format1_configuration cfg = {};
+
+  cfg.context = std::nullopt;
+
+  // Set the slot point.
+  unsigned scs_kHz    = in_cfg["SubcarrierSpacing"][0];
+  unsigned slot_count = in_cfg["NSlot"][0];
+  cfg.slot            = {matlab_to_srs_subcarrier_spacing(scs_kHz), slot_count};
+
+  // Set the cyclic prefix.
+  const matlab::data::CharArray in_cp = in_cfg["CP"];
+  cfg.cp                              = matlab_to_srs_cyclic_prefix(in_cp.toAscii());
+
+  // Set the port indices.
+  unsigned nof_ports = in_cfg["NRxPorts"][0];
+  cfg.ports.clear();
+  for (unsigned i_port = 0; i_port != nof_ports; ++i_port) {
+    cfg.ports.push_back(i_port);
+  }
+
+  // Set the BWP.
+  cfg.bwp_size_rb  = static_cast<unsigned>(in_cfg["NSizeBWP"][0]);
+  cfg.bwp_start_rb = static_cast<unsigned>(in_cfg["NStartBWP"][0]);
+
+  // Set the frequency allocation.
+  cfg.starting_prb   = static_cast<unsigned>(in_cfg["StartPRB"][0]);
+  cfg.second_hop_prb = std::nullopt;
+  if (!in_cfg["SecondHopStartPRB"].isEmpty()) {
+    cfg.second_hop_prb = static_cast<unsigned>(in_cfg["SecondHopStartPRB"][0]);
+  }
+
+  // Set the time allocation.
+  cfg.start_symbol_index = static_cast<unsigned>(in_cfg["StartSymbolIndex"][0]);
+  cfg.nof_symbols        = static_cast<unsigned>(in_cfg["NumOFDMSymbols"][0]);
+
+  // Set the scrambling identifier.
+  cfg.n_id = static_cast<unsigned>(in_cfg["NID"][0]);
+
+  // Set the lengths of UCI fields.
+  cfg.nof_harq_ack = static_cast<unsigned>(in_cfg["NumHARQAck"][0]);
+
+  // Set the initial cyclic shift.
+  cfg.initial_cyclic_shift = static_cast<unsigned>(in_cfg["InitialCyclicShift"][0]);
+
+  // Set the time domain orthogonal cyclic code.
+  cfg.time_domain_occ = static_cast<unsigned>(in_cfg["OCCI"][0]);
+
+  return cfg;
+}
+
+/// Builds a PUCCH Format 2 processor configuration from a MATLAB structure (see pucch_processor_mex).
+inline srsran::pucch_processor::format2_configuration
+populate_pucch_f2_configuration(const matlab::data::Struct& in_cfg)
+{
+  // Create a PUCCH F2 configuration object.
+  srsran::pucch_processor::format2_configuration cfg = {};
+
+  cfg.context = std::nullopt;
+
+  // Set the slot point.
+  unsigned scs_kHz    = in_cfg["SubcarrierSpacing"][0];
+  unsigned slot_count = in_cfg["NSlot"][0];
+  cfg.slot            = {matlab_to_srs_subcarrier_spacing(scs_kHz), slot_count};
+
+  // Set the cyclic prefix.
+  const matlab::data::CharArray in_cp = in_cfg["CP"];
+  cfg.cp                              = matlab_to_srs_cyclic_prefix(in_cp.toAscii());
+
+  // Set the port indices.
+  unsigned nof_ports = in_cfg["NRxPorts"][0];
+  cfg.ports.clear();
+  for (unsigned i_port = 0; i_port != nof_ports; ++i_port) {
+    cfg.ports.push_back(i_port);
+  }
+
+  // Set the BWP.
+  cfg.bwp_size_rb  = static_cast<unsigned>(in_cfg["NSizeBWP"][0]);
+  cfg.bwp_start_rb = static_cast<unsigned>(in_cfg["NStartBWP"][0]);
+
+  // Set the frequency allocation.
+  cfg.starting_prb   = static_cast<unsigned>(in_cfg["StartPRB"][0]);
+  cfg.nof_prb        = static_cast<unsigned>(in_cfg["NumPRBs"][0]);
+  cfg.second_hop_prb = std::nullopt;
+  if (!in_cfg["SecondHopStartPRB"].isEmpty()) {
+    cfg.second_hop_prb = static_cast<unsigned>(in_cfg["SecondHopStartPRB"][0]);
+  }
+
+  // Set the time allocation.
+  cfg.start_symbol_index = static_cast<unsigned>(in_cfg["StartSymbolIndex"][0]);
+  cfg.nof_symbols        = static_cast<unsigned>(in_cfg["NumOFDMSymbols"][0]);
+
+  // Set the RNTI.
+  cfg.rnti = static_cast<unsigned>(in_cfg["RNTI"][0]);
+
+  // Set the scrambling identifier.
+  cfg.n_id = static_cast<unsigned>(in_cfg["NID"][0]);
+
+  // Set the DM-RS scrambling identifier.
+  cfg.n_id_0 = static_cast<unsigned>(in_cfg["NID0"][0]);
+
+  // Set the lengths of UCI fields.
+  cfg.nof_harq_ack  = static_cast<unsigned>(in_cfg["NumHARQAck"][0]);
+  cfg.nof_sr        = static_cast<unsigned>(in_cfg["NumSR"][0]);
+  cfg.nof_csi_part1 = static_cast<unsigned>(in_cfg["NumCSIPart1"][0]);
+  cfg.nof_csi_part2 = static_cast<unsigned>(in_cfg["NumCSIPart2"][0]);
+
+  return cfg;
+}
+
+/// Builds a PUCCH Format 3 processor configuration from a MATLAB structure (see pucch_processor_mex).
+inline srsran::pucch_processor::format3_configuration
+populate_pucch_f3_configuration(const matlab::data::Struct& in_cfg)
+{
+  // Create a PUCCH F3 configuration object.
+  srsran::pucch_processor::format3_configuration cfg = {};
+
+  cfg.context = std::nullopt;
+
+  // Set the slot point.
+  unsigned scs_kHz    = in_cfg["SubcarrierSpacing"][0];
+  unsigned slot_count = in_cfg["NSlot"][0];
+  cfg.slot            = {matlab_to_srs_subcarrier_spacing(scs_kHz), slot_count};
+
+  // Set the cyclic prefix.
+  const matlab::data::CharArray in_cp = in_cfg["CP"];
+  cfg.cp                              = matlab_to_srs_cyclic_prefix(in_cp.toAscii());
+
+  // Set the port indices.
+  unsigned nof_ports = in_cfg["NRxPorts"][0];
+  cfg.ports.clear();
+  for (unsigned i_port = 0; i_port != nof_ports; ++i_port) {
+    cfg.ports.push_back(i_port);
+  }
+
+  // Set the BWP.
+  cfg.bwp_size_rb  = static_cast<unsigned>(in_cfg["NSizeBWP"][0]);
+  cfg.bwp_start_rb = static_cast<unsigned>(in_cfg["NStartBWP"][0]);
+
+  // Set the frequency allocation.
+  cfg.starting_prb   = static_cast<unsigned>(in_cfg["StartPRB"][0]);
+  cfg.nof_prb        = static_cast<unsigned>(in_cfg["NumPRBs"][0]);
+  cfg.second_hop_prb = std::nullopt;
+  if (!in_cfg["SecondHopStartPRB"].isEmpty()) {
+    cfg.second_hop_prb = static_cast<unsigned>(in_cfg["SecondHopStartPRB"][0]);
+  }
+
+  // Set the time allocation.
+  cfg.start_symbol_index = static_cast<unsigned>(in_cfg["StartSymbolIndex"][0]);
+  cfg.nof_symbols        = static_cast<unsigned>(in_cfg["NumOFDMSymbols"][0]);
+
+  // Set the RNTI.
+  cfg.rnti = static_cast<unsigned>(in_cfg["RNTI"][0]);
+
+  // Set the hopping identifier.
+  cfg.n_id_hopping = static_cast<unsigned>(in_cfg["NIDHopping"][0]);
+
+  // Set the scrambling identifier.
+  cfg.n_id_scrambling = static_cast<unsigned>(in_cfg["NIDScrambling"][0]);
+
+  cfg.additional_dmrs = static_cast<bool>(in_cfg["AdditionalDMRS"][0]);
+  cfg.pi2_bpsk        = static_cast<bool>(in_cfg["Pi2BPSK"][0]);
+
+  // Set the lengths of UCI fields.
+  cfg.nof_harq_ack  = static_cast<unsigned>(in_cfg["NumHARQAck"][0]);
+  cfg.nof_sr        = static_cast<unsigned>(in_cfg["NumSR"][0]);
+  cfg.nof_csi_part1 = static_cast<unsigned>(in_cfg["NumCSIPart1"][0]);
+  cfg.nof_csi_part2 = static_cast<unsigned>(in_cfg["NumCSIPart2"][0]);
+
+  return cfg;
+}
+
+/// Builds a PUCCH Format 4 processor configuration from a MATLAB structure (see pucch_processor_mex).
+inline srsran::pucch_processor::format4_configuration
+populate_pucch_f4_configuration(const matlab::data::Struct& in_cfg)
+{
+  // Create a PUCCH F4 configuration object.
+  srsran::pucch_processor::format4_configuration cfg = {};
+
+  cfg.context = std::nullopt;
+
+  // Set the slot point.
+  unsigned scs_kHz    = in_cfg["SubcarrierSpacing"][0];
+  unsigned slot_count = in_cfg["NSlot"][0];
+  cfg.slot            = {matlab_to_srs_subcarrier_spacing(scs_kHz), slot_count};
+
+  // Set the cyclic prefix.
+  const matlab::data::CharArray in_cp = in_cfg["CP"];
+  cfg.cp                              = matlab_to_srs_cyclic_prefix(in_cp.toAscii());
+
+  // Set the port indices.
+  unsigned nof_ports = in_cfg["NRxPorts"][0];
+  cfg.ports.clear();
+  for (unsigned i_port = 0; i_port != nof_ports; ++i_port) {
+    cfg.ports.push_back(i_port);
+  }
+
+  // Set the BWP.
+  cfg.bwp_size_rb  = static_cast<unsigned>(in_cfg["NSizeBWP"][0]);
+  cfg.bwp_start_rb = static_cast<unsigned>(in_cfg["NStartBWP"][0]);
+
+  // Set the frequency allocation.
+  cfg.starting_prb   = static_cast<unsigned>(in_cfg["StartPRB"][0]);
+  cfg.second_hop_prb = std::nullopt;
+  if (!in_cfg["SecondHopStartPRB"].isEmpty()) {
+    cfg.second_hop_prb = static_cast<unsigned>(in_cfg["SecondHopStartPRB"][0]);
+  }
+
+  // Set the time allocation.
+  cfg.start_symbol_index = static_cast<unsigned>(in_cfg["StartSymbolIndex"][0]);
+  cfg.nof_symbols        = static_cast<unsigned>(in_cfg["NumOFDMSymbols"][0]);
+
+  // Set the RNTI.
+  cfg.rnti = static_cast<unsigned>(in_cfg["RNTI"][0]);
+
+  // Set the hopping identifier.
+  cfg.n_id_hopping = static_cast<unsigned>(in_cfg["NIDHopping"][0]);
+
+  // Set the scrambling identifier.
+  cfg.n_id_scrambling = static_cast<unsigned>(in_cfg["NIDScrambling"][0]);
+
+  cfg.additional_dmrs = static_cast<bool>(in_cfg["AdditionalDMRS"][0]);
+  cfg.pi2_bpsk        = static_cast<bool>(in_cfg["Pi2BPSK"][0]);
+
+  cfg.occ_index  = static_cast<unsigned>(in_cfg["OCCI"][0]);
+  cfg.occ_length = static_cast<unsigned>(in_cfg["SpreadingFactor"][0]);
+
+  // Set the lengths of UCI fields.
+  cfg.nof_harq_ack  = static_cast<unsigned>(in_cfg["NumHARQAck"][0]);
+  cfg.nof_sr        = static_cast<unsigned>(in_cfg["NumSR"][0]);
+  cfg.nof_csi_part1 = static_cast<unsigned>(in_cfg["NumCSIPart1"][0]);
+  cfg.nof_csi_part2 = static_cast<unsigned>(in_cfg["NumCSIPart2"][0]);
+
+  return cfg;
+}
+
+} // namespace srsran_matlab
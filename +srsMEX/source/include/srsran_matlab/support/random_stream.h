@@ -0,0 +1,180 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Counter-based random streams for reproducible parallel simulations.
+
+#pragma once
+
+#include "srsran/support/srsran_assert.h"
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace srsran_matlab {
+
+/// Purposes of the random processes of a simulation.
+enum class random_purpose : uint8_t { generic = 0, transport_block, payload, fading, noise };
+
+/// \brief Identifier of a random stream.
+///
+/// Streams with different identifiers are statistically independent. Since the identifier is mapped one-to-one onto
+/// the counter of the generator, no two identifiers can ever produce overlapping sequences.
+struct random_stream_id {
+  /// Maximum item index (exclusive).
+  static constexpr uint64_t MAX_ITEM = uint64_t(1) << 48U;
+  /// Maximum SNR index (exclusive).
+  static constexpr unsigned MAX_SNR_INDEX = 1U << 16U;
+  /// Maximum slot index (exclusive).
+  static constexpr unsigned MAX_SLOT = 1U << 16U;
+  /// Maximum substream index (exclusive).
+  static constexpr unsigned MAX_SUBSTREAM = 1U << 8U;
+
+  /// Simulation seed.
+  uint64_t seed = 0;
+  /// Index of the simulated SNR value.
+  unsigned snr_index = 0;
+  /// \brief Index of the simulated item (e.g., frame or PRACH occasion).
+  ///
+  /// Items, not workers, identify the streams: the same item gets the same random numbers whichever worker simulates
+  /// it.
+  uint64_t item = 0;
+  /// \brief Slot index within the item.
+  ///
+  /// Processes drawn anew at every slot (e.g., slot-independent fading) use the index of the slot, counted from zero.
+  /// Processes that span the whole item (e.g., continuous fading) use slot zero.
+  unsigned slot = 0;
+  /// Purpose of the random process.
+  random_purpose purpose = random_purpose::generic;
+  /// Substream index (e.g., the antenna port of a noise generator).
+  unsigned substream = 0;
+};
+
+/// \brief Counter-based random stream.
+///
+/// The stream is the output of the Philox4x32-10 block function of J. K. Salmon et al., "Parallel random numbers: As
+/// easy as 1, 2, 3," SC'11, applied to a counter whose upper 96 bits encode the stream identifier and whose lower 32
+/// bits are the position of the block within the stream. The seed is the key of the block function. A stream is
+/// therefore a pure function of its identifier: it can be created on any thread, at any time and in any order without
+/// sharing a state, which makes parallel simulations bit-exact regardless of the number of threads. Each stream
+/// provides up to 2<sup>32</sup> - 1 blocks of two 64-bit words: the last value of the block position is not used.
+///
+/// The class satisfies the requirements of a uniform random bit generator and can be used with the distributions of
+/// the standard library.
+class random_stream
+{
+public:
+  /// Type of the generated words.
+  using result_type = uint64_t;
+
+  /// Minimum generated word.
+  static constexpr result_type min() { return 0; }
+  /// Maximum generated word.
+  static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+  /// Creates the stream with the given identifier.
+  explicit random_stream(const random_stream_id& id = {}) { reset(id); }
+
+  /// Restarts the stream with the given identifier.
+  void reset(const random_stream_id& id)
+  {
+    srsran_assert(id.snr_index < random_stream_id::MAX_SNR_INDEX, "SNR index {} out of range.", id.snr_index);
+    srsran_assert(id.item < random_stream_id::MAX_ITEM, "Item index {} out of range.", id.item);
+    srsran_assert(id.slot < random_stream_id::MAX_SLOT, "Slot index {} out of range.", id.slot);
+    srsran_assert(id.substream < random_stream_id::MAX_SUBSTREAM, "Substream index {} out of range.", id.substream);
+
+    key     = {static_cast<uint32_t>(id.seed), static_cast<uint32_t>(id.seed >> 32U)};
+    counter = {0,
+               static_cast<uint32_t>(id.item),
+               static_cast<uint32_t>(id.item >> 32U) | (id.snr_index << 16U),
+               id.slot | (static_cast<uint32_t>(id.purpose) << 16U) | (id.substream << 24U)};
+    i_word  = BLOCK_WORDS;
+  }
+
+  /// Returns the next 64-bit word of the stream.
+  result_type operator()()
+  {
+    if (i_word == BLOCK_WORDS) {
+      next_block();
+    }
+    uint64_t word = (static_cast<uint64_t>(block[i_word]) << 32U) | block[i_word + 1];
+    i_word += 2;
+    return word;
+  }
+
+  /// Returns the next word of the stream converted to a uniform random number in [0, 1), with 53 bits of precision.
+  double uniform() { return static_cast<double>((*this)() >> 11U) * 0x1.0p-53; }
+
+  /// Number of 32-bit words of a block.
+  static constexpr unsigned BLOCK_WORDS = 4;
+
+  /// \brief Philox4x32-10 block function.
+  ///
+  /// \param[in] counter  Counter, least significant word first.
+  /// \param[in] key      Key, least significant word first.
+  /// \return The block of the counter, in the word order of the Random123 known-answer tests.
+  static std::array<uint32_t, BLOCK_WORDS> compute_block(const std::array<uint32_t, BLOCK_WORDS>& counter,
+                                                        const std::array<uint32_t, 2>&           key)
+  {
+    std::array<uint32_t, 2>           round_key = key;
+    std::array<uint32_t, BLOCK_WORDS> block     = counter;
+    for (unsigned i_round = 0; i_round != NOF_ROUNDS; ++i_round) {
+      uint64_t prod0 = static_cast<uint64_t>(MULTIPLIER_0) * block[0];
+      uint64_t prod1 = static_cast<uint64_t>(MULTIPLIER_1) * block[2];
+      block          = {static_cast<uint32_t>(prod1 >> 32U) ^ block[1] ^ round_key[0],
+                        static_cast<uint32_t>(prod1),
+                        static_cast<uint32_t>(prod0 >> 32U) ^ block[3] ^ round_key[1],
+                        static_cast<uint32_t>(prod0)};
+      round_key[0] += WEYL_0;
+      round_key[1] += WEYL_1;
+    }
+    return block;
+  }
+
+private:
+  /// Computes the block of the current counter and moves the counter forward.
+  void next_block()
+  {
+    srsran_assert(counter[0] != std::numeric_limits<uint32_t>::max(), "Random stream exhausted.");
+
+    block = compute_block(counter, key);
+    ++counter[0];
+    i_word = 0;
+  }
+
+  /// Number of rounds of the block function.
+  static constexpr unsigned NOF_ROUNDS = 10;
+  /// Philox multipliers.
+  static constexpr uint32_t MULTIPLIER_0 = 0xd2511f53;
+  static constexpr uint32_t MULTIPLIER_1 = 0xcd9e8d57;
+  /// Philox key increments (Weyl sequence).
+  static constexpr uint32_t WEYL_0 = 0x9e3779b9;
+  static constexpr uint32_t WEYL_1 = 0xbb67ae85;
+
+  /// Key of the block function.
+  std::array<uint32_t, 2> key;
+  /// Counter of the next block.
+  std::array<uint32_t, 4> counter;
+  /// Current block.
+  std::array<uint32_t, BLOCK_WORDS> block;
+  /// Index of the next unused word of the current block.
+  unsigned i_word;
+};
+
+} // namespace srsran_matlab
@@ -24,6 +24,7 @@
 
 #include "srsran/adt/complex.h"
 #include "srsran/phy/support/resource_grid.h"
+#include "srsran/phy/support/resource_grid_reader.h"
 #include "MatlabDataArray/TypedArray.hpp"
 
 namespace srsran_matlab {
@@ -35,4 +36,13 @@ namespace srsran_matlab {
 /// \return A unique pointer to the newly created resource grid object.
 std::unique_ptr<srsran::resource_grid> read_resource_grid(const matlab::data::TypedArray<srsran::cf_t>& in_grid);
 
+/// \brief Copies the content of a resource grid into a MATLAB multidimensional array.
+///
+/// The number of subcarriers, OFDM symbols and antenna ports to copy is determined by the dimensions of \c out_grid,
+/// which must not exceed those of \c in_grid.
+///
+/// \param[out] out_grid  The destination multidimensional (2D or 3D) array of complex floats.
+/// \param[in]  in_grid   Read-only interface to the source resource grid.
+void write_resource_grid(matlab::data::TypedArray<srsran::cf_t>& out_grid, const srsran::resource_grid_reader& in_grid);
+
 } // namespace srsran_matlab
@@ -0,0 +1,129 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Helpers shared by the MEX functions that demultiplex UL-SCH data and UCI from a PUSCH codeword.
+
+#pragma once
+
+#include "srsran_matlab/support/matlab_to_srs.h"
+#include "srsran/phy/upper/channel_processors/pusch/pusch_decoder_buffer.h"
+#include "srsran/phy/upper/channel_processors/pusch/ulsch_demultiplex.h"
+#include "srsran/phy/upper/log_likelihood_ratio.h"
+#include "srsran/srsvec/copy.h"
+#include <MatlabDataArray.hpp>
+
+namespace srsran_matlab {
+
+/// PUSCH decoder buffer that collects the soft bits of a UL-SCH or UCI field into a fixed-size array.
+class llr_array_decoder_buffer : public srsran::pusch_decoder_buffer
+{
+public:
+  /// Creates a buffer that writes into \c data_, which must have the exact number of expected soft bits.
+  explicit llr_array_decoder_buffer(srsran::span<srsran::log_likelihood_ratio> data_) : data(data_) {}
+
+  /// \brief Returns \c true if all expected soft bits were written.
+  ///
+  /// Nonempty fields also require the demultiplexer to have signaled their end.
+  bool is_complete() const { return (count == data.size()) && (completed || data.empty()); }
+
+  // See interface for documentation.
+  srsran::span<srsran::log_likelihood_ratio> get_next_block_view(unsigned block_size) override
+  {
+    block_size = std::min(block_size, static_cast<unsigned>(data.size() - count));
+    return data.subspan(count, block_size);
+  }
+
+  // See interface for documentation.
+  void on_new_softbits(srsran::span<const srsran::log_likelihood_ratio> softbits) override
+  {
+    srsran_assert(count + softbits.size() <= data.size(),
+                  "The number of soft bits, i.e., {}, exceeds the buffer size, i.e., {}.",
+                  count + softbits.size(),
+                  data.size());
+    srsran::span<srsran::log_likelihood_ratio> block = data.subspan(count, softbits.size());
+    if (block.data() != softbits.data()) {
+      srsran::srsvec::copy(block, softbits);
+    }
+    count += softbits.size();
+  }
+
+  // See interface for documentation.
+  void on_end_softbits() override { completed = true; }
+
+private:
+  /// Destination of the soft bits.
+  srsran::span<srsran::log_likelihood_ratio> data;
+  /// Number of soft bits written so far.
+  unsigned count = 0;
+  /// Set to \c true when the demultiplexer signals the end of the field.
+  bool completed = false;
+};
+
+/// UL-SCH demultiplexer configuration, completed with the CSI Part 2 and UL-SCH data sizes.
+struct ulsch_demultiplex_mex_config {
+  /// Configuration of the srsRAN UL-SCH demultiplexer.
+  srsran::ulsch_demultiplex::configuration config;
+  /// Number of UL-SCH data soft bits.
+  unsigned nof_enc_ulsch_bits;
+  /// Number of CSI Part 2 information bits.
+  unsigned nof_csi_part2_bits;
+  /// Number of CSI Part 2 soft bits.
+  unsigned nof_enc_csi_part2_bits;
+};
+
+/// \brief Reads the UL-SCH demultiplexer configuration from a MATLAB structure.
+///
+/// The structure is the one created by the MATLAB static method
+/// <tt>srsMEX.phy.srsULSCHDemultiplex.createConfiguration</tt>, with fields \c Modulation, \c NumLayers, \c NumPRB,
+/// \c StartSymbolIndex, \c NumSymbols, \c NumHARQAckReserved, \c DMRSConfigType, \c DMRSSymbPos,
+/// \c NumCDMGroupsWithoutData, \c NumHARQAck, \c NumEncHARQAck, \c NumCSIPart1, \c NumEncCSIPart1, \c NumCSIPart2,
+/// \c NumEncCSIPart2 and \c NumEncULSCH.
+inline ulsch_demultiplex_mex_config read_ulsch_demultiplex_config(const matlab::data::Struct& in_cfg)
+{
+  using namespace matlab::data;
+
+  ulsch_demultiplex_mex_config out;
+
+  const CharArray in_modulation = in_cfg["Modulation"];
+  out.config.modulation         = matlab_to_srs_modulation(in_modulation.toAscii());
+  out.config.nof_layers         = in_cfg["NumLayers"][0];
+  out.config.nof_prb            = in_cfg["NumPRB"][0];
+  out.config.start_symbol_index = in_cfg["StartSymbolIndex"][0];
+  out.config.nof_symbols        = in_cfg["NumSymbols"][0];
+  out.config.nof_harq_ack_rvd   = in_cfg["NumHARQAckReserved"][0];
+  out.config.dmrs               = matlab_to_srs_dmrs_type(in_cfg["DMRSConfigType"][0]);
+
+  const TypedArray<bool> in_dmrs_pos = in_cfg["DMRSSymbPos"];
+  out.config.dmrs_symbol_mask =
+      srsran::bounded_bitset<srsran::MAX_NSYMB_PER_SLOT>(in_dmrs_pos.begin(), in_dmrs_pos.end());
+
+  out.config.nof_cdm_groups_without_data = in_cfg["NumCDMGroupsWithoutData"][0];
+  out.config.nof_harq_ack_bits           = in_cfg["NumHARQAck"][0];
+  out.config.nof_enc_harq_ack_bits       = in_cfg["NumEncHARQAck"][0];
+  out.config.nof_csi_part1_bits          = in_cfg["NumCSIPart1"][0];
+  out.config.nof_enc_csi_part1_bits      = in_cfg["NumEncCSIPart1"][0];
+  out.nof_csi_part2_bits                 = in_cfg["NumCSIPart2"][0];
+  out.nof_enc_csi_part2_bits             = in_cfg["NumEncCSIPart2"][0];
+  out.nof_enc_ulsch_bits                 = in_cfg["NumEncULSCH"][0];
+
+  return out;
+}
+
+} // namespace srsran_matlab
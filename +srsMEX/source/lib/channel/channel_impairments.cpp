@@ -0,0 +1,197 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Channel impairments (timing offset, carrier frequency offset and AWGN) definition.
+
+#include "srsran_matlab/channel/channel_impairments.h"
+#include "srsran/support/srsran_assert.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace srsran;
+using namespace srsran_matlab;
+
+void gaussian_noise_generator::add_noise(span<cf_t> buffer, float noise_var)
+{
+  constexpr float scale_24bit = 1.0F / (1U << 24U);
+  constexpr float two_pi      = 2.0F * static_cast<float>(M_PI);
+
+  while (!buffer.empty()) {
+    unsigned block_size = std::min(static_cast<unsigned>(buffer.size()), BLOCK_SIZE);
+    std::generate_n(words.begin(), block_size, [this]() { return engine(); });
+
+    // Box-Muller transform: the upper 24 bits of each word give the amplitude, the next 24 bits give the phase. The
+    // squared amplitude is exponentially distributed with mean noise_var.
+    for (unsigned i_sample = 0; i_sample != block_size; ++i_sample) {
+      uint64_t word      = words[i_sample];
+      float    u_modulus = (static_cast<float>(word >> 40U) + 0.5F) * scale_24bit;
+      float    u_phase   = static_cast<float>((word >> 16U) & 0xffffffU) * scale_24bit;
+      float    amplitude = std::sqrt(-noise_var * std::log(u_modulus));
+      float    phase     = two_pi * u_phase;
+      buffer[i_sample] += cf_t(amplitude * std::cos(phase), amplitude * std::sin(phase));
+    }
+    buffer = buffer.subspan(block_size);
+  }
+}
+
+channel_impairments::channel_impairments(const channel_impairments_config& config_) : config(config_)
+{
+  srsran_assert(config.nof_ports > 0, "The number of ports must be positive.");
+  srsran_assert(config.sampling_rate > 0, "The sampling rate must be positive.");
+  srsran_assert(config.timing_offset >= 0, "The timing offset cannot be negative.");
+
+  double delay = config.timing_offset;
+  if (std::abs(delay - std::round(delay)) < 1e-6) {
+    // Integer delays need a single tap.
+    delay_offset = static_cast<unsigned>(std::round(delay));
+    delay_taps   = {1.0F};
+  } else {
+    // Windowed sinc centered at the delay, truncated to the causal part.
+    int first    = std::max(0, static_cast<int>(std::ceil(delay - FILTER_HALF_LENGTH)));
+    int last     = static_cast<int>(std::floor(delay + FILTER_HALF_LENGTH));
+    delay_offset = first;
+    delay_taps.resize(last - first + 1);
+    double sum = 0;
+    for (int n = first; n <= last; ++n) {
+      double x      = n - delay;
+      double sinc   = std::sin(M_PI * x) / (M_PI * x);
+      double window = 0.5 * (1 + std::cos(M_PI * x / FILTER_HALF_LENGTH));
+      double tap    = sinc * window;
+      sum += tap;
+      delay_taps[n - first] = static_cast<float>(tap);
+    }
+    // Unit DC gain.
+    std::transform(delay_taps.begin(), delay_taps.end(), delay_taps.begin(), [sum](float tap) {
+      return static_cast<float>(tap / sum);
+    });
+  }
+
+  srsran_assert(config.nof_ports <= random_stream_id::MAX_SUBSTREAM,
+                "The number of ports, i.e., {}, exceeds the maximum, i.e., {}.",
+                config.nof_ports,
+                random_stream_id::MAX_SUBSTREAM);
+
+  delay_lines.resize(config.nof_ports);
+  noise_generators.resize(config.nof_ports);
+  reset(config.seed);
+}
+
+void channel_impairments::reset(uint64_t seed)
+{
+  random_stream_id id;
+  id.seed    = seed;
+  id.purpose = random_purpose::noise;
+  reset(id);
+}
+
+void channel_impairments::reset(const random_stream_id& id)
+{
+  config.seed            = id.seed;
+  noise_stream           = id;
+  noise_stream.substream = 0;
+  reset();
+}
+
+void channel_impairments::reset()
+{
+  sample_index = 0;
+  for (std::vector<cf_t>& line : delay_lines) {
+    line.assign(delay_offset + delay_taps.size() - 1, 0);
+  }
+  for (unsigned i_port = 0; i_port != config.nof_ports; ++i_port) {
+    random_stream_id port_stream = noise_stream;
+    port_stream.substream        = i_port;
+    noise_generators[i_port].reset(port_stream);
+  }
+}
+
+void channel_impairments::run(span<cf_t> buffer, unsigned i_port, float noise_var)
+{
+  srsran_assert(i_port < config.nof_ports,
+                "The port index, i.e., {}, exceeds the number of ports, i.e., {}.",
+                i_port,
+                config.nof_ports);
+  srsran_assert(noise_var >= 0, "The noise variance cannot be negative.");
+
+  if (buffer.empty()) {
+    return;
+  }
+
+  apply_delay(buffer, i_port);
+
+  if (config.cfo != 0) {
+    apply_cfo(buffer);
+  }
+
+  if (noise_var > 0) {
+    noise_generators[i_port].add_noise(buffer, noise_var);
+  }
+}
+
+void channel_impairments::apply_delay(span<cf_t> buffer, unsigned i_port)
+{
+  std::vector<cf_t>& line          = delay_lines[i_port];
+  std::size_t        memory_length = line.size();
+  if (memory_length == 0) {
+    return;
+  }
+
+  std::size_t nof_samples = buffer.size();
+  line.resize(memory_length + nof_samples);
+  std::copy(buffer.begin(), buffer.end(), line.begin() + memory_length);
+
+  if (delay_taps.size() == 1) {
+    std::copy_n(line.begin(), nof_samples, buffer.begin());
+  } else {
+    std::fill(buffer.begin(), buffer.end(), 0);
+    for (unsigned i_tap = 0, nof_taps = delay_taps.size(); i_tap != nof_taps; ++i_tap) {
+      float       tap = delay_taps[i_tap];
+      const cf_t* in  = line.data() + memory_length - delay_offset - i_tap;
+      for (std::size_t i_sample = 0; i_sample != nof_samples; ++i_sample) {
+        buffer[i_sample] += tap * in[i_sample];
+      }
+    }
+  }
+
+  // Keep the last samples as delay line memory.
+  std::copy(line.end() - memory_length, line.end(), line.begin());
+  line.resize(memory_length);
+}
+
+void channel_impairments::apply_cfo(span<cf_t> buffer) const
+{
+  // The phasor is computed exactly at the beginning of each chunk and updated recursively inside the chunk, which
+  // keeps the phase error negligible for arbitrarily long waveforms.
+  constexpr unsigned chunk_size = 256;
+
+  double                     normalized_cfo = config.cfo / config.sampling_rate;
+  const std::complex<double> step           = std::polar(1.0, 2 * M_PI * normalized_cfo);
+
+  for (std::size_t i_chunk = 0, nof_samples = buffer.size(); i_chunk < nof_samples; i_chunk += chunk_size) {
+    // Keep only the fractional part of the number of cycles to preserve precision.
+    double               cycles = normalized_cfo * static_cast<double>(sample_index + i_chunk);
+    std::complex<double> phasor = std::polar(1.0, 2 * M_PI * (cycles - std::floor(cycles)));
+    for (std::size_t i_sample = i_chunk, i_end = std::min(i_chunk + chunk_size, nof_samples); i_sample != i_end;
+         ++i_sample) {
+      buffer[i_sample] *= cf_t(static_cast<float>(phasor.real()), static_cast<float>(phasor.imag()));
+      phasor *= step;
+    }
+  }
+}
@@ -0,0 +1,193 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Channel impairments MEX definition.
+
+#include "channel_impairments_mex.h"
+#include "srsran_matlab/support/parallel_for.h"
+#include "srsran_matlab/support/to_span.h"
+#include <MatlabDataArray/ArrayDimensions.hpp>
+#include <memory>
+
+using matlab::mex::ArgumentList;
+using namespace matlab::data;
+using namespace srsran;
+using namespace srsran_matlab;
+
+MexFunction::impairments_memento& MexFunction::get_impairments(ArgumentList inputs)
+{
+  if ((inputs[1].getType() != ArrayType::UINT64) || (inputs[1].getNumberOfElements() != 1)) {
+    mex_abort("Input 'impairmentsID' should be a scalar uint64_t.");
+  }
+
+  uint64_t                             key = static_cast<TypedArray<uint64_t>>(inputs[1])[0];
+  std::shared_ptr<impairments_memento> mem = storage.get_memento(key);
+  if (!mem) {
+    mex_abort("Cannot retrieve the channel impairments with key {}.", key);
+  }
+  return *mem;
+}
+
+void MexFunction::method_new(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 2;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::STRUCT) || (inputs[1].getNumberOfElements() != 1)) {
+    mex_abort("Input 'impairmentsConfig' should be a scalar structure.");
+  }
+
+  if (outputs.size() != 1) {
+    mex_abort("Wrong number of outputs: expected 1, provided {}.", outputs.size());
+  }
+
+  const StructArray          in_struct_array = inputs[1];
+  const Struct               in_cfg          = in_struct_array[0];
+  channel_impairments_config config;
+  config.nof_ports     = static_cast<unsigned>(in_cfg["NumPorts"][0]);
+  config.sampling_rate = in_cfg["SampleRate"][0];
+  config.cfo           = in_cfg["CarrierFrequencyOffset"][0];
+  config.timing_offset = in_cfg["TimingOffset"][0];
+  config.seed          = static_cast<uint64_t>(in_cfg["Seed"][0]);
+
+  unsigned nof_workers = static_cast<unsigned>(in_cfg["NumThreads"][0]);
+  if (nof_workers == 0) {
+    nof_workers = default_nof_workers();
+  }
+
+  if (config.nof_ports == 0) {
+    mex_abort("The number of ports must be positive.");
+  }
+  if (config.sampling_rate <= 0) {
+    mex_abort("The sampling rate must be positive.");
+  }
+  if (config.timing_offset < 0) {
+    mex_abort("The timing offset cannot be negative.");
+  }
+
+  std::shared_ptr<impairments_memento> mem =
+      std::make_shared<impairments_memento>(impairments_memento{channel_impairments(config), nof_workers});
+  if (!mem) {
+    mex_abort("Cannot create channel impairments.");
+  }
+  uint64_t key = storage.store(mem);
+  outputs[0]   = factory.createScalar(key);
+}
+
+void MexFunction::method_step(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 4;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if (outputs.size() != 1) {
+    mex_abort("Wrong number of outputs: expected 1, provided {}.", outputs.size());
+  }
+
+  impairments_memento& mem       = get_impairments(inputs);
+  unsigned             nof_ports = mem.impairments.get_config().nof_ports;
+
+  ArrayDimensions in_dims = inputs[2].getDimensions();
+  if ((inputs[2].getType() != ArrayType::COMPLEX_SINGLE) || (in_dims.size() != 2) || (in_dims[1] != nof_ports)) {
+    mex_abort("Input 'waveform' should be a two-dimensional array of complex floats with {} columns, provided [{}].",
+              nof_ports,
+              in_dims);
+  }
+  std::size_t nof_samples = in_dims[0];
+
+  if ((inputs[3].getType() != ArrayType::DOUBLE) ||
+      ((inputs[3].getNumberOfElements() != 1) && (inputs[3].getNumberOfElements() != nof_ports))) {
+    mex_abort("Input 'noiseVar' should be a scalar or an array of {} doubles.", nof_ports);
+  }
+  const TypedArray<double> in_noise_var = inputs[3];
+  std::vector<float>       noise_vars(nof_ports);
+  for (unsigned i_port = 0; i_port != nof_ports; ++i_port) {
+    noise_vars[i_port] = static_cast<float>(in_noise_var[(in_noise_var.getNumberOfElements() == 1) ? 0 : i_port]);
+    if (noise_vars[i_port] < 0) {
+      mex_abort("The noise variance cannot be negative.");
+    }
+  }
+
+  // The impairments are applied in place on a copy of the input.
+  const TypedArray<cf_t> in_waveform  = inputs[2];
+  TypedArray<cf_t>       out_waveform = factory.createArray<cf_t>({nof_samples, static_cast<std::size_t>(nof_ports)});
+  if (nof_samples == 0) {
+    outputs[0] = out_waveform;
+    return;
+  }
+  span<cf_t>             out_view     = to_span(out_waveform);
+  span<const cf_t>       in_view      = to_span(in_waveform);
+  std::copy(in_view.begin(), in_view.end(), out_view.begin());
+
+  // Each port has its own noise generator and delay line: ports can be processed concurrently.
+  channel_impairments& impairments = mem.impairments;
+  parallel_for(nof_ports, mem.nof_workers, [&](unsigned i_port, unsigned /* i_worker */) {
+    impairments.run(out_view.subspan(i_port * nof_samples, nof_samples), i_port, noise_vars[i_port]);
+  });
+  impairments.advance(nof_samples);
+
+  outputs[0] = out_waveform;
+}
+
+void MexFunction::method_reset(ArgumentList outputs, ArgumentList inputs)
+{
+  if ((inputs.size() != 2) && (inputs.size() != 3)) {
+    mex_abort("Wrong number of inputs: expected 2 or 3, provided {}.", inputs.size());
+  }
+
+  if (!outputs.empty()) {
+    mex_abort("Wrong number of outputs: expected 0, provided {}.", outputs.size());
+  }
+
+  channel_impairments& impairments = get_impairments(inputs).impairments;
+
+  if (inputs.size() == 2) {
+    impairments.reset();
+    return;
+  }
+
+  if ((inputs[2].getType() != ArrayType::DOUBLE) || (inputs[2].getNumberOfElements() != 1)) {
+    mex_abort("Input 'seed' should be a scalar double.");
+  }
+  impairments.reset(static_cast<uint64_t>(static_cast<TypedArray<double>>(inputs[2])[0]));
+}
+
+void MexFunction::method_release(ArgumentList outputs, ArgumentList inputs)
+{
+  if (inputs.size() != 2) {
+    mex_abort("Wrong number of inputs: expected 2, provided {}.", inputs.size());
+  }
+
+  if (!outputs.empty()) {
+    mex_abort("Wrong number of outputs: expected 0, provided {}.", outputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::UINT64) || (inputs[1].getNumberOfElements() != 1)) {
+    mex_abort("Input 'impairmentsID' should be a scalar uint64_t.");
+  }
+
+  uint64_t key = static_cast<TypedArray<uint64_t>>(inputs[1])[0];
+  if (storage.release_memento(key) == 0) {
+    mex_abort("There was no channel impairments with key {}.", key);
+  }
+}
@@ -0,0 +1,101 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Channel impairments MEX declaration.
+
+#pragma once
+
+#include "srsran_matlab/channel/channel_impairments.h"
+#include "srsran_matlab/srsran_mex_dispatcher.h"
+#include "srsran_matlab/support/memento.h"
+
+/// \brief Applies timing offset, carrier frequency offset and AWGN following the srsran_mex_dispatcher template.
+///
+/// Since MATLAB instantiates a single MexFunction object, each impairment stage (with its own configuration, time and
+/// noise generators) is stored as a memento and identified by a key. The ports of a waveform are processed in
+/// parallel, each one with its own noise generator, so that the result does not depend on the number of threads.
+class MexFunction : public srsran_mex_dispatcher
+{
+public:
+  /// Constructor: stores the string identifier&ndash;method pairs that form the public interface of the MEX object.
+  MexFunction()
+  {
+    create_callback("new", [this](ArgumentList out, ArgumentList in) { this->method_new(out, in); });
+    create_callback("step", [this](ArgumentList out, ArgumentList in) { this->method_step(out, in); });
+    create_callback("reset", [this](ArgumentList out, ArgumentList in) { this->method_reset(out, in); });
+    create_callback("release", [this](ArgumentList out, ArgumentList in) { this->method_release(out, in); });
+  }
+
+private:
+  /// Impairment stage and number of worker threads used to process it.
+  struct impairments_memento {
+    /// Impairment stage.
+    srsran_matlab::channel_impairments impairments;
+    /// Number of worker threads.
+    unsigned nof_workers;
+  };
+
+  /// Retrieves the impairment stage identified by the second input, aborting if it does not exist.
+  impairments_memento& get_impairments(ArgumentList inputs);
+
+  /// \brief Creates a new impairment stage.
+  ///
+  /// The method accepts two inputs.
+  ///   - The string <tt>"new"</tt>.
+  ///   - A one-dimensional structure with fields
+  ///      - \c NumPorts, the number of antenna ports;
+  ///      - \c SampleRate, the sampling rate in hertz;
+  ///      - \c CarrierFrequencyOffset, the carrier frequency offset in hertz;
+  ///      - \c TimingOffset, the (possibly fractional) timing offset in samples;
+  ///      - \c Seed, the seed of the noise generators;
+  ///      - \c NumThreads, the number of worker threads (zero for as many as hardware threads).
+  ///
+  /// The only output of the method is the identifier of the created impairment stage (a \c uint64_t number).
+  void method_new(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Applies the impairments to a block of samples.
+  ///
+  /// The method takes four inputs.
+  ///   - The string <tt>"step"</tt>.
+  ///   - The impairment stage identifier (a \c uint64_t number).
+  ///   - A two-dimensional array of complex single-precision floats with the samples, one column for each port.
+  ///   - The noise variance, either a scalar or a row with one value for each port (double).
+  ///
+  /// The only output is a two-dimensional array of complex single-precision floats with the impaired samples.
+  void method_step(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Resets an impairment stage.
+  ///
+  /// The method takes two or three inputs.
+  ///   - The string <tt>"reset"</tt>.
+  ///   - The impairment stage identifier (a \c uint64_t number).
+  ///   - Optionally, a new seed for the noise generators (a scalar double).
+  ///
+  /// The method has no outputs.
+  void method_reset(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Releases an impairment stage.
+  ///
+  /// The method takes, as input, the impairment stage identifier (a \c uint64_t number). It has no outputs.
+  void method_release(ArgumentList outputs, ArgumentList inputs);
+
+  /// A container for the impairment stages.
+  memento_storage<impairments_memento> storage;
+};
@@ -0,0 +1,471 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Tapped delay line (TDL) fading channel definition.
+
+#include "srsran_matlab/channel/fading_channel.h"
+#include "srsran/support/srsran_assert.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace srsran;
+using namespace srsran_matlab;
+
+namespace {
+
+/// Tap of a standard delay profile.
+struct tdl_tap {
+  /// Delay, either normalized by the delay spread or in nanoseconds.
+  double delay;
+  /// Average power in decibel.
+  double power_dB;
+};
+
+// clang-format off
+/// TDL-A delay profile, TR38.901 Table 7.7.2-1 (normalized delays).
+constexpr tdl_tap tdl_a[] = {
+    {0.0000, -13.4}, {0.3819, 0.0}, {0.4025, -2.2}, {0.5868, -4.0}, {0.4610, -6.0}, {0.5375, -8.2},
+    {0.6708, -9.9}, {0.5750, -10.5}, {0.7618, -7.5}, {1.5375, -15.9}, {1.8978, -6.6}, {2.2242, -16.7},
+    {2.1718, -12.4}, {2.4942, -15.2}, {2.5119, -10.8}, {3.0582, -11.3}, {4.0810, -12.7}, {4.4579, -16.2},
+    {4.5695, -18.3}, {4.7966, -18.9}, {5.0066, -16.6}, {5.3043, -19.9}, {9.6586, -29.7}};
+
+/// TDL-B delay profile, TR38.901 Table 7.7.2-2 (normalized delays).
+constexpr tdl_tap tdl_b[] = {
+    {0.0000, 0.0}, {0.1072, -2.2}, {0.2155, -4.0}, {0.2095, -3.2}, {0.2870, -9.8}, {0.2986, -1.2},
+    {0.3752, -3.4}, {0.5055, -5.2}, {0.3681, -7.6}, {0.3697, -3.0}, {0.5700, -8.9}, {0.5283, -9.0},
+    {1.1021, -4.8}, {1.2756, -5.7}, {1.5474, -7.5}, {1.7842, -1.9}, {2.0169, -7.6}, {2.8294, -12.2},
+    {3.0219, -9.8}, {3.6187, -11.4}, {4.1067, -14.9}, {4.2790, -9.2}, {4.7834, -11.3}};
+
+/// TDL-C delay profile, TR38.901 Table 7.7.2-3 (normalized delays).
+constexpr tdl_tap tdl_c[] = {
+    {0.0000, -4.4}, {0.2099, -1.2}, {0.2219, -3.5}, {0.2329, -5.2}, {0.2176, -2.5}, {0.6366, 0.0},
+    {0.6448, -2.2}, {0.6560, -3.9}, {0.6584, -7.4}, {0.7935, -7.1}, {0.8213, -10.7}, {0.9336, -11.1},
+    {1.2285, -5.1}, {1.3083, -6.8}, {2.1704, -8.7}, {2.7105, -13.2}, {4.2589, -13.9}, {4.6003, -13.9},
+    {5.4902, -15.8}, {5.6077, -17.1}, {6.3065, -16.0}, {6.6374, -15.7}, {7.0427, -21.6}, {8.6523, -22.8}};
+
+/// TDLA30 delay profile, TS38.104 Table G.2.1.1-2 (delays in nanoseconds).
+constexpr tdl_tap tdla30[] = {
+    {0, -15.5}, {10, 0.0}, {15, -5.1}, {20, -5.1}, {25, -9.6}, {50, -8.2},
+    {65, -13.1}, {75, -11.5}, {105, -11.0}, {135, -16.2}, {150, -16.6}, {290, -26.2}};
+
+/// TDLB100 delay profile, TS38.104 Table G.2.1.1-3 (delays in nanoseconds).
+constexpr tdl_tap tdlb100[] = {
+    {0, 0.0}, {10, -2.2}, {20, -0.6}, {30, -0.6}, {35, -0.3}, {45, -1.2},
+    {55, -5.9}, {120, -2.2}, {170, -0.8}, {245, -6.3}, {330, -7.5}, {480, -7.1}};
+
+/// TDLC300 delay profile, TS38.104 Table G.2.1.1-4 (delays in nanoseconds).
+constexpr tdl_tap tdlc300[] = {
+    {0, -6.9}, {65, 0.0}, {70, -7.7}, {190, -2.5}, {195, -2.4}, {200, -9.9},
+    {240, -8.0}, {290, -6.6}, {325, -7.1}, {520, -13.0}, {1045, -14.2}, {1510, -16.0}};
+// clang-format on
+
+/// Copies the taps of a delay profile into the channel configuration, scaling the delays.
+void set_taps(fading_channel_config& config, span<const tdl_tap> taps, double delay_scaling)
+{
+  config.path_delays.resize(taps.size());
+  config.average_path_gains.resize(taps.size());
+  std::transform(taps.begin(), taps.end(), config.path_delays.begin(), [delay_scaling](const tdl_tap& tap) {
+    return tap.delay * delay_scaling;
+  });
+  std::transform(taps.begin(), taps.end(), config.average_path_gains.begin(), [](const tdl_tap& tap) {
+    return tap.power_dB;
+  });
+}
+
+/// \brief Creates the spatial correlation matrix of a uniform linear array.
+///
+/// \param[in] nof_antennas  Number of antennas.
+/// \param[in] rho           Correlation between the first and the last antennas.
+/// \return The correlation matrix, row-major.
+std::vector<double> antenna_correlation(unsigned nof_antennas, double rho)
+{
+  std::vector<double> corr(nof_antennas * nof_antennas, 1.0);
+  if (nof_antennas == 1) {
+    return corr;
+  }
+  for (unsigned i = 0; i != nof_antennas; ++i) {
+    for (unsigned j = 0; j != nof_antennas; ++j) {
+      double distance            = static_cast<double>(i > j ? i - j : j - i) / (nof_antennas - 1);
+      corr[i * nof_antennas + j] = std::pow(rho, distance * distance);
+    }
+  }
+  return corr;
+}
+
+/// \brief Computes the lower triangular Cholesky factor of a square matrix, in place.
+///
+/// \return \c false if the matrix is not positive definite.
+bool cholesky(std::vector<double>& matrix, unsigned size)
+{
+  for (unsigned j = 0; j != size; ++j) {
+    double diag = matrix[j * size + j];
+    for (unsigned k = 0; k != j; ++k) {
+      diag -= matrix[j * size + k] * matrix[j * size + k];
+    }
+    if (diag <= 0) {
+      return false;
+    }
+    diag                 = std::sqrt(diag);
+    matrix[j * size + j] = diag;
+    for (unsigned i = j + 1; i != size; ++i) {
+      double value = matrix[i * size + j];
+      for (unsigned k = 0; k != j; ++k) {
+        value -= matrix[i * size + k] * matrix[j * size + k];
+      }
+      matrix[i * size + j] = value / diag;
+    }
+    for (unsigned i = 0; i != j; ++i) {
+      matrix[i * size + j] = 0;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+bool srsran_matlab::set_tdl_delay_profile(fading_channel_config& config,
+                                          const std::string&     profile,
+                                          double                 delay_spread)
+{
+  if (profile == "TDL-A") {
+    set_taps(config, tdl_a, delay_spread);
+    return true;
+  }
+  if (profile == "TDL-B") {
+    set_taps(config, tdl_b, delay_spread);
+    return true;
+  }
+  if (profile == "TDL-C") {
+    set_taps(config, tdl_c, delay_spread);
+    return true;
+  }
+  if (profile == "TDLA30") {
+    set_taps(config, tdla30, 1e-9);
+    return true;
+  }
+  if (profile == "TDLB100") {
+    set_taps(config, tdlb100, 1e-9);
+    return true;
+  }
+  if (profile == "TDLC300") {
+    set_taps(config, tdlc300, 1e-9);
+    return true;
+  }
+  return false;
+}
+
+fading_channel::fading_channel(const fading_channel_config& config_) :
+  config(config_), nof_links(config_.nof_tx_ports * config_.nof_rx_ports)
+{
+  unsigned nof_paths = config.path_delays.size();
+  srsran_assert(nof_paths > 0, "At least one path is required.");
+  srsran_assert(config.average_path_gains.size() == nof_paths,
+                "The number of average path gains, i.e., {}, does not match the number of paths, i.e., {}.",
+                config.average_path_gains.size(),
+                nof_paths);
+  srsran_assert(config.sampling_rate > 0, "The sampling rate must be positive.");
+  srsran_assert(config.max_doppler_shift >= 0, "The maximum Doppler shift cannot be negative.");
+  srsran_assert(nof_links > 0, "The number of antenna ports must be positive.");
+  srsran_assert(config.nof_sinusoids > 0, "The number of sinusoids must be positive.");
+  srsran_assert(config.sample_density > 0, "The sample density must be positive.");
+
+  // Average path powers, in linear scale.
+  if (config.normalize_path_gains) {
+    double total_power = 0;
+    for (double gain_dB : config.average_path_gains) {
+      total_power += std::pow(10.0, gain_dB / 10);
+    }
+    double offset_dB = 10 * std::log10(total_power);
+    for (double& gain_dB : config.average_path_gains) {
+      gain_dB -= offset_dB;
+    }
+  }
+  path_amplitudes.resize(nof_paths);
+  std::transform(config.average_path_gains.begin(),
+                 config.average_path_gains.end(),
+                 path_amplitudes.begin(),
+                 [](double gain_dB) { return static_cast<float>(std::pow(10.0, gain_dB / 20)); });
+
+  // Kronecker model: the correlation matrix of the links is the Kronecker product of the transmit and receive
+  // correlation matrices, with the receive port running the fastest.
+  unsigned            nof_tx  = config.nof_tx_ports;
+  unsigned            nof_rx  = config.nof_rx_ports;
+  std::vector<double> corr_tx = antenna_correlation(nof_tx, config.tx_correlation);
+  std::vector<double> corr_rx = antenna_correlation(nof_rx, config.rx_correlation);
+  std::vector<double> corr(nof_links * nof_links);
+  for (unsigned i_link = 0; i_link != nof_links; ++i_link) {
+    for (unsigned j_link = 0; j_link != nof_links; ++j_link) {
+      corr[i_link * nof_links + j_link] = corr_tx[(i_link / nof_rx) * nof_tx + (j_link / nof_rx)] *
+                                          corr_rx[(i_link % nof_rx) * nof_rx + (j_link % nof_rx)];
+    }
+  }
+  std::vector<double> factor = corr;
+  if (!cholesky(factor, nof_links)) {
+    // Highly correlated antennas may result in a numerically singular matrix: regularize it as in TS38.104 Annex G.
+    constexpr double a = 1e-4;
+    factor             = corr;
+    for (unsigned i_link = 0; i_link != nof_links; ++i_link) {
+      factor[i_link * nof_links + i_link] += a;
+    }
+    std::transform(factor.begin(), factor.end(), factor.begin(), [](double value) { return value / (1 + a); });
+    bool success = cholesky(factor, nof_links);
+    srsran_assert(success, "The spatial correlation matrix is not positive definite.");
+  }
+  correlation_factor.assign(factor.begin(), factor.end());
+
+  // Fractional delay filters: windowed sinc centered at the path delay plus the implementation delay.
+  filter_length = 0;
+  filters.resize(nof_paths);
+  for (unsigned i_path = 0; i_path != nof_paths; ++i_path) {
+    double       delay  = config.path_delays[i_path] * config.sampling_rate;
+    double       center = FILTER_DELAY + delay;
+    path_filter& filter = filters[i_path];
+    srsran_assert(delay >= 0, "Path delays cannot be negative.");
+
+    if (std::abs(delay - std::round(delay)) < 1e-6) {
+      // Integer delays need a single tap.
+      filter.offset = static_cast<unsigned>(std::round(center));
+      filter.taps   = {1.0F};
+    } else {
+      int first     = std::max(0, static_cast<int>(std::ceil(center - FILTER_HALF_LENGTH)));
+      int last      = static_cast<int>(std::floor(center + FILTER_HALF_LENGTH));
+      filter.offset = first;
+      filter.taps.resize(last - first + 1);
+      double sum = 0;
+      for (int n = first; n <= last; ++n) {
+        double x      = n - center;
+        double sinc   = std::sin(M_PI * x) / (M_PI * x);
+        double window = 0.5 * (1 + std::cos(M_PI * x / FILTER_HALF_LENGTH));
+        double tap    = sinc * window;
+        sum += tap;
+        filter.taps[n - first] = static_cast<float>(tap);
+      }
+      // Unit DC gain.
+      std::transform(filter.taps.begin(), filter.taps.end(), filter.taps.begin(), [sum](float tap) {
+        return static_cast<float>(tap / sum);
+      });
+    }
+    filter_length = std::max(filter_length, static_cast<unsigned>(filter.offset + filter.taps.size()));
+  }
+
+  // Distance between path gain snapshots, at least one sample.
+  snapshot_period = 1;
+  if (config.max_doppler_shift > 0) {
+    snapshot_period =
+        std::max(1.0, config.sampling_rate / (2.0 * config.sample_density * config.max_doppler_shift));
+  }
+
+  input_buffers.resize(nof_tx);
+  reset(config.seed);
+}
+
+void fading_channel::reset(uint64_t seed)
+{
+  random_stream_id id;
+  id.seed    = seed;
+  id.purpose = random_purpose::fading;
+  reset(id);
+}
+
+void fading_channel::reset(const random_stream_id& id)
+{
+  config.seed   = id.seed;
+  fading_stream = id;
+  reset();
+}
+
+void fading_channel::reset()
+{
+  sample_index = 0;
+  for (std::vector<cf_t>& buffer : input_buffers) {
+    buffer.assign(filter_length - 1, 0);
+  }
+  snapshot_times.clear();
+  snapshot_gains.clear();
+  draw_fading_processes();
+}
+
+void fading_channel::draw_fading_processes()
+{
+  unsigned nof_sinusoids = config.nof_sinusoids;
+  unsigned nof_processes = get_nof_paths() * nof_links * 2;
+  sinusoid_frequencies.resize(nof_processes * nof_sinusoids);
+  sinusoid_phases.resize(nof_processes * nof_sinusoids);
+
+  random_stream rgen(fading_stream);
+  double        max_rotation = M_PI / (4 * nof_sinusoids);
+
+  // Generalized method of exact Doppler spread: the angles of arrival of each process are equally spaced in
+  // (0, pi/2) and rotated by a random angle, the phases are uniformly distributed.
+  for (unsigned i_process = 0; i_process != nof_processes; ++i_process) {
+    double rotation = max_rotation * (2 * rgen.uniform() - 1);
+    for (unsigned i_sinusoid = 0; i_sinusoid != nof_sinusoids; ++i_sinusoid) {
+      double angle = M_PI / (2 * nof_sinusoids) * (i_sinusoid + 0.5) + rotation;
+      sinusoid_frequencies[i_process * nof_sinusoids + i_sinusoid] = config.max_doppler_shift * std::cos(angle);
+      sinusoid_phases[i_process * nof_sinusoids + i_sinusoid]      = 2 * M_PI * rgen.uniform();
+    }
+  }
+}
+
+void fading_channel::compute_path_gains(span<cf_t> gains, double time) const
+{
+  unsigned nof_sinusoids = config.nof_sinusoids;
+  double   norm          = 1.0 / std::sqrt(static_cast<double>(nof_sinusoids));
+
+  std::vector<cf_t> uncorrelated(nof_links);
+  for (unsigned i_path = 0, nof_paths = get_nof_paths(); i_path != nof_paths; ++i_path) {
+    for (unsigned i_link = 0; i_link != nof_links; ++i_link) {
+      double component[2];
+      for (unsigned i_comp = 0; i_comp != 2; ++i_comp) {
+        unsigned offset = ((i_path * nof_links + i_link) * 2 + i_comp) * nof_sinusoids;
+        double   sum    = 0;
+        for (unsigned i_sinusoid = 0; i_sinusoid != nof_sinusoids; ++i_sinusoid) {
+          sum += std::cos(2 * M_PI * sinusoid_frequencies[offset + i_sinusoid] * time +
+                          sinusoid_phases[offset + i_sinusoid]);
+        }
+        component[i_comp] = sum * norm;
+      }
+      uncorrelated[i_link] = cf_t(component[0], component[1]);
+    }
+
+    for (unsigned i_link = 0; i_link != nof_links; ++i_link) {
+      cf_t value = 0;
+      for (unsigned j_link = 0; j_link <= i_link; ++j_link) {
+        value += correlation_factor[i_link * nof_links + j_link] * uncorrelated[j_link];
+      }
+      gains[i_path * nof_links + i_link] = path_amplitudes[i_path] * value;
+    }
+  }
+}
+
+void fading_channel::run(span<cf_t> output, span<const cf_t> input)
+{
+  unsigned nof_tx    = config.nof_tx_ports;
+  unsigned nof_rx    = config.nof_rx_ports;
+  unsigned nof_paths = get_nof_paths();
+  srsran_assert(input.size() % nof_tx == 0,
+                "The number of input samples, i.e., {}, is not a multiple of the number of transmit ports, i.e., {}.",
+                input.size(),
+                nof_tx);
+  unsigned nof_samples = input.size() / nof_tx;
+  srsran_assert(output.size() == static_cast<std::size_t>(nof_samples) * nof_rx,
+                "The output size, i.e., {}, does not match the number of samples times the number of receive ports, "
+                "i.e., {}.",
+                output.size(),
+                nof_samples * nof_rx);
+  if (nof_samples == 0) {
+    return;
+  }
+
+  // Append the new samples to the filter memory.
+  unsigned memory_length = filter_length - 1;
+  for (unsigned i_tx = 0; i_tx != nof_tx; ++i_tx) {
+    std::vector<cf_t>& buffer = input_buffers[i_tx];
+    buffer.resize(memory_length + nof_samples);
+    std::copy_n(input.begin() + i_tx * nof_samples, nof_samples, buffer.begin() + memory_length);
+  }
+
+  // Compute the path gain snapshots around the current block. The last snapshot is strictly after the last sample,
+  // so that all samples lie in between two snapshots.
+  uint64_t first_snapshot = 0;
+  unsigned nof_snapshots  = 1;
+  if (config.max_doppler_shift > 0) {
+    first_snapshot         = static_cast<uint64_t>(std::floor(sample_index / snapshot_period));
+    uint64_t last_snapshot = static_cast<uint64_t>(std::floor((sample_index + nof_samples - 1) / snapshot_period)) + 1;
+    nof_snapshots          = last_snapshot - first_snapshot + 1;
+  }
+  unsigned gains_per_snapshot = nof_paths * nof_links;
+  snapshot_times.resize(nof_snapshots);
+  snapshot_gains.resize(nof_snapshots * gains_per_snapshot);
+  for (unsigned i_snapshot = 0; i_snapshot != nof_snapshots; ++i_snapshot) {
+    double position = (config.max_doppler_shift > 0) ? (first_snapshot + i_snapshot) * snapshot_period
+                                                     : static_cast<double>(sample_index);
+    snapshot_times[i_snapshot] = position / config.sampling_rate;
+    compute_path_gains(span<cf_t>(snapshot_gains).subspan(i_snapshot * gains_per_snapshot, gains_per_snapshot),
+                       snapshot_times[i_snapshot]);
+  }
+
+  float output_scaling = config.normalize_outputs ? 1.0F / std::sqrt(static_cast<float>(nof_rx)) : 1.0F;
+
+  std::fill(output.begin(), output.end(), 0);
+  filtered.resize(nof_samples);
+  for (unsigned i_path = 0; i_path != nof_paths; ++i_path) {
+    const path_filter& filter = filters[i_path];
+    for (unsigned i_tx = 0; i_tx != nof_tx; ++i_tx) {
+      // Fractional delay filter, one tap at a time over the whole block.
+      std::fill(filtered.begin(), filtered.end(), 0);
+      for (unsigned i_tap = 0, nof_taps = filter.taps.size(); i_tap != nof_taps; ++i_tap) {
+        float       tap = filter.taps[i_tap];
+        const cf_t* in  = input_buffers[i_tx].data() + memory_length - filter.offset - i_tap;
+        for (unsigned i_sample = 0; i_sample != nof_samples; ++i_sample) {
+          filtered[i_sample] += tap * in[i_sample];
+        }
+      }
+
+      // Apply the time-varying path gain of each link and accumulate.
+      for (unsigned i_rx = 0; i_rx != nof_rx; ++i_rx) {
+        unsigned i_gain = i_path * nof_links + i_tx * nof_rx + i_rx;
+        cf_t*    out    = output.data() + static_cast<std::size_t>(i_rx) * nof_samples;
+
+        if (nof_snapshots == 1) {
+          cf_t gain = output_scaling * snapshot_gains[i_gain];
+          for (unsigned i_sample = 0; i_sample != nof_samples; ++i_sample) {
+            out[i_sample] += gain * filtered[i_sample];
+          }
+          continue;
+        }
+
+        for (unsigned i_snapshot = 0; i_snapshot != nof_snapshots - 1; ++i_snapshot) {
+          double position  = (first_snapshot + i_snapshot) * snapshot_period;
+          double next      = (first_snapshot + i_snapshot + 1) * snapshot_period;
+          auto   begin     = static_cast<int64_t>(std::ceil(position)) - static_cast<int64_t>(sample_index);
+          auto   end       = static_cast<int64_t>(std::ceil(next)) - static_cast<int64_t>(sample_index);
+          auto   i_begin   = static_cast<unsigned>(std::max<int64_t>(begin, 0));
+          auto   i_end     = static_cast<unsigned>(std::min<int64_t>(end, nof_samples));
+          cf_t   gain      = output_scaling * snapshot_gains[i_snapshot * gains_per_snapshot + i_gain];
+          cf_t   next_gain = output_scaling * snapshot_gains[(i_snapshot + 1) * gains_per_snapshot + i_gain];
+          cf_t   slope     = (next_gain - gain) / static_cast<float>(snapshot_period);
+          float  shift     = static_cast<float>(static_cast<double>(sample_index + i_begin) - position);
+          for (unsigned i_sample = i_begin; i_sample < i_end; ++i_sample) {
+            cf_t interp_gain = gain + slope * (shift + static_cast<float>(i_sample - i_begin));
+            out[i_sample] += interp_gain * filtered[i_sample];
+          }
+        }
+      }
+    }
+  }
+
+  // Keep the last input samples as filter memory.
+  for (std::vector<cf_t>& buffer : input_buffers) {
+    std::copy(buffer.end() - memory_length, buffer.end(), buffer.begin());
+    buffer.resize(memory_length);
+  }
+  sample_index += nof_samples;
+}
+
+std::vector<float> fading_channel::get_path_filters() const
+{
+  std::vector<float> out(static_cast<std::size_t>(filter_length) * get_nof_paths(), 0);
+  for (unsigned i_path = 0, nof_paths = get_nof_paths(); i_path != nof_paths; ++i_path) {
+    const path_filter& filter = filters[i_path];
+    std::copy(filter.taps.begin(), filter.taps.end(), out.begin() + i_path * filter_length + filter.offset);
+  }
+  return out;
+}
@@ -0,0 +1,271 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Fading channel MEX definition.
+
+#include "fading_channel_mex.h"
+#include "srsran_matlab/channel/matlab_to_fading_channel.h"
+#include "srsran_matlab/support/random_stream.h"
+#include "srsran_matlab/support/to_span.h"
+#include <MatlabDataArray/ArrayDimensions.hpp>
+#include <memory>
+
+using matlab::mex::ArgumentList;
+using namespace matlab::data;
+using namespace srsran;
+using namespace srsran_matlab;
+
+fading_channel& MexFunction::get_channel(ArgumentList inputs)
+{
+  if ((inputs[1].getType() != ArrayType::UINT64) || (inputs[1].getNumberOfElements() != 1)) {
+    mex_abort("Input 'channelID' should be a scalar uint64_t.");
+  }
+
+  uint64_t                        key     = static_cast<TypedArray<uint64_t>>(inputs[1])[0];
+  std::shared_ptr<fading_channel> channel = storage.get_memento(key);
+  if (!channel) {
+    mex_abort("Cannot retrieve the fading channel with key {}.", key);
+  }
+  return *channel;
+}
+
+void MexFunction::method_new(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 2;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::STRUCT) || (inputs[1].getNumberOfElements() != 1)) {
+    mex_abort("Input 'channelConfig' should be a scalar structure.");
+  }
+
+  if (outputs.size() != 1) {
+    mex_abort("Wrong number of outputs: expected 1, provided {}.", outputs.size());
+  }
+
+  const StructArray     in_struct_array = inputs[1];
+  const Struct          in_cfg          = in_struct_array[0];
+  fading_channel_config config;
+
+  matlab_to_fading_profile(config, in_cfg, [this](const std::string& msg) { mex_abort(msg); });
+
+  for (double delay : config.path_delays) {
+    if (delay < 0) {
+      mex_abort("Path delays cannot be negative.");
+    }
+  }
+
+  config.sampling_rate     = in_cfg["SampleRate"][0];
+  config.nof_tx_ports      = static_cast<unsigned>(in_cfg["NumTransmitAntennas"][0]);
+  config.nof_rx_ports      = static_cast<unsigned>(in_cfg["NumReceiveAntennas"][0]);
+  config.tx_correlation    = in_cfg["TransmitCorrelation"][0];
+  config.rx_correlation    = in_cfg["ReceiveCorrelation"][0];
+  config.nof_sinusoids     = static_cast<unsigned>(in_cfg["NumSinusoids"][0]);
+  config.sample_density    = static_cast<unsigned>(in_cfg["SampleDensity"][0]);
+  config.seed              = static_cast<uint64_t>(in_cfg["Seed"][0]);
+
+  const TypedArray<bool> in_normalize_gains   = in_cfg["NormalizePathGains"];
+  const TypedArray<bool> in_normalize_outputs = in_cfg["NormalizeChannelOutputs"];
+  config.normalize_path_gains                 = in_normalize_gains[0];
+  config.normalize_outputs                    = in_normalize_outputs[0];
+
+  if ((config.sampling_rate <= 0) || (config.max_doppler_shift < 0)) {
+    mex_abort("The sampling rate must be positive and the maximum Doppler shift nonnegative.");
+  }
+  if ((config.nof_tx_ports == 0) || (config.nof_rx_ports == 0)) {
+    mex_abort("The number of transmit and receive antennas must be positive.");
+  }
+  if ((config.nof_sinusoids == 0) || (config.sample_density == 0)) {
+    mex_abort("The number of sinusoids and the sample density must be positive.");
+  }
+  if ((config.tx_correlation < 0) || (config.tx_correlation > 1) || (config.rx_correlation < 0) ||
+      (config.rx_correlation > 1)) {
+    mex_abort("The antenna correlation coefficients must be between 0 and 1.");
+  }
+
+  std::shared_ptr<fading_channel> channel = std::make_shared<fading_channel>(config);
+  if (!channel) {
+    mex_abort("Cannot create fading channel.");
+  }
+  uint64_t key = storage.store(channel);
+  outputs[0]   = factory.createScalar(key);
+}
+
+void MexFunction::method_step(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 3;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((outputs.size() == 0) || (outputs.size() > 3)) {
+    mex_abort("Wrong number of outputs: expected 1 to 3, provided {}.", outputs.size());
+  }
+
+  fading_channel&              channel = get_channel(inputs);
+  const fading_channel_config& config  = channel.get_config();
+
+  ArrayDimensions in_dims = inputs[2].getDimensions();
+  if ((inputs[2].getType() != ArrayType::COMPLEX_SINGLE) || (in_dims.size() != 2) ||
+      (in_dims[1] != config.nof_tx_ports)) {
+    mex_abort("Input 'txWaveform' should be a two-dimensional array of complex floats with {} columns, provided [{}].",
+              config.nof_tx_ports,
+              in_dims);
+  }
+  std::size_t nof_samples = in_dims[0];
+
+  const TypedArray<cf_t> in_waveform = inputs[2];
+  TypedArray<cf_t>       out_waveform =
+      factory.createArray<cf_t>({nof_samples, static_cast<std::size_t>(config.nof_rx_ports)});
+  channel.run(to_span(out_waveform), to_span(in_waveform));
+  outputs[0] = out_waveform;
+
+  if (outputs.size() == 1) {
+    return;
+  }
+
+  // Path gains: rearrange from [snapshot][path][tx][rx] to MATLAB column-major snapshots-by-paths-by-tx-by-rx.
+  std::size_t      nof_snapshots = channel.get_nof_snapshots();
+  std::size_t      nof_paths     = channel.get_nof_paths();
+  std::size_t      nof_tx        = config.nof_tx_ports;
+  std::size_t      nof_rx        = config.nof_rx_ports;
+  span<const cf_t> gains         = channel.get_path_gains();
+  TypedArray<cf_t> out_gains     = factory.createArray<cf_t>({nof_snapshots, nof_paths, nof_tx, nof_rx});
+  span<cf_t>       out_view      = to_span(out_gains);
+  for (std::size_t i_snapshot = 0; i_snapshot != nof_snapshots; ++i_snapshot) {
+    for (std::size_t i_path = 0; i_path != nof_paths; ++i_path) {
+      for (std::size_t i_tx = 0; i_tx != nof_tx; ++i_tx) {
+        for (std::size_t i_rx = 0; i_rx != nof_rx; ++i_rx) {
+          out_view[i_snapshot + nof_snapshots * (i_path + nof_paths * (i_tx + nof_tx * i_rx))] =
+              gains[((i_snapshot * nof_paths + i_path) * nof_tx + i_tx) * nof_rx + i_rx];
+        }
+      }
+    }
+  }
+  outputs[1] = out_gains;
+
+  if (outputs.size() == 3) {
+    span<const double> times = channel.get_snapshot_times();
+    outputs[2]               = factory.createArray({nof_snapshots, 1}, times.begin(), times.end());
+  }
+}
+
+void MexFunction::method_reset(ArgumentList outputs, ArgumentList inputs)
+{
+  if ((inputs.size() < 2) || (inputs.size() > 4)) {
+    mex_abort("Wrong number of inputs: expected 2, 3 or 4, provided {}.", inputs.size());
+  }
+
+  if (!outputs.empty()) {
+    mex_abort("Wrong number of outputs: expected 0, provided {}.", outputs.size());
+  }
+
+  fading_channel& channel = get_channel(inputs);
+
+  if (inputs.size() == 2) {
+    channel.reset();
+    return;
+  }
+
+  if ((inputs[2].getType() != ArrayType::DOUBLE) || (inputs[2].getNumberOfElements() != 1)) {
+    mex_abort("Input 'seed' should be a scalar double.");
+  }
+  uint64_t seed = static_cast<uint64_t>(static_cast<TypedArray<double>>(inputs[2])[0]);
+  if (inputs.size() == 3) {
+    channel.reset(seed);
+    return;
+  }
+
+  if ((inputs[3].getType() != ArrayType::DOUBLE) || (inputs[3].getNumberOfElements() != 3)) {
+    mex_abort("Input 'streamIndices' should be an array of three doubles.");
+  }
+  const TypedArray<double> in_indices = inputs[3];
+
+  random_stream_id id;
+  id.seed    = seed;
+  id.purpose = random_purpose::fading;
+  if ((in_indices[0] < 0) || (in_indices[0] >= random_stream_id::MAX_SNR_INDEX) || (in_indices[1] < 0) ||
+      (in_indices[1] >= static_cast<double>(random_stream_id::MAX_ITEM)) || (in_indices[2] < 0) ||
+      (in_indices[2] >= random_stream_id::MAX_SLOT)) {
+    mex_abort("Invalid random stream indices (SNR index {}, item {}, slot {}).",
+              static_cast<double>(in_indices[0]),
+              static_cast<double>(in_indices[1]),
+              static_cast<double>(in_indices[2]));
+  }
+  id.snr_index = static_cast<unsigned>(in_indices[0]);
+  id.item      = static_cast<uint64_t>(in_indices[1]);
+  id.slot      = static_cast<unsigned>(in_indices[2]);
+  channel.reset(id);
+}
+
+void MexFunction::method_info(ArgumentList outputs, ArgumentList inputs)
+{
+  if (inputs.size() != 2) {
+    mex_abort("Wrong number of inputs: expected 2, provided {}.", inputs.size());
+  }
+
+  if (outputs.size() != 1) {
+    mex_abort("Wrong number of outputs: expected 1, provided {}.", outputs.size());
+  }
+
+  const fading_channel&        channel   = get_channel(inputs);
+  const fading_channel_config& config    = channel.get_config();
+  std::size_t                  nof_paths = channel.get_nof_paths();
+  std::size_t                  nof_taps  = channel.get_filter_length();
+
+  // The filters are stored one after the other, which is a column-major taps-by-paths matrix: transpose it.
+  std::vector<float> filters     = channel.get_path_filters();
+  TypedArray<double> out_filters = factory.createArray<double>({nof_paths, nof_taps});
+  for (std::size_t i_path = 0; i_path != nof_paths; ++i_path) {
+    for (std::size_t i_tap = 0; i_tap != nof_taps; ++i_tap) {
+      out_filters[i_path][i_tap] = filters[i_path * nof_taps + i_tap];
+    }
+  }
+
+  StructArray S =
+      factory.createStructArray({1, 1}, {"PathDelays", "AveragePathGains", "ChannelFilterDelay", "PathFilters"});
+  S[0]["PathDelays"] = factory.createArray({1, nof_paths}, config.path_delays.cbegin(), config.path_delays.cend());
+  S[0]["AveragePathGains"] =
+      factory.createArray({1, nof_paths}, config.average_path_gains.cbegin(), config.average_path_gains.cend());
+  S[0]["ChannelFilterDelay"] = factory.createScalar(static_cast<double>(fading_channel::FILTER_DELAY));
+  S[0]["PathFilters"]        = out_filters;
+  outputs[0]                 = S;
+}
+
+void MexFunction::method_release(ArgumentList outputs, ArgumentList inputs)
+{
+  if (inputs.size() != 2) {
+    mex_abort("Wrong number of inputs: expected 2, provided {}.", inputs.size());
+  }
+
+  if (!outputs.empty()) {
+    mex_abort("Wrong number of outputs: expected 0, provided {}.", outputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::UINT64) || (inputs[1].getNumberOfElements() != 1)) {
+    mex_abort("Input 'channelID' should be a scalar uint64_t.");
+  }
+
+  uint64_t key = static_cast<TypedArray<uint64_t>>(inputs[1])[0];
+  if (storage.release_memento(key) == 0) {
+    mex_abort("There was no fading channel with key {}.", key);
+  }
+}
@@ -0,0 +1,120 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Fading channel MEX declaration.
+
+#pragma once
+
+#include "srsran_matlab/channel/fading_channel.h"
+#include "srsran_matlab/srsran_mex_dispatcher.h"
+#include "srsran_matlab/support/memento.h"
+
+/// \brief Implements a tapped delay line fading channel following the srsran_mex_dispatcher template.
+///
+/// Since MATLAB instantiates a single MexFunction object, each channel (with its own configuration, fading time and
+/// filter memory) is stored as a memento and identified by a key.
+class MexFunction : public srsran_mex_dispatcher
+{
+public:
+  /// Constructor: stores the string identifier&ndash;method pairs that form the public interface of the MEX object.
+  MexFunction()
+  {
+    create_callback("new", [this](ArgumentList out, ArgumentList in) { this->method_new(out, in); });
+    create_callback("step", [this](ArgumentList out, ArgumentList in) { this->method_step(out, in); });
+    create_callback("reset", [this](ArgumentList out, ArgumentList in) { this->method_reset(out, in); });
+    create_callback("info", [this](ArgumentList out, ArgumentList in) { this->method_info(out, in); });
+    create_callback("release", [this](ArgumentList out, ArgumentList in) { this->method_release(out, in); });
+  }
+
+private:
+  /// Retrieves the fading channel identified by the second input, aborting if it does not exist.
+  srsran_matlab::fading_channel& get_channel(ArgumentList inputs);
+
+  /// \brief Creates a new fading channel.
+  ///
+  /// The method accepts two inputs.
+  ///   - The string <tt>"new"</tt>.
+  ///   - A one-dimensional structure with fields
+  ///      - \c DelayProfile, one of <tt>"TDL-A"</tt>, <tt>"TDL-B"</tt>, <tt>"TDL-C"</tt>, <tt>"TDLA30"</tt>,
+  ///        <tt>"TDLB100"</tt>, <tt>"TDLC300"</tt> and <tt>"custom"</tt>;
+  ///      - \c DelaySpread, the delay spread in seconds (<tt>"TDL-A"</tt>, <tt>"TDL-B"</tt> and <tt>"TDL-C"</tt>);
+  ///      - \c PathDelays, the path delays in seconds (<tt>"custom"</tt> only);
+  ///      - \c AveragePathGains, the average path gains in decibel (<tt>"custom"</tt> only);
+  ///      - \c MaximumDopplerShift, the maximum Doppler shift in hertz;
+  ///      - \c SampleRate, the sampling rate in hertz;
+  ///      - \c NumTransmitAntennas, the number of transmit antennas;
+  ///      - \c NumReceiveAntennas, the number of receive antennas;
+  ///      - \c TransmitCorrelation, the correlation between the first and last transmit antennas;
+  ///      - \c ReceiveCorrelation, the correlation between the first and last receive antennas;
+  ///      - \c NumSinusoids, the number of sinusoids of each fading process;
+  ///      - \c SampleDensity, the number of path gain snapshots per half period of the maximum Doppler shift;
+  ///      - \c NormalizePathGains, a logical flag to normalize the total power of the average path gains to one;
+  ///      - \c NormalizeChannelOutputs, a logical flag to normalize the outputs by the number of receive antennas;
+  ///      - \c Seed, the seed of the fading processes.
+  ///
+  /// The only output of the method is the identifier of the created channel (a \c uint64_t number).
+  void method_new(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Passes a block of samples through a fading channel.
+  ///
+  /// The method takes three inputs.
+  ///   - The string <tt>"step"</tt>.
+  ///   - The channel identifier (a \c uint64_t number).
+  ///   - A two-dimensional array of complex single-precision floats with the transmitted samples, one column for
+  ///     each transmit antenna.
+  ///
+  /// The method has up to three outputs.
+  ///   - A two-dimensional array of complex single-precision floats with the received samples, one column for each
+  ///     receive antenna.
+  ///   - A four-dimensional array of complex single-precision floats with the path gain snapshots, the dimensions
+  ///     being snapshots, paths, transmit antennas and receive antennas.
+  ///   - A column array with the sampling instants of the path gain snapshots, in seconds.
+  void method_step(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Resets a fading channel.
+  ///
+  /// The method takes two, three or four inputs.
+  ///   - The string <tt>"reset"</tt>.
+  ///   - The channel identifier (a \c uint64_t number).
+  ///   - Optionally, a new seed for the fading processes (a scalar double).
+  ///   - Optionally, the SNR index, the item index and the slot index of the fading random stream (an array of three
+  ///     doubles). With the same seed and indices, the fading processes coincide with those of the native simulation
+  ///     engines (see srsran_matlab::random_stream_id).
+  ///
+  /// The method has no outputs.
+  void method_reset(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Returns information about a fading channel.
+  ///
+  /// The method takes, as input, the channel identifier (a \c uint64_t number). The output is a structure with fields
+  ///   - \c PathDelays, the path delays in seconds;
+  ///   - \c AveragePathGains, the (normalized, if requested) average path gains in decibel;
+  ///   - \c ChannelFilterDelay, the implementation delay of the path filters in samples;
+  ///   - \c PathFilters, the path filters, one row for each path.
+  void method_info(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Releases a fading channel.
+  ///
+  /// The method takes, as input, the channel identifier (a \c uint64_t number). It has no outputs.
+  void method_release(ArgumentList outputs, ArgumentList inputs);
+
+  /// A container for the fading channels.
+  memento_storage<srsran_matlab::fading_channel> storage;
+};
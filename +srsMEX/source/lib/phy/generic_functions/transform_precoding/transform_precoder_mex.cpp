@@ -0,0 +1,144 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Transform precoder MEX definition.
+
+#include "transform_precoder_mex.h"
+#include "srsran_matlab/support/to_span.h"
+#include "srsran/srsvec/copy.h"
+#include <MatlabDataArray/ArrayDimensions.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+using matlab::mex::ArgumentList;
+using namespace matlab::data;
+using namespace srsran;
+using namespace srsran_matlab;
+
+unsigned MexFunction::get_nof_prb(unsigned nof_subcarriers)
+{
+  unsigned nof_prb = nof_subcarriers / NRE;
+  if ((nof_subcarriers % NRE != 0) || (nof_prb == 0) || (nof_prb >= plans.precoders.size()) ||
+      !plans.precoders[nof_prb] || !plans.deprecoders[nof_prb]) {
+    mex_abort("Invalid number of subcarriers {}: it should be 12 times a number of PRBs of the form 2^a * 3^b * 5^c.",
+              nof_subcarriers);
+  }
+  return nof_prb;
+}
+
+void MexFunction::method_precode(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 2;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  ArrayDimensions in_dims = inputs[1].getDimensions();
+  if ((inputs[1].getType() != ArrayType::COMPLEX_SINGLE) || (in_dims.size() != 2)) {
+    mex_abort("Input 'symbols' should be a 2-dimensional array of complex floats, provided [{}].", in_dims);
+  }
+
+  constexpr unsigned NOF_OUTPUTS = 1;
+  if (outputs.size() != NOF_OUTPUTS) {
+    mex_abort("Wrong number of outputs: expected {}, provided {}.", NOF_OUTPUTS, outputs.size());
+  }
+
+  unsigned nof_subcarriers = in_dims[0];
+  unsigned nof_symbols     = in_dims[1];
+  unsigned nof_prb         = get_nof_prb(nof_subcarriers);
+
+  const TypedArray<cf_t> in_symbols = inputs[1];
+  span<const cf_t>       in_view    = to_span(in_symbols);
+
+  TypedArray<cf_t> out_symbols = factory.createArray<cf_t>({nof_subcarriers, nof_symbols});
+  span<cf_t>       out_view    = to_span(out_symbols);
+
+  // Transform precoding, as per TS38.211 Section 6.3.1.4.
+  dft_processor& precoder = *plans.precoders[nof_prb];
+  float          scaling  = 1.0F / std::sqrt(static_cast<float>(nof_subcarriers));
+  for (unsigned i_symbol = 0; i_symbol != nof_symbols; ++i_symbol) {
+    srsvec::copy(precoder.get_input(), in_view.subspan(i_symbol * nof_subcarriers, nof_subcarriers));
+    span<const cf_t> dft_output = precoder.run();
+
+    span<cf_t> out_symbol = out_view.subspan(i_symbol * nof_subcarriers, nof_subcarriers);
+    for (unsigned i_re = 0; i_re != nof_subcarriers; ++i_re) {
+      out_symbol[i_re] = scaling * dft_output[i_re];
+    }
+  }
+
+  outputs[0] = out_symbols;
+}
+
+void MexFunction::method_deprecode(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 3;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  ArrayDimensions in_dims = inputs[1].getDimensions();
+  if ((inputs[1].getType() != ArrayType::COMPLEX_SINGLE) || (in_dims.size() != 2)) {
+    mex_abort("Input 'symbols' should be a 2-dimensional array of complex floats, provided [{}].", in_dims);
+  }
+
+  if ((inputs[2].getType() != ArrayType::SINGLE) || (inputs[2].getDimensions() != in_dims)) {
+    mex_abort("Input 'noiseVars' should be an array of floats with size [{}].", in_dims);
+  }
+
+  constexpr unsigned NOF_OUTPUTS = 2;
+  if (outputs.size() != NOF_OUTPUTS) {
+    mex_abort("Wrong number of outputs: expected {}, provided {}.", NOF_OUTPUTS, outputs.size());
+  }
+
+  unsigned nof_subcarriers = in_dims[0];
+  unsigned nof_symbols     = in_dims[1];
+  unsigned nof_prb         = get_nof_prb(nof_subcarriers);
+
+  const TypedArray<cf_t>  in_symbols    = inputs[1];
+  span<const cf_t>        in_view       = to_span(in_symbols);
+  const TypedArray<float> in_noise_vars = inputs[2];
+  span<const float>       in_nvar_view  = to_span(in_noise_vars);
+
+  TypedArray<cf_t>  out_symbols    = factory.createArray<cf_t>({nof_subcarriers, nof_symbols});
+  span<cf_t>        out_view       = to_span(out_symbols);
+  TypedArray<float> out_noise_vars = factory.createArray<float>({nof_subcarriers, nof_symbols});
+  span<float>       out_nvar_view  = to_span(out_noise_vars);
+
+  dft_processor& deprecoder = *plans.deprecoders[nof_prb];
+  float          scaling    = 1.0F / std::sqrt(static_cast<float>(nof_subcarriers));
+  for (unsigned i_symbol = 0; i_symbol != nof_symbols; ++i_symbol) {
+    srsvec::copy(deprecoder.get_input(), in_view.subspan(i_symbol * nof_subcarriers, nof_subcarriers));
+    span<const cf_t> idft_output = deprecoder.run();
+
+    span<cf_t> out_symbol = out_view.subspan(i_symbol * nof_subcarriers, nof_subcarriers);
+    for (unsigned i_re = 0; i_re != nof_subcarriers; ++i_re) {
+      out_symbol[i_re] = scaling * idft_output[i_re];
+    }
+
+    // After deprecoding, the noise is spread evenly across the subcarriers of the OFDM symbol.
+    span<const float> in_nvar_symbol = in_nvar_view.subspan(i_symbol * nof_subcarriers, nof_subcarriers);
+    float mean_noise_var = std::accumulate(in_nvar_symbol.begin(), in_nvar_symbol.end(), 0.0F) / nof_subcarriers;
+    std::fill_n(out_nvar_view.begin() + i_symbol * nof_subcarriers, nof_subcarriers, mean_noise_var);
+  }
+
+  outputs[0] = out_symbols;
+  outputs[1] = out_noise_vars;
+}
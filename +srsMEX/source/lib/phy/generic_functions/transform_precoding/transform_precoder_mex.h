@@ -0,0 +1,129 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Transform precoder MEX declaration.
+
+#pragma once
+
+#include "srsran_matlab/srsran_mex_dispatcher.h"
+#include "srsran/phy/generic_functions/dft_processor.h"
+#include "srsran/phy/generic_functions/generic_functions_factories.h"
+#include "srsran/ran/resource_block.h"
+#include <memory>
+#include <vector>
+
+/// \brief DFT plans for transform precoding and deprecoding.
+///
+/// Both vectors are indexed by the number of PRBs: entries corresponding to sizes that are not valid for DFT-s-OFDM
+/// (i.e., that are not of the form \f$2^a 3^b 5^c\f$) are empty.
+struct transform_precoder_plans {
+  /// DFT processors for transform precoding.
+  std::vector<std::unique_ptr<srsran::dft_processor>> precoders;
+  /// Inverse DFT processors for transform deprecoding.
+  std::vector<std::unique_ptr<srsran::dft_processor>> deprecoders;
+};
+
+/// Factory method for the transform precoding DFT plans of all valid sizes up to \c MAX_RB resource blocks.
+inline transform_precoder_plans create_transform_precoder_plans();
+
+/// \brief Implements a DFT-s-OFDM transform precoder and deprecoder.
+///
+/// The DFT plans of all valid allocation sizes are created once, when the MEX is loaded, and all the OFDM symbols of
+/// a slot are processed with a single call.
+class MexFunction : public srsran_mex_dispatcher
+{
+public:
+  /// Constructor: stores the string identifier&ndash;method pairs that form the public interface of the MEX object.
+  MexFunction()
+  {
+    create_callback("precode", [this](ArgumentList out, ArgumentList in) { this->method_precode(out, in); });
+    create_callback("deprecode", [this](ArgumentList out, ArgumentList in) { this->method_deprecode(out, in); });
+  }
+
+private:
+  /// \brief Returns the number of PRBs spanned by OFDM symbols of the given number of subcarriers.
+  ///
+  /// The MEX function aborts if the number of subcarriers does not correspond to a valid transform precoding size.
+  unsigned get_nof_prb(unsigned nof_subcarriers);
+
+  /// \brief Applies transform precoding to a set of OFDM symbols.
+  ///
+  /// The method has two inputs.
+  ///   - The string <tt>"precode"</tt>.
+  ///   - The modulated symbols: a two-dimensional array of complex single-precision floats (subcarriers, OFDM
+  ///     symbols). The number of subcarriers must be \f$12 M_{\textup{RB}}\f$, with \f$M_{\textup{RB}} = 2^a 3^b 5^c
+  ///     \le 275\f$.
+  ///
+  /// The method has one output.
+  ///   - The transform-precoded symbols, with the same size as the input.
+  void method_precode(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Reverts transform precoding on a set of OFDM symbols.
+  ///
+  /// The method has three inputs.
+  ///   - The string <tt>"deprecode"</tt>.
+  ///   - The equalized symbols: a two-dimensional array of complex single-precision floats (subcarriers, OFDM
+  ///     symbols). The number of subcarriers must be \f$12 M_{\textup{RB}}\f$, with \f$M_{\textup{RB}} = 2^a 3^b 5^c
+  ///     \le 275\f$.
+  ///   - The noise variances of the equalized symbols: a two-dimensional array of single-precision floats, with the
+  ///     same size as the equalized symbols.
+  ///
+  /// The method has two outputs.
+  ///   - The deprecoded symbols, with the same size as the input.
+  ///   - The deprecoded noise variances, that is the noise variance of each OFDM symbol averaged over all its
+  ///     subcarriers, with the same size as the input.
+  void method_deprecode(ArgumentList outputs, ArgumentList inputs);
+
+  /// DFT plans for all valid transform precoding sizes.
+  transform_precoder_plans plans = create_transform_precoder_plans();
+};
+
+transform_precoder_plans create_transform_precoder_plans()
+{
+  using namespace srsran;
+
+  std::shared_ptr<dft_processor_factory> dft_factory = create_dft_processor_factory_fftw_slow();
+  if (!dft_factory) {
+    return {};
+  }
+
+  transform_precoder_plans plans;
+  plans.precoders.resize(MAX_RB + 1);
+  plans.deprecoders.resize(MAX_RB + 1);
+
+  for (unsigned nof_prb = 1; nof_prb <= MAX_RB; ++nof_prb) {
+    // Only sizes of the form 2^a * 3^b * 5^c are valid, as per TS38.211 Section 6.3.1.4.
+    unsigned remainder = nof_prb;
+    for (unsigned factor : {2U, 3U, 5U}) {
+      while (remainder % factor == 0) {
+        remainder /= factor;
+      }
+    }
+    if (remainder != 1) {
+      continue;
+    }
+
+    unsigned nof_subcarriers   = nof_prb * NRE;
+    plans.precoders[nof_prb]   = dft_factory->create({nof_subcarriers, dft_processor::direction::DIRECT});
+    plans.deprecoders[nof_prb] = dft_factory->create({nof_subcarriers, dft_processor::direction::INVERSE});
+  }
+
+  return plans;
+}
@@ -0,0 +1,244 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief PRACH demodulator MEX definition.
+
+#include "prach_demodulator_mex.h"
+#include "srsran_matlab/support/matlab_to_srs.h"
+#include "srsran_matlab/support/to_span.h"
+#include "srsran/phy/support/support_factories.h"
+#include "srsran/phy/upper/channel_processors/channel_processor_formatters.h"
+#include "srsran/ran/prach/prach_preamble_information.h"
+#include "srsran/ran/slot_point.h"
+#include "srsran/srsvec/conversion.h"
+#include "srsran/srsvec/copy.h"
+#include <MatlabDataArray/ArrayDimensions.hpp>
+
+using matlab::mex::ArgumentList;
+using namespace matlab::data;
+using namespace srsran;
+using namespace srsran_matlab;
+
+prach_buffer& MexFunction::get_buffer(std::unique_ptr<prach_buffer>& buf,
+                                      buffer_dimensions&             current_dims,
+                                      const buffer_dimensions&       dims)
+{
+  if (buf && (current_dims == dims)) {
+    return *buf;
+  }
+
+  if (dims.is_long) {
+    buf = create_prach_buffer_long(dims.nof_ports, dims.nof_fd_occasions);
+  } else {
+    buf = create_prach_buffer_short(dims.nof_ports, dims.nof_td_occasions, dims.nof_fd_occasions);
+  }
+
+  if (!buf) {
+    mex_abort("Cannot create srsRAN PRACH buffer.");
+  }
+  current_dims = dims;
+
+  return *buf;
+}
+
+void MexFunction::check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs)
+{
+  if ((inputs.size() != 3) && (inputs.size() != 4)) {
+    mex_abort("Wrong number of inputs: expected 3 or 4, provided {}.", inputs.size());
+  }
+
+  ArrayDimensions in1_dims = inputs[1].getDimensions();
+  if ((inputs[1].getType() != ArrayType::COMPLEX_SINGLE) || (in1_dims.size() != 2)) {
+    mex_abort("Input 'waveform' should be a 2-dimensional array of complex floats, provided [{}].", in1_dims);
+  }
+
+  if ((inputs[2].getType() != ArrayType::STRUCT) || (inputs[2].getNumberOfElements() > 1)) {
+    mex_abort("Input 'demodulatorConfig' must be a scalar structure.");
+  }
+
+  bool detect = (inputs.size() == 4);
+  if (detect && ((inputs[3].getType() != ArrayType::STRUCT) || (inputs[3].getNumberOfElements() > 1))) {
+    mex_abort("Input 'detectorConfig' must be a scalar structure.");
+  }
+
+  if (detect && ((outputs.size() < 1) || (outputs.size() > 2))) {
+    mex_abort("Wrong number of outputs: expected 1 or 2, provided {}.", outputs.size());
+  }
+
+  if (!detect && (outputs.size() != 1)) {
+    mex_abort("Wrong number of outputs: expected 1, provided {}.", outputs.size());
+  }
+}
+
+void MexFunction::method_step(ArgumentList outputs, ArgumentList inputs)
+{
+  check_step_outputs_inputs(outputs, inputs);
+
+  bool detect       = (inputs.size() == 4);
+  bool keep_symbols = !detect || (outputs.size() == 2);
+
+  const StructArray in_demod_cfg_array = inputs[2];
+  const Struct      in_demod_cfg       = in_demod_cfg_array[0];
+
+  // Create a new demodulator only if the sampling rate has changed.
+  double srate_Hz = in_demod_cfg["SampleRate"][0];
+  if (!demodulator || (srate_Hz != demodulator_srate_Hz)) {
+    demodulator = create_prach_demodulator(sampling_rate::from_MHz(srate_Hz / 1e6));
+    if (!demodulator) {
+      mex_abort("Cannot create srsRAN OFDM PRACH demodulator for a sampling rate of {} Hz.", srate_Hz);
+    }
+    demodulator_srate_Hz = srate_Hz;
+  }
+
+  const CharArray    in_format = in_demod_cfg["Format"];
+  subcarrier_spacing scs       = matlab_to_srs_subcarrier_spacing(in_demod_cfg["SubcarrierSpacing"][0]);
+
+  ofdm_prach_demodulator::configuration demod_config = {};
+  demod_config.slot             = slot_point(to_numerology_value(scs), static_cast<unsigned>(in_demod_cfg["NSlot"][0]));
+  demod_config.format           = matlab_to_srs_preamble_format(in_format.toAscii());
+  demod_config.nof_td_occasions = in_demod_cfg["NumTimeOccasions"][0];
+  demod_config.nof_fd_occasions = in_demod_cfg["NumFreqOccasions"][0];
+  demod_config.start_symbol     = in_demod_cfg["StartSymbol"][0];
+  demod_config.rb_offset        = in_demod_cfg["RBOffset"][0];
+  demod_config.nof_prb_ul_grid  = in_demod_cfg["NSizeGrid"][0];
+
+  if ((demod_config.nof_td_occasions == 0) || (demod_config.nof_fd_occasions == 0)) {
+    mex_abort("The number of time- and frequency-domain occasions must be positive.");
+  }
+
+  bool is_long = is_long_preamble(demod_config.format);
+  if (is_long && (demod_config.nof_td_occasions != 1)) {
+    mex_abort("Long preamble formats support one time-domain occasion only, provided {}.",
+              demod_config.nof_td_occasions);
+  }
+
+  prach_subcarrier_spacing ra_scs = to_ra_subcarrier_spacing(
+      static_cast<unsigned>(1000.0 * static_cast<double>(in_demod_cfg["PRACHSubcarrierSpacing"][0])));
+  prach_preamble_information preamble_info = get_prach_preamble_info(demod_config.format, ra_scs);
+  unsigned                   nof_re        = preamble_info.sequence_length;
+  unsigned                   nof_symbols   = preamble_info.nof_symbols;
+
+  ArrayDimensions in_dims     = inputs[1].getDimensions();
+  unsigned        nof_samples = in_dims[0];
+  unsigned        nof_ports   = in_dims[1];
+
+  // Demodulate all ports into the cached buffer.
+  prach_buffer& demod_buffer = get_buffer(
+      buffer, buffer_dims, {is_long, nof_ports, demod_config.nof_td_occasions, demod_config.nof_fd_occasions});
+
+  const TypedArray<cf_t> in_waveform = inputs[1];
+  span<const cf_t>       waveform    = to_span(in_waveform);
+  for (unsigned i_port = 0; i_port != nof_ports; ++i_port) {
+    demod_config.port = i_port;
+    demodulator->demodulate(demod_buffer, waveform.subspan(i_port * nof_samples, nof_samples), demod_config);
+  }
+
+  unsigned nof_td_occasions = demod_config.nof_td_occasions;
+  unsigned nof_fd_occasions = demod_config.nof_fd_occasions;
+
+  if (keep_symbols) {
+    TypedArray<cf_t> out_symbols =
+        factory.createArray<cf_t>({nof_re, nof_symbols, nof_ports, nof_fd_occasions, nof_td_occasions});
+    span<cf_t> out_view = to_span(out_symbols);
+    for (unsigned i_td = 0; i_td != nof_td_occasions; ++i_td) {
+      for (unsigned i_fd = 0; i_fd != nof_fd_occasions; ++i_fd) {
+        for (unsigned i_port = 0; i_port != nof_ports; ++i_port) {
+          for (unsigned i_symbol = 0; i_symbol != nof_symbols; ++i_symbol) {
+            srsvec::convert(out_view.first(nof_re), demod_buffer.get_symbol(i_port, i_td, i_fd, i_symbol));
+            out_view = out_view.last(out_view.size() - nof_re);
+          }
+        }
+      }
+    }
+    outputs[detect ? 1 : 0] = out_symbols;
+  }
+
+  if (!detect) {
+    return;
+  }
+
+  // Chain the PRACH detector.
+  const StructArray in_det_cfg_array = inputs[3];
+  const Struct      in_det_cfg       = in_det_cfg_array[0];
+  const CharArray   restricted_set   = in_det_cfg["RestrictedSet"];
+
+  prach_detector::configuration detector_config = {};
+  detector_config.restricted_set                = matlab_to_srs_restricted_set(restricted_set.toAscii());
+  detector_config.root_sequence_index           = in_det_cfg["SequenceIndex"][0];
+  detector_config.format                        = demod_config.format;
+  detector_config.zero_correlation_zone         = in_det_cfg["ZeroCorrelationZone"][0];
+  detector_config.start_preamble_index          = 0;
+  detector_config.nof_preamble_indices          = 64;
+  detector_config.ra_scs                        = ra_scs;
+  detector_config.nof_rx_ports                  = nof_ports;
+
+  if (!validator->is_valid(detector_config)) {
+    mex_abort("Invalid configuration:\n {:n}.", detector_config);
+  }
+
+  // The detector processes the first occasion of its input buffer: when there are several occasions, each of them is
+  // copied into a single-occasion buffer.
+  bool          single_occasion = (nof_td_occasions == 1) && (nof_fd_occasions == 1);
+  prach_buffer& detector_input =
+      single_occasion ? demod_buffer : get_buffer(detector_buffer, detector_buffer_dims, {is_long, nof_ports, 1, 1});
+
+  StructArray out = factory.createStructArray({nof_fd_occasions, nof_td_occasions},
+                                              {"NumDetectedPreambles",
+                                               "PreambleIndices",
+                                               "TimeAdvance",
+                                               "NormalizedMetric",
+                                               "RSSIDecibel",
+                                               "TimeResolution",
+                                               "MaxTimeAdvance"});
+  for (unsigned i_td = 0; i_td != nof_td_occasions; ++i_td) {
+    for (unsigned i_fd = 0; i_fd != nof_fd_occasions; ++i_fd) {
+      if (!single_occasion) {
+        for (unsigned i_port = 0; i_port != nof_ports; ++i_port) {
+          for (unsigned i_symbol = 0; i_symbol != nof_symbols; ++i_symbol) {
+            srsvec::copy(detector_input.get_symbol(i_port, 0, 0, i_symbol),
+                         demod_buffer.get_symbol(i_port, i_td, i_fd, i_symbol));
+          }
+        }
+      }
+
+      prach_detection_result result = detector->detect(detector_input, detector_config);
+
+      unsigned          nof_detections = result.preambles.size();
+      Reference<Struct> dpi            = out[i_fd + nof_fd_occasions * i_td];
+      dpi["NumDetectedPreambles"]      = factory.createScalar(nof_detections);
+      dpi["RSSIDecibel"]               = factory.createScalar(result.rssi_dB);
+      dpi["TimeResolution"]            = factory.createScalar(result.time_resolution.to_seconds());
+      dpi["MaxTimeAdvance"]            = factory.createScalar(result.time_advance_max.to_seconds());
+      dpi["PreambleIndices"]           = factory.createArray<double>({nof_detections, 1});
+      dpi["TimeAdvance"]               = factory.createArray<double>({nof_detections, 1});
+      dpi["NormalizedMetric"]          = factory.createArray<double>({nof_detections, 1});
+
+      for (unsigned i_preamble = 0; i_preamble != nof_detections; ++i_preamble) {
+        const prach_detection_result::preamble_indication& preamble = result.preambles[i_preamble];
+
+        dpi["PreambleIndices"][i_preamble]  = static_cast<double>(preamble.preamble_index);
+        dpi["TimeAdvance"][i_preamble]      = static_cast<double>(preamble.time_advance.to_seconds());
+        dpi["NormalizedMetric"][i_preamble] = static_cast<double>(preamble.detection_metric);
+      }
+    }
+  }
+
+  outputs[0] = out;
+}
@@ -0,0 +1,172 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief PRACH demodulator MEX declaration.
+
+#pragma once
+
+#include "srsran_matlab/srsran_mex_dispatcher.h"
+#include "srsran/phy/generic_functions/generic_functions_factories.h"
+#include "srsran/phy/lower/modulation/modulation_factories.h"
+#include "srsran/phy/lower/modulation/ofdm_prach_demodulator.h"
+#include "srsran/phy/lower/sampling_rate.h"
+#include "srsran/phy/support/prach_buffer.h"
+#include "srsran/phy/upper/channel_processors/channel_processor_factories.h"
+#include "srsran/phy/upper/channel_processors/prach_detector.h"
+#include <memory>
+
+/// \brief Factory method for an OFDM PRACH demodulator.
+///
+/// \param[in] srate Sampling rate of the time-domain input signal.
+inline std::unique_ptr<srsran::ofdm_prach_demodulator> create_prach_demodulator(srsran::sampling_rate srate);
+
+/// Factory method for a PRACH detector factory.
+inline std::shared_ptr<srsran::prach_detector_factory> create_prach_detector_factory();
+
+/// \brief Implements an OFDM PRACH demodulator, optionally followed by PRACH detection.
+///
+/// The MEX demodulates a time-domain signal directly into an srsRAN \c prach_buffer that is kept across calls and only
+/// reallocated when its dimensions change. When requested, the demodulated PRACH occasions are passed to an srsRAN
+/// PRACH detector in the same call, so that no intermediate frequency-domain MATLAB array is needed.
+class MexFunction : public srsran_mex_dispatcher
+{
+public:
+  /// Constructor: stores the string identifier&ndash;method pairs that form the public interface of the MEX object.
+  MexFunction()
+  {
+    // Ensure the srsRAN PRACH detector was created successfully.
+    if (!detector || !validator) {
+      mex_abort("Cannot create srsRAN PRACH detector.");
+    }
+
+    create_callback("step", [this](ArgumentList out, ArgumentList in) { this->method_step(out, in); });
+  }
+
+private:
+  /// Dimensions of a PRACH buffer.
+  struct buffer_dimensions {
+    /// Long preamble flag.
+    bool is_long;
+    /// Number of receive ports.
+    unsigned nof_ports;
+    /// Number of time-domain occasions.
+    unsigned nof_td_occasions;
+    /// Number of frequency-domain occasions.
+    unsigned nof_fd_occasions;
+
+    bool operator==(const buffer_dimensions& other) const
+    {
+      return (is_long == other.is_long) && (nof_ports == other.nof_ports) &&
+             (nof_td_occasions == other.nof_td_occasions) && (nof_fd_occasions == other.nof_fd_occasions);
+    }
+  };
+
+  /// Checks that outputs/inputs arguments match the requirements of method_step().
+  void check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Gets a PRACH buffer with the given dimensions.
+  ///
+  /// The buffer is reused if the dimensions match those of the previous call, otherwise a new one is created.
+  srsran::prach_buffer& get_buffer(std::unique_ptr<srsran::prach_buffer>& buffer,
+                                   buffer_dimensions&                     current_dims,
+                                   const buffer_dimensions&               dims);
+
+  /// \brief Demodulates the PRACH occasions of a time-domain signal and, optionally, detects PRACH preambles.
+  ///
+  /// The method takes three or four inputs.
+  ///   - The string <tt>"step"</tt>.
+  ///   - A two-dimensional array of complex single-precision floats with the time-domain baseband signal (samples,
+  ///     Rx ports). The signal starts at the beginning of the PRACH slot.
+  ///   - A one-dimensional structure that describes the PRACH demodulator configuration, with fields
+  ///      - \c SampleRate, the sampling rate of the time-domain signal in hertz;
+  ///      - \c SubcarrierSpacing, the subcarrier spacing of the uplink carrier in kHz;
+  ///      - \c NSlot, the PRACH slot number;
+  ///      - \c NSizeGrid, the size of the uplink resource grid in PRBs;
+  ///      - \c Format, the PRACH preamble format;
+  ///      - \c PRACHSubcarrierSpacing, the PRACH subcarrier spacing in kHz;
+  ///      - \c NumTimeOccasions, the number of time-domain PRACH occasions;
+  ///      - \c NumFreqOccasions, the number of frequency-domain PRACH occasions;
+  ///      - \c StartSymbol, the first OFDM symbol of the PRACH within the slot;
+  ///      - \c RBOffset, the PRB offset of the first frequency-domain PRACH occasion.
+  ///   - (Optional) A one-dimensional structure that describes the PRACH detector configuration. If present, the
+  ///     demodulated occasions are passed to the PRACH detector. The fields are
+  ///      - \c SequenceIndex, the root sequence index;
+  ///      - \c RestrictedSet, restricted set configuration;
+  ///      - \c ZeroCorrelationZone, zero-correlation zone configuration index.
+  ///
+  /// Without detector configuration, the method has one single output.
+  ///   - A five-dimensional array of complex single-precision floats with the demodulated PRACH symbols (dimensions
+  ///     are sequence elements, OFDM symbols, Rx ports, frequency-domain occasions and time-domain occasions).
+  ///
+  /// With detector configuration, the method has one or two outputs.
+  ///   - A two-dimensional structure array (frequency-domain occasions, time-domain occasions) with the detection
+  ///     results, with the same fields as the output of \c prach_detector_mex.
+  ///   - (Optional) The demodulated PRACH symbols, as above.
+  void method_step(ArgumentList outputs, ArgumentList inputs);
+
+  /// OFDM PRACH demodulator, created for a given sampling rate.
+  std::unique_ptr<srsran::ofdm_prach_demodulator> demodulator;
+  /// Sampling rate of the current demodulator, in hertz.
+  double demodulator_srate_Hz = 0;
+  /// Buffer for the demodulated PRACH occasions.
+  std::unique_ptr<srsran::prach_buffer> buffer;
+  /// Dimensions of the buffer for the demodulated PRACH occasions.
+  buffer_dimensions buffer_dims = {};
+  /// Single-occasion buffer for the PRACH detector input.
+  std::unique_ptr<srsran::prach_buffer> detector_buffer;
+  /// Dimensions of the PRACH detector input buffer.
+  buffer_dimensions detector_buffer_dims = {};
+  /// PRACH detector factory.
+  std::shared_ptr<srsran::prach_detector_factory> detector_factory = create_prach_detector_factory();
+  /// PRACH detector.
+  std::unique_ptr<srsran::prach_detector> detector = detector_factory ? detector_factory->create() : nullptr;
+  /// PRACH detector validator.
+  std::unique_ptr<srsran::prach_detector_validator> validator =
+      detector_factory ? detector_factory->create_validator() : nullptr;
+};
+
+std::unique_ptr<srsran::ofdm_prach_demodulator> create_prach_demodulator(srsran::sampling_rate srate)
+{
+  using namespace srsran;
+
+  std::shared_ptr<dft_processor_factory> dft_factory = create_dft_processor_factory_fftw_slow();
+  if (!dft_factory) {
+    return nullptr;
+  }
+
+  std::shared_ptr<ofdm_prach_demodulator_factory> demodulator_factory =
+      create_ofdm_prach_demodulator_factory_sw(dft_factory, srate);
+  if (!demodulator_factory) {
+    return nullptr;
+  }
+
+  return demodulator_factory->create();
+}
+
+std::shared_ptr<srsran::prach_detector_factory> create_prach_detector_factory()
+{
+  using namespace srsran;
+
+  std::shared_ptr<dft_processor_factory> dft_factory = create_dft_processor_factory_generic();
+
+  std::shared_ptr<prach_generator_factory> generator_factory = create_prach_generator_factory_sw();
+
+  return create_prach_detector_factory_sw(dft_factory, generator_factory);
+}
@@ -0,0 +1,146 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Demodulation mapper MEX definition.
+
+#include "demodulation_mapper_mex.h"
+#include "srsran_matlab/support/matlab_to_srs.h"
+#include "srsran_matlab/support/parallel_for.h"
+#include "srsran_matlab/support/to_span.h"
+#include "srsran/phy/upper/log_likelihood_ratio.h"
+#include <algorithm>
+
+using matlab::mex::ArgumentList;
+using namespace matlab::data;
+using namespace srsran;
+using namespace srsran_matlab;
+
+void MexFunction::method_new(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 2;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::DOUBLE) || (inputs[1].getNumberOfElements() != 1)) {
+    mex_abort("Input 'nofWorkers' should be a scalar double.");
+  }
+  unsigned nof_workers = static_cast<unsigned>(static_cast<TypedArray<double>>(inputs[1])[0]);
+  if (nof_workers == 0) {
+    nof_workers = default_nof_workers();
+  }
+
+  if (!outputs.empty()) {
+    mex_abort("Wrong number of outputs: expected 0, provided {}.", outputs.size());
+  }
+
+  if (!modulation_factory) {
+    mex_abort("Cannot create srsRAN channel modulation factory.");
+  }
+
+  demappers.clear();
+  for (unsigned i_worker = 0; i_worker != nof_workers; ++i_worker) {
+    demappers.emplace_back(modulation_factory->create_demodulation_mapper());
+
+    // Ensure the demodulation mapper was created properly.
+    if (!demappers.back()) {
+      mex_abort("Cannot create srsRAN demodulation mapper.");
+    }
+  }
+}
+
+void MexFunction::check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 4;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if (inputs[1].getType() != ArrayType::COMPLEX_SINGLE) {
+    mex_abort("Input 'symbols' must be an array of complex single-precision floats.");
+  }
+
+  if (inputs[2].getType() != ArrayType::SINGLE) {
+    mex_abort("Input 'noiseVars' must be an array of single-precision floats.");
+  }
+
+  std::size_t nof_symbols    = inputs[1].getNumberOfElements();
+  std::size_t nof_noise_vars = inputs[2].getNumberOfElements();
+  if ((nof_noise_vars != nof_symbols) && (nof_noise_vars != 1)) {
+    mex_abort("Input 'noiseVars' must be a scalar or have one entry per symbol, provided {} for {} symbols.",
+              nof_noise_vars,
+              nof_symbols);
+  }
+
+  if (inputs[3].getType() != ArrayType::CHAR) {
+    mex_abort("Input 'modulation' must be a string.");
+  }
+
+  constexpr unsigned NOF_OUTPUTS = 1;
+  if (outputs.size() != NOF_OUTPUTS) {
+    mex_abort("Wrong number of outputs: expected {}, provided {}.", NOF_OUTPUTS, outputs.size());
+  }
+}
+
+void MexFunction::method_step(ArgumentList outputs, ArgumentList inputs)
+{
+  // Ensure the demodulation mappers are initialized.
+  if (demappers.empty()) {
+    mex_abort("The srsRAN demodulation mappers were not initialized properly.");
+  }
+
+  check_step_outputs_inputs(outputs, inputs);
+
+  const CharArray   in_modulation   = inputs[3];
+  modulation_scheme modulation      = matlab_to_srs_modulation(in_modulation.toAscii());
+  unsigned          bits_per_symbol = get_bits_per_symbol(modulation);
+
+  const TypedArray<cf_t>  in_symbols    = inputs[1];
+  const TypedArray<float> in_noise_vars = inputs[2];
+  span<const cf_t>        symbols       = to_span(in_symbols);
+  span<const float>       noise_vars    = to_span(in_noise_vars);
+  std::size_t             nof_symbols   = symbols.size();
+
+  // A scalar noise variance applies to all symbols.
+  std::vector<float> noise_vars_expanded;
+  if ((noise_vars.size() == 1) && (nof_symbols != 1)) {
+    noise_vars_expanded.assign(nof_symbols, noise_vars.front());
+    noise_vars = noise_vars_expanded;
+  }
+
+  TypedArray<int8_t>         out  = factory.createArray<int8_t>({nof_symbols * bits_per_symbol, 1});
+  span<log_likelihood_ratio> llrs = to_span<int8_t, log_likelihood_ratio>(out);
+
+  unsigned nof_blocks = (nof_symbols + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  try {
+    parallel_for(nof_blocks, static_cast<unsigned>(demappers.size()), [&](unsigned i_block, unsigned i_worker) {
+      std::size_t offset     = static_cast<std::size_t>(i_block) * BLOCK_SIZE;
+      std::size_t block_size = std::min(static_cast<std::size_t>(BLOCK_SIZE), nof_symbols - offset);
+      demappers[i_worker]->demodulate_soft(llrs.subspan(offset * bits_per_symbol, block_size * bits_per_symbol),
+                                           symbols.subspan(offset, block_size),
+                                           noise_vars.subspan(offset, block_size),
+                                           modulation);
+    });
+  } catch (const std::exception& e) {
+    mex_abort("Cannot demodulate the symbols: {}", e.what());
+  }
+
+  outputs[0] = out;
+}
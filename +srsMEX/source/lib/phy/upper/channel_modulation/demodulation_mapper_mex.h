@@ -0,0 +1,91 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Demodulation mapper MEX declaration.
+
+#pragma once
+
+#include "srsran_matlab/srsran_mex_dispatcher.h"
+#include "srsran/phy/upper/channel_modulation/channel_modulation_factories.h"
+#include "srsran/phy/upper/channel_modulation/demodulation_mapper.h"
+#include <memory>
+#include <vector>
+
+/// Factory method for a channel modulation factory.
+inline std::shared_ptr<srsran::channel_modulation_factory> create_channel_modulation_factory();
+
+/// \brief Implements a bulk demodulation mapper leveraging srsRAN \c demodulation_mapper.
+///
+/// The MEX keeps a pool of demodulation mappers, one per worker thread. The input symbols are split into blocks that
+/// are demodulated in parallel into saturated, quantized log-likelihood ratios.
+class MexFunction : public srsran_mex_dispatcher
+{
+public:
+  /// Constructor: stores the string identifier&ndash;method pairs that form the public interface of the MEX object.
+  MexFunction()
+  {
+    create_callback("new", [this](ArgumentList out, ArgumentList in) { this->method_new(out, in); });
+    create_callback("step", [this](ArgumentList out, ArgumentList in) { this->method_step(out, in); });
+  }
+
+private:
+  /// \brief Number of symbols processed by a worker at a time.
+  ///
+  /// The block size is even, so that all the blocks start with an even symbol index, as required by the
+  /// \f$\pi/2\f$-BPSK demodulator.
+  static constexpr unsigned BLOCK_SIZE = 8192;
+
+  /// \brief Creates a new pool of demodulation mappers.
+  ///
+  /// The method accepts only two inputs.
+  ///   - The string <tt>"new"</tt>.
+  ///   - The number of worker threads (a scalar double). If zero, the number of hardware threads is used.
+  ///
+  /// The method has no output.
+  void method_new(ArgumentList outputs, ArgumentList inputs);
+
+  /// Checks that outputs/inputs arguments match the requirements of method_step().
+  void check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Demodulates a sequence of equalized symbols.
+  ///
+  /// The method has four inputs.
+  ///   - The string <tt>"step"</tt>.
+  ///   - A one-dimensional array of complex single-precision floats with the equalized symbols.
+  ///   - A one-dimensional array of single-precision floats with the noise variance of each symbol, or a scalar if
+  ///     all symbols have the same noise variance.
+  ///   - A string with the modulation scheme (one of <tt>"BPSK"</tt>, <tt>"pi/2-BPSK"</tt>, <tt>"QPSK"</tt>,
+  ///     <tt>"16QAM"</tt>, <tt>"64QAM"</tt> and <tt>"256QAM"</tt>).
+  ///
+  /// The method has one single output.
+  ///   - A column array of \c int8_t with the quantized log-likelihood ratios, \f$Q_m\f$ for each symbol.
+  void method_step(ArgumentList outputs, ArgumentList inputs);
+
+  /// Factory of channel modulation components.
+  std::shared_ptr<srsran::channel_modulation_factory> modulation_factory = create_channel_modulation_factory();
+
+  /// Pool of demodulation mappers, one for each worker.
+  std::vector<std::unique_ptr<srsran::demodulation_mapper>> demappers;
+};
+
+std::shared_ptr<srsran::channel_modulation_factory> create_channel_modulation_factory()
+{
+  return srsran::create_channel_modulation_sw_factory();
+}
@@ -0,0 +1,317 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief PDCCH processor MEX definition.
+
+#include "pdcch_processor_mex.h"
+#include "srsran_matlab/ran/pdcch_candidates.h"
+#include "srsran_matlab/support/matlab_to_srs.h"
+#include "srsran_matlab/support/parallel_for.h"
+#include "srsran_matlab/support/resource_grid.h"
+#include "srsran_matlab/support/to_span.h"
+#include "srsran/phy/support/resource_grid_reader.h"
+#include "srsran/phy/support/resource_grid_writer.h"
+#include "srsran/ran/pdcch/pdcch_constants.h"
+#include "srsran/ran/precoding/precoding_codebooks.h"
+#include "srsran/ran/slot_point.h"
+#include "srsran/srsvec/conversion.h"
+#include <stdexcept>
+
+using matlab::mex::ArgumentList;
+using namespace matlab::data;
+using namespace srsran;
+using namespace srsran_matlab;
+
+void MexFunction::method_new(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 2;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::DOUBLE) || (inputs[1].getNumberOfElements() != 1)) {
+    mex_abort("Input 'nofWorkers' should be a scalar double.");
+  }
+  unsigned nof_workers = static_cast<unsigned>(static_cast<TypedArray<double>>(inputs[1])[0]);
+  if (nof_workers == 0) {
+    nof_workers = default_nof_workers();
+  }
+
+  if (!outputs.empty()) {
+    mex_abort("Wrong number of outputs: expected 0, provided {}.", outputs.size());
+  }
+
+  processors.clear();
+  for (unsigned i_worker = 0; i_worker != nof_workers; ++i_worker) {
+    processors.emplace_back(processor_factory->create());
+
+    // Ensure the processor was created properly.
+    if (!processors.back()) {
+      mex_abort("Cannot create srsRAN PDCCH processor.");
+    }
+  }
+}
+
+void MexFunction::check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 4;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::STRUCT) || (inputs[1].getNumberOfElements() > 1)) {
+    mex_abort("Input 'gridConfig' must be a scalar structure.");
+  }
+
+  if (inputs[2].getType() != ArrayType::CELL) {
+    mex_abort("Input 'dciPayloads' must be a cell array.");
+  }
+
+  if ((inputs[3].getType() != ArrayType::STRUCT) ||
+      (inputs[3].getNumberOfElements() != inputs[2].getNumberOfElements())) {
+    mex_abort("Input 'PDCCHConfigs' must be a structure array with one entry for each DCI payload.");
+  }
+
+  constexpr unsigned NOF_OUTPUTS = 1;
+  if (outputs.size() != NOF_OUTPUTS) {
+    mex_abort("Wrong number of outputs: expected {}, provided {}.", NOF_OUTPUTS, outputs.size());
+  }
+}
+
+void MexFunction::method_step(ArgumentList outputs, ArgumentList inputs)
+{
+  // Ensure the processors are initialized.
+  if (processors.empty()) {
+    mex_abort("The srsRAN PDCCH processors were not initialized properly.");
+  }
+
+  check_step_outputs_inputs(outputs, inputs);
+
+  // Resource grid dimensions.
+  StructArray     in_grid_array   = inputs[1];
+  const Struct    in_grid         = in_grid_array[0];
+  unsigned        nof_grid_rb     = in_grid["NSizeGrid"][0];
+  const CharArray in_grid_cp      = in_grid["CyclicPrefix"];
+  cyclic_prefix   grid_cp         = matlab_to_srs_cyclic_prefix(in_grid_cp.toAscii());
+  unsigned        nof_symbols     = get_nsymb_per_slot(grid_cp);
+  unsigned        nof_ports       = in_grid["NumPorts"][0];
+  unsigned        nof_subcarriers = nof_grid_rb * NRE;
+
+  // Build all the PDUs in the calling thread, since the MATLAB API is not thread-safe.
+  const CellArray                     in_payload_array = inputs[2];
+  const StructArray                   in_pdu_array     = inputs[3];
+  unsigned                            nof_dci          = in_pdu_array.getNumberOfElements();
+  std::vector<pdcch_processor::pdu_t> pdus(nof_dci);
+  for (unsigned i_dci = 0; i_dci != nof_dci; ++i_dci) {
+    if (in_payload_array[i_dci].getType() != ArrayType::UINT8) {
+      mex_abort("DCI payload {} must be an array of uint8_t.", i_dci);
+    }
+    const TypedArray<uint8_t> in_payload = in_payload_array[i_dci];
+    if (in_payload.getNumberOfElements() > pdcch_constants::MAX_DCI_PAYLOAD_SIZE) {
+      mex_abort("DCI payload {} has {} bits, exceeding the maximum of {}.",
+                i_dci,
+                in_payload.getNumberOfElements(),
+                pdcch_constants::MAX_DCI_PAYLOAD_SIZE);
+    }
+
+    const Struct            in_cfg = in_pdu_array[i_dci];
+    pdcch_processor::pdu_t& pdu    = pdus[i_dci];
+
+    pdu.context = std::nullopt;
+    pdu.slot = slot_point(to_numerology_value(matlab_to_srs_subcarrier_spacing(in_cfg["SubcarrierSpacing"][0])),
+                          static_cast<unsigned>(in_cfg["NSlot"][0]));
+    pdu.cp   = grid_cp;
+
+    pdcch_processor::coreset_description& coreset = pdu.coreset;
+    coreset.bwp_size_rb                           = in_cfg["NSizeBWP"][0];
+    coreset.bwp_start_rb                          = in_cfg["NStartBWP"][0];
+    coreset.start_symbol_index                    = in_cfg["StartSymbolIndex"][0];
+    coreset.duration                              = in_cfg["Duration"][0];
+
+    const TypedArray<bool> in_freq_resources = in_cfg["FrequencyResources"];
+    if (in_freq_resources.getNumberOfElements() > pdcch_constants::MAX_NOF_FREQ_RESOURCES) {
+      mex_abort("The CORESET frequency resources of DCI {} exceed the maximum of {} entries.",
+                i_dci,
+                pdcch_constants::MAX_NOF_FREQ_RESOURCES);
+    }
+    coreset.frequency_resources = freq_resource_bitmap(in_freq_resources.cbegin(), in_freq_resources.cend());
+
+    const CharArray   in_mapping = in_cfg["CCEREGMapping"];
+    const std::string mapping    = in_mapping.toAscii();
+    if (mapping == "interleaved") {
+      coreset.cce_to_reg_mapping = pdcch_processor::cce_to_reg_mapping_type::INTERLEAVED;
+      coreset.reg_bundle_size    = in_cfg["REGBundleSize"][0];
+      coreset.interleaver_size   = in_cfg["InterleaverSize"][0];
+      coreset.shift_index        = in_cfg["ShiftIndex"][0];
+    } else if (mapping == "noninterleaved") {
+      coreset.cce_to_reg_mapping = pdcch_processor::cce_to_reg_mapping_type::NON_INTERLEAVED;
+      coreset.reg_bundle_size    = 0;
+      coreset.interleaver_size   = 0;
+      coreset.shift_index        = 0;
+    } else {
+      mex_abort("Unknown CCE-to-REG mapping {}.", mapping);
+    }
+
+    pdcch_processor::dci_description& dci = pdu.dci;
+    dci.rnti                              = in_cfg["RNTI"][0];
+    dci.n_id_pdcch_dmrs                   = in_cfg["NIDDMRS"][0];
+    dci.n_id_pdcch_data                   = in_cfg["NIDData"][0];
+    dci.n_rnti                            = in_cfg["NRNTI"][0];
+    dci.cce_index                         = in_cfg["CCEIndex"][0];
+    dci.aggregation_level                 = in_cfg["AggregationLevel"][0];
+    dci.dmrs_power_offset_dB              = static_cast<float>(static_cast<double>(in_cfg["DMRSPowerOffset"][0]));
+    dci.data_power_offset_dB              = static_cast<float>(static_cast<double>(in_cfg["DataPowerOffset"][0]));
+    dci.payload.assign(in_payload.cbegin(), in_payload.cend());
+    dci.precoding = precoding_configuration::make_wideband(make_single_port());
+
+    error_type<std::string> validation = validator->is_valid(pdu);
+    if (!validation.has_value()) {
+      mex_abort("The PDCCH configuration {} is invalid: {}.", i_dci, validation.error());
+    }
+  }
+
+  // Each worker maps its DCI messages onto its own resource grid.
+  unsigned nof_workers = std::max(1U, std::min(nof_dci, static_cast<unsigned>(processors.size())));
+  std::vector<std::unique_ptr<resource_grid>> grids;
+  for (unsigned i_worker = 0; i_worker != nof_workers; ++i_worker) {
+    grids.emplace_back(create_resource_grid(nof_subcarriers, nof_symbols, nof_ports));
+    if (!grids.back()) {
+      mex_abort("Cannot create resource grid.");
+    }
+    grids.back()->set_all_zero();
+  }
+
+  try {
+    parallel_for(nof_dci, nof_workers, [&](unsigned i_dci, unsigned i_worker) {
+      processors[i_worker]->process(grids[i_worker]->get_writer(), pdus[i_dci]);
+    });
+  } catch (const std::exception& e) {
+    mex_abort("Cannot process the DCI messages: {}", e.what());
+  }
+
+  // Combine the grids of all workers. DCI messages allocated to disjoint CCEs do not overlap, so it suffices to add
+  // them. Overlapping (i.e., blocked) DCI messages are superimposed.
+  TypedArray<cf_t> out_grid = factory.createArray<cf_t>({nof_subcarriers, nof_symbols, nof_ports});
+  write_resource_grid(out_grid, grids[0]->get_reader());
+  std::vector<cf_t> symbol_buffer(nof_subcarriers);
+  for (unsigned i_worker = 1; i_worker != nof_workers; ++i_worker) {
+    const resource_grid_reader& reader    = grids[i_worker]->get_reader();
+    span<cf_t>                  grid_view = to_span(out_grid);
+    for (unsigned i_port = 0; i_port != nof_ports; ++i_port) {
+      for (unsigned i_symbol = 0; i_symbol != nof_symbols; ++i_symbol) {
+        srsvec::convert(symbol_buffer, reader.get_view(i_port, i_symbol).first(nof_subcarriers));
+        for (unsigned i_subc = 0; i_subc != nof_subcarriers; ++i_subc) {
+          grid_view[i_subc] += symbol_buffer[i_subc];
+        }
+        grid_view = grid_view.last(grid_view.size() - nof_subcarriers);
+      }
+    }
+  }
+
+  outputs[0] = out_grid;
+}
+
+void MexFunction::method_candidates(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 3;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::STRUCT) || (inputs[1].getNumberOfElements() > 1)) {
+    mex_abort("Input 'searchSpaceConfig' must be a scalar structure.");
+  }
+
+  if (inputs[2].getType() != ArrayType::DOUBLE) {
+    mex_abort("Input 'RNTIs' must be an array of double.");
+  }
+
+  constexpr unsigned NOF_OUTPUTS = 1;
+  if (outputs.size() != NOF_OUTPUTS) {
+    mex_abort("Wrong number of outputs: expected {}, provided {}.", NOF_OUTPUTS, outputs.size());
+  }
+
+  StructArray  in_ss_array = inputs[1];
+  const Struct in_ss       = in_ss_array[0];
+  unsigned     nof_cce     = in_ss["NumCCEs"][0];
+  unsigned     coreset_id  = in_ss["CORESETID"][0];
+  unsigned     slot_index  = in_ss["NSlot"][0];
+
+  const CharArray   in_ss_type = in_ss["SearchSpaceType"];
+  const std::string ss_type    = in_ss_type.toAscii();
+  bool              is_common  = (ss_type == "common");
+  if (!is_common && (ss_type != "ue")) {
+    mex_abort("Unknown search space type {}.", ss_type);
+  }
+  if (!is_common && (slot_index >= PDCCH_MAX_NOF_SLOTS_PER_FRAME)) {
+    mex_abort("The slot index, i.e., {}, exceeds the maximum of {}.", slot_index, PDCCH_MAX_NOF_SLOTS_PER_FRAME - 1);
+  }
+
+  const TypedArray<double> in_nof_candidates = in_ss["NumCandidates"];
+  if (in_nof_candidates.getNumberOfElements() != PDCCH_NOF_AGGREGATION_LEVELS) {
+    mex_abort("Field 'NumCandidates' must have {} entries, provided {}.",
+              PDCCH_NOF_AGGREGATION_LEVELS,
+              in_nof_candidates.getNumberOfElements());
+  }
+
+  // The terms that do not depend on the UE are computed once for each aggregation level.
+  std::vector<pdcch_candidate_calculator> calculators;
+  for (unsigned i_al = 0; i_al != PDCCH_NOF_AGGREGATION_LEVELS; ++i_al) {
+    unsigned L              = PDCCH_AGGREGATION_LEVELS[i_al];
+    unsigned nof_candidates = static_cast<unsigned>(in_nof_candidates[i_al]);
+    if (nof_candidates > PDCCH_MAX_NOF_CANDIDATES) {
+      mex_abort("Aggregation level {} has {} candidates, exceeding the maximum of {}.",
+                L,
+                nof_candidates,
+                PDCCH_MAX_NOF_CANDIDATES);
+    }
+    if ((nof_candidates != 0) && (nof_cce < L)) {
+      mex_abort("Aggregation level {} does not fit a CORESET of {} CCEs.", L, nof_cce);
+    }
+    calculators.emplace_back(nof_cce, L, nof_candidates);
+  }
+
+  // Compute the hashing value of each UE once, since it is shared by all aggregation levels.
+  const TypedArray<double> in_rntis = inputs[2];
+  unsigned                 nof_ue   = in_rntis.getNumberOfElements();
+  std::vector<unsigned>    hashing_values(nof_ue, 0);
+  if (!is_common) {
+    for (unsigned i_ue = 0; i_ue != nof_ue; ++i_ue) {
+      hashing_values[i_ue] = pdcch_ue_hashing_value(coreset_id, static_cast<unsigned>(in_rntis[i_ue]), slot_index);
+    }
+  }
+
+  CellArray out = factory.createCellArray({1, PDCCH_NOF_AGGREGATION_LEVELS});
+  for (unsigned i_al = 0; i_al != PDCCH_NOF_AGGREGATION_LEVELS; ++i_al) {
+    const pdcch_candidate_calculator& calculator     = calculators[i_al];
+    unsigned                          nof_candidates = calculator.get_nof_candidates();
+
+    TypedArray<uint32_t> out_candidates = factory.createArray<uint32_t>({nof_candidates, nof_ue});
+    if (!out_candidates.isEmpty()) {
+      span<uint32_t> candidates = to_span(out_candidates);
+      for (unsigned i_ue = 0; i_ue != nof_ue; ++i_ue) {
+        calculator.get_candidates(candidates.subspan(i_ue * nof_candidates, nof_candidates), hashing_values[i_ue]);
+      }
+    }
+    out[i_al] = out_candidates;
+  }
+
+  outputs[0] = out;
+}
@@ -0,0 +1,166 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief PDCCH processor MEX declaration.
+
+#pragma once
+
+#include "srsran_matlab/srsran_mex_dispatcher.h"
+#include "srsran/phy/generic_functions/precoding/precoding_factories.h"
+#include "srsran/phy/support/resource_grid.h"
+#include "srsran/phy/support/support_factories.h"
+#include "srsran/phy/upper/channel_coding/channel_coding_factories.h"
+#include "srsran/phy/upper/channel_modulation/channel_modulation_factories.h"
+#include "srsran/phy/upper/channel_processors/pdcch/factories.h"
+#include "srsran/phy/upper/channel_processors/pdcch/pdcch_processor.h"
+#include "srsran/phy/upper/sequence_generators/sequence_generator_factories.h"
+#include "srsran/phy/upper/signal_processors/signal_processor_factories.h"
+#include <memory>
+#include <vector>
+
+/// Factory method for the PDCCH processor factory.
+inline std::shared_ptr<srsran::pdcch_processor_factory> create_pdcch_processor_factory();
+
+/// \brief Implements a PDCCH processor following the srsran_mex_dispatcher template.
+///
+/// The MEX encodes, modulates and maps multiple DCI messages into a single resource grid. The messages are processed
+/// in parallel by a pool of worker threads, each one with its own srsRAN PDCCH processor and its own resource grid, and
+/// the resulting grids are combined at the end. The MEX also computes the PDCCH candidates of a search space for a list
+/// of UEs with one call.
+class MexFunction : public srsran_mex_dispatcher
+{
+public:
+  /// Constructor: creates the PDCCH processor factory and the callback methods.
+  MexFunction()
+  {
+    // Ensure srsRAN PDCCH processor factory and validator were created successfully.
+    if (!processor_factory) {
+      mex_abort("Cannot create srsRAN PDCCH processor factory.");
+    }
+    if (!validator) {
+      mex_abort("Cannot create srsRAN PDCCH PDU validator.");
+    }
+
+    create_callback("new", [this](ArgumentList out, ArgumentList in) { this->method_new(out, in); });
+    create_callback("step", [this](ArgumentList out, ArgumentList in) { this->method_step(out, in); });
+    create_callback("candidates", [this](ArgumentList out, ArgumentList in) { this->method_candidates(out, in); });
+  }
+
+private:
+  /// Checks that outputs/inputs arguments match the requirements of method_step().
+  void check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Creates the pool of PDCCH processors.
+  ///
+  /// The method accepts two inputs.
+  ///   - The string <tt>"new"</tt>.
+  ///   - The number of worker threads (set it to zero to use as many workers as hardware threads).
+  ///
+  /// The method has no output.
+  void method_new(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Encodes, modulates and maps a list of DCI messages into a resource grid.
+  ///
+  /// The method takes four inputs.
+  ///   - The string <tt>"step"</tt>.
+  ///   - A one-dimensional structure describing the resource grid, with fields
+  ///      - \c NSizeGrid, number of resource blocks of the resource grid (the grid starts at CRB 0);
+  ///      - \c CyclicPrefix, cyclic prefix (<tt>"normal"</tt> or <tt>"extended"</tt>);
+  ///      - \c NumPorts, number of antenna ports of the resource grid (the DCI messages are mapped onto port 0).
+  ///   - A cell array with the DCI payloads (unpacked bits, \c uint8_t), one for each DCI message.
+  ///   - A structure array with one entry for each DCI message. The fields are
+  ///      - \c SubcarrierSpacing, subcarrier spacing in kHz;
+  ///      - \c NSlot, slot number within the frame;
+  ///      - \c NSizeBWP, number of resource blocks of the bandwidth part;
+  ///      - \c NStartBWP, first resource block of the bandwidth part, relative to CRB 0;
+  ///      - \c StartSymbolIndex, first OFDM symbol of the CORESET within the slot;
+  ///      - \c Duration, number of OFDM symbols of the CORESET;
+  ///      - \c FrequencyResources, boolean mask of the groups of six resource blocks allocated to the CORESET;
+  ///      - \c CCEREGMapping, CCE-to-REG mapping (<tt>"interleaved"</tt> or <tt>"noninterleaved"</tt>);
+  ///      - \c REGBundleSize, REG bundle size (only for interleaved mapping);
+  ///      - \c InterleaverSize, interleaver size (only for interleaved mapping);
+  ///      - \c ShiftIndex, interleaver shift index (only for interleaved mapping);
+  ///      - \c RNTI, radio network temporary identifier used to mask the CRC;
+  ///      - \c NIDDMRS, DM-RS scrambling identifier;
+  ///      - \c NIDData, data scrambling identifier;
+  ///      - \c NRNTI, RNTI used for data scrambling;
+  ///      - \c CCEIndex, lowest CCE index of the PDCCH candidate;
+  ///      - \c AggregationLevel, aggregation level of the PDCCH candidate;
+  ///      - \c DMRSPowerOffset, DM-RS power offset in dB;
+  ///      - \c DataPowerOffset, data power offset in dB.
+  ///
+  /// The method has one single output.
+  ///   - A three-dimensional array of \c cf_t with the transmit resource grid (dimensions are subcarriers, OFDM
+  ///     symbols and antenna ports).
+  void method_step(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Computes the PDCCH candidates of a search space for a list of UEs.
+  ///
+  /// The method takes three inputs.
+  ///   - The string <tt>"candidates"</tt>.
+  ///   - A one-dimensional structure describing the search space, with fields
+  ///      - \c NumCCEs, number of CCEs of the CORESET;
+  ///      - \c NumCandidates, array with the number of candidates for aggregation levels 1, 2, 4, 8 and 16;
+  ///      - \c SearchSpaceType, search space type (<tt>"common"</tt> or <tt>"ue"</tt>);
+  ///      - \c CORESETID, CORESET identifier;
+  ///      - \c NSlot, slot number within the frame.
+  ///   - An array of RNTIs, one for each UE.
+  ///
+  /// The method has one single output.
+  ///   - A cell array with one entry for each aggregation level. Each entry is an array of \c uint32_t with the lowest
+  ///     CCE index of the candidates (dimensions are candidates and UEs).
+  void method_candidates(ArgumentList outputs, ArgumentList inputs);
+
+  /// PDCCH processor factory.
+  std::shared_ptr<srsran::pdcch_processor_factory> processor_factory = create_pdcch_processor_factory();
+  /// PDCCH PDU validator.
+  std::unique_ptr<srsran::pdcch_pdu_validator> validator =
+      processor_factory ? processor_factory->create_validator() : nullptr;
+  /// Pool of PDCCH processors, one for each worker thread.
+  std::vector<std::unique_ptr<srsran::pdcch_processor>> processors;
+};
+
+std::shared_ptr<srsran::pdcch_processor_factory> create_pdcch_processor_factory()
+{
+  using namespace srsran;
+
+  std::shared_ptr<crc_calculator_factory> crc_factory = create_crc_calculator_factory_sw("auto");
+
+  std::shared_ptr<polar_factory> polar_factory = create_polar_factory_sw();
+
+  std::shared_ptr<pdcch_encoder_factory> encoder_factory = create_pdcch_encoder_factory_sw(crc_factory, polar_factory);
+
+  std::shared_ptr<modulation_mapper_factory> mapper_factory = create_modulation_mapper_factory();
+
+  std::shared_ptr<pseudo_random_generator_factory> prg_factory = create_pseudo_random_generator_sw_factory();
+
+  std::shared_ptr<channel_precoder_factory> precoder_factory = create_channel_precoder_factory("auto");
+
+  std::shared_ptr<resource_grid_mapper_factory> rg_mapper_factory =
+      create_resource_grid_mapper_factory(precoder_factory);
+
+  std::shared_ptr<pdcch_modulator_factory> modulator_factory =
+      create_pdcch_modulator_factory_sw(mapper_factory, prg_factory, rg_mapper_factory);
+
+  std::shared_ptr<dmrs_pdcch_processor_factory> dmrs_factory =
+      create_dmrs_pdcch_processor_factory_sw(prg_factory, rg_mapper_factory);
+
+  return create_pdcch_processor_factory_sw(encoder_factory, modulator_factory, dmrs_factory);
+}
@@ -0,0 +1,250 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief PDSCH processor MEX definition.
+
+#include "pdsch_processor_mex.h"
+#include "srsran_matlab/support/factory_functions.h"
+#include "srsran_matlab/support/matlab_to_srs.h"
+#include "srsran_matlab/support/parallel_for.h"
+#include "srsran_matlab/support/resource_grid.h"
+#include "srsran_matlab/support/to_span.h"
+#include "srsran/phy/support/resource_grid_reader.h"
+#include "srsran/phy/support/resource_grid_writer.h"
+#include "srsran/ran/precoding/precoding_codebooks.h"
+#include "srsran/ran/slot_point.h"
+#include "srsran/srsvec/conversion.h"
+#include <stdexcept>
+
+using matlab::mex::ArgumentList;
+using namespace matlab::data;
+using namespace srsran;
+using namespace srsran_matlab;
+
+namespace {
+
+/// PDSCH processor notifier that records the completion of the processing.
+class pdsch_processor_notifier_flag : public pdsch_processor_notifier
+{
+public:
+  // See interface for documentation.
+  void on_finish_processing() override { finished = true; }
+
+  /// Returns true if the processing has finished.
+  bool has_finished() const { return finished; }
+
+private:
+  /// Processing completion flag.
+  bool finished = false;
+};
+
+} // namespace
+
+void MexFunction::method_new(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 2;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::DOUBLE) || (inputs[1].getNumberOfElements() != 1)) {
+    mex_abort("Input 'nofWorkers' should be a scalar double.");
+  }
+  unsigned nof_workers = static_cast<unsigned>(static_cast<TypedArray<double>>(inputs[1])[0]);
+  if (nof_workers == 0) {
+    nof_workers = default_nof_workers();
+  }
+
+  if (!outputs.empty()) {
+    mex_abort("Wrong number of outputs: expected 0, provided {}.", outputs.size());
+  }
+
+  processors.clear();
+  for (unsigned i_worker = 0; i_worker != nof_workers; ++i_worker) {
+    processors.emplace_back(processor_factory->create());
+
+    // Ensure the processor was created properly.
+    if (!processors.back()) {
+      mex_abort("Cannot create srsRAN PDSCH processor.");
+    }
+  }
+}
+
+void MexFunction::check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 4;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::STRUCT) || (inputs[1].getNumberOfElements() > 1)) {
+    mex_abort("Input 'gridConfig' must be a scalar structure.");
+  }
+
+  if (inputs[2].getType() != ArrayType::CELL) {
+    mex_abort("Input 'transportBlocks' must be a cell array.");
+  }
+
+  if ((inputs[3].getType() != ArrayType::STRUCT) ||
+      (inputs[3].getNumberOfElements() != inputs[2].getNumberOfElements())) {
+    mex_abort("Input 'PDSCHConfigs' must be a structure array with one entry for each transport block.");
+  }
+
+  constexpr unsigned NOF_OUTPUTS = 1;
+  if (outputs.size() != NOF_OUTPUTS) {
+    mex_abort("Wrong number of outputs: expected {}, provided {}.", NOF_OUTPUTS, outputs.size());
+  }
+}
+
+void MexFunction::method_step(ArgumentList outputs, ArgumentList inputs)
+{
+  // Ensure the processors are initialized.
+  if (processors.empty()) {
+    mex_abort("The srsRAN PDSCH processors were not initialized properly.");
+  }
+
+  check_step_outputs_inputs(outputs, inputs);
+
+  // Resource grid dimensions.
+  StructArray     in_grid_array   = inputs[1];
+  const Struct    in_grid         = in_grid_array[0];
+  unsigned        nof_grid_rb     = in_grid["NSizeGrid"][0];
+  const CharArray in_grid_cp      = in_grid["CyclicPrefix"];
+  cyclic_prefix   grid_cp         = matlab_to_srs_cyclic_prefix(in_grid_cp.toAscii());
+  unsigned        nof_symbols     = get_nsymb_per_slot(grid_cp);
+  unsigned        nof_ports       = in_grid["NumPorts"][0];
+  unsigned        nof_subcarriers = nof_grid_rb * NRE;
+
+  // Build all the PDUs in the calling thread, since the MATLAB API is not thread-safe.
+  const CellArray                     in_tb_array  = inputs[2];
+  const StructArray                   in_pdu_array = inputs[3];
+  unsigned                            nof_pdsch    = in_pdu_array.getNumberOfElements();
+  std::vector<TypedArray<uint8_t>>    transport_blocks;
+  std::vector<span<const uint8_t>>    transport_block_views;
+  std::vector<pdsch_processor::pdu_t> pdus(nof_pdsch);
+  transport_blocks.reserve(nof_pdsch);
+  for (unsigned i_pdsch = 0; i_pdsch != nof_pdsch; ++i_pdsch) {
+    if (in_tb_array[i_pdsch].getType() != ArrayType::UINT8) {
+      mex_abort("Transport block {} must be an array of uint8_t.", i_pdsch);
+    }
+    const TypedArray<uint8_t>& in_tb = transport_blocks.emplace_back(in_tb_array[i_pdsch]);
+    transport_block_views.push_back(to_span(in_tb));
+
+    const Struct            in_cfg = in_pdu_array[i_pdsch];
+    pdsch_processor::pdu_t& pdu    = pdus[i_pdsch];
+
+    pdu.slot = slot_point(to_numerology_value(matlab_to_srs_subcarrier_spacing(in_cfg["SubcarrierSpacing"][0])),
+                          static_cast<unsigned>(in_cfg["NSlot"][0]));
+    pdu.rnti         = in_cfg["RNTI"][0];
+    pdu.bwp_size_rb  = in_cfg["NSizeBWP"][0];
+    pdu.bwp_start_rb = in_cfg["NStartBWP"][0];
+    pdu.cp           = grid_cp;
+
+    const CharArray in_modulation = in_cfg["Modulation"];
+    pdu.codewords.push_back(
+        {matlab_to_srs_modulation(in_modulation.toAscii()), static_cast<unsigned>(in_cfg["RV"][0])});
+
+    pdu.n_id = in_cfg["NID"][0];
+
+    const CharArray   in_ref_point = in_cfg["DMRSReferencePoint"];
+    const std::string ref_point    = in_ref_point.toAscii();
+    if (ref_point == "CRB0") {
+      pdu.ref_point = pdsch_processor::pdu_t::CRB0;
+    } else if (ref_point == "PRB0") {
+      pdu.ref_point = pdsch_processor::pdu_t::PRB0;
+    } else {
+      mex_abort("Unknown DM-RS reference point {}.", ref_point);
+    }
+
+    const TypedArray<bool> in_dmrs_pos = in_cfg["DMRSSymbPos"];
+    pdu.dmrs_symbol_mask               = bounded_bitset<MAX_NSYMB_PER_SLOT>(in_dmrs_pos.cbegin(), in_dmrs_pos.cend());
+    pdu.dmrs                           = matlab_to_srs_dmrs_type(in_cfg["DMRSConfigType"][0]);
+    pdu.scrambling_id                  = in_cfg["NIDNSCID"][0];
+    pdu.n_scid                         = static_cast<bool>(static_cast<unsigned>(in_cfg["NSCID"][0]));
+    pdu.nof_cdm_groups_without_data    = in_cfg["NumCDMGroupsWithoutData"][0];
+    pdu.freq_alloc = rb_allocation::make_type1(static_cast<unsigned>(in_cfg["PRBStart"][0]),
+                                               static_cast<unsigned>(in_cfg["NumPRB"][0]));
+    pdu.start_symbol_index         = in_cfg["StartSymbolIndex"][0];
+    pdu.nof_symbols                = in_cfg["NumSymbols"][0];
+    pdu.ldpc_base_graph            = matlab_to_srs_base_graph(in_cfg["BGN"][0]);
+    pdu.tbs_lbrm                   = units::bytes(static_cast<unsigned>(in_cfg["TBSLBRM"][0]));
+    pdu.reserved                   = {};
+    pdu.ptrs                       = std::nullopt;
+    pdu.ratio_pdsch_dmrs_to_sss_dB = static_cast<float>(static_cast<double>(in_cfg["DMRSPowerOffset"][0]));
+    pdu.ratio_pdsch_data_to_sss_dB = static_cast<float>(static_cast<double>(in_cfg["DataPowerOffset"][0]));
+
+    unsigned nof_layers = in_cfg["NumLayers"][0];
+    if (nof_layers > nof_ports) {
+      mex_abort("PDSCH {} has {} layers but the grid only has {} ports.", i_pdsch, nof_layers, nof_ports);
+    }
+    pdu.precoding = precoding_configuration::make_wideband(make_identity(nof_layers));
+
+    error_type<std::string> validation = validator->is_valid(pdu);
+    if (!validation.has_value()) {
+      mex_abort("The PDSCH configuration {} is invalid: {}.", i_pdsch, validation.error());
+    }
+  }
+
+  // Each worker maps its PDSCH transmissions onto its own resource grid.
+  unsigned nof_workers = std::max(1U, std::min(nof_pdsch, static_cast<unsigned>(processors.size())));
+  std::vector<std::unique_ptr<resource_grid>> grids;
+  for (unsigned i_worker = 0; i_worker != nof_workers; ++i_worker) {
+    grids.emplace_back(create_resource_grid(nof_subcarriers, nof_symbols, nof_ports));
+    if (!grids.back()) {
+      mex_abort("Cannot create resource grid.");
+    }
+    grids.back()->set_all_zero();
+  }
+
+  try {
+    parallel_for(nof_pdsch, nof_workers, [&](unsigned i_pdsch, unsigned i_worker) {
+      static_vector<shared_transport_block, pdsch_processor::MAX_NOF_TRANSPORT_BLOCKS> data = {
+          shared_transport_block(transport_block_views[i_pdsch])};
+
+      pdsch_processor_notifier_flag notifier;
+      processors[i_worker]->process(grids[i_worker]->get_writer(), notifier, std::move(data), pdus[i_pdsch]);
+      if (!notifier.has_finished()) {
+        throw std::runtime_error("PDSCH processing did not finish.");
+      }
+    });
+  } catch (const std::exception& e) {
+    mex_abort("Cannot process the PDSCH transmissions: {}", e.what());
+  }
+
+  // Combine the grids of all workers. Since the PDSCH transmissions do not overlap, it suffices to add them.
+  TypedArray<cf_t> out_grid = factory.createArray<cf_t>({nof_subcarriers, nof_symbols, nof_ports});
+  write_resource_grid(out_grid, grids[0]->get_reader());
+  std::vector<cf_t> symbol_buffer(nof_subcarriers);
+  for (unsigned i_worker = 1; i_worker != nof_workers; ++i_worker) {
+    const resource_grid_reader& reader    = grids[i_worker]->get_reader();
+    span<cf_t>                  grid_view = to_span(out_grid);
+    for (unsigned i_port = 0; i_port != nof_ports; ++i_port) {
+      for (unsigned i_symbol = 0; i_symbol != nof_symbols; ++i_symbol) {
+        srsvec::convert(symbol_buffer, reader.get_view(i_port, i_symbol).first(nof_subcarriers));
+        for (unsigned i_subc = 0; i_subc != nof_subcarriers; ++i_subc) {
+          grid_view[i_subc] += symbol_buffer[i_subc];
+        }
+        grid_view = grid_view.last(grid_view.size() - nof_subcarriers);
+      }
+    }
+  }
+
+  outputs[0] = out_grid;
+}
@@ -0,0 +1,162 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief PDSCH processor MEX declaration.
+
+#pragma once
+
+#include "srsran_matlab/srsran_mex_dispatcher.h"
+#include "srsran/phy/generic_functions/precoding/precoding_factories.h"
+#include "srsran/phy/support/resource_grid.h"
+#include "srsran/phy/support/support_factories.h"
+#include "srsran/phy/upper/channel_coding/channel_coding_factories.h"
+#include "srsran/phy/upper/channel_modulation/channel_modulation_factories.h"
+#include "srsran/phy/upper/channel_processors/pdsch/factories.h"
+#include "srsran/phy/upper/channel_processors/pdsch/pdsch_processor.h"
+#include "srsran/phy/upper/sequence_generators/sequence_generator_factories.h"
+#include "srsran/phy/upper/signal_processors/signal_processor_factories.h"
+#include <memory>
+#include <vector>
+
+/// Factory method for the PDSCH processor factory.
+inline std::shared_ptr<srsran::pdsch_processor_factory> create_pdsch_processor_factory();
+
+/// \brief Implements a PDSCH processor following the srsran_mex_dispatcher template.
+///
+/// The MEX encodes, modulates and maps multiple PDSCH transmissions into a single resource grid. The transmissions are
+/// processed in parallel by a pool of worker threads, each one with its own srsRAN PDSCH processor and its own
+/// resource grid, and the resulting grids are combined at the end.
+class MexFunction : public srsran_mex_dispatcher
+{
+public:
+  /// Constructor: creates the PDSCH processor factory and the callback methods.
+  MexFunction()
+  {
+    // Ensure srsRAN PDSCH processor factory and validator were created successfully.
+    if (!processor_factory) {
+      mex_abort("Cannot create srsRAN PDSCH processor factory.");
+    }
+    if (!validator) {
+      mex_abort("Cannot create srsRAN PDSCH PDU validator.");
+    }
+
+    create_callback("new", [this](ArgumentList out, ArgumentList in) { this->method_new(out, in); });
+    create_callback("step", [this](ArgumentList out, ArgumentList in) { this->method_step(out, in); });
+  }
+
+private:
+  /// Checks that outputs/inputs arguments match the requirements of method_step().
+  void check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Creates the pool of PDSCH processors.
+  ///
+  /// The method accepts two inputs.
+  ///   - The string <tt>"new"</tt>.
+  ///   - The number of worker threads (set it to zero to use as many workers as hardware threads).
+  ///
+  /// The method has no output.
+  void method_new(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Encodes, modulates and maps a list of PDSCH transmissions into a resource grid.
+  ///
+  /// The method takes four inputs.
+  ///   - The string <tt>"step"</tt>.
+  ///   - A one-dimensional structure describing the resource grid, with fields
+  ///      - \c NSizeGrid, number of resource blocks of the resource grid (the grid starts at CRB 0);
+  ///      - \c CyclicPrefix, cyclic prefix (<tt>"normal"</tt> or <tt>"extended"</tt>);
+  ///      - \c NumPorts, number of antenna ports of the resource grid.
+  ///   - A cell array with the transport blocks (in packed format, \c uint8_t), one for each PDSCH transmission.
+  ///   - A structure array with one entry for each PDSCH transmission. The fields are
+  ///      - \c SubcarrierSpacing, subcarrier spacing in kHz;
+  ///      - \c NSlot, slot number within the frame;
+  ///      - \c RNTI, radio network temporary identifier;
+  ///      - \c NSizeBWP, number of resource blocks of the bandwidth part;
+  ///      - \c NStartBWP, first resource block of the bandwidth part, relative to CRB 0;
+  ///      - \c Modulation, modulation scheme used for transmission;
+  ///      - \c RV, the redundancy version;
+  ///      - \c NID, scrambling identifier;
+  ///      - \c DMRSReferencePoint, DM-RS subcarrier reference point (<tt>"CRB0"</tt> or <tt>"PRB0"</tt>);
+  ///      - \c DMRSSymbPos, boolean mask flagging the OFDM symbols containing DM-RS;
+  ///      - \c DMRSConfigType, DM-RS configuration type;
+  ///      - \c NIDNSCID, DM-RS scrambling identifier;
+  ///      - \c NSCID, DM-RS scrambling initialization;
+  ///      - \c NumCDMGroupsWithoutData, number of DM-RS CDM groups without data;
+  ///      - \c PRBStart, first allocated resource block, relative to the bandwidth part (contiguous allocation);
+  ///      - \c NumPRB, number of allocated resource blocks;
+  ///      - \c StartSymbolIndex, start symbol index of the time domain allocation within a slot;
+  ///      - \c NumSymbols, number of symbols of the time domain allocation within a slot;
+  ///      - \c BGN, the LDPC base graph;
+  ///      - \c TBSLBRM, transport block size for limited buffer rate matching, in bytes;
+  ///      - \c DMRSPowerOffset, DM-RS power offset in dB;
+  ///      - \c DataPowerOffset, data power offset in dB;
+  ///      - \c NumLayers, number of transmission layers (layer \f$i\f$ is mapped onto port \f$i\f$).
+  ///
+  /// The method has one single output.
+  ///   - A three-dimensional array of \c cf_t with the transmit resource grid (dimensions are subcarriers, OFDM
+  ///     symbols and antenna ports).
+  void method_step(ArgumentList outputs, ArgumentList inputs);
+
+  /// PDSCH processor factory.
+  std::shared_ptr<srsran::pdsch_processor_factory> processor_factory = create_pdsch_processor_factory();
+  /// PDSCH PDU validator.
+  std::unique_ptr<srsran::pdsch_pdu_validator> validator =
+      processor_factory ? processor_factory->create_validator() : nullptr;
+  /// Pool of PDSCH processors, one for each worker thread.
+  std::vector<std::unique_ptr<srsran::pdsch_processor>> processors;
+};
+
+std::shared_ptr<srsran::pdsch_processor_factory> create_pdsch_processor_factory()
+{
+  using namespace srsran;
+
+  std::shared_ptr<crc_calculator_factory> crc_factory = create_crc_calculator_factory_sw("auto");
+
+  std::shared_ptr<ldpc_encoder_factory> ldpc_encoder_factory = create_ldpc_encoder_factory_sw("auto");
+
+  std::shared_ptr<ldpc_rate_matcher_factory> ldpc_rate_matcher_factory = create_ldpc_rate_matcher_factory_sw();
+
+  std::shared_ptr<ldpc_segmenter_tx_factory> segmenter_tx_factory = create_ldpc_segmenter_tx_factory_sw(crc_factory);
+
+  pdsch_encoder_factory_sw_configuration encoder_config;
+  encoder_config.encoder_factory      = ldpc_encoder_factory;
+  encoder_config.rate_matcher_factory = ldpc_rate_matcher_factory;
+  encoder_config.segmenter_factory    = segmenter_tx_factory;
+  std::shared_ptr<pdsch_encoder_factory> encoder_factory = create_pdsch_encoder_factory_sw(encoder_config);
+
+  std::shared_ptr<modulation_mapper_factory> mapper_factory = create_modulation_mapper_factory();
+
+  std::shared_ptr<pseudo_random_generator_factory> prg_factory = create_pseudo_random_generator_sw_factory();
+
+  std::shared_ptr<channel_precoder_factory> precoder_factory = create_channel_precoder_factory("auto");
+
+  std::shared_ptr<resource_grid_mapper_factory> rg_mapper_factory =
+      create_resource_grid_mapper_factory(precoder_factory);
+
+  std::shared_ptr<pdsch_modulator_factory> modulator_factory =
+      create_pdsch_modulator_factory_sw(mapper_factory, prg_factory, rg_mapper_factory);
+
+  std::shared_ptr<dmrs_pdsch_processor_factory> dmrs_factory =
+      create_dmrs_pdsch_processor_factory_sw(prg_factory, rg_mapper_factory);
+
+  std::shared_ptr<ptrs_pdsch_generator_factory> ptrs_factory =
+      create_ptrs_pdsch_generator_generic_factory(prg_factory, rg_mapper_factory);
+
+  return create_pdsch_processor_factory_sw(encoder_factory, modulator_factory, dmrs_factory, ptrs_factory);
+}
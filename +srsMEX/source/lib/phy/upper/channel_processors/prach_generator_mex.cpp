@@ -0,0 +1,147 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief PRACH generator MEX definition.
+
+#include "prach_generator_mex.h"
+#include "srsran_matlab/support/matlab_to_srs.h"
+#include "srsran_matlab/support/to_span.h"
+#include "srsran/srsvec/copy.h"
+
+using matlab::mex::ArgumentList;
+using namespace matlab::data;
+using namespace srsran;
+using namespace srsran_matlab;
+
+void MexFunction::method_new(ArgumentList outputs, ArgumentList inputs)
+{
+  if (inputs.size() != 2) {
+    mex_abort("Wrong number of inputs: expected 2, provided {}.", inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::DOUBLE) || (inputs[1].getNumberOfElements() > 1)) {
+    mex_abort("Input 'cacheSize' must be a scalar double.");
+  }
+
+  if (!outputs.empty()) {
+    mex_abort("No outputs expected, provided {}.", outputs.size());
+  }
+
+  double cache_size = inputs[1][0];
+  if (cache_size < 1) {
+    mex_abort("The cache size must be positive, provided {}.", cache_size);
+  }
+
+  cache = std::make_unique<sequence_cache>(static_cast<unsigned>(cache_size));
+}
+
+void MexFunction::check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs)
+{
+  if (inputs.size() != 2) {
+    mex_abort("Wrong number of inputs: expected 2, provided {}.", inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::STRUCT) || (inputs[1].getNumberOfElements() == 0)) {
+    mex_abort("Input 'config' must be a non-empty structure array.");
+  }
+
+  if (outputs.size() != 1) {
+    mex_abort("Wrong number of outputs: expected 1, provided {}.", outputs.size());
+  }
+}
+
+const std::vector<cf_t>& MexFunction::get_sequence(const Struct& in_cfg)
+{
+  const CharArray in_format      = in_cfg["Format"];
+  const CharArray restricted_set = in_cfg["RestrictedSet"];
+
+  sequence_key key          = {};
+  key.format                = matlab_to_srs_preamble_format(in_format.toAscii());
+  key.root_sequence_index   = in_cfg["SequenceIndex"][0];
+  key.preamble_index        = in_cfg["PreambleIndex"][0];
+  key.restricted_set        = matlab_to_srs_restricted_set(restricted_set.toAscii());
+  key.zero_correlation_zone = in_cfg["ZeroCorrelationZone"][0];
+
+  if (const std::vector<cf_t>* cached = cache->find(key)) {
+    return *cached;
+  }
+
+  if (key.preamble_index > 63) {
+    mex_abort("Invalid preamble index {}.", key.preamble_index);
+  }
+
+  prach_generator::configuration config = {};
+  config.format                         = key.format;
+  config.root_sequence_index            = key.root_sequence_index;
+  config.preamble_index                 = key.preamble_index;
+  config.restricted_set                 = key.restricted_set;
+  config.zero_correlation_zone          = key.zero_correlation_zone;
+
+  span<const cf_t> sequence = generator->generate(config);
+  return cache->insert(key, std::vector<cf_t>(sequence.begin(), sequence.end()));
+}
+
+void MexFunction::method_step(ArgumentList outputs, ArgumentList inputs)
+{
+  check_step_outputs_inputs(outputs, inputs);
+
+  const StructArray in_cfg_array  = inputs[1];
+  unsigned          nof_sequences = in_cfg_array.getNumberOfElements();
+
+  // The first sequence determines the output dimensions. Each sequence is copied right after the lookup, since a later
+  // insertion may evict it from the cache.
+  const std::vector<cf_t>& first_sequence  = get_sequence(in_cfg_array[0]);
+  std::size_t              sequence_length = first_sequence.size();
+  TypedArray<cf_t>         out             = factory.createArray<cf_t>({sequence_length, nof_sequences});
+  span<cf_t>               out_view        = to_span(out);
+  srsvec::copy(out_view.first(sequence_length), first_sequence);
+
+  for (unsigned i_sequence = 1; i_sequence != nof_sequences; ++i_sequence) {
+    const std::vector<cf_t>& sequence = get_sequence(in_cfg_array[i_sequence]);
+    if (sequence.size() != sequence_length) {
+      mex_abort("All sequences must have the same length: entry {} has length {}, expected {}.",
+                i_sequence,
+                sequence.size(),
+                sequence_length);
+    }
+    srsvec::copy(out_view.subspan(i_sequence * sequence_length, sequence_length), sequence);
+  }
+
+  outputs[0] = out;
+}
+
+void MexFunction::method_stats(ArgumentList outputs, ArgumentList inputs)
+{
+  if (inputs.size() != 1) {
+    mex_abort("Wrong number of inputs: expected 1, provided {}.", inputs.size());
+  }
+
+  if (outputs.size() != 1) {
+    mex_abort("Wrong number of outputs: expected 1, provided {}.", outputs.size());
+  }
+
+  StructArray out     = factory.createStructArray({1, 1}, {"Size", "Capacity", "Hits", "Misses", "Evictions"});
+  out[0]["Size"]      = factory.createScalar(static_cast<double>(cache->size()));
+  out[0]["Capacity"]  = factory.createScalar(static_cast<double>(cache->get_capacity()));
+  out[0]["Hits"]      = factory.createScalar(static_cast<double>(cache->get_nof_hits()));
+  out[0]["Misses"]    = factory.createScalar(static_cast<double>(cache->get_nof_misses()));
+  out[0]["Evictions"] = factory.createScalar(static_cast<double>(cache->get_nof_evictions()));
+  outputs[0]          = out;
+}
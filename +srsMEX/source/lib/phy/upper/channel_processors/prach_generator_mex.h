@@ -0,0 +1,157 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief PRACH generator MEX declaration.
+
+#pragma once
+
+#include "srsran_matlab/srsran_mex_dispatcher.h"
+#include "srsran_matlab/support/lru_cache.h"
+#include "srsran/adt/complex.h"
+#include "srsran/phy/upper/channel_processors/channel_processor_factories.h"
+#include "srsran/phy/upper/channel_processors/prach_generator.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+/// Factory method for a PRACH sequence generator.
+inline std::unique_ptr<srsran::prach_generator> create_prach_generator();
+
+/// \brief Implements a PRACH sequence generator following the srsran_mex_dispatcher template.
+///
+/// Generated frequency-domain sequences are kept in a least-recently-used cache, so that repeated requests for the same
+/// preamble (e.g., across the trials of a simulation) do not recompute the Zadoff&ndash;Chu sequence.
+class MexFunction : public srsran_mex_dispatcher
+{
+public:
+  /// \brief Constructor.
+  ///
+  /// Stores the string identifier&ndash;method pairs that form the public interface of the PRACH generator MEX object.
+  MexFunction()
+  {
+    // Ensure the srsRAN PRACH generator was created successfully.
+    if (!generator) {
+      mex_abort("Cannot create srsRAN PRACH generator.");
+    }
+
+    create_callback("new", [this](ArgumentList out, ArgumentList in) { this->method_new(out, in); });
+    create_callback("step", [this](ArgumentList out, ArgumentList in) { this->method_step(out, in); });
+    create_callback("stats", [this](ArgumentList out, ArgumentList in) { this->method_stats(out, in); });
+  }
+
+private:
+  /// Identifies a PRACH sequence in the cache.
+  struct sequence_key {
+    /// Preamble format.
+    srsran::prach_format_type format;
+    /// Root sequence index.
+    unsigned root_sequence_index;
+    /// Preamble index.
+    unsigned preamble_index;
+    /// Restricted set configuration.
+    srsran::restricted_set_config restricted_set;
+    /// Zero-correlation zone configuration index.
+    unsigned zero_correlation_zone;
+
+    bool operator==(const sequence_key& other) const
+    {
+      return (format == other.format) && (root_sequence_index == other.root_sequence_index) &&
+             (preamble_index == other.preamble_index) && (restricted_set == other.restricted_set) &&
+             (zero_correlation_zone == other.zero_correlation_zone);
+    }
+  };
+
+  /// Hash function object for \c sequence_key.
+  struct sequence_key_hash {
+    std::size_t operator()(const sequence_key& key) const
+    {
+      // The root sequence index takes 10 bits, the preamble index 6 bits and the zero-correlation zone 4 bits.
+      std::size_t packed = static_cast<std::size_t>(key.root_sequence_index) |
+                           (static_cast<std::size_t>(key.preamble_index) << 10U) |
+                           (static_cast<std::size_t>(key.zero_correlation_zone) << 16U) |
+                           (static_cast<std::size_t>(key.restricted_set) << 20U) |
+                           (static_cast<std::size_t>(key.format) << 24U);
+      return std::hash<std::size_t>()(packed);
+    }
+  };
+
+  /// Cache of generated PRACH sequences.
+  using sequence_cache = srsran_matlab::lru_cache<sequence_key, std::vector<srsran::cf_t>, sequence_key_hash>;
+
+  /// Default number of cached sequences.
+  static constexpr unsigned DEFAULT_CACHE_SIZE = 1024;
+
+  /// \brief Creates a new sequence cache.
+  ///
+  /// The method takes two inputs.
+  ///   - The string <tt>"new"</tt>.
+  ///   - The maximum number of cached sequences.
+  ///
+  /// Any previously cached sequence is discarded.
+  void method_new(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Gets the PRACH sequence described by the given configuration.
+  ///
+  /// The sequence is generated and inserted in the cache if it is not there yet. The returned reference is valid until
+  /// the sequence is evicted from the cache.
+  const std::vector<srsran::cf_t>& get_sequence(const matlab::data::Struct& in_cfg);
+
+  /// Checks that outputs/inputs arguments match the requirements of method_step().
+  void check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Generates a batch of PRACH sequences.
+  ///
+  /// The method takes two inputs.
+  ///   - The string <tt>"step"</tt>.
+  ///   - A structure array with one entry per requested sequence. The fields are
+  ///      - \c Format, preamble format;
+  ///      - \c SequenceIndex, the root sequence index;
+  ///      - \c PreambleIndex, the preamble index;
+  ///      - \c RestrictedSet, restricted set configuration;
+  ///      - \c ZeroCorrelationZone, zero-correlation zone configuration index.
+  ///
+  /// The method has one single output.
+  ///   - A two-dimensional array of complex single-precision floats with the frequency-domain PRACH sequences, one per
+  ///     column. All requested sequences must have the same length.
+  void method_step(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Returns the cache statistics.
+  ///
+  /// The method takes one input, the string <tt>"stats"</tt>, and returns a scalar structure with fields \c Size,
+  /// \c Capacity, \c Hits, \c Misses and \c Evictions.
+  void method_stats(ArgumentList outputs, ArgumentList inputs);
+
+  /// A pointer to the actual PRACH generator.
+  std::unique_ptr<srsran::prach_generator> generator = create_prach_generator();
+  /// Cache of generated PRACH sequences.
+  std::unique_ptr<sequence_cache> cache = std::make_unique<sequence_cache>(DEFAULT_CACHE_SIZE);
+};
+
+std::unique_ptr<srsran::prach_generator> create_prach_generator()
+{
+  using namespace srsran;
+
+  std::shared_ptr<prach_generator_factory> generator_factory = create_prach_generator_factory_sw();
+  if (!generator_factory) {
+    return nullptr;
+  }
+
+  return generator_factory->create();
+}
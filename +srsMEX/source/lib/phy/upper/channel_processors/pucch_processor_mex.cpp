@@ -19,6 +19,7 @@
 
 #include "pucch_processor_mex.h"
 #include "srsran_matlab/support/matlab_to_srs.h"
+#include "srsran_matlab/support/pucch_processor_helpers.h"
 #include "srsran_matlab/support/resource_grid.h"
 #include "srsran/phy/support/resource_grid_writer.h"
 #include <optional>
@@ -69,297 +70,12 @@ TypedArray<int8_t> MexFunction::fill_message_fields(span<const uint8_t> field)
   return out;
 }
 
-static pucch_processor::format0_configuration populate_f0_configuration(const Struct& in_cfg)
-{
-  // Create a PUCCH F0 configuration object.
-  pucch_processor::format0_configuration cfg = {};
-
-  cfg.context = std::nullopt;
-
-  // Set the slot point.
-  unsigned scs_kHz    = in_cfg["SubcarrierSpacing"][0];
-  unsigned slot_count = in_cfg["NSlot"][0];
-  cfg.slot            = {matlab_to_srs_subcarrier_spacing(scs_kHz), slot_count};
-
-  // Set the cyclic prefix.
-  const CharArray in_cp = in_cfg["CP"];
-  cfg.cp                = matlab_to_srs_cyclic_prefix(in_cp.toAscii());
-
-  // Set the port indices.
-  unsigned nof_ports = in_cfg["NRxPorts"][0];
-  cfg.ports.clear();
-  for (unsigned i_port = 0; i_port != nof_ports; ++i_port) {
-    cfg.ports.push_back(i_port);
-  }
-
-  // Set the BWP.
-  cfg.bwp_size_rb  = static_cast<unsigned>(in_cfg["NSizeBWP"][0]);
-  cfg.bwp_start_rb = static_cast<unsigned>(in_cfg["NStartBWP"][0]);
-
-  // Set the frequency allocation.
-  cfg.starting_prb   = static_cast<unsigned>(in_cfg["StartPRB"][0]);
-  cfg.second_hop_prb = std::nullopt;
-  if (!in_cfg["SecondHopStartPRB"].isEmpty()) {
-    cfg.second_hop_prb = static_cast<unsigned>(in_cfg["SecondHopStartPRB"][0]);
-  }
-
-  // Set the time allocation.
-  cfg.start_symbol_index = static_cast<unsigned>(in_cfg["StartSymbolIndex"][0]);
-  cfg.nof_symbols        = static_cast<unsigned>(in_cfg["NumOFDMSymbols"][0]);
-
-  // Set the initial cyclic shift.
-  cfg.initial_cyclic_shift = static_cast<unsigned>(in_cfg["InitialCyclicShift"][0]);
-
-  // Set the scrambling identifier.
-  cfg.n_id = static_cast<unsigned>(in_cfg["NID"][0]);
-
-  // Set the lengths of UCI fields.
-  cfg.nof_harq_ack = static_cast<unsigned>(in_cfg["NumHARQAck"][0]);
-
-  // Set the SR opportunity.
-  cfg.sr_opportunity = (static_cast<unsigned>(in_cfg["NumSR"][0]) == 1);
-
-  return cfg;
-}
-
-static pucch_processor::format1_configuration populate_f1_configuration(const Struct& in_cfg)
-{
-  // Create a PUCCH F1 configuration object.
-  pucch_processor::format1_configuration cfg = {};
-
-  cfg.context = std::nullopt;
-
-  // Set the slot point.
-  unsigned scs_kHz    = in_cfg["SubcarrierSpacing"][0];
-  unsigned slot_count = in_cfg["NSlot"][0];
-  cfg.slot            = {matlab_to_srs_subcarrier_spacing(scs_kHz), slot_count};
-
-  // Set the cyclic prefix.
-  const CharArray in_cp = in_cfg["CP"];
-  cfg.cp                = matlab_to_srs_cyclic_prefix(in_cp.toAscii());
-
-  // Set the port indices.
-  unsigned nof_ports = in_cfg["NRxPorts"][0];
-  cfg.ports.clear();
-  for (unsigned i_port = 0; i_port != nof_ports; ++i_port) {
-    cfg.ports.push_back(i_port);
-  }
-
-  // Set the BWP.
-  cfg.bwp_size_rb  = static_cast<unsigned>(in_cfg["NSizeBWP"][0]);
-  cfg.bwp_start_rb = static_cast<unsigned>(in_cfg["NStartBWP"][0]);
-
-  // Set the frequency allocation.
-  cfg.starting_prb   = static_cast<unsigned>(in_cfg["StartPRB"][0]);
-  cfg.second_hop_prb = std::nullopt;
-  if (!in_cfg["SecondHopStartPRB"].isEmpty()) {
-    cfg.second_hop_prb = static_cast<unsigned>(in_cfg["SecondHopStartPRB"][0]);
-  }
-
-  // Set the time allocation.
-  cfg.start_symbol_index = static_cast<unsigned>(in_cfg["StartSymbolIndex"][0]);
-  cfg.nof_symbols        = static_cast<unsigned>(in_cfg["NumOFDMSymbols"][0]);
-
-  // Set the scrambling identifier.
-  cfg.n_id = static_cast<unsigned>(in_cfg["NID"][0]);
-
-  // Set the lengths of UCI fields.
-  cfg.nof_harq_ack = static_cast<unsigned>(in_cfg["NumHARQAck"][0]);
-
-  // Set the initial cyclic shift.
-  cfg.initial_cyclic_shift = static_cast<unsigned>(in_cfg["InitialCyclicShift"][0]);
-
-  // Set the time domain orthogonal cyclic code.
-  cfg.time_domain_occ = static_cast<unsigned>(in_cfg["OCCI"][0]);
-
-  return cfg;
-}
-
-static pucch_processor::format2_configuration populate_f2_configuration(const Struct& in_cfg)
-{
-  // Create a PUCCH F2 configuration object.
-  pucch_processor::format2_configuration cfg = {};
-
-  cfg.context = std::nullopt;
-
-  // Set the slot point.
-  unsigned scs_kHz    = in_cfg["SubcarrierSpacing"][0];
-  unsigned slot_count = in_cfg["NSlot"][0];
-  cfg.slot            = {matlab_to_srs_subcarrier_spacing(scs_kHz), slot_count};
-
-  // Set the cyclic prefix.
-  const CharArray in_cp = in_cfg["CP"];
-  cfg.cp                = matlab_to_srs_cyclic_prefix(in_cp.toAscii());
-
-  // Set the port indices.
-  unsigned nof_ports = in_cfg["NRxPorts"][0];
-  cfg.ports.clear();
-  for (unsigned i_port = 0; i_port != nof_ports; ++i_port) {
-    cfg.ports.push_back(i_port);
-  }
-
-  // Set the BWP.
-  cfg.bwp_size_rb  = static_cast<unsigned>(in_cfg["NSizeBWP"][0]);
-  cfg.bwp_start_rb = static_cast<unsigned>(in_cfg["NStartBWP"][0]);
-
-  // Set the frequency allocation.
-  cfg.starting_prb   = static_cast<unsigned>(in_cfg["StartPRB"][0]);
-  cfg.nof_prb        = static_cast<unsigned>(in_cfg["NumPRBs"][0]);
-  cfg.second_hop_prb = std::nullopt;
-  if (!in_cfg["SecondHopStartPRB"].isEmpty()) {
-    cfg.second_hop_prb = static_cast<unsigned>(in_cfg["SecondHopStartPRB"][0]);
-  }
-
-  // Set the time allocation.
-  cfg.start_symbol_index = static_cast<unsigned>(in_cfg["StartSymbolIndex"][0]);
-  cfg.nof_symbols        = static_cast<unsigned>(in_cfg["NumOFDMSymbols"][0]);
-
-  // Set the RNTI.
-  cfg.rnti = static_cast<unsigned>(in_cfg["RNTI"][0]);
-
-  // Set the scrambling identifier.
-  cfg.n_id = static_cast<unsigned>(in_cfg["NID"][0]);
-
-  // Set the DM-RS scrambling identifier.
-  cfg.n_id_0 = static_cast<unsigned>(in_cfg["NID0"][0]);
-
-  // Set the lengths of UCI fields.
-  cfg.nof_harq_ack  = static_cast<unsigned>(in_cfg["NumHARQAck"][0]);
-  cfg.nof_sr        = static_cast<unsigned>(in_cfg["NumSR"][0]);
-  cfg.nof_csi_part1 = static_cast<unsigned>(in_cfg["NumCSIPart1"][0]);
-  cfg.nof_csi_part2 = static_cast<unsigned>(in_cfg["NumCSIPart2"][0]);
-
-  return cfg;
-}
-
-static pucch_processor::format3_configuration populate_f3_configuration(const Struct& in_cfg)
-{
-  // Create a PUCCH F3 configuration object.
-  pucch_processor::format3_configuration cfg = {};
-
-  cfg.context = std::nullopt;
-
-  // Set the slot point.
-  unsigned scs_kHz    = in_cfg["SubcarrierSpacing"][0];
-  unsigned slot_count = in_cfg["NSlot"][0];
-  cfg.slot            = {matlab_to_srs_subcarrier_spacing(scs_kHz), slot_count};
-
-  // Set the cyclic prefix.
-  const CharArray in_cp = in_cfg["CP"];
-  cfg.cp                = matlab_to_srs_cyclic_prefix(in_cp.toAscii());
-
-  // Set the port indices.
-  unsigned nof_ports = in_cfg["NRxPorts"][0];
-  cfg.ports.clear();
-  for (unsigned i_port = 0; i_port != nof_ports; ++i_port) {
-    cfg.ports.push_back(i_port);
-  }
-
-  // Set the BWP.
-  cfg.bwp_size_rb  = static_cast<unsigned>(in_cfg["NSizeBWP"][0]);
-  cfg.bwp_start_rb = static_cast<unsigned>(in_cfg["NStartBWP"][0]);
-
-  // Set the frequency allocation.
-  cfg.starting_prb   = static_cast<unsigned>(in_cfg["StartPRB"][0]);
-  cfg.nof_prb        = static_cast<unsigned>(in_cfg["NumPRBs"][0]);
-  cfg.second_hop_prb = std::nullopt;
-  if (!in_cfg["SecondHopStartPRB"].isEmpty()) {
-    cfg.second_hop_prb = static_cast<unsigned>(in_cfg["SecondHopStartPRB"][0]);
-  }
-
-  // Set the time allocation.
-  cfg.start_symbol_index = static_cast<unsigned>(in_cfg["StartSymbolIndex"][0]);
-  cfg.nof_symbols        = static_cast<unsigned>(in_cfg["NumOFDMSymbols"][0]);
-
-  // Set the RNTI.
-  cfg.rnti = static_cast<unsigned>(in_cfg["RNTI"][0]);
-
-  // Set the hopping identifier.
-  cfg.n_id_hopping = static_cast<unsigned>(in_cfg["NIDHopping"][0]);
-
-  // Set the scrambling identifier.
-  cfg.n_id_scrambling = static_cast<unsigned>(in_cfg["NIDScrambling"][0]);
-
-  cfg.additional_dmrs = static_cast<bool>(in_cfg["AdditionalDMRS"][0]);
-  cfg.pi2_bpsk        = static_cast<bool>(in_cfg["Pi2BPSK"][0]);
-
-  // Set the lengths of UCI fields.
-  cfg.nof_harq_ack  = static_cast<unsigned>(in_cfg["NumHARQAck"][0]);
-  cfg.nof_sr        = static_cast<unsigned>(in_cfg["NumSR"][0]);
-  cfg.nof_csi_part1 = static_cast<unsigned>(in_cfg["NumCSIPart1"][0]);
-  cfg.nof_csi_part2 = static_cast<unsigned>(in_cfg["NumCSIPart2"][0]);
-
-  return cfg;
-}
-
-static pucch_processor::format4_configuration populate_f4_configuration(const Struct& in_cfg)
-{
-  // Create a PUCCH F4 configuration object.
-  pucch_processor::format4_configuration cfg = {};
-
-  cfg.context = std::nullopt;
-
-  // Set the slot point.
-  unsigned scs_kHz    = in_cfg["SubcarrierSpacing"][0];
-  unsigned slot_count = in_cfg["NSlot"][0];
-  cfg.slot            = {matlab_to_srs_subcarrier_spacing(scs_kHz), slot_count};
-
-  // Set the cyclic prefix.
-  const CharArray in_cp = in_cfg["CP"];
-  cfg.cp                = matlab_to_srs_cyclic_prefix(in_cp.toAscii());
-
-  // Set the port indices.
-  unsigned nof_ports = in_cfg["NRxPorts"][0];
-  cfg.ports.clear();
-  for (unsigned i_port = 0; i_port != nof_ports; ++i_port) {
-    cfg.ports.push_back(i_port);
-  }
-
-  // Set the BWP.
-  cfg.bwp_size_rb  = static_cast<unsigned>(in_cfg["NSizeBWP"][0]);
-  cfg.bwp_start_rb = static_cast<unsigned>(in_cfg["NStartBWP"][0]);
-
-  // Set the frequency allocation.
-  cfg.starting_prb   = static_cast<unsigned>(in_cfg["StartPRB"][0]);
-  cfg.second_hop_prb = std::nullopt;
-  if (!in_cfg["SecondHopStartPRB"].isEmpty()) {
-    cfg.second_hop_prb = static_cast<unsigned>(in_cfg["SecondHopStartPRB"][0]);
-  }
-
-  // Set the time allocation.
-  cfg.start_symbol_index = static_cast<unsigned>(in_cfg["StartSymbolIndex"][0]);
-  cfg.nof_symbols        = static_cast<unsigned>(in_cfg["NumOFDMSymbols"][0]);
-
-  // Set the RNTI.
-  cfg.rnti = static_cast<unsigned>(in_cfg["RNTI"][0]);
-
-  // Set the hopping identifier.
-  cfg.n_id_hopping = static_cast<unsigned>(in_cfg["NIDHopping"][0]);
-
-  // Set the scrambling identifier.
-  cfg.n_id_scrambling = static_cast<unsigned>(in_cfg["NIDScrambling"][0]);
-
-  cfg.additional_dmrs = static_cast<bool>(in_cfg["AdditionalDMRS"][0]);
-  cfg.pi2_bpsk        = static_cast<bool>(in_cfg["Pi2BPSK"][0]);
-
-  cfg.occ_index  = static_cast<unsigned>(in_cfg["OCCI"][0]);
-  cfg.occ_length = static_cast<unsigned>(in_cfg["SpreadingFactor"][0]);
-
-  // Set the lengths of UCI fields.
-  cfg.nof_harq_ack  = static_cast<unsigned>(in_cfg["NumHARQAck"][0]);
-  cfg.nof_sr        = static_cast<unsigned>(in_cfg["NumSR"][0]);
-  cfg.nof_csi_part1 = static_cast<unsigned>(in_cfg["NumCSIPart1"][0]);
-  cfg.nof_csi_part2 = static_cast<unsigned>(in_cfg["NumCSIPart2"][0]);
-
-  return cfg;
-}
-
 StructArray
 MexFunction::call_processor(const resource_grid_reader& grid_reader, const Struct& in_cfg, const StructArray& mux_f1)
 {
   unsigned pucch_format = in_cfg["Format"][0];
   if ((pucch_format == 1) && !mux_f1.isEmpty()) {
-    pucch_processor::format1_configuration       cfg = populate_f1_configuration(in_cfg);
+    pucch_processor::format1_configuration       cfg = populate_pucch_f1_configuration(in_cfg);
     pucch_processor::format1_batch_configuration batch_config(cfg);
     batch_config.entries.clear();
 
@@ -428,7 +144,7 @@ MexFunction::call_processor(const resource_grid_reader& grid_reader, const Struc
         mex_abort("For PUCCH Format 0 the number of SR bits is at most one, given {}.", nof_sr);
       }
 
-      const pucch_processor::format0_configuration cfg = populate_f0_configuration(in_cfg);
+      const pucch_processor::format0_configuration cfg = populate_pucch_f0_configuration(in_cfg);
 
       // Ensure the provided configuration is valid.
       error_type<std::string> validation = validator->is_valid(cfg);
@@ -441,7 +157,7 @@ MexFunction::call_processor(const resource_grid_reader& grid_reader, const Struc
       break;
     }
     case 1: {
-      const pucch_processor::format1_configuration cfg = populate_f1_configuration(in_cfg);
+      const pucch_processor::format1_configuration cfg = populate_pucch_f1_configuration(in_cfg);
 
       // Ensure the provided configuration is valid.
       error_type<std::string> validation = validator->is_valid(cfg);
@@ -456,7 +172,7 @@ MexFunction::call_processor(const resource_grid_reader& grid_reader, const Struc
       break;
     }
     case 2: {
-      const pucch_processor::format2_configuration cfg = populate_f2_configuration(in_cfg);
+      const pucch_processor::format2_configuration cfg = populate_pucch_f2_configuration(in_cfg);
 
       // Ensure the provided configuration is valid.
       error_type<std::string> validation = validator->is_valid(cfg);
@@ -469,7 +185,7 @@ MexFunction::call_processor(const resource_grid_reader& grid_reader, const Struc
       break;
     }
     case 3: {
-      const pucch_processor::format3_configuration cfg = populate_f3_configuration(in_cfg);
+      const pucch_processor::format3_configuration cfg = populate_pucch_f3_configuration(in_cfg);
 
       // Ensure the provided configuration is valid.
       error_type<std::string> validation = validator->is_valid(cfg);
@@ -482,7 +198,7 @@ MexFunction::call_processor(const resource_grid_reader& grid_reader, const Struc
       break;
     }
     case 4: {
-      const pucch_processor::format4_configuration cfg = populate_f4_configuration(in_cfg);
+      const pucch_processor::format4_configuration cfg = populate_pucch_f4_configuration(in_cfg);
 
       // Ensure the provided configuration is valid.
       error_type<std::string> validation = validator->is_valid(cfg);
@@ -23,6 +23,7 @@
 #pragma once
 
 #include "srsran_matlab/srsran_mex_dispatcher.h"
+#include "srsran_matlab/support/low_papr_sequence_collection_cache.h"
 #include "srsran/phy/generic_functions/generic_functions_factories.h"
 #include "srsran/phy/upper/channel_coding/channel_coding_factories.h"
 #include "srsran/phy/upper/channel_modulation/channel_modulation_factories.h"
@@ -149,7 +150,7 @@ create_pucch_processor()
   std::shared_ptr<low_papr_sequence_generator_factory> lpapr_generator_factory =
       create_low_papr_sequence_generator_sw_factory();
   std::shared_ptr<low_papr_sequence_collection_factory> lpapr_collection_factory =
-      create_low_papr_sequence_collection_sw_factory(lpapr_generator_factory);
+      srsran_matlab::create_low_papr_sequence_collection_cached_factory(lpapr_generator_factory);
   std::shared_ptr<dft_processor_factory>            dft_factory = create_dft_processor_factory_fftw_slow();
   std::shared_ptr<time_alignment_estimator_factory> ta_est_factory =
       create_time_alignment_estimator_dft_factory(dft_factory);
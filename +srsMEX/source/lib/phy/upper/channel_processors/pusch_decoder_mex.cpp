@@ -29,8 +29,11 @@
 #include "srsran/ran/sch/modulation_scheme.h"
 #include "srsran/support/units.h"
 #include "fmt/format.h"
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <optional>
+#include <string>
 
 using matlab::mex::ArgumentList;
 using namespace matlab::data;
@@ -39,6 +42,11 @@ using namespace srsran_matlab;
 
 namespace {
 
+/// \brief Numerology of the slot counter of the softbuffer pools.
+///
+/// The pools only count slots, the numerology determines the wrap-around of the counter (10240 slots).
+constexpr unsigned SLOT_NUMEROLOGY = 0;
+
 class pusch_decoder_notifier_spy : private pusch_decoder_notifier
 {
 public:
@@ -54,37 +62,318 @@ private:
   std::optional<pusch_decoder_result> result;
 };
 
+/// \brief Softbuffer that goes back to the pool when the decoder is done with it, whatever the CRC.
+///
+/// The decoder releases the softbuffer of a transport block that passes the CRC and only unlocks it otherwise. This
+/// wrapper releases the wrapped softbuffer in both cases, without a new reservation.
+class release_on_unlock_rx_buffer : public unique_rx_buffer::callback
+{
+public:
+  explicit release_on_unlock_rx_buffer(unique_rx_buffer buffer_) : buffer(std::move(buffer_)), inner(buffer.get()) {}
+
+  // See interface for documentation.
+  unsigned get_nof_codeblocks() const override { return inner.get_nof_codeblocks(); }
+
+  // See interface for documentation.
+  void reset_codeblocks_crc() override { inner.reset_codeblocks_crc(); }
+
+  // See interface for documentation.
+  span<bool> get_codeblocks_crc() override { return inner.get_codeblocks_crc(); }
+
+  // See interface for documentation.
+  unsigned get_absolute_codeblock_id(unsigned codeblock_id) const override
+  {
+    return inner.get_absolute_codeblock_id(codeblock_id);
+  }
+
+  // See interface for documentation.
+  span<log_likelihood_ratio> get_codeblock_soft_bits(unsigned codeblock_id, unsigned codeblock_size) override
+  {
+    return inner.get_codeblock_soft_bits(codeblock_id, codeblock_size);
+  }
+
+  // See interface for documentation.
+  bit_buffer get_codeblock_data_bits(unsigned codeblock_id, unsigned data_size) override
+  {
+    return inner.get_codeblock_data_bits(codeblock_id, data_size);
+  }
+
+  // The wrapped softbuffer is already locked.
+  void lock() override {}
+
+  // See interface for documentation.
+  void unlock() override { release(); }
+
+  // See interface for documentation.
+  void release() override
+  {
+    if (buffer.is_valid()) {
+      buffer.release();
+    }
+  }
+
+private:
+  /// Wrapped softbuffer.
+  unique_rx_buffer buffer;
+  /// Wrapped softbuffer, for the accessors.
+  rx_buffer& inner;
+};
+
 } // namespace
 
+MexFunction::pusch_memento::pusch_memento(const rx_buffer_pool_config& config,
+                                          unsigned                     softbit_width,
+                                          bool                         enable_checkpoints,
+                                          std::unique_ptr<harq_entity> h) :
+  harq(std::move(h)),
+  expire_timeout_slots(config.expire_timeout_slots),
+  full_width_storage_size(std::size_t{config.nof_codeblocks} * config.max_codeblock_size)
+{
+  // The state of the srsRAN pool is not accessible: checkpoints need the srsRAN-matlab pool, lossless at 8 bits.
+  if ((softbit_width == 8) && !enable_checkpoints) {
+    pool = create_rx_buffer_pool(config);
+  } else {
+    compressed_pool = std::make_unique<compressed_rx_buffer_pool>(config, softbit_width);
+  }
+}
+
 unique_rx_buffer MexFunction::pusch_memento::retrieve_softbuffer(const trx_buffer_identifier& id,
                                                                  unsigned                     nof_codeblocks,
                                                                  bool                         is_new_data)
 {
-  return pool->get_pool().reserve({}, id, nof_codeblocks, is_new_data);
+  unique_rx_buffer softbuffer = compressed_pool
+                                    ? compressed_pool->reserve(current_slot, id, nof_codeblocks, is_new_data)
+                                    : pool->get_pool().reserve(current_slot, id, nof_codeblocks, is_new_data);
+
+  std::pair<uint16_t, unsigned> buffer_key = {id.get_rnti(), id.get_harq()};
+  auto                          it         = reservations.find(buffer_key);
+
+  // The mirror only follows successful reservations. A failed one leaves the compressed pool unchanged, while the
+  // srsRAN pool frees a softbuffer whose new codeblocks cannot be allocated.
+  if (!softbuffer.is_valid()) {
+    if (!compressed_pool && is_new_data && (it != reservations.end()) &&
+        (it->second.nof_codeblocks != nof_codeblocks)) {
+      erase_reservation(it);
+    }
+    return softbuffer;
+  }
+
+  // Every reservation renews the expiration of the softbuffer and may change its number of codeblocks.
+  if (it != reservations.end()) {
+    erase_reservation(it);
+  }
+  reservations.emplace(buffer_key, reservation{current_slot + static_cast<int>(expire_timeout_slots), nof_codeblocks});
+
+  status.nof_buffers = reservations.size();
+  status.nof_codeblocks += nof_codeblocks;
+  status.max_nof_buffers    = std::max(status.max_nof_buffers, status.nof_buffers);
+  status.max_nof_codeblocks = std::max(status.max_nof_codeblocks, status.nof_codeblocks);
+
+  return softbuffer;
+}
+
+void MexFunction::pusch_memento::run_slot(const slot_point& slot)
+{
+  if (slot == current_slot) {
+    return;
+  }
+
+  if (compressed_pool) {
+    compressed_pool->run_slot(slot);
+  } else {
+    pool->get_pool().run_slot(slot);
+  }
+  current_slot = slot;
+
+  // Same expiration rule as the pool.
+  for (auto it = reservations.begin(); it != reservations.end();) {
+    if (it->second.expiration <= slot) {
+      it = erase_reservation(it);
+      ++status.nof_expired_buffers;
+    } else {
+      ++it;
+    }
+  }
+}
+
+void MexFunction::pusch_memento::on_softbuffer_released(const trx_buffer_identifier& id)
+{
+  if (auto it = reservations.find({id.get_rnti(), id.get_harq()}); it != reservations.end()) {
+    erase_reservation(it);
+  }
+}
+
+void MexFunction::pusch_memento::save(checkpoint_writer& writer) const
+{
+  srsran_assert(supports_checkpoints(), "The memento does not support checkpoints.");
+
+  writer.write_slot(current_slot);
+
+  writer.write<uint32_t>(reservations.size());
+  for (const auto& [buffer_key, buffer_reservation] : reservations) {
+    writer.write<uint16_t>(buffer_key.first);
+    writer.write<uint32_t>(buffer_key.second);
+    writer.write_slot(buffer_reservation.expiration);
+    writer.write<uint32_t>(buffer_reservation.nof_codeblocks);
+  }
+
+  writer.write<uint32_t>(status.nof_buffers);
+  writer.write<uint32_t>(status.nof_codeblocks);
+  writer.write<uint32_t>(status.max_nof_buffers);
+  writer.write<uint32_t>(status.max_nof_codeblocks);
+  writer.write<uint64_t>(status.nof_expired_buffers);
+
+  writer.write<uint8_t>(harq != nullptr);
+  if (harq) {
+    harq->save(writer);
+  }
+
+  compressed_pool->save(writer);
+}
+
+bool MexFunction::pusch_memento::load(checkpoint_reader& reader)
+{
+  srsran_assert(supports_checkpoints(), "The memento does not support checkpoints.");
+
+  current_slot = reader.read_slot();
+  if (!current_slot.valid()) {
+    return false;
+  }
+
+  reservations.clear();
+  unsigned nof_reservations = reader.read<uint32_t>();
+  for (unsigned i_reservation = 0; reader.is_valid() && (i_reservation != nof_reservations); ++i_reservation) {
+    std::pair<uint16_t, unsigned> buffer_key = {reader.read<uint16_t>(), reader.read<uint32_t>()};
+    slot_point                    expiration = reader.read_slot();
+    reservations.emplace(buffer_key, reservation{expiration, reader.read<uint32_t>()});
+  }
+
+  status.nof_buffers         = reader.read<uint32_t>();
+  status.nof_codeblocks      = reader.read<uint32_t>();
+  status.max_nof_buffers     = reader.read<uint32_t>();
+  status.max_nof_codeblocks  = reader.read<uint32_t>();
+  status.nof_expired_buffers = reader.read<uint64_t>();
+
+  bool has_harq = (reader.read<uint8_t>() != 0);
+  if (has_harq != (harq != nullptr)) {
+    return false;
+  }
+  if (harq && !harq->load(reader)) {
+    return false;
+  }
+
+  return compressed_pool->load(reader) && reader.is_valid() && (reservations.size() == status.nof_buffers);
+}
+
+MexFunction::pusch_memento::reservation_map::iterator
+MexFunction::pusch_memento::erase_reservation(reservation_map::iterator it)
+{
+  status.nof_codeblocks -= it->second.nof_codeblocks;
+  auto next          = reservations.erase(it);
+  status.nof_buffers = reservations.size();
+  return next;
 }
 
 unique_rx_buffer MexFunction::retrieve_softbuffer(uint64_t                     key,
                                                   const trx_buffer_identifier& id,
                                                   unsigned                     nof_codeblocks,
                                                   bool                         is_new_data)
+{
+  unique_rx_buffer softbuffer = retrieve_memento(key)->retrieve_softbuffer(id, nof_codeblocks, is_new_data);
+  if (!softbuffer.is_valid()) {
+    mex_abort(
+        "Cannot retrieve softbuffer with key {}, buffer ID ({}) and nr. of codeblocks {}.", key, id, nof_codeblocks);
+  }
+  return softbuffer;
+}
+
+std::shared_ptr<MexFunction::pusch_memento> MexFunction::create_memento(ArgumentList inputs, unsigned i_first)
+{
+  if ((inputs[i_first].getType() != ArrayType::STRUCT) || (inputs[i_first].getNumberOfElements() != 1)) {
+    mex_abort("Input 'softbuffer_conf' must be a scalar structure.");
+  }
+  rx_buffer_pool_config pool_config = {};
+
+  StructArray in_struct            = inputs[i_first];
+  Struct      softbuffer_conf      = in_struct[0];
+  pool_config.max_codeblock_size   = softbuffer_conf["MaxCodeblockSize"][0];
+  pool_config.nof_buffers          = softbuffer_conf["MaxSoftbuffers"][0];
+  pool_config.nof_codeblocks       = softbuffer_conf["MaxCodeblocks"][0];
+  pool_config.expire_timeout_slots = softbuffer_conf["ExpireTimeoutSlots"][0];
+  unsigned softbit_width           = softbuffer_conf["SoftbitWidth"][0];
+
+  const TypedArray<bool> in_enable_checkpoints = softbuffer_conf["EnableCheckpoints"];
+  bool                   enable_checkpoints    = in_enable_checkpoints[0];
+  if ((softbit_width != 8) && (softbit_width != 6) && (softbit_width != 4)) {
+    mex_abort("Invalid soft bit width {}, valid values are 8, 6 and 4.", softbit_width);
+  }
+
+  std::unique_ptr<harq_entity> harq = nullptr;
+  if (inputs.size() > i_first + 1) {
+    if ((inputs[i_first + 1].getType() != ArrayType::STRUCT) || (inputs[i_first + 1].getNumberOfElements() != 1)) {
+      mex_abort("Input 'harq_conf' must be a scalar structure.");
+    }
+
+    in_struct                                 = inputs[i_first + 1];
+    Struct                   harq_conf        = in_struct[0];
+    const TypedArray<double> in_process_seq   = harq_conf["HARQProcessSequence"];
+    const TypedArray<double> in_rv_seq        = harq_conf["RVSequence"];
+    std::vector<unsigned>    process_sequence = {};
+    for (double id : in_process_seq) {
+      process_sequence.push_back(static_cast<unsigned>(id));
+    }
+    std::vector<unsigned> rv_sequence = {};
+    for (double rv : in_rv_seq) {
+      if (rv > 3) {
+        mex_abort("Invalid redundancy version {}.", rv);
+      }
+      rv_sequence.push_back(static_cast<unsigned>(rv));
+    }
+    if (process_sequence.empty() || rv_sequence.empty()) {
+      mex_abort("At least one HARQ process and one redundancy version are required.");
+    }
+
+    uint16_t rnti = harq_conf["RNTI"][0];
+    harq          = std::make_unique<harq_entity>(rnti, std::move(process_sequence), std::move(rv_sequence));
+
+    // Each HARQ process needs its own softbuffer.
+    unsigned nof_processes = harq->get_statistics().size();
+    if (nof_processes > pool_config.nof_buffers) {
+      mex_abort("The HARQ entity has {} processes but the pool has only {} softbuffers.",
+                nof_processes,
+                pool_config.nof_buffers);
+    }
+  }
+
+  std::shared_ptr<pusch_memento> mem =
+      std::make_shared<pusch_memento>(pool_config, softbit_width, enable_checkpoints, std::move(harq));
+  if (!mem) {
+    mex_abort("Cannot create PUSCH memento.");
+  }
+  return mem;
+}
+
+std::shared_ptr<MexFunction::pusch_memento> MexFunction::retrieve_memento(uint64_t key)
 {
   std::shared_ptr<pusch_memento> mem = storage.get_memento(key);
   if (!mem) {
     mex_abort("Cannot retrieve rx_softbuffer_pool with key {}.", key);
   }
+  return mem;
+}
 
-  auto             pusch_mem  = std::dynamic_pointer_cast<pusch_memento>(storage.get_memento(key));
-  unique_rx_buffer softbuffer = pusch_mem->retrieve_softbuffer(id, nof_codeblocks, is_new_data);
-  if (!softbuffer.is_valid()) {
-    mex_abort(
-        "Cannot retrieve softbuffer with key {}, buffer ID ({}) and nr. of codeblocks {}.", key, id, nof_codeblocks);
+std::shared_ptr<MexFunction::pusch_memento> MexFunction::retrieve_harq_memento(uint64_t key)
+{
+  std::shared_ptr<pusch_memento> mem = retrieve_memento(key);
+  if (mem->get_harq_entity() == nullptr) {
+    mex_abort("The rx_softbuffer_pool with key {} has no HARQ entity.", key);
   }
-  return softbuffer;
+  return mem;
 }
 
 void MexFunction::check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs)
 {
-  if (inputs.size() != 6) {
+  if ((inputs.size() != 6) && (inputs.size() != 7)) {
     mex_abort("Wrong number of inputs.");
   }
 
@@ -113,6 +402,76 @@ void MexFunction::check_step_outputs_inputs(ArgumentList outputs, ArgumentList i
   }
 }
 
+pusch_decoder::configuration MexFunction::read_decoder_config(const Struct& in_seg_cfg, bool new_data)
+{
+  pusch_decoder::configuration cfg = {};
+  cfg.base_graph                   = matlab_to_srs_base_graph(in_seg_cfg["BGN"][0]);
+  const CharArray in_mod_scheme    = in_seg_cfg["Modulation"];
+  cfg.mod                          = matlab_to_srs_modulation(in_mod_scheme.toAscii());
+  cfg.nof_layers                   = in_seg_cfg["NumLayers"][0];
+  cfg.rv                           = in_seg_cfg["RV"][0];
+  cfg.Nref                         = in_seg_cfg["LimitedBufferSize"][0];
+  cfg.new_data                     = new_data;
+  cfg.use_early_stop               = true;
+  cfg.nof_ldpc_iterations          = in_seg_cfg["MaximumLDPCIterationCount"][0];
+  return cfg;
+}
+
+slot_point MexFunction::read_slot(const Array& in_slot)
+{
+  if ((in_slot.getType() != ArrayType::DOUBLE) || (in_slot.getNumberOfElements() != 1)) {
+    mex_abort("Input 'slot' must be a scalar double.");
+  }
+
+  double slot = static_cast<TypedArray<double>>(in_slot)[0];
+  if ((slot < 0) || (slot != std::floor(slot))) {
+    mex_abort("Invalid slot {}, it must be a nonnegative integer.", slot);
+  }
+
+  // The counter wraps around as the pool slot point does.
+  unsigned nof_slots = slot_point(SLOT_NUMEROLOGY, 0).nof_slots_per_hyper_system_frame();
+  return {SLOT_NUMEROLOGY, static_cast<uint32_t>(std::fmod(slot, nof_slots))};
+}
+
+pusch_decoder_result MexFunction::decode(span<uint8_t>                       transport_block,
+                                         unique_rx_buffer                    softbuffer,
+                                         span<const log_likelihood_ratio>    llrs,
+                                         const pusch_decoder::configuration& cfg)
+{
+  pusch_decoder_notifier_spy notifier_spy;
+  pusch_decoder_buffer&      buffer =
+      decoder->new_data(transport_block, std::move(softbuffer), notifier_spy.get_notifier(), cfg);
+
+  buffer.on_new_softbits(llrs);
+  buffer.on_end_softbits();
+
+  if (!notifier_spy.has_result()) {
+    mex_abort("Notifier result has not been reported.");
+  }
+  return notifier_spy.get_result();
+}
+
+StructArray MexFunction::to_matlab(const pusch_decoder_result& result)
+{
+  StructArray S              = factory.createStructArray({1, 1}, {"CRCOK", "LDPCIterationsMax", "LDPCIterationsMean"});
+  S[0]["CRCOK"]              = factory.createScalar(result.tb_crc_ok);
+  S[0]["LDPCIterationsMax"]  = factory.createScalar(result.ldpc_decoder_stats.get_max());
+  S[0]["LDPCIterationsMean"] = factory.createScalar(result.ldpc_decoder_stats.get_mean());
+  return S;
+}
+
+StructArray MexFunction::to_matlab(const harq_transmission& transmission)
+{
+  StructArray S = factory.createStructArray(
+      {1, 1}, {"HARQProcessID", "TransmissionNumber", "RedundancyVersion", "NewData", "SequenceTimeout"});
+  S[0]["HARQProcessID"]      = factory.createScalar(static_cast<double>(transmission.harq_process_id));
+  S[0]["TransmissionNumber"] = factory.createScalar(static_cast<double>(transmission.transmission_number));
+  S[0]["RedundancyVersion"]  = factory.createScalar(static_cast<double>(transmission.rv));
+  S[0]["NewData"]            = factory.createScalar(transmission.new_data);
+  S[0]["SequenceTimeout"]    = factory.createScalar(transmission.sequence_timeout);
+  return S;
+}
+
 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
 void MexFunction::method_new(ArgumentList outputs, ArgumentList inputs)
 {
@@ -120,25 +479,14 @@ void MexFunction::method_new(ArgumentList outputs, ArgumentList inputs)
     mex_abort("Only one output expected.");
   }
 
-  if ((inputs[1].getType() != ArrayType::STRUCT) || (inputs[1].getNumberOfElements() != 1)) {
-    mex_abort("Second input must be a scalar structure.");
+  if ((inputs.size() != 2) && (inputs.size() != 3)) {
+    mex_abort("Wrong number of inputs.");
   }
-  rx_buffer_pool_config pool_config = {};
-
-  StructArray in_struct            = inputs[1];
-  Struct      softbuffer_conf      = in_struct[0];
-  pool_config.max_codeblock_size   = softbuffer_conf["MaxCodeblockSize"][0];
-  pool_config.nof_buffers          = softbuffer_conf["MaxSoftbuffers"][0];
-  pool_config.nof_codeblocks       = softbuffer_conf["MaxCodeblocks"][0];
-  pool_config.expire_timeout_slots = softbuffer_conf["ExpireTimeoutSlots"][0];
 
-  std::shared_ptr<pusch_memento> mem = std::make_shared<pusch_memento>(create_rx_buffer_pool(pool_config));
-  if (!mem) {
-    mex_abort("Cannot create PUSCH memento.");
-  }
-  uint64_t             key      = storage.store(mem);
-  TypedArray<uint64_t> pool_key = factory.createScalar(key);
-  outputs[0]                    = pool_key;
+  std::shared_ptr<pusch_memento> mem      = create_memento(inputs, 1);
+  uint64_t                       key      = storage.store(mem);
+  TypedArray<uint64_t>           pool_key = factory.createScalar(key);
+  outputs[0]                              = pool_key;
 }
 
 void MexFunction::method_step(ArgumentList outputs, ArgumentList inputs)
@@ -148,18 +496,10 @@ void MexFunction::method_step(ArgumentList outputs, ArgumentList inputs)
   const TypedArray<int8_t>         in_int8_array = inputs[2];
   span<const log_likelihood_ratio> llrs          = to_span<int8_t, log_likelihood_ratio>(in_int8_array);
 
+  bool                         new_data        = static_cast<TypedArray<bool>>(inputs[3])[0];
   StructArray                  in_struct_array = inputs[4];
   Struct                       in_seg_cfg      = in_struct_array[0];
-  pusch_decoder::configuration cfg             = {};
-  cfg.base_graph                               = matlab_to_srs_base_graph(in_seg_cfg["BGN"][0]);
-  CharArray in_mod_scheme                      = in_seg_cfg["Modulation"];
-  cfg.mod                                      = matlab_to_srs_modulation(in_mod_scheme.toAscii());
-  cfg.nof_layers                               = in_seg_cfg["NumLayers"][0];
-  cfg.rv                                       = in_seg_cfg["RV"][0];
-  cfg.Nref                                     = in_seg_cfg["LimitedBufferSize"][0];
-  cfg.new_data                                 = static_cast<TypedArray<bool>>(inputs[3])[0];
-  cfg.use_early_stop                           = true;
-  cfg.nof_ldpc_iterations                      = in_seg_cfg["MaximumLDPCIterationCount"][0];
+  pusch_decoder::configuration cfg             = read_decoder_config(in_seg_cfg, new_data);
 
   units::bits tbs(static_cast<unsigned>(in_seg_cfg["TransportBlockLength"][0]));
   if (!tbs.is_byte_exact()) {
@@ -180,30 +520,29 @@ void MexFunction::method_step(ArgumentList outputs, ArgumentList inputs)
               nof_codeblocks_check);
   }
 
-  uint64_t key = static_cast<TypedArray<uint64_t>>(inputs[1])[0];
+  uint64_t                       key = static_cast<TypedArray<uint64_t>>(inputs[1])[0];
+  std::shared_ptr<pusch_memento> mem = retrieve_memento(key);
+  if (inputs.size() == 7) {
+    mem->run_slot(read_slot(inputs[6]));
+  }
 
   unique_rx_buffer    softbuffer = retrieve_softbuffer(key, buf_id, nof_codeblocks, cfg.new_data);
   TypedArray<uint8_t> out        = factory.createArray<uint8_t>({tbs_bytes.value(), 1});
-  span<uint8_t>       rx_tb      = to_span(out);
 
-  pusch_decoder_notifier_spy notifier_spy;
-  pusch_decoder_buffer&      buffer = decoder->new_data(rx_tb, std::move(softbuffer), notifier_spy.get_notifier(), cfg);
+  const pusch_decoder_result dec_result = decode(to_span(out), std::move(softbuffer), llrs, cfg);
 
-  buffer.on_new_softbits(llrs);
-  buffer.on_end_softbits();
-
-  outputs[0] = out;
+  // The decoder releases the softbuffer of a transport block that passes the CRC.
+  if (dec_result.tb_crc_ok) {
+    mem->on_softbuffer_released(buf_id);
+  }
 
-  if (!notifier_spy.has_result()) {
-    mex_abort("Notifier result has not been reported.");
+  // Without an explicit slot, every decoded codeword takes one slot.
+  if (inputs.size() == 6) {
+    mem->run_slot(mem->get_slot() + 1);
   }
-  const pusch_decoder_result& dec_result = notifier_spy.get_result();
 
-  StructArray S              = factory.createStructArray({1, 1}, {"CRCOK", "LDPCIterationsMax", "LDPCIterationsMean"});
-  S[0]["CRCOK"]              = factory.createScalar(dec_result.tb_crc_ok);
-  S[0]["LDPCIterationsMax"]  = factory.createScalar(dec_result.ldpc_decoder_stats.get_max());
-  S[0]["LDPCIterationsMean"] = factory.createScalar(dec_result.ldpc_decoder_stats.get_mean());
-  outputs[1]                 = S;
+  outputs[0] = out;
+  outputs[1] = to_matlab(dec_result);
 }
 
 void MexFunction::method_reset_crcs(ArgumentList outputs, ArgumentList inputs)
@@ -212,7 +551,7 @@ void MexFunction::method_reset_crcs(ArgumentList outputs, ArgumentList inputs)
     mex_abort("No outputs expected.");
   }
 
-  if (inputs.size() != 3) {
+  if ((inputs.size() != 3) && (inputs.size() != 4)) {
     mex_abort("Wrong number of inputs.");
   }
 
@@ -231,6 +570,9 @@ void MexFunction::method_reset_crcs(ArgumentList outputs, ArgumentList inputs)
   unsigned nof_codeblocks = in_buf_id["NumCodeblocks"][0];
 
   uint64_t key = static_cast<TypedArray<uint64_t>>(inputs[1])[0];
+  if (inputs.size() == 4) {
+    retrieve_memento(key)->run_slot(read_slot(inputs[3]));
+  }
 
   // We reset the CRCs before new transmissions, not in between retransmissions.
   bool is_new_data = true;
@@ -240,6 +582,279 @@ void MexFunction::method_reset_crcs(ArgumentList outputs, ArgumentList inputs)
   rm_buffer.get().reset_codeblocks_crc();
 }
 
+void MexFunction::method_step_harq(ArgumentList outputs, ArgumentList inputs)
+{
+  if ((inputs.size() != 4) && (inputs.size() != 5)) {
+    mex_abort("Wrong number of inputs.");
+  }
+
+  if ((inputs[1].getType() != ArrayType::UINT64) || (inputs[1].getNumberOfElements() > 1)) {
+    mex_abort("Input 'softbufferPoolID' should be a scalar uint64_t");
+  }
+
+  if (inputs[2].getType() != ArrayType::INT8) {
+    mex_abort("Input 'llrs' must be an array of int8_t.");
+  }
+
+  if ((inputs[3].getType() != ArrayType::STRUCT) || (inputs[3].getNumberOfElements() > 1)) {
+    mex_abort("Input 'seg_cfg' must be a scalar structure.");
+  }
+
+  if (outputs.size() != 3) {
+    mex_abort("Wrong number of outputs.");
+  }
+
+  uint64_t                       key  = static_cast<TypedArray<uint64_t>>(inputs[1])[0];
+  std::shared_ptr<pusch_memento> mem  = retrieve_harq_memento(key);
+  harq_entity&                   harq = *mem->get_harq_entity();
+  if (inputs.size() == 5) {
+    mem->run_slot(read_slot(inputs[4]));
+  }
+
+  // The HARQ entity, not the caller, decides the RV and the new data flag.
+  const harq_transmission transmission = harq.get_transmission();
+
+  const TypedArray<int8_t>         in_int8_array = inputs[2];
+  span<const log_likelihood_ratio> llrs          = to_span<int8_t, log_likelihood_ratio>(in_int8_array);
+
+  StructArray                  in_struct_array = inputs[3];
+  Struct                       in_seg_cfg      = in_struct_array[0];
+  pusch_decoder::configuration cfg             = read_decoder_config(in_seg_cfg, transmission.new_data);
+  cfg.rv                                       = transmission.rv;
+
+  units::bits tbs(static_cast<unsigned>(in_seg_cfg["TransportBlockLength"][0]));
+  if (!tbs.is_byte_exact()) {
+    mex_abort("The TBS is not an exact number of bytes.");
+  }
+  if (!transmission.new_data && (tbs.value() != harq.get_tbs())) {
+    mex_abort("HARQ process {}: the retransmission TBS ({}) differs from the initial transmission TBS ({}).",
+              transmission.harq_process_id,
+              tbs.value(),
+              harq.get_tbs());
+  }
+  units::bytes tbs_bytes = tbs.round_up_to_bytes();
+
+  trx_buffer_identifier buf_id(harq.get_rnti(), transmission.harq_process_id);
+
+  unsigned nof_codeblocks       = in_seg_cfg["NumCodeblocks"][0];
+  unsigned nof_codeblocks_check = ldpc::compute_nof_codeblocks(tbs, cfg.base_graph);
+  if (nof_codeblocks != nof_codeblocks_check) {
+    mex_abort("Softbuffer ({}) requested with {} codeblocks, but the codeword has {} codeblocks.",
+              buf_id,
+              nof_codeblocks,
+              nof_codeblocks_check);
+  }
+
+  // A new RV sequence starts with clean CRC flags.
+  unique_rx_buffer softbuffer = retrieve_softbuffer(key, buf_id, nof_codeblocks, transmission.new_data);
+  if (transmission.new_data) {
+    softbuffer.get().reset_codeblocks_crc();
+  }
+
+  // After the last transmission of the RV sequence, the softbuffer is of no further use even if the CRC fails: it goes
+  // back to the pool as soon as the decoder is done with it.
+  bool                                       is_last_transmission = harq.is_last_transmission();
+  std::optional<release_on_unlock_rx_buffer> releasing_softbuffer;
+  if (is_last_transmission) {
+    releasing_softbuffer.emplace(std::move(softbuffer));
+    softbuffer = unique_rx_buffer(*releasing_softbuffer);
+  }
+
+  TypedArray<uint8_t>        out        = factory.createArray<uint8_t>({tbs_bytes.value(), 1});
+  const pusch_decoder_result dec_result = decode(to_span(out), std::move(softbuffer), llrs, cfg);
+
+  // The decoder releases the softbuffer of a transport block that passes the CRC.
+  if (dec_result.tb_crc_ok || is_last_transmission) {
+    mem->on_softbuffer_released(buf_id);
+  }
+
+  // Move to the next transmission.
+  harq.update(dec_result.tb_crc_ok, tbs.value());
+
+  // Without an explicit slot, every decoded codeword takes one slot.
+  if (inputs.size() == 4) {
+    mem->run_slot(mem->get_slot() + 1);
+  }
+
+  outputs[0] = out;
+  outputs[1] = to_matlab(dec_result);
+  outputs[2] = to_matlab(harq.get_transmission());
+}
+
+void MexFunction::method_harq_status(ArgumentList outputs, ArgumentList inputs)
+{
+  if (inputs.size() != 2) {
+    mex_abort("Wrong number of inputs.");
+  }
+
+  if ((inputs[1].getType() != ArrayType::UINT64) || (inputs[1].getNumberOfElements() > 1)) {
+    mex_abort("Input 'softbufferPoolID' should be a scalar uint64_t");
+  }
+
+  if (outputs.size() != 2) {
+    mex_abort("Wrong number of outputs.");
+  }
+
+  uint64_t                       key  = static_cast<TypedArray<uint64_t>>(inputs[1])[0];
+  std::shared_ptr<pusch_memento> mem  = retrieve_harq_memento(key);
+  const harq_entity&             harq = *mem->get_harq_entity();
+
+  const std::vector<harq_process_statistics>& statistics = harq.get_statistics();
+
+  StructArray S = factory.createStructArray({1, statistics.size()},
+                                            {"HARQProcessID",
+                                             "NumTransmissions",
+                                             "NumNewTransmissions",
+                                             "NumTimeouts",
+                                             "TotalBits",
+                                             "SuccessfulBits",
+                                             "NumSuccesses"});
+  for (unsigned i_process = 0, nof_processes = statistics.size(); i_process != nof_processes; ++i_process) {
+    const harq_process_statistics& stats = statistics[i_process];
+    S[i_process]["HARQProcessID"]        = factory.createScalar(static_cast<double>(stats.harq_process_id));
+    S[i_process]["NumTransmissions"]     = factory.createScalar(static_cast<double>(stats.nof_transmissions));
+    S[i_process]["NumNewTransmissions"]  = factory.createScalar(static_cast<double>(stats.nof_new_transmissions));
+    S[i_process]["NumTimeouts"]          = factory.createScalar(static_cast<double>(stats.nof_timeouts));
+    S[i_process]["TotalBits"]            = factory.createScalar(static_cast<double>(stats.total_bits));
+    S[i_process]["SuccessfulBits"]       = factory.createScalar(static_cast<double>(stats.successful_bits));
+
+    TypedArray<double> nof_successes = factory.createArray<double>({1, stats.nof_successes.size()});
+    std::transform(stats.nof_successes.begin(),
+                   stats.nof_successes.end(),
+                   nof_successes.begin(),
+                   [](uint64_t value) { return static_cast<double>(value); });
+    S[i_process]["NumSuccesses"] = nof_successes;
+  }
+
+  outputs[0] = to_matlab(harq.get_transmission());
+  outputs[1] = S;
+}
+
+void MexFunction::method_pool_status(ArgumentList outputs, ArgumentList inputs)
+{
+  if ((inputs.size() != 2) && (inputs.size() != 3)) {
+    mex_abort("Wrong number of inputs.");
+  }
+
+  if ((inputs[1].getType() != ArrayType::UINT64) || (inputs[1].getNumberOfElements() > 1)) {
+    mex_abort("Input 'softbufferPoolID' should be a scalar uint64_t");
+  }
+
+  if (outputs.size() != 1) {
+    mex_abort("Wrong number of outputs.");
+  }
+
+  uint64_t                       key = static_cast<TypedArray<uint64_t>>(inputs[1])[0];
+  std::shared_ptr<pusch_memento> mem = retrieve_memento(key);
+  if (inputs.size() == 3) {
+    mem->run_slot(read_slot(inputs[2]));
+  }
+
+  const pusch_memento::pool_status& status = mem->get_status();
+
+  StructArray S = factory.createStructArray({1, 1},
+                                            {"Slot",
+                                             "NumBuffers",
+                                             "NumCodeblocks",
+                                             "MaxNumBuffers",
+                                             "MaxNumCodeblocks",
+                                             "NumExpiredBuffers",
+                                             "StorageBytes",
+                                             "FullWidthStorageBytes"});
+  S[0]["Slot"]                  = factory.createScalar(static_cast<double>(mem->get_slot().to_uint()));
+  S[0]["NumBuffers"]            = factory.createScalar(static_cast<double>(status.nof_buffers));
+  S[0]["NumCodeblocks"]         = factory.createScalar(static_cast<double>(status.nof_codeblocks));
+  S[0]["MaxNumBuffers"]         = factory.createScalar(static_cast<double>(status.max_nof_buffers));
+  S[0]["MaxNumCodeblocks"]      = factory.createScalar(static_cast<double>(status.max_nof_codeblocks));
+  S[0]["NumExpiredBuffers"]     = factory.createScalar(static_cast<double>(status.nof_expired_buffers));
+  S[0]["StorageBytes"]          = factory.createScalar(static_cast<double>(mem->get_softbit_storage_size()));
+  S[0]["FullWidthStorageBytes"] = factory.createScalar(static_cast<double>(mem->get_full_width_storage_size()));
+  outputs[0]                    = S;
+}
+
+void MexFunction::method_save(ArgumentList outputs, ArgumentList inputs)
+{
+  if (outputs.size() != 1) {
+    mex_abort("Only one output expected.");
+  }
+
+  if (inputs.size() != 3) {
+    mex_abort("Wrong number of inputs.");
+  }
+
+  if ((inputs[1].getType() != ArrayType::UINT64) || (inputs[1].getNumberOfElements() > 1)) {
+    mex_abort("Input 'softbufferPoolID' should be a scalar uint64_t");
+  }
+
+  if (inputs[2].getType() != ArrayType::CHAR) {
+    mex_abort("Input 'filename' must be a character array.");
+  }
+
+  uint64_t                       key = static_cast<TypedArray<uint64_t>>(inputs[1])[0];
+  std::shared_ptr<pusch_memento> mem = retrieve_memento(key);
+  if (!mem->supports_checkpoints()) {
+    mex_abort("The rx_softbuffer_pool with key {} was created without checkpoints.", key);
+  }
+
+  const CharArray in_filename = inputs[2];
+  std::string     filename    = in_filename.toAscii();
+
+  checkpoint_writer writer;
+  mem->save(writer);
+  if (!writer.save(filename)) {
+    mex_abort("Cannot write checkpoint file {}.", filename);
+  }
+
+  TypedArray<uint64_t> checkpoint_id = factory.createScalar(writer.get_checkpoint_id());
+  outputs[0]                         = checkpoint_id;
+}
+
+void MexFunction::method_load(ArgumentList outputs, ArgumentList inputs)
+{
+  if (outputs.size() != 1) {
+    mex_abort("Only one output expected.");
+  }
+
+  if ((inputs.size() != 4) && (inputs.size() != 5)) {
+    mex_abort("Wrong number of inputs.");
+  }
+
+  if (inputs[1].getType() != ArrayType::CHAR) {
+    mex_abort("Input 'filename' must be a character array.");
+  }
+
+  if ((inputs[2].getType() != ArrayType::UINT64) || (inputs[2].getNumberOfElements() != 1)) {
+    mex_abort("Input 'checkpointID' should be a scalar uint64_t");
+  }
+
+  const CharArray in_filename   = inputs[1];
+  std::string     filename      = in_filename.toAscii();
+  uint64_t        checkpoint_id = static_cast<TypedArray<uint64_t>>(inputs[2])[0];
+
+  std::shared_ptr<pusch_memento> mem = create_memento(inputs, 3);
+  if (!mem->supports_checkpoints()) {
+    mex_abort("Cannot load a checkpoint into an rx_softbuffer_pool without checkpoints.");
+  }
+
+  checkpoint_reader reader(filename);
+  if (!reader.is_valid()) {
+    mex_abort("Cannot read checkpoint file {}.", filename);
+  }
+  if (reader.get_checkpoint_id() != checkpoint_id) {
+    mex_abort("The checkpoint file {} holds checkpoint {:016x} instead of {:016x}: it was overwritten by a later save.",
+              filename,
+              reader.get_checkpoint_id(),
+              checkpoint_id);
+  }
+  if (!mem->load(reader)) {
+    mex_abort("The checkpoint file {} does not match the rx_softbuffer_pool configuration.", filename);
+  }
+
+  uint64_t             key      = storage.store(mem);
+  TypedArray<uint64_t> pool_key = factory.createScalar(key);
+  outputs[0]                    = pool_key;
+}
+
 void MexFunction::method_release(ArgumentList outputs, ArgumentList inputs)
 {
   if (outputs.size() != 0) {
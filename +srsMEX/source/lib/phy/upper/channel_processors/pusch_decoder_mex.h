@@ -23,13 +23,20 @@
 #pragma once
 
 #include "srsran_matlab/srsran_mex_dispatcher.h"
+#include "srsran_matlab/support/checkpoint_file.h"
+#include "srsran_matlab/support/compressed_rx_buffer_pool.h"
+#include "srsran_matlab/support/harq_entity.h"
 #include "srsran_matlab/support/memento.h"
 #include "srsran/phy/upper/channel_processors/pusch/factories.h"
 #include "srsran/phy/upper/channel_processors/pusch/pusch_decoder.h"
+#include "srsran/phy/upper/channel_processors/pusch/pusch_decoder_result.h"
 #include "srsran/phy/upper/rx_buffer.h"
 #include "srsran/phy/upper/rx_buffer_pool.h"
 #include "srsran/phy/upper/unique_rx_buffer.h"
+#include "srsran/ran/slot_point.h"
+#include <map>
 #include <memory>
+#include <utility>
 
 /// \brief Factory method for a PUSCH decoder.
 ///
@@ -44,18 +51,42 @@ class MexFunction : public srsran_mex_dispatcher
   class pusch_memento
   {
   public:
+    /// Occupancy and eviction counters of the softbuffer pool.
+    struct pool_status {
+      /// Number of reserved softbuffers.
+      unsigned nof_buffers = 0;
+      /// Number of codeblocks of the reserved softbuffers.
+      unsigned nof_codeblocks = 0;
+      /// Maximum number of softbuffers reserved at the same time.
+      unsigned max_nof_buffers = 0;
+      /// Maximum number of codeblocks reserved at the same time.
+      unsigned max_nof_codeblocks = 0;
+      /// Number of softbuffers released by the pool because they expired.
+      uint64_t nof_expired_buffers = 0;
+    };
+
     /// \brief Creator.
     ///
-    /// The memento object consists of the pointer to the \c rx_buffer_pool used by the PUSCH decoder to store and
-    /// combine LLRs from different retransmissions as well as segment data corresponding to decoded codeblocks that
-    /// pass the CRC checksum.
-    explicit pusch_memento(std::unique_ptr<srsran::rx_buffer_pool_controller> p) : pool(std::move(p)) {}
+    /// The memento object consists of the \c rx_buffer_pool used by the PUSCH decoder to store and combine LLRs from
+    /// different retransmissions as well as segment data corresponding to decoded codeblocks that pass the CRC
+    /// checksum. With full-width (8-bit) soft bits and no checkpoints, the pool is the srsRAN one. Otherwise, it is a
+    /// srsran_matlab::compressed_rx_buffer_pool, whose state can be saved to a checkpoint. Optionally, the memento
+    /// also owns the HARQ entity that schedules the transmissions decoded with the softbuffers of the pool.
+    /// \param[in] config              Softbuffer pool configuration.
+    /// \param[in] softbit_width       Number of bits of the stored soft bits (4, 6 or 8).
+    /// \param[in] enable_checkpoints  Boolean flag: true if the memento must support checkpoints.
+    /// \param[in] h                   HARQ entity (optional).
+    pusch_memento(const srsran::rx_buffer_pool_config&        config,
+                  unsigned                                    softbit_width,
+                  bool                                        enable_checkpoints,
+                  std::unique_ptr<srsran_matlab::harq_entity> h = nullptr);
 
     /// \brief Gets a softbuffer from the softbuffer pool stored in the memento.
     ///
     /// This function requests a softbuffer to the softbuffer pool stored in the memento. Depending on whether a
     /// softbuffer with the same ID and number of codeblocks exists or not, the pool will return the existing
-    /// softbuffer or create a new one.
+    /// softbuffer or create a new one. The softbuffer is reserved at the current slot of the pool (see run_slot()) and
+    /// expires if it is not reserved again within the expiration time.
     /// \param[in] id              Softbuffer identifier (UE RNTI and HARQ process ID).
     /// \param[in] nof_codeblocks  Number of codeblocks forming the codeword (or, equivalently, the transport block).
     /// \param[in] is_new_data     Boolean flag: true if the softbuffer is requested for a new transmission, false if
@@ -64,9 +95,85 @@ class MexFunction : public srsran_mex_dispatcher
     srsran::unique_rx_buffer
     retrieve_softbuffer(const srsran::trx_buffer_identifier& id, unsigned nof_codeblocks, bool is_new_data);
 
+    /// \brief Advances the softbuffer pool to the given slot.
+    ///
+    /// The pool releases the softbuffers that expire at or before the given slot. Nothing happens if the slot is the
+    /// current one.
+    void run_slot(const srsran::slot_point& slot);
+
+    /// \brief Notifies the memento that a softbuffer was released outside the pool.
+    ///
+    /// The PUSCH decoder releases the softbuffer of a transport block that passes the CRC or that ends the RV
+    /// sequence of its HARQ process.
+    void on_softbuffer_released(const srsran::trx_buffer_identifier& id);
+
+    /// Returns the occupancy and eviction counters of the softbuffer pool.
+    const pool_status& get_status() const { return status; }
+
+    /// Returns the current slot of the softbuffer pool.
+    const srsran::slot_point& get_slot() const { return current_slot; }
+
+    /// Returns the number of bytes of the softbuffer pool persistently storing soft bits.
+    std::size_t get_softbit_storage_size() const
+    {
+      return compressed_pool ? compressed_pool->get_softbit_storage_size() : full_width_storage_size;
+    }
+
+    /// Returns the number of bytes storing soft bits of a softbuffer pool with full-width soft bits.
+    std::size_t get_full_width_storage_size() const { return full_width_storage_size; }
+
+    /// Returns a pointer to the HARQ entity stored in the memento, \c nullptr if there is none.
+    srsran_matlab::harq_entity* get_harq_entity() { return harq.get(); }
+
+    /// Returns true if the state of the memento can be saved to a checkpoint.
+    bool supports_checkpoints() const { return compressed_pool != nullptr; }
+
+    /// \brief Writes the state of the memento to a checkpoint.
+    ///
+    /// The state consists of the current slot, the reservations and counters of the softbuffer pool, the state of the
+    /// HARQ entity (if any) and the content of the reserved softbuffers. The memento must support checkpoints.
+    void save(srsran_matlab::checkpoint_writer& writer) const;
+
+    /// \brief Restores the state of the memento from a checkpoint.
+    ///
+    /// The checkpoint must come from a memento with the same configuration.
+    /// \return True on success, false if the checkpoint is not valid for the memento (the memento is then in an
+    /// unspecified state).
+    bool load(srsran_matlab::checkpoint_reader& reader);
+
   private:
-    /// Pointer to the softbuffer pool stored in the memento.
+    /// Reservation of a softbuffer, as tracked by the memento.
+    struct reservation {
+      /// Slot at which the softbuffer expires.
+      srsran::slot_point expiration;
+      /// Number of codeblocks of the softbuffer.
+      unsigned nof_codeblocks;
+    };
+
+    /// Softbuffer reservations, indexed by RNTI and HARQ process ID.
+    using reservation_map = std::map<std::pair<uint16_t, unsigned>, reservation>;
+
+    /// Removes a softbuffer from the reservations, updates the counters and returns the next reservation.
+    reservation_map::iterator erase_reservation(reservation_map::iterator it);
+
+    /// Pointer to the srsRAN softbuffer pool stored in the memento (full-width soft bits only).
     std::unique_ptr<srsran::rx_buffer_pool_controller> pool;
+    /// Pointer to the compressed softbuffer pool stored in the memento (compressed soft bits only).
+    std::unique_ptr<srsran_matlab::compressed_rx_buffer_pool> compressed_pool;
+    /// Pointer to the HARQ entity stored in the memento.
+    std::unique_ptr<srsran_matlab::harq_entity> harq;
+    /// Softbuffer expiration time as a number of slots.
+    unsigned expire_timeout_slots;
+    /// Number of bytes storing soft bits of a softbuffer pool with full-width soft bits.
+    std::size_t full_width_storage_size;
+    /// Current slot of the softbuffer pool.
+    srsran::slot_point current_slot = {0, 0};
+    /// \brief Softbuffers reserved in the pool.
+    ///
+    /// The pool does not report its occupancy: the memento mirrors the reservations, releases and expirations.
+    reservation_map reservations;
+    /// Occupancy and eviction counters of the softbuffer pool.
+    pool_status status;
   };
 
 public:
@@ -83,6 +190,11 @@ public:
     create_callback("new", [this](ArgumentList out, ArgumentList in) { this->method_new(out, in); });
     create_callback("step", [this](ArgumentList out, ArgumentList in) { this->method_step(out, in); });
     create_callback("reset_crcs", [this](ArgumentList out, ArgumentList in) { this->method_reset_crcs(out, in); });
+    create_callback("step_harq", [this](ArgumentList out, ArgumentList in) { this->method_step_harq(out, in); });
+    create_callback("harq_status", [this](ArgumentList out, ArgumentList in) { this->method_harq_status(out, in); });
+    create_callback("pool_status", [this](ArgumentList out, ArgumentList in) { this->method_pool_status(out, in); });
+    create_callback("save", [this](ArgumentList out, ArgumentList in) { this->method_save(out, in); });
+    create_callback("load", [this](ArgumentList out, ArgumentList in) { this->method_load(out, in); });
     create_callback("release", [this](ArgumentList out, ArgumentList in) { this->method_release(out, in); });
   }
 
@@ -99,29 +211,90 @@ private:
   srsran::unique_rx_buffer
   retrieve_softbuffer(uint64_t key, const srsran::trx_buffer_identifier& id, unsigned nof_codeblocks, bool is_new_data);
 
+  /// \brief Creates a memento object.
+  ///
+  /// \param[in] inputs   The inputs of the MEX method.
+  /// \param[in] i_first  Index of the input with the softbuffer pool configuration, optionally followed by the input
+  ///                     with the HARQ entity configuration (see method_new()).
+  /// \return A pointer to the new PUSCH memento. The function aborts the MEX if the configuration is not valid.
+  std::shared_ptr<pusch_memento> create_memento(ArgumentList inputs, unsigned i_first);
+
+  /// \brief Retrieves a memento object.
+  ///
+  /// \param[in] key  The PUSCH memento identifier.
+  /// \return A pointer to the PUSCH memento associated to the given identifier. The function aborts the MEX if the
+  /// memento does not exist.
+  std::shared_ptr<pusch_memento> retrieve_memento(uint64_t key);
+
+  /// \brief Retrieves a memento object with a HARQ entity.
+  ///
+  /// \param[in] key  The PUSCH memento identifier.
+  /// \return A pointer to the PUSCH memento associated to the given identifier. The function aborts the MEX if the
+  /// memento does not exist or if it has no HARQ entity.
+  std::shared_ptr<pusch_memento> retrieve_harq_memento(uint64_t key);
+
   /// Checks that outputs/inputs arguments match the requirements of method_step().
   void check_step_outputs_inputs(matlab::mex::ArgumentList outputs, matlab::mex::ArgumentList inputs);
 
+  /// \brief Reads the decoder configuration from the segment configuration structure.
+  ///
+  /// \param[in] in_seg_cfg  A segment configuration structure (see method_step()).
+  /// \param[in] new_data    Boolean flag: true for new transmissions, false for retransmissions.
+  /// \return The PUSCH decoder configuration (the RV is read from the structure).
+  srsran::pusch_decoder::configuration read_decoder_config(const matlab::data::Struct& in_seg_cfg, bool new_data);
+
+  /// \brief Reads the current slot of a softbuffer pool.
+  ///
+  /// \param[in] in_slot  A scalar with the number of slots since the creation of the pool (see method_pool_status()).
+  /// \return The corresponding slot point.
+  srsran::slot_point read_slot(const matlab::data::Array& in_slot);
+
+  /// \brief Decodes one codeword with the given softbuffer.
+  ///
+  /// \param[out] transport_block  Decoded transport block (in packed format).
+  /// \param[in]  softbuffer       Softbuffer for combining the LLRs.
+  /// \param[in]  llrs             Codeword log-likelihood ratios.
+  /// \param[in]  cfg              PUSCH decoder configuration.
+  /// \return The PUSCH decoder result.
+  srsran::pusch_decoder_result decode(srsran::span<uint8_t>                            transport_block,
+                                      srsran::unique_rx_buffer                         softbuffer,
+                                      srsran::span<const srsran::log_likelihood_ratio> llrs,
+                                      const srsran::pusch_decoder::configuration&      cfg);
+
+  /// Converts the PUSCH decoder result to a MATLAB structure of decoding statistics (see method_step()).
+  matlab::data::StructArray to_matlab(const srsran::pusch_decoder_result& result);
+
+  /// Converts the HARQ information of a transmission to a MATLAB structure (see method_step_harq()).
+  matlab::data::StructArray to_matlab(const srsran_matlab::harq_transmission& transmission);
+
   /// \brief Creates a new PUSCH decoder MEX object.
   ///
   /// Specifically, this method creates a new softbuffer pool that can be used by the PUSCH decoder for storing LLRs
   /// and decoded data (recall that MATLAB can only instantiate a single object for any MEX function). It is up to
   /// the users to manage the pools and use the correct one depending on the PUSCH transmission they are decoding.
   ///
-  /// The method accepts only two inputs.
+  /// The method accepts two or three inputs.
   ///   - The string <tt>"new"</tt>.
   ///   - A one-dimensional structure with fields (see also srsran::rx_softbuffer_pool_description):
   ///      - \c MaxCodeblockSize, maximum size of the codeblocks stored in the pool;
   ///      - \c MaxSoftbuffers, maximum number of softbuffers managed by the pool;
-  ///      - \c MaxCodeblocks, maximum number of codeblocks managed by the pool (shared by all softbuffers); and
-  ///      - \c ExpireTimeoutSlots, softbuffer expiration time as a number of slots.
+  ///      - \c MaxCodeblocks, maximum number of codeblocks managed by the pool (shared by all softbuffers);
+  ///      - \c ExpireTimeoutSlots, softbuffer expiration time as a number of slots;
+  ///      - \c SoftbitWidth, number of bits of the stored soft bits (8 for full width, 6 or 4 for compressed soft bits,
+  ///        see srsran_matlab::compressed_rx_buffer_pool); and
+  ///      - \c EnableCheckpoints, a logical flag enabling the save and load of the pool state (see method_save()).
+  ///   - Optionally, a one-dimensional structure that configures the HARQ entity attached to the pool (see
+  ///     method_step_harq()), with fields
+  ///      - \c RNTI, the UE RNTI;
+  ///      - \c HARQProcessSequence, the fixed sequence of HARQ process IDs scheduling the transmissions;
+  ///      - \c RVSequence, the redundancy version sequence shared by all HARQ processes.
   ///
   /// The only output of the method is the identifier of the created pool (a \c uint64_t number).
   void method_new(ArgumentList outputs, ArgumentList inputs);
 
   /// \brief Decodes one codeword.
   ///
-  /// The method takes six inputs.
+  /// The method takes six or seven inputs.
   ///   - The string <tt>"step"</tt>.
   ///   - A softbuffer pool identifier (a \c uint64_t number).
   ///   - An array of \c int8 containing the codeword log-likelihood ratios.
@@ -139,6 +312,8 @@ private:
   ///      - \c HARQProcessID, the ID of the HARQ process;
   ///      - \c RNTI, the UE RNTI;
   ///      - \c NumCodeblocks, the number of codeblocks forming the codeword.
+  ///   - The current slot, as a number of slots since the creation of the pool (optional, see
+  ///     method_pool_status()).
   ///
   /// The method has two outputs.
   ///   - The decoded transport block (in packed format).
@@ -150,17 +325,121 @@ private:
 
   /// \brief Resets the CRC status of a softbuffer.
   ///
-  /// The method takes three inputs.
+  /// The method takes three or four inputs.
   ///   - The string <tt>"reset_crcs"</tt>.
   ///   - A softbuffer pool identifier (a \c uint64_t number).
   ///   - A one-dimensional structure with fields
   ///      - \c HARQProcessID, the ID of the HARQ process;
   ///      - \c RNTI, the UE RNTI;
   ///      - \c NumCodeblocks, the number of codeblocks forming the codeword.
+  ///   - The current slot (optional, see method_pool_status()).
   ///
   /// The method has no outputs.
   void method_reset_crcs(ArgumentList outputs, ArgumentList inputs);
 
+  /// \brief Decodes the codeword of the current transmission of a HARQ entity.
+  ///
+  /// The HARQ entity attached to the softbuffer pool decides the HARQ process, the redundancy version and the new
+  /// data flag of the transmission. It also manages the softbuffer of the process: the CRCs are reset at the start of
+  /// every redundancy version sequence and the softbuffer goes back to the pool as soon as the last transmission of
+  /// the sequence is decoded. Once the codeword is decoded, the entity updates the process with the CRC outcome and
+  /// moves to the next process of the sequence.
+  ///
+  /// The method takes four or five inputs.
+  ///   - The string <tt>"step_harq"</tt>.
+  ///   - A softbuffer pool identifier (a \c uint64_t number). The pool must have a HARQ entity (see method_new()).
+  ///   - An array of \c int8 containing the codeword log-likelihood ratios.
+  ///   - A one-dimensional structure that describes the segmentation of the transport block, as in method_step()
+  ///     with the additional field \c NumCodeblocks. The field \c RV is ignored.
+  ///   - The current slot (optional, see method_pool_status()).
+  ///
+  /// The method has three outputs.
+  ///   - The decoded transport block (in packed format).
+  ///   - A one-dimensional structure with decoding statistics, as in method_step().
+  ///   - A one-dimensional structure with the HARQ information of the next transmission. The fields are
+  ///      - \c HARQProcessID, the ID of the HARQ process;
+  ///      - \c TransmissionNumber, the transmission number in the RV sequence (0-based);
+  ///      - \c RedundancyVersion, the redundancy version;
+  ///      - \c NewData, equal to \c true if the transmission starts a new RV sequence;
+  ///      - \c SequenceTimeout, equal to \c true if the previous RV sequence of the process ended without success.
+  void method_step_harq(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Reports the status of a HARQ entity.
+  ///
+  /// The method takes two inputs.
+  ///   - The string <tt>"harq_status"</tt>.
+  ///   - A softbuffer pool identifier (a \c uint64_t number). The pool must have a HARQ entity (see method_new()).
+  ///
+  /// The method has two outputs.
+  ///   - A one-dimensional structure with the HARQ information of the next transmission, as in method_step_harq().
+  ///   - A structure array with the statistics of each HARQ process, sorted by HARQ process ID. The fields are
+  ///      - \c HARQProcessID, the ID of the HARQ process;
+  ///      - \c NumTransmissions, the number of transmissions, including retransmissions;
+  ///      - \c NumNewTransmissions, the number of new data transmissions;
+  ///      - \c NumTimeouts, the number of RV sequences that ended without success;
+  ///      - \c TotalBits, the number of transmitted information bits;
+  ///      - \c SuccessfulBits, the number of successfully received information bits;
+  ///      - \c NumSuccesses, the number of successful receptions for each transmission number (a row vector).
+  void method_harq_status(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Reports the occupancy of a softbuffer pool.
+  ///
+  /// The pool keeps track of time with a slot counter, starting at zero when the pool is created. The methods that
+  /// access the softbuffers take the current slot as optional last input and advance the pool to it before reserving
+  /// a softbuffer: the softbuffers that have not been reserved for \c ExpireTimeoutSlots slots (see method_new()) are
+  /// released by the pool. The slot counter cannot move backwards by more than half its range. Without the slot
+  /// input, the decoding methods advance the pool by one slot after decoding, while the other methods stay at the
+  /// current slot.
+  ///
+  /// The method takes two or three inputs.
+  ///   - The string <tt>"pool_status"</tt>.
+  ///   - A softbuffer pool identifier (a \c uint64_t number).
+  ///   - The current slot (optional).
+  ///
+  /// The method has one output, a one-dimensional structure with fields
+  ///   - \c Slot, the current slot of the pool;
+  ///   - \c NumBuffers, the number of reserved softbuffers;
+  ///   - \c NumCodeblocks, the number of codeblocks of the reserved softbuffers;
+  ///   - \c MaxNumBuffers, the maximum number of softbuffers reserved at the same time;
+  ///   - \c MaxNumCodeblocks, the maximum number of codeblocks reserved at the same time;
+  ///   - \c NumExpiredBuffers, the number of softbuffers released because they expired;
+  ///   - \c StorageBytes, the number of bytes storing soft bits;
+  ///   - \c FullWidthStorageBytes, the number of bytes storing soft bits with full-width (8-bit) soft bits.
+  void method_pool_status(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Saves the state of a softbuffer pool to a checkpoint file.
+  ///
+  /// The checkpoint contains the current slot and the counters of the pool, the state and statistics of its HARQ
+  /// entity (if any) and the content of the reserved softbuffers, so that a simulation can resume in the middle of
+  /// the RV sequences after <tt>clear mex</tt> or a MATLAB restart (see method_load()). The pool must have been created
+  /// with checkpoints enabled (see method_new()). The file is written in a compact binary format with the native byte
+  /// order: it is meant to be loaded on the same machine.
+  ///
+  /// The method takes three inputs.
+  ///   - The string <tt>"save"</tt>.
+  ///   - A softbuffer pool identifier (a \c uint64_t number).
+  ///   - The name of the checkpoint file (a character array).
+  ///
+  /// The only output of the method is the checkpoint identifier (a \c uint64_t number), a hash of the saved state
+  /// that is also stored in the file header. Loading the checkpoint requires it (see method_load()).
+  void method_save(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Creates a softbuffer pool from a checkpoint file.
+  ///
+  /// The method creates a new pool, as method_new() does, and restores its state from a checkpoint file written by
+  /// method_save(). The file is mapped into memory and must come from a pool with the same configuration. The method
+  /// fails if the file holds a checkpoint other than the requested one, e.g., because a later save overwrote it.
+  ///
+  /// The method takes four or five inputs.
+  ///   - The string <tt>"load"</tt>.
+  ///   - The name of the checkpoint file (a character array).
+  ///   - The checkpoint identifier returned by method_save() (a \c uint64_t number).
+  ///   - The softbuffer pool configuration, as in method_new(), with checkpoints enabled.
+  ///   - Optionally, the HARQ entity configuration, as in method_new().
+  ///
+  /// The only output of the method is the identifier of the created pool (a \c uint64_t number).
+  void method_load(ArgumentList outputs, ArgumentList inputs);
+
   /// \brief Releases a softbuffer pool.
   ///
   /// The method takes, as input, a softbuffer pool identifier (a \c uint64_t number). It returns 1 if the
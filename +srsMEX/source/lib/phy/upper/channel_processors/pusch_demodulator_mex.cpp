@@ -21,6 +21,7 @@
 #include "srsran_matlab/support/matlab_to_srs.h"
 #include "srsran_matlab/support/resource_grid.h"
 #include "srsran_matlab/support/to_span.h"
+#include "srsran_matlab/support/ulsch_demultiplex_helpers.h"
 #include "srsran/phy/upper/channel_processors/pusch/pusch_codeword_buffer.h"
 #include "srsran/phy/upper/channel_processors/pusch/pusch_demodulator_notifier.h"
 #include <optional>
@@ -129,11 +130,21 @@ void MexFunction::method_new(ArgumentList outputs, ArgumentList inputs)
   if (!demodulator) {
     mex_abort("Cannot create srsRAN PUSCH demodulator.");
   }
+
+  std::shared_ptr<ulsch_demultiplex_factory> demux_factory = create_ulsch_demultiplex_factory_sw();
+  if (!demux_factory) {
+    mex_abort("Cannot create srsRAN UL-SCH demultiplexer factory.");
+  }
+
+  demultiplexer = demux_factory->create();
+  if (!demultiplexer) {
+    mex_abort("Cannot create srsRAN UL-SCH demultiplexer.");
+  }
 }
 
 void MexFunction::check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs)
 {
-  if (inputs.size() != 5) {
+  if ((inputs.size() != 5) && (inputs.size() != 6)) {
     mex_abort("Wrong number of inputs.");
   }
 
@@ -153,6 +164,17 @@ void MexFunction::check_step_outputs_inputs(ArgumentList outputs, ArgumentList i
     mex_abort("Input 'PUSCHDemConfig' must be a scalar structure.");
   }
 
+  if (inputs.size() == 6) {
+    if ((inputs[5].getType() != ArrayType::STRUCT) || (inputs[5].getNumberOfElements() != 1)) {
+      mex_abort("Input 'demuxConfig' must be a scalar structure.");
+    }
+
+    if (outputs.size() != 4) {
+      mex_abort("Wrong number of outputs.");
+    }
+    return;
+  }
+
   if (outputs.size() != 1) {
     mex_abort("Wrong number of outputs.");
   }
@@ -255,6 +277,48 @@ void MexFunction::method_step(ArgumentList outputs, ArgumentList inputs)
   // Compute expected soft output bit number.
   unsigned nof_expected_soft_output_bits = in_dem_cfg["NumOutputLLR"][0];
 
+  if (inputs.size() == 6) {
+    if (!demultiplexer) {
+      mex_abort("UL-SCH demultiplexer was not initialized properly.");
+    }
+
+    const StructArray            in_demux_array = inputs[5];
+    ulsch_demultiplex_mex_config demux_config   = read_ulsch_demultiplex_config(in_demux_array[0]);
+
+    auto create_output = [this](unsigned size) { return factory.createArray<int8_t>({size, 1}); };
+    TypedArray<int8_t> out_sch_data  = create_output(demux_config.nof_enc_ulsch_bits);
+    TypedArray<int8_t> out_harq_ack  = create_output(demux_config.config.nof_enc_harq_ack_bits);
+    TypedArray<int8_t> out_csi_part1 = create_output(demux_config.config.nof_enc_csi_part1_bits);
+    TypedArray<int8_t> out_csi_part2 = create_output(demux_config.nof_enc_csi_part2_bits);
+
+    // Empty MATLAB arrays have no valid data pointer.
+    auto as_llr_span = [](TypedArray<int8_t>& array) {
+      return array.isEmpty() ? span<log_likelihood_ratio>() : to_span<int8_t, log_likelihood_ratio>(array);
+    };
+    llr_array_decoder_buffer sch_data(as_llr_span(out_sch_data));
+    llr_array_decoder_buffer harq_ack(as_llr_span(out_harq_ack));
+    llr_array_decoder_buffer csi_part1(as_llr_span(out_csi_part1));
+    llr_array_decoder_buffer csi_part2(as_llr_span(out_csi_part2));
+
+    // The demodulator writes the soft bits of each OFDM symbol directly into the demultiplexer, which also takes care
+    // of the scrambling placeholders.
+    pusch_codeword_buffer& cw_buffer = demultiplexer->demultiplex(sch_data, harq_ack, csi_part1, demux_config.config);
+    demultiplexer->set_csi_part2(csi_part2, demux_config.nof_csi_part2_bits, demux_config.nof_enc_csi_part2_bits);
+
+    pusch_demodulator_notifier_spy notifier;
+    demodulator->demodulate(cw_buffer, notifier.get_notifier(), grid->get_reader(), chan_estimates, demodulator_config);
+
+    if (!sch_data.is_complete() || !harq_ack.is_complete() || !csi_part1.is_complete() || !csi_part2.is_complete()) {
+      mex_abort("The UL-SCH demultiplexer did not fill all the fields.");
+    }
+
+    outputs[0] = out_sch_data;
+    outputs[1] = out_harq_ack;
+    outputs[2] = out_csi_part1;
+    outputs[3] = out_csi_part2;
+    return;
+  }
+
   TypedArray<int8_t>         out       = factory.createArray<int8_t>({nof_expected_soft_output_bits, 1});
   span<log_likelihood_ratio> soft_bits = to_span<int8_t, log_likelihood_ratio>(out);
   pusch_codeword_buffer_spy  sch_data(soft_bits);
@@ -25,6 +25,7 @@
 #include "srsran_matlab/srsran_mex_dispatcher.h"
 #include "srsran/phy/upper/channel_processors/pusch/factories.h"
 #include "srsran/phy/upper/channel_processors/pusch/pusch_demodulator.h"
+#include "srsran/phy/upper/channel_processors/pusch/ulsch_demultiplex.h"
 #include "srsran/phy/upper/equalization/channel_equalizer_algorithm_type.h"
 #include "srsran/phy/upper/equalization/equalization_factories.h"
 
@@ -66,7 +67,7 @@ private:
 
   /// \brief Demodulates a PUSCH transmission according to the given configuration.
   ///
-  /// The method takes five inputs.
+  /// The method takes five or six inputs.
   ///   - The string <tt>"step"</tt>.
   ///   - A three-dimensional array of \c cf_t containing the receiver-side resource grid.
   ///   - A three-dimensional array of \c cf_t containing the estimated channel coefficients for all REs of all Rx ports
@@ -85,13 +86,21 @@ private:
   ///      - \c NumLayers, number of transmit layers;
   ///      - \c Placeholders, ULSCH Scrambling placeholder list;
   ///      - \c RxPorts, receive antenna port indices the PUSCH transmission is mapped to;
+  ///   - Optionally, a one-dimensional structure with the UL-SCH demultiplexer configuration, as described in
+  ///     srsran_matlab::read_ulsch_demultiplex_config().
   ///
-  /// The method has one single output.
+  /// Without the demultiplexer configuration, the method has one single output.
   ///   - An array of \c log_likelihood_ratio resulting from the PUSCH demodulation.
+  ///
+  /// With the demultiplexer configuration, the demodulated soft bits are passed directly to the srsRAN UL-SCH
+  /// demultiplexer and the method has four outputs, namely the arrays of \c log_likelihood_ratio of UL-SCH data,
+  /// HARQ-ACK, CSI Part 1 and CSI Part 2.
   void method_step(ArgumentList outputs, ArgumentList inputs);
 
   /// A pointer to the actual PUSCH decoder.
   std::unique_ptr<srsran::pusch_demodulator> demodulator = nullptr;
+  /// A pointer to the UL-SCH demultiplexer the demodulated soft bits can be passed to.
+  std::unique_ptr<srsran::ulsch_demultiplex> demultiplexer = nullptr;
 };
 
 inline std::unique_ptr<srsran::pusch_demodulator>
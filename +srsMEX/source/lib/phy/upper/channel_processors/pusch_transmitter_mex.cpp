@@ -0,0 +1,258 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+#include "pusch_transmitter_mex.h"
+#include "srsran_matlab/support/factory_functions.h"
+#include "srsran_matlab/support/matlab_to_srs.h"
+#include "srsran_matlab/support/resource_grid.h"
+#include "srsran_matlab/support/to_span.h"
+#include "srsran/adt/bit_buffer.h"
+#include "srsran/phy/support/resource_grid_writer.h"
+#include "srsran/phy/upper/codeblock_metadata.h"
+#include "srsran/ran/precoding/precoding_codebooks.h"
+#include "srsran/ran/slot_point.h"
+#include "srsran/srsvec/bit.h"
+#include "srsran/srsvec/copy.h"
+#include "srsran/srsvec/zero.h"
+#include <array>
+#include <cmath>
+#include <vector>
+
+using matlab::mex::ArgumentList;
+using namespace matlab::data;
+using namespace srsran;
+using namespace srsran_matlab;
+
+dft_processor& MexFunction::get_transform_precoder(unsigned size)
+{
+  auto it = transform_precoders.find(size);
+  if (it != transform_precoders.end()) {
+    return *it->second;
+  }
+
+  std::unique_ptr<dft_processor> dft = components.dft_factory->create({size, dft_processor::direction::DIRECT});
+  if (!dft) {
+    mex_abort("Cannot create transform precoder of size {}.", size);
+  }
+
+  return *transform_precoders.emplace(size, std::move(dft)).first->second;
+}
+
+void MexFunction::check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 3;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if (inputs[1].getType() != ArrayType::UINT8) {
+    mex_abort("Input 'transportBlock' must be an array of uint8_t.");
+  }
+
+  if ((inputs[2].getType() != ArrayType::STRUCT) || (inputs[2].getNumberOfElements() > 1)) {
+    mex_abort("Input 'PUSCHConfig' must be a scalar structure.");
+  }
+
+  constexpr unsigned NOF_OUTPUTS = 1;
+  if (outputs.size() != NOF_OUTPUTS) {
+    mex_abort("Wrong number of outputs: expected {}, provided {}.", NOF_OUTPUTS, outputs.size());
+  }
+}
+
+void MexFunction::method_step(ArgumentList outputs, ArgumentList inputs)
+{
+  check_step_outputs_inputs(outputs, inputs);
+
+  const TypedArray<uint8_t> in_tb_array     = inputs[1];
+  span<const uint8_t>       transport_block = to_span(in_tb_array);
+
+  StructArray  in_struct_array = inputs[2];
+  const Struct in_cfg          = in_struct_array[0];
+
+  // Resource grid dimensions.
+  unsigned        nof_grid_rb     = in_cfg["NSizeGrid"][0];
+  const CharArray in_cp           = in_cfg["CyclicPrefix"];
+  cyclic_prefix   cp              = matlab_to_srs_cyclic_prefix(in_cp.toAscii());
+  unsigned        nof_symbols     = get_nsymb_per_slot(cp);
+  unsigned        nof_layers      = in_cfg["NumLayers"][0];
+  unsigned        nof_subcarriers = nof_grid_rb * NRE;
+
+  // Frequency allocation (contiguous PRB allocation is assumed).
+  const TypedArray<bool> in_rb_mask = in_cfg["RBMask"];
+  if (in_rb_mask.getNumberOfElements() != nof_grid_rb) {
+    mex_abort("The RB mask size (i.e., {}) does not match the grid size (i.e., {}).",
+              in_rb_mask.getNumberOfElements(),
+              nof_grid_rb);
+  }
+  crb_bitmap rb_mask(in_rb_mask.cbegin(), in_rb_mask.cend());
+  int        start_rb = rb_mask.find_lowest();
+  unsigned   nof_rb   = rb_mask.count();
+  if ((start_rb < 0) || (!rb_mask.is_contiguous())) {
+    mex_abort("The PUSCH frequency allocation must be non-empty and contiguous.");
+  }
+
+  // Time allocation.
+  unsigned                           start_symbol = in_cfg["StartSymbolIndex"][0];
+  unsigned                           nof_alloc    = in_cfg["NumSymbols"][0];
+  const TypedArray<bool>             in_dmrs_pos  = in_cfg["DMRSSymbPos"];
+  bounded_bitset<MAX_NSYMB_PER_SLOT> dmrs_symb_pos(in_dmrs_pos.cbegin(), in_dmrs_pos.cend());
+
+  // DM-RS and modulation parameters.
+  dmrs_type         dmrs                        = matlab_to_srs_dmrs_type(in_cfg["DMRSConfigType"][0]);
+  unsigned          nof_cdm_groups_without_data = in_cfg["NumCDMGroupsWithoutData"][0];
+  bool              enable_transform_precoding  = in_cfg["TransformPrecoding"][0];
+  float             dmrs_amplitude              = static_cast<float>(static_cast<double>(in_cfg["DMRSAmplitude"][0]));
+  const CharArray   in_modulation               = in_cfg["Modulation"];
+  modulation_scheme modulation                  = matlab_to_srs_modulation(in_modulation.toAscii());
+
+  if (start_symbol + nof_alloc > nof_symbols) {
+    mex_abort("The time allocation [{}, {}) exceeds the slot.", start_symbol, start_symbol + nof_alloc);
+  }
+
+  if (enable_transform_precoding && (nof_layers != 1)) {
+    mex_abort("Transform precoding requires one layer, provided {}.", nof_layers);
+  }
+
+  if (enable_transform_precoding && (nof_cdm_groups_without_data != 2)) {
+    mex_abort("Transform precoding requires two CDM groups without data, provided {}.", nof_cdm_groups_without_data);
+  }
+
+  // Count the REs carrying data: on DM-RS symbols, the REs of the CDM groups without data are not used.
+  unsigned nof_dmrs_re_per_cdm_group = (dmrs == dmrs_type::TYPE1) ? 6 : 4;
+  unsigned nof_re                    = 0;
+  for (unsigned i_symbol = start_symbol, i_end = start_symbol + nof_alloc; i_symbol != i_end; ++i_symbol) {
+    unsigned nof_re_prb = NRE;
+    if (dmrs_symb_pos.test(i_symbol)) {
+      nof_re_prb -= nof_cdm_groups_without_data * nof_dmrs_re_per_cdm_group;
+    }
+    nof_re += nof_re_prb * nof_rb;
+  }
+
+  // Encode the transport block.
+  segmenter_config encoder_config;
+  encoder_config.base_graph     = matlab_to_srs_base_graph(in_cfg["BGN"][0]);
+  encoder_config.rv             = in_cfg["RV"][0];
+  encoder_config.mod            = modulation;
+  encoder_config.Nref           = in_cfg["LimitedBufferSize"][0];
+  encoder_config.nof_layers     = nof_layers;
+  encoder_config.nof_ch_symbols = nof_re * nof_layers;
+
+  unsigned             nof_cw_bits = encoder_config.nof_ch_symbols * get_bits_per_symbol(modulation);
+  std::vector<uint8_t> codeword(nof_cw_bits);
+  components.encoder->encode(codeword, transport_block, encoder_config);
+
+  dynamic_bit_buffer packed_codeword(nof_cw_bits);
+  srsvec::bit_pack(packed_codeword, codeword);
+
+  // Prepare the resource grid.
+  std::unique_ptr<resource_grid> grid = create_resource_grid(nof_subcarriers, nof_symbols, nof_layers);
+  if (!grid) {
+    mex_abort("Cannot create resource grid.");
+  }
+  grid->set_all_zero();
+  resource_grid_writer& writer = grid->get_writer();
+
+  unsigned n_id = in_cfg["NID"][0];
+  unsigned rnti = in_cfg["RNTI"][0];
+
+  if (!enable_transform_precoding) {
+    // Scramble, modulate, layer-map and map the codeword.
+    pdsch_modulator::config_t modulator_config;
+    modulator_config.rnti                        = rnti;
+    modulator_config.bwp                         = {0, nof_grid_rb};
+    modulator_config.modulation1                 = modulation;
+    modulator_config.modulation2                 = modulation;
+    modulator_config.freq_allocation             = rb_allocation::make_type1(start_rb, nof_rb);
+    modulator_config.time_alloc                  = {start_symbol, start_symbol + nof_alloc};
+    modulator_config.dmrs_symb_pos               = dmrs_symb_pos;
+    modulator_config.dmrs_config_type            = dmrs;
+    modulator_config.nof_cdm_groups_without_data = nof_cdm_groups_without_data;
+    modulator_config.n_id                        = n_id;
+    modulator_config.scaling                     = 1.0F;
+    modulator_config.reserved                    = {};
+    modulator_config.precoding = precoding_configuration::make_wideband(make_identity(nof_layers));
+
+    std::array<bit_buffer, 1> codewords = {packed_codeword.first(nof_cw_bits)};
+    components.modulator->modulate(writer, codewords, modulator_config);
+
+    // Generate and map the DM-RS.
+    dmrs_pdsch_processor::config_t dmrs_config;
+    dmrs_config.slot = slot_point(to_numerology_value(matlab_to_srs_subcarrier_spacing(in_cfg["SubcarrierSpacing"][0])),
+                                  static_cast<unsigned>(in_cfg["NSlot"][0]));
+    dmrs_config.reference_point_k_rb = 0;
+    dmrs_config.type                 = dmrs;
+    dmrs_config.scrambling_id        = in_cfg["NIDNSCID"][0];
+    dmrs_config.n_scid               = (static_cast<unsigned>(in_cfg["NSCID"][0]) == 1);
+    dmrs_config.amplitude            = dmrs_amplitude;
+    dmrs_config.symbols_mask         = dmrs_symb_pos;
+    dmrs_config.rb_mask              = rb_mask;
+    dmrs_config.precoding            = precoding_configuration::make_wideband(make_identity(nof_layers));
+
+    components.dmrs->map(writer, dmrs_config);
+  } else {
+    // Scramble the codeword, as per TS38.211 Section 6.3.1.1 without UCI placeholders.
+    dynamic_bit_buffer scrambled_codeword(nof_cw_bits);
+    components.prg->init((rnti << 15U) + n_id);
+    components.prg->apply_xor(scrambled_codeword, packed_codeword);
+
+    // Modulate.
+    std::vector<cf_t> data_symbols(nof_re);
+    components.mapper->modulate(data_symbols, scrambled_codeword, modulation);
+
+    // Transform-precoded DM-RS sequence, as per TS38.211 Section 6.4.1.1.1.2 without group nor sequence hopping.
+    unsigned          nof_subc_alloc = nof_rb * NRE;
+    unsigned          u              = static_cast<unsigned>(in_cfg["NRSID"][0]) % 30;
+    std::vector<cf_t> dmrs_sequence(nof_subc_alloc / 2);
+    components.lpapr->generate(dmrs_sequence, u, 0, 0, NRE);
+
+    // DM-RS occupy the even subcarriers of CDM group 0, the odd subcarriers are left empty.
+    std::vector<cf_t> dmrs_symbol(nof_subc_alloc);
+    srsvec::zero(dmrs_symbol);
+    for (unsigned i_re = 0, i_end = dmrs_sequence.size(); i_re != i_end; ++i_re) {
+      dmrs_symbol[2 * i_re] = dmrs_amplitude * dmrs_sequence[i_re];
+    }
+
+    dft_processor&    precoder = get_transform_precoder(nof_subc_alloc);
+    float             scaling  = 1.0F / std::sqrt(static_cast<float>(nof_subc_alloc));
+    std::vector<cf_t> precoded(nof_subc_alloc);
+
+    span<const cf_t> data_view = data_symbols;
+    for (unsigned i_symbol = start_symbol, i_end = start_symbol + nof_alloc; i_symbol != i_end; ++i_symbol) {
+      if (dmrs_symb_pos.test(i_symbol)) {
+        writer.put(0, i_symbol, start_rb * NRE, dmrs_symbol);
+        continue;
+      }
+
+      // Transform precoding, as per TS38.211 Section 6.3.1.4.
+      srsvec::copy(precoder.get_input(), data_view.first(nof_subc_alloc));
+      data_view = data_view.last(data_view.size() - nof_subc_alloc);
+
+      span<const cf_t> dft_output = precoder.run();
+      for (unsigned i_re = 0; i_re != nof_subc_alloc; ++i_re) {
+        precoded[i_re] = scaling * dft_output[i_re];
+      }
+      writer.put(0, i_symbol, start_rb * NRE, precoded);
+    }
+  }
+
+  TypedArray<cf_t> out = factory.createArray<cf_t>({nof_subcarriers, nof_symbols, nof_layers});
+  write_resource_grid(out, grid->get_reader());
+
+  outputs[0] = out;
+}
@@ -0,0 +1,185 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief PUSCH transmitter MEX declaration.
+///
+/// srsRAN does not provide a PUSCH transmitter. However, in the absence of UCI multiplexing, the UL-SCH encoding,
+/// the PUSCH scrambling, modulation and layer mapping as well as the DM-RS sequence for non-transform-precoded
+/// transmissions coincide with their PDSCH counterparts. The MEX reuses the PDSCH encoder, modulator and DM-RS
+/// processor for these steps and implements transform precoding (and the corresponding low-PAPR DM-RS) on top of the
+/// srsRAN modulation mapper, pseudo-random generator, DFT processor and low-PAPR sequence generator.
+
+#pragma once
+
+#include "srsran_matlab/srsran_mex_dispatcher.h"
+#include "srsran/phy/generic_functions/dft_processor.h"
+#include "srsran/phy/generic_functions/generic_functions_factories.h"
+#include "srsran/phy/generic_functions/precoding/precoding_factories.h"
+#include "srsran/phy/support/support_factories.h"
+#include "srsran/phy/upper/channel_coding/channel_coding_factories.h"
+#include "srsran/phy/upper/channel_modulation/channel_modulation_factories.h"
+#include "srsran/phy/upper/channel_processors/pdsch/factories.h"
+#include "srsran/phy/upper/channel_processors/pdsch/pdsch_encoder.h"
+#include "srsran/phy/upper/channel_processors/pdsch/pdsch_modulator.h"
+#include "srsran/phy/upper/sequence_generators/sequence_generator_factories.h"
+#include "srsran/phy/upper/signal_processors/signal_processor_factories.h"
+#include <memory>
+#include <unordered_map>
+
+/// Collection of srsRAN components forming a PUSCH transmitter.
+struct pusch_transmitter_components {
+  /// UL-SCH encoder (identical to the DL-SCH one in the absence of UCI).
+  std::unique_ptr<srsran::pdsch_encoder> encoder;
+  /// Scrambler, modulator and mapper for non-transform-precoded transmissions.
+  std::unique_ptr<srsran::pdsch_modulator> modulator;
+  /// DM-RS generator and mapper for non-transform-precoded transmissions.
+  std::unique_ptr<srsran::dmrs_pdsch_processor> dmrs;
+  /// Modulation mapper for transform-precoded transmissions.
+  std::unique_ptr<srsran::modulation_mapper> mapper;
+  /// Scrambling sequence generator for transform-precoded transmissions.
+  std::unique_ptr<srsran::pseudo_random_generator> prg;
+  /// Low-PAPR sequence generator for the DM-RS of transform-precoded transmissions.
+  std::unique_ptr<srsran::low_papr_sequence_generator> lpapr;
+  /// DFT factory, used to create the transform precoders on demand.
+  std::shared_ptr<srsran::dft_processor_factory> dft_factory;
+};
+
+/// \brief Factory method for the PUSCH transmitter components.
+///
+/// Creates and assemblies all the necessary components (LDPC encoder, modulation mapper, DM-RS generator, DFT, ...)
+/// for a fully-functional PUSCH transmitter.
+inline pusch_transmitter_components create_pusch_transmitter();
+
+/// Implements a PUSCH transmitter following the srsran_mex_dispatcher template.
+class MexFunction : public srsran_mex_dispatcher
+{
+public:
+  /// \brief Constructor.
+  ///
+  /// Stores the string identifier&ndash;method pairs that form the public interface of the PUSCH transmitter MEX
+  /// object.
+  MexFunction()
+  {
+    // Ensure srsRAN PUSCH transmitter components were created successfully.
+    if (!components.encoder || !components.modulator || !components.dmrs || !components.mapper || !components.prg ||
+        !components.lpapr || !components.dft_factory) {
+      mex_abort("Cannot create srsRAN PUSCH transmitter.");
+    }
+
+    create_callback("step", [this](ArgumentList out, ArgumentList in) { this->method_step(out, in); });
+  }
+
+private:
+  /// Checks that outputs/inputs arguments match the requirements of method_step().
+  void check_step_outputs_inputs(matlab::mex::ArgumentList outputs, matlab::mex::ArgumentList inputs);
+
+  /// \brief Encodes, modulates and maps a PUSCH transmission according to the given configuration.
+  ///
+  /// The method takes three inputs.
+  ///   - The string <tt>"step"</tt>.
+  ///   - An array of \c uint8_t containing the transport block (in packed format).
+  ///   - A one-dimensional structure that describes the PUSCH transmission. The fields are
+  ///      - \c NSizeGrid, number of resource blocks of the resource grid;
+  ///      - \c CyclicPrefix, cyclic prefix (<tt>"normal"</tt> or <tt>"extended"</tt>);
+  ///      - \c SubcarrierSpacing, subcarrier spacing in kHz;
+  ///      - \c NSlot, slot number within the frame;
+  ///      - \c RNTI, radio network temporary identifier;
+  ///      - \c NID, scrambling identifier;
+  ///      - \c RBMask, allocation RB list (as a boolean mask, contiguous allocation is assumed);
+  ///      - \c Modulation, modulation scheme used for transmission;
+  ///      - \c StartSymbolIndex, start symbol index of the time domain allocation within a slot;
+  ///      - \c NumSymbols, number of symbols of the time domain allocation within a slot;
+  ///      - \c DMRSSymbPos, boolean mask flagging the OFDM symbols containing DM-RS;
+  ///      - \c DMRSConfigType, DM-RS configuration type;
+  ///      - \c NumCDMGroupsWithoutData, number of DM-RS CDM groups without data;
+  ///      - \c NIDNSCID, DM-RS scrambling identifier (non-transform-precoded transmissions);
+  ///      - \c NSCID, DM-RS scrambling initialization (non-transform-precoded transmissions);
+  ///      - \c NRSID, DM-RS low-PAPR sequence identifier (transform-precoded transmissions);
+  ///      - \c DMRSAmplitude, linear amplitude of the DM-RS with respect to the data;
+  ///      - \c NumLayers, number of transmission layers;
+  ///      - \c TransformPrecoding, boolean flag for transform precoding;
+  ///      - \c BGN, the LDPC base graph;
+  ///      - \c RV, the redundancy version;
+  ///      - \c LimitedBufferSize, limited buffer rate matching length (set to zero for unlimited buffer).
+  ///
+  /// The method has one single output.
+  ///   - A three-dimensional array of \c cf_t with the transmit resource grid (dimensions are subcarriers, OFDM
+  ///     symbols and layers). Layer \f$i\f$ is mapped onto port \f$i\f$.
+  void method_step(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Gets a DFT processor of the given size, for transform precoding.
+  ///
+  /// DFT processors are created the first time a size is requested and reused afterwards.
+  srsran::dft_processor& get_transform_precoder(unsigned size);
+
+  /// srsRAN components forming the PUSCH transmitter.
+  pusch_transmitter_components components = create_pusch_transmitter();
+
+  /// Transform precoders, indexed by their size.
+  std::unordered_map<unsigned, std::unique_ptr<srsran::dft_processor>> transform_precoders;
+};
+
+pusch_transmitter_components create_pusch_transmitter()
+{
+  using namespace srsran;
+
+  std::shared_ptr<crc_calculator_factory> crc_factory = create_crc_calculator_factory_sw("auto");
+
+  std::shared_ptr<ldpc_encoder_factory> ldpc_encoder_factory = create_ldpc_encoder_factory_sw("auto");
+
+  std::shared_ptr<ldpc_rate_matcher_factory> ldpc_rate_matcher_factory = create_ldpc_rate_matcher_factory_sw();
+
+  std::shared_ptr<ldpc_segmenter_tx_factory> segmenter_tx_factory = create_ldpc_segmenter_tx_factory_sw(crc_factory);
+
+  pdsch_encoder_factory_sw_configuration encoder_config;
+  encoder_config.encoder_factory      = ldpc_encoder_factory;
+  encoder_config.rate_matcher_factory = ldpc_rate_matcher_factory;
+  encoder_config.segmenter_factory    = segmenter_tx_factory;
+  std::shared_ptr<pdsch_encoder_factory> encoder_factory = create_pdsch_encoder_factory_sw(encoder_config);
+
+  std::shared_ptr<modulation_mapper_factory> mapper_factory = create_modulation_mapper_factory();
+
+  std::shared_ptr<pseudo_random_generator_factory> prg_factory = create_pseudo_random_generator_sw_factory();
+
+  std::shared_ptr<channel_precoder_factory> precoder_factory = create_channel_precoder_factory("auto");
+
+  std::shared_ptr<resource_grid_mapper_factory> rg_mapper_factory =
+      create_resource_grid_mapper_factory(precoder_factory);
+
+  std::shared_ptr<pdsch_modulator_factory> modulator_factory =
+      create_pdsch_modulator_factory_sw(mapper_factory, prg_factory, rg_mapper_factory);
+
+  std::shared_ptr<dmrs_pdsch_processor_factory> dmrs_factory =
+      create_dmrs_pdsch_processor_factory_sw(prg_factory, rg_mapper_factory);
+
+  std::shared_ptr<low_papr_sequence_generator_factory> lpapr_factory =
+      create_low_papr_sequence_generator_sw_factory();
+
+  pusch_transmitter_components components;
+  components.encoder     = encoder_factory->create();
+  components.modulator   = modulator_factory->create();
+  components.dmrs        = dmrs_factory->create();
+  components.mapper      = mapper_factory->create();
+  components.prg         = prg_factory->create();
+  components.lpapr       = lpapr_factory->create();
+  components.dft_factory = create_dft_processor_factory_fftw_slow();
+
+  return components;
+}
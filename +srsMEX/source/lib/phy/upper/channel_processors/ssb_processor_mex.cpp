@@ -0,0 +1,349 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief SSB processor MEX definition.
+
+#include "ssb_processor_mex.h"
+#include "srsran_matlab/support/parallel_for.h"
+#include "srsran_matlab/support/to_span.h"
+#include "srsran/phy/support/resource_grid_reader.h"
+#include "srsran/phy/support/resource_grid_writer.h"
+#include "srsran/srsvec/conversion.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+using matlab::mex::ArgumentList;
+using namespace matlab::data;
+using namespace srsran;
+using namespace srsran_matlab;
+
+namespace {
+
+/// Copies the content of a resource grid the size of an SS/PBCH block into an array (subcarriers first).
+void read_ssb_grid(span<cf_t> out, const resource_grid_reader& reader, unsigned nof_subcarriers)
+{
+  for (unsigned i_symbol = 0, nof_symbols = out.size() / nof_subcarriers; i_symbol != nof_symbols; ++i_symbol) {
+    srsvec::convert(out.subspan(i_symbol * nof_subcarriers, nof_subcarriers),
+                    reader.get_view(0, i_symbol).first(nof_subcarriers));
+  }
+}
+
+} // namespace
+
+bool MexFunction::create_signal_generators()
+{
+  std::shared_ptr<pseudo_random_generator_factory> prg_factory = create_pseudo_random_generator_sw_factory();
+  std::shared_ptr<pss_processor_factory>           pss_factory = create_pss_processor_factory_sw();
+  std::shared_ptr<sss_processor_factory>           sss_factory = create_sss_processor_factory_sw();
+  if (!prg_factory || !pss_factory || !sss_factory) {
+    return false;
+  }
+
+  std::shared_ptr<dmrs_pbch_processor_factory> dmrs_factory = create_dmrs_pbch_processor_factory_sw(prg_factory);
+  if (!dmrs_factory) {
+    return false;
+  }
+
+  pss         = pss_factory->create();
+  sss         = sss_factory->create();
+  dmrs        = dmrs_factory->create();
+  signal_grid = create_resource_grid(SSB_NOF_SUBCARRIERS, SSB_NOF_SYMBOLS, 1);
+
+  return pss && sss && dmrs && signal_grid;
+}
+
+void MexFunction::method_new(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 3;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::DOUBLE) || (inputs[1].getNumberOfElements() != 1)) {
+    mex_abort("Input 'cacheSize' must be a scalar double.");
+  }
+
+  if ((inputs[2].getType() != ArrayType::DOUBLE) || (inputs[2].getNumberOfElements() != 1)) {
+    mex_abort("Input 'nofWorkers' should be a scalar double.");
+  }
+
+  if (!outputs.empty()) {
+    mex_abort("Wrong number of outputs: expected 0, provided {}.", outputs.size());
+  }
+
+  double cache_size = inputs[1][0];
+  if (cache_size < 1) {
+    mex_abort("The cache size must be positive, provided {}.", cache_size);
+  }
+
+  unsigned nof_workers = static_cast<unsigned>(static_cast<TypedArray<double>>(inputs[2])[0]);
+  if (nof_workers == 0) {
+    nof_workers = default_nof_workers();
+  }
+
+  std::shared_ptr<crc_calculator_factory>          crc_factory    = create_crc_calculator_factory_sw("auto");
+  std::shared_ptr<polar_factory>                   polar_factory  = create_polar_factory_sw();
+  std::shared_ptr<pseudo_random_generator_factory> prg_factory    = create_pseudo_random_generator_sw_factory();
+  std::shared_ptr<modulation_mapper_factory>       mapper_factory = create_modulation_mapper_factory();
+
+  std::shared_ptr<pbch_encoder_factory> encoder_factory =
+      create_pbch_encoder_factory_sw(crc_factory, prg_factory, polar_factory);
+  std::shared_ptr<pbch_modulator_factory> modulator_factory =
+      create_pbch_modulator_factory_sw(mapper_factory, prg_factory);
+  if (!encoder_factory || !modulator_factory) {
+    mex_abort("Cannot create srsRAN PBCH encoder and modulator factories.");
+  }
+
+  workers.clear();
+  for (unsigned i_worker = 0; i_worker != nof_workers; ++i_worker) {
+    pbch_worker& worker = workers.emplace_back();
+    worker.encoder      = encoder_factory->create();
+    worker.modulator    = modulator_factory->create();
+    worker.grid         = create_resource_grid(SSB_NOF_SUBCARRIERS, SSB_NOF_SYMBOLS, 1);
+
+    // Ensure the worker was created properly.
+    if (!worker.encoder || !worker.modulator || !worker.grid) {
+      mex_abort("Cannot create srsRAN PBCH encoder and modulator.");
+    }
+  }
+
+  cache = std::make_unique<signal_cache>(static_cast<unsigned>(cache_size));
+}
+
+const std::vector<cf_t>& MexFunction::get_signals(const signal_key& key)
+{
+  if (const std::vector<cf_t>* cached = cache->find(key)) {
+    return *cached;
+  }
+
+  signal_grid->set_all_zero();
+  resource_grid_writer& writer = signal_grid->get_writer();
+
+  pss_processor::config_t pss_config;
+  pss_config.phys_cell_id         = key.phys_cell_id;
+  pss_config.ssb_first_subcarrier = 0;
+  pss_config.ssb_first_symbol     = 0;
+  pss_config.amplitude            = std::pow(10.0F, key.beta_pss / 20.0F);
+  pss_config.ports                = {0};
+  pss->map(writer, pss_config);
+
+  sss_processor::config_t sss_config;
+  sss_config.phys_cell_id         = key.phys_cell_id;
+  sss_config.ssb_first_subcarrier = 0;
+  sss_config.ssb_first_symbol     = 0;
+  sss_config.amplitude            = 1.0F;
+  sss_config.ports                = {0};
+  sss->map(writer, sss_config);
+
+  dmrs_pbch_processor::config_t dmrs_config;
+  dmrs_config.phys_cell_id         = key.phys_cell_id;
+  dmrs_config.ssb_idx              = key.ssb_idx;
+  dmrs_config.L_max                = key.L_max;
+  dmrs_config.ssb_first_subcarrier = 0;
+  dmrs_config.ssb_first_symbol     = 0;
+  dmrs_config.hrf                  = key.hrf;
+  dmrs_config.amplitude            = 1.0F;
+  dmrs_config.ports                = {0};
+  dmrs->map(writer, dmrs_config);
+
+  std::vector<cf_t> signals(SSB_NOF_RE);
+  read_ssb_grid(signals, signal_grid->get_reader(), SSB_NOF_SUBCARRIERS);
+  return cache->insert(key, std::move(signals));
+}
+
+void MexFunction::check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 3;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::STRUCT) || (inputs[1].getNumberOfElements() > 1)) {
+    mex_abort("Input 'gridConfig' must be a scalar structure.");
+  }
+
+  if (inputs[2].getType() != ArrayType::STRUCT) {
+    mex_abort("Input 'SSBConfigs' must be a structure array.");
+  }
+
+  constexpr unsigned NOF_OUTPUTS = 1;
+  if (outputs.size() != NOF_OUTPUTS) {
+    mex_abort("Wrong number of outputs: expected {}, provided {}.", NOF_OUTPUTS, outputs.size());
+  }
+}
+
+void MexFunction::method_step(ArgumentList outputs, ArgumentList inputs)
+{
+  // Ensure the workers are initialized.
+  if (workers.empty()) {
+    mex_abort("The srsRAN PBCH encoders and modulators were not initialized properly.");
+  }
+
+  check_step_outputs_inputs(outputs, inputs);
+
+  // Resource grid dimensions.
+  StructArray  in_grid_array   = inputs[1];
+  const Struct in_grid         = in_grid_array[0];
+  unsigned     nof_subcarriers = in_grid["NumSubcarriers"][0];
+  unsigned     nof_symbols     = in_grid["NumSymbols"][0];
+  unsigned     nof_ports       = in_grid["NumPorts"][0];
+
+  // SS/PBCH block parameters other than the cache key.
+  struct ssb_description {
+    unsigned                                    sfn;
+    unsigned                                    k_ssb;
+    decltype(pbch_encoder::pbch_msg_t::payload) payload;
+    unsigned                                    first_subcarrier;
+    unsigned                                    first_symbol;
+    unsigned                                    port;
+  };
+
+  // Read the configurations and fetch the cached signals in the calling thread, since neither the MATLAB API nor the
+  // cache are thread-safe. The signals are copied right after the lookup, since a later insertion may evict them.
+  const StructArray              in_ssb_array = inputs[2];
+  unsigned                       nof_ssb      = in_ssb_array.getNumberOfElements();
+  std::vector<signal_key>        keys(nof_ssb);
+  std::vector<ssb_description>   ssbs(nof_ssb);
+  std::vector<std::vector<cf_t>> blocks(nof_ssb);
+  for (unsigned i_ssb = 0; i_ssb != nof_ssb; ++i_ssb) {
+    const Struct     in_cfg = in_ssb_array[i_ssb];
+    signal_key&      key    = keys[i_ssb];
+    ssb_description& ssb    = ssbs[i_ssb];
+
+    key.phys_cell_id = in_cfg["NCellID"][0];
+    key.ssb_idx      = in_cfg["SSBIndex"][0];
+    key.L_max        = in_cfg["Lmax"][0];
+    key.hrf          = (static_cast<unsigned>(in_cfg["HalfFrame"][0]) != 0);
+    key.beta_pss     = static_cast<float>(static_cast<double>(in_cfg["PSSPowerOffset"][0]));
+
+    if ((key.L_max != 4) && (key.L_max != 8) && (key.L_max != 64)) {
+      mex_abort("SSB {}: invalid Lmax {}, valid values are 4, 8 and 64.", i_ssb, key.L_max);
+    }
+    if (key.ssb_idx >= key.L_max) {
+      mex_abort("SSB {}: the SSB index, i.e., {}, must be lower than Lmax, i.e., {}.", i_ssb, key.ssb_idx, key.L_max);
+    }
+
+    ssb.sfn              = in_cfg["SFN"][0];
+    ssb.k_ssb            = in_cfg["KSSB"][0];
+    ssb.first_subcarrier = in_cfg["FirstSubcarrier"][0];
+    ssb.first_symbol     = in_cfg["FirstSymbol"][0];
+    ssb.port             = in_cfg["Port"][0];
+
+    const TypedArray<double> in_mib = in_cfg["MIB"];
+    if (in_mib.getNumberOfElements() != ssb.payload.size()) {
+      mex_abort(
+          "SSB {}: the MIB must have {} bits, provided {}.", i_ssb, ssb.payload.size(), in_mib.getNumberOfElements());
+    }
+    std::transform(
+        in_mib.cbegin(), in_mib.cend(), ssb.payload.begin(), [](double bit) { return static_cast<uint8_t>(bit); });
+
+    if ((ssb.first_subcarrier + SSB_NOF_SUBCARRIERS > nof_subcarriers) ||
+        (ssb.first_symbol + SSB_NOF_SYMBOLS > nof_symbols) || (ssb.port >= nof_ports)) {
+      mex_abort("SSB {} does not fit the resource grid.", i_ssb);
+    }
+
+    blocks[i_ssb] = get_signals(key);
+  }
+
+  // Each worker encodes and modulates the PBCH of its blocks and adds it to the cached signals.
+  try {
+    parallel_for(nof_ssb, workers.size(), [&](unsigned i_ssb, unsigned i_worker) {
+      pbch_worker&           worker = workers[i_worker];
+      const signal_key&      key    = keys[i_ssb];
+      const ssb_description& ssb    = ssbs[i_ssb];
+
+      pbch_encoder::pbch_msg_t pbch_msg;
+      pbch_msg.N_id    = key.phys_cell_id;
+      pbch_msg.ssb_idx = key.ssb_idx;
+      pbch_msg.L_max   = key.L_max;
+      pbch_msg.hrf     = key.hrf;
+      pbch_msg.payload = ssb.payload;
+      pbch_msg.sfn     = ssb.sfn;
+      pbch_msg.k_ssb   = ssb.k_ssb;
+
+      std::array<uint8_t, pbch_encoder::E> encoded_bits;
+      worker.encoder->encode(encoded_bits, pbch_msg);
+
+      pbch_modulator::config_t modulator_config;
+      modulator_config.phys_cell_id         = key.phys_cell_id;
+      modulator_config.ssb_idx              = key.ssb_idx;
+      modulator_config.ssb_first_subcarrier = 0;
+      modulator_config.ssb_first_symbol     = 0;
+      modulator_config.amplitude            = 1.0F;
+      modulator_config.ports                = {0};
+
+      worker.grid->set_all_zero();
+      worker.modulator->put(encoded_bits, worker.grid->get_writer(), modulator_config);
+
+      std::array<cf_t, SSB_NOF_RE> pbch;
+      read_ssb_grid(pbch, worker.grid->get_reader(), SSB_NOF_SUBCARRIERS);
+
+      std::vector<cf_t>& block = blocks[i_ssb];
+      for (unsigned i_re = 0; i_re != SSB_NOF_RE; ++i_re) {
+        block[i_re] += pbch[i_re];
+      }
+    });
+  } catch (const std::exception& e) {
+    mex_abort("Cannot process the SS/PBCH blocks: {}", e.what());
+  }
+
+  // Add the blocks to the grid, so that overlapping blocks (e.g., of different cells) are superimposed.
+  TypedArray<cf_t> out_grid  = factory.createArray<cf_t>({nof_subcarriers, nof_symbols, nof_ports});
+  span<cf_t>       grid_view = to_span(out_grid);
+  for (unsigned i_ssb = 0; i_ssb != nof_ssb; ++i_ssb) {
+    const ssb_description&   ssb   = ssbs[i_ssb];
+    const std::vector<cf_t>& block = blocks[i_ssb];
+    for (unsigned i_symbol = 0; i_symbol != SSB_NOF_SYMBOLS; ++i_symbol) {
+      cf_t* symbol = grid_view.data() + (ssb.port * nof_symbols + ssb.first_symbol + i_symbol) * nof_subcarriers +
+                     ssb.first_subcarrier;
+      const cf_t* block_symbol = block.data() + i_symbol * SSB_NOF_SUBCARRIERS;
+      for (unsigned i_subc = 0; i_subc != SSB_NOF_SUBCARRIERS; ++i_subc) {
+        symbol[i_subc] += block_symbol[i_subc];
+      }
+    }
+  }
+
+  outputs[0] = out_grid;
+}
+
+void MexFunction::method_stats(ArgumentList outputs, ArgumentList inputs)
+{
+  // Ensure the cache is initialized.
+  if (!cache) {
+    mex_abort("The SS/PBCH block signal cache was not initialized properly.");
+  }
+
+  if (inputs.size() != 1) {
+    mex_abort("Wrong number of inputs: expected 1, provided {}.", inputs.size());
+  }
+
+  if (outputs.size() != 1) {
+    mex_abort("Wrong number of outputs: expected 1, provided {}.", outputs.size());
+  }
+
+  StructArray out     = factory.createStructArray({1, 1}, {"Size", "Capacity", "Hits", "Misses", "Evictions"});
+  out[0]["Size"]      = factory.createScalar(static_cast<double>(cache->size()));
+  out[0]["Capacity"]  = factory.createScalar(static_cast<double>(cache->get_capacity()));
+  out[0]["Hits"]      = factory.createScalar(static_cast<double>(cache->get_nof_hits()));
+  out[0]["Misses"]    = factory.createScalar(static_cast<double>(cache->get_nof_misses()));
+  out[0]["Evictions"] = factory.createScalar(static_cast<double>(cache->get_nof_evictions()));
+  outputs[0]          = out;
+}
@@ -0,0 +1,190 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief SSB processor MEX declaration.
+
+#pragma once
+
+#include "srsran_matlab/srsran_mex_dispatcher.h"
+#include "srsran_matlab/support/lru_cache.h"
+#include "srsran/adt/complex.h"
+#include "srsran/phy/support/resource_grid.h"
+#include "srsran/phy/support/support_factories.h"
+#include "srsran/phy/upper/channel_coding/channel_coding_factories.h"
+#include "srsran/phy/upper/channel_modulation/channel_modulation_factories.h"
+#include "srsran/phy/upper/channel_processors/ssb/factories.h"
+#include "srsran/phy/upper/sequence_generators/sequence_generator_factories.h"
+#include "srsran/phy/upper/signal_processors/signal_processor_factories.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+/// \brief Implements an SSB processor following the srsran_mex_dispatcher template.
+///
+/// The MEX maps all the SS/PBCH blocks of a burst, possibly of different cells, into a single resource grid with one
+/// call. Each block is assembled from the srsRAN PSS, SSS, PBCH DM-RS, PBCH encoder and PBCH modulator blocks. The
+/// PSS, SSS and PBCH DM-RS do not depend on the BCH payload: they are generated once for each combination of physical
+/// cell identifier, SSB index, maximum number of SSBs in a burst, half-frame and PSS power and kept in a
+/// least-recently-used cache. Only the PBCH is encoded and modulated at every call, by a pool of worker threads.
+class MexFunction : public srsran_mex_dispatcher
+{
+public:
+  /// \brief Constructor.
+  ///
+  /// Stores the string identifier&ndash;method pairs that form the public interface of the SSB processor MEX object.
+  MexFunction()
+  {
+    // Ensure the srsRAN SSB signal generators were created successfully.
+    if (!create_signal_generators()) {
+      mex_abort("Cannot create srsRAN SSB signal generators.");
+    }
+
+    create_callback("new", [this](ArgumentList out, ArgumentList in) { this->method_new(out, in); });
+    create_callback("step", [this](ArgumentList out, ArgumentList in) { this->method_step(out, in); });
+    create_callback("stats", [this](ArgumentList out, ArgumentList in) { this->method_stats(out, in); });
+  }
+
+private:
+  /// Number of subcarriers of an SS/PBCH block.
+  static constexpr unsigned SSB_NOF_SUBCARRIERS = 240;
+  /// Number of OFDM symbols of an SS/PBCH block.
+  static constexpr unsigned SSB_NOF_SYMBOLS = 4;
+  /// Number of resource elements of an SS/PBCH block.
+  static constexpr unsigned SSB_NOF_RE = SSB_NOF_SUBCARRIERS * SSB_NOF_SYMBOLS;
+
+  /// Identifies the BCH-independent signals of an SS/PBCH block in the cache.
+  struct signal_key {
+    /// Physical cell identifier.
+    unsigned phys_cell_id;
+    /// SS/PBCH block index.
+    unsigned ssb_idx;
+    /// Maximum number of SS/PBCH blocks in a burst.
+    unsigned L_max;
+    /// Half-frame flag.
+    bool hrf;
+    /// PSS power relative to the SSS, in dB.
+    float beta_pss;
+
+    bool operator==(const signal_key& other) const
+    {
+      return (phys_cell_id == other.phys_cell_id) && (ssb_idx == other.ssb_idx) && (L_max == other.L_max) &&
+             (hrf == other.hrf) && (beta_pss == other.beta_pss);
+    }
+  };
+
+  /// Hash function object for \c signal_key.
+  struct signal_key_hash {
+    std::size_t operator()(const signal_key& key) const
+    {
+      // The cell identifier takes 10 bits, the SSB index 6 bits and L_max 7 bits.
+      std::size_t packed = static_cast<std::size_t>(key.phys_cell_id) |
+                           (static_cast<std::size_t>(key.ssb_idx) << 10U) |
+                           (static_cast<std::size_t>(key.L_max) << 16U) |
+                           (static_cast<std::size_t>(key.hrf) << 23U);
+      return std::hash<std::size_t>()(packed) ^ std::hash<float>()(key.beta_pss);
+    }
+  };
+
+  /// \brief Cache of BCH-independent signals.
+  ///
+  /// Each entry holds the PSS, SSS and PBCH DM-RS of one SS/PBCH block, as a 240-by-4 array (subcarriers are the
+  /// fastest-varying dimension) with zeros in the PBCH data resource elements.
+  using signal_cache = srsran_matlab::lru_cache<signal_key, std::vector<srsran::cf_t>, signal_key_hash>;
+
+  /// Default number of cached SS/PBCH block signals.
+  static constexpr unsigned DEFAULT_CACHE_SIZE = 1024;
+
+  /// PBCH encoder and modulator, with the scratch memory needed by one worker.
+  struct pbch_worker {
+    /// PBCH encoder.
+    std::unique_ptr<srsran::pbch_encoder> encoder;
+    /// PBCH modulator.
+    std::unique_ptr<srsran::pbch_modulator> modulator;
+    /// Resource grid the size of an SS/PBCH block.
+    std::unique_ptr<srsran::resource_grid> grid;
+  };
+
+  /// Creates the PSS, SSS and PBCH DM-RS generators. Returns \c false if any of them cannot be created.
+  bool create_signal_generators();
+
+  /// \brief Creates the pool of PBCH workers and a new signal cache.
+  ///
+  /// The method takes three inputs.
+  ///   - The string <tt>"new"</tt>.
+  ///   - The maximum number of cached SS/PBCH block signals.
+  ///   - The number of worker threads (set it to zero to use as many workers as hardware threads).
+  ///
+  /// Any previously cached signal is discarded. The method has no output.
+  void method_new(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Gets the BCH-independent signals of an SS/PBCH block.
+  ///
+  /// The signals are generated and inserted in the cache if they are not there yet. The returned reference is valid
+  /// until the entry is evicted from the cache.
+  const std::vector<srsran::cf_t>& get_signals(const signal_key& key);
+
+  /// Checks that outputs/inputs arguments match the requirements of method_step().
+  void check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Maps a list of SS/PBCH blocks into a resource grid.
+  ///
+  /// The method takes three inputs.
+  ///   - The string <tt>"step"</tt>.
+  ///   - A one-dimensional structure describing the resource grid, with fields
+  ///      - \c NumSubcarriers, number of subcarriers of the resource grid;
+  ///      - \c NumSymbols, number of OFDM symbols of the resource grid (e.g., all the symbols of a half frame);
+  ///      - \c NumPorts, number of antenna ports of the resource grid.
+  ///   - A structure array with one entry for each SS/PBCH block. The fields are
+  ///      - \c NCellID, physical cell identifier;
+  ///      - \c SSBIndex, SS/PBCH block index;
+  ///      - \c Lmax, maximum number of SS/PBCH blocks in a burst;
+  ///      - \c SFN, system frame number;
+  ///      - \c HalfFrame, half-frame bit;
+  ///      - \c KSSB, subcarrier offset \f$k_{SSB}\f$;
+  ///      - \c MIB, BCH payload (24 unpacked bits);
+  ///      - \c PSSPowerOffset, PSS power relative to the SSS in dB;
+  ///      - \c FirstSubcarrier, index of the first subcarrier of the block within the resource grid;
+  ///      - \c FirstSymbol, index of the first OFDM symbol of the block within the resource grid;
+  ///      - \c Port, antenna port the block is mapped onto.
+  ///
+  /// The method has one single output.
+  ///   - A three-dimensional array of \c cf_t with the transmit resource grid (dimensions are subcarriers, OFDM
+  ///     symbols and antenna ports). Overlapping SS/PBCH blocks (e.g., of different cells) are superimposed.
+  void method_step(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Returns the cache statistics.
+  ///
+  /// The method takes one input, the string <tt>"stats"</tt>, and returns a scalar structure with fields \c Size,
+  /// \c Capacity, \c Hits, \c Misses and \c Evictions.
+  void method_stats(ArgumentList outputs, ArgumentList inputs);
+
+  /// PSS generator.
+  std::unique_ptr<srsran::pss_processor> pss;
+  /// SSS generator.
+  std::unique_ptr<srsran::sss_processor> sss;
+  /// PBCH DM-RS generator.
+  std::unique_ptr<srsran::dmrs_pbch_processor> dmrs;
+  /// Resource grid the size of an SS/PBCH block, used to generate the cached signals.
+  std::unique_ptr<srsran::resource_grid> signal_grid;
+  /// Pool of PBCH workers.
+  std::vector<pbch_worker> workers;
+  /// Cache of BCH-independent signals.
+  std::unique_ptr<signal_cache> cache = std::make_unique<signal_cache>(DEFAULT_CACHE_SIZE);
+};
@@ -0,0 +1,149 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief UCI decoder MEX definition.
+
+#include "uci_decoder_mex.h"
+#include "srsran_matlab/support/matlab_to_srs.h"
+#include "srsran_matlab/support/parallel_for.h"
+#include "srsran_matlab/support/to_span.h"
+#include "srsran/phy/upper/log_likelihood_ratio.h"
+#include "srsran/ran/uci/uci_constants.h"
+#include <algorithm>
+
+using matlab::mex::ArgumentList;
+using namespace matlab::data;
+using namespace srsran;
+using namespace srsran_matlab;
+
+void MexFunction::method_new(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 2;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::DOUBLE) || (inputs[1].getNumberOfElements() != 1)) {
+    mex_abort("Input 'nofWorkers' should be a scalar double.");
+  }
+  unsigned nof_workers = static_cast<unsigned>(static_cast<TypedArray<double>>(inputs[1])[0]);
+  if (nof_workers == 0) {
+    nof_workers = default_nof_workers();
+  }
+
+  if (!outputs.empty()) {
+    mex_abort("Wrong number of outputs: expected 0, provided {}.", outputs.size());
+  }
+
+  if (!decoder_factory) {
+    mex_abort("Cannot create srsRAN UCI decoder factory.");
+  }
+
+  decoders.clear();
+  for (unsigned i_worker = 0; i_worker != nof_workers; ++i_worker) {
+    decoders.emplace_back(decoder_factory->create());
+
+    // Ensure the decoder was created properly.
+    if (!decoders.back()) {
+      mex_abort("Cannot create srsRAN UCI decoder.");
+    }
+  }
+}
+
+void MexFunction::check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 3;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if (inputs[1].getType() != ArrayType::CELL) {
+    mex_abort("Input 'llrs' must be a cell array.");
+  }
+
+  if ((inputs[2].getType() != ArrayType::STRUCT) ||
+      (inputs[2].getNumberOfElements() != inputs[1].getNumberOfElements())) {
+    mex_abort("Input 'UCIConfigs' must be a structure array with one entry for each LLR array.");
+  }
+
+  constexpr unsigned NOF_OUTPUTS = 1;
+  if (outputs.size() != NOF_OUTPUTS) {
+    mex_abort("Wrong number of outputs: expected {}, provided {}.", NOF_OUTPUTS, outputs.size());
+  }
+}
+
+void MexFunction::method_step(ArgumentList outputs, ArgumentList inputs)
+{
+  // Ensure the decoders are initialized.
+  if (decoders.empty()) {
+    mex_abort("The srsRAN UCI decoders were not initialized properly.");
+  }
+
+  check_step_outputs_inputs(outputs, inputs);
+
+  // Collect all the inputs in the calling thread, since the MATLAB API is not thread-safe.
+  const CellArray                               in_llr_array = inputs[1];
+  const StructArray                             in_cfg_array = inputs[2];
+  unsigned                                      nof_messages = in_cfg_array.getNumberOfElements();
+  std::vector<TypedArray<int8_t>>               llr_arrays;
+  std::vector<span<const log_likelihood_ratio>> llr_views;
+  std::vector<uci_decoder::configuration>       configs(nof_messages);
+  std::vector<std::vector<uint8_t>>             messages(nof_messages);
+  llr_arrays.reserve(nof_messages);
+  for (unsigned i_msg = 0; i_msg != nof_messages; ++i_msg) {
+    if (in_llr_array[i_msg].getType() != ArrayType::INT8) {
+      mex_abort("LLR array {} must be an array of int8_t.", i_msg);
+    }
+    const TypedArray<int8_t>& in_llrs = llr_arrays.emplace_back(in_llr_array[i_msg]);
+    llr_views.push_back(to_span<int8_t, log_likelihood_ratio>(in_llrs));
+
+    const Struct in_cfg         = in_cfg_array[i_msg];
+    unsigned     message_length = in_cfg["MessageLength"][0];
+    if ((message_length == 0) || (message_length > uci_constants::MAX_NOF_PAYLOAD_SIZE)) {
+      mex_abort("Invalid length {} of UCI message {}.", message_length, i_msg);
+    }
+    messages[i_msg].resize(message_length);
+
+    const CharArray in_modulation = in_cfg["Modulation"];
+    configs[i_msg].modulation     = matlab_to_srs_modulation(in_modulation.toAscii());
+  }
+
+  // Decode the messages, each worker using its own decoder.
+  std::vector<uci_status> status(nof_messages, uci_status::unknown);
+  try {
+    parallel_for(nof_messages, static_cast<unsigned>(decoders.size()), [&](unsigned i_msg, unsigned i_worker) {
+      status[i_msg] = decoders[i_worker]->decode(messages[i_msg], llr_views[i_msg], configs[i_msg]);
+    });
+  } catch (const std::exception& e) {
+    mex_abort("Cannot decode the UCI messages: {}", e.what());
+  }
+
+  StructArray out = factory.createStructArray({nof_messages, 1}, {"Message", "isValid"});
+  for (unsigned i_msg = 0; i_msg != nof_messages; ++i_msg) {
+    unsigned            message_length = messages[i_msg].size();
+    TypedArray<uint8_t> out_message    = factory.createArray<uint8_t>({message_length, 1});
+    std::copy(messages[i_msg].begin(), messages[i_msg].end(), out_message.begin());
+
+    out[i_msg]["Message"] = out_message;
+    out[i_msg]["isValid"] = factory.createScalar(status[i_msg] == uci_status::valid);
+  }
+
+  outputs[0] = out;
+}
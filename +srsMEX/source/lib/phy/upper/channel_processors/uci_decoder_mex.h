@@ -0,0 +1,94 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief UCI decoder MEX declaration.
+
+#pragma once
+
+#include "srsran_matlab/srsran_mex_dispatcher.h"
+#include "srsran/phy/upper/channel_coding/channel_coding_factories.h"
+#include "srsran/phy/upper/channel_processors/uci/factories.h"
+#include "srsran/phy/upper/channel_processors/uci/uci_decoder.h"
+#include <memory>
+#include <vector>
+
+/// Factory method for a UCI decoder factory.
+inline std::shared_ptr<srsran::uci_decoder_factory> create_uci_decoder_factory();
+
+/// \brief Implements a batched UCI decoder leveraging srsRAN \c uci_decoder.
+///
+/// The MEX keeps a pool of UCI decoders, one per worker thread, and decodes all the UCI messages provided in a single
+/// call in parallel. Both short-block (up to 11 bits) and polar-coded messages are supported.
+class MexFunction : public srsran_mex_dispatcher
+{
+public:
+  /// Constructor: stores the string identifier&ndash;method pairs that form the public interface of the MEX object.
+  MexFunction()
+  {
+    create_callback("new", [this](ArgumentList out, ArgumentList in) { this->method_new(out, in); });
+    create_callback("step", [this](ArgumentList out, ArgumentList in) { this->method_step(out, in); });
+  }
+
+private:
+  /// Checks that outputs/inputs arguments match the requirements of method_step().
+  void check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Creates a new pool of UCI decoders.
+  ///
+  /// The method accepts only two inputs.
+  ///   - The string <tt>"new"</tt>.
+  ///   - The number of worker threads (a scalar double). If zero, the number of hardware threads is used.
+  ///
+  /// The method has no output.
+  void method_new(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Decodes a batch of UCI messages.
+  ///
+  /// The method has three inputs.
+  ///   - The string <tt>"step"</tt>.
+  ///   - A cell array of one-dimensional arrays of \c int8_t, with the (quantized) log-likelihood ratios of each UCI
+  ///     codeword.
+  ///   - A structure array with one entry for each UCI codeword and fields
+  ///      - \c MessageLength, the number of bits of the UCI message;
+  ///      - \c Modulation, the modulation scheme used to transmit the UCI codeword.
+  ///
+  /// The method has one single output.
+  ///   - A structure array with one entry for each UCI codeword and fields
+  ///      - \c Message, a one-dimensional array of \c uint8_t with the decoded (unpacked) message bits;
+  ///      - \c isValid, a boolean flag denoting whether the message was decoded successfully.
+  void method_step(ArgumentList outputs, ArgumentList inputs);
+
+  /// Factory of UCI decoders.
+  std::shared_ptr<srsran::uci_decoder_factory> decoder_factory = create_uci_decoder_factory();
+
+  /// Pool of UCI decoders, one for each worker.
+  std::vector<std::unique_ptr<srsran::uci_decoder>> decoders;
+};
+
+std::shared_ptr<srsran::uci_decoder_factory> create_uci_decoder_factory()
+{
+  using namespace srsran;
+
+  std::shared_ptr<short_block_detector_factory> short_block_dec_factory = create_short_block_detector_factory_sw();
+  std::shared_ptr<polar_factory>                polar_dec_factory       = create_polar_factory_sw();
+  std::shared_ptr<crc_calculator_factory>       crc_calc_factory        = create_crc_calculator_factory_sw("auto");
+
+  return create_uci_decoder_factory_generic(short_block_dec_factory, polar_dec_factory, crc_calc_factory);
+}
@@ -0,0 +1,157 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief UL-SCH demultiplexer MEX definition.
+
+#include "ulsch_demultiplex_mex.h"
+#include "srsran_matlab/support/to_span.h"
+#include "srsran_matlab/support/ulsch_demultiplex_helpers.h"
+#include "srsran/adt/bit_buffer.h"
+#include "srsran/phy/upper/channel_processors/pusch/pusch_codeword_buffer.h"
+
+using matlab::mex::ArgumentList;
+using namespace matlab::data;
+using namespace srsran;
+using namespace srsran_matlab;
+
+void MexFunction::method_new(ArgumentList outputs, ArgumentList inputs)
+{
+  if (inputs.size() != 1) {
+    mex_abort("Wrong number of inputs: expected 1, provided {}.", inputs.size());
+  }
+
+  if (!outputs.empty()) {
+    mex_abort("Wrong number of outputs: expected 0, provided {}.", outputs.size());
+  }
+
+  std::shared_ptr<ulsch_demultiplex_factory> demux_factory = create_ulsch_demultiplex_factory_sw();
+  if (!demux_factory) {
+    mex_abort("Cannot create srsRAN UL-SCH demultiplexer factory.");
+  }
+
+  demultiplexer = demux_factory->create();
+  if (!demultiplexer) {
+    mex_abort("Cannot create srsRAN UL-SCH demultiplexer.");
+  }
+
+  std::shared_ptr<pseudo_random_generator_factory> prg_factory = create_pseudo_random_generator_sw_factory();
+  if (!prg_factory) {
+    mex_abort("Cannot create srsRAN pseudo-random generator factory.");
+  }
+
+  scrambler = prg_factory->create();
+  if (!scrambler) {
+    mex_abort("Cannot create srsRAN pseudo-random generator.");
+  }
+}
+
+void MexFunction::check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 4;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if (inputs[1].getType() != ArrayType::INT8) {
+    mex_abort("Input 'codeword' must be an array of int8_t.");
+  }
+
+  if ((inputs[2].getType() != ArrayType::STRUCT) || (inputs[2].getNumberOfElements() != 1)) {
+    mex_abort("Input 'demuxConfig' must be a scalar structure.");
+  }
+
+  if ((inputs[3].getType() != ArrayType::STRUCT) || (inputs[3].getNumberOfElements() != 1)) {
+    mex_abort("Input 'scramblingConfig' must be a scalar structure.");
+  }
+
+  constexpr unsigned NOF_OUTPUTS = 4;
+  if (outputs.size() != NOF_OUTPUTS) {
+    mex_abort("Wrong number of outputs: expected {}, provided {}.", NOF_OUTPUTS, outputs.size());
+  }
+}
+
+void MexFunction::method_step(ArgumentList outputs, ArgumentList inputs)
+{
+  check_step_outputs_inputs(outputs, inputs);
+
+  if (!demultiplexer || !scrambler) {
+    mex_abort("UL-SCH demultiplexer was not initialized properly.");
+  }
+
+  const StructArray            in_demux_array = inputs[2];
+  ulsch_demultiplex_mex_config demux_config   = read_ulsch_demultiplex_config(in_demux_array[0]);
+
+  const TypedArray<int8_t> in_codeword = inputs[1];
+  if (in_codeword.isEmpty()) {
+    mex_abort("Input 'codeword' cannot be empty.");
+  }
+  span<const log_likelihood_ratio> codeword = to_span<int8_t, log_likelihood_ratio>(in_codeword);
+  unsigned                         nof_llr  = codeword.size();
+
+  // The sizes of the fields must add up to the codeword size. When there are up to two HARQ-ACK bits, they puncture
+  // the UL-SCH data instead of taking their own resource elements.
+  unsigned nof_harq_ack_re_bits =
+      (demux_config.config.nof_harq_ack_bits > 2) ? demux_config.config.nof_enc_harq_ack_bits : 0;
+  unsigned expected_nof_llr = demux_config.nof_enc_ulsch_bits + nof_harq_ack_re_bits +
+                              demux_config.config.nof_enc_csi_part1_bits + demux_config.nof_enc_csi_part2_bits;
+  if (nof_llr != expected_nof_llr) {
+    mex_abort("The codeword has {} soft bits, but the configured fields need {}.", nof_llr, expected_nof_llr);
+  }
+
+  // Generate the scrambling sequence, needed by the demultiplexer to revert the descrambling of the placeholders.
+  const StructArray  in_scrambling_array = inputs[3];
+  const Struct       in_scrambling_cfg   = in_scrambling_array[0];
+  unsigned           rnti                = in_scrambling_cfg["RNTI"][0];
+  unsigned           n_id                = in_scrambling_cfg["NID"][0];
+  dynamic_bit_buffer scrambling_seq(nof_llr);
+  scrambler->init((rnti << 15U) + n_id);
+  scrambler->generate(scrambling_seq);
+
+  // Prepare the destination buffers.
+  auto create_output = [this](unsigned size) { return factory.createArray<int8_t>({size, 1}); };
+  TypedArray<int8_t> out_sch_data  = create_output(demux_config.nof_enc_ulsch_bits);
+  TypedArray<int8_t> out_harq_ack  = create_output(demux_config.config.nof_enc_harq_ack_bits);
+  TypedArray<int8_t> out_csi_part1 = create_output(demux_config.config.nof_enc_csi_part1_bits);
+  TypedArray<int8_t> out_csi_part2 = create_output(demux_config.nof_enc_csi_part2_bits);
+
+  // Empty MATLAB arrays have no valid data pointer.
+  auto as_llr_span = [](TypedArray<int8_t>& array) {
+    return array.isEmpty() ? span<log_likelihood_ratio>() : to_span<int8_t, log_likelihood_ratio>(array);
+  };
+  llr_array_decoder_buffer sch_data(as_llr_span(out_sch_data));
+  llr_array_decoder_buffer harq_ack(as_llr_span(out_harq_ack));
+  llr_array_decoder_buffer csi_part1(as_llr_span(out_csi_part1));
+  llr_array_decoder_buffer csi_part2(as_llr_span(out_csi_part2));
+
+  // Feed the whole codeword to the demultiplexer as a single block.
+  pusch_codeword_buffer& cw_buffer = demultiplexer->demultiplex(sch_data, harq_ack, csi_part1, demux_config.config);
+  demultiplexer->set_csi_part2(csi_part2, demux_config.nof_csi_part2_bits, demux_config.nof_enc_csi_part2_bits);
+  cw_buffer.on_new_block(codeword, scrambling_seq);
+  cw_buffer.on_end_codeword();
+
+  if (!sch_data.is_complete() || !harq_ack.is_complete() || !csi_part1.is_complete() || !csi_part2.is_complete()) {
+    mex_abort("The UL-SCH demultiplexer did not fill all the fields.");
+  }
+
+  outputs[0] = out_sch_data;
+  outputs[1] = out_harq_ack;
+  outputs[2] = out_csi_part1;
+  outputs[3] = out_csi_part2;
+}
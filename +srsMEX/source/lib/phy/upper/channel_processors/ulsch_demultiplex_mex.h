@@ -0,0 +1,72 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief UL-SCH demultiplexer MEX declaration.
+
+#pragma once
+
+#include "srsran_matlab/srsran_mex_dispatcher.h"
+#include "srsran/phy/upper/channel_processors/pusch/factories.h"
+#include "srsran/phy/upper/channel_processors/pusch/ulsch_demultiplex.h"
+#include "srsran/phy/upper/sequence_generators/sequence_generator_factories.h"
+#include <memory>
+
+/// \brief Implements a UL-SCH demultiplexer following the srsran_mex_dispatcher template.
+///
+/// The MEX separates, in a single pass, the UL-SCH data, HARQ-ACK, CSI Part 1 and CSI Part 2 soft bits of a
+/// descrambled PUSCH codeword, taking care of the UCI scrambling placeholders.
+class MexFunction : public srsran_mex_dispatcher
+{
+public:
+  /// Constructor: stores the string identifier&ndash;method pairs that form the public interface of the MEX object.
+  MexFunction()
+  {
+    create_callback("new", [this](ArgumentList out, ArgumentList in) { this->method_new(out, in); });
+    create_callback("step", [this](ArgumentList out, ArgumentList in) { this->method_step(out, in); });
+  }
+
+private:
+  /// Checks that outputs/inputs arguments match the requirements of method_step().
+  void check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Creates the UL-SCH demultiplexer.
+  ///
+  /// The method accepts only one input, the string <tt>"new"</tt>, and has no output.
+  void method_new(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Demultiplexes a PUSCH codeword.
+  ///
+  /// The method takes four inputs.
+  ///   - The string <tt>"step"</tt>.
+  ///   - A column array of \c int8_t with the descrambled soft bits of the PUSCH codeword, as returned by the PUSCH
+  ///     demodulator.
+  ///   - A one-dimensional structure with the demultiplexer configuration, as described in
+  ///     srsran_matlab::read_ulsch_demultiplex_config().
+  ///   - A one-dimensional structure with fields \c RNTI and \c NID, which determine the scrambling sequence.
+  ///
+  /// The method has four outputs, namely the soft bits (column arrays of \c int8_t) of UL-SCH data, HARQ-ACK,
+  /// CSI Part 1 and CSI Part 2.
+  void method_step(ArgumentList outputs, ArgumentList inputs);
+
+  /// A pointer to the actual UL-SCH demultiplexer.
+  std::unique_ptr<srsran::ulsch_demultiplex> demultiplexer = nullptr;
+  /// A pointer to the pseudo-random generator of the scrambling sequence.
+  std::unique_ptr<srsran::pseudo_random_generator> scrambler = nullptr;
+};
@@ -0,0 +1,151 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Channel equalizer MEX definition.
+
+#include "channel_equalizer_mex.h"
+#include "srsran_matlab/support/to_span.h"
+#include "srsran/phy/support/re_buffer.h"
+#include "srsran/phy/upper/equalization/dynamic_ch_est_list.h"
+#include "srsran/srsvec/conversion.h"
+#include <MatlabDataArray/ArrayDimensions.hpp>
+
+using namespace matlab::data;
+using namespace srsran;
+using namespace srsran_matlab;
+
+void MexFunction::method_new(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 2;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if (inputs[1].getType() != ArrayType::CHAR) {
+    mex_abort("Input 'eqType' must be a string.");
+  }
+  std::string                      eq_type_string = static_cast<CharArray>(inputs[1]).toAscii();
+  channel_equalizer_algorithm_type eq_type        = channel_equalizer_algorithm_type::zf;
+  if (eq_type_string == "MMSE") {
+    eq_type = channel_equalizer_algorithm_type::mmse;
+  } else if (eq_type_string != "ZF") {
+    mex_abort("Unknown equalizer type {}.", eq_type_string);
+  }
+
+  if (!outputs.empty()) {
+    mex_abort("Wrong number of outputs: expected 0, provided {}.", outputs.size());
+  }
+
+  equalizer = create_channel_equalizer(eq_type);
+
+  // Ensure the equalizer was created properly.
+  if (!equalizer) {
+    mex_abort("Cannot create srsRAN channel equalizer.");
+  }
+}
+
+void MexFunction::check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 5;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  ArrayDimensions in1_dims = inputs[1].getDimensions();
+  if ((inputs[1].getType() != ArrayType::COMPLEX_SINGLE) || (in1_dims.size() != 2)) {
+    mex_abort("Input 'rxSymbols' should be a 2-dimensional array of complex floats, provided [{}].", in1_dims);
+  }
+
+  ArrayDimensions in2_dims = inputs[2].getDimensions();
+  if ((inputs[2].getType() != ArrayType::COMPLEX_SINGLE) || (in2_dims.size() < 2) || (in2_dims.size() > 3) ||
+      (in2_dims[0] != in1_dims[0]) || (in2_dims[1] != in1_dims[1])) {
+    mex_abort("Input 'chEstimates' should be a 2- or 3-dimensional array of complex floats with size [{}, {}, L], "
+              "provided [{}].",
+              in1_dims[0],
+              in1_dims[1],
+              in2_dims);
+  }
+
+  if ((inputs[3].getType() != ArrayType::SINGLE) || (inputs[3].getNumberOfElements() != in1_dims[1])) {
+    mex_abort("Input 'noiseVars' should be an array of {} floats.", in1_dims[1]);
+  }
+
+  if ((inputs[4].getType() != ArrayType::SINGLE) || (inputs[4].getNumberOfElements() != 1)) {
+    mex_abort("Input 'txScaling' should be a scalar float.");
+  }
+
+  constexpr unsigned NOF_OUTPUTS = 2;
+  if (outputs.size() != NOF_OUTPUTS) {
+    mex_abort("Wrong number of outputs: expected {}, provided {}.", NOF_OUTPUTS, outputs.size());
+  }
+}
+
+void MexFunction::method_step(ArgumentList outputs, ArgumentList inputs)
+{
+  // Ensure the equalizer is initialized.
+  if (!equalizer) {
+    mex_abort("The srsRAN channel equalizer was not initialized properly.");
+  }
+
+  check_step_outputs_inputs(outputs, inputs);
+
+  ArrayDimensions ch_dims      = inputs[2].getDimensions();
+  unsigned        nof_re       = ch_dims[0];
+  unsigned        nof_rx_ports = ch_dims[1];
+  unsigned        nof_layers   = (ch_dims.size() == 3) ? ch_dims[2] : 1;
+
+  if (!equalizer->is_supported(nof_rx_ports, nof_layers)) {
+    mex_abort("The equalizer does not support {} Rx ports and {} layers.", nof_rx_ports, nof_layers);
+  }
+
+  // Convert the received symbols, one Rx port at a time.
+  const TypedArray<cf_t>     in_rx_symbols = inputs[1];
+  span<const cf_t>           rx_view       = to_span(in_rx_symbols);
+  dynamic_re_buffer<cbf16_t> rx_symbols(nof_rx_ports, nof_re);
+  for (unsigned i_port = 0; i_port != nof_rx_ports; ++i_port) {
+    srsvec::convert(rx_symbols.get_slice(i_port), rx_view.subspan(i_port * nof_re, nof_re));
+  }
+
+  // Convert the channel estimates, one Rx port&ndash;Tx layer path at a time.
+  const TypedArray<cf_t> in_ch_estimates = inputs[2];
+  span<const cf_t>       ch_view         = to_span(in_ch_estimates);
+  dynamic_ch_est_list    ch_estimates(nof_re, nof_rx_ports, nof_layers);
+  for (unsigned i_layer = 0; i_layer != nof_layers; ++i_layer) {
+    for (unsigned i_port = 0; i_port != nof_rx_ports; ++i_port) {
+      srsvec::convert(ch_estimates.get_channel(i_port, i_layer),
+                      ch_view.subspan((i_layer * nof_rx_ports + i_port) * nof_re, nof_re));
+    }
+  }
+
+  const TypedArray<float> in_noise_vars = inputs[3];
+  span<const float>       noise_vars    = to_span(in_noise_vars);
+
+  float tx_scaling = static_cast<TypedArray<float>>(inputs[4])[0];
+
+  // The equalized symbols and noise variances are interleaved by layer.
+  TypedArray<cf_t>  eq_symbols_out    = factory.createArray<cf_t>({nof_layers, nof_re});
+  TypedArray<float> eq_noise_vars_out = factory.createArray<float>({nof_layers, nof_re});
+
+  equalizer->equalize(
+      to_span(eq_symbols_out), to_span(eq_noise_vars_out), rx_symbols, ch_estimates, noise_vars, tx_scaling);
+
+  outputs[0] = eq_symbols_out;
+  outputs[1] = eq_noise_vars_out;
+}
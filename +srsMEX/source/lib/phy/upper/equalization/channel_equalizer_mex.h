@@ -0,0 +1,89 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Channel equalizer MEX declaration.
+
+#pragma once
+
+#include "srsran_matlab/srsran_mex_dispatcher.h"
+#include "srsran/phy/upper/equalization/channel_equalizer.h"
+#include "srsran/phy/upper/equalization/channel_equalizer_algorithm_type.h"
+#include "srsran/phy/upper/equalization/equalization_factories.h"
+#include <memory>
+
+/// Factory method for a channel equalizer.
+inline std::unique_ptr<srsran::channel_equalizer>
+create_channel_equalizer(srsran::channel_equalizer_algorithm_type eq_type);
+
+/// Implements a MIMO channel equalizer leveraging srsRAN \c channel_equalizer.
+class MexFunction : public srsran_mex_dispatcher
+{
+public:
+  /// Constructor: stores the string identifier&ndash;method pairs that form the public interface of the MEX object.
+  MexFunction()
+  {
+    create_callback("new", [this](ArgumentList out, ArgumentList in) { this->method_new(out, in); });
+    create_callback("step", [this](ArgumentList out, ArgumentList in) { this->method_step(out, in); });
+  }
+
+private:
+  /// Checks that outputs/inputs arguments match the requirements of method_step().
+  void check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Creates a new channel equalizer MEX object.
+  ///
+  /// The method accepts only two inputs.
+  ///   - The string <tt>"new"</tt>.
+  ///   - A string identifying the equalizer strategy (one of <tt>"ZF"</tt> for zero-forcing or <tt>"MMSE"</tt> for
+  ///     minimum mean-square error).
+  ///
+  /// The method has no output.
+  void method_new(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Equalizes a set of resource elements.
+  ///
+  /// The method has five inputs.
+  ///   - The string <tt>"step"</tt>.
+  ///   - The received symbols: a two-dimensional array of complex single-precision floats (REs, Rx ports).
+  ///   - The channel estimates: a three-dimensional array of complex single-precision floats (REs, Rx ports, Tx
+  ///     layers).
+  ///   - The noise variances: a one-dimensional array of single-precision floats with one entry per Rx port.
+  ///   - The scaling factor applied to the transmitted symbols (scalar single-precision float).
+  ///
+  /// The method has two outputs.
+  ///   - The equalized symbols: a two-dimensional array of complex single-precision floats (Tx layers, REs).
+  ///   - The post-equalization noise variances: a two-dimensional array of single-precision floats (Tx layers, REs).
+  void method_step(ArgumentList outputs, ArgumentList inputs);
+
+  /// Pointer to the actual channel equalizer.
+  std::unique_ptr<srsran::channel_equalizer> equalizer = nullptr;
+};
+
+std::unique_ptr<srsran::channel_equalizer> create_channel_equalizer(srsran::channel_equalizer_algorithm_type eq_type)
+{
+  using namespace srsran;
+
+  std::shared_ptr<channel_equalizer_factory> equalizer_factory = create_channel_equalizer_generic_factory(eq_type);
+  if (!equalizer_factory) {
+    return nullptr;
+  }
+
+  return equalizer_factory->create();
+}
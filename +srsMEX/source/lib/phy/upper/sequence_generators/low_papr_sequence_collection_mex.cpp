@@ -0,0 +1,106 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief MEX access to the low-PAPR sequence collections, with and without the cache of
+/// srsran_matlab::low_papr_sequence_collection_cached_factory.
+
+#include "srsran_matlab/srsran_mex_dispatcher.h"
+#include "srsran_matlab/support/low_papr_sequence_collection_cache.h"
+#include "srsran_matlab/support/to_span.h"
+#include "srsran/phy/upper/sequence_generators/sequence_generator_factories.h"
+#include <algorithm>
+#include <memory>
+#include <string>
+
+/// \brief srsLowPAPRCollectionMEX returns all the sequences of a low-PAPR sequence collection.
+///
+/// The collection is either generated by the srsRAN software factory or mapped from the cache files of the given
+/// directory, which allows comparing the two.
+class MexFunction : public srsran_mex_dispatcher
+{
+public:
+  /// Alias for MATLAB type.
+  using ArgumentList = matlab::mex::ArgumentList;
+
+  void operator()(ArgumentList outputs, ArgumentList inputs) override
+  {
+    using namespace matlab::data;
+
+    constexpr unsigned NOF_INPUTS = 4;
+    if (inputs.size() != NOF_INPUTS) {
+      mex_abort(
+          "srsLowPAPRCollectionMEX: Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+    }
+    if (outputs.size() != 1) {
+      mex_abort("srsLowPAPRCollectionMEX: Wrong number of outputs: expected 1, provided {}.", outputs.size());
+    }
+    for (unsigned i_input : {0U, 1U}) {
+      if ((inputs[i_input].getType() != ArrayType::DOUBLE) || (inputs[i_input].getNumberOfElements() != 1)) {
+        mex_abort("srsLowPAPRCollectionMEX: Inputs 'm' and 'delta' should be scalar doubles.");
+      }
+    }
+    if ((inputs[2].getType() != ArrayType::SINGLE) || inputs[2].isEmpty()) {
+      mex_abort("srsLowPAPRCollectionMEX: Input 'alphas' should be a nonempty array of singles.");
+    }
+    if (inputs[3].getType() != ArrayType::CHAR) {
+      mex_abort("srsLowPAPRCollectionMEX: Input 'cacheDir' should be a char array.");
+    }
+
+    unsigned                m         = static_cast<TypedArray<double>>(inputs[0])[0];
+    unsigned                delta     = static_cast<TypedArray<double>>(inputs[1])[0];
+    const TypedArray<float>   in_alphas          = inputs[2];
+    srsran::span<const float> alphas             = srsran_matlab::to_span(in_alphas);
+    const CharArray           in_cache_directory = inputs[3];
+    std::string               cache_directory    = in_cache_directory.toAscii();
+
+    std::shared_ptr<srsran::low_papr_sequence_collection_factory> collection_factory =
+        srsran::create_low_papr_sequence_collection_sw_factory(srsran::create_low_papr_sequence_generator_sw_factory());
+    if (!cache_directory.empty()) {
+      collection_factory = std::make_shared<srsran_matlab::low_papr_sequence_collection_cached_factory>(
+          std::move(collection_factory), cache_directory);
+    }
+
+    std::unique_ptr<srsran::low_papr_sequence_collection> collection =
+        collection_factory->create(m, delta, alphas);
+    if (!collection) {
+      mex_abort("srsLowPAPRCollectionMEX: Cannot create the collection with m={} and delta={}.", m, delta);
+    }
+
+    // Sequences indexed by sample, cyclic shift, base and group.
+    constexpr std::size_t nof_groups      = srsran_matlab::mapped_low_papr_sequence_collection::nof_groups;
+    constexpr std::size_t nof_bases       = srsran_matlab::mapped_low_papr_sequence_collection::nof_bases;
+    std::size_t           nof_alphas      = alphas.size();
+    std::size_t           sequence_length = collection->get(0, 0, 0).size();
+    TypedArray<srsran::cf_t> out =
+        factory.createArray<srsran::cf_t>({sequence_length, nof_alphas, nof_bases, nof_groups});
+    srsran::span<srsran::cf_t> out_view = srsran_matlab::to_span(out);
+    for (unsigned u = 0; u != nof_groups; ++u) {
+      for (unsigned v = 0; v != nof_bases; ++v) {
+        for (unsigned alpha_idx = 0; alpha_idx != nof_alphas; ++alpha_idx) {
+          srsran::span<const srsran::cf_t> sequence = collection->get(u, v, alpha_idx);
+          std::size_t                      offset   = ((u * nof_bases + v) * nof_alphas + alpha_idx) * sequence_length;
+          std::copy(sequence.begin(), sequence.end(), out_view.subspan(offset, sequence_length).begin());
+        }
+      }
+    }
+
+    outputs[0] = out;
+  }
+};
@@ -0,0 +1,229 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief NZP-CSI-RS generator MEX definition.
+
+#include "nzp_csi_rs_generator_mex.h"
+#include "srsran_matlab/support/matlab_to_srs.h"
+#include "srsran_matlab/support/parallel_for.h"
+#include "srsran_matlab/support/to_span.h"
+#include "srsran/phy/support/resource_grid_reader.h"
+#include "srsran/phy/support/resource_grid_writer.h"
+#include "srsran/ran/precoding/precoding_codebooks.h"
+#include "srsran/ran/slot_point.h"
+#include "srsran/srsvec/conversion.h"
+#include <algorithm>
+#include <functional>
+
+using matlab::mex::ArgumentList;
+using namespace matlab::data;
+using namespace srsran;
+using namespace srsran_matlab;
+
+void MexFunction::method_new(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 2;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::DOUBLE) || (inputs[1].getNumberOfElements() != 1)) {
+    mex_abort("Input 'nofWorkers' should be a scalar double.");
+  }
+  unsigned nof_workers = static_cast<unsigned>(static_cast<TypedArray<double>>(inputs[1])[0]);
+  if (nof_workers == 0) {
+    nof_workers = default_nof_workers();
+  }
+
+  if (!outputs.empty()) {
+    mex_abort("Wrong number of outputs: expected 0, provided {}.", outputs.size());
+  }
+
+  generators.clear();
+  for (unsigned i_worker = 0; i_worker != nof_workers; ++i_worker) {
+    generators.emplace_back(generator_factory->create());
+
+    // Ensure the generator was created properly.
+    if (!generators.back()) {
+      mex_abort("Cannot create srsRAN NZP-CSI-RS generator.");
+    }
+  }
+}
+
+void MexFunction::check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 3;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::STRUCT) || (inputs[1].getNumberOfElements() > 1)) {
+    mex_abort("Input 'gridConfig' must be a scalar structure.");
+  }
+
+  if ((inputs[2].getType() != ArrayType::STRUCT) || (inputs[2].getNumberOfElements() == 0)) {
+    mex_abort("Input 'CSIRSConfigs' must be a nonempty structure array.");
+  }
+
+  if ((outputs.size() < 1) || (outputs.size() > 2)) {
+    mex_abort("Wrong number of outputs: expected 1 or 2, provided {}.", outputs.size());
+  }
+}
+
+void MexFunction::method_step(ArgumentList outputs, ArgumentList inputs)
+{
+  // Ensure the generators are initialized.
+  if (generators.empty()) {
+    mex_abort("The srsRAN NZP-CSI-RS generators were not initialized properly.");
+  }
+
+  check_step_outputs_inputs(outputs, inputs);
+
+  // Resource grid dimensions.
+  StructArray     in_grid_array   = inputs[1];
+  const Struct    in_grid         = in_grid_array[0];
+  unsigned        nof_grid_rb     = in_grid["NSizeGrid"][0];
+  const CharArray in_grid_cp      = in_grid["CyclicPrefix"];
+  cyclic_prefix   grid_cp         = matlab_to_srs_cyclic_prefix(in_grid_cp.toAscii());
+  unsigned        nof_symbols     = get_nsymb_per_slot(grid_cp);
+  unsigned        nof_ports       = in_grid["NumPorts"][0];
+  unsigned        nof_subcarriers = nof_grid_rb * NRE;
+  unsigned        nof_grid_re     = nof_subcarriers * nof_symbols;
+
+  // Build all the configurations in the calling thread, since the MATLAB API is not thread-safe.
+  const StructArray                           in_cfg_array         = inputs[2];
+  unsigned                                    nof_resources        = in_cfg_array.getNumberOfElements();
+  std::vector<nzp_csi_rs_generator::config_t> configs(nof_resources);
+  std::vector<bool>                           zero_power(nof_resources);
+  unsigned                                    max_nof_csi_rs_ports = 1;
+  for (unsigned i_resource = 0; i_resource != nof_resources; ++i_resource) {
+    const Struct                    in_cfg = in_cfg_array[i_resource];
+    nzp_csi_rs_generator::config_t& config = configs[i_resource];
+
+    unsigned nof_csi_rs_ports = in_cfg["NumCSIRSPorts"][0];
+    if (nof_csi_rs_ports > nof_ports) {
+      mex_abort(
+          "CSI-RS resource {} has {} ports but the grid only has {} ports.", i_resource, nof_csi_rs_ports, nof_ports);
+    }
+    max_nof_csi_rs_ports = std::max(max_nof_csi_rs_ports, nof_csi_rs_ports);
+
+    config.slot     = slot_point(to_numerology_value(matlab_to_srs_subcarrier_spacing(in_cfg["SubcarrierSpacing"][0])),
+                             static_cast<unsigned>(in_cfg["NFrame"][0]) % 1024,
+                             static_cast<unsigned>(in_cfg["NSlot"][0]));
+    config.cp       = grid_cp;
+    config.start_rb = in_cfg["RBOffset"][0];
+    config.nof_rb   = in_cfg["NumRB"][0];
+    if (config.start_rb + config.nof_rb > nof_grid_rb) {
+      mex_abort("CSI-RS resource {} does not fit the resource grid.", i_resource);
+    }
+    config.csi_rs_mapping_table_row = in_cfg["RowNumber"][0];
+
+    const TypedArray<double> in_subcarriers = in_cfg["SubcarrierLocations"];
+    for (double k_i : in_subcarriers) {
+      config.freq_allocation_ref_idx.push_back(static_cast<unsigned>(k_i));
+    }
+
+    const TypedArray<double> in_symbols = in_cfg["SymbolLocations"];
+    if ((in_symbols.getNumberOfElements() == 0) || (in_symbols.getNumberOfElements() > 2)) {
+      mex_abort("CSI-RS resource {}: 'SymbolLocations' must have one or two entries.", i_resource);
+    }
+    config.symbol_l0 = static_cast<unsigned>(in_symbols[0]);
+    config.symbol_l1 = (in_symbols.getNumberOfElements() == 2) ? static_cast<unsigned>(in_symbols[1]) : 0;
+
+    const CharArray in_cdm     = in_cfg["CDMType"];
+    config.cdm                 = matlab_to_srs_csi_rs_cdm_type(in_cdm.toAscii());
+    const CharArray in_density = in_cfg["Density"];
+    config.freq_density        = matlab_to_srs_csi_rs_density(in_density.toAscii());
+    config.scrambling_id       = in_cfg["NID"][0];
+    config.precoding           = precoding_configuration::make_wideband(make_identity(nof_csi_rs_ports));
+
+    // Zero-power resources are generated with unit amplitude to find their resource elements, but they are not added
+    // to the resource grid.
+    zero_power[i_resource] = static_cast<bool>(static_cast<unsigned>(in_cfg["ZeroPower"][0]));
+    config.amplitude = zero_power[i_resource] ? 1.0F : static_cast<float>(static_cast<double>(in_cfg["Amplitude"][0]));
+  }
+
+  bool             with_bitmaps = (outputs.size() == 2);
+  TypedArray<bool> out_bitmaps =
+      factory.createArray<bool>({nof_subcarriers, nof_symbols, with_bitmaps ? nof_resources : 0U});
+  span<bool> bitmap_view = with_bitmaps ? to_span(out_bitmaps) : span<bool>();
+
+  // Each worker maps its resources onto a scratch grid, detects the occupied resource elements and accumulates the
+  // nonzero-power resources onto its own buffer.
+  unsigned nof_workers = std::min(nof_resources, static_cast<unsigned>(generators.size()));
+  std::vector<std::unique_ptr<resource_grid>> scratch_grids;
+  std::vector<std::vector<cf_t>>              worker_grids(nof_workers, std::vector<cf_t>(nof_grid_re * nof_ports));
+  for (unsigned i_worker = 0; i_worker != nof_workers; ++i_worker) {
+    scratch_grids.emplace_back(create_resource_grid(nof_subcarriers, nof_symbols, max_nof_csi_rs_ports));
+    if (!scratch_grids.back()) {
+      mex_abort("Cannot create resource grid.");
+    }
+  }
+
+  try {
+    parallel_for(nof_resources, nof_workers, [&](unsigned i_resource, unsigned i_worker) {
+      const nzp_csi_rs_generator::config_t& config  = configs[i_resource];
+      resource_grid&                        scratch = *scratch_grids[i_worker];
+
+      scratch.set_all_zero();
+      generators[i_worker]->map(scratch.get_writer(), config);
+
+      const resource_grid_reader& reader = scratch.get_reader();
+      std::vector<cf_t>&          accum  = worker_grids[i_worker];
+      std::vector<cf_t>           symbol_buffer(nof_subcarriers);
+      span<bool>                  bitmap;
+      if (with_bitmaps) {
+        bitmap = bitmap_view.subspan(i_resource * nof_grid_re, nof_grid_re);
+      }
+      for (unsigned i_port = 0, nof_csi_rs_ports = config.precoding.get_nof_ports(); i_port != nof_csi_rs_ports;
+           ++i_port) {
+        for (unsigned i_symbol = 0; i_symbol != nof_symbols; ++i_symbol) {
+          srsvec::convert(symbol_buffer, reader.get_view(i_port, i_symbol).first(nof_subcarriers));
+          cf_t* accum_symbol = accum.data() + (i_port * nof_symbols + i_symbol) * nof_subcarriers;
+          for (unsigned i_subc = 0; i_subc != nof_subcarriers; ++i_subc) {
+            if (symbol_buffer[i_subc] == cf_t()) {
+              continue;
+            }
+            if (!bitmap.empty()) {
+              bitmap[i_symbol * nof_subcarriers + i_subc] = true;
+            }
+            if (!zero_power[i_resource]) {
+              accum_symbol[i_subc] += symbol_buffer[i_subc];
+            }
+          }
+        }
+      }
+    });
+  } catch (const std::exception& e) {
+    mex_abort("Cannot process the CSI-RS resources: {}", e.what());
+  }
+
+  // Combine the buffers of all workers.
+  TypedArray<cf_t> out_grid  = factory.createArray<cf_t>({nof_subcarriers, nof_symbols, nof_ports});
+  span<cf_t>       grid_view = to_span(out_grid);
+  for (const std::vector<cf_t>& accum : worker_grids) {
+    std::transform(grid_view.begin(), grid_view.end(), accum.begin(), grid_view.begin(), std::plus<cf_t>());
+  }
+
+  outputs[0] = out_grid;
+  if (with_bitmaps) {
+    outputs[1] = out_bitmaps;
+  }
+}
@@ -0,0 +1,120 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief NZP-CSI-RS generator MEX declaration.
+
+#pragma once
+
+#include "srsran_matlab/srsran_mex_dispatcher.h"
+#include "srsran/phy/generic_functions/precoding/precoding_factories.h"
+#include "srsran/phy/support/resource_grid.h"
+#include "srsran/phy/support/support_factories.h"
+#include "srsran/phy/upper/sequence_generators/sequence_generator_factories.h"
+#include "srsran/phy/upper/signal_processors/signal_processor_factories.h"
+#include <memory>
+#include <vector>
+
+/// Factory method for the NZP-CSI-RS generator factory.
+inline std::shared_ptr<srsran::nzp_csi_rs_generator_factory> create_nzp_csi_rs_generator_factory();
+
+/// \brief Implements an NZP-CSI-RS generator following the srsran_mex_dispatcher template.
+///
+/// The MEX maps all the CSI-RS resources of a resource set into a single resource grid with one call and returns, for
+/// each resource, the bitmap of the resource elements it occupies. The resources are processed in parallel by a pool
+/// of worker threads, each one with its own srsRAN NZP-CSI-RS generator.
+class MexFunction : public srsran_mex_dispatcher
+{
+public:
+  /// Constructor: creates the NZP-CSI-RS generator factory and the callback methods.
+  MexFunction()
+  {
+    // Ensure srsRAN NZP-CSI-RS generator factory was created successfully.
+    if (!generator_factory) {
+      mex_abort("Cannot create srsRAN NZP-CSI-RS generator factory.");
+    }
+
+    create_callback("new", [this](ArgumentList out, ArgumentList in) { this->method_new(out, in); });
+    create_callback("step", [this](ArgumentList out, ArgumentList in) { this->method_step(out, in); });
+  }
+
+private:
+  /// Checks that outputs/inputs arguments match the requirements of method_step().
+  void check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Creates the pool of NZP-CSI-RS generators.
+  ///
+  /// The method accepts two inputs.
+  ///   - The string <tt>"new"</tt>.
+  ///   - The number of worker threads (set it to zero to use as many workers as hardware threads).
+  ///
+  /// The method has no output.
+  void method_new(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Maps a set of CSI-RS resources into a resource grid.
+  ///
+  /// The method takes three inputs.
+  ///   - The string <tt>"step"</tt>.
+  ///   - A one-dimensional structure describing the resource grid, with fields
+  ///      - \c NSizeGrid, number of resource blocks of the resource grid (the grid starts at CRB 0);
+  ///      - \c CyclicPrefix, cyclic prefix (<tt>"normal"</tt> or <tt>"extended"</tt>);
+  ///      - \c NumPorts, number of antenna ports of the resource grid.
+  ///   - A structure array with one entry for each CSI-RS resource. The fields are
+  ///      - \c SubcarrierSpacing, subcarrier spacing in kHz;
+  ///      - \c NFrame, system frame number;
+  ///      - \c NSlot, slot number within the frame;
+  ///      - \c RowNumber, row of TS38.211 Table 7.4.1.5.3-1 describing the resource;
+  ///      - \c NumCSIRSPorts, number of CSI-RS ports of the resource (mapped onto ports 0, 1, ...);
+  ///      - \c Density, frequency density (<tt>"one"</tt>, <tt>"three"</tt>, <tt>"dot5even"</tt> or
+  ///        <tt>"dot5odd"</tt>);
+  ///      - \c CDMType, CDM type (<tt>"noCDM"</tt>, <tt>"FD-CDM2"</tt>, <tt>"CDM4"</tt> or <tt>"CDM8"</tt>);
+  ///      - \c SubcarrierLocations, frequency-domain locations \f$k_i\f$;
+  ///      - \c SymbolLocations, time-domain locations \f$l_0\f$ and, if needed, \f$l_1\f$;
+  ///      - \c RBOffset, first resource block of the resource, relative to CRB 0;
+  ///      - \c NumRB, number of resource blocks of the resource;
+  ///      - \c NID, scrambling identifier;
+  ///      - \c Amplitude, amplitude of the CSI-RS symbols;
+  ///      - \c ZeroPower, boolean flag: if true, the resource only contributes to the reserved-RE bitmaps (ZP-CSI-RS).
+  ///
+  /// The method has two outputs.
+  ///   - A three-dimensional array of \c cf_t with the transmit resource grid (dimensions are subcarriers, OFDM
+  ///     symbols and antenna ports). Overlapping resources are superimposed.
+  ///   - A three-dimensional boolean array with the resource elements occupied by each resource on any of its ports
+  ///     (dimensions are subcarriers, OFDM symbols and resources).
+  void method_step(ArgumentList outputs, ArgumentList inputs);
+
+  /// NZP-CSI-RS generator factory.
+  std::shared_ptr<srsran::nzp_csi_rs_generator_factory> generator_factory = create_nzp_csi_rs_generator_factory();
+  /// Pool of NZP-CSI-RS generators, one for each worker thread.
+  std::vector<std::unique_ptr<srsran::nzp_csi_rs_generator>> generators;
+};
+
+std::shared_ptr<srsran::nzp_csi_rs_generator_factory> create_nzp_csi_rs_generator_factory()
+{
+  using namespace srsran;
+
+  std::shared_ptr<pseudo_random_generator_factory> prg_factory = create_pseudo_random_generator_sw_factory();
+
+  std::shared_ptr<channel_precoder_factory> precoder_factory = create_channel_precoder_factory("auto");
+
+  std::shared_ptr<resource_grid_mapper_factory> rg_mapper_factory =
+      create_resource_grid_mapper_factory(precoder_factory);
+
+  return create_nzp_csi_rs_generator_factory_sw(prg_factory, rg_mapper_factory);
+}
@@ -0,0 +1,200 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief SRS channel estimator MEX definition.
+
+#include "srs_estimator_mex.h"
+#include "srsran_matlab/support/matlab_to_srs.h"
+#include "srsran_matlab/support/parallel_for.h"
+#include "srsran_matlab/support/resource_grid.h"
+#include "srsran/phy/support/resource_grid_reader.h"
+#include "srsran/phy/upper/signal_processors/srs/srs_estimator_configuration.h"
+#include "srsran/phy/upper/signal_processors/srs/srs_estimator_result.h"
+#include "srsran/ran/slot_point.h"
+#include <MatlabDataArray/ArrayDimensions.hpp>
+
+using namespace matlab::data;
+using namespace srsran;
+using namespace srsran_matlab;
+
+void MexFunction::method_new(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 2;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::DOUBLE) || (inputs[1].getNumberOfElements() != 1)) {
+    mex_abort("Input 'nofWorkers' should be a scalar double.");
+  }
+  unsigned nof_workers = static_cast<unsigned>(static_cast<TypedArray<double>>(inputs[1])[0]);
+  if (nof_workers == 0) {
+    nof_workers = default_nof_workers();
+  }
+
+  if (!outputs.empty()) {
+    mex_abort("Wrong number of outputs: expected 0, provided {}.", outputs.size());
+  }
+
+  estimators.clear();
+  for (unsigned i_worker = 0; i_worker != nof_workers; ++i_worker) {
+    estimators.emplace_back(estimator_factory->create());
+
+    // Ensure the estimator was created properly.
+    if (!estimators.back()) {
+      mex_abort("Cannot create srsRAN SRS estimator.");
+    }
+  }
+}
+
+void MexFunction::check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 4;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  ArrayDimensions in1_dims = inputs[1].getDimensions();
+  if ((inputs[1].getType() != ArrayType::COMPLEX_SINGLE) || (in1_dims.size() < 2) || (in1_dims.size() > 3)) {
+    mex_abort("Input 'rxGrid' should be a 2- or 3-dimensional array of complex floats, provided [{}].", in1_dims);
+  }
+
+  if ((inputs[2].getType() != ArrayType::STRUCT) || (inputs[2].getNumberOfElements() > 1)) {
+    mex_abort("Input 'slotConfig' should be a scalar structure.");
+  }
+
+  if ((inputs[3].getType() != ArrayType::STRUCT) || (inputs[3].getNumberOfElements() == 0)) {
+    mex_abort("Input 'srsConfigs' should be a nonempty structure array.");
+  }
+
+  constexpr unsigned NOF_OUTPUTS = 1;
+  if (outputs.size() != NOF_OUTPUTS) {
+    mex_abort("Wrong number of outputs: expected {}, provided {}.", NOF_OUTPUTS, outputs.size());
+  }
+}
+
+void MexFunction::method_step(ArgumentList outputs, ArgumentList inputs)
+{
+  // Ensure the estimators are initialized.
+  if (estimators.empty()) {
+    mex_abort("The srsRAN SRS estimators were not initialized properly.");
+  }
+
+  check_step_outputs_inputs(outputs, inputs);
+
+  // Read the resource grid from inputs[1].
+  std::unique_ptr<resource_grid> grid = read_resource_grid(inputs[1]);
+  if (!grid) {
+    mex_abort("Cannot create resource grid.");
+  }
+  const resource_grid_reader& grid_reader  = grid->get_reader();
+  unsigned                    nof_rx_ports = grid_reader.get_nof_ports();
+
+  StructArray        in_slot_array = inputs[2];
+  const Struct       in_slot       = in_slot_array[0];
+  subcarrier_spacing scs = matlab_to_srs_subcarrier_spacing(static_cast<unsigned>(in_slot["SubcarrierSpacing"][0]));
+  unsigned           n_frame = static_cast<unsigned>(in_slot["NFrame"][0]);
+  unsigned           n_slot  = static_cast<unsigned>(in_slot["NSlot"][0]);
+  slot_point         slot(scs, n_frame, n_slot);
+
+  // Build all the configurations in the calling thread, since the MATLAB API is not thread-safe.
+  const StructArray                        in_srs_array = inputs[3];
+  unsigned                                 nof_srs      = in_srs_array.getNumberOfElements();
+  std::vector<srs_estimator_configuration> configs(nof_srs);
+  for (unsigned i_srs = 0; i_srs != nof_srs; ++i_srs) {
+    const Struct                 in_srs = in_srs_array[i_srs];
+    srs_estimator_configuration& config = configs[i_srs];
+
+    config.slot = slot;
+
+    srs_resource_configuration& resource = config.resource;
+    resource.nof_antenna_ports =
+        static_cast<srs_resource_configuration::one_two_four_enum>(static_cast<unsigned>(in_srs["NumSRSPorts"][0]));
+    resource.nof_symbols =
+        static_cast<srs_resource_configuration::one_two_four_enum>(static_cast<unsigned>(in_srs["NumSRSSymbols"][0]));
+    resource.start_symbol        = static_cast<unsigned>(in_srs["SymbolStart"][0]);
+    resource.configuration_index = static_cast<unsigned>(in_srs["CSRS"][0]);
+    resource.sequence_id         = static_cast<unsigned>(in_srs["NSRSID"][0]);
+    resource.bandwidth_index     = static_cast<unsigned>(in_srs["BSRS"][0]);
+    resource.comb_size =
+        static_cast<srs_resource_configuration::comb_size_enum>(static_cast<unsigned>(in_srs["KTC"][0]));
+    resource.comb_offset   = static_cast<unsigned>(in_srs["KBarTC"][0]);
+    resource.cyclic_shift  = static_cast<unsigned>(in_srs["CyclicShift"][0]);
+    resource.freq_position = static_cast<unsigned>(in_srs["NRRC"][0]);
+    resource.freq_shift    = static_cast<unsigned>(in_srs["FrequencyStart"][0]);
+    resource.freq_hopping  = static_cast<unsigned>(in_srs["BHop"][0]);
+
+    const CharArray   in_hop     = in_srs["GroupSeqHopping"];
+    const std::string hop_string = in_hop.toAscii();
+    if (hop_string == "neither") {
+      resource.hopping = srs_resource_configuration::group_or_sequence_hopping_enum::neither;
+    } else if (hop_string == "groupHopping") {
+      resource.hopping = srs_resource_configuration::group_or_sequence_hopping_enum::group_hopping;
+    } else if (hop_string == "sequenceHopping") {
+      resource.hopping = srs_resource_configuration::group_or_sequence_hopping_enum::sequence_hopping;
+    } else {
+      mex_abort("Unknown group or sequence hopping {}.", hop_string);
+    }
+
+    // The periodicity is only relevant to frequency hopping, which is not supported.
+    const CharArray in_type = in_srs["ResourceType"];
+    if (in_type.toAscii() == "periodic") {
+      resource.periodicity.emplace();
+    }
+
+    for (unsigned i_port = 0; i_port != nof_rx_ports; ++i_port) {
+      config.ports.emplace_back(i_port);
+    }
+
+    error_type<std::string> validation = validator->is_valid(config);
+    if (!validation.has_value()) {
+      mex_abort("The SRS configuration {} is invalid: {}.", i_srs, validation.error());
+    }
+  }
+
+  // Estimate all SRS transmissions in parallel, each worker with its own estimator.
+  std::vector<srs_estimator_result> results(nof_srs);
+  parallel_for(nof_srs, estimators.size(), [&](unsigned i_srs, unsigned i_worker) {
+    results[i_srs] = estimators[i_worker]->estimate(grid_reader, configs[i_srs]);
+  });
+
+  StructArray srs_out =
+      factory.createStructArray({nof_srs, 1}, {"ChannelMatrix", "EPRE", "NoiseVariance", "TimeAlignment"});
+  for (unsigned i_srs = 0; i_srs != nof_srs; ++i_srs) {
+    const srs_estimator_result& result       = results[i_srs];
+    unsigned                    nof_tx_ports = result.channel_matrix.get_nof_tx_ports();
+
+    TypedArray<std::complex<double>> ch_matrix_out =
+        factory.createArray<std::complex<double>>({nof_rx_ports, nof_tx_ports});
+    for (unsigned i_tx_port = 0; i_tx_port != nof_tx_ports; ++i_tx_port) {
+      for (unsigned i_rx_port = 0; i_rx_port != nof_rx_ports; ++i_rx_port) {
+        cf_t coefficient                    = result.channel_matrix.get_coefficient(i_rx_port, i_tx_port);
+        ch_matrix_out[i_rx_port][i_tx_port] = std::complex<double>(coefficient.real(), coefficient.imag());
+      }
+    }
+
+    srs_out[i_srs]["ChannelMatrix"] = ch_matrix_out;
+    srs_out[i_srs]["EPRE"]          = factory.createScalar(static_cast<double>(result.epre_dB));
+    srs_out[i_srs]["NoiseVariance"] = factory.createScalar(static_cast<double>(result.noise_variance));
+    srs_out[i_srs]["TimeAlignment"] = factory.createScalar(result.time_align.to_seconds());
+  }
+
+  outputs[0] = srs_out;
+}
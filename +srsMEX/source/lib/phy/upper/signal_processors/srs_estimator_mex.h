@@ -0,0 +1,130 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief SRS channel estimator MEX declaration.
+
+#pragma once
+
+#include "srsran_matlab/srsran_mex_dispatcher.h"
+#include "srsran/phy/generic_functions/generic_functions_factories.h"
+#include "srsran/phy/support/time_alignment_estimator/time_alignment_estimator_factories.h"
+#include "srsran/phy/upper/sequence_generators/sequence_generator_factories.h"
+#include "srsran/phy/upper/signal_processors/srs/srs_estimator.h"
+#include "srsran/phy/upper/signal_processors/srs/srs_estimator_factory.h"
+#include <memory>
+#include <vector>
+
+/// Factory method for the SRS channel estimator factory.
+inline std::shared_ptr<srsran::srs_estimator_factory> create_srs_estimator_factory();
+
+/// \brief Implements an SRS channel estimator leveraging srsRAN \c srs_estimator.
+///
+/// The MEX estimates the channel of a list of SRS transmissions (e.g., from multiple UEs) sharing the same received
+/// resource grid. The transmissions are processed in parallel by a pool of worker threads, each one with its own
+/// srsRAN SRS estimator.
+class MexFunction : public srsran_mex_dispatcher
+{
+public:
+  /// Constructor: creates the SRS estimator factory and the callback methods.
+  MexFunction()
+  {
+    // Ensure srsRAN SRS estimator factory and validator were created successfully.
+    if (!estimator_factory) {
+      mex_abort("Cannot create srsRAN SRS estimator factory.");
+    }
+    if (!validator) {
+      mex_abort("Cannot create srsRAN SRS estimator configuration validator.");
+    }
+
+    create_callback("new", [this](ArgumentList out, ArgumentList in) { this->method_new(out, in); });
+    create_callback("step", [this](ArgumentList out, ArgumentList in) { this->method_step(out, in); });
+  }
+
+private:
+  /// Checks that outputs/inputs arguments match the requirements of method_step().
+  void check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Creates the pool of SRS estimators.
+  ///
+  /// The method accepts two inputs.
+  ///   - The string <tt>"new"</tt>.
+  ///   - The number of worker threads (set it to zero to use as many workers as hardware threads).
+  ///
+  /// The method has no output.
+  void method_new(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Estimates the channel of a list of SRS transmissions.
+  ///
+  /// The method has four inputs.
+  ///   - The string <tt>"step"</tt>.
+  ///   - A resource grid: a 2- or 3-dimensional array of complex single-precision floats representing the received IQ
+  ///     samples for all subcarriers, OFDM symbols and Rx antenna ports.
+  ///   - A one-dimensional structure describing the slot, with fields
+  ///      - \c SubcarrierSpacing, the subcarrier spacing in kHz;
+  ///      - \c NFrame, the system frame number;
+  ///      - \c NSlot, the slot number within the frame.
+  ///   - A structure array with one entry for each SRS transmission. The fields are
+  ///      - \c NumSRSPorts, number of SRS antenna ports \f$\{1, 2, 4\}\f$;
+  ///      - \c NumSRSSymbols, number of OFDM symbols allocated to the SRS \f$\{1, 2, 4\}\f$;
+  ///      - \c SymbolStart, first OFDM symbol allocated to the SRS \f$\{0, \dots, 13\}\f$;
+  ///      - \c CSRS, bandwidth configuration index \f$C_{\textup{SRS}}\f$ \f$\{0, \dots, 63\}\f$;
+  ///      - \c NSRSID, sequence identifier \f$\{0, \dots, 1023\}\f$;
+  ///      - \c BSRS, bandwidth index \f$B_{\textup{SRS}}\f$ \f$\{0, \dots, 3\}\f$;
+  ///      - \c KTC, transmission comb size \f$\{2, 4\}\f$;
+  ///      - \c KBarTC, transmission comb offset \f$\{0, \dots, K_{\textup{TC}}-1\}\f$;
+  ///      - \c CyclicShift, cyclic shift \f$\{0, \dots, 11\}\f$;
+  ///      - \c NRRC, frequency domain position \f$n_{\textup{RRC}}\f$ \f$\{0, \dots, 67\}\f$;
+  ///      - \c FrequencyStart, frequency domain shift \f$n_{\textup{shift}}\f$ \f$\{0, \dots, 268\}\f$;
+  ///      - \c BHop, frequency hopping index \f$b_{\textup{hop}}\f$ \f$\{0, \dots, 3\}\f$;
+  ///      - \c GroupSeqHopping, group or sequence hopping (<tt>"neither"</tt>, <tt>"groupHopping"</tt> or
+  ///        <tt>"sequenceHopping"</tt>);
+  ///      - \c ResourceType, resource type (<tt>"aperiodic"</tt>, <tt>"semi-persistent"</tt> or
+  ///        <tt>"periodic"</tt>).
+  ///
+  /// The method has one output.
+  ///   - A structure array with as many entries as SRS transmissions. The fields are
+  ///      - \c ChannelMatrix, the wideband channel matrix (Rx ports by SRS ports);
+  ///      - \c EPRE, the estimated EPRE in decibel;
+  ///      - \c NoiseVariance, the estimated noise variance;
+  ///      - \c TimeAlignment, the estimated time alignment in seconds.
+  void method_step(ArgumentList outputs, ArgumentList inputs);
+
+  /// SRS estimator factory.
+  std::shared_ptr<srsran::srs_estimator_factory> estimator_factory = create_srs_estimator_factory();
+  /// SRS estimator configuration validator.
+  std::unique_ptr<srsran::srs_estimator_configuration_validator> validator =
+      estimator_factory ? estimator_factory->create_validator() : nullptr;
+  /// Pool of SRS estimators, one for each worker thread.
+  std::vector<std::unique_ptr<srsran::srs_estimator>> estimators;
+};
+
+std::shared_ptr<srsran::srs_estimator_factory> create_srs_estimator_factory()
+{
+  using namespace srsran;
+
+  std::shared_ptr<low_papr_sequence_generator_factory> lpapr_factory = create_low_papr_sequence_generator_sw_factory();
+
+  std::shared_ptr<dft_processor_factory> dft_factory = create_dft_processor_factory_fftw_slow();
+
+  std::shared_ptr<time_alignment_estimator_factory> ta_est_factory =
+      create_time_alignment_estimator_dft_factory(dft_factory);
+
+  return create_srs_estimator_generic_factory(lpapr_factory, ta_est_factory, MAX_RB);
+}
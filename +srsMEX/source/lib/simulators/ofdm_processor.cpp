@@ -0,0 +1,150 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief OFDM slot modulator and demodulator definition.
+
+#include "srsran_matlab/simulators/ofdm_processor.h"
+#include "srsran/srsvec/conversion.h"
+#include "srsran/srsvec/copy.h"
+#include "srsran/srsvec/zero.h"
+#include "srsran/support/srsran_assert.h"
+#include <cmath>
+
+using namespace srsran;
+using namespace srsran_matlab;
+
+ofdm_processor::ofdm_processor(const ofdm_processor_config& config_, dft_processor_factory& dft_factory) :
+  config(config_),
+  sampling_rate(static_cast<double>(config.dft_size) * 15e3 * (1U << to_numerology_value(config.scs))),
+  idft(dft_factory.create({config.dft_size, dft_processor::direction::INVERSE})),
+  dft(dft_factory.create({config.dft_size, dft_processor::direction::DIRECT})),
+  symbol_buffer(config.nof_subcarriers)
+{
+  srsran_assert(config.nof_subcarriers <= config.dft_size,
+                "The number of subcarriers (i.e., {}) exceeds the DFT size (i.e., {}).",
+                config.nof_subcarriers,
+                config.dft_size);
+  srsran_assert((config.cp_fraction >= 0) && (config.cp_fraction <= 1),
+                "Invalid cyclic prefix fraction {}.",
+                config.cp_fraction);
+}
+
+unsigned ofdm_processor::get_cp_length(unsigned i_slot, unsigned i_symbol) const
+{
+  // Cyclic prefix lengths as per TS38.211 Section 5.3.1, scaled from the reference DFT size of 2048.
+  if (config.cp == cyclic_prefix::EXTENDED) {
+    return 512 * config.dft_size / 2048;
+  }
+
+  // The first OFDM symbol of every half subframe has a longer cyclic prefix.
+  unsigned nof_symbols_half_subframe = 7U << to_numerology_value(config.scs);
+  unsigned nof_slots_subframe        = 1U << to_numerology_value(config.scs);
+  unsigned i_symbol_subframe         = (i_slot % nof_slots_subframe) * get_nsymb_per_slot(config.cp) + i_symbol;
+  unsigned cp_length                 = 144 * config.dft_size / 2048;
+  if (i_symbol_subframe % nof_symbols_half_subframe == 0) {
+    cp_length += 16 * config.dft_size / 2048;
+  }
+  return cp_length;
+}
+
+unsigned ofdm_processor::get_slot_size(unsigned i_slot) const
+{
+  unsigned slot_size = 0;
+  for (unsigned i_symbol = 0, nof_symbols = get_nsymb_per_slot(config.cp); i_symbol != nof_symbols; ++i_symbol) {
+    slot_size += get_cp_length(i_slot, i_symbol) + config.dft_size;
+  }
+  return slot_size;
+}
+
+void ofdm_processor::modulate(span<cf_t> output, const resource_grid_reader& grid, unsigned i_port, unsigned i_slot)
+{
+  srsran_assert(output.size() == get_slot_size(i_slot),
+                "The output size (i.e., {}) does not match the slot size (i.e., {}).",
+                output.size(),
+                get_slot_size(i_slot));
+
+  unsigned nof_subcarriers = config.nof_subcarriers;
+  unsigned half_grid       = nof_subcarriers / 2;
+  unsigned dft_size        = config.dft_size;
+  float    scaling         = 1.0F / static_cast<float>(dft_size);
+
+  for (unsigned i_symbol = 0, nof_symbols = get_nsymb_per_slot(config.cp); i_symbol != nof_symbols; ++i_symbol) {
+    srsvec::convert(symbol_buffer, grid.get_view(i_port, i_symbol).first(nof_subcarriers));
+
+    // Map the grid around DC: the upper half of the grid goes to the first DFT bins, the lower half to the last ones.
+    span<cf_t>       idft_input = idft->get_input();
+    span<const cf_t> grid_symbol(symbol_buffer);
+    srsvec::zero(idft_input);
+    srsvec::copy(idft_input.first(nof_subcarriers - half_grid), grid_symbol.last(nof_subcarriers - half_grid));
+    srsvec::copy(idft_input.last(half_grid), grid_symbol.first(half_grid));
+
+    span<const cf_t> idft_output = idft->run();
+
+    // Write the cyclic prefix followed by the useful part of the symbol.
+    unsigned   cp_length = get_cp_length(i_slot, i_symbol);
+    span<cf_t> symbol    = output.first(cp_length + dft_size);
+    for (unsigned i_sample = 0; i_sample != dft_size; ++i_sample) {
+      symbol[cp_length + i_sample] = scaling * idft_output[i_sample];
+    }
+    srsvec::copy(symbol.first(cp_length), symbol.last(cp_length));
+
+    output = output.last(output.size() - symbol.size());
+  }
+}
+
+void ofdm_processor::demodulate(resource_grid_writer& grid, span<const cf_t> input, unsigned i_port, unsigned i_slot)
+{
+  srsran_assert(input.size() == get_slot_size(i_slot),
+                "The input size (i.e., {}) does not match the slot size (i.e., {}).",
+                input.size(),
+                get_slot_size(i_slot));
+
+  unsigned nof_subcarriers = config.nof_subcarriers;
+  unsigned half_grid       = nof_subcarriers / 2;
+  unsigned dft_size        = config.dft_size;
+
+  for (unsigned i_symbol = 0, nof_symbols = get_nsymb_per_slot(config.cp); i_symbol != nof_symbols; ++i_symbol) {
+    // The DFT window starts inside the cyclic prefix, as in nrOFDMDemodulate.
+    unsigned cp_length    = get_cp_length(i_slot, i_symbol);
+    unsigned window_start = static_cast<unsigned>(std::floor(config.cp_fraction * cp_length));
+    unsigned advance      = cp_length - window_start;
+
+    srsvec::copy(dft->get_input(), input.subspan(window_start, dft_size));
+    span<const cf_t> dft_output = dft->run();
+
+    span<cf_t> grid_symbol(symbol_buffer);
+    srsvec::copy(grid_symbol.first(half_grid), dft_output.last(half_grid));
+    srsvec::copy(grid_symbol.last(nof_subcarriers - half_grid), dft_output.first(nof_subcarriers - half_grid));
+
+    // Compensate the phase rotation due to the window advance: subcarrier k is rotated by 2 * pi * k * advance / N,
+    // with k counted from DC.
+    if (advance != 0) {
+      double phase_step = 2.0 * M_PI * static_cast<double>(advance) / static_cast<double>(dft_size);
+      for (unsigned i_subc = 0; i_subc != nof_subcarriers; ++i_subc) {
+        double frequency = static_cast<double>(i_subc) - static_cast<double>(half_grid);
+        symbol_buffer[i_subc] *= static_cast<cf_t>(std::polar(1.0, phase_step * frequency));
+      }
+    }
+
+    grid.put(i_port, i_symbol, 0, symbol_buffer);
+
+    input = input.last(input.size() - cp_length - dft_size);
+  }
+}
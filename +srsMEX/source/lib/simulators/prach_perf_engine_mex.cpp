@@ -0,0 +1,434 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief PRACH performance simulation engine MEX definition.
+
+#include "prach_perf_engine_mex.h"
+#include "srsran_matlab/channel/matlab_to_fading_channel.h"
+#include "srsran_matlab/support/matlab_to_srs.h"
+#include "srsran_matlab/support/random_stream.h"
+#include "srsran/phy/upper/channel_processors/channel_processor_formatters.h"
+#include "srsran/ran/prach/prach_preamble_information.h"
+#include "srsran/ran/slot_point.h"
+#include "srsran/srsvec/copy.h"
+#include "srsran/srsvec/sc_prod.h"
+#include "srsran/srsvec/zero.h"
+#include <algorithm>
+#include <cmath>
+
+using matlab::mex::ArgumentList;
+using namespace matlab::data;
+using namespace srsran;
+using namespace srsran_matlab;
+
+namespace {
+
+/// Number of occasions simulated by each worker in a batch, when the simulation may stop early.
+constexpr unsigned BATCH_OCCASIONS_PER_WORKER = 16;
+
+/// Returns the configuration of the channel impairments of a PRACH link (carrier frequency offset and AWGN).
+channel_impairments_config get_impairments_config(const prach_perf_config& config)
+{
+  channel_impairments_config impairments_config;
+  impairments_config.nof_ports     = config.nof_rx_ports;
+  impairments_config.sampling_rate = config.sampling_rate;
+  impairments_config.cfo           = config.cfo;
+  impairments_config.timing_offset = 0;
+  return impairments_config;
+}
+
+/// \brief Updates the counters with the outcome of a PRACH occasion.
+///
+/// \param[in,out] counters    Counters to update.
+/// \param[in]     outcome     Outcome of the occasion.
+/// \param[in]     thresholds  Normalized detection thresholds.
+/// \param[in]     edges       Edges of the timing error histogram bins.
+/// \param[in]     config      Link configuration.
+void update_counters(prach_perf_counters&      counters,
+                     const prach_perf_outcome& outcome,
+                     span<const float>         thresholds,
+                     span<const double>        edges,
+                     const prach_perf_config&  config)
+{
+  ++counters.nof_occasions;
+
+  // Index of the histogram bin of the timing error, as in histcounts: the last bin includes its right edge.
+  unsigned nof_bins = edges.empty() ? 0 : edges.size() - 1;
+  unsigned i_bin    = nof_bins;
+  if ((nof_bins != 0) && (outcome.timing_error >= edges.front()) && (outcome.timing_error <= edges.back())) {
+    i_bin = std::upper_bound(edges.begin(), edges.end(), outcome.timing_error) - edges.begin() - 1;
+    i_bin = std::min(i_bin, nof_bins - 1);
+  }
+
+  for (unsigned i_threshold = 0, nof_thresholds = thresholds.size(); i_threshold != nof_thresholds; ++i_threshold) {
+    if (outcome.metric < thresholds[i_threshold]) {
+      continue;
+    }
+    ++counters.detected[i_threshold];
+
+    if (!config.is_detection_test) {
+      continue;
+    }
+    counters.detected_perfect[i_threshold] += (outcome.timing_error <= config.time_error_tolerance) ? 1 : 0;
+    counters.timing_error_sum[i_threshold] += outcome.timing_error;
+    counters.timing_error_sq_sum[i_threshold] += outcome.timing_error * outcome.timing_error;
+    if (i_bin != nof_bins) {
+      ++counters.timing_error_histogram[i_threshold * nof_bins + i_bin];
+    }
+  }
+}
+
+/// Returns the number of failures with the first detection threshold, as counted by PRACHPERF.
+unsigned get_nof_failures(const prach_perf_counters& counters, const prach_perf_config& config)
+{
+  return config.is_detection_test ? (counters.nof_occasions - counters.detected.front()) : counters.detected.front();
+}
+
+/// \brief Creates a MATLAB array of doubles with the given dimensions from a vector of counters.
+///
+/// The counters are copied in column-major order, that is with the first dimension running the fastest.
+template <typename T>
+TypedArray<double> create_double_array(ArrayFactory& factory, ArrayDimensions dims, const std::vector<T>& values)
+{
+  TypedArray<double> out = factory.createArray<double>(std::move(dims));
+  std::copy(values.begin(), values.end(), out.begin());
+  return out;
+}
+
+} // namespace
+
+prach_perf_worker::prach_perf_worker(const prach_perf_config&    config_,
+                                     span<const cf_t>            waveform_,
+                                     const prach_link_factories& factories) :
+  config(config_),
+  waveform(waveform_),
+  demodulator(factories.demodulator ? factories.demodulator->create() : nullptr),
+  detector(factories.detector ? factories.detector->create() : nullptr),
+  buffer(is_long_preamble(config.demodulator.format) ? create_prach_buffer_long(config.nof_rx_ports, 1)
+                                                     : create_prach_buffer_short(config.nof_rx_ports, 1, 1)),
+  channel(config.fading),
+  impairments(get_impairments_config(config))
+{
+  unsigned max_delay = *std::max_element(config.timing_delays.begin(), config.timing_delays.end());
+  unsigned max_size  = waveform.size() + max_delay + fading_channel::FILTER_DELAY;
+  tx_samples.resize(max_size);
+  rx_samples.resize(config.nof_rx_ports * max_size);
+}
+
+prach_perf_outcome prach_perf_worker::run_occasion(unsigned i_snr, unsigned i_occasion, float noise_var)
+{
+  // Transmitter: delay the waveform by the timing offset of the occasion. The fading channel filters add their own
+  // implementation delay, which is compensated for at the receiver.
+  unsigned i_offset     = i_occasion % config.timing_offsets.size();
+  unsigned delay        = config.timing_delays[i_offset];
+  unsigned filter_delay = config.is_awgn ? 0 : fading_channel::FILTER_DELAY;
+  unsigned nof_samples  = waveform.size() + delay;
+  unsigned block_size   = nof_samples + filter_delay;
+
+  span<cf_t> tx_block = span<cf_t>(tx_samples).first(block_size);
+  span<cf_t> rx_block = span<cf_t>(rx_samples).first(config.nof_rx_ports * block_size);
+  if (config.is_detection_test) {
+    srsvec::zero(tx_block.first(delay));
+    srsvec::copy(tx_block.subspan(delay, waveform.size()), waveform);
+    srsvec::zero(tx_block.last(filter_delay));
+
+    if (config.is_awgn) {
+      // Same as PRACHPERF TrivialChannel: the waveform is replicated at each receive antenna with normalized power.
+      float scaling = 1.0F / std::sqrt(static_cast<float>(config.nof_rx_ports));
+      for (unsigned i_port = 0; i_port != config.nof_rx_ports; ++i_port) {
+        srsvec::sc_prod(rx_block.subspan(i_port * block_size, block_size), tx_block, scaling);
+      }
+    } else {
+      // The PRACH receiver is memoryless: a new fading realization for each occasion, as in PRACHPERF.
+      channel.reset(random_stream_id{config.seed, i_snr, i_occasion, 0, random_purpose::fading});
+      channel.run(rx_block, tx_block);
+    }
+  } else {
+    srsvec::zero(rx_block);
+  }
+
+  // Every occasion starts afresh: new noise and frequency offset starting at phase zero.
+  impairments.reset(random_stream_id{config.seed, i_snr, i_occasion, 0, random_purpose::noise});
+  ofdm_prach_demodulator::configuration demod_config = config.demodulator;
+  for (unsigned i_port = 0; i_port != config.nof_rx_ports; ++i_port) {
+    span<cf_t> rx_port = rx_block.subspan(i_port * block_size + filter_delay, nof_samples);
+    impairments.run(rx_port, i_port, noise_var);
+
+    demod_config.port = i_port;
+    demodulator->demodulate(*buffer, rx_port, demod_config);
+  }
+
+  prach_detection_result result = detector->detect(*buffer, config.detector);
+
+  prach_perf_outcome outcome;
+  for (const prach_detection_result::preamble_indication& preamble : result.preambles) {
+    if (!config.is_detection_test) {
+      // For the false alarm test, any preamble detected is wrong.
+      outcome.metric = std::max(outcome.metric, static_cast<float>(preamble.detection_metric));
+    } else if (preamble.preamble_index == config.preamble_index) {
+      outcome.metric       = static_cast<float>(preamble.detection_metric);
+      outcome.timing_error = std::abs(preamble.time_advance.to_seconds() * 1e6 - config.timing_offsets[i_offset]);
+    }
+  }
+  return outcome;
+}
+
+void MexFunction::method_new(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 2;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::DOUBLE) || (inputs[1].getNumberOfElements() != 1)) {
+    mex_abort("Input 'nofWorkers' should be a scalar double.");
+  }
+
+  if (!outputs.empty()) {
+    mex_abort("Wrong number of outputs: expected 0, provided {}.", outputs.size());
+  }
+
+  unsigned nof_workers_in = static_cast<unsigned>(static_cast<TypedArray<double>>(inputs[1])[0]);
+  nof_workers             = (nof_workers_in == 0) ? default_nof_workers() : nof_workers_in;
+}
+
+void MexFunction::check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 8;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::STRUCT) || (inputs[1].getNumberOfElements() != 1)) {
+    mex_abort("Input 'config' should be a scalar structure.");
+  }
+
+  ArrayDimensions in2_dims = inputs[2].getDimensions();
+  if ((inputs[2].getType() != ArrayType::COMPLEX_SINGLE) || (in2_dims.size() != 2) || (in2_dims[1] != 1) ||
+      (in2_dims[0] == 0)) {
+    mex_abort("Input 'waveform' should be a nonempty column array of complex floats.");
+  }
+
+  if ((inputs[3].getType() != ArrayType::DOUBLE) || (inputs[3].getNumberOfElements() == 0)) {
+    mex_abort("Input 'SNRIn' should be a nonempty array of doubles.");
+  }
+
+  if ((inputs[4].getType() != ArrayType::DOUBLE) || (inputs[4].getNumberOfElements() != 1)) {
+    mex_abort("Input 'nOccasions' should be a scalar double.");
+  }
+
+  if ((inputs[5].getType() != ArrayType::DOUBLE) || (inputs[5].getNumberOfElements() != 1)) {
+    mex_abort("Input 'maxFailures' should be a scalar double.");
+  }
+
+  if ((inputs[6].getType() != ArrayType::DOUBLE) || (inputs[6].getNumberOfElements() == 0)) {
+    mex_abort("Input 'thresholds' should be a nonempty array of doubles.");
+  }
+
+  if ((inputs[7].getType() != ArrayType::DOUBLE) || (inputs[7].getNumberOfElements() == 1)) {
+    mex_abort("Input 'timingErrorEdges' should be an array of doubles, either empty or with at least two elements.");
+  }
+
+  constexpr unsigned NOF_OUTPUTS = 1;
+  if (outputs.size() != NOF_OUTPUTS) {
+    mex_abort("Wrong number of outputs: expected {}, provided {}.", NOF_OUTPUTS, outputs.size());
+  }
+}
+
+prach_perf_config MexFunction::read_config(const Struct& in_cfg)
+{
+  prach_perf_config config;
+
+  // Demodulator, with the same fields as the srsPRACHDemodulator MEX. Only the first occasion is processed.
+  config.sampling_rate = in_cfg["SampleRate"][0];
+  config.dft_size      = in_cfg["Nfft"][0];
+  if ((config.sampling_rate <= 0) || (config.dft_size == 0)) {
+    mex_abort("Invalid sampling rate {} Hz with a DFT size of {}.", config.sampling_rate, config.dft_size);
+  }
+
+  const CharArray    in_format = in_cfg["Format"];
+  subcarrier_spacing scs = matlab_to_srs_subcarrier_spacing(static_cast<unsigned>(in_cfg["SubcarrierSpacing"][0]));
+  config.demodulator     = {};
+  config.demodulator.slot   = slot_point(to_numerology_value(scs), static_cast<unsigned>(in_cfg["NSlot"][0]));
+  config.demodulator.format = matlab_to_srs_preamble_format(in_format.toAscii());
+  config.demodulator.nof_td_occasions = 1;
+  config.demodulator.nof_fd_occasions = 1;
+  config.demodulator.start_symbol     = in_cfg["StartSymbol"][0];
+  config.demodulator.rb_offset        = in_cfg["RBOffset"][0];
+  config.demodulator.nof_prb_ul_grid  = in_cfg["NSizeGrid"][0];
+
+  config.nof_rx_ports = in_cfg["NRxPorts"][0];
+  if ((config.nof_rx_ports == 0) || (config.nof_rx_ports > 4)) {
+    mex_abort("Invalid number of receive antennas {}.", config.nof_rx_ports);
+  }
+
+  // Detector, with the same fields as the srsPRACHDemodulator MEX.
+  const CharArray in_restricted_set     = in_cfg["RestrictedSet"];
+  config.detector                       = {};
+  config.detector.restricted_set        = matlab_to_srs_restricted_set(in_restricted_set.toAscii());
+  config.detector.root_sequence_index   = in_cfg["SequenceIndex"][0];
+  config.detector.format                = config.demodulator.format;
+  config.detector.zero_correlation_zone = in_cfg["ZeroCorrelationZone"][0];
+  config.detector.start_preamble_index  = 0;
+  config.detector.nof_preamble_indices  = 64;
+  config.detector.ra_scs                = to_ra_subcarrier_spacing(
+      static_cast<unsigned>(1000.0 * static_cast<double>(in_cfg["PRACHSubcarrierSpacing"][0])));
+  config.detector.nof_rx_ports = config.nof_rx_ports;
+
+  std::unique_ptr<prach_detector_validator> validator =
+      create_prach_link_factories(sampling_rate::from_MHz(config.sampling_rate / 1e6)).detector->create_validator();
+  if (!validator) {
+    mex_abort("Cannot create srsRAN PRACH detector validator.");
+  }
+  if (!validator->is_valid(config.detector)) {
+    mex_abort("Invalid configuration:\n {:n}.", config.detector);
+  }
+
+  config.preamble_index = in_cfg["PreambleIndex"][0];
+  if (config.preamble_index >= 64) {
+    mex_abort("Invalid preamble index {}.", config.preamble_index);
+  }
+
+  // Timing offsets, applied as integer delays as in PRACHPERF.
+  const TypedArray<double> in_offsets = in_cfg["TimingOffsets"];
+  config.timing_offsets.assign(in_offsets.cbegin(), in_offsets.cend());
+  if (config.timing_offsets.empty()) {
+    mex_abort("Field 'TimingOffsets' should not be empty.");
+  }
+  for (double offset : config.timing_offsets) {
+    if (!std::isfinite(offset) || (offset < 0)) {
+      mex_abort("Timing offsets should be nonnegative, provided {} us.", offset);
+    }
+    config.timing_delays.push_back(static_cast<unsigned>(offset / 1e6 * config.sampling_rate));
+  }
+  config.time_error_tolerance = in_cfg["TimeErrorTolerance"][0];
+
+  // Channel.
+  const CharArray   in_profile = in_cfg["DelayProfile"];
+  const std::string profile    = in_profile.toAscii();
+  config.is_awgn               = (profile == "AWGN");
+  if (!config.is_awgn) {
+    matlab_to_fading_profile(config.fading, in_cfg, [this](const std::string& msg) { mex_abort(msg); });
+  }
+  config.fading.sampling_rate     = config.sampling_rate;
+  config.fading.nof_tx_ports      = 1;
+  config.fading.nof_rx_ports      = config.nof_rx_ports;
+  config.fading.normalize_outputs = true;
+  config.cfo                      = in_cfg["FrequencyOffset"][0];
+
+  const TypedArray<bool> in_detection_test = in_cfg["DetectionTest"];
+  config.is_detection_test                 = in_detection_test[0];
+  config.seed                              = static_cast<uint64_t>(in_cfg["Seed"][0]);
+
+  return config;
+}
+
+void MexFunction::method_step(ArgumentList outputs, ArgumentList inputs)
+{
+  check_step_outputs_inputs(outputs, inputs);
+
+  const StructArray       in_struct_array = inputs[1];
+  const prach_perf_config config          = read_config(in_struct_array[0]);
+
+  const TypedArray<std::complex<float>> in_waveform = inputs[2];
+  const std::vector<cf_t>               waveform(in_waveform.cbegin(), in_waveform.cend());
+
+  const TypedArray<double> in_snr        = inputs[3];
+  std::vector<double>      snr_values    = std::vector<double>(in_snr.cbegin(), in_snr.cend());
+  unsigned                 nof_occasions = static_cast<unsigned>(static_cast<TypedArray<double>>(inputs[4])[0]);
+  unsigned                 max_failures  = static_cast<unsigned>(static_cast<TypedArray<double>>(inputs[5])[0]);
+
+  const TypedArray<double> in_thresholds = inputs[6];
+  std::vector<float>       thresholds;
+  for (double threshold : in_thresholds) {
+    // srsRAN does not report preambles below its own threshold.
+    if (!std::isfinite(threshold) || (threshold < 1)) {
+      mex_abort("Normalized detection thresholds should be finite and not lower than one, provided {}.", threshold);
+    }
+    thresholds.push_back(static_cast<float>(threshold));
+  }
+
+  const TypedArray<double> in_edges = inputs[7];
+  std::vector<double>      edges(in_edges.cbegin(), in_edges.cend());
+  if (!std::is_sorted(edges.begin(), edges.end()) ||
+      (std::adjacent_find(edges.begin(), edges.end()) != edges.end())) {
+    mex_abort("The timing error histogram edges should be strictly increasing.");
+  }
+  unsigned nof_bins = edges.empty() ? 0 : edges.size() - 1;
+
+  // The workers are created serially, since DFT planning may not be thread-safe.
+  unsigned             nof_active_workers = std::max(1U, std::min(nof_workers, nof_occasions));
+  prach_link_factories factories = create_prach_link_factories(sampling_rate::from_MHz(config.sampling_rate / 1e6));
+  std::vector<std::unique_ptr<prach_perf_worker>> workers;
+  for (unsigned i_worker = 0; i_worker != nof_active_workers; ++i_worker) {
+    workers.emplace_back(std::make_unique<prach_perf_worker>(config, waveform, factories));
+    if (!workers.back()->is_valid()) {
+      mex_abort("Cannot create the PRACH link components.");
+    }
+  }
+
+  // Without an early stop, all occasions are simulated at once. Otherwise, occasions are simulated in small batches
+  // for each worker, so that little work is wasted once the maximum number of failures is exceeded.
+  unsigned batch_size =
+      (max_failures == 0) ? std::max(1U, nof_occasions) : nof_active_workers * BATCH_OCCASIONS_PER_WORKER;
+
+  std::vector<prach_perf_counters> results(snr_values.size(), prach_perf_counters(thresholds.size(), nof_bins));
+  std::vector<prach_perf_outcome>  outcomes(batch_size);
+  for (unsigned i_snr = 0, nof_snr = snr_values.size(); i_snr != nof_snr; ++i_snr) {
+    // Noise variance of the time-domain samples, as in PRACHPERF.
+    double snr       = std::pow(10.0, snr_values[i_snr] / 10.0);
+    float  noise_var = static_cast<float>(1.0 / (config.nof_rx_ports * config.dft_size * snr));
+
+    prach_perf_counters& result = results[i_snr];
+    bool                 stop   = false;
+    for (unsigned i_batch_start = 0; (i_batch_start < nof_occasions) && !stop; i_batch_start += batch_size) {
+      unsigned nof_batch_occasions = std::min(batch_size, nof_occasions - i_batch_start);
+      try {
+        parallel_for(nof_batch_occasions, nof_active_workers, [&](unsigned i_occasion, unsigned i_worker) {
+          outcomes[i_occasion] = workers[i_worker]->run_occasion(i_snr, i_batch_start + i_occasion, noise_var);
+        });
+      } catch (const std::exception& e) {
+        mex_abort("Cannot simulate the PRACH link: {}", e.what());
+      }
+
+      // Accumulate in occasion order, up to the occasion exceeding the maximum number of failures.
+      for (unsigned i_occasion = 0; (i_occasion != nof_batch_occasions) && !stop; ++i_occasion) {
+        update_counters(result, outcomes[i_occasion], thresholds, edges, config);
+        stop = (max_failures != 0) && (get_nof_failures(result, config) > max_failures);
+      }
+    }
+  }
+
+  std::size_t nof_thresholds = thresholds.size();
+  StructArray out            = factory.createStructArray(
+      {snr_values.size(), 1},
+      {"NumOccasions", "Detected", "DetectedPerfect", "TimingErrorSum", "TimingErrorSqSum", "TimingErrorHistogram"});
+  for (unsigned i_snr = 0, nof_snr = snr_values.size(); i_snr != nof_snr; ++i_snr) {
+    const prach_perf_counters& result = results[i_snr];
+    out[i_snr]["NumOccasions"]        = factory.createScalar(static_cast<double>(result.nof_occasions));
+    out[i_snr]["Detected"]            = create_double_array(factory, {nof_thresholds, 1}, result.detected);
+    out[i_snr]["DetectedPerfect"]     = create_double_array(factory, {nof_thresholds, 1}, result.detected_perfect);
+    out[i_snr]["TimingErrorSum"]      = create_double_array(factory, {nof_thresholds, 1}, result.timing_error_sum);
+    out[i_snr]["TimingErrorSqSum"]    = create_double_array(factory, {nof_thresholds, 1}, result.timing_error_sq_sum);
+    out[i_snr]["TimingErrorHistogram"] =
+        create_double_array(factory, {nof_bins, nof_thresholds}, result.timing_error_histogram);
+  }
+  outputs[0] = out;
+}
@@ -0,0 +1,279 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief PRACH performance simulation engine MEX declaration.
+///
+/// The engine runs the PRACH link of the PRACHPERF simulator natively: timing offset, fading channel or AWGN, carrier
+/// frequency offset, OFDM PRACH demodulation and PRACH detection. srsRAN does not provide a time-domain PRACH
+/// modulator, so the transmitted waveform is generated by MATLAB once and for all and passed to the engine, which
+/// delays it according to the timing offset of each occasion. The detection outcome of each occasion is evaluated
+/// against a list of detection thresholds at once, so that a single run provides the detection (or false alarm)
+/// probability for all of them.
+
+#pragma once
+
+#include "srsran_matlab/channel/channel_impairments.h"
+#include "srsran_matlab/channel/fading_channel.h"
+#include "srsran_matlab/srsran_mex_dispatcher.h"
+#include "srsran_matlab/support/parallel_for.h"
+#include "srsran/phy/generic_functions/generic_functions_factories.h"
+#include "srsran/phy/lower/modulation/modulation_factories.h"
+#include "srsran/phy/lower/modulation/ofdm_prach_demodulator.h"
+#include "srsran/phy/lower/sampling_rate.h"
+#include "srsran/phy/support/prach_buffer.h"
+#include "srsran/phy/upper/channel_processors/channel_processor_factories.h"
+#include "srsran/phy/upper/channel_processors/prach_detector.h"
+#include <memory>
+#include <vector>
+
+/// PRACH link and channel configuration, as read from the MATLAB configuration structure.
+struct prach_perf_config {
+  /// Sampling rate of the time-domain waveform in hertz.
+  double sampling_rate;
+  /// DFT size of the carrier OFDM modulator, used to scale the noise variance.
+  unsigned dft_size;
+  /// OFDM PRACH demodulator configuration. The port is updated for each receive antenna.
+  srsran::ofdm_prach_demodulator::configuration demodulator;
+  /// PRACH detector configuration.
+  srsran::prach_detector::configuration detector;
+  /// Index of the transmitted preamble.
+  unsigned preamble_index;
+  /// Number of receive antennas.
+  unsigned nof_rx_ports;
+  /// Timing offsets in microseconds, used cyclically by consecutive occasions.
+  std::vector<double> timing_offsets;
+  /// Timing offsets in samples (same as \ref timing_offsets, rounded towards zero).
+  std::vector<unsigned> timing_delays;
+  /// Maximum timing error, in microseconds, for a detection to be considered perfect.
+  double time_error_tolerance;
+  /// Set to \c true for an AWGN channel, \c false for a fading channel.
+  bool is_awgn;
+  /// Fading channel configuration (fading channel only).
+  srsran_matlab::fading_channel_config fading;
+  /// Carrier frequency offset in hertz.
+  double cfo;
+  /// Set to \c true for detection tests (preamble plus noise), \c false for false alarm tests (noise only).
+  bool is_detection_test;
+  /// Seed of all the random processes (fading and noise).
+  uint64_t seed;
+};
+
+/// \brief Outcome of a PRACH occasion.
+///
+/// Detection metrics are normalized to the srsRAN detection threshold, so that the detector only reports preambles
+/// with a metric not lower than one. An occasion is detected at a given threshold if its metric is not lower than the
+/// threshold.
+struct prach_perf_outcome {
+  /// \brief Detection metric of the occasion, zero if nothing was detected.
+  ///
+  /// In detection tests, this is the metric of the transmitted preamble. In false alarm tests, this is the highest
+  /// metric among all detected preambles.
+  float metric = 0;
+  /// Absolute error of the estimated timing offset in microseconds (detection tests only).
+  double timing_error = 0;
+};
+
+/// Simulation counters for a list of detection thresholds, from which PRACHPERF derives its metrics.
+struct prach_perf_counters {
+  /// Creates a set of zeroed counters for the given number of thresholds and timing error histogram bins.
+  prach_perf_counters(unsigned nof_thresholds, unsigned nof_bins) :
+    detected(nof_thresholds),
+    detected_perfect(nof_thresholds),
+    timing_error_sum(nof_thresholds),
+    timing_error_sq_sum(nof_thresholds),
+    timing_error_histogram(nof_thresholds * nof_bins)
+  {
+  }
+
+  /// Number of simulated PRACH occasions.
+  unsigned nof_occasions = 0;
+  /// \brief Number of detected occasions, for each threshold.
+  ///
+  /// In detection tests, the occasions where the transmitted preamble is detected. In false alarm tests, the occasions
+  /// where any preamble is detected.
+  std::vector<unsigned> detected;
+  /// Number of occasions where the transmitted preamble is detected with a timing error within the tolerance, for each
+  /// threshold (detection tests only).
+  std::vector<unsigned> detected_perfect;
+  /// Sum of the timing errors of the detected occasions in microseconds, for each threshold (detection tests only).
+  std::vector<double> timing_error_sum;
+  /// Sum of the squared timing errors of the detected occasions, for each threshold (detection tests only).
+  std::vector<double> timing_error_sq_sum;
+  /// \brief Histogram of the timing errors of the detected occasions (detection tests only).
+  ///
+  /// The counters are indexed as <tt>[threshold][bin]</tt>, with the bin index running the fastest.
+  std::vector<unsigned> timing_error_histogram;
+};
+
+/// Collection of srsRAN factories for the components of a PRACH receiver.
+struct prach_link_factories {
+  /// OFDM PRACH demodulator factory.
+  std::shared_ptr<srsran::ofdm_prach_demodulator_factory> demodulator;
+  /// PRACH detector factory.
+  std::shared_ptr<srsran::prach_detector_factory> detector;
+};
+
+/// \brief Factory method for the PRACH link factories.
+///
+/// Creates and assemblies the OFDM PRACH demodulator and PRACH detector factories as in the srsPRACHDemodulator MEX,
+/// for a time-domain waveform with the given sampling rate.
+inline prach_link_factories create_prach_link_factories(srsran::sampling_rate srate);
+
+/// \brief Simulates a PRACH link, one occasion at a time.
+///
+/// Each worker owns a full channel and receiver. The fading channel is drawn anew in every occasion, as in PRACHPERF.
+/// All the random processes restart at every occasion, with random streams identified by the SNR and occasion indices.
+/// Therefore, the outcome of an occasion does not depend on which worker simulates it.
+class prach_perf_worker
+{
+public:
+  /// Creates the worker components. The components are not valid if any of them could not be created.
+  prach_perf_worker(const prach_perf_config&         config_,
+                    srsran::span<const srsran::cf_t> waveform_,
+                    const prach_link_factories&      factories);
+
+  /// Returns \c true if all the components were created successfully.
+  bool is_valid() const { return demodulator && detector && buffer; }
+
+  /// \brief Simulates one PRACH occasion.
+  ///
+  /// \param[in] i_snr       SNR index, used to identify the random streams.
+  /// \param[in] i_occasion  Occasion index, used to pick the timing offset and to identify the random streams.
+  /// \param[in] noise_var   Noise variance of the time-domain samples, at each receive port.
+  /// \return The outcome of the simulated occasion.
+  prach_perf_outcome run_occasion(unsigned i_snr, unsigned i_occasion, float noise_var);
+
+private:
+  /// Link configuration.
+  const prach_perf_config& config;
+  /// Transmitted waveform, shared by all workers.
+  srsran::span<const srsran::cf_t> waveform;
+  /// OFDM PRACH demodulator.
+  std::unique_ptr<srsran::ofdm_prach_demodulator> demodulator;
+  /// PRACH detector.
+  std::unique_ptr<srsran::prach_detector> detector;
+  /// Demodulated PRACH occasion, one port for each receive antenna.
+  std::unique_ptr<srsran::prach_buffer> buffer;
+  /// Fading channel.
+  srsran_matlab::fading_channel channel;
+  /// Carrier frequency offset and AWGN.
+  srsran_matlab::channel_impairments impairments;
+  /// Transmitted samples, i.e., the delayed waveform.
+  std::vector<srsran::cf_t> tx_samples;
+  /// Received samples, one antenna after the other.
+  std::vector<srsran::cf_t> rx_samples;
+};
+
+/// \brief Implements the PRACH performance simulation engine following the srsran_mex_dispatcher template.
+///
+/// The occasions of each SNR point are simulated by a pool of workers. The outcomes are accumulated in occasion order
+/// and, when the quick simulation stops a point early, only the occasions up to the one exceeding the maximum number
+/// of failures are counted. The results are thus independent of the number of workers.
+class MexFunction : public srsran_mex_dispatcher
+{
+public:
+  /// \brief Constructor.
+  ///
+  /// Stores the string identifier&ndash;method pairs that form the public interface of the PRACH performance engine
+  /// MEX object.
+  MexFunction()
+  {
+    create_callback("new", [this](ArgumentList out, ArgumentList in) { this->method_new(out, in); });
+    create_callback("step", [this](ArgumentList out, ArgumentList in) { this->method_step(out, in); });
+  }
+
+private:
+  /// \brief Sets the number of workers.
+  ///
+  /// The method takes two inputs.
+  ///   - The string <tt>"new"</tt>.
+  ///   - The number of worker threads (set it to zero to use as many workers as hardware threads).
+  ///
+  /// The method has no output.
+  void method_new(ArgumentList outputs, ArgumentList inputs);
+
+  /// Checks that outputs/inputs arguments match the requirements of method_step().
+  void check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs);
+
+  /// Reads the link and channel configuration from a MATLAB structure (see method_step()).
+  prach_perf_config read_config(const matlab::data::Struct& in_cfg);
+
+  /// \brief Simulates the PRACH link for a list of SNR values.
+  ///
+  /// The method takes eight inputs.
+  ///   - The string <tt>"step"</tt>.
+  ///   - A one-dimensional structure that describes the link. Besides the fields of the demodulator and detector
+  ///     configurations of the srsPRACHDemodulator MEX (only the first time- and frequency-domain occasions are
+  ///     processed, the number of occasions is ignored), the fields are
+  ///      - \c Nfft, DFT size of the carrier OFDM modulator;
+  ///      - \c PreambleIndex, index of the transmitted preamble;
+  ///      - \c NRxPorts, number of receive antennas;
+  ///      - \c TimingOffsets, timing offsets in microseconds, used cyclically by consecutive occasions;
+  ///      - \c TimeErrorTolerance, time error tolerance in microseconds;
+  ///      - \c DelayProfile, delay profile (<tt>"AWGN"</tt> or any of the TDL profiles of srsFadingChannel);
+  ///      - \c DelaySpread, delay spread in seconds (TDL-A, TDL-B and TDL-C profiles only);
+  ///      - \c MaximumDopplerShift, maximum Doppler shift in hertz (fading channel only);
+  ///      - \c FrequencyOffset, carrier frequency offset in hertz;
+  ///      - \c DetectionTest, \c true for detection tests and \c false for false alarm tests;
+  ///      - \c Seed, seed of all the random processes.
+  ///   - The transmitted waveform, a column array of complex floats starting at the beginning of the PRACH slot, as
+  ///     returned by srsPRACHgenerator.
+  ///   - An array of SNR values in dB. The SNR is the ratio between the energy per resource element and the noise
+  ///     energy per resource element at each receive antenna, as in PRACHPERF.
+  ///   - The number of PRACH occasions to simulate for each SNR value.
+  ///   - The maximum number of failures for each SNR value (set it to zero to simulate all occasions). Failures are
+  ///     missed detections in detection tests and false detections in false alarm tests, counted with the first
+  ///     detection threshold. The simulation of an SNR value stops as soon as the failures exceed the maximum.
+  ///   - An array of detection thresholds, normalized to the srsRAN detection threshold (that is, values not lower
+  ///     than one, with one corresponding to the srsRAN default).
+  ///   - An array with the increasing edges of the timing error histogram bins, in microseconds (possibly empty).
+  ///     As in the MATLAB function \c histcounts, each bin includes its left edge and the last bin also includes its
+  ///     right edge.
+  ///
+  /// The method has one single output.
+  ///   - A structure array with one entry for each SNR value. The fields are
+  ///      - \c NumOccasions, number of simulated PRACH occasions;
+  ///      - \c Detected, number of detected occasions, for each threshold (see prach_perf_counters::detected);
+  ///      - \c DetectedPerfect, number of detected occasions with a timing error within the tolerance, for each
+  ///        threshold;
+  ///      - \c TimingErrorSum, sum of the timing errors of the detected occasions, for each threshold;
+  ///      - \c TimingErrorSqSum, sum of the squared timing errors of the detected occasions, for each threshold;
+  ///      - \c TimingErrorHistogram, histogram of the timing errors of the detected occasions (bins, thresholds).
+  void method_step(ArgumentList outputs, ArgumentList inputs);
+
+  /// Number of workers.
+  unsigned nof_workers = srsran_matlab::default_nof_workers();
+};
+
+inline prach_link_factories create_prach_link_factories(srsran::sampling_rate srate)
+{
+  using namespace srsran;
+
+  std::shared_ptr<dft_processor_factory>   demod_dft_factory = create_dft_processor_factory_fftw_slow();
+  std::shared_ptr<dft_processor_factory>   det_dft_factory   = create_dft_processor_factory_generic();
+  std::shared_ptr<prach_generator_factory> generator_factory = create_prach_generator_factory_sw();
+
+  prach_link_factories factories;
+  if (demod_dft_factory) {
+    factories.demodulator = create_ofdm_prach_demodulator_factory_sw(demod_dft_factory, srate);
+  }
+  factories.detector = create_prach_detector_factory_sw(det_dft_factory, generator_factory);
+  return factories;
+}
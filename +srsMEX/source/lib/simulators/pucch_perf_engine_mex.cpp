@@ -0,0 +1,547 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief PUCCH performance simulation engine MEX definition.
+
+#include "pucch_perf_engine_mex.h"
+#include "srsran_matlab/channel/matlab_to_fading_channel.h"
+#include "srsran_matlab/simulators/matlab_to_stopping_criterion.h"
+#include "srsran_matlab/support/matlab_to_srs.h"
+#include "srsran_matlab/support/pucch_processor_helpers.h"
+#include "srsran_matlab/support/random_stream.h"
+#include "srsran/phy/support/resource_grid_reader.h"
+#include "srsran/phy/support/resource_grid_writer.h"
+#include "srsran/srsvec/zero.h"
+#include "srsran/support/srsran_assert.h"
+#include <algorithm>
+#include <cmath>
+
+using matlab::mex::ArgumentList;
+using namespace matlab::data;
+using namespace srsran;
+using namespace srsran_matlab;
+
+namespace {
+
+/// Runs the PUCCH processor for a Format 1 transmission, which is processed as a batch of one single entry.
+pucch_uci_message process_pucch(pucch_processor&                              processor,
+                                const resource_grid_reader&                   grid,
+                                const pucch_processor::format1_configuration& config)
+{
+  pucch_processor::format1_batch_configuration batch_config(config);
+  const auto&                                  batch_results = processor.process(grid, batch_config);
+  return batch_results.get(config.initial_cyclic_shift, config.time_domain_occ).message;
+}
+
+/// Runs the PUCCH processor for a transmission of any format other than Format 1.
+template <typename Config>
+pucch_uci_message process_pucch(pucch_processor& processor, const resource_grid_reader& grid, const Config& config)
+{
+  return processor.process(grid, config).message;
+}
+
+/// Counts the bits of \c lhs that differ from the bits of \c rhs.
+unsigned count_bit_errors(span<const uint8_t> lhs, span<const uint8_t> rhs)
+{
+  unsigned nof_errors = 0;
+  for (unsigned i_bit = 0, nof_bits = lhs.size(); i_bit != nof_bits; ++i_bit) {
+    nof_errors += (lhs[i_bit] != rhs[i_bit]) ? 1 : 0;
+  }
+  return nof_errors;
+}
+
+/// Returns the number of errors that stop a quick simulation, according to the PUCCH format and the test type.
+unsigned get_nof_stop_errors(const pucch_perf_counters& counters, const pucch_perf_config& config)
+{
+  if (!config.is_detection_test) {
+    return (config.format == 1) ? counters.false_acks : counters.false_detections;
+  }
+  if (config.format == 0) {
+    return (config.nof_harq_ack != 0) ? counters.ack_errors : counters.sr_errors;
+  }
+  if (config.format == 1) {
+    return std::min(counters.missed_acks, counters.nack_to_acks);
+  }
+  return counters.block_errors;
+}
+
+/// \brief Returns \c true if the error rates counted by get_nof_stop_errors() meet the stopping criterion.
+///
+/// Error rates are computed per bit for Format 0 and per occasion otherwise. Format 1 detection tests stop when both
+/// the missed ACK and the NACK-to-ACK rates meet the criterion.
+bool is_stop_criterion_met(const pucch_perf_counters& counters,
+                           const pucch_perf_config&   config,
+                           const stopping_criterion&  criterion)
+{
+  if (!config.is_detection_test) {
+    unsigned nof_errors = (config.format == 1) ? counters.false_acks : counters.false_detections;
+    return criterion.is_met(nof_errors, counters.nof_occasions);
+  }
+  if (config.format == 0) {
+    if (config.nof_harq_ack != 0) {
+      return criterion.is_met(counters.ack_errors, counters.nof_occasions * config.nof_harq_ack);
+    }
+    return criterion.is_met(counters.sr_errors, counters.nof_occasions * config.nof_sr);
+  }
+  if (config.format == 1) {
+    return criterion.is_met(counters.missed_acks, counters.nof_acks) &&
+           criterion.is_met(counters.nack_to_acks, counters.nof_nacks);
+  }
+  return criterion.is_met(counters.block_errors, counters.nof_occasions);
+}
+
+/// Returns the configuration of the channel impairments of a PUCCH link (AWGN only).
+channel_impairments_config get_impairments_config(const pucch_perf_config& config)
+{
+  channel_impairments_config impairments_config;
+  impairments_config.nof_ports     = config.nof_rx_ports;
+  impairments_config.sampling_rate = config.fading.sampling_rate;
+  impairments_config.cfo           = 0;
+  impairments_config.timing_offset = 0;
+  return impairments_config;
+}
+
+} // namespace
+
+pucch_perf_worker::pucch_perf_worker(const pucch_perf_config&    config_,
+                                     const pucch_perf_codebook&  codebook_,
+                                     const pucch_link_factories& factories) :
+  config(config_),
+  codebook(codebook_),
+  processor(factories.processor->create()),
+  tx_grid(create_resource_grid(config.nof_grid_rb * NRE, MAX_NSYMB_PER_SLOT, 1)),
+  rx_grid(create_resource_grid(config.nof_grid_rb * NRE, MAX_NSYMB_PER_SLOT, config.nof_rx_ports)),
+  channel(config.fading),
+  impairments(get_impairments_config(config))
+{
+  ofdm_processor_config ofdm_config;
+  ofdm_config.nof_subcarriers = config.nof_grid_rb * NRE;
+  ofdm_config.dft_size        = config.dft_size;
+  ofdm_config.scs             = config.scs;
+  ofdm_config.cp              = config.cp;
+  ofdm_config.cp_fraction     = 0.5;
+  ofdm                        = std::make_unique<ofdm_processor>(ofdm_config, *factories.dft);
+
+  // The first slot of a subframe is the longest one.
+  unsigned max_slot_size = ofdm->get_slot_size(0);
+  tx_samples.resize(max_slot_size);
+  rx_samples.resize(config.nof_rx_ports * max_slot_size);
+}
+
+bool pucch_perf_worker::is_valid() const
+{
+  return processor && ofdm && ofdm->is_valid() && tx_grid && rx_grid;
+}
+
+pucch_uci_message pucch_perf_worker::process(unsigned i_slot)
+{
+  return std::visit(
+      [this, i_slot](auto& processor_config) {
+        processor_config.slot = slot_point(to_numerology_value(config.scs), i_slot);
+        return process_pucch(*processor, rx_grid->get_reader(), processor_config);
+      },
+      config.processor);
+}
+
+void pucch_perf_worker::update_counters(pucch_perf_counters&     counters,
+                                        span<const uint8_t>      payload,
+                                        const pucch_uci_message& message) const
+{
+  bool is_valid = (message.get_status() == uci_status::valid);
+
+  span<const uint8_t> tx_harq_ack = payload.first(config.nof_harq_ack);
+  span<const uint8_t> tx_sr       = payload.subspan(config.nof_harq_ack, config.nof_sr);
+  unsigned            nof_tx_acks = std::count(tx_harq_ack.begin(), tx_harq_ack.end(), 1);
+  ++counters.nof_occasions;
+  counters.nof_acks += nof_tx_acks;
+  counters.nof_nacks += tx_harq_ack.size() - nof_tx_acks;
+
+  // False alarm tests: nothing was transmitted.
+  if (!config.is_detection_test) {
+    if (is_valid) {
+      ++counters.false_detections;
+      span<const uint8_t> rx_harq_ack = message.get_harq_ack_bits();
+      counters.false_acks += std::count(rx_harq_ack.begin(), rx_harq_ack.end(), 1);
+    }
+    return;
+  }
+
+  if (!is_valid) {
+    // Nothing has been recovered.
+    ++counters.missed_detections;
+    ++counters.block_errors;
+    counters.ack_errors += tx_harq_ack.size();
+    counters.sr_errors += tx_sr.size();
+    counters.missed_acks += nof_tx_acks;
+    return;
+  }
+
+  span<const uint8_t> rx_harq_ack = message.get_harq_ack_bits();
+  span<const uint8_t> rx_sr       = message.get_sr_bits();
+  span<const uint8_t> rx_csi1     = message.get_csi_part1_bits();
+  span<const uint8_t> rx_csi2     = message.get_csi_part2_bits();
+  srsran_assert((rx_harq_ack.size() == config.nof_harq_ack) && (rx_sr.size() == config.nof_sr) &&
+                    (rx_csi1.size() == config.nof_csi_part1) && (rx_csi2.size() == config.nof_csi_part2),
+                "The detected UCI message does not have the expected field sizes.");
+
+  for (unsigned i_bit = 0, nof_bits = tx_harq_ack.size(); i_bit != nof_bits; ++i_bit) {
+    counters.missed_acks += ((tx_harq_ack[i_bit] == 1) && (rx_harq_ack[i_bit] == 0)) ? 1 : 0;
+    counters.nack_to_acks += ((tx_harq_ack[i_bit] == 0) && (rx_harq_ack[i_bit] == 1)) ? 1 : 0;
+  }
+  unsigned ack_errors = count_bit_errors(tx_harq_ack, rx_harq_ack);
+  unsigned sr_errors  = count_bit_errors(tx_sr, rx_sr);
+  unsigned csi_errors = count_bit_errors(payload.subspan(config.nof_harq_ack + config.nof_sr, config.nof_csi_part1),
+                                         rx_csi1) +
+                        count_bit_errors(payload.last(config.nof_csi_part2), rx_csi2);
+  counters.ack_errors += ack_errors;
+  counters.sr_errors += sr_errors;
+  counters.block_errors += (ack_errors + sr_errors + csi_errors != 0) ? 1 : 0;
+}
+
+pucch_perf_counters pucch_perf_worker::run_frame(unsigned i_snr, unsigned i_frame, float noise_var)
+{
+  pucch_perf_counters counters;
+
+  // Every frame starts afresh: new payload selection and noise.
+  random_stream payload_generator(random_stream_id{config.seed, i_snr, i_frame, 0, random_purpose::payload});
+  unsigned      nof_codewords = codebook.get_nof_codewords();
+  impairments.reset(random_stream_id{config.seed, i_snr, i_frame, 0, random_purpose::noise});
+
+  for (unsigned i_slot = 0; i_slot != config.nof_slots_per_frame; ++i_slot) {
+    // The codeword is drawn from the stream words directly: the output of the standard distributions depends on the
+    // implementation of the standard library.
+    unsigned   i_codeword = static_cast<unsigned>(payload_generator.uniform() * nof_codewords);
+    unsigned   slot_size  = ofdm->get_slot_size(i_slot);
+    span<cf_t> rx_slot    = span<cf_t>(rx_samples).first(config.nof_rx_ports * slot_size);
+
+    if (config.is_detection_test) {
+      // Transmitter: map the codebook grid and modulate it.
+      resource_grid_writer& writer = tx_grid->get_writer();
+      for (unsigned i_symbol = 0, nof_symbols = get_nsymb_per_slot(config.cp); i_symbol != nof_symbols; ++i_symbol) {
+        writer.put(0, i_symbol, 0, codebook.get_symbol(i_slot, i_codeword, i_symbol));
+      }
+      span<cf_t> tx_slot = span<cf_t>(tx_samples).first(slot_size);
+      ofdm->modulate(tx_slot, tx_grid->get_reader(), 0, i_slot);
+
+      // The PUCCH receiver is memoryless: a new fading realization for each slot, as in PUCCHPERF.
+      channel.reset(random_stream_id{config.seed, i_snr, i_frame, i_slot, random_purpose::fading});
+      channel.run(rx_slot, tx_slot);
+    } else {
+      srsvec::zero(rx_slot);
+    }
+
+    for (unsigned i_port = 0; i_port != config.nof_rx_ports; ++i_port) {
+      impairments.run(rx_slot.subspan(i_port * slot_size, slot_size), i_port, noise_var);
+    }
+    impairments.advance(slot_size);
+
+    // Receiver.
+    for (unsigned i_port = 0; i_port != config.nof_rx_ports; ++i_port) {
+      ofdm->demodulate(rx_grid->get_writer(), rx_slot.subspan(i_port * slot_size, slot_size), i_port, i_slot);
+    }
+
+    update_counters(counters, codebook.get_payload(i_codeword), process(i_slot));
+  }
+
+  return counters;
+}
+
+void MexFunction::method_new(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 2;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::DOUBLE) || (inputs[1].getNumberOfElements() != 1)) {
+    mex_abort("Input 'nofWorkers' should be a scalar double.");
+  }
+
+  if (!outputs.empty()) {
+    mex_abort("Wrong number of outputs: expected 0, provided {}.", outputs.size());
+  }
+
+  unsigned nof_workers_in = static_cast<unsigned>(static_cast<TypedArray<double>>(inputs[1])[0]);
+  nof_workers             = (nof_workers_in == 0) ? default_nof_workers() : nof_workers_in;
+}
+
+void MexFunction::check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 8;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::STRUCT) || (inputs[1].getNumberOfElements() != 1)) {
+    mex_abort("Input 'config' should be a scalar structure.");
+  }
+
+  if (inputs[2].getType() != ArrayType::COMPLEX_SINGLE) {
+    mex_abort("Input 'txGrids' should be an array of complex floats.");
+  }
+
+  if (inputs[3].getType() != ArrayType::INT8) {
+    mex_abort("Input 'payloads' should be an array of int8.");
+  }
+
+  if ((inputs[4].getType() != ArrayType::DOUBLE) || (inputs[4].getNumberOfElements() == 0)) {
+    mex_abort("Input 'SNRIn' should be a nonempty array of doubles.");
+  }
+
+  if ((inputs[5].getType() != ArrayType::DOUBLE) || (inputs[5].getNumberOfElements() != 1)) {
+    mex_abort("Input 'nFrames' should be a scalar double.");
+  }
+
+  if ((inputs[6].getType() != ArrayType::DOUBLE) || (inputs[6].getNumberOfElements() != 1)) {
+    mex_abort("Input 'maxErrors' should be a scalar double.");
+  }
+
+  if ((inputs[7].getType() != ArrayType::STRUCT) || (inputs[7].getNumberOfElements() != 1)) {
+    mex_abort("Input 'stopping' should be a scalar structure.");
+  }
+
+  constexpr unsigned NOF_OUTPUTS = 1;
+  if (outputs.size() != NOF_OUTPUTS) {
+    mex_abort("Wrong number of outputs: expected {}, provided {}.", NOF_OUTPUTS, outputs.size());
+  }
+}
+
+pucch_perf_config MexFunction::read_config(const Struct& in_cfg)
+{
+  pucch_perf_config config;
+
+  // Carrier.
+  config.nof_grid_rb         = in_cfg["NSizeGrid"][0];
+  config.scs                 = matlab_to_srs_subcarrier_spacing(static_cast<unsigned>(in_cfg["SubcarrierSpacing"][0]));
+  const CharArray in_cp      = in_cfg["CP"];
+  config.cp                  = matlab_to_srs_cyclic_prefix(in_cp.toAscii());
+  config.dft_size            = in_cfg["Nfft"][0];
+  config.nof_slots_per_frame = in_cfg["SlotsPerFrame"][0];
+  unsigned nof_subcarriers   = config.nof_grid_rb * NRE;
+  if ((config.nof_grid_rb == 0) || (config.nof_grid_rb > MAX_RB) || (nof_subcarriers > config.dft_size)) {
+    mex_abort("Invalid grid of {} RBs with a DFT size of {}.", config.nof_grid_rb, config.dft_size);
+  }
+
+  // PUCCH, with the same fields as the srsPUCCHProcessor MEX.
+  config.format       = in_cfg["Format"][0];
+  config.nof_rx_ports = in_cfg["NRxPorts"][0];
+  if ((config.nof_rx_ports == 0) || (config.nof_rx_ports > 4)) {
+    mex_abort("Invalid number of receive antennas {}.", config.nof_rx_ports);
+  }
+  config.nof_harq_ack  = in_cfg["NumHARQAck"][0];
+  config.nof_sr        = (config.format == 1) ? 0 : static_cast<unsigned>(in_cfg["NumSR"][0]);
+  config.nof_csi_part1 = (config.format < 2) ? 0 : static_cast<unsigned>(in_cfg["NumCSIPart1"][0]);
+  config.nof_csi_part2 = (config.format < 2) ? 0 : static_cast<unsigned>(in_cfg["NumCSIPart2"][0]);
+
+  std::unique_ptr<pucch_pdu_validator> validator = create_pucch_link_factories(1).processor->create_validator();
+  if (!validator) {
+    mex_abort("Cannot create srsRAN PUCCH PDU validator.");
+  }
+  error_type<std::string> validation = {};
+  switch (config.format) {
+    case 0:
+      if (config.nof_sr > 1) {
+        mex_abort("For PUCCH Format 0 the number of SR bits is at most one, given {}.", config.nof_sr);
+      }
+      config.processor = populate_pucch_f0_configuration(in_cfg);
+      validation       = validator->is_valid(std::get<pucch_processor::format0_configuration>(config.processor));
+      break;
+    case 1:
+      config.processor = populate_pucch_f1_configuration(in_cfg);
+      validation       = validator->is_valid(std::get<pucch_processor::format1_configuration>(config.processor));
+      break;
+    case 2:
+      config.processor = populate_pucch_f2_configuration(in_cfg);
+      validation       = validator->is_valid(std::get<pucch_processor::format2_configuration>(config.processor));
+      break;
+    case 3:
+      config.processor = populate_pucch_f3_configuration(in_cfg);
+      validation       = validator->is_valid(std::get<pucch_processor::format3_configuration>(config.processor));
+      break;
+    case 4:
+      config.processor = populate_pucch_f4_configuration(in_cfg);
+      validation       = validator->is_valid(std::get<pucch_processor::format4_configuration>(config.processor));
+      break;
+    default:
+      mex_abort("Unsupported or unkown PUCCH Format {}", config.format);
+      break;
+  }
+  if (!validation.has_value()) {
+    mex_abort("The provided PUCCH Format {} configuration is invalid: {}.", config.format, validation.error());
+  }
+
+  // Channel.
+  matlab_to_fading_profile(config.fading, in_cfg, [this](const std::string& msg) { mex_abort(msg); });
+  config.fading.sampling_rate =
+      static_cast<double>(config.dft_size) * 15e3 * static_cast<double>(1U << to_numerology_value(config.scs));
+  config.fading.nof_tx_ports      = 1;
+  config.fading.nof_rx_ports      = config.nof_rx_ports;
+  config.fading.normalize_outputs = true;
+
+  const TypedArray<bool> in_detection_test = in_cfg["DetectionTest"];
+  config.is_detection_test                 = in_detection_test[0];
+  config.seed                              = static_cast<uint64_t>(in_cfg["Seed"][0]);
+
+  return config;
+}
+
+pucch_perf_codebook
+MexFunction::read_codebook(const pucch_perf_config& config, const Array& in_grids, const Array& in_payloads)
+{
+  unsigned        nof_subcarriers = config.nof_grid_rb * NRE;
+  unsigned        nof_symbols     = get_nsymb_per_slot(config.cp);
+  ArrayDimensions grid_dims       = in_grids.getDimensions();
+  ArrayDimensions payload_dims    = in_payloads.getDimensions();
+
+  // Trailing singleton dimensions are dropped by MATLAB.
+  grid_dims.resize(4, 1);
+  unsigned nof_codewords = grid_dims[2];
+  if ((grid_dims[0] != nof_subcarriers) || (grid_dims[1] != nof_symbols) || (nof_codewords == 0) ||
+      (grid_dims[3] != config.nof_slots_per_frame)) {
+    mex_abort("Input 'txGrids' should be a {}x{}xNx{} array, provided {}x{}x{}x{}.",
+              nof_subcarriers,
+              nof_symbols,
+              config.nof_slots_per_frame,
+              grid_dims[0],
+              grid_dims[1],
+              grid_dims[2],
+              grid_dims[3]);
+  }
+
+  unsigned nof_bits = config.nof_harq_ack + config.nof_sr + config.nof_csi_part1 + config.nof_csi_part2;
+  if ((payload_dims.size() != 2) || (payload_dims[0] != nof_bits) || (payload_dims[1] != nof_codewords)) {
+    mex_abort("Input 'payloads' should be a {}x{} array.", nof_bits, nof_codewords);
+  }
+
+  // MATLAB arrays are column-major: the subcarrier index runs the fastest, as in the codebook.
+  const TypedArray<std::complex<float>> in_grid_array = in_grids;
+  std::vector<cf_t>                     grids(in_grid_array.cbegin(), in_grid_array.cend());
+
+  const TypedArray<int8_t> in_payload_array = in_payloads;
+  std::vector<uint8_t>     payloads;
+  payloads.reserve(in_payload_array.getNumberOfElements());
+  for (int8_t bit : in_payload_array) {
+    if ((bit != 0) && (bit != 1)) {
+      mex_abort("Input 'payloads' should only contain binary values, provided {}.", bit);
+    }
+    payloads.push_back(static_cast<uint8_t>(bit));
+  }
+
+  return pucch_perf_codebook(std::move(grids), std::move(payloads), nof_subcarriers, nof_symbols, nof_codewords);
+}
+
+void MexFunction::method_step(ArgumentList outputs, ArgumentList inputs)
+{
+  check_step_outputs_inputs(outputs, inputs);
+
+  const StructArray         in_struct_array = inputs[1];
+  const pucch_perf_config   config          = read_config(in_struct_array[0]);
+  const pucch_perf_codebook codebook        = read_codebook(config, inputs[2], inputs[3]);
+
+  const TypedArray<double> in_snr            = inputs[4];
+  std::vector<double>      snr_values        = std::vector<double>(in_snr.cbegin(), in_snr.cend());
+  unsigned                 nof_snr           = snr_values.size();
+  unsigned                 nof_frames        = static_cast<unsigned>(static_cast<TypedArray<double>>(inputs[5])[0]);
+  unsigned                 max_errors        = static_cast<unsigned>(static_cast<TypedArray<double>>(inputs[6])[0]);
+  const StructArray        in_stopping_array = inputs[7];
+  const stopping_criterion criterion(
+      matlab_to_stopping_criterion(in_stopping_array[0], [this](const std::string& msg) { mex_abort(msg); }));
+
+  // The workers are created serially, since DFT planning may not be thread-safe.
+  unsigned             nof_active_workers = std::max(1U, std::min(nof_workers, nof_snr * nof_frames));
+  pucch_link_factories factories          = create_pucch_link_factories(config.nof_rx_ports);
+  std::vector<std::unique_ptr<pucch_perf_worker>> workers;
+  for (unsigned i_worker = 0; i_worker != nof_active_workers; ++i_worker) {
+    workers.emplace_back(std::make_unique<pucch_perf_worker>(config, codebook, factories));
+    if (!workers.back()->is_valid()) {
+      mex_abort("Cannot create the PUCCH link components.");
+    }
+  }
+
+  // Noise variance of the time-domain samples, as in PUCCHPERF.
+  std::vector<float> noise_vars(nof_snr);
+  std::transform(snr_values.cbegin(), snr_values.cend(), noise_vars.begin(), [&config](double snr_dB) {
+    return static_cast<float>(1.0 / (config.nof_rx_ports * config.dft_size * std::pow(10.0, snr_dB / 10.0)));
+  });
+
+  // Without an early stop, all frames of all SNR points are simulated at once. Otherwise, frames are simulated in
+  // batches of one frame per worker, shared among the SNR points that are not stopped yet, so that at most one batch is
+  // wasted once all the points are stopped.
+  bool     early_stop = (max_errors != 0) || criterion.is_enabled();
+  unsigned batch_size = early_stop ? nof_active_workers : std::max(1U, nof_snr * nof_frames);
+
+  std::vector<pucch_perf_counters> results(nof_snr);
+  std::vector<pucch_perf_counters> frame_counters(batch_size);
+  trial_scheduler                  scheduler(nof_snr, nof_frames, batch_size);
+  while (!scheduler.is_done()) {
+    const std::vector<trial_scheduler::trial>& batch = scheduler.next_batch();
+    try {
+      parallel_for(batch.size(), nof_active_workers, [&](unsigned i_trial, unsigned i_worker) {
+        const trial_scheduler::trial& trial = batch[i_trial];
+        frame_counters[i_trial] = workers[i_worker]->run_frame(trial.i_point, trial.i_item, noise_vars[trial.i_point]);
+      });
+    } catch (const std::exception& e) {
+      mex_abort("Cannot simulate the PUCCH link: {}", e.what());
+    }
+
+    // Accumulate in frame order, up to the frame reaching the target number of errors or the target accuracy of the
+    // error rate.
+    for (unsigned i_trial = 0, nof_trials = batch.size(); i_trial != nof_trials; ++i_trial) {
+      unsigned             i_snr  = batch[i_trial].i_point;
+      pucch_perf_counters& result = results[i_snr];
+      if (scheduler.is_stopped(i_snr)) {
+        continue;
+      }
+      result += frame_counters[i_trial];
+      if (((max_errors != 0) && (get_nof_stop_errors(result, config) >= max_errors)) ||
+          is_stop_criterion_met(result, config, criterion)) {
+        scheduler.stop(i_snr);
+      }
+    }
+  }
+
+  StructArray out = factory.createStructArray({snr_values.size(), 1},
+                                              {"NumOccasions",
+                                               "NumACKs",
+                                               "NumNACKs",
+                                               "MissedDetections",
+                                               "ACKErrors",
+                                               "SRErrors",
+                                               "MissedACKs",
+                                               "NACK2ACKs",
+                                               "BlockErrors",
+                                               "FalseDetections",
+                                               "FalseACKs"});
+  for (unsigned i_snr = 0; i_snr != nof_snr; ++i_snr) {
+    const pucch_perf_counters& result = results[i_snr];
+    out[i_snr]["NumOccasions"]        = factory.createScalar(static_cast<double>(result.nof_occasions));
+    out[i_snr]["NumACKs"]             = factory.createScalar(static_cast<double>(result.nof_acks));
+    out[i_snr]["NumNACKs"]            = factory.createScalar(static_cast<double>(result.nof_nacks));
+    out[i_snr]["MissedDetections"]    = factory.createScalar(static_cast<double>(result.missed_detections));
+    out[i_snr]["ACKErrors"]           = factory.createScalar(static_cast<double>(result.ack_errors));
+    out[i_snr]["SRErrors"]            = factory.createScalar(static_cast<double>(result.sr_errors));
+    out[i_snr]["MissedACKs"]          = factory.createScalar(static_cast<double>(result.missed_acks));
+    out[i_snr]["NACK2ACKs"]           = factory.createScalar(static_cast<double>(result.nack_to_acks));
+    out[i_snr]["BlockErrors"]         = factory.createScalar(static_cast<double>(result.block_errors));
+    out[i_snr]["FalseDetections"]     = factory.createScalar(static_cast<double>(result.false_detections));
+    out[i_snr]["FalseACKs"]           = factory.createScalar(static_cast<double>(result.false_acks));
+  }
+  outputs[0] = out;
+}
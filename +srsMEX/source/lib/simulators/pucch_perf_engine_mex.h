@@ -0,0 +1,413 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief PUCCH performance simulation engine MEX declaration.
+///
+/// The engine runs the PUCCH link of the PUCCHPERF simulator natively, for all PUCCH formats: OFDM modulation, fading
+/// channel and AWGN, OFDM demodulation and PUCCH processing (estimation, detection or demodulation and UCI decoding).
+/// srsRAN does not provide PUCCH modulators, so the transmitted resource grids are generated by MATLAB once and for
+/// all and passed to the engine as a codebook: a set of UCI payloads together with the resource grid that carries
+/// each of them in each slot of a frame. Every simulated PUCCH transmission picks one of the payloads at random.
+
+#pragma once
+
+#include "srsran_matlab/channel/channel_impairments.h"
+#include "srsran_matlab/channel/fading_channel.h"
+#include "srsran_matlab/simulators/ofdm_processor.h"
+#include "srsran_matlab/simulators/trial_scheduler.h"
+#include "srsran_matlab/srsran_mex_dispatcher.h"
+#include "srsran_matlab/support/low_papr_sequence_collection_cache.h"
+#include "srsran_matlab/support/parallel_for.h"
+#include "srsran/phy/generic_functions/generic_functions_factories.h"
+#include "srsran/phy/support/resource_grid.h"
+#include "srsran/phy/support/support_factories.h"
+#include "srsran/phy/upper/channel_coding/channel_coding_factories.h"
+#include "srsran/phy/upper/channel_modulation/channel_modulation_factories.h"
+#include "srsran/phy/upper/channel_processors/pucch/factories.h"
+#include "srsran/phy/upper/channel_processors/pucch/pucch_processor.h"
+#include "srsran/phy/upper/channel_processors/uci/factories.h"
+#include "srsran/phy/upper/equalization/equalization_factories.h"
+#include "srsran/phy/upper/sequence_generators/sequence_generator_factories.h"
+#include "srsran/ran/cyclic_prefix.h"
+#include "srsran/ran/pucch/pucch_constants.h"
+#include "srsran/ran/subcarrier_spacing.h"
+#include <memory>
+#include <variant>
+#include <vector>
+
+/// PUCCH processor configuration of any format. The slot is updated for each simulated transmission.
+using pucch_perf_processor_config = std::variant<srsran::pucch_processor::format0_configuration,
+                                                 srsran::pucch_processor::format1_configuration,
+                                                 srsran::pucch_processor::format2_configuration,
+                                                 srsran::pucch_processor::format3_configuration,
+                                                 srsran::pucch_processor::format4_configuration>;
+
+/// PUCCH link and channel configuration, as read from the MATLAB configuration structure.
+struct pucch_perf_config {
+  /// Number of resource blocks of the resource grid.
+  unsigned nof_grid_rb;
+  /// Subcarrier spacing.
+  srsran::subcarrier_spacing scs;
+  /// Cyclic prefix.
+  srsran::cyclic_prefix cp;
+  /// DFT size of the OFDM modulator and demodulator.
+  unsigned dft_size;
+  /// Number of slots in a frame.
+  unsigned nof_slots_per_frame;
+  /// PUCCH format.
+  unsigned format;
+  /// PUCCH processor configuration.
+  pucch_perf_processor_config processor;
+  /// Number of HARQ-ACK bits.
+  unsigned nof_harq_ack;
+  /// Number of SR bits.
+  unsigned nof_sr;
+  /// Number of CSI Part 1 bits.
+  unsigned nof_csi_part1;
+  /// Number of CSI Part 2 bits.
+  unsigned nof_csi_part2;
+  /// Number of receive antennas.
+  unsigned nof_rx_ports;
+  /// Fading channel configuration.
+  srsran_matlab::fading_channel_config fading;
+  /// Set to \c true for detection tests (PUCCH plus noise), \c false for false alarm tests (noise only).
+  bool is_detection_test;
+  /// Seed of all the random processes (payload selection, fading and noise).
+  uint64_t seed;
+};
+
+/// \brief Transmitted PUCCH codebook.
+///
+/// Collection of UCI payloads and of the transmit resource grids carrying them, one grid for each payload and slot of
+/// a frame.
+class pucch_perf_codebook
+{
+public:
+  /// \brief Creates a codebook.
+  ///
+  /// \param[in] grids_            Transmit resource grids, indexed as <tt>[slot][codeword][symbol][subcarrier]</tt>.
+  /// \param[in] payloads_         UCI payloads, one after the other, as unpacked bits.
+  /// \param[in] nof_subcarriers_  Number of subcarriers of the resource grids.
+  /// \param[in] nof_symbols_      Number of OFDM symbols of the resource grids.
+  /// \param[in] nof_codewords_    Number of codewords.
+  pucch_perf_codebook(std::vector<srsran::cf_t> grids_,
+                      std::vector<uint8_t>      payloads_,
+                      unsigned                  nof_subcarriers_,
+                      unsigned                  nof_symbols_,
+                      unsigned                  nof_codewords_) :
+    grids(std::move(grids_)),
+    payloads(std::move(payloads_)),
+    nof_subcarriers(nof_subcarriers_),
+    nof_symbols(nof_symbols_),
+    nof_codewords(nof_codewords_)
+  {
+  }
+
+  /// Returns the number of codewords.
+  unsigned get_nof_codewords() const { return nof_codewords; }
+
+  /// Returns the UCI payload of a codeword.
+  srsran::span<const uint8_t> get_payload(unsigned i_codeword) const
+  {
+    unsigned nof_bits = payloads.size() / nof_codewords;
+    return srsran::span<const uint8_t>(payloads).subspan(i_codeword * nof_bits, nof_bits);
+  }
+
+  /// Returns one OFDM symbol of the resource grid transmitting a codeword in a slot.
+  srsran::span<const srsran::cf_t> get_symbol(unsigned i_slot, unsigned i_codeword, unsigned i_symbol) const
+  {
+    unsigned offset = ((i_slot * nof_codewords + i_codeword) * nof_symbols + i_symbol) * nof_subcarriers;
+    return srsran::span<const srsran::cf_t>(grids).subspan(offset, nof_subcarriers);
+  }
+
+private:
+  /// Transmit resource grids.
+  std::vector<srsran::cf_t> grids;
+  /// UCI payloads.
+  std::vector<uint8_t> payloads;
+  /// Number of subcarriers of the resource grids.
+  unsigned nof_subcarriers;
+  /// Number of OFDM symbols of the resource grids.
+  unsigned nof_symbols;
+  /// Number of codewords.
+  unsigned nof_codewords;
+};
+
+/// Simulation counters, from which PUCCHPERF derives the metrics of each PUCCH format.
+struct pucch_perf_counters {
+  /// Number of simulated PUCCH occasions.
+  unsigned nof_occasions = 0;
+  /// Number of HARQ-ACK bits set to one (ACK) in the selected payloads.
+  unsigned nof_acks = 0;
+  /// Number of HARQ-ACK bits set to zero (NACK) in the selected payloads.
+  unsigned nof_nacks = 0;
+  /// Number of transmissions that were not detected (detection tests only).
+  unsigned missed_detections = 0;
+  /// Number of erroneous HARQ-ACK bits, all of them when the transmission is not detected (detection tests only).
+  unsigned ack_errors = 0;
+  /// Number of erroneous SR bits, all of them when the transmission is not detected (detection tests only).
+  unsigned sr_errors = 0;
+  /// Number of ACKs received as NACKs or not detected (detection tests only).
+  unsigned missed_acks = 0;
+  /// Number of NACKs received as ACKs (detection tests only).
+  unsigned nack_to_acks = 0;
+  /// Number of UCI messages not detected or with any erroneous bit (detection tests only).
+  unsigned block_errors = 0;
+  /// Number of UCI messages detected when only noise is received (false alarm tests only).
+  unsigned false_detections = 0;
+  /// Number of ACKs detected when only noise is received (false alarm tests only).
+  unsigned false_acks = 0;
+
+  /// Accumulates the counters of another simulation.
+  pucch_perf_counters& operator+=(const pucch_perf_counters& other)
+  {
+    nof_occasions += other.nof_occasions;
+    nof_acks += other.nof_acks;
+    nof_nacks += other.nof_nacks;
+    missed_detections += other.missed_detections;
+    ack_errors += other.ack_errors;
+    sr_errors += other.sr_errors;
+    missed_acks += other.missed_acks;
+    nack_to_acks += other.nack_to_acks;
+    block_errors += other.block_errors;
+    false_detections += other.false_detections;
+    false_acks += other.false_acks;
+    return *this;
+  }
+};
+
+/// Collection of srsRAN factories for the components of a PUCCH link.
+struct pucch_link_factories {
+  /// DFT factory, for the OFDM modulator and demodulator.
+  std::shared_ptr<srsran::dft_processor_factory> dft;
+  /// PUCCH processor factory.
+  std::shared_ptr<srsran::pucch_processor_factory> processor;
+};
+
+/// \brief Factory method for the PUCCH link factories.
+///
+/// Creates and assemblies all the necessary factories (DFT, estimator, detector, demodulator, UCI decoder, ...) for a
+/// fully-functional PUCCH link with up to \c nof_rx_ports receive antennas. The PUCCH processor is assembled as in the
+/// srsPUCCHProcessor MEX.
+inline pucch_link_factories create_pucch_link_factories(unsigned nof_rx_ports);
+
+/// \brief Simulates a PUCCH link, one frame at a time.
+///
+/// Each worker owns a full channel and receiver. Each slot carries one PUCCH transmission and the fading channel is
+/// drawn anew in every slot, as in PUCCHPERF. All the random processes restart at every frame, with random streams
+/// identified by the SNR and frame indices. Therefore, the counters of a frame do not depend on which worker simulates
+/// it.
+class pucch_perf_worker
+{
+public:
+  /// Creates the worker components. The components are not valid if any of them could not be created.
+  pucch_perf_worker(const pucch_perf_config&    config_,
+                    const pucch_perf_codebook&  codebook_,
+                    const pucch_link_factories& factories);
+
+  /// Returns \c true if all the components were created successfully.
+  bool is_valid() const;
+
+  /// \brief Simulates one frame.
+  ///
+  /// \param[in] i_snr      SNR index, used to identify the random streams.
+  /// \param[in] i_frame    Frame index, used to identify the random streams.
+  /// \param[in] noise_var  Noise variance of the time-domain samples, at each receive port.
+  /// \return The counters of the simulated frame.
+  pucch_perf_counters run_frame(unsigned i_snr, unsigned i_frame, float noise_var);
+
+private:
+  /// Processes the received resource grid of a slot and returns the detected UCI message.
+  srsran::pucch_uci_message process(unsigned i_slot);
+
+  /// Updates the counters with the outcome of a PUCCH occasion.
+  void update_counters(pucch_perf_counters&             counters,
+                       srsran::span<const uint8_t>      payload,
+                       const srsran::pucch_uci_message& message) const;
+
+  /// Link configuration.
+  pucch_perf_config config;
+  /// Transmitted codebook, shared by all workers.
+  const pucch_perf_codebook& codebook;
+  /// PUCCH processor.
+  std::unique_ptr<srsran::pucch_processor> processor;
+  /// OFDM modulator and demodulator.
+  std::unique_ptr<srsran_matlab::ofdm_processor> ofdm;
+  /// Transmit resource grid, with one port.
+  std::unique_ptr<srsran::resource_grid> tx_grid;
+  /// Receive resource grid, one port for each receive antenna.
+  std::unique_ptr<srsran::resource_grid> rx_grid;
+  /// Fading channel.
+  srsran_matlab::fading_channel channel;
+  /// Additive white Gaussian noise.
+  srsran_matlab::channel_impairments impairments;
+  /// Transmitted samples.
+  std::vector<srsran::cf_t> tx_samples;
+  /// Received samples, one antenna after the other.
+  std::vector<srsran::cf_t> rx_samples;
+};
+
+/// \brief Implements the PUCCH performance simulation engine following the srsran_mex_dispatcher template.
+///
+/// The frames of all SNR points are simulated by a pool of workers, which move to the points that are still running as
+/// soon as the other points are stopped (see trial_scheduler). The counters of each point are accumulated in frame
+/// order and, when a point stops early, only the frames up to the one reaching the target number of errors or the
+/// target accuracy of the error rate are counted. The results are thus independent of the number of workers.
+class MexFunction : public srsran_mex_dispatcher
+{
+public:
+  /// \brief Constructor.
+  ///
+  /// Stores the string identifier&ndash;method pairs that form the public interface of the PUCCH performance engine
+  /// MEX object.
+  MexFunction()
+  {
+    create_callback("new", [this](ArgumentList out, ArgumentList in) { this->method_new(out, in); });
+    create_callback("step", [this](ArgumentList out, ArgumentList in) { this->method_step(out, in); });
+  }
+
+private:
+  /// \brief Sets the number of workers.
+  ///
+  /// The method takes two inputs.
+  ///   - The string <tt>"new"</tt>.
+  ///   - The number of worker threads (set it to zero to use as many workers as hardware threads).
+  ///
+  /// The method has no output.
+  void method_new(ArgumentList outputs, ArgumentList inputs);
+
+  /// Checks that outputs/inputs arguments match the requirements of method_step().
+  void check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs);
+
+  /// Reads the link and channel configuration from a MATLAB structure (see method_step()).
+  pucch_perf_config read_config(const matlab::data::Struct& in_cfg);
+
+  /// Reads the transmitted codebook from the MATLAB arrays (see method_step()).
+  pucch_perf_codebook read_codebook(const pucch_perf_config&  config,
+                                    const matlab::data::Array& in_grids,
+                                    const matlab::data::Array& in_payloads);
+
+  /// \brief Simulates the PUCCH link for a list of SNR values.
+  ///
+  /// The method takes eight inputs.
+  ///   - The string <tt>"step"</tt>.
+  ///   - A one-dimensional structure that describes the link. Besides the PUCCH configuration fields of the
+  ///     srsPUCCHProcessor MEX (the value of \c NSlot is ignored), the fields are
+  ///      - \c NSizeGrid, number of resource blocks of the resource grid;
+  ///      - \c Nfft, DFT size of the OFDM modulator;
+  ///      - \c SlotsPerFrame, number of slots in a frame;
+  ///      - \c DelayProfile, delay profile (<tt>"custom"</tt> or any of the TDL profiles of srsFadingChannel);
+  ///      - \c PathDelays, path delays in seconds (<tt>"custom"</tt> profile only);
+  ///      - \c AveragePathGains, average path gains in dB (<tt>"custom"</tt> profile only);
+  ///      - \c DelaySpread, delay spread in seconds (TDL-A, TDL-B and TDL-C profiles only);
+  ///      - \c MaximumDopplerShift, maximum Doppler shift in hertz;
+  ///      - \c DetectionTest, \c true for detection tests and \c false for false alarm tests;
+  ///      - \c Seed, seed of all the random processes.
+  ///   - The transmitted resource grids, a four-dimensional array of complex floats (subcarriers, OFDM symbols,
+  ///     codewords, slots of a frame).
+  ///   - The transmitted UCI payloads, a two-dimensional array of binary values (UCI bits, codewords), with the
+  ///     HARQ-ACK, SR, CSI Part 1 and CSI Part 2 bits one after the other.
+  ///   - An array of SNR values in dB. The SNR is the ratio between the energy per resource element of the PUCCH and
+  ///     the noise energy per resource element at each receive antenna, as in PUCCHPERF.
+  ///   - The number of frames to simulate for each SNR value.
+  ///   - The maximum number of errors for each SNR value (set it to zero for no limit). The counted errors
+  ///     depend on the PUCCH format and test type: HARQ-ACK bit errors (SR bit errors if there are no HARQ-ACK bits)
+  ///     for Format 0, the lowest of missed ACKs and NACK-to-ACK errors for Format 1 and block errors for the other
+  ///     formats, in detection tests; falsely detected ACKs for Format 1 and false detections for the other formats,
+  ///     in false alarm tests.
+  ///   - A one-dimensional structure that describes the confidence-based stopping criterion. A point stops at the frame
+  ///     where the width of the confidence interval of the rate of the errors above does not exceed the largest of the
+  ///     two targets (for Format 1 detection tests, both the missed ACK and the NACK-to-ACK rates must meet it). Rates
+  ///     are per bit for Format 0 and per occasion otherwise. The fields are
+  ///      - \c ConfidenceLevel, confidence level of the two-sided confidence interval, in (0, 1);
+  ///      - \c IntervalType, method for computing the confidence interval (<tt>"Wilson"</tt> or
+  ///        <tt>"Clopper-Pearson"</tt>);
+  ///      - \c TargetWidth, target absolute width of the confidence interval (zero for no absolute target);
+  ///      - \c TargetRelativeWidth, target width of the confidence interval relative to the error rate (zero for no
+  ///        relative target).
+  ///
+  /// All frames of an SNR point are simulated when neither the maximum number of errors nor the stopping criterion
+  /// stops it.
+  ///
+  /// The method has one single output.
+  ///   - A structure array with one entry for each SNR value. The fields are
+  ///      - \c NumOccasions, number of simulated PUCCH occasions;
+  ///      - \c NumACKs, number of transmitted HARQ-ACK bits set to one;
+  ///      - \c NumNACKs, number of transmitted HARQ-ACK bits set to zero;
+  ///      - \c MissedDetections, number of transmissions that were not detected;
+  ///      - \c ACKErrors, number of erroneous HARQ-ACK bits;
+  ///      - \c SRErrors, number of erroneous SR bits;
+  ///      - \c MissedACKs, number of ACKs received as NACKs or not detected;
+  ///      - \c NACK2ACKs, number of NACKs received as ACKs;
+  ///      - \c BlockErrors, number of UCI messages not detected or with any erroneous bit;
+  ///      - \c FalseDetections, number of UCI messages detected when only noise is received;
+  ///      - \c FalseACKs, number of ACKs detected when only noise is received.
+  void method_step(ArgumentList outputs, ArgumentList inputs);
+
+  /// Number of workers.
+  unsigned nof_workers = srsran_matlab::default_nof_workers();
+};
+
+inline pucch_link_factories create_pucch_link_factories(unsigned nof_rx_ports)
+{
+  using namespace srsran;
+
+  std::shared_ptr<pseudo_random_generator_factory>     prg_factory = create_pseudo_random_generator_sw_factory();
+  std::shared_ptr<low_papr_sequence_generator_factory> lpapr_generator_factory =
+      create_low_papr_sequence_generator_sw_factory();
+  std::shared_ptr<low_papr_sequence_collection_factory> lpapr_collection_factory =
+      srsran_matlab::create_low_papr_sequence_collection_cached_factory(lpapr_generator_factory);
+  std::shared_ptr<dft_processor_factory>            dft_factory = create_dft_processor_factory_fftw_slow();
+  std::shared_ptr<time_alignment_estimator_factory> ta_est_factory =
+      create_time_alignment_estimator_dft_factory(dft_factory);
+  std::shared_ptr<port_channel_estimator_factory> estimator_factory =
+      create_port_channel_estimator_factory_sw(ta_est_factory);
+  std::shared_ptr<dmrs_pucch_estimator_factory> dmrs_factory = create_dmrs_pucch_estimator_factory_sw(
+      prg_factory, lpapr_collection_factory, lpapr_generator_factory, estimator_factory);
+  std::shared_ptr<transform_precoder_factory> precoding_factory =
+      create_dft_transform_precoder_factory(dft_factory, pucch_constants::FORMAT3_MAX_NPRB + 1);
+
+  std::shared_ptr<channel_equalizer_factory> equalizer_factory =
+      create_channel_equalizer_generic_factory(channel_equalizer_algorithm_type::zf);
+  std::shared_ptr<pucch_detector_factory> detector_factory =
+      create_pucch_detector_factory_sw(lpapr_collection_factory, prg_factory, equalizer_factory, dft_factory);
+
+  std::shared_ptr<demodulation_mapper_factory> demodulation_factory = create_demodulation_mapper_factory();
+  std::shared_ptr<pucch_demodulator_factory>   demodulator_factory =
+      create_pucch_demodulator_factory_sw(equalizer_factory, demodulation_factory, prg_factory, precoding_factory);
+
+  std::shared_ptr<short_block_detector_factory> short_block_dec_factory = create_short_block_detector_factory_sw();
+  std::shared_ptr<polar_factory>                polar_dec_factory       = create_polar_factory_sw();
+  std::shared_ptr<crc_calculator_factory>       crc_calc_factory        = create_crc_calculator_factory_sw("auto");
+  std::shared_ptr<uci_decoder_factory>          uci_dec_factory =
+      create_uci_decoder_factory_generic(short_block_dec_factory, polar_dec_factory, crc_calc_factory);
+
+  channel_estimate::channel_estimate_dimensions channel_estimate_dimensions;
+  channel_estimate_dimensions.nof_tx_layers = 1;
+  channel_estimate_dimensions.nof_rx_ports  = nof_rx_ports;
+  channel_estimate_dimensions.nof_symbols   = MAX_NSYMB_PER_SLOT;
+  channel_estimate_dimensions.nof_prb       = MAX_RB;
+
+  pucch_link_factories factories;
+  factories.dft       = dft_factory;
+  factories.processor = create_pucch_processor_factory_sw(
+      dmrs_factory, detector_factory, demodulator_factory, uci_dec_factory, channel_estimate_dimensions);
+  return factories;
+}
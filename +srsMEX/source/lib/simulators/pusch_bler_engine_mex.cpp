@@ -0,0 +1,794 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief PUSCH BLER simulation engine MEX definition.
+
+#include "pusch_bler_engine_mex.h"
+#include "srsran_matlab/channel/matlab_to_fading_channel.h"
+#include "srsran_matlab/simulators/matlab_to_stopping_criterion.h"
+#include "srsran_matlab/support/factory_functions.h"
+#include "srsran_matlab/support/matlab_to_srs.h"
+#include "srsran_matlab/support/random_stream.h"
+#include "srsran/phy/support/resource_grid_reader.h"
+#include "srsran/phy/support/resource_grid_writer.h"
+#include "srsran/phy/upper/channel_coding/ldpc/ldpc.h"
+#include "srsran/phy/upper/channel_processors/pusch/pusch_codeword_buffer.h"
+#include "srsran/phy/upper/channel_processors/pusch/pusch_decoder_buffer.h"
+#include "srsran/phy/upper/channel_processors/pusch/pusch_decoder_notifier.h"
+#include "srsran/phy/upper/channel_processors/pusch/pusch_decoder_result.h"
+#include "srsran/phy/upper/channel_processors/pusch/pusch_demodulator_notifier.h"
+#include "srsran/phy/upper/trx_buffer_identifier.h"
+#include "srsran/phy/upper/unique_rx_buffer.h"
+#include "srsran/srsvec/bit.h"
+#include "srsran/srsvec/conversion.h"
+#include "srsran/srsvec/copy.h"
+#include "srsran/srsvec/zero.h"
+#include "srsran/support/units.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <optional>
+
+using matlab::mex::ArgumentList;
+using namespace matlab::data;
+using namespace srsran;
+using namespace srsran_matlab;
+
+namespace {
+
+class pusch_codeword_buffer_spy : private pusch_codeword_buffer
+{
+public:
+  explicit pusch_codeword_buffer_spy(span<log_likelihood_ratio> data_) : data(data_) {}
+
+  bool is_completed() const { return completed; }
+
+  pusch_codeword_buffer& get_buffer() { return *this; }
+
+private:
+  span<log_likelihood_ratio> get_next_block_view(unsigned block_size) override
+  {
+    srsran_assert(!completed, "Data processing is completed.");
+
+    block_size = std::min(block_size, static_cast<unsigned>(data.size()) - count);
+
+    return data.subspan(count, block_size);
+  }
+
+  void on_new_block(span<const log_likelihood_ratio> in_block, const bit_buffer& /* scrambling_seq */) override
+  {
+    srsran_assert(!completed, "Data processing is completed.");
+    srsran_assert(data.size() >= in_block.size() + count,
+                  "The sum of the block size (i.e., {}) and the current count (i.e., {}) exceeds the data size (i.e., "
+                  "{}).",
+                  in_block.size(),
+                  count,
+                  data.size());
+    span<log_likelihood_ratio> block = get_next_block_view(in_block.size());
+
+    if (block.data() != in_block.data()) {
+      srsvec::copy(block, in_block);
+    }
+
+    count += in_block.size();
+  }
+
+  void on_end_codeword() override
+  {
+    srsran_assert(!completed, "Data processing is completed.");
+    srsran_assert(data.size() == count, "Expected {} bits but only wrote {}.", data.size(), count);
+    completed = true;
+  }
+
+  bool                       completed = false;
+  span<log_likelihood_ratio> data;
+  unsigned                   count = 0;
+};
+
+class pusch_demodulator_notifier_spy : private pusch_demodulator_notifier
+{
+public:
+  pusch_demodulator_notifier& get_notifier() { return *this; }
+
+private:
+  void on_provisional_stats(unsigned /* i_symbol */, const demodulation_stats& /* stats */) override {}
+  void on_end_stats(const demodulation_stats& /* stats */) override {}
+};
+
+class pusch_decoder_notifier_spy : private pusch_decoder_notifier
+{
+public:
+  bool has_result() const { return result.has_value(); }
+
+  const pusch_decoder_result& get_result() const { return result.value(); }
+
+  pusch_decoder_notifier& get_notifier() { return *this; }
+
+private:
+  void on_sch_data(const pusch_decoder_result& result_) override { result = result_; }
+
+  std::optional<pusch_decoder_result> result;
+};
+
+/// \brief Returns the DM-RS RE pattern of a layer within a PRB.
+///
+/// Layers 0 and 1 belong to CDM group 0 and layers 2 and 3 to CDM group 1, as per TS38.211 Tables 6.4.1.1.3-1 and
+/// 6.4.1.1.3-2.
+bounded_bitset<NRE> get_dmrs_re_pattern(dmrs_type type, unsigned i_layer)
+{
+  unsigned            cdm_group = i_layer / 2;
+  bounded_bitset<NRE> re_pattern(NRE);
+  for (unsigned i_re = 0; i_re != NRE; ++i_re) {
+    bool is_dmrs = (type == dmrs_type::TYPE1) ? (i_re % 2 == cdm_group) : ((i_re % 6) / 2 == cdm_group);
+    if (is_dmrs) {
+      re_pattern.set(i_re);
+    }
+  }
+  return re_pattern;
+}
+
+/// Returns the dimensions of the DM-RS symbol list of a PUSCH transmission.
+re_measurement_dimensions get_pilot_dimensions(const pusch_bler_config& config)
+{
+  re_measurement_dimensions dims;
+  dims.nof_subc    = config.rb_mask.count() * get_dmrs_re_pattern(config.dmrs, 0).count();
+  dims.nof_symbols = config.dmrs_symb_pos.count();
+  dims.nof_slices  = config.nof_layers;
+  return dims;
+}
+
+/// Returns the dimensions of the channel estimates of a PUSCH transmission.
+channel_estimate::channel_estimate_dimensions get_estimate_dimensions(const pusch_bler_config& config)
+{
+  channel_estimate::channel_estimate_dimensions dims;
+  dims.nof_prb       = config.nof_grid_rb;
+  dims.nof_symbols   = MAX_NSYMB_PER_SLOT;
+  dims.nof_rx_ports  = config.nof_rx_ports;
+  dims.nof_tx_layers = config.nof_layers;
+  return dims;
+}
+
+/// Returns the configuration of the channel impairments of a PUSCH link (carrier frequency offset and AWGN).
+channel_impairments_config get_impairments_config(const pusch_bler_config& config)
+{
+  channel_impairments_config impairments_config;
+  impairments_config.nof_ports     = config.nof_rx_ports;
+  impairments_config.sampling_rate = config.fading.sampling_rate;
+  impairments_config.cfo           = config.cfo;
+  impairments_config.timing_offset = 0;
+  return impairments_config;
+}
+
+} // namespace
+
+pusch_bler_worker::pusch_bler_worker(const pusch_bler_config& config_, const pusch_link_factories& factories) :
+  config(config_),
+  encoder(factories.encoder->create()),
+  modulator(factories.modulator->create()),
+  dmrs(factories.dmrs->create()),
+  estimator(factories.estimator->create(config.fd_smoothing, config.td_interpolation, config.compensate_cfo)),
+  demodulator(factories.demodulator->create()),
+  decoder(factories.decoder->create()),
+  tx_grid(create_resource_grid(config.nof_grid_rb * NRE, MAX_NSYMB_PER_SLOT, config.nof_layers)),
+  rx_grid(create_resource_grid(config.nof_grid_rb * NRE, MAX_NSYMB_PER_SLOT, config.nof_rx_ports)),
+  channel(config.fading),
+  impairments(get_impairments_config(config)),
+  estimates(get_estimate_dimensions(config)),
+  pilots(get_pilot_dimensions(config)),
+  transport_blocks(config.nof_harq_processes, std::vector<uint8_t>(config.tbs / 8)),
+  rx_transport_block(config.tbs / 8)
+{
+  ofdm_processor_config ofdm_config;
+  ofdm_config.nof_subcarriers = config.nof_grid_rb * NRE;
+  ofdm_config.dft_size        = config.dft_size;
+  ofdm_config.scs             = config.scs;
+  ofdm_config.cp              = config.cp;
+  ofdm_config.cp_fraction     = 0.5;
+  ofdm                        = std::make_unique<ofdm_processor>(ofdm_config, *factories.dft);
+
+  // One softbuffer for each HARQ process.
+  rx_buffer_pool_config pool_config = {};
+  pool_config.max_codeblock_size    = config.max_codeblock_size;
+  pool_config.nof_buffers           = config.nof_harq_processes;
+  pool_config.nof_codeblocks        = config.nof_harq_processes * config.nof_codeblocks;
+  pool_config.expire_timeout_slots  = config.nof_harq_processes * config.rv_sequence.size();
+  if (config.softbit_width == 8) {
+    softbuffer_pool = create_rx_buffer_pool(pool_config);
+  } else {
+    compressed_softbuffer_pool = std::make_unique<compressed_rx_buffer_pool>(pool_config, config.softbit_width);
+  }
+  pool_slot = slot_point(to_numerology_value(config.scs), 0);
+
+  // Count the REs carrying data: on DM-RS symbols, the REs of the CDM groups without data are not used.
+  unsigned nof_dmrs_re_per_cdm_group = (config.dmrs == dmrs_type::TYPE1) ? 6 : 4;
+  nof_data_re                        = 0;
+  for (unsigned i_symbol = config.start_symbol, i_end = config.start_symbol + config.nof_symbols; i_symbol != i_end;
+       ++i_symbol) {
+    unsigned nof_re_prb = NRE;
+    if (config.dmrs_symb_pos.test(i_symbol)) {
+      nof_re_prb -= config.nof_cdm_groups_without_data * nof_dmrs_re_per_cdm_group;
+    }
+    nof_data_re += nof_re_prb * config.rb_mask.count();
+  }
+  unsigned nof_cw_bits = nof_data_re * config.nof_layers * get_bits_per_symbol(config.modulation);
+  codeword.resize(nof_cw_bits);
+  llrs.resize(nof_cw_bits);
+
+  // The first slot of a subframe is the longest one.
+  unsigned max_slot_size = ofdm->get_slot_size(0);
+  tx_samples.resize(config.nof_tx_ports * max_slot_size);
+  rx_samples.resize(config.nof_rx_ports * max_slot_size);
+
+  // The channel estimator and the demodulator configurations do not change from slot to slot.
+  estimator_config.cp           = config.cp;
+  estimator_config.scs          = config.scs;
+  estimator_config.first_symbol = config.start_symbol;
+  estimator_config.nof_symbols  = config.nof_symbols;
+  estimator_config.dmrs_pattern.resize(config.nof_layers);
+  for (unsigned i_layer = 0; i_layer != config.nof_layers; ++i_layer) {
+    port_channel_estimator::layer_dmrs_pattern& dmrs_pattern = estimator_config.dmrs_pattern[i_layer];
+    dmrs_pattern.symbols                                     = config.dmrs_symb_pos;
+    dmrs_pattern.rb_mask                                     = config.rb_mask;
+    dmrs_pattern.re_pattern                                  = get_dmrs_re_pattern(config.dmrs, i_layer);
+  }
+  estimator_config.rx_ports.resize(config.nof_rx_ports);
+  std::iota(estimator_config.rx_ports.begin(), estimator_config.rx_ports.end(), 0);
+  estimator_config.scaling = config.dmrs_amplitude;
+
+  demodulator_config.rnti                        = config.rnti;
+  demodulator_config.rb_mask                     = config.rb_mask;
+  demodulator_config.modulation                  = config.modulation;
+  demodulator_config.start_symbol_index          = config.start_symbol;
+  demodulator_config.nof_symbols                 = config.nof_symbols;
+  demodulator_config.dmrs_symb_pos               = config.dmrs_symb_pos;
+  demodulator_config.dmrs_config_type            = config.dmrs;
+  demodulator_config.nof_cdm_groups_without_data = config.nof_cdm_groups_without_data;
+  demodulator_config.n_id                        = config.n_id;
+  demodulator_config.nof_tx_layers               = config.nof_layers;
+  demodulator_config.enable_transform_precoding  = false;
+  for (unsigned i_port = 0; i_port != config.nof_rx_ports; ++i_port) {
+    demodulator_config.rx_ports.push_back(static_cast<uint8_t>(i_port));
+  }
+}
+
+bool pusch_bler_worker::is_valid() const
+{
+  return encoder && modulator && dmrs && ofdm && ofdm->is_valid() && estimator && demodulator && decoder &&
+         (softbuffer_pool || compressed_softbuffer_pool) && tx_grid && rx_grid;
+}
+
+void pusch_bler_worker::transmit(unsigned i_slot, unsigned rv, span<const uint8_t> transport_block)
+{
+  int      start_rb = config.rb_mask.find_lowest();
+  unsigned nof_rb   = config.rb_mask.count();
+
+  // Encode the transport block.
+  segmenter_config encoder_config;
+  encoder_config.base_graph     = config.base_graph;
+  encoder_config.rv             = rv;
+  encoder_config.mod            = config.modulation;
+  encoder_config.Nref           = config.Nref;
+  encoder_config.nof_layers     = config.nof_layers;
+  encoder_config.nof_ch_symbols = nof_data_re * config.nof_layers;
+  encoder->encode(codeword, transport_block, encoder_config);
+
+  dynamic_bit_buffer packed_codeword(codeword.size());
+  srsvec::bit_pack(packed_codeword, codeword);
+
+  tx_grid->set_all_zero();
+  resource_grid_writer& writer = tx_grid->get_writer();
+
+  // Scramble, modulate, layer-map and map the codeword.
+  pdsch_modulator::config_t modulator_config;
+  modulator_config.rnti                        = config.rnti;
+  modulator_config.bwp                         = {0, config.nof_grid_rb};
+  modulator_config.modulation1                 = config.modulation;
+  modulator_config.modulation2                 = config.modulation;
+  modulator_config.freq_allocation             = rb_allocation::make_type1(start_rb, nof_rb);
+  modulator_config.time_alloc                  = {config.start_symbol, config.start_symbol + config.nof_symbols};
+  modulator_config.dmrs_symb_pos               = config.dmrs_symb_pos;
+  modulator_config.dmrs_config_type            = config.dmrs;
+  modulator_config.nof_cdm_groups_without_data = config.nof_cdm_groups_without_data;
+  modulator_config.n_id                        = config.n_id;
+  modulator_config.scaling                     = 1.0F;
+  modulator_config.reserved                    = {};
+  modulator_config.precoding = precoding_configuration::make_wideband(make_identity(config.nof_layers));
+
+  std::array<bit_buffer, 1> codewords = {packed_codeword.first(codeword.size())};
+  modulator->modulate(writer, codewords, modulator_config);
+
+  // Generate and map the DM-RS.
+  dmrs_pdsch_processor::config_t dmrs_config;
+  dmrs_config.slot                 = slot_point(to_numerology_value(config.scs), i_slot);
+  dmrs_config.reference_point_k_rb = 0;
+  dmrs_config.type                 = config.dmrs;
+  dmrs_config.scrambling_id        = config.dmrs_scrambling_id;
+  dmrs_config.n_scid               = config.n_scid;
+  dmrs_config.amplitude            = config.dmrs_amplitude;
+  dmrs_config.symbols_mask         = config.dmrs_symb_pos;
+  dmrs_config.rb_mask              = config.rb_mask;
+  dmrs_config.precoding            = precoding_configuration::make_wideband(make_identity(config.nof_layers));
+  dmrs->map(writer, dmrs_config);
+}
+
+void pusch_bler_worker::extract_pilots()
+{
+  const resource_grid_reader& reader = tx_grid->get_reader();
+
+  unsigned          nof_subcarriers = config.nof_grid_rb * NRE;
+  float             scaling         = 1.0F / config.dmrs_amplitude;
+  std::vector<cf_t> grid_symbol(nof_subcarriers);
+  std::vector<cf_t> layer_pilots;
+  layer_pilots.reserve(get_pilot_dimensions(config).nof_subc * config.dmrs_symb_pos.count());
+
+  // The estimator expects the DM-RS without the amplitude scaling, one OFDM symbol after the other.
+  for (unsigned i_layer = 0; i_layer != config.nof_layers; ++i_layer) {
+    const bounded_bitset<NRE>& re_pattern = estimator_config.dmrs_pattern[i_layer].re_pattern;
+    layer_pilots.clear();
+    config.dmrs_symb_pos.for_each(0, config.dmrs_symb_pos.size(), [&](unsigned i_symbol) {
+      srsvec::convert(grid_symbol, reader.get_view(i_layer, i_symbol).first(nof_subcarriers));
+      config.rb_mask.for_each(0, config.rb_mask.size(), [&](unsigned i_rb) {
+        re_pattern.for_each(
+            0, NRE, [&](unsigned i_re) { layer_pilots.push_back(scaling * grid_symbol[i_rb * NRE + i_re]); });
+      });
+    });
+    pilots.set_slice(layer_pilots, i_layer);
+  }
+}
+
+pusch_bler_counters pusch_bler_worker::run_frame(unsigned i_snr, unsigned i_frame, float noise_var)
+{
+  pusch_bler_counters counters;
+  counters.nof_frames = 1;
+
+  // Every frame starts afresh: new transport blocks, fading realization and noise, all HARQ processes idle.
+  random_stream tb_generator(random_stream_id{config.seed, i_snr, i_frame, 0, random_purpose::transport_block});
+  channel.reset(random_stream_id{config.seed, i_snr, i_frame, 0, random_purpose::fading});
+  impairments.reset(random_stream_id{config.seed, i_snr, i_frame, 0, random_purpose::noise});
+  std::vector<unsigned> rv_indices(config.nof_harq_processes, 0);
+
+  // New transport blocks are transmitted in the slots of the frame only. After the frame, the slots go on until all
+  // HARQ processes are idle again, so that every transport block is counted once its RV sequence is over.
+  unsigned nof_rv          = config.rv_sequence.size();
+  unsigned nof_pending_tbs = 0;
+  for (unsigned i_slot = 0; (i_slot < config.nof_slots_per_frame) || (nof_pending_tbs != 0); ++i_slot) {
+    unsigned              harq_id         = i_slot % config.nof_harq_processes;
+    unsigned              rv_index        = rv_indices[harq_id];
+    bool                  new_data        = (rv_index == 0);
+    std::vector<uint8_t>& transport_block = transport_blocks[harq_id];
+    unsigned              slot_size       = ofdm->get_slot_size(i_slot);
+
+    // The softbuffer pool sees every simulated slot, so that the softbuffers that are not used again expire.
+    ++pool_slot;
+    if (compressed_softbuffer_pool) {
+      compressed_softbuffer_pool->run_slot(pool_slot);
+    } else {
+      softbuffer_pool->get_pool().run_slot(pool_slot);
+    }
+
+    if (new_data && (i_slot >= config.nof_slots_per_frame)) {
+      // Idle process after the frame: nothing is transmitted, but the fading and the noise evolve in time.
+      span<cf_t> tx_slot = span<cf_t>(tx_samples).first(config.nof_tx_ports * slot_size);
+      span<cf_t> rx_slot = span<cf_t>(rx_samples).first(config.nof_rx_ports * slot_size);
+      srsvec::zero(tx_slot);
+      if (!config.slot_independent_fading) {
+        channel.run(rx_slot, tx_slot);
+      }
+      impairments.advance(slot_size);
+      continue;
+    }
+    if (new_data) {
+      std::generate(transport_block.begin(), transport_block.end(), [&]() {
+        return static_cast<uint8_t>(tb_generator() >> 56U);
+      });
+    }
+
+    // Transmitter: the transmit antennas beyond the number of layers are not used.
+    transmit(i_slot, config.rv_sequence[rv_index], transport_block);
+    span<cf_t> tx_slot = span<cf_t>(tx_samples).first(config.nof_tx_ports * slot_size);
+    span<cf_t> rx_slot = span<cf_t>(rx_samples).first(config.nof_rx_ports * slot_size);
+    srsvec::zero(tx_slot);
+    for (unsigned i_layer = 0; i_layer != config.nof_layers; ++i_layer) {
+      ofdm->modulate(tx_slot.subspan(i_layer * slot_size, slot_size), tx_grid->get_reader(), i_layer, i_slot);
+    }
+
+    // Channel.
+    if (config.slot_independent_fading) {
+      channel.reset(random_stream_id{config.seed, i_snr, i_frame, i_slot, random_purpose::fading});
+    }
+    channel.run(rx_slot, tx_slot);
+    for (unsigned i_port = 0; i_port != config.nof_rx_ports; ++i_port) {
+      impairments.run(rx_slot.subspan(i_port * slot_size, slot_size), i_port, noise_var);
+    }
+    impairments.advance(slot_size);
+
+    // Receiver.
+    rx_grid->set_all_zero();
+    for (unsigned i_port = 0; i_port != config.nof_rx_ports; ++i_port) {
+      ofdm->demodulate(rx_grid->get_writer(), rx_slot.subspan(i_port * slot_size, slot_size), i_port, i_slot);
+    }
+
+    extract_pilots();
+    for (unsigned i_port = 0; i_port != config.nof_rx_ports; ++i_port) {
+      estimator->compute(estimates, rx_grid->get_reader(), i_port, pilots, estimator_config);
+    }
+
+    float rsrp          = 0;
+    float estimated_var = 0;
+    for (unsigned i_port = 0; i_port != config.nof_rx_ports; ++i_port) {
+      rsrp += estimates.get_rsrp(i_port);
+      estimated_var += estimates.get_noise_variance(i_port);
+    }
+    counters.rsrp += rsrp / static_cast<float>(config.nof_rx_ports);
+    counters.noise_var += estimated_var / static_cast<float>(config.nof_rx_ports);
+
+    pusch_codeword_buffer_spy      cw_buffer(llrs);
+    pusch_demodulator_notifier_spy demodulator_notifier;
+    demodulator->demodulate(cw_buffer.get_buffer(),
+                            demodulator_notifier.get_notifier(),
+                            rx_grid->get_reader(),
+                            estimates,
+                            demodulator_config);
+    srsran_assert(cw_buffer.is_completed(), "The PUSCH demodulator did not complete the codeword.");
+
+    pusch_decoder::configuration decoder_config = {};
+    decoder_config.base_graph                   = config.base_graph;
+    decoder_config.mod                          = config.modulation;
+    decoder_config.nof_layers                   = config.nof_layers;
+    decoder_config.rv                           = config.rv_sequence[rv_index];
+    decoder_config.Nref                         = config.Nref;
+    decoder_config.new_data                     = new_data;
+    decoder_config.use_early_stop               = true;
+    decoder_config.nof_ldpc_iterations          = config.nof_ldpc_iterations;
+
+    trx_buffer_identifier buffer_id(config.rnti, harq_id);
+    unique_rx_buffer      softbuffer =
+        compressed_softbuffer_pool
+            ? compressed_softbuffer_pool->reserve(pool_slot, buffer_id, config.nof_codeblocks, decoder_config.new_data)
+            : softbuffer_pool->get_pool().reserve(pool_slot, buffer_id, config.nof_codeblocks, decoder_config.new_data);
+    srsran_assert(softbuffer.is_valid(), "Cannot reserve softbuffer {}.", buffer_id);
+    if (new_data) {
+      softbuffer.get().reset_codeblocks_crc();
+    }
+
+    pusch_decoder_notifier_spy decoder_notifier;
+    pusch_decoder_buffer&      decoder_buffer =
+        decoder->new_data(rx_transport_block, std::move(softbuffer), decoder_notifier.get_notifier(), decoder_config);
+    decoder_buffer.on_new_softbits(llrs);
+    decoder_buffer.on_end_softbits();
+    srsran_assert(decoder_notifier.has_result(), "Notifier result has not been reported.");
+    const pusch_decoder_result& result = decoder_notifier.get_result();
+
+    // Update the counters as PUSCHBLER does.
+    bool   is_last_rv = (rv_index == nof_rv - 1);
+    double iterations = result.ldpc_decoder_stats.get_mean();
+    ++counters.nof_slots;
+    counters.max_throughput += config.tbs;
+    counters.dec_iterations += iterations;
+    if (result.tb_crc_ok) {
+      counters.throughput += config.tbs;
+      counters.dec_iterations_crc_ok += iterations;
+    }
+    if (result.tb_crc_ok || is_last_rv) {
+      ++counters.total_blocks;
+      if (!std::equal(transport_block.begin(), transport_block.end(), rx_transport_block.begin())) {
+        ++counters.missed_blocks;
+      }
+    }
+
+    // HARQ: retransmit with the next redundancy version until success or timeout.
+    bool is_tb_over = result.tb_crc_ok || is_last_rv;
+    if (new_data && !is_tb_over) {
+      ++nof_pending_tbs;
+    } else if (!new_data && is_tb_over) {
+      --nof_pending_tbs;
+    }
+    rv_indices[harq_id] = is_tb_over ? 0 : rv_index + 1;
+  }
+
+  return counters;
+}
+
+void MexFunction::method_new(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 2;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::DOUBLE) || (inputs[1].getNumberOfElements() != 1)) {
+    mex_abort("Input 'nofWorkers' should be a scalar double.");
+  }
+
+  if (!outputs.empty()) {
+    mex_abort("Wrong number of outputs: expected 0, provided {}.", outputs.size());
+  }
+
+  unsigned nof_workers_in = static_cast<unsigned>(static_cast<TypedArray<double>>(inputs[1])[0]);
+  nof_workers             = (nof_workers_in == 0) ? default_nof_workers() : nof_workers_in;
+}
+
+void MexFunction::check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 6;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::STRUCT) || (inputs[1].getNumberOfElements() != 1)) {
+    mex_abort("Input 'config' should be a scalar structure.");
+  }
+
+  if ((inputs[2].getType() != ArrayType::DOUBLE) || (inputs[2].getNumberOfElements() == 0)) {
+    mex_abort("Input 'SNRIn' should be a nonempty array of doubles.");
+  }
+
+  if ((inputs[3].getType() != ArrayType::DOUBLE) || (inputs[3].getNumberOfElements() != 1)) {
+    mex_abort("Input 'nFrames' should be a scalar double.");
+  }
+
+  if ((inputs[4].getType() != ArrayType::DOUBLE) || (inputs[4].getNumberOfElements() != 1)) {
+    mex_abort("Input 'maxMissedBlocks' should be a scalar double.");
+  }
+
+  if ((inputs[5].getType() != ArrayType::STRUCT) || (inputs[5].getNumberOfElements() != 1)) {
+    mex_abort("Input 'stopping' should be a scalar structure.");
+  }
+
+  constexpr unsigned NOF_OUTPUTS = 1;
+  if (outputs.size() != NOF_OUTPUTS) {
+    mex_abort("Wrong number of outputs: expected {}, provided {}.", NOF_OUTPUTS, outputs.size());
+  }
+}
+
+pusch_bler_config MexFunction::read_config(const Struct& in_cfg)
+{
+  pusch_bler_config config;
+
+  // Carrier.
+  config.nof_grid_rb         = in_cfg["NSizeGrid"][0];
+  config.scs                 = matlab_to_srs_subcarrier_spacing(static_cast<unsigned>(in_cfg["SubcarrierSpacing"][0]));
+  const CharArray in_cp      = in_cfg["CyclicPrefix"];
+  config.cp                  = matlab_to_srs_cyclic_prefix(in_cp.toAscii());
+  config.dft_size            = in_cfg["Nfft"][0];
+  config.nof_slots_per_frame = in_cfg["SlotsPerFrame"][0];
+  unsigned nof_symbols_slot  = get_nsymb_per_slot(config.cp);
+  unsigned nof_subcarriers   = config.nof_grid_rb * NRE;
+  if ((config.nof_grid_rb == 0) || (config.nof_grid_rb > MAX_RB) || (nof_subcarriers > config.dft_size)) {
+    mex_abort("Invalid grid of {} RBs with a DFT size of {}.", config.nof_grid_rb, config.dft_size);
+  }
+
+  // Frequency allocation (contiguous PRB allocation is assumed).
+  config.rnti                       = in_cfg["RNTI"][0];
+  config.n_id                       = in_cfg["NID"][0];
+  const TypedArray<bool> in_rb_mask = in_cfg["RBMask"];
+  if (in_rb_mask.getNumberOfElements() != config.nof_grid_rb) {
+    mex_abort("The RB mask size (i.e., {}) does not match the grid size (i.e., {}).",
+              in_rb_mask.getNumberOfElements(),
+              config.nof_grid_rb);
+  }
+  config.rb_mask = crb_bitmap(in_rb_mask.cbegin(), in_rb_mask.cend());
+  if (config.rb_mask.none() || !config.rb_mask.is_contiguous()) {
+    mex_abort("The PUSCH frequency allocation must be non-empty and contiguous.");
+  }
+
+  // Time allocation.
+  config.start_symbol                = in_cfg["StartSymbolIndex"][0];
+  config.nof_symbols                 = in_cfg["NumSymbols"][0];
+  const TypedArray<bool> in_dmrs_pos = in_cfg["DMRSSymbPos"];
+  config.dmrs_symb_pos               = bounded_bitset<MAX_NSYMB_PER_SLOT>(in_dmrs_pos.cbegin(), in_dmrs_pos.cend());
+  if (config.start_symbol + config.nof_symbols > nof_symbols_slot) {
+    mex_abort("The time allocation [{}, {}) exceeds the slot.",
+              config.start_symbol,
+              config.start_symbol + config.nof_symbols);
+  }
+
+  // DM-RS and modulation parameters.
+  config.dmrs                        = matlab_to_srs_dmrs_type(in_cfg["DMRSConfigType"][0]);
+  config.nof_cdm_groups_without_data = in_cfg["NumCDMGroupsWithoutData"][0];
+  config.dmrs_scrambling_id          = in_cfg["NIDNSCID"][0];
+  config.n_scid                      = (static_cast<unsigned>(in_cfg["NSCID"][0]) == 1);
+  config.dmrs_amplitude              = static_cast<float>(static_cast<double>(in_cfg["DMRSAmplitude"][0]));
+  config.nof_layers                  = in_cfg["NumLayers"][0];
+  const CharArray in_modulation      = in_cfg["Modulation"];
+  config.modulation                  = matlab_to_srs_modulation(in_modulation.toAscii());
+
+  // UL-SCH and HARQ.
+  config.base_graph                       = matlab_to_srs_base_graph(in_cfg["BGN"][0]);
+  config.tbs                              = in_cfg["TransportBlockLength"][0];
+  config.nof_codeblocks                   = in_cfg["NumCodeblocks"][0];
+  config.max_codeblock_size               = in_cfg["MaxCodeblockSize"][0];
+  config.softbit_width                    = in_cfg["SoftbitWidth"][0];
+  config.Nref                             = in_cfg["LimitedBufferSize"][0];
+  config.nof_ldpc_iterations              = in_cfg["MaximumLDPCIterationCount"][0];
+  config.nof_harq_processes               = in_cfg["NumHARQProcesses"][0];
+  const TypedArray<double> in_rv_sequence = in_cfg["RVSequence"];
+  for (double rv : in_rv_sequence) {
+    config.rv_sequence.push_back(static_cast<unsigned>(rv));
+  }
+
+  units::bits tbs(config.tbs);
+  if ((config.tbs == 0) || !tbs.is_byte_exact()) {
+    mex_abort("The TBS (i.e., {}) is not a positive exact number of bytes.", config.tbs);
+  }
+  if (config.nof_codeblocks != ldpc::compute_nof_codeblocks(tbs, config.base_graph)) {
+    mex_abort(
+        "The number of codeblocks (i.e., {}) does not match the TBS (i.e., {}).", config.nof_codeblocks, config.tbs);
+  }
+  if (config.rv_sequence.empty() || (config.nof_harq_processes == 0)) {
+    mex_abort("At least one redundancy version and one HARQ process are required.");
+  }
+  if ((config.softbit_width != 8) && (config.softbit_width != 6) && (config.softbit_width != 4)) {
+    mex_abort("Invalid soft bit width {}, valid values are 8, 6 and 4.", config.softbit_width);
+  }
+
+  // Antennas and channel.
+  config.nof_tx_ports = in_cfg["NumTxAnts"][0];
+  config.nof_rx_ports = in_cfg["NumRxAnts"][0];
+  if ((config.nof_layers == 0) || (config.nof_layers > 4) || (config.nof_layers > config.nof_tx_ports)) {
+    mex_abort("Invalid number of layers {} with {} transmit antennas.", config.nof_layers, config.nof_tx_ports);
+  }
+  if (config.nof_rx_ports == 0) {
+    mex_abort("At least one receive antenna is required.");
+  }
+
+  matlab_to_fading_profile(config.fading, in_cfg, [this](const std::string& msg) { mex_abort(msg); });
+  config.fading.sampling_rate =
+      static_cast<double>(config.dft_size) * 15e3 * static_cast<double>(1U << to_numerology_value(config.scs));
+  config.fading.nof_tx_ports                 = config.nof_tx_ports;
+  config.fading.nof_rx_ports                 = config.nof_rx_ports;
+  config.fading.normalize_outputs            = true;
+  const TypedArray<bool> in_slot_independent = in_cfg["SlotIndependentFading"];
+  config.slot_independent_fading             = in_slot_independent[0];
+  config.cfo                                 = in_cfg["CarrierFrequencyOffset"][0];
+
+  // Receiver.
+  const CharArray   in_smoothing        = in_cfg["Smoothing"];
+  const std::string fd_smoothing_string = in_smoothing.toAscii();
+  config.fd_smoothing                   = port_channel_estimator_fd_smoothing_strategy::none;
+  if (fd_smoothing_string == "filter") {
+    config.fd_smoothing = port_channel_estimator_fd_smoothing_strategy::filter;
+  } else if (fd_smoothing_string == "mean") {
+    config.fd_smoothing = port_channel_estimator_fd_smoothing_strategy::mean;
+  } else if (fd_smoothing_string != "none") {
+    mex_abort("Unknown FD smoothing strategy {}.", fd_smoothing_string);
+  }
+
+  const CharArray   in_interpolation        = in_cfg["Interpolation"];
+  const std::string td_interpolation_string = in_interpolation.toAscii();
+  config.td_interpolation                   = port_channel_estimator_td_interpolation_strategy::average;
+  if (td_interpolation_string == "interpolate") {
+    config.td_interpolation = port_channel_estimator_td_interpolation_strategy::interpolate;
+  } else if (td_interpolation_string != "average") {
+    mex_abort("Unknown TD interpolation strategy {}.", td_interpolation_string);
+  }
+
+  const TypedArray<bool> in_compensate_cfo = in_cfg["CompensateCFO"];
+  config.compensate_cfo                    = in_compensate_cfo[0];
+
+  const CharArray   in_equalizer     = in_cfg["EqualizerType"];
+  const std::string equalizer_string = in_equalizer.toAscii();
+  config.equalizer                   = channel_equalizer_algorithm_type::zf;
+  if (equalizer_string == "MMSE") {
+    config.equalizer = channel_equalizer_algorithm_type::mmse;
+  } else if (equalizer_string != "ZF") {
+    mex_abort("Unknown equalizer type {}.", equalizer_string);
+  }
+
+  config.seed = static_cast<uint64_t>(in_cfg["Seed"][0]);
+
+  return config;
+}
+
+void MexFunction::method_step(ArgumentList outputs, ArgumentList inputs)
+{
+  check_step_outputs_inputs(outputs, inputs);
+
+  const StructArray       in_struct_array = inputs[1];
+  const pusch_bler_config config          = read_config(in_struct_array[0]);
+
+  const TypedArray<double> in_snr            = inputs[2];
+  std::vector<double>      snr_values        = std::vector<double>(in_snr.cbegin(), in_snr.cend());
+  unsigned                 nof_snr           = snr_values.size();
+  unsigned                 nof_frames        = static_cast<unsigned>(static_cast<TypedArray<double>>(inputs[3])[0]);
+  unsigned                 max_missed_blocks = static_cast<unsigned>(static_cast<TypedArray<double>>(inputs[4])[0]);
+  const StructArray        in_stopping_array = inputs[5];
+  const stopping_criterion criterion(
+      matlab_to_stopping_criterion(in_stopping_array[0], [this](const std::string& msg) { mex_abort(msg); }));
+
+  // The workers are created serially, since DFT planning may not be thread-safe.
+  unsigned             nof_active_workers = std::max(1U, std::min(nof_workers, nof_snr * nof_frames));
+  pusch_link_factories factories          = create_pusch_link_factories(config.equalizer);
+  std::vector<std::unique_ptr<pusch_bler_worker>> workers;
+  for (unsigned i_worker = 0; i_worker != nof_active_workers; ++i_worker) {
+    workers.emplace_back(std::make_unique<pusch_bler_worker>(config, factories));
+    if (!workers.back()->is_valid()) {
+      mex_abort("Cannot create the PUSCH link components.");
+    }
+  }
+
+  // Noise variance of the time-domain samples, as in PUSCHBLER.
+  std::vector<float> noise_vars(nof_snr);
+  std::transform(snr_values.cbegin(), snr_values.cend(), noise_vars.begin(), [&config](double snr_dB) {
+    return static_cast<float>(1.0 / (config.nof_rx_ports * config.dft_size * std::pow(10.0, snr_dB / 10.0)));
+  });
+
+  // Without an early stop, all frames of all SNR points are simulated at once. Otherwise, frames are simulated in
+  // batches of one frame per worker, shared among the SNR points that are not stopped yet, so that at most one batch is
+  // wasted once all the points are stopped.
+  bool     early_stop = (max_missed_blocks != 0) || criterion.is_enabled();
+  unsigned batch_size = early_stop ? nof_active_workers : std::max(1U, nof_snr * nof_frames);
+
+  std::vector<pusch_bler_counters> results(nof_snr);
+  std::vector<pusch_bler_counters> frame_counters(batch_size);
+  trial_scheduler                  scheduler(nof_snr, nof_frames, batch_size);
+  while (!scheduler.is_done()) {
+    const std::vector<trial_scheduler::trial>& batch = scheduler.next_batch();
+    try {
+      parallel_for(batch.size(), nof_active_workers, [&](unsigned i_trial, unsigned i_worker) {
+        const trial_scheduler::trial& trial = batch[i_trial];
+        frame_counters[i_trial] = workers[i_worker]->run_frame(trial.i_point, trial.i_item, noise_vars[trial.i_point]);
+      });
+    } catch (const std::exception& e) {
+      mex_abort("Cannot simulate the PUSCH link: {}", e.what());
+    }
+
+    // Accumulate in frame order, up to the frame reaching the target number of missed blocks or the target accuracy
+    // of the BLER.
+    for (unsigned i_trial = 0, nof_trials = batch.size(); i_trial != nof_trials; ++i_trial) {
+      unsigned             i_snr  = batch[i_trial].i_point;
+      pusch_bler_counters& result = results[i_snr];
+      if (scheduler.is_stopped(i_snr)) {
+        continue;
+      }
+      result += frame_counters[i_trial];
+      if (((max_missed_blocks != 0) && (result.missed_blocks >= max_missed_blocks)) ||
+          criterion.is_met(result.missed_blocks, result.total_blocks)) {
+        scheduler.stop(i_snr);
+      }
+    }
+  }
+
+  StructArray out = factory.createStructArray({snr_values.size(), 1},
+                                              {"NumFrames",
+                                               "NumSlots",
+                                               "MaxThroughput",
+                                               "Throughput",
+                                               "TotalBlocks",
+                                               "MissedBlocks",
+                                               "DecIterations",
+                                               "DecIterationsCRCOK",
+                                               "RSRP",
+                                               "NoiseVar"});
+  for (unsigned i_snr = 0; i_snr != nof_snr; ++i_snr) {
+    const pusch_bler_counters& result = results[i_snr];
+    out[i_snr]["NumFrames"]           = factory.createScalar(static_cast<double>(result.nof_frames));
+    out[i_snr]["NumSlots"]            = factory.createScalar(static_cast<double>(result.nof_slots));
+    out[i_snr]["MaxThroughput"]       = factory.createScalar(result.max_throughput);
+    out[i_snr]["Throughput"]          = factory.createScalar(result.throughput);
+    out[i_snr]["TotalBlocks"]         = factory.createScalar(static_cast<double>(result.total_blocks));
+    out[i_snr]["MissedBlocks"]        = factory.createScalar(static_cast<double>(result.missed_blocks));
+    out[i_snr]["DecIterations"]       = factory.createScalar(result.dec_iterations);
+    out[i_snr]["DecIterationsCRCOK"]  = factory.createScalar(result.dec_iterations_crc_ok);
+    out[i_snr]["RSRP"]                = factory.createScalar(result.rsrp);
+    out[i_snr]["NoiseVar"]            = factory.createScalar(result.noise_var);
+  }
+  outputs[0] = out;
+}
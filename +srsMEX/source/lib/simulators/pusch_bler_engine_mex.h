@@ -0,0 +1,479 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief PUSCH BLER simulation engine MEX declaration.
+///
+/// The engine runs the complete PUSCH link of the PUSCHBLER simulator natively: UL-SCH encoding, PUSCH modulation and
+/// DM-RS mapping, OFDM modulation, fading channel, carrier frequency offset and AWGN, OFDM demodulation, channel
+/// estimation, PUSCH demodulation and UL-SCH decoding with HARQ soft combining. As in the srsPUSCHTransmitter MEX,
+/// the transmitter reuses the PDSCH encoder, modulator and DM-RS processor, which coincide with their PUSCH
+/// counterparts for non-transform-precoded transmissions without UCI. The receiver is made of the same srsRAN blocks
+/// wrapped by the srsMultiPortChannelEstimator, srsPUSCHDemodulator and srsPUSCHDecoder MEX.
+
+#pragma once
+
+#include "srsran_matlab/channel/channel_impairments.h"
+#include "srsran_matlab/channel/fading_channel.h"
+#include "srsran_matlab/simulators/ofdm_processor.h"
+#include "srsran_matlab/simulators/trial_scheduler.h"
+#include "srsran_matlab/srsran_mex_dispatcher.h"
+#include "srsran_matlab/support/compressed_rx_buffer_pool.h"
+#include "srsran_matlab/support/parallel_for.h"
+#include "srsran/adt/bounded_bitset.h"
+#include "srsran/phy/generic_functions/generic_functions_factories.h"
+#include "srsran/phy/generic_functions/precoding/precoding_factories.h"
+#include "srsran/phy/support/resource_grid.h"
+#include "srsran/phy/support/support_factories.h"
+#include "srsran/phy/upper/channel_coding/channel_coding_factories.h"
+#include "srsran/phy/upper/channel_modulation/channel_modulation_factories.h"
+#include "srsran/phy/upper/channel_processors/pdsch/factories.h"
+#include "srsran/phy/upper/channel_processors/pdsch/pdsch_encoder.h"
+#include "srsran/phy/upper/channel_processors/pdsch/pdsch_modulator.h"
+#include "srsran/phy/upper/channel_processors/pusch/factories.h"
+#include "srsran/phy/upper/channel_processors/pusch/pusch_decoder.h"
+#include "srsran/phy/upper/channel_processors/pusch/pusch_demodulator.h"
+#include "srsran/phy/upper/equalization/channel_equalizer_algorithm_type.h"
+#include "srsran/phy/upper/equalization/equalization_factories.h"
+#include "srsran/phy/upper/rx_buffer_pool.h"
+#include "srsran/phy/upper/sequence_generators/sequence_generator_factories.h"
+#include "srsran/phy/upper/signal_processors/channel_estimator/factories.h"
+#include "srsran/phy/upper/signal_processors/signal_processor_factories.h"
+#include "srsran/ran/cyclic_prefix.h"
+#include "srsran/ran/resource_block.h"
+#include "srsran/ran/sch/modulation_scheme.h"
+#include "srsran/ran/slot_point.h"
+#include "srsran/ran/subcarrier_spacing.h"
+#include <memory>
+#include <vector>
+
+/// PUSCH link and channel configuration, as read from the MATLAB configuration structure.
+struct pusch_bler_config {
+  /// Number of resource blocks of the resource grid.
+  unsigned nof_grid_rb;
+  /// Subcarrier spacing.
+  srsran::subcarrier_spacing scs;
+  /// Cyclic prefix.
+  srsran::cyclic_prefix cp;
+  /// DFT size of the OFDM modulator and demodulator.
+  unsigned dft_size;
+  /// Number of slots in a frame.
+  unsigned nof_slots_per_frame;
+  /// Radio network temporary identifier.
+  uint16_t rnti;
+  /// Data scrambling identifier.
+  unsigned n_id;
+  /// Allocated resource blocks (contiguous allocation).
+  srsran::crb_bitmap rb_mask;
+  /// Index of the first OFDM symbol of the allocation.
+  unsigned start_symbol;
+  /// Number of OFDM symbols of the allocation.
+  unsigned nof_symbols;
+  /// OFDM symbols carrying DM-RS.
+  srsran::bounded_bitset<srsran::MAX_NSYMB_PER_SLOT> dmrs_symb_pos;
+  /// DM-RS configuration type.
+  srsran::dmrs_type dmrs;
+  /// Number of DM-RS CDM groups without data.
+  unsigned nof_cdm_groups_without_data;
+  /// DM-RS scrambling identifier.
+  unsigned dmrs_scrambling_id;
+  /// DM-RS scrambling initialization.
+  bool n_scid;
+  /// Linear amplitude of the DM-RS with respect to the data.
+  float dmrs_amplitude;
+  /// Number of transmission layers.
+  unsigned nof_layers;
+  /// Modulation scheme.
+  srsran::modulation_scheme modulation;
+  /// LDPC base graph.
+  srsran::ldpc_base_graph_type base_graph;
+  /// Transport block size in bits.
+  unsigned tbs;
+  /// Number of codeblocks of a transport block.
+  unsigned nof_codeblocks;
+  /// Maximum codeblock length, for the softbuffer pool.
+  unsigned max_codeblock_size;
+  /// Number of bits of the soft bits stored in the softbuffer pool (8 for full width, 6 or 4 for compressed).
+  unsigned softbit_width;
+  /// Limited buffer rate matching length (zero for unlimited buffer).
+  unsigned Nref;
+  /// Maximum number of LDPC decoding iterations.
+  unsigned nof_ldpc_iterations;
+  /// Redundancy version sequence of a HARQ process.
+  std::vector<unsigned> rv_sequence;
+  /// Number of HARQ processes, scheduled one after the other in consecutive slots.
+  unsigned nof_harq_processes;
+  /// Number of transmit antennas.
+  unsigned nof_tx_ports;
+  /// Number of receive antennas.
+  unsigned nof_rx_ports;
+  /// Fading channel configuration.
+  srsran_matlab::fading_channel_config fading;
+  /// Set to \c true to draw a new fading realization in every slot, \c false for a continuous fading process.
+  bool slot_independent_fading;
+  /// Carrier frequency offset in hertz.
+  double cfo;
+  /// Frequency-domain smoothing strategy of the channel estimator.
+  srsran::port_channel_estimator_fd_smoothing_strategy fd_smoothing;
+  /// Time-domain interpolation strategy of the channel estimator.
+  srsran::port_channel_estimator_td_interpolation_strategy td_interpolation;
+  /// Set to \c true to compensate the CFO in the channel estimator.
+  bool compensate_cfo;
+  /// Channel equalizer algorithm.
+  srsran::channel_equalizer_algorithm_type equalizer;
+  /// Seed of all the random processes (transport blocks, fading and noise).
+  uint64_t seed;
+};
+
+/// Simulation counters, with the same meaning as the PUSCHBLER counters.
+struct pusch_bler_counters {
+  /// Number of simulated frames.
+  unsigned nof_frames = 0;
+  /// Number of simulated slots, including the slots that complete the retransmissions after the end of a frame.
+  unsigned nof_slots = 0;
+  /// Number of transmitted bits, retransmissions included.
+  double max_throughput = 0;
+  /// Number of correctly received bits.
+  double throughput = 0;
+  /// Number of transport blocks, counted when correctly received or after the last retransmission.
+  unsigned total_blocks = 0;
+  /// Number of transport blocks missed after all allowed retransmissions.
+  unsigned missed_blocks = 0;
+  /// Sum of the average number of LDPC iterations of all the transmissions.
+  double dec_iterations = 0;
+  /// Sum of the average number of LDPC iterations of the transmissions with a valid CRC.
+  double dec_iterations_crc_ok = 0;
+  /// Sum of the RSRP estimated in every slot.
+  double rsrp = 0;
+  /// Sum of the noise variance estimated in every slot.
+  double noise_var = 0;
+
+  /// Accumulates the counters of another simulation.
+  pusch_bler_counters& operator+=(const pusch_bler_counters& other)
+  {
+    nof_frames += other.nof_frames;
+    nof_slots += other.nof_slots;
+    max_throughput += other.max_throughput;
+    throughput += other.throughput;
+    total_blocks += other.total_blocks;
+    missed_blocks += other.missed_blocks;
+    dec_iterations += other.dec_iterations;
+    dec_iterations_crc_ok += other.dec_iterations_crc_ok;
+    rsrp += other.rsrp;
+    noise_var += other.noise_var;
+    return *this;
+  }
+};
+
+/// Collection of srsRAN factories for the components of a PUSCH link.
+struct pusch_link_factories {
+  /// UL-SCH encoder factory (identical to the DL-SCH one in the absence of UCI).
+  std::shared_ptr<srsran::pdsch_encoder_factory> encoder;
+  /// Scrambler, modulator and mapper factory.
+  std::shared_ptr<srsran::pdsch_modulator_factory> modulator;
+  /// DM-RS generator and mapper factory.
+  std::shared_ptr<srsran::dmrs_pdsch_processor_factory> dmrs;
+  /// DFT factory, for the OFDM modulator and demodulator.
+  std::shared_ptr<srsran::dft_processor_factory> dft;
+  /// Port channel estimator factory.
+  std::shared_ptr<srsran::port_channel_estimator_factory> estimator;
+  /// PUSCH demodulator factory.
+  std::shared_ptr<srsran::pusch_demodulator_factory> demodulator;
+  /// PUSCH decoder factory.
+  std::shared_ptr<srsran::pusch_decoder_factory> decoder;
+};
+
+/// \brief Factory method for the PUSCH link factories.
+///
+/// Creates and assemblies all the necessary factories (LDPC blocks, modulation mappers, DM-RS generator, DFT, channel
+/// estimator, equalizer, ...) for a fully-functional PUSCH link with the given equalizer.
+inline pusch_link_factories create_pusch_link_factories(srsran::channel_equalizer_algorithm_type equalizer);
+
+/// \brief Simulates a PUSCH link, one frame at a time.
+///
+/// Each worker owns a full transmitter, channel and receiver, as well as the softbuffer pool and the HARQ state of all
+/// the HARQ processes. Frames are independent of each other: the HARQ processes, the fading channel and all the random
+/// generators start afresh at every frame, with random streams identified by the SNR and frame indices. Therefore, the
+/// counters of a frame do not depend on which worker simulates it.
+///
+/// New transport blocks are only transmitted in the slots of the frame. The retransmissions still pending at the end
+/// of the frame go on in the following slots until all HARQ processes are idle, so that each frame holds complete RV
+/// sequences and all its transport blocks are counted, as in a simulation where the HARQ processes carry on across
+/// frames.
+class pusch_bler_worker
+{
+public:
+  /// Creates the worker components. The components are not valid if any of them could not be created.
+  pusch_bler_worker(const pusch_bler_config& config_, const pusch_link_factories& factories);
+
+  /// Returns \c true if all the components were created successfully.
+  bool is_valid() const;
+
+  /// \brief Simulates one frame, followed by the retransmissions still pending at its end.
+  ///
+  /// \param[in] i_snr      SNR index, used to identify the random streams.
+  /// \param[in] i_frame    Frame index, used to identify the random streams.
+  /// \param[in] noise_var  Noise variance of the time-domain samples, at each receive port.
+  /// \return The counters of the simulated frame.
+  pusch_bler_counters run_frame(unsigned i_snr, unsigned i_frame, float noise_var);
+
+private:
+  /// Generates, encodes, modulates and maps the PUSCH transmission of a slot into the transmit grid.
+  void transmit(unsigned i_slot, unsigned rv, srsran::span<const uint8_t> transport_block);
+
+  /// Extracts the DM-RS of each layer from the transmit grid, as expected by the channel estimator.
+  void extract_pilots();
+
+  /// Link configuration.
+  pusch_bler_config config;
+  /// UL-SCH encoder.
+  std::unique_ptr<srsran::pdsch_encoder> encoder;
+  /// Scrambler, modulator and mapper.
+  std::unique_ptr<srsran::pdsch_modulator> modulator;
+  /// DM-RS generator and mapper.
+  std::unique_ptr<srsran::dmrs_pdsch_processor> dmrs;
+  /// OFDM modulator and demodulator.
+  std::unique_ptr<srsran_matlab::ofdm_processor> ofdm;
+  /// Port channel estimator.
+  std::unique_ptr<srsran::port_channel_estimator> estimator;
+  /// PUSCH demodulator.
+  std::unique_ptr<srsran::pusch_demodulator> demodulator;
+  /// PUSCH decoder.
+  std::unique_ptr<srsran::pusch_decoder> decoder;
+  /// Softbuffer pool, with one softbuffer for each HARQ process (full-width soft bits only).
+  std::unique_ptr<srsran::rx_buffer_pool_controller> softbuffer_pool;
+  /// Softbuffer pool, with one softbuffer for each HARQ process (compressed soft bits only).
+  std::unique_ptr<srsran_matlab::compressed_rx_buffer_pool> compressed_softbuffer_pool;
+  /// Current slot of the softbuffer pool, counting all the slots simulated by the worker.
+  srsran::slot_point pool_slot;
+  /// Transmit resource grid, one port for each layer.
+  std::unique_ptr<srsran::resource_grid> tx_grid;
+  /// Receive resource grid, one port for each receive antenna.
+  std::unique_ptr<srsran::resource_grid> rx_grid;
+  /// Fading channel.
+  srsran_matlab::fading_channel channel;
+  /// Carrier frequency offset and AWGN.
+  srsran_matlab::channel_impairments impairments;
+  /// Channel estimator configuration.
+  srsran::port_channel_estimator::configuration estimator_config;
+  /// PUSCH demodulator configuration.
+  srsran::pusch_demodulator::configuration demodulator_config;
+  /// Channel estimates.
+  srsran::channel_estimate estimates;
+  /// DM-RS symbols of all layers, as expected by the channel estimator.
+  srsran::dmrs_symbol_list pilots;
+  /// Number of resource elements carrying data in a slot, per layer.
+  unsigned nof_data_re;
+  /// Transport blocks of the HARQ processes (packed bits).
+  std::vector<std::vector<uint8_t>> transport_blocks;
+  /// Decoded transport block (packed bits).
+  std::vector<uint8_t> rx_transport_block;
+  /// Unpacked codeword.
+  std::vector<uint8_t> codeword;
+  /// Codeword log-likelihood ratios.
+  std::vector<srsran::log_likelihood_ratio> llrs;
+  /// Transmitted samples, one antenna after the other.
+  std::vector<srsran::cf_t> tx_samples;
+  /// Received samples, one antenna after the other.
+  std::vector<srsran::cf_t> rx_samples;
+};
+
+/// \brief Implements the PUSCH BLER simulation engine following the srsran_mex_dispatcher template.
+///
+/// The frames of all SNR points are simulated by a pool of workers, which move to the points that are still running as
+/// soon as the other points are stopped (see trial_scheduler). The counters of each point are accumulated in frame
+/// order and, when a point stops early, only the frames up to the one reaching the target number of missed transport
+/// blocks or the target accuracy of the BLER are counted. The results are thus independent of the number of workers.
+class MexFunction : public srsran_mex_dispatcher
+{
+public:
+  /// \brief Constructor.
+  ///
+  /// Stores the string identifier&ndash;method pairs that form the public interface of the PUSCH BLER engine MEX
+  /// object.
+  MexFunction()
+  {
+    create_callback("new", [this](ArgumentList out, ArgumentList in) { this->method_new(out, in); });
+    create_callback("step", [this](ArgumentList out, ArgumentList in) { this->method_step(out, in); });
+  }
+
+private:
+  /// \brief Sets the number of workers.
+  ///
+  /// The method takes two inputs.
+  ///   - The string <tt>"new"</tt>.
+  ///   - The number of worker threads (set it to zero to use as many workers as hardware threads).
+  ///
+  /// The method has no output.
+  void method_new(ArgumentList outputs, ArgumentList inputs);
+
+  /// Checks that outputs/inputs arguments match the requirements of method_step().
+  void check_step_outputs_inputs(ArgumentList outputs, ArgumentList inputs);
+
+  /// Reads the link and channel configuration from a MATLAB structure (see method_step()).
+  pusch_bler_config read_config(const matlab::data::Struct& in_cfg);
+
+  /// \brief Simulates the PUSCH link for a list of SNR values.
+  ///
+  /// The method takes six inputs.
+  ///   - The string <tt>"step"</tt>.
+  ///   - A one-dimensional structure that describes the link. The fields are
+  ///      - \c NSizeGrid, number of resource blocks of the resource grid;
+  ///      - \c SubcarrierSpacing, subcarrier spacing in kHz;
+  ///      - \c CyclicPrefix, cyclic prefix (<tt>"normal"</tt> or <tt>"extended"</tt>);
+  ///      - \c Nfft, DFT size of the OFDM modulator;
+  ///      - \c SlotsPerFrame, number of slots in a frame;
+  ///      - \c RNTI, radio network temporary identifier;
+  ///      - \c NID, scrambling identifier;
+  ///      - \c RBMask, allocation RB list (as a boolean mask, contiguous allocation is assumed);
+  ///      - \c StartSymbolIndex, start symbol index of the time domain allocation within a slot;
+  ///      - \c NumSymbols, number of symbols of the time domain allocation within a slot;
+  ///      - \c DMRSSymbPos, boolean mask flagging the OFDM symbols containing DM-RS;
+  ///      - \c DMRSConfigType, DM-RS configuration type;
+  ///      - \c NumCDMGroupsWithoutData, number of DM-RS CDM groups without data;
+  ///      - \c NIDNSCID, DM-RS scrambling identifier;
+  ///      - \c NSCID, DM-RS scrambling initialization;
+  ///      - \c DMRSAmplitude, linear amplitude of the DM-RS with respect to the data;
+  ///      - \c NumLayers, number of transmission layers;
+  ///      - \c Modulation, modulation scheme used for transmission;
+  ///      - \c BGN, the LDPC base graph;
+  ///      - \c TransportBlockLength, the transport block size;
+  ///      - \c NumCodeblocks, the number of codeblocks forming the codeword;
+  ///      - \c MaxCodeblockSize, the maximum codeblock length;
+  ///      - \c SoftbitWidth, number of bits of the soft bits stored in the softbuffers (8, 6 or 4);
+  ///      - \c LimitedBufferSize, limited buffer rate matching length (set to zero for unlimited buffer);
+  ///      - \c MaximumLDPCIterationCount, the maximum number of LDPC decoding iterations;
+  ///      - \c RVSequence, the redundancy version sequence of the HARQ processes;
+  ///      - \c NumHARQProcesses, the number of HARQ processes;
+  ///      - \c NumTxAnts, number of transmit antennas;
+  ///      - \c NumRxAnts, number of receive antennas;
+  ///      - \c DelayProfile, delay profile (<tt>"custom"</tt> or any of the TDL profiles of srsFadingChannel);
+  ///      - \c PathDelays, path delays in seconds (<tt>"custom"</tt> profile only);
+  ///      - \c AveragePathGains, average path gains in dB (<tt>"custom"</tt> profile only);
+  ///      - \c DelaySpread, delay spread in seconds (TDL-A, TDL-B and TDL-C profiles only);
+  ///      - \c MaximumDopplerShift, maximum Doppler shift in hertz;
+  ///      - \c SlotIndependentFading, \c true for a new fading realization in every slot;
+  ///      - \c CarrierFrequencyOffset, carrier frequency offset in hertz;
+  ///      - \c Smoothing, frequency-domain smoothing strategy of the channel estimator (<tt>"filter"</tt>,
+  ///        <tt>"mean"</tt> or <tt>"none"</tt>);
+  ///      - \c Interpolation, time-domain interpolation strategy of the channel estimator (<tt>"interpolate"</tt>
+  ///        or <tt>"average"</tt>);
+  ///      - \c CompensateCFO, \c true to compensate the CFO in the channel estimator;
+  ///      - \c EqualizerType, equalizer algorithm (<tt>"ZF"</tt> or <tt>"MMSE"</tt>);
+  ///      - \c Seed, seed of all the random processes.
+  ///   - An array of SNR values in dB. The SNR is the ratio between the energy per resource element of the data and
+  ///     the noise energy per resource element at each receive antenna, as in PUSCHBLER.
+  ///   - The number of frames to simulate for each SNR value.
+  ///   - The maximum number of missed transport blocks for each SNR value (set it to zero for no limit).
+  ///   - A one-dimensional structure that describes the confidence-based stopping criterion. A point stops at the frame
+  ///     where the width of the confidence interval of its BLER does not exceed the largest of the two targets. The
+  ///     fields are
+  ///      - \c ConfidenceLevel, confidence level of the two-sided confidence interval, in (0, 1);
+  ///      - \c IntervalType, method for computing the confidence interval (<tt>"Wilson"</tt> or
+  ///        <tt>"Clopper-Pearson"</tt>);
+  ///      - \c TargetWidth, target absolute width of the confidence interval (zero for no absolute target);
+  ///      - \c TargetRelativeWidth, target width of the confidence interval relative to the BLER (zero for no
+  ///        relative target).
+  ///
+  /// All frames of an SNR point are simulated when neither the maximum number of missed transport blocks nor the
+  /// stopping criterion stops it.
+  ///
+  /// The method has one single output.
+  ///   - A structure array with one entry for each SNR value. The fields are
+  ///      - \c NumFrames, number of simulated frames;
+  ///      - \c NumSlots, number of simulated slots, including those completing the retransmissions after a frame;
+  ///      - \c MaxThroughput, number of transmitted bits;
+  ///      - \c Throughput, number of correctly received bits;
+  ///      - \c TotalBlocks, number of transport blocks (counted when received or after all retransmissions);
+  ///      - \c MissedBlocks, number of transport blocks missed after all allowed retransmissions;
+  ///      - \c DecIterations, sum of the average LDPC iterations of all transmissions;
+  ///      - \c DecIterationsCRCOK, sum of the average LDPC iterations of the transmissions with a valid CRC;
+  ///      - \c RSRP, sum of the RSRP estimated in every slot;
+  ///      - \c NoiseVar, sum of the noise variance estimated in every slot.
+  void method_step(ArgumentList outputs, ArgumentList inputs);
+
+  /// Number of workers.
+  unsigned nof_workers = srsran_matlab::default_nof_workers();
+};
+
+inline pusch_link_factories create_pusch_link_factories(srsran::channel_equalizer_algorithm_type equalizer)
+{
+  using namespace srsran;
+
+  std::shared_ptr<crc_calculator_factory> crc_factory = create_crc_calculator_factory_sw("auto");
+
+  std::shared_ptr<ldpc_encoder_factory> ldpc_encoder_factory = create_ldpc_encoder_factory_sw("auto");
+
+  std::shared_ptr<ldpc_rate_matcher_factory> ldpc_rate_matcher_factory = create_ldpc_rate_matcher_factory_sw();
+
+  std::shared_ptr<ldpc_segmenter_tx_factory> segmenter_tx_factory = create_ldpc_segmenter_tx_factory_sw(crc_factory);
+
+  pdsch_encoder_factory_sw_configuration encoder_config;
+  encoder_config.encoder_factory      = ldpc_encoder_factory;
+  encoder_config.rate_matcher_factory = ldpc_rate_matcher_factory;
+  encoder_config.segmenter_factory    = segmenter_tx_factory;
+
+  std::shared_ptr<modulation_mapper_factory> mapper_factory = create_modulation_mapper_factory();
+
+  std::shared_ptr<pseudo_random_generator_factory> prg_factory = create_pseudo_random_generator_sw_factory();
+
+  std::shared_ptr<channel_precoder_factory> precoder_factory = create_channel_precoder_factory("auto");
+
+  std::shared_ptr<resource_grid_mapper_factory> rg_mapper_factory =
+      create_resource_grid_mapper_factory(precoder_factory);
+
+  std::shared_ptr<dft_processor_factory> dft_factory = create_dft_processor_factory_fftw_slow();
+
+  std::shared_ptr<time_alignment_estimator_factory> ta_est_factory =
+      create_time_alignment_estimator_dft_factory(dft_factory);
+
+  std::shared_ptr<transform_precoder_factory> transform_precod_factory =
+      create_dft_transform_precoder_factory(dft_factory, MAX_RB);
+
+  std::shared_ptr<channel_equalizer_factory> equalizer_factory = create_channel_equalizer_generic_factory(equalizer);
+
+  std::shared_ptr<demodulation_mapper_factory> demod_factory = create_demodulation_mapper_factory();
+
+  std::shared_ptr<ldpc_decoder_factory> ldpc_decoder_factory = create_ldpc_decoder_factory_sw("auto");
+
+  std::shared_ptr<ldpc_rate_dematcher_factory> ldpc_rate_dematcher_factory =
+      create_ldpc_rate_dematcher_factory_sw("auto");
+
+  std::shared_ptr<ldpc_segmenter_rx_factory> segmenter_rx_factory = create_ldpc_segmenter_rx_factory_sw();
+
+  pusch_decoder_factory_sw_configuration decoder_config;
+  decoder_config.crc_factory       = crc_factory;
+  decoder_config.decoder_factory   = ldpc_decoder_factory;
+  decoder_config.dematcher_factory = ldpc_rate_dematcher_factory;
+  decoder_config.segmenter_factory = segmenter_rx_factory;
+  decoder_config.nof_prb           = MAX_RB;
+  decoder_config.nof_layers        = pusch_constants::MAX_NOF_LAYERS;
+
+  pusch_link_factories factories;
+  factories.encoder   = create_pdsch_encoder_factory_sw(encoder_config);
+  factories.modulator = create_pdsch_modulator_factory_sw(mapper_factory, prg_factory, rg_mapper_factory);
+  factories.dmrs      = create_dmrs_pdsch_processor_factory_sw(prg_factory, rg_mapper_factory);
+  factories.dft       = dft_factory;
+  factories.estimator = create_port_channel_estimator_factory_sw(ta_est_factory);
+  factories.demodulator = create_pusch_demodulator_factory_sw(
+      equalizer_factory, transform_precod_factory, demod_factory, nullptr, prg_factory, MAX_RB);
+  factories.decoder = create_pusch_decoder_factory_sw(decoder_config);
+
+  return factories;
+}
@@ -0,0 +1,124 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Random stream MEX definition.
+
+#include "random_stream_mex.h"
+#include "srsran_matlab/support/random_stream.h"
+#include <algorithm>
+#include <array>
+
+using matlab::mex::ArgumentList;
+using namespace matlab::data;
+using namespace srsran_matlab;
+
+void MexFunction::method_block(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 3;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::UINT32) || (inputs[1].getNumberOfElements() != random_stream::BLOCK_WORDS)) {
+    mex_abort("Input 'counter' should be an array of {} uint32_t.", random_stream::BLOCK_WORDS);
+  }
+
+  if ((inputs[2].getType() != ArrayType::UINT32) || (inputs[2].getNumberOfElements() != 2)) {
+    mex_abort("Input 'key' should be an array of 2 uint32_t.");
+  }
+
+  if (outputs.size() != 1) {
+    mex_abort("Wrong number of outputs: expected 1, provided {}.", outputs.size());
+  }
+
+  const TypedArray<uint32_t>                       in_counter = inputs[1];
+  const TypedArray<uint32_t>                       in_key     = inputs[2];
+  std::array<uint32_t, random_stream::BLOCK_WORDS> counter;
+  std::copy(in_counter.begin(), in_counter.end(), counter.begin());
+  std::array<uint32_t, 2> key = {in_key[0], in_key[1]};
+
+  std::array<uint32_t, random_stream::BLOCK_WORDS> block = random_stream::compute_block(counter, key);
+
+  outputs[0] =
+      factory.createArray<uint32_t>({1, random_stream::BLOCK_WORDS}, block.data(), block.data() + block.size());
+}
+
+void MexFunction::method_stream(ArgumentList outputs, ArgumentList inputs)
+{
+  constexpr unsigned NOF_INPUTS = 3;
+  if (inputs.size() != NOF_INPUTS) {
+    mex_abort("Wrong number of inputs: expected {}, provided {}.", NOF_INPUTS, inputs.size());
+  }
+
+  if ((inputs[1].getType() != ArrayType::UINT64) || (inputs[1].getNumberOfElements() != 6)) {
+    mex_abort("Input 'streamID' should be an array of 6 uint64_t.");
+  }
+
+  if ((inputs[2].getType() != ArrayType::DOUBLE) || (inputs[2].getNumberOfElements() != 1) ||
+      (static_cast<TypedArray<double>>(inputs[2])[0] < 0)) {
+    mex_abort("Input 'nofWords' should be a nonnegative scalar double.");
+  }
+
+  if (outputs.size() != 1) {
+    mex_abort("Wrong number of outputs: expected 1, provided {}.", outputs.size());
+  }
+
+  const TypedArray<uint64_t> in_id = inputs[1];
+  if (in_id[1] >= random_stream_id::MAX_SNR_INDEX) {
+    mex_abort("SNR index {} out of range, should be lower than {}.",
+              static_cast<uint64_t>(in_id[1]),
+              random_stream_id::MAX_SNR_INDEX);
+  }
+  if (in_id[2] >= random_stream_id::MAX_ITEM) {
+    mex_abort("Item index {} out of range, should be lower than {}.",
+              static_cast<uint64_t>(in_id[2]),
+              random_stream_id::MAX_ITEM);
+  }
+  if (in_id[3] >= random_stream_id::MAX_SLOT) {
+    mex_abort("Slot index {} out of range, should be lower than {}.",
+              static_cast<uint64_t>(in_id[3]),
+              random_stream_id::MAX_SLOT);
+  }
+  if (in_id[4] > static_cast<uint64_t>(random_purpose::noise)) {
+    mex_abort("Unknown random purpose {}.", static_cast<uint64_t>(in_id[4]));
+  }
+  if (in_id[5] >= random_stream_id::MAX_SUBSTREAM) {
+    mex_abort("Substream index {} out of range, should be lower than {}.",
+              static_cast<uint64_t>(in_id[5]),
+              random_stream_id::MAX_SUBSTREAM);
+  }
+
+  random_stream_id id;
+  id.seed      = in_id[0];
+  id.snr_index = static_cast<unsigned>(in_id[1]);
+  id.item      = in_id[2];
+  id.slot      = static_cast<unsigned>(in_id[3]);
+  id.purpose   = static_cast<random_purpose>(in_id[4]);
+  id.substream = static_cast<unsigned>(in_id[5]);
+
+  std::size_t          nof_words = static_cast<std::size_t>(static_cast<TypedArray<double>>(inputs[2])[0]);
+  random_stream        stream(id);
+  TypedArray<uint64_t> words = factory.createArray<uint64_t>({nof_words, 1});
+  for (std::size_t i_word = 0; i_word != nof_words; ++i_word) {
+    words[i_word] = stream();
+  }
+
+  outputs[0] = words;
+}
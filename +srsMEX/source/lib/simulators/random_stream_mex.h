@@ -0,0 +1,63 @@
+/*
+ *
+ * Copyright 2021-2025 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN-matlab.
+ *
+ * srsRAN-matlab is free software: you can redistribute it and/or
+ * modify it under the terms of the BSD 2-Clause License.
+ *
+ * srsRAN-matlab is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * BSD 2-Clause License for more details.
+ *
+ * A copy of the BSD 2-Clause License can be found in the LICENSE
+ * file in the top-level directory of this distribution.
+ *
+ */
+
+/// \file
+/// \brief Random stream MEX declaration.
+
+#pragma once
+
+#include "srsran_matlab/srsran_mex_dispatcher.h"
+
+/// \brief Exposes the counter-based random streams of the simulation engines following the srsran_mex_dispatcher
+/// template.
+///
+/// The MEX has no state: it is meant for checking the generator (see srsran_matlab::random_stream) against its
+/// known-answer vectors and for inspecting the streams of a simulation from MATLAB.
+class MexFunction : public srsran_mex_dispatcher
+{
+public:
+  /// Constructor: stores the string identifier&ndash;method pairs that form the public interface of the MEX object.
+  MexFunction()
+  {
+    create_callback("block", [this](ArgumentList out, ArgumentList in) { this->method_block(out, in); });
+    create_callback("stream", [this](ArgumentList out, ArgumentList in) { this->method_stream(out, in); });
+  }
+
+private:
+  /// \brief Computes a block of the Philox4x32-10 function.
+  ///
+  /// The method takes three inputs.
+  ///   - The string <tt>"block"</tt>.
+  ///   - The counter, an array of four \c uint32_t numbers, least significant word first.
+  ///   - The key, an array of two \c uint32_t numbers, least significant word first.
+  ///
+  /// The only output is a row of four \c uint32_t numbers with the block.
+  void method_block(ArgumentList outputs, ArgumentList inputs);
+
+  /// \brief Generates the first words of a random stream.
+  ///
+  /// The method takes three inputs.
+  ///   - The string <tt>"stream"</tt>.
+  ///   - The stream identifier, an array of six \c uint64_t numbers with the seed, the SNR index, the item index, the
+  ///     slot index, the purpose and the substream index (see srsran_matlab::random_stream_id).
+  ///   - The number of words to generate (a scalar double).
+  ///
+  /// The only output is a column of \c uint64_t numbers with the words of the stream.
+  void method_stream(ArgumentList outputs, ArgumentList inputs);
+};
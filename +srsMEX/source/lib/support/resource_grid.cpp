@@ -24,6 +24,7 @@
 #include "srsran_matlab/support/factory_functions.h"
 #include "srsran_matlab/support/to_span.h"
 #include "srsran/phy/support/resource_grid_writer.h"
+#include "srsran/srsvec/conversion.h"
 
 using namespace matlab::data;
 using namespace srsran;
@@ -59,3 +60,24 @@ std::unique_ptr<resource_grid> srsran_matlab::read_resource_grid(const TypedArra
 
   return grid;
 }
+
+void srsran_matlab::write_resource_grid(TypedArray<srsran::cf_t>& out_grid, const resource_grid_reader& in_grid)
+{
+  const ArrayDimensions grid_dims       = out_grid.getDimensions();
+  unsigned              nof_subcarriers = grid_dims[0];
+  unsigned              nof_symbols     = grid_dims[1];
+  unsigned              nof_ports       = 1;
+  if (grid_dims.size() == 3) {
+    nof_ports = grid_dims[2];
+  }
+
+  span<cf_t> grid_view = to_span(out_grid);
+
+  for (unsigned i_port = 0; i_port != nof_ports; ++i_port) {
+    for (unsigned i_symbol = 0; i_symbol != nof_symbols; ++i_symbol) {
+      span<const cbf16_t> symbol_view = in_grid.get_view(i_port, i_symbol).first(nof_subcarriers);
+      srsvec::convert(grid_view.first(nof_subcarriers), symbol_view);
+      grid_view = grid_view.last(grid_view.size() - nof_subcarriers);
+    }
+  }
+}
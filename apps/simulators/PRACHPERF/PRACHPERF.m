@@ -58,6 +58,7 @@
 %   NCS                     - Cyclic shift width.
 %   PUSCHSubcarrierSpacing  - PUSCH subcarrier spacing in kHz (15, 30, 120).
 %   DelayProfile            - Channel delay profile ('AWGN', 'TDLC300').
+%   ChannelModelType        - Implementation of the fading channel ('MEX', 'noMEX', TDLC300 only).
 %   NumReceiveAntennas      - Number of receive antennas.
 %   FrequencyOffset         - Frequency offset in Hz.
 %   TimeErrorTolerance      - Time error tolerance in microseconds.
@@ -67,6 +68,13 @@
 %   DetectionThreshold      - Custom detection threshold (NaN for default or positive value,
 %                             only for ImplementationType 'matlab').
 %   ImplementationType      - PRACH detector implementation type('matlab', 'srs'). Default is 'matlab'.
+%                             With 'srs', the preamble sequence is also generated by srsRAN.
+%   SimulationEngineType    - Implementation of the simulation loop ('MEX', 'noMEX'). With 'MEX',
+%                             the whole link is simulated by the native multi-threaded
+%                             srsPRACHPERFEngine (requires ImplementationType 'srs').
+%   NumThreads              - Number of worker threads of the native simulation engine (0 for as
+%                             many as hardware threads).
+%   Seed                    - Seed of the random streams of the native simulation engine.
 %   QuickSimulation         - Quick-simulation flag: set to true to stop each point
 %                             after 100 failures (tunable).
 %
@@ -122,6 +130,10 @@ classdef PRACHPERF < matlab.System
         %Channel delay profile ('AWGN', 'TDLC300').
         %   Default is 'AWGN'.
         DelayProfile (1, :) char {mustBeMember(DelayProfile, {'AWGN', 'TDLC300'})} = 'AWGN'
+        %Implementation of the fading channel ('MEX', 'noMEX', TDLC300 only).
+        %   Set to 'MEX' for using the native srsFadingChannel instead of nrTDLChannel.
+        %   Default is 'noMEX'.
+        ChannelModelType (1, :) char {mustBeMember(ChannelModelType, {'MEX', 'noMEX'})} = 'noMEX'
         %Number of receive antennas.
         %   Default is 2.
         NumReceiveAntennas (1, 1) double {mustBeInteger, mustBePositive, mustBeFinite} = 2
@@ -143,7 +155,18 @@ classdef PRACHPERF < matlab.System
         DetectionThreshold (1, 1) double = NaN
         %PRACH detector implementation type('matlab', 'srs'). Default is 'matlab'.
         %   Both implementations refer to the same algorithm, but the 'srs' one runs the MEX version.
+        %   With 'srs', the preamble sequence is also generated by the srsPRACHGenerator MEX.
         ImplementationType (1, :) char {mustBeMember(ImplementationType, {'matlab', 'srs'})} = 'matlab'
+        %Implementation of the simulation loop ('MEX', 'noMEX').
+        %   Set to 'MEX' for simulating the whole link (channel and receiver) with the native
+        %   multi-threaded srsPRACHPERFEngine. Requires ImplementationType set to 'srs'.
+        SimulationEngineType (1, :) char {mustBeMember(SimulationEngineType, {'MEX', 'noMEX'})} = 'noMEX'
+        %Number of worker threads of the native simulation engine (0 for as many as hardware threads).
+        NumThreads (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
+        %Seed of the random streams of the native simulation engine.
+        %   The fading and the noise of each occasion and SNR point are drawn from streams
+        %   identified by the seed: the same seed gives the same realization.
+        Seed (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
     end
 
     properties (Access = private, Hidden)
@@ -155,6 +178,8 @@ classdef PRACHPERF < matlab.System
         PRACH
         %Channel system object.
         Channel
+        %Native simulation engine.
+        Engine
 
         %Counter for the mean time offset estimation error.
         TimingAvg;
@@ -233,6 +258,117 @@ classdef PRACHPERF < matlab.System
                     'Format %s is not valid in FR2.', obj.Format);
             end
         end % of function checkSCSandFormat(obj)
+
+        function checkSimulationEngine(obj)
+            if (strcmp(obj.SimulationEngineType, 'MEX') && ~strcmp(obj.ImplementationType, 'srs'))
+                error('The native simulation engine requires ImplementationType ''srs''.');
+            end
+        end
+
+        function [waveform, gridset, winfo] = generateWaveform(obj)
+        %Generates the transmitted PRACH waveform, with the same outputs as srsPRACHgenerator.
+        %   The waveform does not change between occasions. With ImplementationType 'srs',
+        %   the frequency-domain sequence is provided by the srsPRACHGenerator MEX and only
+        %   the resource mapping and the OFDM modulation are carried out in MATLAB.
+            carrier = obj.Carrier;
+            prach = obj.PRACH;
+            prach.NPRACHSlot = 0;
+
+            if ~strcmp(obj.ImplementationType, 'srs')
+                [waveform, gridset, winfo] = srsLib.phy.upper.channel_processors.srsPRACHgenerator(carrier, prach);
+                return;
+            end
+
+            % Look for the first active PRACH slot, as srsPRACHgenerator does.
+            [prachIndices, prachInfoInd] = nrPRACHIndices(carrier, prach);
+            while isempty(prachIndices)
+                prach.NPRACHSlot = prach.NPRACHSlot + 1;
+                [prachIndices, prachInfoInd] = nrPRACHIndices(carrier, prach);
+            end
+
+            % The sequence is repeated over all the PRACH OFDM symbols.
+            prachGenerator = srsMEX.phy.srsPRACHGenerator;
+            prachSymbols = repmat(prachGenerator(prach), numel(prachIndices) / prach.LRA, 1);
+            prachGrid = nrPRACHGrid(carrier, prach);
+            prachGrid(prachIndices) = prachSymbols;
+
+            winfo = struct();
+            winfo.NPRACHSlot = prach.NPRACHSlot;
+            winfo.PRACHSymbols = prachSymbols;
+            winfo.PRACHSymbolsInfo = struct('NumCyclicShifts', obj.NCS);
+            winfo.PRACHIndices = prachIndices;
+            winfo.PRACHIndicesInfo = prachInfoInd;
+
+            [waveform, prachOFDMInfo] = nrPRACHOFDMModulate(carrier, prach, prachGrid, 'Windowing', 0);
+
+            % We are only interested in the PRACH waveform itself, not in a possible offset.
+            if prachOFDMInfo.OffsetLength > 0
+                waveform = waveform(prachOFDMInfo.OffsetLength+1:end);
+                prachOFDMInfo.OffsetLength = 0;
+            end
+
+            gridset.Info = prachOFDMInfo;
+            gridset.ResourceGrid = prachGrid;
+        end % of function [waveform, gridset, winfo] = generateWaveform(obj)
+
+        function counters = runEngine(obj, SNRdB, nPRACHOccasions)
+        %Simulates all SNR points with the native simulation engine.
+        %   srsRAN does not provide a time-domain PRACH modulator, so the transmitted
+        %   waveform is generated here once and for all, and the engine applies the
+        %   same timing offsets as the MATLAB simulation loop.
+            carrier = obj.Carrier;
+            prach = obj.PRACH;
+            [waveform, ~, winfo] = obj.generateWaveform();
+
+            % Timing offsets in microseconds, as in the MATLAB simulation loop.
+            if (prach.LRA == 839)
+                baseOffset = ((winfo.PRACHSymbolsInfo.NumCyclicShifts/2)/prach.LRA)/prach.SubcarrierSpacing*1e3;
+                timingOffsets = baseOffset + (0:9)/10;
+            else
+                timingOffsets = (0:8)/10;
+            end
+
+            % Same demodulator and detector configuration as the srsPRACHDemodulator MEX.
+            prachRx = prach;
+            prachRx.PreambleIndex = 0;
+            prachRx.NPRACHSlot = winfo.NPRACHSlot;
+            [engineConfig, detectorConfig] = srsMEX.phy.srsPRACHDemodulator.getMEXConfig(carrier, prachRx, 1);
+            for fieldName = string(fieldnames(detectorConfig).')
+                engineConfig.(fieldName) = detectorConfig.(fieldName);
+            end
+
+            % The waveform has the sampling rate of the carrier, as in the MATLAB simulation loop.
+            engineConfig.SampleRate = obj.OFDMInfo.SampleRate;
+            engineConfig.Nfft = obj.OFDMInfo.Nfft;
+            engineConfig.PreambleIndex = prach.PreambleIndex;
+            engineConfig.NRxPorts = obj.NumReceiveAntennas;
+            engineConfig.TimingOffsets = timingOffsets;
+            engineConfig.TimeErrorTolerance = obj.TimeErrorTolerance;
+            engineConfig.DelayProfile = obj.DelayProfile;
+            engineConfig.DelaySpread = 0;
+            engineConfig.MaximumDopplerShift = 100.0;
+            engineConfig.FrequencyOffset = obj.FrequencyOffset;
+            engineConfig.DetectionTest = obj.isDetectionTest;
+            engineConfig.Seed = obj.Seed;
+
+            % To speed the simulation up, the engine stops each point after 100 failures.
+            % The srsRAN default detection threshold is used and no timing error histogram is needed.
+            counters = obj.Engine(engineConfig, waveform, SNRdB, nPRACHOccasions, 100 * obj.QuickSimulation, 1, []);
+        end % of function counters = runEngine(obj, SNRdB, nPRACHOccasions)
+
+        function exportResults(obj, SNRdB, occasionCount, detectedCount, detectedPerfCount, meanOffsetError, varOffsetError)
+        %Merges the counters of the simulated SNR points with the previous ones.
+            [~, repeatedIdx] = intersect(obj.SNRrange, SNRdB);
+            obj.SNRrange(repeatedIdx) = [];
+            [obj.SNRrange, sortedIdx] = sort([obj.SNRrange SNRdB]);
+
+            obj.Occasions = joinArrays(obj.Occasions, occasionCount, repeatedIdx, sortedIdx);
+            obj.Detected = joinArrays(obj.Detected, detectedCount, repeatedIdx, sortedIdx);
+            obj.DetectedPerfect = joinArrays(obj.DetectedPerfect, detectedPerfCount, ...
+                repeatedIdx, sortedIdx);
+            obj.TimingAvg = joinArrays(obj.TimingAvg, meanOffsetError, repeatedIdx, sortedIdx);
+            obj.TimingVar = joinArrays(obj.TimingVar, varOffsetError, repeatedIdx, sortedIdx);
+        end % of function exportResults(...)
     end % of methods (Access = private)
 
     methods (Access = protected)
@@ -301,27 +437,38 @@ classdef PRACHPERF < matlab.System
                 obj.Channel.NumReceiveAntennas = obj.NumReceiveAntennas;
                 obj.Channel.SampleRate = obj.OFDMInfo.SampleRate; % Input signal sample rate in Hz
             else
-                obj.Channel = nrTDLChannel;
+                if strcmp(obj.ChannelModelType, 'MEX')
+                    % Native TDL channel, with uplink antenna correlation. It always uses its
+                    % own random streams: see the reseeding in stepImpl.
+                    obj.Channel = srsMEX.channel.srsFadingChannel;
+                else
+                    obj.Channel = nrTDLChannel;
+                    obj.Channel.TransmissionDirection = "Uplink"; % Uplink transmission
+                    % Global stream for a block fading model (each transmission undergoes
+                    % a different channel IR).
+                    obj.Channel.RandomStream = 'Global stream';
+                end
                 obj.Channel.DelayProfile = obj.DelayProfile;      % Delay profile
                 obj.Channel.MaximumDopplerShift = 100.0;          % Maximum Doppler shift in Hz
                 obj.Channel.SampleRate = obj.OFDMInfo.SampleRate; % Input signal sample rate in Hz
                 obj.Channel.MIMOCorrelation = "Low";              % MIMO correlation
-                obj.Channel.TransmissionDirection = "Uplink";     % Uplink transmission
                 obj.Channel.NumReceiveAntennas = obj.NumReceiveAntennas;
                                                                   % Number of receive antennas
                 obj.Channel.NormalizePathGains = true;            % Normalize delay profile power
-                % Global stream for a block fading model (each transmission undergoes
-                % a different channel IR).
-                obj.Channel.RandomStream = 'Global stream';
                 obj.Channel.NormalizeChannelOutputs = true;       % Normalize for receive antennas
             end
 
+            if strcmp(obj.SimulationEngineType, 'MEX')
+                obj.Engine = srsMEX.simulators.srsPRACHPERFEngine('NumThreads', obj.NumThreads);
+            end
+
         end % of function setupImpl(obj)
 
         function validatePropertiesImpl(obj)
             checkSeqIndexandFormat(obj);
             checkNCSandFormat(obj);
             checkSCSandFormat(obj);
+            checkSimulationEngine(obj);
         end
 
         function stepImpl(obj, SNRdB, nPRACHOccasions)
@@ -337,6 +484,28 @@ classdef PRACHPERF < matlab.System
             SNRdB = unique(SNRdB);
             SNRdB = SNRdB(:).';
 
+            % The native simulation engine runs the entire simulation loop.
+            if strcmp(obj.SimulationEngineType, 'MEX')
+                timeNow = char(datetime('now','Format','HH:mm:ss'));
+                fprintf([timeNow ': Simulating SNR = [%s] dB with the native engine...\n'], num2str(SNRdB));
+                counters = obj.runEngine(SNRdB, nPRACHOccasions);
+                occasionCount = [counters.NumOccasions].';
+                detectedCount = [counters.Detected].';
+                detectedPerfCount = [counters.DetectedPerfect].';
+                meanOffsetError = [counters.TimingErrorSum].';
+                varOffsetError = [counters.TimingErrorSqSum].';
+
+                for snrIdx = 1:numel(SNRdB)
+                    % Same alignment as the messages of the MATLAB simulation loop.
+                    fprintf('%-39s', sprintf('Results for SNR = %+5.1f dB: ', SNRdB(snrIdx)));
+                    printResults(obj.isDetectionTest, occasionCount(snrIdx), detectedCount(snrIdx), ...
+                        detectedPerfCount(snrIdx), meanOffsetError(snrIdx), varOffsetError(snrIdx));
+                end
+
+                obj.exportResults(SNRdB, occasionCount, detectedCount, detectedPerfCount, meanOffsetError, varOffsetError);
+                return;
+            end
+
             foffset = obj.FrequencyOffset;                 % Frequency offset in Hz.
             timeErrorTolerance = obj.TimeErrorTolerance;   % Time error tolerance in microseconds.
 
@@ -358,11 +527,15 @@ classdef PRACHPERF < matlab.System
 
             % Get the channel characteristic information.
             channelInfo = info(channel);
+            useMEXChannel = isa(channel, 'srsMEX.channel.srsFadingChannel');
 
             % Implementation flag.
             useMEX = strcmp(obj.ImplementationType, 'srs');
             prachDetectorMex = srsMEX.phy.srsPRACHDetector;
 
+            % The transmitted PRACH waveform is the same for all occasions.
+            [waveform, gridset, winfo] = obj.generateWaveform();
+
             for snrIdx = 1:numel(SNRdB)
 
                 % Display progress in the command window.
@@ -385,12 +558,13 @@ classdef PRACHPERF < matlab.System
 
                     % Reset the channel before each transmission, to obtain a
                     % different realization (since we don't use an internal generator).
-                    reset(channel);
-
-                    % Generate PRACH waveform for the current occasion.
-                    prach.NPRACHSlot = 0;
-
-                    [waveform, gridset, winfo] = srsLib.phy.upper.channel_processors.srsPRACHgenerator(carrier, prach);
+                    % The native channel draws the realization from its own random
+                    % stream, identified by the SNR point and the occasion.
+                    if useMEXChannel
+                        reseed(channel, channel.Seed, snrIdx - 1, iOccasion - 1, 0);
+                    else
+                        reset(channel);
+                    end
 
                     % Set PRACH timing offset in microseconds as per TS 38.141-1 Figure 8.4.1.4.2-2
                     % and Figure 8.4.1.4.2-3.
@@ -491,36 +665,13 @@ classdef PRACHPERF < matlab.System
 
                 occasionCount(snrIdx) = iOccasion;
 
-                if isDetectTest
-                    % Display the detection probability for this SNR.
-                    fprintf('Detection probability (ignoring time error):        %.2f%%\n', ...
-                        detectedCount(snrIdx)/iOccasion*100);
-                    fprintf('                                       ');
-                    fprintf('Detection probability (time error below tolerance): %.2f%%\n', ...
-                        detectedPerfCount(snrIdx)/iOccasion*100);
-                    meanErr = meanOffsetError(snrIdx) / iOccasion;
-                    stdErr = sqrt((varOffsetError(snrIdx) - meanErr^2) / max(1, iOccasion-1));
-                    fprintf('                                       ');
-                    fprintf('Time error:                                         %.2g +/- %.2g\n', ...
-                        meanErr, stdErr);
-                else
-                    % Display the false alarm probability for this SNR.
-                    fprintf('False-alarm probability: %.2f%%\n', detectedCount(snrIdx)/iOccasion*100);
-                end
+                printResults(isDetectTest, iOccasion, detectedCount(snrIdx), detectedPerfCount(snrIdx), ...
+                    meanOffsetError(snrIdx), varOffsetError(snrIdx));
 
             end % of SNR loop
 
             % Export results.
-            [~, repeatedIdx] = intersect(obj.SNRrange, SNRdB);
-            obj.SNRrange(repeatedIdx) = [];
-            [obj.SNRrange, sortedIdx] = sort([obj.SNRrange SNRdB]);
-
-            obj.Occasions = joinArrays(obj.Occasions, occasionCount, repeatedIdx, sortedIdx);
-            obj.Detected = joinArrays(obj.Detected, detectedCount, repeatedIdx, sortedIdx);
-            obj.DetectedPerfect = joinArrays(obj.DetectedPerfect, detectedPerfCount, ...
-                repeatedIdx, sortedIdx);
-            obj.TimingAvg = joinArrays(obj.TimingAvg, meanOffsetError, repeatedIdx, sortedIdx);
-            obj.TimingVar = joinArrays(obj.TimingVar, varOffsetError, repeatedIdx, sortedIdx);
+            obj.exportResults(SNRdB, occasionCount, detectedCount, detectedPerfCount, meanOffsetError, varOffsetError);
         end % of function setupImpl(obj)
 
         function flag = isInactivePropertyImpl(obj, property)
@@ -535,6 +686,10 @@ classdef PRACHPERF < matlab.System
                     flag = isempty(obj.Detected) || obj.isDetectionTest || ~obj.isLocked;
                 case 'OffsetError'
                     flag = isempty(obj.TimingAvg) || ~obj.isDetectionTest || ~obj.isLocked;
+                case {'NumThreads', 'Seed'}
+                    flag = ~strcmp(obj.SimulationEngineType, 'MEX');
+                case 'ChannelModelType'
+                    flag = strcmp(obj.DelayProfile, 'AWGN');
                 case {'DetectionThreshold', 'IgnoreCFO'}
                     flag = ~strcmp(obj.ImplementationType, 'matlab');
                 otherwise
@@ -578,6 +733,9 @@ classdef PRACHPERF < matlab.System
         function releaseImpl(obj)
             % Release internal system objects.
             release(obj.Channel);
+            if ~isempty(obj.Engine)
+                release(obj.Engine);
+            end
         end
 
         function s= saveObjectImpl(obj)
@@ -587,6 +745,9 @@ classdef PRACHPERF < matlab.System
             if isLocked(obj)
                 % Save child objects.
                 s.Channel = matlab.System.saveObject(obj.Channel);
+                if ~isempty(obj.Engine)
+                    s.Engine = matlab.System.saveObject(obj.Engine);
+                end
                 s.Carrier = obj.Carrier;
                 s.OFDMInfo = obj.OFDMInfo;
                 s.PRACH = obj.PRACH;
@@ -605,6 +766,9 @@ classdef PRACHPERF < matlab.System
             if wasInUse
                 % Load child objects.
                 obj.Channel = matlab.System.loadObject(s.Channel);
+                if isfield(s, 'Engine')
+                    obj.Engine = matlab.System.loadObject(s.Engine);
+                end
                 obj.Carrier = s.Carrier;
                 obj.OFDMInfo = s.OFDMInfo;
                 obj.PRACH = s.PRACH;
@@ -702,6 +866,25 @@ classdef PRACHPERF < matlab.System
 end % of classdef PRACHPERF < matlab.System
 
 % %% Local Functions
+function printResults(isDetectTest, nOccasions, detected, detectedPerf, meanOffsetError, varOffsetError)
+    if isDetectTest
+        % Display the detection probability for this SNR.
+        fprintf('Detection probability (ignoring time error):        %.2f%%\n', ...
+            detected/nOccasions*100);
+        fprintf('                                       ');
+        fprintf('Detection probability (time error below tolerance): %.2f%%\n', ...
+            detectedPerf/nOccasions*100);
+        meanErr = meanOffsetError / nOccasions;
+        stdErr = sqrt((varOffsetError - meanErr^2) / max(1, nOccasions-1));
+        fprintf('                                       ');
+        fprintf('Time error:                                         %.2g +/- %.2g\n', ...
+            meanErr, stdErr);
+    else
+        % Display the false alarm probability for this SNR.
+        fprintf('False-alarm probability: %.2f%%\n', detected/nOccasions*100);
+    end
+end
+
 function mixedArray = joinArrays(arrayA, arrayB, removeFromA, outputOrder)
     arrayA(removeFromA) = [];
     mixedArray = [arrayA; arrayB];
@@ -68,8 +68,24 @@
 %                                  'TDL-C'(rural scenario), 'TDLC300' (simplified rural scenario)).
 %   DelaySpread                  - Delay spread in seconds (TDL-C delay profile only).
 %   MaximumDopplerShift          - Maximum Doppler shift in hertz (TDL-C and TDLC300 delay profile only).
+%   ChannelModelType             - Implementation of the fading channel ('MEX', 'noMEX').
 %   ImplementationType           - PUCCH implementation type ('matlab', 'srs' or 'both').
 %   TestType                     - Test type ('Detection', 'False Alarm').
+%   SimulationEngineType         - Implementation of the simulation loop ('MEX', 'noMEX'). With 'MEX',
+%                                  the whole link is simulated by the native multi-threaded
+%                                  srsPUCCHPERFEngine (requires ImplementationType 'srs').
+%   NumThreads                   - Number of worker threads of the native simulation engine (0 for as
+%                                  many as hardware threads).
+%   ConfidenceLevel              - Confidence level of the error rate confidence interval of the native
+%                                  simulation engine.
+%   IntervalType                 - Method for computing the error rate confidence interval of the native
+%                                  simulation engine ('Wilson', 'Clopper-Pearson').
+%   TargetIntervalWidth          - Target absolute width of the error rate confidence interval: the native
+%                                  simulation engine stops a point as soon as it is met (0 for no target).
+%   TargetRelativeIntervalWidth  - Target width of the error rate confidence interval relative to the error
+%                                  rate: the native simulation engine stops a point as soon as it is met
+%                                  (0 for no target).
+%   Seed                         - Seed of the random streams of the native simulation engine.
 %   QuickSimulation              - Quick-simulation flag: set to true to stop
 %                                  each point after 100 errors (tunable).
 %
@@ -147,11 +163,38 @@ classdef PUCCHPERF < matlab.System
         DelaySpread (1, 1) double {mustBeReal, mustBeNonnegative} = 300e-9
         %Maximum Doppler shift in hertz (TDL-C and TDLC300 delay profile only).
         MaximumDopplerShift (1, 1) double {mustBeReal, mustBeNonnegative} = 100
+        %Implementation of the fading channel ('MEX', 'noMEX').
+        %   Set to 'MEX' for using the native srsFadingChannel instead of nrTDLChannel.
+        ChannelModelType (1, :) char {mustBeMember(ChannelModelType, {'MEX', 'noMEX'})} = 'noMEX'
         %PUCCH implementation type ('matlab', 'srs', 'both').
         ImplementationType (1, :) char {mustBeMember(ImplementationType, {'matlab', 'srs', 'both'})} = 'matlab'
         %Test type.
         %   Possible values are ('Detection', 'False Alarm'). Default is 'Detection'.
         TestType (1, :) char {mustBeMember(TestType, {'Detection', 'False Alarm'})} = 'Detection'
+        %Implementation of the simulation loop ('MEX', 'noMEX').
+        %   Set to 'MEX' for simulating the whole link (channel and receiver) with the native
+        %   multi-threaded srsPUCCHPERFEngine. Requires ImplementationType set to 'srs'.
+        SimulationEngineType (1, :) char {mustBeMember(SimulationEngineType, {'MEX', 'noMEX'})} = 'noMEX'
+        %Number of worker threads of the native simulation engine (0 for as many as hardware threads).
+        NumThreads (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
+        %Confidence level of the error rate confidence interval of the native simulation engine.
+        ConfidenceLevel (1, 1) double {mustBeGreaterThan(ConfidenceLevel, 0), mustBeLessThan(ConfidenceLevel, 1)} = 0.95
+        %Method for computing the error rate confidence interval of the native simulation engine ('Wilson', 'Clopper-Pearson').
+        IntervalType (1, :) char {mustBeMember(IntervalType, {'Wilson', 'Clopper-Pearson'})} = 'Wilson'
+        %Target absolute width of the error rate confidence interval (0 for no target).
+        %   The native simulation engine stops simulating an SNR point as soon as the width of
+        %   the confidence interval of the error rate counted by QuickSimulation is not larger
+        %   than the target, and moves the worker threads to the other SNR points.
+        TargetIntervalWidth (1, 1) double {mustBeReal, mustBeNonnegative} = 0
+        %Target width of the error rate confidence interval relative to the error rate (0 for no target).
+        %   The native simulation engine stops simulating an SNR point as soon as the width of
+        %   the confidence interval of the error rate counted by QuickSimulation is not larger
+        %   than the target times the error rate, and moves the worker threads to the other SNR points.
+        TargetRelativeIntervalWidth (1, 1) double {mustBeReal, mustBeNonnegative} = 0
+        %Seed of the random streams of the native simulation engine.
+        %   The payloads, the fading and the noise of each frame and SNR point are drawn from
+        %   streams identified by the seed: the same seed gives the same realization.
+        Seed (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
     end % of properties (Nontunable)
 
     properties % Tunable
@@ -179,6 +222,8 @@ classdef PUCCHPERF < matlab.System
         Channel
         %Format-specific metrics and functions.
         FormatDetails
+        %Native simulation engine.
+        Engine
     end % of properties (Access = private, Hidden)
 
     properties (Access = private, Dependent, Hidden)
@@ -222,6 +267,12 @@ classdef PUCCHPERF < matlab.System
             obj.FormatDetails.checkUCIBits(obj.NumACKBits, obj.NumSRBits, obj.NumCSI1Bits, obj.NumCSI2Bits);
         end
 
+        function checkSimulationEngine(obj)
+            if (strcmp(obj.SimulationEngineType, 'MEX') && ~strcmp(obj.ImplementationType, 'srs'))
+                error('The native simulation engine requires ImplementationType ''srs''.');
+            end
+        end
+
         function checkFormatandTestType(obj)
             totalBits = obj.NumACKBits + obj.NumSRBits + obj.NumCSI1Bits + obj.NumCSI2Bits;
             if ((obj.PUCCHFormat == 2) && (totalBits > 11) && strcmp(obj.TestType, 'False Alarm'))
@@ -276,12 +327,14 @@ classdef PUCCHPERF < matlab.System
         % Signatures of methods defined in dedicated files.
         setupImpl(obj)
         stepImpl(obj, SNRIn, nFrames)
+        counters = runEngine(obj, SNRIn, nFrames)
 
         function validatePropertiesImpl(obj)
             obj.checkPRBSetandGrid();
             obj.checkImplementationandChEstPerf();
             obj.checkImplementationandHopping();
             obj.checkFormatandTestType();
+            obj.checkSimulationEngine();
         end % of function validatePropertiesImpl(obj)
 
         function resetImpl(obj)
@@ -296,6 +349,9 @@ classdef PUCCHPERF < matlab.System
             obj.resetImpl();
             % Release internal system objects.
             release(obj.Channel);
+            if ~isempty(obj.Engine)
+                release(obj.Engine);
+            end
             % Release the format details.
             obj.FormatDetails = [];
         end % of function releaseImpl(obj)
@@ -312,6 +368,9 @@ classdef PUCCHPERF < matlab.System
                     flag = (obj.PUCCHFormat < 3);
                 case 'TestType'
                     flag = (obj.PUCCHFormat >= 3);
+                case {'NumThreads', 'ConfidenceLevel', 'IntervalType', 'TargetIntervalWidth', ...
+                        'TargetRelativeIntervalWidth', 'Seed'}
+                    flag = ~strcmp(obj.SimulationEngineType, 'MEX');
                 otherwise
                     flag = false;
             end
@@ -330,9 +389,12 @@ classdef PUCCHPERF < matlab.System
                 ... Antennas and layers.
                 'NRxAnts', 'NTxAnts', ...
                 ... Channel model.
-                'DelayProfile', 'DelaySpread', 'MaximumDopplerShift', 'PerfectChannelEstimator', ...
+                'DelayProfile', 'DelaySpread', 'MaximumDopplerShift', 'ChannelModelType', ...
+                'PerfectChannelEstimator', ...
                 ... Other simulation details.
-                'ImplementationType', 'TestType', 'QuickSimulation', 'DisplaySimulationInformation'};
+                'ImplementationType', 'TestType', 'SimulationEngineType', 'NumThreads', 'ConfidenceLevel', ...
+                'IntervalType', 'TargetIntervalWidth', 'TargetRelativeIntervalWidth', 'Seed', ...
+                'QuickSimulation', 'DisplaySimulationInformation'};
             groups = matlab.mixin.util.PropertyGroup(confProps, 'Configuration');
 
             if (~isempty(obj.FormatDetails) && obj.FormatDetails.hasresults())
@@ -350,6 +412,9 @@ classdef PUCCHPERF < matlab.System
                 s.PUCCH = obj.PUCCH;
                 s.Channel = matlab.System.saveObject(obj.Channel);
                 s.FormatDetails = obj.FormatDetails;
+                if ~isempty(obj.Engine)
+                    s.Engine = matlab.System.saveObject(obj.Engine);
+                end
 
                 % Save FFT size.
                 s.Nfft = obj.Nfft;
@@ -363,6 +428,9 @@ classdef PUCCHPERF < matlab.System
                 obj.PUCCH = s.PUCCH;
                 obj.Channel = matlab.System.loadObject(s.Channel);
                 obj.FormatDetails = s.FormatDetails;
+                if isfield(s, 'Engine')
+                    obj.Engine = matlab.System.loadObject(s.Engine);
+                end
 
                 % Load FFT size.
                 obj.Nfft = s.Nfft;
@@ -0,0 +1,112 @@
+%runEngine Simulates all SNR points with the native simulation engine.
+%   COUNTERS = runEngine(OBJ, SNRIN, NFRAMES) builds the codebook of transmitted
+%   PUCCH resource grids and runs the srsPUCCHPERFEngine for all the SNR values in
+%   SNRIN. COUNTERS is the structure array returned by the engine.
+%
+%   srsRAN does not provide PUCCH modulators, so the transmitted resource grids
+%   are generated here with the same MATLAB functions as the simulation loop of
+%   stepImpl, once for each UCI payload and slot of a frame. The codebook contains
+%   all possible payloads when there are at most MaxCodewords of them, and
+%   MaxCodewords random payloads otherwise.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
+
+function counters = runEngine(obj, SNRIn, nFrames)
+    % Maximum number of UCI payloads in the codebook.
+    MaxCodewords = 16;
+
+    carrier = obj.Carrier;
+    pucch = obj.PUCCH;
+    nBits = obj.NumACKBits + obj.NumSRBits + obj.NumCSI1Bits + obj.NumCSI2Bits;
+    if (obj.PUCCHFormat == 0)
+        ouci = [obj.NumACKBits obj.NumSRBits];
+    else
+        ouci = nBits;
+    end
+
+    % Select the UCI payloads, one per column.
+    if ((obj.PUCCHFormat == 0) && (obj.NumACKBits == 0))
+        % If there are no ACK bits, the PUCCH is transmitted only if the SR bit is 1.
+        % Since the no transmission case is covered by the 'False Alarm' test, here
+        % we set the bit to 1.
+        payloads = 1;
+    elseif (nBits == 0)
+        payloads = zeros(0, 1);
+    elseif (2^nBits <= MaxCodewords)
+        payloads = int2bit(0:2^nBits-1, nBits);
+    else
+        % Do not disturb the global random generator used by the MATLAB simulation loop.
+        stream = RandStream('mt19937ar', 'Seed', 0);
+        payloads = randi(stream, [0 1], nBits, MaxCodewords);
+    end
+    nCodewords = size(payloads, 2);
+
+    % Generate the transmitted resource grids for all payloads and all slots of a frame.
+    slotsPerFrame = carrier.SlotsPerFrame;
+    stats = obj.FormatDetails.setupTmpStats(1);
+    txGrids = complex(zeros(carrier.NSizeGrid * 12, carrier.SymbolsPerSlot, nCodewords, slotsPerFrame, 'single'));
+    for nslot = 0:slotsPerFrame-1
+        carrier.NSlot = nslot;
+
+        [pucchIndices, pucchIndicesInfo] = nrPUCCHIndices(carrier, pucch);
+        dmrsIndices = nrPUCCHDMRSIndices(carrier, pucch);
+        dmrsSymbols = nrPUCCHDMRS(carrier, pucch);
+
+        for iCodeword = 1:nCodewords
+            if isscalar(ouci)
+                uci = payloads(:, iCodeword);
+            else
+                uci = {payloads(1:ouci(1), iCodeword); payloads(ouci(1)+1:end, iCodeword)};
+            end
+
+            codedUCI = obj.FormatDetails.UCIEncode(uci, ouci, pucchIndicesInfo.G, stats, 1);
+
+            pucchGrid = nrResourceGrid(carrier, obj.NTxAnts);
+            pucchGrid(pucchIndices) = nrPUCCH(carrier, pucch, codedUCI);
+            pucchGrid(dmrsIndices) = dmrsSymbols;
+            txGrids(:, :, iCodeword, nslot + 1) = pucchGrid;
+        end
+    end
+
+    % Same PUCCH configuration as the srsPUCCHProcessor MEX (NSlot is set by the engine).
+    uciSizes = struct('NumHARQAck', obj.NumACKBits, 'NumSR', obj.NumSRBits, ...
+        'NumCSIPart1', obj.NumCSI1Bits, 'NumCSIPart2', obj.NumCSI2Bits);
+    engineConfig = srsMEX.phy.srsPUCCHProcessor.getMEXConfig(carrier, pucch, obj.NRxAnts, uciSizes);
+
+    % The channel is the same as the one of the MATLAB simulation loop.
+    engineConfig.NSizeGrid = carrier.NSizeGrid;
+    engineConfig.Nfft = obj.Nfft;
+    engineConfig.SlotsPerFrame = slotsPerFrame;
+    if strcmp(obj.DelayProfile, 'AWGN')
+        engineConfig.DelayProfile = 'custom';
+        engineConfig.MaximumDopplerShift = 0;
+    else
+        engineConfig.DelayProfile = obj.DelayProfile;
+        engineConfig.MaximumDopplerShift = obj.MaximumDopplerShift;
+    end
+    engineConfig.PathDelays = 0;
+    engineConfig.AveragePathGains = 0;
+    engineConfig.DelaySpread = obj.DelaySpread;
+    engineConfig.DetectionTest = obj.isDetectionTest;
+    engineConfig.Seed = obj.Seed;
+
+    fprintf(['\nSimulating transmission scheme MIMO (%dx%d) and SCS=%dkHz with ', ...
+             '%s channel at SNR [%s] dB for %d 10ms frame(s) (native engine)\n'], ...
+        obj.NTxAnts, obj.NRxAnts, carrier.SubcarrierSpacing, obj.DelayProfile, num2str(SNRIn), nFrames);
+
+    % To speed the simulation up, the engine stops each point after 100 errors.
+    counters = obj.Engine(engineConfig, txGrids, int8(payloads), SNRIn, nFrames, 100 * obj.QuickSimulation);
+end % of function counters = runEngine(obj, SNRIn, nFrames)
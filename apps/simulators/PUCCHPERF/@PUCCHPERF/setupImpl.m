@@ -89,7 +89,18 @@ function setupImpl(obj)
     obj.Nfft = waveformInfo.Nfft;
 
     % Set up TDL channel.
-    channel = nrTDLChannel;
+    if strcmp(obj.ChannelModelType, 'MEX')
+        % Native TDL channel object, with uplink antenna correlation. It always uses its
+        % own random streams: see the reseeding in stepImpl.
+        channel = srsMEX.channel.srsFadingChannel;
+    else
+        channel = nrTDLChannel;
+        channel.TransmissionDirection = 'Uplink';
+
+        % The PUCCH receiver is memoryless - a new fading realization for each slot
+        % is more representative for performance analysis.
+        channel.RandomStream = 'Global stream';
+    end
 
     % Set the channel geometry.
     channel.NumTransmitAntennas = obj.NTxAnts;
@@ -98,11 +109,6 @@ function setupImpl(obj)
     % Assign simulation channel parameters and waveform sample rate to the object.
     channel.SampleRate = waveformInfo.SampleRate;
     channel.DelaySpread = obj.DelaySpread;
-    channel.TransmissionDirection = 'Uplink';
-
-    % The PUCCH receiver is memoryless - a new fading realization for each slot
-    % is more representative for performance analysis.
-    channel.RandomStream = 'Global stream';
 
     if strcmp(obj.DelayProfile, 'AWGN')
         channel.DelayProfile = 'custom';
@@ -112,10 +118,16 @@ function setupImpl(obj)
     else
         channel.MaximumDopplerShift = obj.MaximumDopplerShift;
         channel.DelayProfile = obj.DelayProfile;
-        channel.MIMOCorrelation = 'low';
+        channel.MIMOCorrelation = 'Low';
     end
 
     obj.Channel = channel;
 
+    if strcmp(obj.SimulationEngineType, 'MEX')
+        obj.Engine = srsMEX.simulators.srsPUCCHPERFEngine('NumThreads', obj.NumThreads, ...
+            'ConfidenceLevel', obj.ConfidenceLevel, 'IntervalType', obj.IntervalType, ...
+            'TargetWidth', obj.TargetIntervalWidth, 'TargetRelativeWidth', obj.TargetRelativeIntervalWidth);
+    end
+
 end % function setupImpl(obj)
 
@@ -66,6 +66,25 @@ function stepImpl(obj, SNRIn, nFrames)
     totalBlocks = zeros(nSNRIn, 1);
     stats = obj.FormatDetails.setupTmpStats(nSNRIn);
 
+    % The native simulation engine runs the entire simulation loop.
+    if strcmp(obj.SimulationEngineType, 'MEX')
+        counters = obj.runEngine(SNRIn, nFrames);
+        for snrIdx = 1:nSNRIn
+            stats = obj.FormatDetails.updateStatsEngine(stats, counters(snrIdx), isDetectTest, snrIdx);
+            totalBlocks(snrIdx) = counters(snrIdx).NumOccasions;
+
+            if displaySimulationInformation
+                usedFrames = round(totalBlocks(snrIdx) / slotsPerFrame);
+                obj.FormatDetails.printMessagesSRS(stats, usedFrames, totalBlocks, SNRIn, isDetectTest, snrIdx);
+            end
+        end
+
+        % Export results.
+        obj.FormatDetails.updateCounters(stats, SNRIn, totalBlocks);
+
+        fprintf('\n');
+        return;
+    end
 
     for snrIdx = 1:numel(SNRIn)
 
@@ -140,8 +159,14 @@ function stepImpl(obj, SNRIn, nFrames)
 
             % Reset the channel: since the property RandomStream is set to "Global stream",
             % we are only resetting the filter and generate an "independent" channel
-            % realization at each slot.
-            reset(obj.Channel)
+            % realization at each slot. The native channel draws the realization from its
+            % own random stream, identified by the SNR point, the frame and the slot.
+            if strcmp(obj.ChannelModelType, 'MEX')
+                reseed(obj.Channel, obj.Channel.Seed, snrIdx - 1, floor(nslot / slotsPerFrame), ...
+                    mod(nslot, slotsPerFrame));
+            else
+                reset(obj.Channel)
+            end
 
             % Pass data through the channel model. Append zeros at the end of
             % the transmitted waveform to flush the channel content. These
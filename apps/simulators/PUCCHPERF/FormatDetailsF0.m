@@ -436,6 +436,19 @@ classdef FormatDetailsF0 < handle
             end
         end % of function getStatistics(obj)
 
+        function stats = updateStatsEngine(obj, stats, counters, isDetectTest, snrIdx)
+            % Occasions, as counted by UCIEncode.
+            stats.nACKs(snrIdx) = stats.nACKs(snrIdx) + counters.NumACKs + counters.NumNACKs;
+            stats.nSRs(snrIdx) = stats.nSRs(snrIdx) + counters.NumOccasions * obj.NumSRBits;
+            if isDetectTest
+                stats.errorACKSRS(snrIdx) = stats.errorACKSRS(snrIdx) + counters.ACKErrors;
+                stats.errorSRSRS(snrIdx) = stats.errorSRSRS(snrIdx) + counters.SRErrors;
+            else % false alarm test
+                stats.falseACKSRS(snrIdx) = stats.falseACKSRS(snrIdx) + counters.FalseDetections * obj.NumACKBits;
+                stats.falseSRSRS(snrIdx) = stats.falseSRSRS(snrIdx) + counters.FalseDetections * obj.NumSRBits;
+            end
+        end
+
         function flag = isSimOver(obj, stats, snrIdx, implementationType)
             useMATLAB = ~strcmp(implementationType, 'srs');
             useSRS = ~strcmp(implementationType, 'matlab');
@@ -376,6 +376,20 @@ classdef FormatDetailsF1 < handle
             end
         end % of function UCIEncode()
 
+        function stats = updateStatsEngine(obj, stats, counters, isDetectTest, snrIdx)
+            % Occasions, as counted by UCIEncode.
+            stats.nOccasions(snrIdx) = stats.nOccasions(snrIdx) + counters.NumOccasions * obj.NumACKBits;
+            if isDetectTest
+                stats.nACKs(snrIdx) = stats.nACKs(snrIdx) + counters.NumACKs;
+                stats.nNACKs(snrIdx) = stats.nNACKs(snrIdx) + counters.NumNACKs;
+                stats.missedPUCCHSRS(snrIdx) = stats.missedPUCCHSRS(snrIdx) + counters.MissedDetections;
+                stats.missedACKSRS(snrIdx) = stats.missedACKSRS(snrIdx) + counters.MissedACKs;
+                stats.NACK2ACKSRS(snrIdx) = stats.NACK2ACKSRS(snrIdx) + counters.NACK2ACKs;
+            else % false alarm test
+                stats.falseACKSRS(snrIdx) = stats.falseACKSRS(snrIdx) + counters.FalseACKs;
+            end
+        end % of function updateStatsEngine()
+
         function counts = getCounters(obj, implementationType)
             counts = struct();
             counts.SNRrange = obj.SNRrange;
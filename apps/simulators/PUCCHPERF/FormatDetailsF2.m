@@ -152,6 +152,14 @@ classdef FormatDetailsF2 < handle
             end
         end
 
+        function stats = updateStatsEngine(stats, counters, isDetectTest, snrIdx)
+            if isDetectTest
+                stats.blerUCISRS(snrIdx) = stats.blerUCISRS(snrIdx) + counters.BlockErrors;
+            else % false alarm test
+                stats.blerUCISRS(snrIdx) = stats.blerUCISRS(snrIdx) + counters.FalseDetections;
+            end
+        end
+
         function flag = isSimOver(stats, snrIdx, implementationType)
             useMATLABpucch = ~strcmp(implementationType, 'srs');
             useSRSpucch = ~strcmp(implementationType, 'matlab');
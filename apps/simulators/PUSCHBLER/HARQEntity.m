@@ -34,6 +34,7 @@ classdef HARQEntity < handle
 %   updateProcess        - Update current HARQ process with data transmission information (TBS, CRC error, bit capacity)
 %   advanceToNextProcess - Advance entity to next HARQ process in the sequence
 %   updateAndAdvance     - Update current HARQ process and advance to the next
+%   createUpdateReport   - Create a text report of a data transmission on a HARQ process (static)
 
 %   Copyright 2021 The MathWorks, Inc.
 
@@ -140,7 +141,7 @@ classdef HARQEntity < handle
             % combination of the shared channel configuration (subset) and
             % the resulting CRC error
             if nargout
-                rep = createUpdateReport(obj,txerror,tbs,g);
+                rep = HARQEntity.createUpdateReport(obj,txerror,tbs,g);
             end
 
             % Create a text summary of what happened for the transmission event
@@ -243,8 +244,18 @@ classdef HARQEntity < handle
             obj.SequenceTimeout = obj.HarqProcessStates(stateidx).Timeout;          % Did the last sequence end without a successful transmission
         end
 
-        % Create a text report of the effect of the data transmission on the current HARQ process
+    end
+
+    methods (Static)
+
         function sr = createUpdateReport(harqEntity,blkerr,tbs,g)
+        %createUpdateReport Create a text report of a data transmission on a HARQ process
+        %   TR = HARQEntity.createUpdateReport(HARQINFO,BLKERR,TBS,G) creates the text
+        %   report TR of a data transmission with CRC error BLKERR, transport block
+        %   size TBS and bit capacity G on the HARQ process described by HARQINFO.
+        %   HARQINFO is either a HARQEntity object or a structure with the same HARQ
+        %   information fields (HARQProcessID, TransmissionNumber, RedundancyVersion
+        %   and NewData), e.g., the HARQ information reported by a native HARQ entity.
 
             % Display transport block CRC error information per codeword managed by current HARQ process
             icr = tbs./g;    % Instantaneous code rate
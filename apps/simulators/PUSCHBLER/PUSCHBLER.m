@@ -76,10 +76,28 @@
 %                                  'TDL-C', 'TDLC300').
 %   DelaySpread                  - Delay spread in seconds (single-tap and TDL-{A,B,C} delay profiles only).
 %   MaximumDopplerShift          - Maximum Doppler shift in hertz (TDL delay profiles only).
+%   ChannelModelType             - Implementation of the fading channel ('MEX', 'noMEX').
+%   SimulationEngineType         - Implementation of the simulation loop ('MEX', 'noMEX'). With 'MEX',
+%                                  the whole link is simulated by the native multi-threaded
+%                                  srsPUSCHBLEREngine (requires ImplementationType 'srs').
+%   NumThreads                   - Number of worker threads of the native simulation engine (0 for as
+%                                  many as hardware threads).
+%   ConfidenceLevel              - Confidence level of the BLER confidence interval of the native
+%                                  simulation engine.
+%   IntervalType                 - Method for computing the BLER confidence interval of the native
+%                                  simulation engine ('Wilson', 'Clopper-Pearson').
+%   TargetIntervalWidth          - Target absolute width of the BLER confidence interval: the native
+%                                  simulation engine stops a point as soon as it is met (0 for no target).
+%   TargetRelativeIntervalWidth  - Target width of the BLER confidence interval relative to the BLER: the
+%                                  native simulation engine stops a point as soon as it is met (0 for no
+%                                  target).
+%   Seed                         - Seed of the random streams of the native simulation engine.
 %   CarrierFrequencyOffset       - Carrier frequency offset in hertz (requires PerfectChannelEstimator
 %                                  set to false).
 %   EnableHARQ                   - HARQ flag: true for enabling retransmission with
 %                                  RV sequence [0, 2, 3, 1], false for no retransmissions.
+%   SoftbitWidth                 - Number of bits of the soft bits stored in the srsRAN softbuffers
+%                                  (8, 6 or 4): smaller widths compress the soft-combining buffers.
 %   MaximumLDPCIterationCount    - Maximum LDPC decoding iterations.
 %   ImplementationType           - PUSCH implementation type ('matlab', 'srs' (requires mex), 'both')
 %   SRSEstimatorType             - Implementation of the SRS channel estimator ('MEX', 'noMEX')
@@ -202,10 +220,43 @@ classdef PUSCHBLER < matlab.System
         DelaySpread (1, 1) double {mustBeReal, mustBeNonnegative} = 30e-9
         %TDL delay profiles only: Maximum Doppler shift in hertz.
         MaximumDopplerShift (1, 1) double {mustBeReal, mustBeNonnegative} = 0
+        %Implementation of the fading channel ('MEX', 'noMEX').
+        %   Set to 'MEX' for using the native srsFadingChannel instead of nrTDLChannel.
+        ChannelModelType (1, :) char {mustBeMember(ChannelModelType, {'MEX', 'noMEX'})} = 'noMEX'
+        %Implementation of the simulation loop ('MEX', 'noMEX').
+        %   Set to 'MEX' for simulating the whole link (transmitter, channel and receiver) with the
+        %   native multi-threaded srsPUSCHBLEREngine. Requires ImplementationType set to 'srs',
+        %   practical channel estimation, no transform precoding and no O-FH compression.
+        SimulationEngineType (1, :) char {mustBeMember(SimulationEngineType, {'MEX', 'noMEX'})} = 'noMEX'
+        %Number of worker threads of the native simulation engine (0 for as many as hardware threads).
+        NumThreads (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
+        %Confidence level of the BLER confidence interval of the native simulation engine.
+        ConfidenceLevel (1, 1) double {mustBeGreaterThan(ConfidenceLevel, 0), mustBeLessThan(ConfidenceLevel, 1)} = 0.95
+        %Method for computing the BLER confidence interval of the native simulation engine ('Wilson', 'Clopper-Pearson').
+        IntervalType (1, :) char {mustBeMember(IntervalType, {'Wilson', 'Clopper-Pearson'})} = 'Wilson'
+        %Target absolute width of the BLER confidence interval (0 for no target).
+        %   The native simulation engine stops simulating an SNR point as soon as the width of
+        %   the BLER confidence interval is not larger than the target, and moves the worker
+        %   threads to the other SNR points. Useful for points with few or no errors.
+        TargetIntervalWidth (1, 1) double {mustBeReal, mustBeNonnegative} = 0
+        %Target width of the BLER confidence interval relative to the BLER (0 for no target).
+        %   The native simulation engine stops simulating an SNR point as soon as the width of
+        %   the BLER confidence interval is not larger than the target times the BLER, and moves
+        %   the worker threads to the other SNR points. Useful for the waterfall region.
+        TargetRelativeIntervalWidth (1, 1) double {mustBeReal, mustBeNonnegative} = 0
+        %Seed of the random streams of the native simulation engine.
+        %   The transport blocks, the fading and the noise of each frame and SNR point are drawn
+        %   from streams identified by the seed: the same seed gives the same realization.
+        Seed (1, 1) double {mustBeInteger, mustBeNonnegative} = 0
         %Carrier frequency offset in hertz (requires PerfectChannelEstimator set to false).
         CarrierFrequencyOffset (1, 1) double {mustBeReal} = 0
         %HARQ flag: true for enabling retransmission with RV sequence [0, 2, 3, 1], false for no retransmissions.
         EnableHARQ (1, 1) logical = false
+        %Number of bits of the soft bits stored in the srsRAN softbuffers (8, 6 or 4).
+        %   Smaller widths compress the soft-combining buffers, thus allowing more HARQ processes
+        %   for the same memory, at the cost of a coarser combining of the retransmissions.
+        %   Only applies if ImplementationType is set to 'srs' or 'both'.
+        SoftbitWidth (1, 1) double {mustBeMember(SoftbitWidth, [4 6 8])} = 8
         %Maximum LDPC decoding iterations.
         MaximumLDPCIterationCount (1, 1) double {mustBeInteger, mustBePositive} = 6
         %PUSCH implementation type ('matlab', 'srs' (requires mex), 'both').
@@ -308,6 +359,8 @@ classdef PUSCHBLER < matlab.System
         PUSCHIndicesInfo
         %Transport block segmentation configuration.
         SegmentCfg
+        %Native simulation engine.
+        Engine
     end % of properties (Access = private, Hidden)
 
     methods (Access = private)
@@ -340,6 +393,122 @@ classdef PUSCHBLER < matlab.System
                 error('Transform precoding and more than one layer are incompatible.');
             end
         end
+
+        function checkSimulationEngine(obj)
+            if ~strcmp(obj.SimulationEngineType, 'MEX')
+                return;
+            end
+            if ~strcmp(obj.ImplementationType, 'srs')
+                error('The native simulation engine requires ImplementationType ''srs''.');
+            end
+            if (obj.PerfectChannelEstimator || obj.TransformPrecoding || obj.ApplyOFHCompression)
+                error(['The native simulation engine does not support perfect channel estimation, ' ...
+                    'transform precoding nor O-FH compression.']);
+            end
+        end
+
+        function [maxThroughput, simThroughputSRS, simBLERSRS, totalBlocks, simIterSRS, simIterCRCOKSRS] = ...
+                runEngine(obj, SNRIn, nFrames, rvSeq, betaDMRS)
+        %Simulates all SNR points with the native simulation engine.
+            carrier = obj.Carrier;
+            pusch = obj.PUSCH;
+            channel = obj.Channel;
+
+            % Generate a PUSCH RB allocation mask.
+            rbAllocationMask = false(carrier.NSizeGrid, 1);
+            rbAllocationMask(pusch.PRBSet + 1) = true;
+
+            % Generate a DM-RS symbol mask.
+            dmrsIndices = nrPUSCHDMRSIndices(carrier, pusch, 'IndexStyle', 'subscript', 'IndexBase', '0based');
+            dmrsSymbolMask = false(carrier.SymbolsPerSlot, 1);
+            dmrsSymbolMask(unique(dmrsIndices(:, 2)) + 1) = true;
+
+            % The channel is the same as the one of the MATLAB simulation loop.
+            engineConfig = struct( ...
+                'NSizeGrid', carrier.NSizeGrid, ...
+                'SubcarrierSpacing', carrier.SubcarrierSpacing, ...
+                'CyclicPrefix', carrier.CyclicPrefix, ...
+                'Nfft', obj.Nfft, ...
+                'SlotsPerFrame', carrier.SlotsPerFrame, ...
+                'RNTI', pusch.RNTI, ...
+                'NID', pusch.NID, ...
+                'RBMask', rbAllocationMask, ...
+                'StartSymbolIndex', pusch.SymbolAllocation(1), ...
+                'NumSymbols', pusch.SymbolAllocation(2), ...
+                'DMRSSymbPos', dmrsSymbolMask, ...
+                'DMRSConfigType', pusch.DMRS.DMRSConfigurationType, ...
+                'NumCDMGroupsWithoutData', pusch.DMRS.NumCDMGroupsWithoutData, ...
+                'NIDNSCID', pusch.DMRS.NIDNSCID, ...
+                'NSCID', pusch.DMRS.NSCID, ...
+                'DMRSAmplitude', betaDMRS, ...
+                'NumLayers', pusch.NumLayers, ...
+                'Modulation', pusch.Modulation, ...
+                'BGN', obj.SegmentCfg.BGN, ...
+                'TransportBlockLength', obj.SegmentCfg.TransportBlockLength, ...
+                'NumCodeblocks', obj.SegmentCfg.NumCodeblocks, ...
+                'MaxCodeblockSize', obj.PUSCHExtension.MaxCodeblockSize, ...
+                'SoftbitWidth', obj.SoftbitWidth, ...
+                'LimitedBufferSize', obj.SegmentCfg.LimitedBufferSize, ...
+                'MaximumLDPCIterationCount', obj.MaximumLDPCIterationCount, ...
+                'RVSequence', rvSeq, ...
+                'NumHARQProcesses', obj.PUSCHExtension.NHARQProcesses, ...
+                'NumTxAnts', obj.NTxAnts, ...
+                'NumRxAnts', obj.NRxAnts, ...
+                'DelayProfile', channel.DelayProfile, ...
+                'PathDelays', channel.PathDelays, ...
+                'AveragePathGains', channel.AveragePathGains, ...
+                'DelaySpread', channel.DelaySpread, ...
+                'MaximumDopplerShift', channel.MaximumDopplerShift, ...
+                'SlotIndependentFading', strcmp(obj.FadingTimeEvolution, 'Slot independent'), ...
+                'CarrierFrequencyOffset', obj.CarrierFrequencyOffset, ...
+                'Smoothing', obj.SRSSmoothing, ...
+                'Interpolation', obj.SRSInterpolation, ...
+                'CompensateCFO', obj.SRSCompensateCFO, ...
+                'EqualizerType', obj.SRSEqualizerType, ...
+                'Seed', obj.Seed);
+
+            % To speed the simulation up, the engine stops each point after 100 missed transport blocks.
+            counters = obj.Engine(engineConfig, SNRIn, nFrames, 100 * obj.QuickSimulation);
+
+            maxThroughput = [counters.MaxThroughput].';
+            simThroughputSRS = [counters.Throughput].';
+            simBLERSRS = [counters.MissedBlocks].';
+            totalBlocks = [counters.TotalBlocks].';
+            simIterSRS = [counters.DecIterations].';
+            simIterCRCOKSRS = [counters.DecIterationsCRCOK].';
+
+            % Display the results in the command window.
+            for snrIdx = 1:numel(SNRIn)
+                usedFrames = counters(snrIdx).NumFrames;
+                fprintf('\nSimulated transmission scheme 1 (%dx%d) and SCS=%dkHz with %s channel at %gdB SNR for %g 10ms frame(s) (native engine)\n', ...
+                    obj.NTxAnts, obj.NRxAnts, carrier.SubcarrierSpacing, obj.DelayProfile, SNRIn(snrIdx), usedFrames);
+                fprintf('\nSRS');
+                fprintf('\nThroughput(Mbps) after %.0f frame(s) = %.4f (max %.4f)\n', usedFrames, ...
+                    1e-6*[simThroughputSRS(snrIdx) maxThroughput(snrIdx)]/(usedFrames*10e-3));
+                fprintf('Throughput(%%) after %.0f frame(s) = %.4f\n', usedFrames, simThroughputSRS(snrIdx)*100/maxThroughput(snrIdx));
+                fprintf('BLER after %.0f frame(s) = %.4f\n', usedFrames, simBLERSRS(snrIdx)/totalBlocks(snrIdx));
+                fprintf('Measured SNR = %.1f dB.\n', ...
+                    10*log10(counters(snrIdx).RSRP * pusch.NumLayers / counters(snrIdx).NoiseVar / betaDMRS^2));
+            end
+        end % of function runEngine(...)
+
+        function storeResults(obj, SNRIn, maxThroughput, simThroughput, simThroughputSRS, totalBlocks, ...
+                simBLER, simBLERSRS, simIterSRS, simIterCRCOKSRS)
+        %Merges the counters of the simulated SNR points with the ones of previous simulations.
+            [~, repeatedIdx] = intersect(obj.SNRrange, SNRIn);
+            obj.SNRrange(repeatedIdx) = [];
+            [obj.SNRrange, sortedIdx] = sort([obj.SNRrange; SNRIn(:)]);
+
+            obj.MaxThroughputCtr = joinArrays(obj.MaxThroughputCtr, maxThroughput, repeatedIdx, sortedIdx);
+            obj.ThroughputMATLABCtr = joinArrays(obj.ThroughputMATLABCtr, simThroughput, repeatedIdx, sortedIdx);
+            obj.ThroughputSRSCtr = joinArrays(obj.ThroughputSRSCtr, simThroughputSRS, repeatedIdx, sortedIdx);
+            obj.TotalBlocksCtr = joinArrays(obj.TotalBlocksCtr, totalBlocks, repeatedIdx, sortedIdx);
+            obj.MissedBlocksMATLABCtr = joinArrays(obj.MissedBlocksMATLABCtr, simBLER, repeatedIdx, sortedIdx);
+            obj.MissedBlocksSRSCtr = joinArrays(obj.MissedBlocksSRSCtr, simBLERSRS, repeatedIdx, sortedIdx);
+            obj.DecIterationsSRSCtr = joinArrays(obj.DecIterationsSRSCtr, simIterSRS, repeatedIdx, sortedIdx);
+            obj.DecIterationsCRCOKSRSCtr = joinArrays(obj.DecIterationsCRCOKSRSCtr, simIterCRCOKSRS, ...
+                repeatedIdx, sortedIdx);
+        end % of function storeResults(...)
     end % of methods (Access = private)
 
     methods % public
@@ -521,6 +690,14 @@ classdef PUSCHBLER < matlab.System
             obj.PUSCHExtension.XOverhead = 0;       % Set PUSCH rate matching overhead for TBS (Xoh).
             obj.PUSCHExtension.NHARQProcesses = 16; % Number of parallel HARQ processes to use.
             obj.PUSCHExtension.EnableHARQ = obj.EnableHARQ;
+            % Redundancy version (RV) sequence for all HARQ processes.
+            if obj.EnableHARQ
+                % From PUSCH demodulation requirements in RAN WG4 meeting #88bis (R4-1814062).
+                obj.PUSCHExtension.RVSequence = [0 2 3 1];
+            else
+                % HARQ disabled - single transmission with RV=0, no retransmissions.
+                obj.PUSCHExtension.RVSequence = 0;
+            end
 
             % LDPC decoder parameters.
             % Available algorithms: 'Belief propagation', 'Layered belief propagation', 'Normalized min-sum', 'Offset min-sum'.
@@ -535,18 +712,24 @@ classdef PUSCHBLER < matlab.System
             obj.Nfft = waveformInfo.Nfft;
 
             % Create a channel system object for the simulations.
-            channel = nrTDLChannel; % TDL channel object.
+            if strcmp(obj.ChannelModelType, 'MEX')
+                % Native TDL channel object. It always uses its own random streams: see the
+                % reseeding in stepImpl for the 'Slot independent' fading time evolution.
+                channel = srsMEX.channel.srsFadingChannel;
+            else
+                channel = nrTDLChannel; % TDL channel object.
+
+                if strcmp(obj.FadingTimeEvolution, 'Slot independent')
+                    channel.RandomStream = 'Global stream';
+                else
+                    channel.RandomStream = "mt19937ar with seed";
+                end
+            end
 
             % Set the channel geometry.
             channel.NumTransmitAntennas = obj.NTxAnts;
             channel.NumReceiveAntennas = obj.NRxAnts;
 
-            if strcmp(obj.FadingTimeEvolution, 'Slot independent')
-                channel.RandomStream = 'Global stream';
-            else
-                channel.RandomStream = "mt19937ar with seed";
-            end
-
             % Assign simulation channel parameters and waveform sample rate to the object.
             channel.SampleRate = waveformInfo.SampleRate;
             channel.DelaySpread = obj.DelaySpread;
@@ -594,8 +777,24 @@ classdef PUSCHBLER < matlab.System
             [obj.SegmentCfg, configSRS] = srsMEX.phy.srsPUSCHDecoder.configureSegment(obj.Carrier, ...
                 obj.PUSCH, obj.TargetCodeRate, obj.PUSCHExtension.NHARQProcesses, obj.PUSCHExtension.XOverhead);
             obj.SegmentCfg.MaximumLDPCIterationCount = obj.MaximumLDPCIterationCount;
+            obj.PUSCHExtension.MaxCodeblockSize = configSRS.MaxCodeblockSize;
+            % When it runs alone, the srsRAN decoder manages the HARQ processes with its native HARQ
+            % entity. When both decoders run, the HARQEntity object drives both of them with the
+            % combined CRC error. A softbuffer must not expire before its process has gone through
+            % the whole RV sequence.
             obj.DecodeULSCHsrs = srsMEX.phy.srsPUSCHDecoder('MaxCodeblockSize', configSRS.MaxCodeblockSize, ...
-                'MaxSoftbuffers', configSRS.MaxSoftbuffers, 'MaxCodeblocks', configSRS.MaxCodeblocks);
+                'MaxSoftbuffers', configSRS.MaxSoftbuffers, 'MaxCodeblocks', configSRS.MaxCodeblocks, ...
+                'ExpireTimeoutSlots', obj.PUSCHExtension.NHARQProcesses * numel(obj.PUSCHExtension.RVSequence), ...
+                'SoftbitWidth', obj.SoftbitWidth, 'NativeHARQ', strcmp(obj.ImplementationType, 'srs'), ...
+                'RNTI', obj.RNTI, ...
+                'HARQProcessSequence', 0:obj.PUSCHExtension.NHARQProcesses-1, ...
+                'RVSequence', obj.PUSCHExtension.RVSequence);
+
+            if strcmp(obj.SimulationEngineType, 'MEX')
+                obj.Engine = srsMEX.simulators.srsPUSCHBLEREngine('NumThreads', obj.NumThreads, ...
+                    'ConfidenceLevel', obj.ConfidenceLevel, 'IntervalType', obj.IntervalType, ...
+                    'TargetWidth', obj.TargetIntervalWidth, 'TargetRelativeWidth', obj.TargetRelativeIntervalWidth);
+            end
 
         end % of setupImpl
 
@@ -626,6 +825,9 @@ classdef PUSCHBLER < matlab.System
 
             % Cross-check that we aren't enabling transform precoding with multiple layers.
             obj.checkTrPrecandLayers();
+
+            % Cross-check that the native simulation engine supports the configuration.
+            obj.checkSimulationEngine();
         end
 
         function stepImpl(obj, SNRIn, nFrames)
@@ -652,14 +854,8 @@ classdef PUSCHBLER < matlab.System
             maxThroughput = zeros(length(SNRIn), 1);
             totalBlocks = zeros(length(SNRIn), 1);
 
-            % Set up redundancy version (RV) sequence for all HARQ processes.
-            if obj.PUSCHExtension.EnableHARQ
-                % From PUSCH demodulation requirements in RAN WG4 meeting #88bis (R4-1814062).
-                rvSeq = [0 2 3 1];
-            else
-                % HARQ disabled - single transmission with RV=0, no retransmissions.
-                rvSeq = 0;
-            end
+            % Redundancy version (RV) sequence for all HARQ processes.
+            rvSeq = obj.PUSCHExtension.RVSequence;
 
             % Take copies of channel-level parameters to simplify subsequent parameter referencing.
             carrier = obj.Carrier;
@@ -680,6 +876,7 @@ classdef PUSCHBLER < matlab.System
 
             useMATLABDecoder = (strcmp(implementationType, 'matlab') || strcmp(implementationType, 'both'));
             useSRSDecoder = (strcmp(implementationType, 'srs') || strcmp(implementationType, 'both'));
+            useNativeHARQ = strcmp(implementationType, 'srs');
 
             % Array to store the simulation throughput and BLER for all SNR points.
             simThroughput = zeros(length(SNRIn), 1);
@@ -703,6 +900,15 @@ classdef PUSCHBLER < matlab.System
             % DM-RS over data amplitude gain.
             betaDMRS = sqrt(2);
 
+            % The native simulation engine runs the entire simulation loop.
+            if strcmp(obj.SimulationEngineType, 'MEX')
+                [maxThroughput, simThroughputSRS, simBLERSRS, totalBlocks, simIterSRS, simIterCRCOKSRS] = ...
+                    obj.runEngine(SNRIn, nFrames, rvSeq, betaDMRS);
+                obj.storeResults(SNRIn, maxThroughput, simThroughput, simThroughputSRS, totalBlocks, ...
+                    simBLER, simBLERSRS, simIterSRS, simIterCRCOKSRS);
+                return;
+            end
+
             if useSRSDecoder
                 srsDemodulatePUSCH = srsMEX.phy.srsPUSCHDemodulator(EqualizerStrategy = obj.SRSEqualizerType);
                 srsChannelEstimate = srsMEX.phy.srsMultiPortChannelEstimator(...
@@ -735,11 +941,22 @@ classdef PUSCHBLER < matlab.System
                     nTxAnts, nRxAnts, carrier.SubcarrierSpacing, ...
                     delayProfile, SNRdB, nFrames, optCompStr);
 
-                % Specify the fixed order in which we cycle through the HARQ process IDs.
-                harqSequence = 0:puschextra.NHARQProcesses-1;
-
-                % Initialize the state of all HARQ processes.
-                harqEntity = HARQEntity(harqSequence, rvSeq);
+                % Initialize the state of all HARQ processes. When it runs alone, the srsRAN
+                % decoder runs its own native HARQ entity, which is reset together with the
+                % softbuffers and reports the HARQ information of the next transmission at every
+                % step. Otherwise, the HARQEntity object provides the same information as
+                % properties.
+                if useSRSDecoder
+                    reset(obj.DecodeULSCHsrs);
+                end
+                if useNativeHARQ
+                    harqInfo = getHARQTransmission(obj.DecodeULSCHsrs);
+                else
+                    % Specify the fixed order in which we cycle through the HARQ process IDs.
+                    harqSequence = 0:puschextra.NHARQProcesses-1;
+                    harqEntity = HARQEntity(harqSequence, rvSeq);
+                    harqInfo = harqEntity;
+                end
 
                 % If FadingTimeEvolution is set to 'Jakes model', we reset the channel before
                 % simulating the slots. Since the channel uses its internal random generator,
@@ -768,27 +985,21 @@ classdef PUSCHBLER < matlab.System
 
                     % HARQ processing.
                     %
-                    % Create HARQ ID for the SRS decoder.
-                    % Set the HARQ ID.
-                    harqBufID.RNTI = pusch.RNTI;
-                    harqBufID.HARQProcessID = harqEntity.HARQProcessID;
-                    harqBufID.NumCodeblocks = segmentCfg.NumCodeblocks;
-
                     % If new data for current process then create a new UL-SCH transport block.
-                    if harqEntity.NewData
+                    if harqInfo.NewData
                         trBlk = randi([0 1], trBlkSize, 1);
-                        setTransportBlock(obj.EncodeULSCH, trBlk, harqEntity.HARQProcessID);
-                        % If new data because of previous RV sequence time out then flush decoder soft buffer explicitly.
-                        if harqEntity.SequenceTimeout
-                            resetSoftBuffer(obj.DecodeULSCH, harqEntity.HARQProcessID);
+                        setTransportBlock(obj.EncodeULSCH, trBlk, harqInfo.HARQProcessID);
+                        % Flush the MATLAB decoder soft buffer explicitly (it is already empty unless
+                        % the previous RV sequence timed out). The SRS decoder takes care of its own
+                        % softbuffers.
+                        if useMATLABDecoder
+                            resetSoftBuffer(obj.DecodeULSCH, harqInfo.HARQProcessID);
                         end
-                        % The SRS decoder must be reset explicitely in any case.
-                        obj.DecodeULSCHsrs.resetCRCS(harqBufID);
                     end
 
                     % Encode the UL-SCH transport block.
                     codedTrBlock = obj.EncodeULSCH(pusch.Modulation, pusch.NumLayers, ...
-                        puschBitCapacity, harqEntity.RedundancyVersion, harqEntity.HARQProcessID);
+                        puschBitCapacity, harqInfo.RedundancyVersion, harqInfo.HARQProcessID);
 
                     % Create resource grid for a slot.
                     puschGrid = nrResourceGrid(carrier, nTxAnts);
@@ -830,7 +1041,16 @@ classdef PUSCHBLER < matlab.System
                     % SNR for loop, we still ensure that all SNR points will experience the
                     % same channel ralizations.
                     if strcmp(obj.FadingTimeEvolution, 'Slot independent')
-                        reset(obj.Channel);
+                        if strcmp(obj.ChannelModelType, 'MEX')
+                            % The native channel draws the new realization from its own random
+                            % stream, identified by the SNR point, the frame and the slot. It does
+                            % not draw from the global random generator, so the transport blocks
+                            % and the noise do not depend on the fading realizations.
+                            reseed(obj.Channel, obj.Channel.Seed, snrIdx - 1, ...
+                                floor(nslot / carrier.SlotsPerFrame), mod(nslot, carrier.SlotsPerFrame));
+                        else
+                            reset(obj.Channel);
+                        end
                     end
 
                     % Pass data through channel model. Append zeros at the end of the
@@ -935,7 +1155,7 @@ classdef PUSCHBLER < matlab.System
                     end
 
                     % Store values to calculate BLER.
-                    isLastRetransmission = (harqEntity.RedundancyVersion == rvSeq(end));
+                    isLastRetransmission = (harqInfo.RedundancyVersion == rvSeq(end));
 
                     blkerrBoth = false;
 
@@ -971,7 +1191,7 @@ classdef PUSCHBLER < matlab.System
                         % Decode the UL-SCH transport channel.
                         obj.DecodeULSCH.TransportBlockLength = trBlkSize;
                         [decbits, blkerr] = obj.DecodeULSCH(ulschLLRs, pusch.Modulation, ...
-                            pusch.NumLayers, harqEntity.RedundancyVersion, harqEntity.HARQProcessID);
+                            pusch.NumLayers, harqInfo.RedundancyVersion, harqInfo.HARQProcessID);
 
                         % Store values to calculate throughput and BLER.
                         simThroughput(snrIdx) = simThroughput(snrIdx) + (~blkerr * trBlkSize);
@@ -998,10 +1218,20 @@ classdef PUSCHBLER < matlab.System
                         ulschLLRsInt8 = int8(srsDemodulatePUSCH(rxGrid, estChannelGrid, noiseEst, pusch, ...
                             puschIndices, dmrsLayerIndices, 0:nRxAnts-1));
 
-                        % Set the RV.
-                        segmentCfg.RV = harqEntity.RedundancyVersion;
-
-                        [decbitsSRS, statsSRS] = obj.DecodeULSCHsrs(ulschLLRsInt8, harqEntity.NewData, segmentCfg, harqBufID);
+                        obj.DecodeULSCHsrs.Slot = nslot;
+                        if useNativeHARQ
+                            % The native HARQ entity sets the HARQ process, the RV and the new data
+                            % flag, and returns the HARQ information of the next transmission.
+                            [decbitsSRS, statsSRS, nextHARQInfo] = obj.DecodeULSCHsrs(ulschLLRsInt8, segmentCfg);
+                        else
+                            harqBufID = struct('RNTI', pusch.RNTI, 'HARQProcessID', harqInfo.HARQProcessID, ...
+                                'NumCodeblocks', segmentCfg.NumCodeblocks);
+                            if harqInfo.NewData
+                                resetCRCS(obj.DecodeULSCHsrs, harqBufID);
+                            end
+                            segmentCfg.RV = harqInfo.RedundancyVersion;
+                            [decbitsSRS, statsSRS] = obj.DecodeULSCHsrs(ulschLLRsInt8, harqInfo.NewData, segmentCfg, harqBufID);
+                        end
 
                         % Store values to calculate throughput and BLER.
                         simThroughputSRS(snrIdx) = simThroughputSRS(snrIdx) + (statsSRS.CRCOK * trBlkSize);
@@ -1027,8 +1257,13 @@ classdef PUSCHBLER < matlab.System
                     end
 
                     % Update current process with CRC error and advance to
-                    % next process.
-                    procstatus = updateAndAdvance(harqEntity, blkerrBoth, trBlkSize, puschBitCapacity);
+                    % next process. The native HARQ entity has already done it.
+                    if useNativeHARQ
+                        procstatus = HARQEntity.createUpdateReport(harqInfo, blkerrBoth, trBlkSize, puschBitCapacity);
+                        harqInfo = nextHARQInfo;
+                    else
+                        procstatus = updateAndAdvance(harqEntity, blkerrBoth, trBlkSize, puschBitCapacity);
+                    end
                     if (displaySimulationInformation)
                         fprintf('\n(%3.2f%%) NSlot=%d, %s', 100*(nslot+1)/NSlots, nslot, procstatus);
                     end
@@ -1060,23 +1295,17 @@ classdef PUSCHBLER < matlab.System
                     if (~perfectChannelEstimator)
                         fprintf('Measured SNR = %.1f dB.\n', 10*log10(rsrpLT * pusch.NumLayers / noiseEstLT / betaDMRS^2));
                     end
+                    poolStatus = getPoolStatus(obj.DecodeULSCHsrs);
+                    if (poolStatus.FullWidthStorageBytes > 0)
+                        fprintf('Softbuffer storage = %d bytes (%.0f%% of full width).\n', poolStatus.StorageBytes, ...
+                            100 * poolStatus.StorageBytes / poolStatus.FullWidthStorageBytes);
+                    end
                 end
             end
 
             % Export results.
-            [~, repeatedIdx] = intersect(obj.SNRrange, SNRIn);
-            obj.SNRrange(repeatedIdx) = [];
-            [obj.SNRrange, sortedIdx] = sort([obj.SNRrange; SNRIn(:)]);
-
-            obj.MaxThroughputCtr = joinArrays(obj.MaxThroughputCtr, maxThroughput, repeatedIdx, sortedIdx);
-            obj.ThroughputMATLABCtr = joinArrays(obj.ThroughputMATLABCtr, simThroughput, repeatedIdx, sortedIdx);
-            obj.ThroughputSRSCtr = joinArrays(obj.ThroughputSRSCtr, simThroughputSRS, repeatedIdx, sortedIdx);
-            obj.TotalBlocksCtr = joinArrays(obj.TotalBlocksCtr, totalBlocks, repeatedIdx, sortedIdx);
-            obj.MissedBlocksMATLABCtr = joinArrays(obj.MissedBlocksMATLABCtr, simBLER, repeatedIdx, sortedIdx);
-            obj.MissedBlocksSRSCtr = joinArrays(obj.MissedBlocksSRSCtr, simBLERSRS, repeatedIdx, sortedIdx);
-            obj.DecIterationsSRSCtr = joinArrays(obj.DecIterationsSRSCtr, simIterSRS, repeatedIdx, sortedIdx);
-            obj.DecIterationsCRCOKSRSCtr = joinArrays(obj.DecIterationsCRCOKSRSCtr, simIterCRCOKSRS, ...
-                repeatedIdx, sortedIdx);
+            obj.storeResults(SNRIn, maxThroughput, simThroughput, simThroughputSRS, totalBlocks, ...
+                simBLER, simBLERSRS, simIterSRS, simIterCRCOKSRS);
         end % of function stepImpl()
 
         function resetImpl(obj)
@@ -1107,6 +1336,9 @@ classdef PUSCHBLER < matlab.System
             release(obj.EncodeULSCH);
             release(obj.DecodeULSCH);
             release(obj.DecodeULSCHsrs);
+            if ~isempty(obj.Engine)
+                release(obj.Engine);
+            end
         end
 
         function flag = isInactivePropertyImpl(obj, property)
@@ -1136,10 +1368,13 @@ classdef PUSCHBLER < matlab.System
                     flag = isempty(obj.ThroughputSRSCtr) || strcmp(obj.ImplementationType, 'matlab');
                 case {'SRSEstimatorType', 'SRSSmoothing', 'SRSInterpolation', 'SRSCompensateCFO'}
                     flag = strcmp(obj.ImplementationType, 'matlab') || obj.PerfectChannelEstimator;
-                case 'SRSEqualizerType'
+                case {'SRSEqualizerType', 'SoftbitWidth'}
                     flag = strcmp(obj.ImplementationType, 'matlab');
                 case 'CompIQwidth'
                     flag = ~obj.ApplyOFHCompression;
+                case {'NumThreads', 'ConfidenceLevel', 'IntervalType', 'TargetIntervalWidth', ...
+                        'TargetRelativeIntervalWidth', 'Seed'}
+                    flag = ~strcmp(obj.SimulationEngineType, 'MEX');
                 otherwise
                     flag = false;
             end
@@ -1168,15 +1403,17 @@ classdef PUSCHBLER < matlab.System
                 'NRxAnts', 'NTxAnts', 'NumLayers', ...
                 ... Channel model.
                 'FadingTimeEvolution', 'DelayProfile', 'DelaySpread', 'MaximumDopplerShift', ...
-                'CarrierFrequencyOffset', 'PerfectChannelEstimator', ...
+                'ChannelModelType', 'CarrierFrequencyOffset', 'PerfectChannelEstimator', ...
                 ... HARQ.
-                'EnableHARQ', ...
+                'EnableHARQ', 'SoftbitWidth', ...
                 ... Compression.
                 'ApplyOFHCompression', 'CompIQwidth', ...
                 ... Other simulation details.
                 'MaximumLDPCIterationCount', ...
                 'ImplementationType', 'SRSEqualizerType', 'SRSEstimatorType', 'SRSSmoothing', 'SRSInterpolation', ...
-                'SRSCompensateCFO', 'QuickSimulation', 'DisplaySimulationInformation', 'DisplayDiagnostics'};
+                'SRSCompensateCFO', 'SimulationEngineType', 'NumThreads', 'ConfidenceLevel', 'IntervalType', ...
+                'TargetIntervalWidth', 'TargetRelativeIntervalWidth', 'Seed', ...
+                'QuickSimulation', 'DisplaySimulationInformation', 'DisplayDiagnostics'};
             groups = matlab.mixin.util.PropertyGroup(confProps, 'Configuration');
 
             resProps = {};
@@ -1206,6 +1443,9 @@ classdef PUSCHBLER < matlab.System
                 s.EncodeULSCH = matlab.System.saveObject(obj.EncodeULSCH);
                 s.DecodeULSCH = matlab.System.saveObject(obj.DecodeULSCH);
                 s.DecodeULSCHsrs = matlab.System.saveObject(obj.DecodeULSCHsrs);
+                if ~isempty(obj.Engine)
+                    s.Engine = matlab.System.saveObject(obj.Engine);
+                end
                 s.SegmentCfg = obj.SegmentCfg;
 
                 % Save FFT size.
@@ -1237,6 +1477,9 @@ classdef PUSCHBLER < matlab.System
                 obj.EncodeULSCH = matlab.System.loadObject(s.EncodeULSCH);
                 obj.DecodeULSCH = matlab.System.loadObject(s.DecodeULSCH);
                 obj.DecodeULSCHsrs = matlab.System.loadObject(s.DecodeULSCHsrs);
+                if isfield(s, 'Engine')
+                    obj.Engine = matlab.System.loadObject(s.Engine);
+                end
                 obj.SegmentCfg = s.SegmentCfg;
 
                 % Load FFT size.
@@ -1262,6 +1505,30 @@ classdef PUSCHBLER < matlab.System
             if isfield(s, 'DecoderType')
                 obj.ImplementationType = s.DecoderType;
             end
+
+            % Objects saved before the srsRAN decoder managed the HARQ processes natively or before
+            % its softbuffers expired.
+            if wasInUse && ~isfield(obj.PUSCHExtension, 'RVSequence')
+                if obj.EnableHARQ
+                    obj.PUSCHExtension.RVSequence = [0 2 3 1];
+                else
+                    obj.PUSCHExtension.RVSequence = 0;
+                end
+            end
+            if wasInUse
+                expireTimeoutSlots = obj.PUSCHExtension.NHARQProcesses * numel(obj.PUSCHExtension.RVSequence);
+                nativeHARQ = strcmp(obj.ImplementationType, 'srs');
+                decoder = obj.DecodeULSCHsrs;
+                if (decoder.NativeHARQ ~= nativeHARQ) || (decoder.ExpireTimeoutSlots ~= expireTimeoutSlots) ...
+                        || (decoder.SoftbitWidth ~= obj.SoftbitWidth)
+                    obj.DecodeULSCHsrs = srsMEX.phy.srsPUSCHDecoder('MaxCodeblockSize', decoder.MaxCodeblockSize, ...
+                        'MaxSoftbuffers', decoder.MaxSoftbuffers, 'MaxCodeblocks', decoder.MaxCodeblocks, ...
+                        'ExpireTimeoutSlots', expireTimeoutSlots, 'SoftbitWidth', obj.SoftbitWidth, ...
+                        'NativeHARQ', nativeHARQ, 'RNTI', obj.RNTI, ...
+                        'HARQProcessSequence', 0:obj.PUSCHExtension.NHARQProcesses-1, ...
+                        'RVSequence', obj.PUSCHExtension.RVSequence);
+                end
+            end
         end % function loadObjectImpl(obj, s, wasInUse)
 
     end % of methods (Access = protected)
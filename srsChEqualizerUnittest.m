@@ -31,6 +31,10 @@
 %   testvectorGenerationCases - Generates a test vector according to the provided
 %                               parameters.
 %
+%   srsChEqualizerUnittest Methods (TestTags = {'testmex'}):
+%
+%   mexTest  - Tests the MEX-based channel equalizer.
+%
 %   srsChEqualizerUnittest Methods (Access = protected):
 %
 %   addTestIncludesToHeaderFile     - Adds include directives to the test header file.
@@ -217,6 +221,51 @@ classdef srsChEqualizerUnittest < srsTest.srsBlockUnittest
         end % of function testvectorGenerationCases
     end % methods (Test, TestTags = {'testvector'})
 
+    methods (Test, TestTags = {'testmex'})
+        function mexTest(obj, NumSymbols, channelSize, eqType)
+        %mexTest  Tests the MEX-based channel equalizer.
+        %   mexTest(OBJ, NUMSYMBOLS, CHANNELSIZE, EQTYPE) equalizes NUMSYMBOLS random
+        %   REs through a random channel of size CHANNELSIZE with the srsChannelEqualizer
+        %   MEX of type EQTYPE. The test is considered as passed if the equalized
+        %   symbols and noise variances match those of the MATLAB reference
+        %   srsLib.phy.upper.equalization.srsChannelEqualizer.
+            import srsTest.helpers.approxbf16
+            import srsLib.phy.upper.equalization.srsChannelEqualizer
+
+            NumRxPorts = channelSize(1);
+            NumLayers = channelSize(2);
+
+            % Random QPSK transmit symbols.
+            txSymbols = (2 * (randi([0, 1], NumSymbols, NumLayers) + 1j * randi([0, 1], NumSymbols, NumLayers)) ...
+                - (1 + 1j)) / sqrt(2);
+
+            % Random channel, with magnitude in (0.1, 1) and phase in (0, 2 * pi).
+            chEsts = (0.1 + 0.9 * rand(NumSymbols, NumRxPorts, NumLayers)) .* ...
+                exp(2j * pi * rand(NumSymbols, NumRxPorts, NumLayers));
+
+            noiseVar = 0.5 + rand();
+            rxSymbols = (randn(NumSymbols, NumRxPorts) + 1j * randn(NumSymbols, NumRxPorts)) * sqrt(noiseVar / 2);
+            for nt = 1:NumLayers
+                rxSymbols = rxSymbols + txSymbols(:, nt) .* chEsts(:, :, nt);
+            end
+
+            % The MEX works with BFloat16 samples (note that the MEX class name clashes with
+            % the imported MATLAB reference, hence the full name below).
+            rxSymbols = approxbf16(rxSymbols);
+            chEsts = approxbf16(chEsts);
+
+            [eqSymbolsRef, eqNoiseVarsRef] = srsChannelEqualizer(rxSymbols, chEsts, eqType, noiseVar, 1);
+
+            equalizer = srsMEX.phy.srsChannelEqualizer(EqualizerType=eqType);
+            [eqSymbols, eqNoiseVars] = equalizer(rxSymbols, chEsts, noiseVar);
+
+            obj.verifyEqual(eqSymbols, reshape(eqSymbolsRef, NumSymbols, NumLayers), 'RelTol', 0.01, 'AbsTol', 0.01, ...
+                'The MEX equalized symbols do not match the MATLAB reference.');
+            obj.verifyEqual(eqNoiseVars, reshape(eqNoiseVarsRef, NumSymbols, NumLayers), 'RelTol', 0.01, ...
+                'The MEX post-equalization noise variances do not match the MATLAB reference.');
+        end % of function mexTest
+    end % methods (Test, TestTags = {'testmex'})
+
     methods
         function [mseEmp, mseNom, snrEmp, snrNom] = MSEsimulation(obj, channelSize, eqType)
             %MSEsimulation Computes the expected (nominal) and empirical
@@ -25,6 +25,10 @@
 %   testvectorGenerationCases - Generates a test vector for the given modulation
 %                               scheme and number of symbols.
 %
+%   srsDemodulationMapperUnittest Methods (TestTags = {'testmex'}):
+%
+%   mexTest  - Tests the MEX-based implementation of the demodulation mapper.
+%
 %   srsDemodulationMapperUnittest Methods (Access = protected):
 %
 %   addTestIncludesToHeaderFile     - Adds include directives to the test header file.
@@ -150,4 +154,50 @@ classdef srsDemodulationMapperUnittest < srsTest.srsBlockUnittest
             testCase.addTestToHeaderFile(testCase.headerFileID, testCaseString);
         end % of function testvectorGenerationCases
     end % of methods (Test, TestTags = {'testvector'})
+
+    methods (Test, TestTags = {'testmex'})
+        function mexTest(testCase, nSymbols, Modulation)
+        %mexTest  Tests the MEX-based implementation of the demodulation mapper.
+        %   mexTest(TESTCASE, NSYMBOLS, MODULATION) demodulates NSYMBOLS noisy symbols
+        %   with modulation scheme MODULATION using the MEX and compares the resulting
+        %   LLRs with those of srsDemodulator. The symbols are repeated to span several
+        %   processing blocks inside the MEX.
+
+            import srsLib.phy.helpers.srsGetBitsSymbol
+            import srsLib.phy.upper.channel_modulation.srsDemodulator
+            import srsLib.phy.upper.channel_modulation.srsModulator
+            import srsMEX.phy.srsDemodulationMapper
+
+            % Make sure the MEX splits the symbols into several blocks.
+            nSymbolsTotal = nSymbols * 37;
+
+            bitsSymbol = srsGetBitsSymbol(Modulation);
+            codeword = randi([0 1], nSymbolsTotal * bitsSymbol, 1);
+            modulatedSymbols = srsModulator(codeword, Modulation);
+
+            normNoise = randn(nSymbolsTotal, 2) * [1; 1i] / sqrt(2);
+            noiseStd = 0.1 + 0.9 * rand(nSymbolsTotal, 1);
+            noiseVar = noiseStd.^2;
+            noisySymbols = modulatedSymbols + noiseStd .* normNoise;
+
+            % Cast to single precision to feed both implementations with the same input.
+            noisySymbols = double(single(noisySymbols));
+            noiseVar = double(single(noiseVar));
+
+            demapper = srsDemodulationMapper;
+            softBits = demapper(noisySymbols, Modulation, noiseVar);
+            expected = srsDemodulator(noisySymbols, Modulation, noiseVar);
+
+            testCase.verifyClass(softBits, 'int8', 'The LLRs should be of type int8.');
+            % Allow for rounding differences between the two implementations.
+            testCase.verifyEqual(double(softBits), double(expected(:)), AbsTol=1, ...
+                'The MEX LLRs do not match the reference ones.');
+
+            % Same noise variance for all symbols.
+            softBits = demapper(noisySymbols, Modulation, noiseVar(1));
+            expected = srsDemodulator(noisySymbols, Modulation, noiseVar(1));
+            testCase.verifyEqual(double(softBits), double(expected(:)), AbsTol=1, ...
+                'The MEX LLRs do not match the reference ones (scalar noise variance).');
+        end % of function mexTest
+    end % of methods (Test, TestTags = {'testmex'})
 end % of classdef srsDemodulationMapperUnittest
@@ -20,12 +20,18 @@
 %
 %   SequenceLength      - Length of the sequence.
 %   MaxCyclicShift      - Maximum number of sequence cyclic shifts.
+%   CollectionM         - Parameter m of the low-PAPR sequence collection.
 %
 %   srsLowPAPRSequenceUnittest Methods (TestTags = {'testvector'}):
 %
 %   testvectorGenerationCases - Generates a test vector according to the
 %                               provided parameters.
 %
+%   srsLowPAPRSequenceUnittest Methods (TestTags = {'testmex'}):
+%
+%   mexTestCollectionCache - Compares the low-PAPR sequence collections mapped from the
+%                            cache files with those of the srsRAN software factory.
+%
 %   srsLowPAPRSequenceUnittest Methods (Access = protected):
 %
 %   addTestIncludesToHeaderFile     - Adds include directives to the test header file.
@@ -74,6 +80,10 @@ classdef srsLowPAPRSequenceUnittest < srsTest.srsBlockUnittest
 
         %Carrier bandwidth in PRB.
         MaxCyclicShift = {8, 12}
+
+        %Collection parameter m (sequence length in PRB for delta = 0), covering both
+        %table-based (m = 1, 2) and Zadoff-Chu-based (m >= 3) sequences.
+        CollectionM = {1, 2, 4, 16}
     end
 
     methods (Access = protected)
@@ -152,4 +162,51 @@ classdef srsLowPAPRSequenceUnittest < srsTest.srsBlockUnittest
             testCase.addTestToHeaderFile(testCase.headerFileID, testCaseString);
         end % of function testvectorGenerationCases
     end % of methods (Test, TestTags = {'testvector'})
+
+    methods (Test, TestTags = {'testmex'})
+        function mexTestCollectionCache(testCase, CollectionM)
+        %mexTestCollectionCache Compares the low-PAPR sequence collections with parameter
+        %CollectionM built and mapped from the cache with those of the srsRAN software
+        %factory, element by element. Also checks that the cache directory is private and
+        %that a directory other users can write to is not used as a cache.
+
+            import matlab.unittest.fixtures.TemporaryFolderFixture
+            import srsMEX.phy.srsLowPAPRCollectionMEX
+
+            tmp = testCase.applyFixture(TemporaryFolderFixture);
+            alphas = single(2 * pi * (0:11) / 12);
+            delta = 0;
+
+            swSequences = srsLowPAPRCollectionMEX(CollectionM, delta, alphas, '');
+            testCase.assertSize(swSequences, [CollectionM * 12, numel(alphas), 2, 30], ...
+                'Wrong size of the software collection.');
+
+            % The first call builds the cache file, the second one maps it.
+            cacheDir = fullfile(tmp.Folder, 'cache');
+            builtSequences = srsLowPAPRCollectionMEX(CollectionM, delta, alphas, cacheDir);
+            cacheFiles = dir(fullfile(cacheDir, '*.bin'));
+            testCase.assertNumElements(cacheFiles, 1, 'The cache file was not written.');
+            mappedSequences = srsLowPAPRCollectionMEX(CollectionM, delta, alphas, cacheDir);
+            testCase.assertNumElements(dir(fullfile(cacheDir, '*.bin')), 1, 'The cache file was written again.');
+
+            testCase.verifyEqual(builtSequences, swSequences, ...
+                'The collection that built the cache differs from the software one.');
+            testCase.verifyEqual(mappedSequences, swSequences, ...
+                'The collection mapped from the cache differs from the software one.');
+
+            % The cache directory is only accessible by the user.
+            [~, attributes] = fileattrib(cacheDir);
+            testCase.verifyFalse(logical(attributes.GroupRead || attributes.GroupWrite || ...
+                attributes.OtherRead || attributes.OtherWrite), 'The cache directory is not private.');
+
+            % A directory other users can write to is ignored.
+            sharedDir = fullfile(tmp.Folder, 'shared');
+            mkdir(sharedDir);
+            fileattrib(sharedDir, '+w', 'g');
+            sharedSequences = srsLowPAPRCollectionMEX(CollectionM, delta, alphas, sharedDir);
+            testCase.verifyEmpty(dir(fullfile(sharedDir, '*.bin')), 'A shared directory was used as a cache.');
+            testCase.verifyEqual(sharedSequences, swSequences, ...
+                'The collection with a shared cache directory differs from the software one.');
+        end % of function mexTestCollectionCache
+    end % of methods (Test, TestTags = {'testmex'})
 end % of classdef srsLowPAPRSequenceUnittest
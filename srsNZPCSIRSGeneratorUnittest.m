@@ -29,6 +29,10 @@
 %   testvectorGenerationCases - Generates a test vectors according to the provided
 %                               parameters.
 %
+%   srsNZPCSIRSGeneratorUnittest Methods (TestTags = {'testmex'}):
+%
+%   mexTest  - Tests the MEX-based NZP-CSI-RS generator.
+%
 %   srsNZPCSIRSGeneratorUnittest Methods (Access = protected):
 %
 %   addTestIncludesToHeaderFile     - Adds include directives to the test header file.
@@ -266,6 +270,80 @@ classdef srsNZPCSIRSGeneratorUnittest < srsTest.srsBlockUnittest
             testCase.addTestToHeaderFile(testCase.headerFileID, testCaseString);
         end % of function testvectorGenerationCases
     end % of methods (Test, TestTags = {'testvector'})
+    methods (Test, TestTags = {'testmex'})
+        function mexTest(testCase, RowNumber, Density)
+        %mexTest  Tests the MEX-based NZP-CSI-RS generator.
+        %   mexTest(TESTCASE, ROWNUMBER, DENSITY) maps a set of two NZP-CSI-RS resources
+        %   and one ZP-CSI-RS resource with random NID and PRB allocation using the MEX
+        %   and compares the resource grid with the output of srsCSIRSnzp and the
+        %   reserved-RE bitmaps with the output of nrCSIRSIndices.
+
+            import srsLib.phy.upper.signal_processors.srsCSIRSnzp
+            import srsLib.phy.helpers.srsCSIRSGetNofFreqRefs
+            import srsLib.phy.helpers.srsCSIRSValidateConfig
+            import srsMEX.phy.srsNZPCSIRSGenerator
+
+            carrier = nrCarrierConfig( ...
+                NCellID=randi([0, 1007]), ...
+                NSizeGrid=52, ...
+                NStartGrid=10, ...
+                NFrame=randi([0, 1023]), ...
+                NSlot=randi([0, 9]));
+
+            amplitude = 0.1 * randi([1, 100]);
+
+            % The resources only differ in the first OFDM symbol and in the type.
+            symbolLocations = {2, 5, 9};
+            types = {'nzp', 'nzp', 'zp'};
+            nofKiRefs = srsCSIRSGetNofFreqRefs(RowNumber);
+            subcarrierLocations = {2 * (0:nofKiRefs-1).'};
+
+            nResources = numel(symbolLocations);
+            csirs = cell(nResources, 1);
+            nPorts = 1;
+            for iResource = 1:nResources
+                numRB = randi([4, carrier.NSizeGrid]);
+                csirs{iResource} = nrCSIRSConfig( ...
+                    Density=Density, ...
+                    RowNumber=RowNumber, ...
+                    SymbolLocations=symbolLocations(iResource), ...
+                    SubcarrierLocations=subcarrierLocations, ...
+                    NumRB=numRB, ...
+                    NID=randi([0, 1023]), ...
+                    RBOffset=randi([0, carrier.NSizeGrid - numRB]), ...
+                    CSIRSType=types{iResource}, ...
+                    CSIRSPeriod='on');
+                testCase.assumeTrue(srsCSIRSValidateConfig(carrier, csirs{iResource}), ...
+                    'The current configuration results in an invalid CSI-RS.');
+                nPorts = max(nPorts, csirs{iResource}.NumCSIRSPorts);
+            end
+
+            % Build the reference resource grid and bitmaps.
+            nSubcarriers = carrier.NSizeGrid * 12;
+            expectedGrid = complex(zeros(nSubcarriers, carrier.SymbolsPerSlot, nPorts));
+            expectedReserved = false(nSubcarriers, carrier.SymbolsPerSlot, nResources);
+            for iResource = 1:nResources
+                indices = nrCSIRSIndices(carrier, csirs{iResource}, 'IndexStyle', 'subscript', 'IndexBase', '1based');
+                reserved = false(nSubcarriers, carrier.SymbolsPerSlot);
+                reserved(sub2ind(size(reserved), indices(:, 1), indices(:, 2))) = true;
+                expectedReserved(:, :, iResource) = reserved;
+
+                if strcmp(types{iResource}, 'nzp')
+                    [symbols, indices] = srsCSIRSnzp(carrier, csirs{iResource}, amplitude);
+                    linIndices = sub2ind(size(expectedGrid), indices(:, 1) + 1, indices(:, 2) + 1, indices(:, 3) + 1);
+                    expectedGrid(linIndices) = expectedGrid(linIndices) + symbols;
+                end
+            end
+
+            CSIRSGen = srsNZPCSIRSGenerator(Amplitude=amplitude);
+            [txGrid, reserved] = CSIRSGen(carrier, csirs);
+
+            testCase.verifyEqual(double(txGrid), expectedGrid, AbsTol=1e-4, ...
+                'The CSI-RS resource grid does not match the reference one.');
+            testCase.verifyEqual(reserved, expectedReserved, ...
+                'The reserved-RE bitmaps do not match the reference ones.');
+        end % of function mexTest
+    end % of methods (Test, TestTags = {'testmex'})
 end % of classdef srsCSIRSUnittest
 
 function DensityStr = matlab2srsCSIRSDensity (Density)
@@ -27,6 +27,10 @@
 %   testvectorGenerationCases - Generates a test vector according to the provided
 %                               parameters.
 %
+%   srsPDCCHCandidatesUeUnittest Methods (TestTags = {'testmex'}):
+%
+%   mexTest  - Tests the MEX-based PDCCH candidate computation.
+%
 %   srsPDCCHCandidatesUeUnittest Methods (Access = protected):
 %
 %   addTestIncludesToHeaderFile     - Adds include directives to the test header file.
@@ -159,4 +163,53 @@ classdef srsPDCCHCandidatesUeUnittest < srsTest.srsBlockUnittest
             
         end % of function testvectorGenerationCases
     end % of methods (Test, TestTags = {'testvector'})
+
+    methods (Test, TestTags = {'testmex'})
+        function mexTest(testCase, numCCEs)
+        %mexTest  Tests the MEX-based PDCCH candidate computation.
+        %   mexTest(TESTCASE, NUMCCES) computes the candidates of a UE-specific search
+        %   space in a CORESET with NUMCCES CCEs for a batch of random RNTIs, using
+        %   srsPDCCHProcessor.getCandidates. The test is considered as passed if the
+        %   candidates match those returned by srsPDCCHCandidatesUE for each RNTI.
+
+            import srsLib.ran.pdcch.srsPDCCHCandidatesUE
+            import srsMEX.phy.srsPDCCHProcessor
+
+            % A CORESET has at most 45 groups of 6 resource blocks and 3 symbols.
+            duration = ceil(numCCEs / 45);
+            if duration > 3
+                return;
+            end
+            numGroups = numCCEs / duration;
+
+            % The CORESET spans the whole carrier, so that it has NUMCCES CCEs.
+            carrier = nrCarrierConfig(NSizeGrid=6 * numGroups, SubcarrierSpacing=30);
+            carrier.NSlot = randi([0, carrier.SlotsPerFrame - 1]);
+            coreset = nrCORESETConfig( ...
+                FrequencyResources=ones(1, numGroups), ...
+                Duration=duration, ...
+                CORESETID=randi([1, 11]));
+
+            numCandidates = min(floor(numCCEs ./ [1, 2, 4, 8, 16]), 8);
+            searchSpace = nrSearchSpaceConfig( ...
+                SearchSpaceType='ue', ...
+                CORESETID=coreset.CORESETID, ...
+                NumCandidates=numCandidates);
+
+            rnti = randi([1, 65519], 100, 1);
+            candidates = srsPDCCHProcessor.getCandidates(carrier, coreset, searchSpace, rnti);
+
+            testCase.assertNumElements(candidates, 5, 'Wrong number of aggregation levels.');
+            for iAL = 1:5
+                aggregationLevel = 2^(iAL - 1);
+                expected = zeros(numCandidates(iAL), numel(rnti), 'uint32');
+                for iUE = 1:numel(rnti)
+                    expected(:, iUE) = srsPDCCHCandidatesUE(numCCEs, numCandidates(iAL), aggregationLevel, ...
+                        coreset.CORESETID, rnti(iUE), carrier.NSlot);
+                end
+                testCase.verifyEqual(candidates{iAL}, expected, ...
+                    sprintf('Candidates of aggregation level %d do not match.', aggregationLevel));
+            end
+        end % of function mexTest
+    end % of methods (Test, TestTags = {'testmex'})
 end % of classdef srsPDCCHCandidatesUeUnittest< srsTest.srsBlockUnittest
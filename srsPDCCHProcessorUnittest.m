@@ -30,6 +30,10 @@
 %   testvectorGenerationCases - Generates a test vector according to the provided
 %                               parameters.
 %
+%   srsPDCCHProcessorUnittest Methods (TestTags = {'testmex'}):
+%
+%   mexTest  - Tests the MEX-based PDCCH processor.
+%
 %   srsPDCCHProcessorUnittest Methods (Access = protected):
 %
 %   addTestIncludesToHeaderFile     - Adds include directives to the test header file.
@@ -293,4 +297,76 @@ classdef srsPDCCHProcessorUnittest < srsTest.srsBlockUnittest
         testCase.addTestToHeaderFile(testCase.headerFileID, testCaseString);
         end % of function testvectorGenerationCases
     end % of methods (Test, TestTags = {'testvector'})
+
+    methods (Test, TestTags = {'testmex'})
+        function mexTest(testCase, Duration, AggregationLevel)
+        %mexTest  Tests the MEX-based PDCCH processor.
+        %   mexTest(TESTCASE, DURATION, AGGREGATIONLEVEL) maps two random DCI messages,
+        %   allocated to two different candidates of the same UE-specific search space,
+        %   into the same resource grid using the srsPDCCHProcessor MEX. The test is
+        %   considered as passed if the resulting resource grid matches the one generated
+        %   with MATLAB nrDCIEncode, nrPDCCH and nrPDCCHResources functions.
+
+            import srsMEX.phy.srsPDCCHProcessor
+            import srsTest.helpers.approxbf16
+
+            carrier = nrCarrierConfig( ...
+                NCellID=randi([0, 1007]), ...
+                NSizeGrid=52);
+            carrier.NSlot = randi([0, carrier.SlotsPerFrame - 1]);
+
+            coreset = nrCORESETConfig( ...
+                FrequencyResources=ones(1, floor(carrier.NSizeGrid / 6)), ...
+                Duration=Duration, ...
+                CORESETID=randi([1, 10]));
+
+            numCandidates = min(floor(coreset.NCCE ./ [1, 2, 4, 8, 16]), 8);
+            iAL = log2(AggregationLevel) + 1;
+
+            % Two different candidates are needed.
+            if numCandidates(iAL) < 2
+                return;
+            end
+
+            searchSpace = nrSearchSpaceConfig( ...
+                SearchSpaceType='ue', ...
+                StartSymbolWithinSlot=randi([0, 14 - Duration]), ...
+                CORESETID=coreset.CORESETID, ...
+                NumCandidates=numCandidates);
+
+            rnti = randi([1, 65519]);
+            allocatedCandidates = randperm(numCandidates(iAL), 2);
+
+            nDCI = numel(allocatedCandidates);
+            pdcchList = cell(nDCI, 1);
+            dciBits = cell(nDCI, 1);
+            expectedGrid = nrResourceGrid(carrier, 1);
+            for iDCI = 1:nDCI
+                pdcch = nrPDCCHConfig( ...
+                    CORESET=coreset, ...
+                    SearchSpace=searchSpace, ...
+                    RNTI=rnti, ...
+                    AggregationLevel=AggregationLevel, ...
+                    AllocatedCandidate=allocatedCandidates(iDCI), ...
+                    DMRSScramblingID=randi([0, 65535]));
+
+                dciBits{iDCI} = randi([0, 1], randi([12, 70]), 1);
+                codeword = nrDCIEncode(dciBits{iDCI}, rnti, 108 * AggregationLevel);
+
+                [pdcchIndices, dmrsSymbols, dmrsIndices] = nrPDCCHResources(carrier, pdcch);
+                expectedGrid(pdcchIndices) = nrPDCCH(codeword, pdcch.DMRSScramblingID, rnti);
+                expectedGrid(dmrsIndices) = dmrsSymbols;
+
+                pdcchList{iDCI} = pdcch;
+            end
+
+            pdcchProcessor = srsPDCCHProcessor;
+            txGrid = pdcchProcessor(carrier, pdcchList, dciBits);
+
+            testCase.assertSize(txGrid, [carrier.NSizeGrid * 12, carrier.SymbolsPerSlot], ...
+                'Wrong resource grid dimensions.');
+            testCase.verifyEqual(double(txGrid), approxbf16(expectedGrid), 'AbsTol', 0.02, ...
+                'The MEX PDCCH resource grid does not match the MATLAB one.');
+        end % of function mexTest
+    end % of methods (Test, TestTags = {'testmex'})
 end % of classdef srsPDCCHProcessorUnittest< srsTest.srsBlockUnittest
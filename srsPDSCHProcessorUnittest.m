@@ -29,6 +29,10 @@
 %   testvectorGenerationCases - Generates a test vectors according to the provided
 %                               parameters.
 %
+%   srsPDSCHProcessorUnittest Methods (TestTags = {'testmex'}):
+%
+%   mexTest  - Tests the MEX-based PDSCH processor.
+%
 %   srsPDSCHProcessorUnittest Methods (Access = protected):
 %
 %   addTestIncludesToHeaderFile     - Adds include directives to the test header file.
@@ -387,4 +391,76 @@ classdef srsPDSCHProcessorUnittest < srsTest.srsBlockUnittest
 
         end % of function testvectorGenerationCases
     end % of methods (Test, TestTags = {'testvector'})
+
+    methods (Test, TestTags = {'testmex'})
+        function mexTest(testCase, Modulation)
+        %mexTest  Tests the MEX-based PDSCH processor.
+        %   mexTest(TESTCASE, MODULATION) generates two random PDSCH transmissions
+        %   with modulation MODULATION, occupying disjoint PRB ranges of the same
+        %   resource grid, using the srsPDSCHProcessor MEX. The test is considered as
+        %   passed if the resulting resource grid matches the one generated with
+        %   MATLAB nrDLSCH, nrPDSCH and nrPDSCHDMRS functions.
+
+            import srsMEX.phy.srsPDSCHProcessor
+            import srsTest.helpers.approxbf16
+
+            carrier = nrCarrierConfig( ...
+                NCellID=randi([0, 1007]), ...
+                SubcarrierSpacing=15 * randi([1, 2]), ...
+                NSizeGrid=52);
+            carrier.NSlot = randi([0, carrier.SlotsPerFrame - 1]);
+
+            % Split the grid into two disjoint allocations.
+            splitRB = randi([1, carrier.NSizeGrid - 1]);
+            prbSets = {0:splitRB - 1, splitRB:carrier.NSizeGrid - 1};
+
+            nPDSCH = numel(prbSets);
+            pdschList = cell(nPDSCH, 1);
+            trBlks = cell(nPDSCH, 1);
+            targetCodeRates = 0.1 + rand(nPDSCH, 1) * 0.7;
+            rvs = zeros(nPDSCH, 1);
+            numPorts = 1;
+            expectedGrid = nrResourceGrid(carrier, testCase.MaxNumLayers);
+            for iPDSCH = 1:nPDSCH
+                pdsch = nrPDSCHConfig;
+                pdsch.RNTI = randi([1, 65535]);
+                pdsch.NID = randi([0, 1023]);
+                pdsch.Modulation = Modulation;
+                pdsch.SymbolAllocation = testCase.SymbolAllocation;
+                pdsch.PRBSet = prbSets{iPDSCH};
+                pdsch.NumLayers = randi([1, testCase.MaxNumLayers]);
+                pdsch.DMRS.DMRSAdditionalPosition = randi([0, 3]);
+                pdsch.DMRS.NIDNSCID = randi([0, 65535]);
+                pdsch.DMRS.NSCID = randi([0, 1]);
+                numPorts = max(numPorts, pdsch.NumLayers);
+
+                [pdschIndices, pdschInfo] = nrPDSCHIndices(carrier, pdsch);
+                tbs = nrTBS(pdsch.Modulation, pdsch.NumLayers, numel(pdsch.PRBSet), pdschInfo.NREPerPRB, ...
+                    targetCodeRates(iPDSCH));
+                trBlk = randi([0, 1], tbs, 1);
+
+                encDL = nrDLSCH;
+                encDL.TargetCodeRate = targetCodeRates(iPDSCH);
+                setTransportBlock(encDL, trBlk);
+                codeword = encDL(pdsch.Modulation, pdsch.NumLayers, pdschInfo.G, rvs(iPDSCH));
+
+                % Map the expected symbols onto a grid with the maximum number of ports.
+                pdschGrid = nrResourceGrid(carrier, pdsch.NumLayers);
+                pdschGrid(pdschIndices) = nrPDSCH(carrier, pdsch, codeword);
+                pdschGrid(nrPDSCHDMRSIndices(carrier, pdsch)) = nrPDSCHDMRS(carrier, pdsch);
+                expectedGrid(:, :, 1:pdsch.NumLayers) = expectedGrid(:, :, 1:pdsch.NumLayers) + pdschGrid;
+
+                pdschList{iPDSCH} = pdsch;
+                trBlks{iPDSCH} = trBlk;
+            end
+
+            pdschProcessor = srsPDSCHProcessor;
+            txGrid = pdschProcessor(carrier, pdschList, trBlks, targetCodeRates, rvs);
+
+            testCase.assertSize(txGrid, [carrier.NSizeGrid * 12, carrier.SymbolsPerSlot, numPorts], ...
+                'Wrong resource grid dimensions.');
+            testCase.verifyEqual(double(txGrid), approxbf16(expectedGrid(:, :, 1:numPorts)), 'AbsTol', 0.02, ...
+                'The MEX PDSCH resource grid does not match the MATLAB one.');
+        end % of function mexTest
+    end % of methods (Test, TestTags = {'testmex'})
 end % of classdef srsPDSCHProcessorUnittest
@@ -30,6 +30,10 @@
 %   testvectorGenerationCases - Generates a test vectors according to the provided
 %                               parameters.
 %
+%   srsPRACHDemodulatorUnittest Methods (TestTags = {'testmex'}):
+%
+%   mexTest  - Tests the MEX-based PRACH demodulator.
+%
 %   srsPRACHDemodulatorUnittest Methods (Access = protected):
 %
 %   addTestIncludesToHeaderFile     - Adds include directives to the test header file.
@@ -68,6 +72,9 @@ classdef srsPRACHDemodulatorUnittest < srsTest.srsBlockUnittest
         %Preamble formats for FR2.
         PreambleFormatsFR2 = {'A1', 'A1/B1', 'A2', 'A2/B2', 'A3', ...
             'A3/B3', 'B1', 'B4', 'C0', 'C2'}
+
+        %Number of frequency-domain PRACH occasions.
+        NumFreqOccasions = 2
     end
 
     properties (ClassSetupParameter)
@@ -128,20 +135,16 @@ classdef srsPRACHDemodulatorUnittest < srsTest.srsBlockUnittest
 
     end % of methods (Access = protected)
 
-    methods (Test, TestTags = {'testvector'})
-        function testvectorGenerationCases(testCase, DuplexMode, CarrierBandwidth, RestrictedSet, ZeroCorrelationZone, RBOffset)
-        %testvectorGenerationCases Generates a test vector for the given
-        %   DuplexMode, CarrierBandwidth, RestrictedSet, 
-        %   ZeroCorrelationZone and RBOffset. The parameters SequenceIndex,
-        %   PreambleFormat and PreambleIndex are generated randomly.
-
-            import srsTest.helpers.writeComplexFloatFile
+    methods (Access = private)
+        function [waveform, PRACHSymbols, carrier, prach, gridset, info, PreambleIndices] = ...
+                generatePRACHWaveform(testCase, DuplexMode, CarrierBandwidth, RestrictedSet, ZeroCorrelationZone, RBOffset)
+        %generatePRACHWaveform Generates a PRACH waveform with NumFreqOccasions frequency-domain
+        %   occasions and all time-domain occasions of a randomly selected preamble format.
+        %   Each occasion carries a random preamble, whose index is returned in PreambleIndices.
+        %   The waveform is scaled so that its energy is equal to the energy of the PRACH sequences.
             import srsLib.phy.helpers.srsConfigurePRACH
             import srsLib.phy.upper.channel_processors.srsPRACHgenerator
 
-            % Generate a unique test ID
-            TestID = testCase.generateTestID;
-
             % Set parameters that depend on the duplex mode.
             switch DuplexMode
                 case 'FDD'
@@ -183,9 +186,6 @@ classdef srsPRACHDemodulatorUnittest < srsTest.srsBlockUnittest
                 RBOffset=RBOffset ...
                 );
 
-            % Select a symbolic number of frequency-domain occasions.
-            NumFreqOccasions = 2;
-
             % Get PRACH modulation information.
             PrachOfdmInfo = nrPRACHOFDMInfo(carrier, prach);
 
@@ -193,11 +193,12 @@ classdef srsPRACHDemodulatorUnittest < srsTest.srsBlockUnittest
             waveform = zeros(sum(PrachOfdmInfo.SymbolLengths), 1);
 
             % Prepare matrix with PRACH symbols to modulate.
-            PRACHSymbols = nan(prach.LRA, NumFreqOccasions, prach.NumTimeOccasions);
+            PRACHSymbols = nan(prach.LRA, testCase.NumFreqOccasions, prach.NumTimeOccasions);
+            PreambleIndices = nan(testCase.NumFreqOccasions, prach.NumTimeOccasions);
 
             % Generate a waveform for each time and frequency occasion.
             for TimeIndex = 1:prach.NumTimeOccasions
-                for FrequencyIndex = 1:NumFreqOccasions
+                for FrequencyIndex = 1:testCase.NumFreqOccasions
                     % Select time- and frequency-domain occasion.
                     prach.TimeIndex = TimeIndex - 1;
                     prach.FrequencyIndex = FrequencyIndex - 1;
@@ -216,7 +217,8 @@ classdef srsPRACHDemodulatorUnittest < srsTest.srsBlockUnittest
 
                     % Store PRACH sequence.
                     PRACHSymbols(:, FrequencyIndex, TimeIndex) = info.PRACHSymbols(1:prach.LRA);
-                end % for FrequencyIndex = NumFreqOccasions
+                    PreambleIndices(FrequencyIndex, TimeIndex) = prach.PreambleIndex;
+                end % for FrequencyIndex = testCase.NumFreqOccasions
             end % for TimeIndex = 0:prach.NumTimeOccasions
 
             % Correct waveform scaling for the demodulator: The Matlab
@@ -233,6 +235,25 @@ classdef srsPRACHDemodulatorUnittest < srsTest.srsBlockUnittest
             % Reset time and frequency indexes.
             prach.TimeIndex = 0;
             prach.FrequencyIndex = 0;
+        end % of function generatePRACHWaveform
+    end % of methods (Access = private)
+
+    methods (Test, TestTags = {'testvector'})
+        function testvectorGenerationCases(testCase, DuplexMode, CarrierBandwidth, RestrictedSet, ZeroCorrelationZone, RBOffset)
+        %testvectorGenerationCases Generates a test vector for the given
+        %   DuplexMode, CarrierBandwidth, RestrictedSet, 
+        %   ZeroCorrelationZone and RBOffset. The parameters SequenceIndex,
+        %   PreambleFormat and PreambleIndex are generated randomly.
+
+            import srsTest.helpers.writeComplexFloatFile
+
+            % Generate a unique test ID
+            TestID = testCase.generateTestID;
+
+            % Generate the PRACH waveform.
+            [waveform, PRACHSymbols, carrier, prach, gridset, info] = testCase.generatePRACHWaveform( ...
+                DuplexMode, CarrierBandwidth, RestrictedSet, ZeroCorrelationZone, RBOffset);
+            PreambleFormat = prach.Format;
 
             % Select the starting symbol within the slot and duration in symbols.
             StartSymbolWithinSlot = mod(prach.SymbolLocation, 14);
@@ -259,13 +280,13 @@ classdef srsPRACHDemodulatorUnittest < srsTest.srsBlockUnittest
 
             % srsran PRACH configuration
             srsPRACHConfig = {...
-                slotConfig, ...                       % slot
-                srsPRACHFormat, ...                   % format
-                max([1, prach.NumTimeOccasions]), ... % nof_td_occasions
-                max([1, NumFreqOccasions]), ...       % nof_fd_occasions
-                StartSymbolWithinSlot , ...           % start_symbol
-                prach.RBOffset, ...                   % rb_offset
-                carrier.NSizeGrid, ...                % nof_prb_ul_grid
+                slotConfig, ...                          % slot
+                srsPRACHFormat, ...                      % format
+                max([1, prach.NumTimeOccasions]), ...    % nof_td_occasions
+                max([1, testCase.NumFreqOccasions]), ... % nof_fd_occasions
+                StartSymbolWithinSlot , ...              % start_symbol
+                prach.RBOffset, ...                      % rb_offset
+                carrier.NSizeGrid, ...                   % nof_prb_ul_grid
                 };
 
             % test context
@@ -282,5 +303,44 @@ classdef srsPRACHDemodulatorUnittest < srsTest.srsBlockUnittest
             testCase.addTestToHeaderFile(testCase.headerFileID, testCaseString);
         end % of function testvectorGenerationCases
     end % of methods (Test, TestTags = {'testvector'})
-end % of classdef srsPRACHDemodulatorUnittest
 
+    methods (Test, TestTags = {'testmex'})
+        function mexTest(testCase, DuplexMode, CarrierBandwidth, RestrictedSet, ZeroCorrelationZone, RBOffset)
+        %mexTest  Tests the MEX-based PRACH demodulator.
+        %   mexTest(TESTCASE, DUPLEXMODE, CARRIERBANDWIDTH, RESTRICTEDSET, ZEROCORRELATIONZONE,
+        %   RBOFFSET) generates a PRACH waveform as in testvectorGenerationCases and
+        %   demodulates it with the srsPRACHDemodulator MEX. The test is considered as
+        %   passed if the demodulated symbols of all occasions match the transmitted PRACH
+        %   sequences and, for long preambles, if the chained PRACH detector finds the
+        %   transmitted preamble in all occasions.
+            import srsTest.helpers.approxbf16
+            import srsMEX.phy.srsPRACHDemodulator
+
+            [waveform, PRACHSymbols, carrier, prach, ~, ~, PreambleIndices] = testCase.generatePRACHWaveform( ...
+                DuplexMode, CarrierBandwidth, RestrictedSet, ZeroCorrelationZone, RBOffset);
+
+            demodulator = srsPRACHDemodulator(NumFreqOccasions=testCase.NumFreqOccasions);
+            symbols = demodulator(waveform, carrier, prach);
+
+            nTimeOccasions = max(1, prach.NumTimeOccasions);
+            testCase.verifySize(symbols, [prach.LRA, prach.PRACHDuration, 1, testCase.NumFreqOccasions, nTimeOccasions], ...
+                'The demodulated PRACH symbols do not have the expected size.');
+
+            % All OFDM symbols of an occasion carry the same sequence.
+            expected = repmat(reshape(approxbf16(PRACHSymbols), prach.LRA, 1, 1, testCase.NumFreqOccasions, ...
+                nTimeOccasions), 1, prach.PRACHDuration);
+            testCase.verifyEqual(symbols, expected, 'AbsTol', 0.02, ...
+                'The demodulated PRACH symbols do not match the transmitted PRACH sequences.');
+
+            % Chain the detector, which currently supports long preambles only.
+            if ismember(prach.Format, {'0', '1'})
+                detector = srsPRACHDemodulator(NumFreqOccasions=testCase.NumFreqOccasions, Detection=true);
+                detections = detector(waveform, carrier, prach);
+                for iOccasion = 1:numel(detections)
+                    testCase.verifyTrue(ismember(PreambleIndices(iOccasion), detections(iOccasion).PreambleIndices), ...
+                        sprintf('The preamble of occasion %d was not detected.', iOccasion));
+                end
+            end
+        end % of function mexTest
+    end % of methods (Test, TestTags = {'testmex'})
+end % of classdef srsPRACHDemodulatorUnittest
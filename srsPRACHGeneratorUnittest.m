@@ -30,6 +30,10 @@
 %   testvectorGenerationCases - Generates a test vectors according to the provided
 %                               parameters.
 %
+%   srsPRACHGeneratorUnittest Methods (TestTags = {'testmex'}):
+%
+%   mexTest  - Tests the MEX-based implementation of the PRACH generator.
+%
 %   srsPRACHGeneratorUnittest Methods (Access = protected):
 %
 %   addTestIncludesToHeaderFile     - Adds include directives to the test header file.
@@ -194,4 +198,61 @@ classdef srsPRACHGeneratorUnittest < srsTest.srsBlockUnittest
             testCase.addTestToHeaderFile(testCase.headerFileID, testCaseString);
         end % of function testvectorGenerationCases
     end % of methods (Test, TestTags = {'testvector'})
+
+    methods (Test, TestTags = {'testmex'})
+        function mexTest(testCase, DuplexMode, PreambleFormat, RestrictedSet, ZeroCorrelationZone)
+        %mexTest  Tests the MEX-based implementation of the PRACH generator.
+        %   mexTest(TESTCASE, DUPLEXMODE, PREAMBLEFORMAT, RESTRICTEDSET, ZEROCORRELATIONZONE)
+        %   generates a batch of PRACH sequences with random root sequence and preamble
+        %   indices using the MEX and compares them with the output of srsPRACHgenerator.
+        %   The batch is generated twice to check that the second call is served by the
+        %   sequence cache.
+
+            import srsLib.phy.helpers.srsConfigurePRACH
+            import srsLib.phy.upper.channel_processors.srsPRACHgenerator
+            import srsMEX.phy.srsPRACHGenerator
+
+            carrier = nrCarrierConfig;
+            switch DuplexMode
+                case 'FDD'
+                    carrier.SubcarrierSpacing = 15;
+                case 'TDD'
+                    carrier.SubcarrierSpacing = 30;
+                otherwise
+                    error('Invalid duplex mode %s', DuplexMode);
+            end
+
+            nSequences = 4;
+            prachList = cell(nSequences, 1);
+            expected = [];
+            for iSequence = 1:nSequences
+                prach = srsConfigurePRACH(PreambleFormat, ...
+                    DuplexMode=DuplexMode, ...
+                    SubcarrierSpacing=carrier.SubcarrierSpacing, ...
+                    SequenceIndex=randi([0, 1023]), ...
+                    PreambleIndex=randi([0, 63]), ...
+                    RestrictedSet=RestrictedSet, ...
+                    ZeroCorrelationZone=ZeroCorrelationZone);
+                [~, ~, info] = srsPRACHgenerator(carrier, prach);
+                prachList{iSequence} = prach;
+                expected = [expected, info.PRACHSymbols(1:prach.LRA)]; %#ok<AGROW>
+            end
+
+            PRACHGen = srsPRACHGenerator;
+            sequences = PRACHGen(prachList);
+            testCase.verifyEqual(sequences, expected, AbsTol=1e-5, ...
+                'The generated PRACH sequences do not match the reference ones.');
+
+            % The second batch must be read from the cache.
+            statsBefore = PRACHGen.cacheStatistics;
+            sequences = PRACHGen(prachList);
+            statsAfter = PRACHGen.cacheStatistics;
+            testCase.verifyEqual(sequences, expected, AbsTol=1e-5, ...
+                'The cached PRACH sequences do not match the reference ones.');
+            testCase.verifyEqual(statsAfter.Hits - statsBefore.Hits, nSequences, ...
+                'The second batch should be served by the cache.');
+            testCase.verifyEqual(statsAfter.Misses, statsBefore.Misses, ...
+                'The second batch should not generate new sequences.');
+        end % of function mexTest
+    end % of methods (Test, TestTags = {'testmex'})
 end % of classdef srsPRACHGeneratorUnittest
@@ -20,6 +20,7 @@
 %   SymbolAllocation        - Symbols allocated to the PUSCH transmission.
 %   PRBAllocation           - PRBs allocated to the PUSCH transmission.
 %   mcs                     - Modulation scheme index (0, 28).
+%   SoftbitWidth            - Number of bits of the compressed soft bits (4, 6).
 %
 %   srsPUSCHDecoderUnittest Methods (TestTags = {'testvector'}):
 %
@@ -28,7 +29,17 @@
 %
 %   srsPUSCHDecoderUnittest Methods (TestTags = {'testmex'}):
 %
-%   mexTest  - Tests the mex wrapper of the SRSRAN PUSCH decoder.
+%   mexTest        - Tests the mex wrapper of the SRSRAN PUSCH decoder.
+%   mexTestHARQ    - Tests the native HARQ entity of the mex wrapper of the SRSRAN
+%                    PUSCH decoder.
+%   mexTestExpiry  - Tests the softbuffer expiration of the mex wrapper of the SRSRAN
+%                    PUSCH decoder.
+%   mexTestCompressed - Tests the compressed softbuffers of the mex wrapper of the
+%                    SRSRAN PUSCH decoder.
+%   mexTestCheckpoint - Tests the checkpoints of the softbuffer pool of the mex wrapper
+%                    of the SRSRAN PUSCH decoder.
+%   mexTestCheckpointFullWidth - Tests that the full-width softbuffer pool with
+%                    checkpoints decodes as the SRSRAN softbuffer pool.
 %
 %   srsPUSCHDecoderUnittest Methods (Access = protected):
 %
@@ -79,6 +90,9 @@ classdef srsPUSCHDecoderUnittest < srsTest.srsBlockUnittest
 
         %Modulation and coding scheme index.
         mcs = num2cell(0:28)
+
+        %Number of bits of the compressed soft bits.
+        SoftbitWidth = {4, 6}
     end
 
     properties (Constant, Hidden)
@@ -371,5 +385,353 @@ classdef srsPUSCHDecoderUnittest < srsTest.srsBlockUnittest
             end
 
         end % of function mextest
+
+        function mexTestHARQ(obj, SymbolAllocation, PRBAllocation, mcs)
+        %mexTestHARQ  Tests the native HARQ entity of the mex wrapper of the SRSRAN PUSCH decoder.
+        %   mexTestHARQ(OBJ, SYMBOLALLOCATION, PRBALLOCATION, MCS) sets up the same simulation
+        %   as mexTest with a single HARQ process managed by the native HARQ entity of the
+        %   decoder. The first transmission of a first transport block is lost (random LLRs) and
+        %   the retransmission is received with no noise: the entity must schedule the
+        %   retransmission with the second RV and the decoder must recover the transport block.
+        %   All the transmissions of a second transport block are lost: the RV sequence must
+        %   time out. Finally, the test checks the statistics of the HARQ process.
+
+            import srsMEX.phy.srsPUSCHDecoder
+            import srsTest.helpers.bitPack
+
+            setupsimulation(obj, SymbolAllocation, PRBAllocation, mcs);
+
+            % Configure the PUSCH encoder.
+            multipleHARQProcesses = obj.MultipleHARQProcesses;
+            TargetCodeRateLoc = obj.TargetCodeRate;
+            ULSCHEncoder = nrULSCH( ...
+                MultipleHARQProcesses=multipleHARQProcesses, ...
+                TargetCodeRate=TargetCodeRateLoc ...
+                );
+
+            % Configure the SRS PUSCH decoder mex with a native HARQ entity.
+            ULSCHDecoder = srsPUSCHDecoder('MaxCodeblockSize', obj.ulschInfo.N, ...
+                'MaxSoftbuffers', 1, 'MaxCodeblocks', obj.ulschInfo.C, 'NativeHARQ', true, ...
+                'HARQProcessSequence', obj.HARQProcessID, 'RVSequence', obj.RVsequence);
+
+            % Fill segment configuration for the decoder.
+            segmentCfg = srsPUSCHDecoder.configureSegment(obj.Carrier, obj.PUSCH, ...
+                TargetCodeRateLoc, obj.NHARQProcesses);
+
+            nRVs = numel(obj.RVsequence);
+
+            % First transport block: the first transmission is lost.
+            TB = randi([0 1], obj.TransportBlockSize, 1);
+            setTransportBlock(ULSCHEncoder, TB, obj.HARQProcessID);
+
+            harqInfo = getHARQTransmission(ULSCHDecoder);
+            obj.assertTrue(harqInfo.NewData, 'The first transmission should carry new data.');
+
+            lostLLRs = int8(2 * randi([0 1], obj.encodedTBLength, 1) - 1);
+            [~, stats, harqInfo] = ULSCHDecoder(lostLLRs, segmentCfg);
+            obj.assertFalse(stats.CRCOK, 'A lost transmission should not pass the CRC.');
+            obj.assertEqual([harqInfo.HARQProcessID, harqInfo.TransmissionNumber, harqInfo.RedundancyVersion], ...
+                [obj.HARQProcessID, 1, obj.RVsequence(2)], 'Wrong retransmission.');
+            obj.assertFalse(harqInfo.NewData, 'A retransmission should not carry new data.');
+
+            % The retransmission is received with no noise.
+            cw = ULSCHEncoder(obj.Modulation, obj.NumLayers, obj.encodedTBLength, ...
+                harqInfo.RedundancyVersion, obj.HARQProcessID);
+            [rxTB, stats, harqInfo] = ULSCHDecoder(int8(60 - 120 * double(cw)), segmentCfg);
+            obj.assertTrue(stats.CRCOK, 'The retransmission should pass the CRC.');
+            obj.assertEqual(rxTB, uint8(bitPack(TB)), 'Decoding errors.');
+            obj.assertTrue(harqInfo.NewData && ~harqInfo.SequenceTimeout, ...
+                'The RV sequence should have ended successfully.');
+
+            % Second transport block: all transmissions are lost.
+            for iRV = 1:nRVs
+                lostLLRs = int8(2 * randi([0 1], obj.encodedTBLength, 1) - 1);
+                [~, stats, harqInfo] = ULSCHDecoder(lostLLRs, segmentCfg);
+                obj.assertFalse(stats.CRCOK, 'A lost transmission should not pass the CRC.');
+            end
+            obj.assertTrue(harqInfo.NewData && harqInfo.SequenceTimeout, 'The RV sequence should have timed out.');
+
+            % Check the statistics of the HARQ process.
+            harqStats = getHARQStatistics(ULSCHDecoder);
+            obj.assertEqual(harqStats.HARQProcessID, obj.HARQProcessID, 'Wrong HARQ process ID.');
+            obj.assertEqual([harqStats.NumTransmissions, harqStats.NumNewTransmissions, harqStats.NumTimeouts], ...
+                [2 + nRVs, 2, 1], 'Wrong number of transmissions or timeouts.');
+            obj.assertEqual(harqStats.NumSuccesses, [0, 1, zeros(1, nRVs - 2)], 'Wrong number of successes.');
+            obj.assertEqual(harqStats.SuccessfulBits, obj.TransportBlockSize, 'Wrong number of successful bits.');
+        end % of function mexTestHARQ
+
+        function mexTestExpiry(obj, mcs)
+        %mexTestExpiry  Tests the softbuffer expiration of the mex wrapper of the SRSRAN PUSCH decoder.
+        %   mexTestExpiry(OBJ, MCS) sets up the same simulation as mexTest over the entire
+        %   slot and BWP and a softbuffer pool whose softbuffers expire after two slots. The
+        %   first transmission of a transport block is lost: its softbuffer must stay in the
+        %   pool until it expires. The transport block is then sent again, as new data, and
+        %   received with no noise: its softbuffer must be released as soon as it is decoded.
+
+            import srsMEX.phy.srsPUSCHDecoder
+            import srsTest.helpers.bitPack
+
+            setupsimulation(obj, [0, 14], 0, mcs);
+
+            % Configure the PUSCH encoder.
+            multipleHARQProcesses = obj.MultipleHARQProcesses;
+            TargetCodeRateLoc = obj.TargetCodeRate;
+            ULSCHEncoder = nrULSCH( ...
+                MultipleHARQProcesses=multipleHARQProcesses, ...
+                TargetCodeRate=TargetCodeRateLoc ...
+                );
+
+            % Configure the SRS PUSCH decoder mex with a short expiration time.
+            expireTimeoutSlots = 2;
+            ULSCHDecoder = srsPUSCHDecoder('MaxCodeblockSize', obj.ulschInfo.N, ...
+                'MaxSoftbuffers', 1, 'MaxCodeblocks', obj.ulschInfo.C, 'ExpireTimeoutSlots', expireTimeoutSlots);
+
+            % Fill segment configuration for the decoder.
+            segmentCfg = srsPUSCHDecoder.configureSegment(obj.Carrier, obj.PUSCH, ...
+                TargetCodeRateLoc, obj.NHARQProcesses);
+            nCodeblocks = segmentCfg.NumCodeblocks;
+
+            % Fill the HARQ buffer ID.
+            HARQBufID.RNTI = 1;
+            HARQBufID.HARQProcessID = obj.HARQProcessID;
+            HARQBufID.NumCodeblocks = nCodeblocks;
+
+            TB = randi([0 1], obj.TransportBlockSize, 1);
+            setTransportBlock(ULSCHEncoder, TB, obj.HARQProcessID);
+
+            % The first transmission is lost: the softbuffer waits for a retransmission.
+            ULSCHDecoder.Slot = 0;
+            lostLLRs = int8(2 * randi([0 1], obj.encodedTBLength, 1) - 1);
+            [~, stats] = ULSCHDecoder(lostLLRs, true, segmentCfg, HARQBufID);
+            obj.assertFalse(stats.CRCOK, 'A lost transmission should not pass the CRC.');
+            status = getPoolStatus(ULSCHDecoder);
+            obj.assertEqual([status.NumBuffers, status.NumCodeblocks], [1, nCodeblocks], ...
+                'The softbuffer of a failed transmission should be reserved.');
+
+            % The decoder moves to the next slot by itself: the softbuffer is still there
+            % one slot before its expiration...
+            obj.assertEqual(ULSCHDecoder.Slot, expireTimeoutSlots - 1, 'The slot should advance after decoding.');
+            status = getPoolStatus(ULSCHDecoder);
+            obj.assertEqual([status.NumBuffers, status.NumExpiredBuffers], [1, 0], ...
+                'The softbuffer should not have expired yet.');
+
+            % ...and it is gone at its expiration.
+            ULSCHDecoder.Slot = expireTimeoutSlots;
+            status = getPoolStatus(ULSCHDecoder);
+            obj.assertEqual([status.Slot, status.NumBuffers, status.NumCodeblocks, status.NumExpiredBuffers], ...
+                [expireTimeoutSlots, 0, 0, 1], 'The softbuffer should have expired.');
+
+            % The transport block is sent again with no noise.
+            ULSCHDecoder.Slot = expireTimeoutSlots + 1;
+            cw = ULSCHEncoder(obj.Modulation, obj.NumLayers, obj.encodedTBLength, 0, obj.HARQProcessID);
+            [rxTB, stats] = ULSCHDecoder(int8(60 - 120 * double(cw)), true, segmentCfg, HARQBufID);
+            obj.assertTrue(stats.CRCOK, 'The new transmission should pass the CRC.');
+            obj.assertEqual(rxTB, uint8(bitPack(TB)), 'Decoding errors.');
+
+            % The decoder releases the softbuffer of a successful transmission.
+            status = getPoolStatus(ULSCHDecoder);
+            obj.assertEqual([status.NumBuffers, status.MaxNumBuffers, status.MaxNumCodeblocks, ...
+                status.NumExpiredBuffers], [0, 1, nCodeblocks, 1], 'Wrong pool occupancy.');
+        end % of function mexTestExpiry
+
+        function mexTestCompressed(obj, mcs, SoftbitWidth)
+        %mexTestCompressed  Tests the compressed softbuffers of the mex wrapper of the SRSRAN PUSCH decoder.
+        %   mexTestCompressed(OBJ, MCS, SOFTBITWIDTH) sets up the same simulation as mexTest
+        %   over the entire slot and BWP and a softbuffer pool of eight softbuffers storing
+        %   soft bits with SOFTBITWIDTH bits. The codeword is sent twice with no noise, each time with half
+        %   of its bits erased (even bits first, odd bits then): the decoder must recover
+        %   the transport block from the combination of the two transmissions, that is from
+        %   the compressed soft bits of the first one.
+
+            import srsMEX.phy.srsPUSCHDecoder
+            import srsTest.helpers.bitPack
+
+            setupsimulation(obj, [0, 14], 0, mcs);
+
+            % Configure the PUSCH encoder.
+            multipleHARQProcesses = obj.MultipleHARQProcesses;
+            TargetCodeRateLoc = obj.TargetCodeRate;
+            ULSCHEncoder = nrULSCH( ...
+                MultipleHARQProcesses=multipleHARQProcesses, ...
+                TargetCodeRate=TargetCodeRateLoc ...
+                );
+
+            % Configure the SRS PUSCH decoder mex with compressed softbuffers. The pool has
+            % room for several softbuffers.
+            nSoftbuffers = 8;
+            ULSCHDecoder = srsPUSCHDecoder('MaxCodeblockSize', obj.ulschInfo.N, 'MaxSoftbuffers', nSoftbuffers, ...
+                'MaxCodeblocks', nSoftbuffers * obj.ulschInfo.C, 'SoftbitWidth', SoftbitWidth);
+
+            % Fill segment configuration for the decoder.
+            segmentCfg = srsPUSCHDecoder.configureSegment(obj.Carrier, obj.PUSCH, ...
+                TargetCodeRateLoc, obj.NHARQProcesses);
+
+            % Fill the HARQ buffer ID.
+            HARQBufID.RNTI = 1;
+            HARQBufID.HARQProcessID = obj.HARQProcessID;
+            HARQBufID.NumCodeblocks = segmentCfg.NumCodeblocks;
+
+            TB = randi([0 1], obj.TransportBlockSize, 1);
+            setTransportBlock(ULSCHEncoder, TB, obj.HARQProcessID);
+            cw = ULSCHEncoder(obj.Modulation, obj.NumLayers, obj.encodedTBLength, 0, obj.HARQProcessID);
+            cwLLRs = 60 - 120 * double(cw);
+            isEven = (mod((1:obj.encodedTBLength).', 2) == 0);
+
+            % First transmission: only the even bits are received.
+            [rxTB, stats] = ULSCHDecoder(int8(cwLLRs .* isEven), true, segmentCfg, HARQBufID);
+
+            % Low code rates may not need the second half of the codeword.
+            if ~stats.CRCOK
+                status = getPoolStatus(ULSCHDecoder);
+                obj.assertLessThan(status.StorageBytes, status.FullWidthStorageBytes, ...
+                    'Compressed softbuffers should take less memory than full-width ones.');
+
+                % Second transmission: only the odd bits are received.
+                [rxTB, stats] = ULSCHDecoder(int8(cwLLRs .* ~isEven), false, segmentCfg, HARQBufID);
+            end
+            obj.assertTrue(stats.CRCOK, 'The combined transmissions should pass the CRC.');
+            obj.assertEqual(rxTB, uint8(bitPack(TB)), 'Decoding errors.');
+        end % of function mexTestCompressed
+
+        function mexTestCheckpoint(obj, mcs)
+        %mexTestCheckpoint  Tests the checkpoints of the softbuffer pool of the mex wrapper of the SRSRAN PUSCH decoder.
+        %   mexTestCheckpoint(OBJ, MCS) sets up the same simulation as mexTest over the entire
+        %   slot and BWP with a single HARQ process managed by the native HARQ entity of the
+        %   decoder. The first transmission of a transport block is lost (random LLRs), then
+        %   the decoder is saved, released and loaded back: the loaded decoder must resume the
+        %   RV sequence with the same softbuffer and HARQ state and decode the retransmission,
+        %   received with no noise.
+
+            import srsMEX.phy.srsPUSCHDecoder
+            import srsTest.helpers.bitPack
+
+            setupsimulation(obj, [0, 14], 0, mcs);
+
+            % Configure the PUSCH encoder.
+            multipleHARQProcesses = obj.MultipleHARQProcesses;
+            TargetCodeRateLoc = obj.TargetCodeRate;
+            ULSCHEncoder = nrULSCH( ...
+                MultipleHARQProcesses=multipleHARQProcesses, ...
+                TargetCodeRate=TargetCodeRateLoc ...
+                );
+
+            % Configure the SRS PUSCH decoder mex with a native HARQ entity and checkpoints.
+            checkpointFile = [tempname '.bin'];
+            matFile = [tempname '.mat'];
+            laterMatFile = [tempname '.mat'];
+            obj.addTeardown(@() delete(checkpointFile, matFile, laterMatFile));
+            ULSCHDecoder = srsPUSCHDecoder('MaxCodeblockSize', obj.ulschInfo.N, ...
+                'MaxSoftbuffers', 1, 'MaxCodeblocks', obj.ulschInfo.C, 'NativeHARQ', true, ...
+                'HARQProcessSequence', obj.HARQProcessID, 'RVSequence', obj.RVsequence, ...
+                'CheckpointFile', checkpointFile);
+
+            % Fill segment configuration for the decoder.
+            segmentCfg = srsPUSCHDecoder.configureSegment(obj.Carrier, obj.PUSCH, ...
+                TargetCodeRateLoc, obj.NHARQProcesses);
+
+            TB = randi([0 1], obj.TransportBlockSize, 1);
+            setTransportBlock(ULSCHEncoder, TB, obj.HARQProcessID);
+
+            % The first transmission is lost.
+            ULSCHDecoder.Slot = 0;
+            lostLLRs = int8(2 * randi([0 1], obj.encodedTBLength, 1) - 1);
+            [~, stats, harqInfo] = ULSCHDecoder(lostLLRs, segmentCfg);
+            obj.assertFalse(stats.CRCOK, 'A lost transmission should not pass the CRC.');
+
+            % Save the decoder and release its softbuffer pool, as "clear mex" would.
+            save(matFile, 'ULSCHDecoder');
+            release(ULSCHDecoder);
+            loaded = load(matFile, 'ULSCHDecoder');
+            ULSCHDecoder = loaded.ULSCHDecoder;
+
+            % The loaded decoder resumes the RV sequence.
+            obj.assertEqual(getHARQTransmission(ULSCHDecoder), harqInfo, 'Wrong HARQ state after loading.');
+            status = getPoolStatus(ULSCHDecoder);
+            obj.assertEqual([status.Slot, status.NumBuffers, status.NumCodeblocks], ...
+                [1, 1, segmentCfg.NumCodeblocks], 'Wrong softbuffer pool state after loading.');
+
+            % The retransmission is received with no noise, in the next slot.
+            cw = ULSCHEncoder(obj.Modulation, obj.NumLayers, obj.encodedTBLength, ...
+                harqInfo.RedundancyVersion, obj.HARQProcessID);
+            [rxTB, stats] = ULSCHDecoder(int8(60 - 120 * double(cw)), segmentCfg);
+            obj.assertTrue(stats.CRCOK, 'The retransmission should pass the CRC.');
+            obj.assertEqual(rxTB, uint8(bitPack(TB)), 'Decoding errors.');
+
+            % The statistics include the transmission before the checkpoint.
+            harqStats = getHARQStatistics(ULSCHDecoder);
+            obj.assertEqual([harqStats.NumTransmissions, harqStats.NumNewTransmissions], [2, 1], ...
+                'Wrong number of transmissions.');
+            obj.assertEqual(harqStats.NumSuccesses, [0, 1, zeros(1, numel(obj.RVsequence) - 2)], ...
+                'Wrong number of successes.');
+
+            % A later save with the same checkpoint file overwrites the checkpoint of the first
+            % saved decoder, which cannot be loaded anymore.
+            save(laterMatFile, 'ULSCHDecoder');
+            lastwarn('');
+            try
+                loaded = load(matFile, 'ULSCHDecoder'); %#ok<NASGU>
+                isRejected = contains(lastwarn, 'overwritten');
+            catch ME
+                isRejected = contains(ME.message, 'overwritten');
+            end
+            obj.assertTrue(isRejected, 'The overwritten checkpoint should not be loaded.');
+        end % of function mexTestCheckpoint
+
+        function mexTestCheckpointFullWidth(obj, mcs)
+        %mexTestCheckpointFullWidth  Tests that the full-width softbuffer pool with checkpoints decodes as the SRSRAN softbuffer pool.
+        %   mexTestCheckpointFullWidth(OBJ, MCS) sets up the same simulation as mexTest over the
+        %   entire slot and BWP. Enabling checkpoints replaces the SRSRAN softbuffer pool with the
+        %   srsRAN-matlab one: with 8-bit soft bits, two decoders with and without checkpoints
+        %   must return the same transport blocks and statistics for the same noisy transmissions
+        %   of a transport block.
+
+            import srsMEX.phy.srsPUSCHDecoder
+
+            setupsimulation(obj, [0, 14], 0, mcs);
+
+            % Configure the PUSCH encoder.
+            multipleHARQProcesses = obj.MultipleHARQProcesses;
+            TargetCodeRateLoc = obj.TargetCodeRate;
+            ULSCHEncoder = nrULSCH( ...
+                MultipleHARQProcesses=multipleHARQProcesses, ...
+                TargetCodeRate=TargetCodeRateLoc ...
+                );
+
+            % Configure two SRS PUSCH decoder mex with 8-bit soft bits, the second one with checkpoints.
+            checkpointFile = [tempname '.bin'];
+            decoderConfig = {'MaxCodeblockSize', obj.ulschInfo.N, 'MaxSoftbuffers', 1, ...
+                'MaxCodeblocks', obj.ulschInfo.C, 'SoftbitWidth', 8};
+            ULSCHDecoders = {srsPUSCHDecoder(decoderConfig{:}), ...
+                srsPUSCHDecoder(decoderConfig{:}, 'CheckpointFile', checkpointFile)};
+
+            % Fill segment configuration for the decoder.
+            segmentCfg = srsPUSCHDecoder.configureSegment(obj.Carrier, obj.PUSCH, ...
+                TargetCodeRateLoc, obj.NHARQProcesses);
+
+            % Fill the HARQ buffer ID.
+            HARQBufID.RNTI = 1;
+            HARQBufID.HARQProcessID = obj.HARQProcessID;
+            HARQBufID.NumCodeblocks = segmentCfg.NumCodeblocks;
+
+            TB = randi([0 1], obj.TransportBlockSize, 1);
+            setTransportBlock(ULSCHEncoder, TB, obj.HARQProcessID);
+
+            % Go through the RV sequence with noisy transmissions, the soft bits of the failed
+            % ones are combined with the next ones.
+            for rvIdx = 1:numel(obj.RVsequence)
+                rv = obj.RVsequence(rvIdx);
+                cw = ULSCHEncoder(obj.Modulation, obj.NumLayers, obj.encodedTBLength, rv, obj.HARQProcessID);
+                llrs = int8(20 - 40 * double(cw) + 40 * randn(size(cw)));
+                segmentCfg.RV = rv;
+
+                [rxTB0, stats0] = ULSCHDecoders{1}(llrs, rvIdx == 1, segmentCfg, HARQBufID);
+                [rxTB1, stats1] = ULSCHDecoders{2}(llrs, rvIdx == 1, segmentCfg, HARQBufID);
+                obj.assertEqual(rxTB1, rxTB0, 'The decoded transport blocks differ.');
+                obj.assertEqual(stats1, stats0, 'The decoding statistics differ.');
+                if stats0.CRCOK
+                    break;
+                end
+            end
+        end % of function mexTestCheckpointFullWidth
     end % of methods (Test, TestTags = {'testmex'})
 end % of classdef srsPUSCHDecoderUnittest
@@ -28,7 +28,8 @@
 %
 %   srsPUSCHDemodulatorUnittest Methods (TestTags = {'testmex'}):
 %
-%   mexTest  - Tests the MEX-based implementation of the PUSCH demodulator.
+%   mexTest            - Tests the MEX-based implementation of the PUSCH demodulator.
+%   mexTestDemultiplex - Tests the PUSCH demodulator MEX with integrated UL-SCH demultiplexing.
 %
 %   srsPUSCHDemodulatorUnittest Methods (Access = protected):
 %
@@ -562,5 +563,58 @@ classdef srsPUSCHDemodulatorUnittest < srsTest.srsBlockUnittest
             % iv) Compare srsRAN and MATLAB results.
             obj.assertEqual(schSoftBits, int8(schSoftBitsMatlab), 'Demodulation errors.', AbsTol = int8(1));
         end % of function mextest
+
+        function mexTestDemultiplex(obj, DMRSConfigurationType, Modulation)
+        %mexTestDemultiplex  Tests the PUSCH demodulator MEX with integrated UL-SCH demultiplexing.
+        %   mexTestDemultiplex(OBJ, DMRSCONFIGURATIONTYPE, MODULATION) demodulates a
+        %   single-layer PUSCH transmission using DM-RS type DMRSCONFIGURATIONTYPE and symbol
+        %   modulation MODULATION with property DemultiplexUCI set to true. The test is
+        %   considered as passed if the four outputs coincide with those of the standalone
+        %   srsULSCHDemultiplex applied to the soft bits of the plain PUSCH demodulator.
+
+            import srsMEX.phy.srsPUSCHDemodulator
+            import srsMEX.phy.srsULSCHDemultiplex
+
+            NumRxPorts = 2;
+            NumLayers = 1;
+            setupsimulation(obj, DMRSConfigurationType, Modulation, NumRxPorts, NumLayers, 0);
+
+            % Generate receive grid.
+            rxGrid = nrResourceGrid(obj.carrier, NumRxPorts);
+            for Nr = 1:NumRxPorts
+                rxGrid(:, :, Nr) = obj.ce(:, :, Nr, 1) .* obj.txGrid(:, :, 1);
+            end
+            noiseVar = rand() * 0.0099 + 0.0001;
+            rxGrid = rxGrid + (randn(size(rxGrid)) + 1j * randn(size(rxGrid))) * sqrt(noiseVar / 2);
+
+            gridSize = size(rxGrid);
+            dmrsIx = sub2ind(gridSize(1:2), obj.puschDmrsIndices(:, 1) + 1, obj.puschDmrsIndices(:, 2) + 1);
+
+            % Demultiplexer configuration with all UCI types.
+            targetCodeRate = 0.5;
+            [~, puschInfo] = nrPUSCHIndices(obj.carrier, obj.pusch);
+            tbs = nrTBS(obj.pusch.Modulation, NumLayers, numel(obj.pusch.PRBSet), puschInfo.NREPerPRB, targetCodeRate);
+            nofHarqAckBits = 4;
+            nofCsiPart1Bits = 12;
+            nofCsiPart2Bits = 6;
+            demuxConfig = srsULSCHDemultiplex.createConfiguration(obj.carrier, obj.pusch, targetCodeRate, tbs, ...
+                nofHarqAckBits, nofCsiPart1Bits, nofCsiPart2Bits);
+
+            % Reference: demodulation followed by the standalone demultiplexer.
+            PUSCHDemodulator = srsPUSCHDemodulator;
+            codeword = PUSCHDemodulator(rxGrid, obj.ce, noiseVar, obj.pusch, obj.puschTxIndices, dmrsIx, obj.rxPorts);
+            demux = srsULSCHDemultiplex;
+            [schData, harqAck, csiPart1, csiPart2] = demux(codeword, obj.pusch, demuxConfig);
+
+            % Demodulation with integrated demultiplexing.
+            PUSCHDemodulatorDemux = srsPUSCHDemodulator(DemultiplexUCI=true);
+            [schDataMEX, harqAckMEX, csiPart1MEX, csiPart2MEX] = PUSCHDemodulatorDemux(rxGrid, obj.ce, noiseVar, ...
+                obj.pusch, obj.puschTxIndices, dmrsIx, obj.rxPorts, demuxConfig);
+
+            obj.verifyEqual(schDataMEX, schData, 'UL-SCH data soft bits do not match.');
+            obj.verifyEqual(harqAckMEX, harqAck, 'HARQ-ACK soft bits do not match.');
+            obj.verifyEqual(csiPart1MEX, csiPart1, 'CSI Part 1 soft bits do not match.');
+            obj.verifyEqual(csiPart2MEX, csiPart2, 'CSI Part 2 soft bits do not match.');
+        end % of function mexTestDemultiplex
     end % of methods (Test, TestTags = {'testmex'})
 end % of classdef srsPUSCHDemodulatorUnittest
@@ -22,12 +22,18 @@
 %   nofHarqAck       - Number of HARQ-ACK feedback bits multiplexed.
 %   nofCsiBits       - Number of CSI-Part1 and CSI-Part2 report bits multiplexed.
 %   NumRxPorts       - Number of receive antenna ports for PUSCH.
+%   TxModulation     - PUSCH modulation scheme (PUSCH transmitter MEX test).
+%   NumLayers        - Number of transmission layers (PUSCH transmitter MEX test).
 %
 %   srsPUSCHProcessorUnittest Methods (TestTags = {'testvector'}):
 %
 %   testvectorGenerationCases - Generates a test vector according to the provided
 %                               parameters.
 %
+%   srsPUSCHProcessorUnittest Methods (TestTags = {'testmex'}):
+%
+%   mexTest  - Tests the MEX-based PUSCH transmitter.
+%
 %   srsPUSCHProcessorUnittest Methods (Access = protected):
 %
 %   addTestIncludesToHeaderFile     - Adds include directives to the test header file.
@@ -93,6 +99,12 @@ classdef srsPUSCHProcessorUnittest < srsTest.srsBlockUnittest
 
         %Number of receive antenna ports for PUSCH.
         NumRxPorts = {1, 2, 4};
+
+        %Modulation scheme of the PUSCH transmission (only for the MEX test).
+        TxModulation = {'pi/2-BPSK', 'QPSK', '16QAM', '64QAM', '256QAM'};
+
+        %Number of transmission layers (only for the MEX test).
+        NumLayers = {1, 2, 4};
     end
 
     methods (Access = protected)
@@ -448,4 +460,78 @@ classdef srsPUSCHProcessorUnittest < srsTest.srsBlockUnittest
 
         end % of function testvectorGenerationCases
     end % of methods (Test, TestTags = {'testvector'})
+
+    methods (Test, TestTags = {'testmex'})
+        function mexTest(obj, TxModulation, NumLayers)
+        %mexTest  Tests the MEX-based PUSCH transmitter.
+        %   mexTest(OBJ, TXMODULATION, NUMLAYERS) generates a random PUSCH
+        %   transmission with modulation TXMODULATION and NUMLAYERS transmission
+        %   layers using the srsPUSCHTransmitter MEX. The test is considered as
+        %   passed if the resulting resource grid matches the one generated with
+        %   MATLAB nrULSCH, nrPUSCH and nrPUSCHDMRS functions.
+
+            import srsMEX.phy.srsPUSCHTransmitter
+            import srsMEX.phy.srsPUSCHDecoder
+            import srsTest.helpers.approxbf16
+
+            % pi/2-BPSK requires transform precoding, which is only possible with one layer.
+            obj.assumeTrue(~strcmp(TxModulation, 'pi/2-BPSK') || (NumLayers == 1), ...
+                'pi/2-BPSK is only supported with transform precoding, i.e., with one layer.');
+            TransformPrecoding = strcmp(TxModulation, 'pi/2-BPSK') || ((NumLayers == 1) && (randi([0, 1]) == 1));
+
+            % Random carrier configuration.
+            carrier = nrCarrierConfig;
+            carrier.NCellID = randi([0, 1007]);
+            carrier.SubcarrierSpacing = 15 * randi([1, 2]);
+            carrier.NSizeGrid = 52;
+            carrier.NSlot = randi([0, carrier.SlotsPerFrame - 1]);
+
+            % Random contiguous frequency allocation.
+            if TransformPrecoding
+                validNumPRB = obj.ValidNumPRB(obj.ValidNumPRB <= carrier.NSizeGrid);
+                numPRB = validNumPRB(randi([1, numel(validNumPRB)]));
+            else
+                numPRB = randi([1, carrier.NSizeGrid]);
+            end
+            startPRB = randi([0, carrier.NSizeGrid - numPRB]);
+
+            pusch = nrPUSCHConfig;
+            pusch.Modulation = TxModulation;
+            pusch.NumLayers = NumLayers;
+            pusch.TransformPrecoding = TransformPrecoding;
+            pusch.PRBSet = startPRB + (0:numPRB - 1);
+            pusch.RNTI = randi([1, 65535]);
+            pusch.NID = randi([0, 1023]);
+            pusch.DMRS.DMRSConfigurationType = 1 + (~TransformPrecoding && (randi([0, 1]) == 1));
+            pusch.DMRS.DMRSAdditionalPosition = randi([0, 3]);
+            pusch.DMRS.NumCDMGroupsWithoutData = 2;
+            pusch.DMRS.NIDNSCID = randi([0, 65535]);
+            pusch.DMRS.NSCID = randi([0, 1]);
+            pusch.DMRS.NRSID = randi([0, 1007]);
+
+            % Transport block and segmentation.
+            targetCodeRate = 0.1 + 0.7 * rand();
+            segCfg = srsPUSCHDecoder.configureSegment(carrier, pusch, targetCodeRate);
+            segCfg.RV = randi([0, 3]);
+            trBlk = randi([0, 1], segCfg.TransportBlockLength, 1);
+
+            % Generate the grid with MATLAB.
+            [puschIndices, puschInfo] = nrPUSCHIndices(carrier, pusch);
+            encUL = nrULSCH;
+            encUL.TargetCodeRate = targetCodeRate;
+            setTransportBlock(encUL, trBlk);
+            codeword = encUL(pusch.Modulation, pusch.NumLayers, puschInfo.G, segCfg.RV);
+
+            betaDMRS = sqrt(2);
+            refGrid = nrResourceGrid(carrier, NumLayers);
+            refGrid(puschIndices) = nrPUSCH(carrier, pusch, codeword);
+            refGrid(nrPUSCHDMRSIndices(carrier, pusch)) = nrPUSCHDMRS(carrier, pusch) * betaDMRS;
+
+            % Generate the grid with the MEX.
+            PUSCHTransmitter = srsPUSCHTransmitter(DMRSAmplitude = betaDMRS);
+            txGrid = PUSCHTransmitter(carrier, pusch, trBlk, segCfg);
+
+            obj.assertEqual(double(txGrid), approxbf16(refGrid), 'Resource grid mismatch.', AbsTol = 0.02);
+        end % of function mexTest
+    end % of methods (Test, TestTags = {'testmex'})
 end % of classdef srsPUSCHProcessorUnittest
@@ -28,6 +28,10 @@
 %   testvectorGenerationCases - Generates a test vectors according to the provided
 %                               parameters.
 %
+%   srsSRSEstimatorUnittest Methods (TestTags = {'testmex'}):
+%
+%   mexTest  - Tests the MEX-based SRS channel estimator.
+%
 %   srsSRSEstimatorUnittest Methods (Access = protected):
 %
 %   addTestIncludesToHeaderFile     - Adds include directives to the test header file.
@@ -328,6 +332,80 @@ classdef srsSRSEstimatorUnittest < srsTest.srsBlockUnittest
             testCase.addTestToHeaderFile(testCase.headerFileID, testCaseString);
         end % of function testvectorGenerationCases
     end % of methods (Test, TestTags = {'testvector'})
+
+    methods (Test, TestTags = {'testmex'})
+        function mexTest(testCase, NumSRSSymbols, NumRxPorts, KTC)
+        %mexTest  Tests the MEX-based SRS channel estimator.
+        %   mexTest(TESTCASE, NUMSRSSYMBOLS, NUMRXPORTS, KTC) generates KTC SRS
+        %   transmissions occupying NUMSRSSYMBOLS OFDM symbols, each one from a
+        %   different UE and with a different comb offset, through random channels
+        %   with NUMRXPORTS receive ports. The channels of all UEs are estimated with
+        %   one call to the srsSRSEstimator MEX. The test is considered as passed if
+        %   all estimated channel matrices match the generated ones.
+
+            import srsMEX.phy.srsSRSEstimator
+            import srsLib.phy.helpers.srsSRSValidateConfig
+
+            carrier = nrCarrierConfig( ...
+                NCellID=randi([0, 1007]), ...
+                SubcarrierSpacing=15 * randi([1, 2]), ...
+                NSizeGrid=52, ...
+                NFrame=randi([0, 1023]));
+            carrier.NSlot = randi([0, carrier.SlotsPerFrame - 1]);
+
+            % Common SRS allocation, the UEs are multiplexed by means of the comb offset.
+            symbolStart = randi([0, 14 - NumSRSSymbols]);
+            srsCommon = struct();
+            while ~srsSRSValidateConfig(carrier, srsCommon)
+                BSRS = randi([0, 3]);
+                srsCommon = nrSRSConfig( ...
+                    'SymbolStart', symbolStart, ...
+                    'NumSRSSymbols', NumSRSSymbols, ...
+                    'FrequencyStart', randi([0, 10]), ...
+                    'CSRS', randi([0, 20]), ...
+                    'BSRS', BSRS, ...
+                    'BHop', randi([BSRS, 3]), ...
+                    'KTC', KTC, ...
+                    'NRRC', randi([0, 67]));
+            end
+
+            nUEs = KTC;
+            srsList = cell(nUEs, 1);
+            channels = cell(nUEs, 1);
+            rxGrid = nrResourceGrid(carrier, NumRxPorts);
+            for iUE = 1:nUEs
+                srs = srsCommon;
+                srs.NumSRSPorts = randi([1, 2]);
+                srs.KBarTC = iUE - 1;
+                srs.NSRSID = randi([0, 1023]);
+                srs.CyclicShift = randi([0, 7]);
+
+                txGrid = nrResourceGrid(carrier, srs.NumSRSPorts);
+                txGrid(nrSRSIndices(carrier, srs)) = nrSRS(carrier, srs);
+
+                H = exp(2i * pi * rand(NumRxPorts, srs.NumSRSPorts)) / sqrt(srs.NumSRSPorts);
+                for iRx = 1:NumRxPorts
+                    for iTx = 1:srs.NumSRSPorts
+                        rxGrid(:, :, iRx) = rxGrid(:, :, iRx) + H(iRx, iTx) * txGrid(:, :, iTx);
+                    end
+                end
+
+                srsList{iUE} = srs;
+                channels{iUE} = H;
+            end
+
+            srsEstimator = srsSRSEstimator;
+            est = srsEstimator(rxGrid, carrier, srsList);
+
+            testCase.assertSize(est, [nUEs, 1], 'Wrong number of SRS estimates.');
+            for iUE = 1:nUEs
+                testCase.verifyEqual(est(iUE).ChannelMatrix, channels{iUE}, 'AbsTol', 0.02, ...
+                    sprintf('Wrong channel matrix for UE %d.', iUE));
+                testCase.verifyEqual(est(iUE).TimeAlignment, 0, 'AbsTol', 1e-8, ...
+                    sprintf('Wrong time alignment for UE %d.', iUE));
+            end
+        end % of function mexTest
+    end % of methods (Test, TestTags = {'testmex'})
 end % of classdef srsSRSUnittest
 
 
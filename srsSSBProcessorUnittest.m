@@ -30,6 +30,10 @@
 %                                SSBs within a set, SSB index and half-frame, while using
 %                                random NCellID and cw for each test.
 %
+%   srsSSBProcessorUnittest Methods (Test, TestTags = {'testmex'}):
+%
+%   mexTest  - Tests the MEX-based SSB processor.
+%
 %   srsSSBProcessorUnittest Methods (Access = protected):
 %
 %   addTestIncludesToHeaderFile     - Adds include directives to the test header file.
@@ -227,4 +231,95 @@ classdef srsSSBProcessorUnittest < srsTest.srsBlockUnittest
             end
         end % of function testvectorGenerationCases
     end % of methods (Test, TestTags = {'testvector'})
+    methods (Test, TestTags = {'testmex'})
+        function mexTest(testCase, SSBpattern, PSSscale)
+        %mexTest  Tests the MEX-based SSB processor.
+        %   mexTest(TESTCASE, SSBPATTERN, PSSSCALE) maps the full SS/PBCH block bursts of
+        %   two cells with random NCellID, SFN and MIB into one half-frame resource grid
+        %   using the MEX and compares it with the grid built from the outputs of srsPSS,
+        %   srsSSS, srsPBCHdmrs, srsPBCHencoder and srsPBCHmodulator. The burst is mapped
+        %   twice to check that the second call is served by the signal cache.
+
+            import srsLib.phy.helpers.srsSSBgetNumerology
+            import srsLib.phy.helpers.srsSSBgetFirstSymbolIndex
+            import srsLib.phy.helpers.srsSSBgetFirstSubcarrierIndex
+            import srsLib.phy.upper.signal_processors.srsPSS
+            import srsLib.phy.upper.signal_processors.srsSSS
+            import srsLib.phy.upper.signal_processors.srsPBCHdmrs
+            import srsLib.phy.upper.channel_processors.ssb.srsPBCHencoder
+            import srsLib.phy.upper.channel_processors.ssb.srsPBCHmodulator
+            import srsMEX.phy.srsSSBProcessor
+
+            numerology = srsSSBgetNumerology(SSBpattern);
+            carrier = nrCarrierConfig(SubcarrierSpacing=15 * 2^numerology, NSizeGrid=52);
+            nSymbols = carrier.SymbolsPerSlot * carrier.SlotsPerSubframe * 5;
+
+            if any(strcmp(SSBpattern, {'D', 'E'}))
+                LmaxLoc = 64;
+            else
+                LmaxLoc = 8;
+            end
+
+            % The two cells are mapped onto different ports and frequency positions.
+            nCells = 2;
+            pointAOffsets = [0, 20];
+            cellIDs = randperm(1008, nCells) - 1;
+            SFNLoc = randi([0, 1023]);
+            nHF = randi([0, 1]);
+            SSBoffset = 0;
+
+            expected = complex(zeros(carrier.NSizeGrid * 12, nSymbols, nCells));
+            ssb = [];
+            for iCell = 1:nCells
+                NCellIDLoc = cellIDs(iCell);
+                MIB = randi([0, 1], 24, 1);
+                firstSubcarrier = srsSSBgetFirstSubcarrierIndex(numerology, pointAOffsets(iCell), SSBoffset);
+                for SSBindexLoc = 0:LmaxLoc-1
+                    firstSymbol = srsSSBgetFirstSymbolIndex(SSBpattern, SSBindexLoc);
+
+                    [PSSsymbols, PSSindices] = srsPSS(NCellIDLoc);
+                    PSSsymbols = 10^(PSSscale / 20) * PSSsymbols;
+                    [SSSsymbols, SSSindices] = srsSSS(NCellIDLoc);
+                    cw = srsPBCHencoder(MIB, NCellIDLoc, SSBindexLoc, LmaxLoc, SFNLoc, nHF, SSBoffset);
+                    [PBCHsymbols, PBCHindices] = srsPBCHmodulator(cw, NCellIDLoc, SSBindexLoc, LmaxLoc);
+                    [DMRSsymbols, DMRSindices] = srsPBCHdmrs(NCellIDLoc, SSBindexLoc, LmaxLoc, nHF);
+
+                    symbols = [PSSsymbols; SSSsymbols; PBCHsymbols; DMRSsymbols];
+                    indices = [PSSindices; SSSindices; PBCHindices; DMRSindices];
+                    linIndices = sub2ind(size(expected), indices(:, 1) + firstSubcarrier + 1, ...
+                        indices(:, 2) + firstSymbol + 1, iCell * ones(size(symbols)));
+                    expected(linIndices) = expected(linIndices) + symbols;
+
+                    ssb = [ssb; struct( ...
+                        'NCellID', NCellIDLoc, ...
+                        'SSBPattern', SSBpattern, ...
+                        'Lmax', LmaxLoc, ...
+                        'SSBIndex', SSBindexLoc, ...
+                        'SFN', SFNLoc, ...
+                        'HalfFrame', nHF, ...
+                        'KSSB', SSBoffset, ...
+                        'PointAOffset', pointAOffsets(iCell), ...
+                        'MIB', MIB, ...
+                        'PSSPowerOffset', PSSscale, ...
+                        'Port', iCell - 1)]; %#ok<AGROW>
+                end
+            end
+
+            SSBProc = srsSSBProcessor;
+            txGrid = SSBProc(carrier, ssb);
+            testCase.verifyEqual(double(txGrid), expected, AbsTol=1e-5, ...
+                'The SS/PBCH block burst does not match the reference one.');
+
+            % The second burst must use the cached signals.
+            statsBefore = SSBProc.cacheStatistics;
+            txGrid = SSBProc(carrier, ssb);
+            statsAfter = SSBProc.cacheStatistics;
+            testCase.verifyEqual(double(txGrid), expected, AbsTol=1e-5, ...
+                'The SS/PBCH block burst with cached signals does not match the reference one.');
+            testCase.verifyEqual(statsAfter.Hits - statsBefore.Hits, numel(ssb), ...
+                'The second burst should be served by the cache.');
+            testCase.verifyEqual(statsAfter.Misses, statsBefore.Misses, ...
+                'The second burst should not generate new signals.');
+        end % of function mexTest
+    end % of methods (Test, TestTags = {'testmex'})
 end % of classdef srsSSBProcessorUnittest
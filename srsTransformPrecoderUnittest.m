@@ -26,6 +26,10 @@
 %   testvectorGenerationCases - Generates a test vector according to the provided
 %                               parameters.
 %
+%   srsTransformPrecoderUnittest Methods (TestTags = {'testmex'}):
+%
+%   mexTest  - Tests the MEX-based transform precoder.
+%
 %   srsTransformPrecoderUnittest Methods (Access = protected):
 %
 %   addTestIncludesToHeaderFile     - Adds include directives to the test header file.
@@ -143,4 +147,41 @@ classdef srsTransformPrecoderUnittest < srsTest.srsBlockUnittest
 
         end % of function testvectorGenerationCases
     end % of methods (Test, TestTags = {'testvector'})
+
+    methods (Test, TestTags = {'testmex'})
+        function mexTest(testCase, NumPRB)
+        %mexTest  Tests the MEX-based transform precoder.
+        %   mexTest(TESTCASE, NUMPRB) precodes and deprecodes NumOFDMSymbols OFDM symbols
+        %   of NUMPRB resource blocks with the srsTransformPrecoder MEX. The test is
+        %   considered as passed if the results match those of nrTransformPrecode and
+        %   srsTransformDeprecode.
+            import srsTest.helpers.randmod
+            import srsLib.phy.generic_functions.transform_precoding.srsTransformDeprecode
+            import srsMEX.phy.srsTransformPrecoder
+
+            NumSC = NumPRB * 12 * testCase.NumOFDMSymbols;
+
+            % Generate random QPSK subcarriers.
+            x = randmod('QPSK', [NumSC, 1]);
+
+            precoder = srsTransformPrecoder(Direction='precode');
+            precoded = precoder(x, NumPRB);
+
+            precodedRef = nrTransformPrecode(x, NumPRB);
+            testCase.verifyEqual(precoded, precodedRef, 'AbsTol', 1e-5, ...
+                'The MEX transform-precoded symbols do not match the MATLAB reference.');
+
+            % Generate noise variance.
+            eqNoiseVar = rand() + rand(size(precodedRef)) / 10;
+
+            deprecoder = srsTransformPrecoder(Direction='deprecode');
+            [deprecoded, noiseVar] = deprecoder(precodedRef, NumPRB, eqNoiseVar);
+
+            [deprecodedRef, noiseVarRef] = srsTransformDeprecode(precodedRef, eqNoiseVar, NumPRB, 1);
+            testCase.verifyEqual(deprecoded, deprecodedRef, 'AbsTol', 1e-5, ...
+                'The MEX deprecoded symbols do not match the MATLAB reference.');
+            testCase.verifyEqual(noiseVar, noiseVarRef, 'RelTol', 1e-5, ...
+                'The MEX deprecoded noise variances do not match the MATLAB reference.');
+        end % of function mexTest
+    end % of methods (Test, TestTags = {'testmex'})
 end % of classdef srsTransformPrecoderUnittest
@@ -25,6 +25,10 @@
 %   testvectorGenerationCases - Generates a test vector according to the provided
 %                               parameters.
 %
+%   srsUCIDecoderUnittest Methods (TestTags = {'testmex'}):
+%
+%   mexTest  - Tests the MEX-based UCI decoder.
+%
 %   srsUCIDecoderUnittest Methods (Access = protected):
 %
 %   addTestIncludesToHeaderFile     - Adds include directives to the test header file.
@@ -105,7 +109,6 @@ classdef srsUCIDecoderUnittest < srsTest.srsBlockUnittest
         %testvectorGenerationCases Generates a test vector for the given A and
         %   Modulation and Rate. Other parameters (e.g., E) are generated randomly.
 
-            import srsLib.phy.helpers.srsGetBitsSymbol
             import srsLib.phy.helpers.srsModulationFromMatlab
             import srsTest.helpers.writeUint8File
             import srsTest.helpers.writeInt8File
@@ -113,79 +116,9 @@ classdef srsUCIDecoderUnittest < srsTest.srsBlockUnittest
             % Generate a unique test ID.
             testID = testCase.generateTestID;
 
-            % Set randomized values.
-            UCIbits = randi([0 1], A, 1);
-
-            % Get the number of bits per symbol
-            bitsSymbol = srsGetBitsSymbol(Modulation);
-            
-            % The length of the rate-matched UCI codeword, E, depends on A 
-            % and on the modulation scheme (maximum length = 8192).
-            minE = A + 1;
-            maxE = floor(8192 / bitsSymbol) * bitsSymbol;
-
-            % For sequence sizes in {12,..., 19} bits there will be 6 CRC
-            % bits, for longer sequences there will be 11 CRC bits.
-            % If A > 2 and < 12 assign a minE of 24 in order to be able to decode it.
-            L = 0;
-            if A > 19
-                L = 11;
-            elseif A > 11
-                L = 6;
-            elseif A > 2
-                minE = 24;
-            end
-
-            % If a second polar code codeblock is used, the maximum number
-            % of rate matched bits is doubled.
-            if A > 1013
-                maxE = 2 * maxE;
-                L = 2 * L;
-            end
-            minE  = minE + L;
-
-            % Select a number of rate macthed bits without exceeding the maximum. 
-            E = min(maxE, max(minE, ceil((A + L) / Rate)));
-    
-            % Round the number of rate macthed bits to the number of bits
-            % per symbol.
-            E = ceil(E / bitsSymbol) * bitsSymbol;
-
-            % Set up an SNR that can challenge the decoder.
-            snrdB = 25;
-            nVar = 10 ^ (-snrdB / 10);
-            
-            % Encode the UCI bits.
-            UCICodeWord = nrUCIEncode(UCIbits, E, Modulation);
-
-            % Replace placeholders -1 (x) and -2 (y) as part of the
-            % descrambling.
-            UCICodeWord(UCICodeWord == -1) = 1;
-            UCICodeWord(UCICodeWord == -2) = UCICodeWord(find(UCICodeWord == -2) - 1);
-
-            % Modulate signal.
-            modulatedUCI = nrSymbolModulate(UCICodeWord, Modulation);
-
-            % Apply AWGN and try to decode. Repeat process until it is 
-            % possible to decode.
-            decodedOk = false;
-            while ~decodedOk
-                % Estimate the LLR soft bits.
-                rxSignal = awgn(modulatedUCI, snrdB);
-                LLRSoftBits = nrSymbolDemodulate(rxSignal, Modulation, nVar);
-    
-                % Decode the received UCI LLR soft bits.
-                decodedUCIBits = nrUCIDecode(LLRSoftBits, A, Modulation);
-
-                % Check if the message is decoded.
-                decodedOk = (sum(xor(UCIbits, decodedUCIBits)) == 0);
-           
-            end
+            % Generate a random UCI message and its noisy, quantized LLRs.
+            [UCIbits, LLRSoftBits, E] = generateUCICodeword(A, Modulation, Rate);
 
-            % Clip and quantize the LLRs.
-            LLRSoftBits(LLRSoftBits > 20) = 20;
-            LLRSoftBits(LLRSoftBits < -20) = -20;
-            LLRSoftBits = round(LLRSoftBits * 6); % this is LLRSoftBits * 120 / 20
             % Write the LLRs to a binary file.
             testCase.saveDataFile('_test_input', testID, @writeInt8File, LLRSoftBits(:));
 
@@ -201,4 +134,112 @@ classdef srsUCIDecoderUnittest < srsTest.srsBlockUnittest
             testCase.addTestToHeaderFile(testCase.headerFileID, testCaseString);
         end % of function testvectorGenerationCases
     end % of methods (Test, TestTags = {'testvector'})
+
+    methods (Test, TestTags = {'testmex'})
+        function mexTest(testCase, Modulation, Rate)
+        %mexTest  Tests the MEX-based UCI decoder.
+        %   mexTest(TESTCASE, MODULATION, RATE) generates one random UCI codeword for
+        %   each of the message lengths in A, with modulation MODULATION and code rate
+        %   RATE, and decodes all of them with one call to the srsUCIDecoder MEX. The
+        %   test is considered as passed if all messages are decoded correctly.
+            import srsMEX.phy.srsUCIDecoder
+
+            messageLengths = [testCase.A{:}].';
+            nUCI = numel(messageLengths);
+
+            UCIbits = cell(nUCI, 1);
+            LLRSoftBits = cell(nUCI, 1);
+            for iUCI = 1:nUCI
+                [UCIbits{iUCI}, LLRSoftBits{iUCI}] = generateUCICodeword(messageLengths(iUCI), Modulation, Rate);
+                LLRSoftBits{iUCI} = int8(LLRSoftBits{iUCI});
+            end
+
+            decoder = srsUCIDecoder;
+            [decodedBits, isValid] = decoder(LLRSoftBits, messageLengths, Modulation);
+
+            testCase.verifyTrue(all(isValid), 'Some UCI messages were not decoded.');
+            testCase.verifyEqual(decodedBits, UCIbits, 'The decoded UCI messages are not correct.');
+        end % of function mexTest
+    end % of methods (Test, TestTags = {'testmex'})
 end % of classdef srsUCIDecoderUnittest
+
+function [UCIbits, LLRSoftBits, E] = generateUCICodeword(A, Modulation, Rate)
+%generateUCICodeword Generates a random UCI message of A bits and the corresponding
+%   quantized LLRs, as received through an AWGN channel with the given modulation
+%   and code rate. Other parameters (e.g., E) are generated randomly.
+    import srsLib.phy.helpers.srsGetBitsSymbol
+
+    % Set randomized values.
+    UCIbits = randi([0 1], A, 1);
+
+    % Get the number of bits per symbol
+    bitsSymbol = srsGetBitsSymbol(Modulation);
+    
+    % The length of the rate-matched UCI codeword, E, depends on A 
+    % and on the modulation scheme (maximum length = 8192).
+    minE = A + 1;
+    maxE = floor(8192 / bitsSymbol) * bitsSymbol;
+
+    % For sequence sizes in {12,..., 19} bits there will be 6 CRC
+    % bits, for longer sequences there will be 11 CRC bits.
+    % If A > 2 and < 12 assign a minE of 24 in order to be able to decode it.
+    L = 0;
+    if A > 19
+        L = 11;
+    elseif A > 11
+        L = 6;
+    elseif A > 2
+        minE = 24;
+    end
+
+    % If a second polar code codeblock is used, the maximum number
+    % of rate matched bits is doubled.
+    if A > 1013
+        maxE = 2 * maxE;
+        L = 2 * L;
+    end
+    minE  = minE + L;
+
+    % Select a number of rate macthed bits without exceeding the maximum. 
+    E = min(maxE, max(minE, ceil((A + L) / Rate)));
+
+    % Round the number of rate macthed bits to the number of bits
+    % per symbol.
+    E = ceil(E / bitsSymbol) * bitsSymbol;
+
+    % Set up an SNR that can challenge the decoder.
+    snrdB = 25;
+    nVar = 10 ^ (-snrdB / 10);
+    
+    % Encode the UCI bits.
+    UCICodeWord = nrUCIEncode(UCIbits, E, Modulation);
+
+    % Replace placeholders -1 (x) and -2 (y) as part of the
+    % descrambling.
+    UCICodeWord(UCICodeWord == -1) = 1;
+    UCICodeWord(UCICodeWord == -2) = UCICodeWord(find(UCICodeWord == -2) - 1);
+
+    % Modulate signal.
+    modulatedUCI = nrSymbolModulate(UCICodeWord, Modulation);
+
+    % Apply AWGN and try to decode. Repeat process until it is 
+    % possible to decode.
+    decodedOk = false;
+    while ~decodedOk
+        % Estimate the LLR soft bits.
+        rxSignal = awgn(modulatedUCI, snrdB);
+        LLRSoftBits = nrSymbolDemodulate(rxSignal, Modulation, nVar);
+
+        % Decode the received UCI LLR soft bits.
+        decodedUCIBits = nrUCIDecode(LLRSoftBits, A, Modulation);
+
+        % Check if the message is decoded.
+        decodedOk = (sum(xor(UCIbits, decodedUCIBits)) == 0);
+       
+    end
+
+    % Clip and quantize the LLRs.
+    LLRSoftBits(LLRSoftBits > 20) = 20;
+    LLRSoftBits(LLRSoftBits < -20) = -20;
+    LLRSoftBits = round(LLRSoftBits * 6); % this is LLRSoftBits * 120 / 20
+end % of function generateUCICodeword
@@ -28,6 +28,10 @@
 %   testvectorGenerationCases - Generates a test vector according to the provided
 %                               parameters.
 %
+%   srsULSCHDemultiplexUnittest Methods (TestTags = {'testmex'}):
+%
+%   mexTest  - Tests the MEX-based implementation of the UL-SCH demultiplexer.
+%
 %   srsULSCHDemultiplexUnittest Methods (Access = protected):
 %
 %   addTestIncludesToHeaderFile     - Adds include directives to the test header file.
@@ -256,4 +260,72 @@ classdef srsULSCHDemultiplexUnittest < srsTest.srsBlockUnittest
 
         end % of function testvectorGenerationCases
     end % of methods (Test, TestTags = {'testvector'})
+
+    methods (Test, TestTags = {'testmex'})
+        function mexTest(testCase, Modulation, nofHarqAckBits, nofCsiPart1Bits, nofCsiPart2Bits)
+        %mexTest  Tests the mex wrapper of the srsRAN UL-SCH demultiplexer.
+        %   mexTest(testCase, Modulation, nofHarqAckBits, nofCsiPart1Bits, nofCsiPart2Bits)
+        %   demultiplexes a random codeword and compares the result with the one
+        %   returned by nrULSCHDemultiplex.
+
+            import srsLib.phy.upper.channel_processors.pusch.srsULSCHScramblingPlaceholders
+            import srsMEX.phy.srsULSCHDemultiplex
+
+            % Configure carrier.
+            carrier = nrCarrierConfig;
+
+            % Prepare PRB set.
+            numPRB = randi([1, carrier.NSizeGrid]);
+            PRBSet = 0:(numPRB-1);
+
+            % Select a target code rate between 0.5 and 0.9.
+            targetCodeRate = round(0.4 * rand + 0.5, 1);
+
+            % Configure PUSCH.
+            numLayers = randi([1, 4]);
+            pusch = nrPUSCHConfig( ...
+                NumLayers=numLayers, ...
+                Modulation=Modulation, ...
+                PRBSet=PRBSet, ...
+                NID=1 ...
+                );
+            pusch.DMRS.DMRSConfigurationType = randi([1, 2]);
+            pusch.DMRS.DMRSAdditionalPosition = randi([0, 3]);
+            pusch.DMRS.NumCDMGroupsWithoutData = pusch.DMRS.DMRSConfigurationType + 1;
+            if numLayers == 1
+                pusch.DMRS.NumCDMGroupsWithoutData = 1;
+            end
+
+            [~, puschInfo] = nrPUSCHIndices(carrier, pusch);
+
+            tbs = nrTBS(pusch.Modulation, pusch.NumLayers, numPRB, puschInfo.NREPerPRB, targetCodeRate);
+
+            % Generate placeholders.
+            [xInd, yInd] = srsULSCHScramblingPlaceholders(pusch, targetCodeRate, tbs, nofHarqAckBits, ...
+                nofCsiPart1Bits, nofCsiPart2Bits);
+
+            % Generate random soft bits.
+            demodulated = randi([-120, 120], puschInfo.G, 1);
+
+            % Descramble demodulated bits without placeholders, as the PUSCH demodulator does.
+            descrambled = nrPUSCHDescramble(demodulated, pusch.NID, pusch.RNTI);
+
+            % Descramble demodulated bits with placeholders and demultiplex them.
+            codeword = nrPUSCHDescramble(demodulated, pusch.NID, pusch.RNTI, xInd + 1, yInd + 1);
+            [schData, harqAck, csiPart1, csiPart2] = nrULSCHDemultiplex(pusch, targetCodeRate, tbs, ...
+                nofHarqAckBits, nofCsiPart1Bits, nofCsiPart2Bits, codeword);
+
+            % Run the MEX demultiplexer.
+            demuxConfig = srsULSCHDemultiplex.createConfiguration(carrier, pusch, targetCodeRate, tbs, ...
+                nofHarqAckBits, nofCsiPart1Bits, nofCsiPart2Bits);
+            demux = srsULSCHDemultiplex;
+            [schDataMEX, harqAckMEX, csiPart1MEX, csiPart2MEX] = demux(int8(descrambled), pusch, demuxConfig);
+
+            % Verify the outputs.
+            testCase.verifyEqual(schDataMEX, int8(schData), 'UL-SCH data soft bits do not match.');
+            testCase.verifyEqual(harqAckMEX, int8(harqAck), 'HARQ-ACK soft bits do not match.');
+            testCase.verifyEqual(csiPart1MEX, int8(csiPart1), 'CSI Part 1 soft bits do not match.');
+            testCase.verifyEqual(csiPart2MEX, int8(csiPart2), 'CSI Part 2 soft bits do not match.');
+        end % of function mexTest(...)
+    end % of methods (Test, TestTags = {'testmex'})
 end % of classdef srsPUSCHProcessorUnittest
@@ -0,0 +1,259 @@
+%CheckChannelModels Unit tests for the native channel models.
+%   This class, based on the matlab.unittest.TestCase framework, checks the
+%   channel models in '+srsMEX/+channel' against their expected statistics and
+%   against the corresponding MATLAB objects, as well as the random streams they
+%   draw from.
+%
+%   CheckChannelModels Methods (Test, TestTags = {'mex code'}):
+%
+%   testStaticSingleTap   - Verifies that a static single-path channel is a pure delay.
+%   testPathPowers        - Verifies the average power of the paths against nrTDLChannel.
+%   testDopplerSpectrum   - Verifies the time autocorrelation of the path gains (Jakes model).
+%   testBlockContinuity   - Verifies that processing by blocks is the same as processing at once.
+%   testStreamReseed      - Verifies that reseeding by random stream is reproducible and leaves
+%                           the global random generator untouched.
+%   testImpairments       - Verifies the noise power, the frequency offset and the delay of the
+%                           impairment stage, as well as its independence of the number of threads.
+%   testPhiloxKnownAnswers - Verifies the random stream generator against the Philox4x32-10
+%                           known-answer vectors of Random123.
+%   testDisjointStreams   - Verifies that different stream identifiers give disjoint streams.
+%
+%   Example
+%      runtests('CheckChannelModels')
+%
+%   See also matlab.unittest, srsMEX.channel.srsFadingChannel, srsMEX.channel.srsChannelImpairments,
+%   srsMEX.simulators.srsRandomStreamMEX, nrTDLChannel.
+
+%   Copyright 2021-2025 Software Radio Systems Limited
+%
+%   This file is part of srsRAN-matlab.
+%
+%   srsRAN-matlab is free software: you can redistribute it and/or
+%   modify it under the terms of the BSD 2-Clause License.
+%
+%   srsRAN-matlab is distributed in the hope that it will be useful,
+%   but WITHOUT ANY WARRANTY; without even the implied warranty of
+%   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+%   BSD 2-Clause License for more details.
+%
+%   A copy of the BSD 2-Clause License can be found in the LICENSE
+%   file in the top-level directory of this distribution.
+
+classdef CheckChannelModels < matlab.unittest.TestCase
+    properties (TestParameter)
+        %Delay profiles.
+        DelayProfile = {'TDL-A', 'TDLB100', 'TDLC300'}
+    end % of properties (TestParameter)
+
+    methods (TestMethodSetup)
+        function resetrandomgenerator(obj)
+            % Reset random genenator after storing current state.
+            orig = rng('default');
+            % Random generator will be restored after the method.
+            obj.addTeardown(@rng, orig);
+        end % of function resetrandomgenerator(obj)
+    end % of methods (TestMethodSetup)
+
+    methods (Test, TestTags = {'mex code'})
+        function testStaticSingleTap(obj)
+            chan = srsMEX.channel.srsFadingChannel(DelayProfile='custom', PathDelays=0, AveragePathGains=0, ...
+                MaximumDopplerShift=0, NumTransmitAntennas=1, NumReceiveAntennas=1);
+
+            chInfo = info(chan);
+            pathFilters = getPathFilters(chan);
+            obj.assertEqual(nnz(pathFilters), 1, 'A zero-delay path should have a single tap.');
+            obj.assertEqual(find(pathFilters) - 1, chInfo.ChannelFilterDelay, 'Wrong position of the filter tap.');
+
+            tx = complex(randn(1000, 1), randn(1000, 1));
+            [rx, pathGains] = chan(tx);
+            delay = chInfo.ChannelFilterDelay;
+            expected = pathGains(1) * tx(1:end-delay);
+            obj.assertEqual(rx(delay+1:end), expected, 'A static single-path channel should be a pure delay.', ...
+                AbsTol=1e-5);
+        end % of function testStaticSingleTap(obj)
+
+        function testPathPowers(obj, DelayProfile)
+            sampleRate = 30.72e6;
+            nSamples = 20000;
+            nRealizations = 200;
+
+            chan = srsMEX.channel.srsFadingChannel(DelayProfile=DelayProfile, DelaySpread=100e-9, ...
+                MaximumDopplerShift=100, SampleRate=sampleRate, NumTransmitAntennas=1, NumReceiveAntennas=1);
+            ref = nrTDLChannel(DelayProfile=DelayProfile, DelaySpread=100e-9, MaximumDopplerShift=100, ...
+                SampleRate=sampleRate, NumTransmitAntennas=1, NumReceiveAntennas=1);
+
+            chInfo = info(chan);
+            refInfo = info(ref);
+            obj.assertEqual(chInfo.PathDelays, refInfo.PathDelays, 'Wrong path delays.', AbsTol=1e-12);
+
+            % Average the power of the path gains over many independent realizations.
+            power = zeros(size(chInfo.PathDelays));
+            for iRealization = 1:nRealizations
+                reseed(chan, iRealization);
+                [~, pathGains] = chan(complex(zeros(nSamples, 1)));
+                power = power + mean(abs(pathGains).^2, 1);
+            end
+            power = power / nRealizations;
+
+            % The path gains of both channels are normalized to unit total power.
+            refGains = refInfo.AveragePathGains - 10 * log10(sum(10.^(refInfo.AveragePathGains / 10)));
+            obj.assertEqual(chInfo.AveragePathGains, refGains, 'Wrong normalized path gains.', AbsTol=1e-6);
+            obj.assertEqual(10 * log10(power), refGains, 'Wrong average path powers.', AbsTol=0.5);
+        end % of function testPathPowers(obj, DelayProfile)
+
+        function testDopplerSpectrum(obj)
+            sampleRate = 1.92e6;
+            fD = 100;
+            nSamples = 192000;
+            nRealizations = 100;
+
+            chan = srsMEX.channel.srsFadingChannel(DelayProfile='custom', PathDelays=0, AveragePathGains=0, ...
+                MaximumDopplerShift=fD, SampleRate=sampleRate, NumTransmitAntennas=1, NumReceiveAntennas=1);
+
+            % Estimate the autocorrelation of the path gain at a few lags.
+            lags = 0:4:40;
+            acorr = zeros(size(lags));
+            for iRealization = 1:nRealizations
+                reseed(chan, iRealization);
+                [~, pathGains, sampleTimes] = chan(complex(zeros(nSamples, 1)));
+                snapshotPeriod = sampleTimes(2) - sampleTimes(1);
+                for iLag = 1:numel(lags)
+                    lag = lags(iLag);
+                    acorr(iLag) = acorr(iLag) + mean(pathGains(1+lag:end) .* conj(pathGains(1:end-lag)));
+                end
+            end
+            acorr = real(acorr) / nRealizations;
+
+            expected = besselj(0, 2 * pi * fD * lags * snapshotPeriod);
+            obj.assertEqual(acorr, expected, 'The autocorrelation does not follow the Jakes model.', AbsTol=0.05);
+        end % of function testDopplerSpectrum(obj)
+
+        function testBlockContinuity(obj, DelayProfile)
+            chan = srsMEX.channel.srsFadingChannel(DelayProfile=DelayProfile, MaximumDopplerShift=500, ...
+                NumTransmitAntennas=2, NumReceiveAntennas=4, MIMOCorrelation='Medium');
+
+            tx = complex(randn(30720, 2), randn(30720, 2));
+
+            rxWhole = chan(tx);
+
+            reset(chan);
+            blockEnds = [0 1000 1001 15360 30720];
+            rxBlocks = zeros(size(rxWhole));
+            for iBlock = 1:numel(blockEnds)-1
+                block = blockEnds(iBlock)+1:blockEnds(iBlock+1);
+                rxBlocks(block, :) = chan(tx(block, :));
+            end
+
+            obj.assertEqual(rxBlocks, rxWhole, 'Processing by blocks does not match processing at once.', ...
+                AbsTol=1e-5);
+        end % of function testBlockContinuity(obj, DelayProfile)
+
+        function testStreamReseed(obj)
+            chan = srsMEX.channel.srsFadingChannel(DelayProfile='TDLA30', MaximumDopplerShift=100, ...
+                NumTransmitAntennas=1, NumReceiveAntennas=2);
+            tx = complex(randn(3072, 1), randn(3072, 1));
+
+            globalState = rng;
+            reseed(chan, 0, 2, 5, 3);
+            rxSlot = chan(tx);
+            reseed(chan, 0, 2, 5, 4);
+            rxNextSlot = chan(tx);
+            reseed(chan, 0, 2, 5, 3);
+            rxAgain = chan(tx);
+            obj.assertEqual(rng, globalState, 'Reseeding by random stream changed the global random generator.');
+
+            obj.assertEqual(rxAgain, rxSlot, 'The same random stream gives a different realization.');
+            obj.assertGreaterThan(norm(rxNextSlot - rxSlot), 0.1 * norm(rxSlot), ...
+                'Different slots give the same realization.');
+        end % of function testStreamReseed(obj)
+
+        function testImpairments(obj)
+            sampleRate = 1.92e6;
+            cfo = 1000;
+            nSamples = 19200;
+            noiseVar = [0.5 1 2 4];
+
+            % Noise only: power of each port and independence of the number of threads.
+            impair = srsMEX.channel.srsChannelImpairments(SampleRate=sampleRate, Seed=5, NumThreads=1);
+            noise = impair(zeros(nSamples, 4), noiseVar);
+            obj.assertEqual(mean(abs(noise).^2, 1), noiseVar, 'Wrong noise power.', RelTol=0.05);
+            corrCoeffs = abs(noise' * noise) ./ sqrt(sum(abs(noise).^2, 1)' * sum(abs(noise).^2, 1));
+            obj.assertLessThan(corrCoeffs(~eye(4)), 0.05, 'The noise of the ports is correlated.');
+
+            impairThreads = srsMEX.channel.srsChannelImpairments(SampleRate=sampleRate, Seed=5, NumThreads=4);
+            obj.assertEqual(impairThreads(zeros(nSamples, 4), noiseVar), noise, ...
+                'The noise depends on the number of threads.');
+
+            reset(impair);
+            obj.assertEqual(impair(zeros(nSamples, 4), noiseVar), noise, 'The noise is not reproducible after reset.');
+
+            % Noiseless: frequency offset and integer delay, processed in two blocks.
+            delay = 12;
+            impair = srsMEX.channel.srsChannelImpairments(SampleRate=sampleRate, CarrierFrequencyOffset=cfo, ...
+                TimingOffset=delay);
+            tx = complex(randn(nSamples, 2), randn(nSamples, 2));
+            rx = [impair(tx(1:1000, :), 0); impair(tx(1001:end, :), 0)];
+            timeIx = (0:nSamples-1).';
+            expected = [zeros(delay, 2); tx(1:end-delay, :)] .* exp(2j * pi * timeIx * cfo / sampleRate);
+            obj.assertEqual(rx, expected, 'Wrong frequency offset or delay.', AbsTol=1e-4);
+        end % of function testImpairments(obj)
+
+        function testPhiloxKnownAnswers(obj)
+            import srsMEX.simulators.srsRandomStreamMEX
+
+            % Known-answer vectors of Random123 (kat_vectors, philox4x32_10): zero, all ones and pi digits.
+            counters = uint32([0 0 0 0; ...
+                0xffffffff 0xffffffff 0xffffffff 0xffffffff; ...
+                0x243f6a88 0x85a308d3 0x13198a2e 0x03707344]);
+            keys = uint32([0 0; ...
+                0xffffffff 0xffffffff; ...
+                0xa4093822 0x299f31d0]);
+            expected = uint32([0x6627e8d5 0xe169c58d 0xbc57ac4c 0x9b00dbd8; ...
+                0x408f276d 0x41c83b0e 0xa20bc7c6 0x6d5451fd; ...
+                0xd16cfe09 0x94fdcceb 0x5001e420 0x24126ea1]);
+            for iVector = 1:size(counters, 1)
+                block = srsRandomStreamMEX('block', counters(iVector, :), keys(iVector, :));
+                obj.assertEqual(block, expected(iVector, :), ...
+                    sprintf('Wrong block for known-answer vector %d.', iVector));
+            end
+
+            % The zero stream identifier maps onto the zero counter and key.
+            words = srsRandomStreamMEX('stream', zeros(1, 6, 'uint64'), 2);
+            obj.assertEqual(words, [0x6627e8d5e169c58du64; 0xbc57ac4c9b00dbd8u64], ...
+                'The zero stream does not start with the zero known-answer block.');
+        end % of function testPhiloxKnownAnswers(obj)
+
+        function testDisjointStreams(obj)
+            import srsMEX.simulators.srsRandomStreamMEX
+
+            % Stream identifiers [seed snrIndex item slot purpose substream] that differ in a single field, including
+            % the largest values of the fields that share a counter word.
+            baseID = uint64([7 1 5 2 3 0]);
+            maxValues = uint64([2^64-1 2^16-1 2^48-1 2^16-1 4 2^8-1]);
+            streamIDs = baseID;
+            for iField = 1:numel(baseID)
+                for value = [0 1 maxValues(iField)]
+                    streamID = baseID;
+                    streamID(iField) = value;
+                    if ~ismember(streamID, streamIDs, 'rows')
+                        streamIDs = [streamIDs; streamID]; %#ok<AGROW>
+                    end
+                end
+            end
+
+            % For a given key, the block function is a bijection: streams with the same seed have disjoint words if,
+            % and only if, they have disjoint counters.
+            nWords = 64;
+            words = zeros(nWords, size(streamIDs, 1), 'uint64');
+            for iStream = 1:size(streamIDs, 1)
+                words(:, iStream) = srsRandomStreamMEX('stream', streamIDs(iStream, :), nWords);
+            end
+            obj.assertEqual(numel(unique(words)), numel(words), ...
+                'Different stream identifiers give overlapping streams.');
+
+            % The streams are a pure function of their identifiers.
+            obj.assertEqual(srsRandomStreamMEX('stream', baseID, nWords), words(:, 1), ...
+                'The same stream identifier gives a different stream.');
+        end % of function testDisjointStreams(obj)
+    end % of methods (Test, TestTags = {'mex code'})
+end % of classdef CheckChannelModels < matlab.unittest.TestCase
@@ -17,11 +17,19 @@
 %   CheckSimulators Methods (Test, TestTags = {'mex code'}):
 %
 %   testPUSCHBLERmex   - Verifies the PUSCHBLER simulator class also using MEX implementations.
+%   testPUSCHBLERengine - Verifies the PUSCHBLER simulator class using the native simulation engine.
+%   testPUSCHBLERengineAdaptive - Verifies the confidence-based stopping criterion of the native PUSCHBLER engine.
+%   testPUSCHBLERengineHARQ - Verifies the HARQ retransmissions of the native PUSCHBLER engine against the
+%                         MATLAB simulation loop.
+%   testPUSCHBLERengineSoftbitWidth - Compares the BLER of the native PUSCHBLER engine with compressed (6- and
+%                         4-bit) softbuffers against the one with full-width (8-bit) softbuffers.
 %   testPUCCHPERFF0mex - Verifies the PUCCHPERF simulator class PUCCH F0 also using MEX implementations.
 %   testPUCCHPERFF1mex - Verifies the PUCCHPERF simulator class PUCCH F1 also using MEX implementations.
 %   testPUCCHPERFF2mex - Verifies the PUCCHPERF simulator class PUCCH F2 also using MEX implementations.
 %   testPUCCHPERFF3mex - Verifies the PUCCHPERF simulator class PUCCH F3 also using MEX implementations.
 %   testPUCCHPERFF4mex - Verifies the PUCCHPERF simulator class PUCCH F4 also using MEX implementations.
+%   testPUCCHPERFengine - Verifies the PUCCHPERF simulator class PUCCH F2 using the native simulation engine.
+%   testPRACHPERFengine - Verifies the PRACHPERF simulator class using the native simulation engine.
 %
 %   Example
 %      runtests('CheckSimulators')
@@ -375,6 +383,161 @@ classdef CheckSimulators < matlab.unittest.TestCase
             obj.assertLessThanOrEqual(pp.BlockErrorRateSRS, [0.70; 0.70; 0.65; 0.65; 0.62], "Wrong BLER curve.");
         end % of function testPUSCHBLERmex(obj)
 
+        function testPUSCHBLERengine(obj)
+            import matlab.unittest.fixtures.CurrentFolderFixture
+            import matlab.unittest.constraints.IsFile
+
+            obj.applyFixture(CurrentFolderFixture('../apps/simulators/PUSCHBLER'));
+
+            obj.assertThat('../../../+srsMEX/+simulators/@srsPUSCHBLEREngine/pusch_bler_engine_mex.mexa64', IsFile, ...
+                'Could not find PUSCH BLER engine mex executable.');
+
+            snrs = -5.0:0.2:-4.2;
+            sims = obj.runEngineThreads('PUSCHBLER', {'QuickSimulation', false, 'ImplementationType', 'srs', ...
+                'PerfectChannelEstimator', false}, snrs, 100, @(pp) [pp.ThroughputSRSCtr pp.MissedBlocksSRSCtr]);
+            pp = sims{1};
+
+            % The native engine simulates the same link as testPUSCHBLERmex, with different noise realizations.
+            obj.assertEqual(pp.SNRrange, snrs', 'Wrong SNR range.');
+            obj.assertEqual(pp.TBS, 1800, 'Wrong transport block size.');
+            obj.assertEqual(pp.MaxThroughput, 1.8, 'Wrong maximum throughput.');
+            obj.assertGreaterThanOrEqual(pp.ThroughputSRS, [0; 0; 0.02; 0.25; 0.65], "Wrong throughput curve.");
+            obj.assertLessThanOrEqual(pp.BlockErrorRateSRS, [0.75; 0.75; 0.70; 0.70; 0.67], "Wrong BLER curve.");
+        end % of function testPUSCHBLERengine(obj)
+
+        function testPUSCHBLERengineAdaptive(obj)
+            import matlab.unittest.fixtures.CurrentFolderFixture
+            import matlab.unittest.constraints.IsFile
+
+            obj.applyFixture(CurrentFolderFixture('../apps/simulators/PUSCHBLER'));
+
+            obj.assertThat('../../../+srsMEX/+simulators/@srsPUSCHBLEREngine/pusch_bler_engine_mex.mexa64', IsFile, ...
+                'Could not find PUSCH BLER engine mex executable.');
+
+            % One point in the waterfall region and one point without errors, both of them should stop long before
+            % the maximum number of frames.
+            snrs = [-5.0 20.0];
+            nFrames = 50;
+            targetWidth = 0.05;
+            targetRelativeWidth = 0.2;
+
+            sims = obj.runEngineThreads('PUSCHBLER', {'QuickSimulation', false, 'ImplementationType', 'srs', ...
+                'PerfectChannelEstimator', false, 'TargetIntervalWidth', targetWidth, ...
+                'TargetRelativeIntervalWidth', targetRelativeWidth}, snrs, nFrames, ...
+                @(pp) [pp.TotalBlocksCtr pp.MissedBlocksSRSCtr]);
+
+            % Each point stops as soon as the Wilson interval of its BLER is narrow enough, i.e., long before the
+            % maximum number of frames (the engine counts all the transport blocks of a frame, ten with the default
+            % 15-kHz subcarrier spacing).
+            totalBlocks = sims{1}.TotalBlocksCtr;
+            missedBlocks = sims{1}.MissedBlocksSRSCtr;
+            obj.assertLessThan(totalBlocks, nFrames * 10 * ones(2, 1), 'The points were not stopped early.');
+            obj.assertEqual(missedBlocks(2), 0, 'Unexpected errors at high SNR.');
+
+            z = sqrt(2) * erfinv(0.95);
+            p = missedBlocks ./ totalBlocks;
+            halfWidth = z ./ (1 + z^2 ./ totalBlocks) .* sqrt(p .* (1 - p) ./ totalBlocks + z^2 ./ (4 * totalBlocks.^2));
+            obj.assertLessThanOrEqual(2 * halfWidth, max(targetWidth, targetRelativeWidth * p) + 1e-12, ...
+                'The confidence interval is wider than the target.');
+        end % of function testPUSCHBLERengineAdaptive(obj)
+
+        function testPUSCHBLERengineHARQ(obj)
+            import matlab.unittest.fixtures.CurrentFolderFixture
+            import matlab.unittest.constraints.IsFile
+
+            obj.applyFixture(CurrentFolderFixture('../apps/simulators/PUSCHBLER'));
+
+            obj.assertThat('../../../+srsMEX/+simulators/@srsPUSCHBLEREngine/pusch_bler_engine_mex.mexa64', IsFile, ...
+                'Could not find PUSCH BLER engine mex executable.');
+
+            % With 15-kHz subcarriers a frame has 10 slots, fewer than NHARQProcesses x numel(RVSequence) = 64:
+            % most RV sequences are still running at the end of the frame.
+            snrs = [-10.0 -8.0];
+            nFrames = 50;
+            engineTypes = {'noMEX', 'MEX'};
+            bler = cell(2, 1);
+            throughput = cell(2, 1);
+            for iRun = 1:2
+                pp = PUSCHBLER;
+                pp.QuickSimulation = false;
+                pp.ImplementationType = 'srs';
+                pp.PerfectChannelEstimator = false;
+                pp.EnableHARQ = true;
+                pp.SimulationEngineType = engineTypes{iRun};
+                try
+                    pp(snrs, nFrames);
+                catch ME
+                    obj.assertFail(['PUSCHBLER could not run because of exception: ', ...
+                        ME.message]);
+                end
+                bler{iRun} = pp.BlockErrorRateSRS;
+                throughput{iRun} = pp.ThroughputSRS;
+
+                if strcmp(engineTypes{iRun}, 'MEX')
+                    % The engine completes the RV sequences started in each frame: every transport block is counted.
+                    obj.assertEqual(pp.TotalBlocksCtr, nFrames * 10 * ones(2, 1), ...
+                        'The engine did not count all the transport blocks.');
+                end
+            end
+
+            % Same link, different noise realizations. Also, the MATLAB loop does not count the transport blocks
+            % still pending after the last frame.
+            obj.assertEqual(bler{2}, bler{1}, 'The BLER of the engine does not match the MATLAB loop.', ...
+                AbsTol=0.1);
+            obj.assertEqual(throughput{2}, throughput{1}, ...
+                'The throughput of the engine does not match the MATLAB loop.', RelTol=0.15);
+        end % of function testPUSCHBLERengineHARQ(obj)
+
+        function testPUSCHBLERengineSoftbitWidth(obj)
+            import matlab.unittest.fixtures.CurrentFolderFixture
+            import matlab.unittest.constraints.IsFile
+            import matlab.unittest.Verbosity
+
+            obj.applyFixture(CurrentFolderFixture('../apps/simulators/PUSCHBLER'));
+
+            obj.assertThat('../../../+srsMEX/+simulators/@srsPUSCHBLEREngine/pusch_bler_engine_mex.mexa64', IsFile, ...
+                'Could not find PUSCH BLER engine mex executable.');
+
+            % Only the soft combining of the retransmissions is affected by the softbuffer compression. The engine
+            % draws the same channel and noise realizations for all widths.
+            snrs = [-10.0 -8.0];
+            nFrames = 50;
+            softbitWidths = [8 6 4];
+            nWidths = numel(softbitWidths);
+            bler = cell(nWidths, 1);
+            throughput = cell(nWidths, 1);
+            for iWidth = 1:nWidths
+                pp = PUSCHBLER;
+                pp.QuickSimulation = false;
+                pp.ImplementationType = 'srs';
+                pp.PerfectChannelEstimator = false;
+                pp.EnableHARQ = true;
+                pp.SoftbitWidth = softbitWidths(iWidth);
+                pp.SimulationEngineType = 'MEX';
+                try
+                    pp(snrs, nFrames);
+                catch ME
+                    obj.assertFail(['PUSCHBLER could not run because of exception: ', ...
+                        ME.message]);
+                end
+                bler{iWidth} = pp.BlockErrorRateSRS;
+                throughput{iWidth} = pp.ThroughputSRS;
+
+                obj.log(Verbosity.Concise, sprintf('SoftbitWidth = %d: BLER = [%s], throughput = [%s] Mbps.', ...
+                    softbitWidths(iWidth), num2str(bler{iWidth}.', '%.3f '), ...
+                    num2str(throughput{iWidth}.', '%.3f ')));
+            end
+
+            % The 6-bit softbuffers are almost lossless, the 4-bit ones lose a little combining gain.
+            blerTol = [0.05 0.15];
+            for iWidth = 2:nWidths
+                obj.assertEqual(bler{iWidth}, bler{1}, sprintf(['The BLER with %d-bit softbuffers is too far ' ...
+                    'from the full-width one.'], softbitWidths(iWidth)), AbsTol=blerTol(iWidth - 1));
+                obj.assertGreaterThanOrEqual(bler{iWidth}, bler{1} - 0.05, sprintf(['The BLER with %d-bit ' ...
+                    'softbuffers is lower than the full-width one.'], softbitWidths(iWidth)));
+            end
+        end % of function testPUSCHBLERengineSoftbitWidth(obj)
+
         function testPUCCHPERFF0mex(obj, PUCCHTestType)
             import matlab.unittest.fixtures.CurrentFolderFixture
             import matlab.unittest.constraints.IsFile
@@ -591,5 +754,140 @@ classdef CheckSimulators < matlab.unittest.TestCase
             obj.assertLessThanOrEqual(pp.Statistics.BlockErrorRateSRS, [1; 0.991; 0.926; 0.782; 0.541], ...
                 "Wrong BLER curve.");
         end % of function testPUCCHPERFF4mex(obj)
+
+        function testPUCCHPERFengine(obj, PUCCHTestType)
+            import matlab.unittest.fixtures.CurrentFolderFixture
+            import matlab.unittest.constraints.IsFile
+
+            obj.applyFixture(CurrentFolderFixture('../apps/simulators/PUCCHPERF'));
+
+            obj.assertThat('../../../+srsMEX/+simulators/@srsPUCCHPERFEngine/pucch_perf_engine_mex.mexa64', IsFile, ...
+                'Could not find PUCCH performance engine mex executable.');
+
+            snrs = -20:2:-4;
+            sims = obj.runEngineThreads('PUCCHPERF', {'TestType', PUCCHTestType, 'NRxAnts', 2, ...
+                'ImplementationType', 'srs', 'PerfectChannelEstimator', false}, snrs, 100, @(pp) pp.Counters);
+            pp = sims{1};
+
+            % The native engine simulates the same link as testPUCCHPERFF2mex, with different noise realizations.
+            obj.assertEqual(pp.Counters.SNRrange, snrs', 'Wrong SNR range.');
+            if (PUCCHTestType == "Detection")
+                obj.assertLessThanOrEqual(pp.Statistics.BlockErrorRateSRS, ...
+                    [0.950; 0.940; 0.920; 0.880; 0.780; 0.660; 0.480; 0.300; 0.200], ...
+                    "Wrong BLER curve.");
+            else
+                obj.assertLessThanOrEqual(pp.Statistics.FalseDetectionRateSRS, 0.010 * ones(9, 1), "Wrong false alarm curve.");
+            end
+        end % of function testPUCCHPERFengine(obj, PUCCHTestType)
+
+        function testPRACHPERFengine(obj)
+            import matlab.unittest.fixtures.CurrentFolderFixture
+            import matlab.unittest.constraints.IsFile
+
+            obj.applyFixture(CurrentFolderFixture('../apps/simulators/PRACHPERF'));
+
+            obj.assertThat('../../../+srsMEX/+simulators/@srsPRACHPERFEngine/prach_perf_engine_mex.mexa64', IsFile, ...
+                'Could not find PRACH performance engine mex executable.');
+
+            % Run detection test: same link as testPRACHPERFmatlab, with different noise realizations.
+            snr = -14.2;
+            sims = obj.runEngineThreads('PRACHPERF', {'ImplementationType', 'srs'}, snr, 100, ...
+                @(pp) [pp.Detected pp.DetectedPerfect]);
+            pp = sims{1};
+
+            obj.assertEqual(pp.SNRrange, snr, 'Wrong SNR range.');
+            obj.assertEqual(pp.Occasions, 100, 'Wrong number of occasions.');
+            obj.assertGreaterThanOrEqual(pp.Detected, 98, 'Wrong number of detected preambles.');
+            obj.assertGreaterThanOrEqual(pp.ProbabilityDetectionPerfect, 0.98, 'Wrong probability of perfect detection.');
+
+            % Run false alarm test.
+            sims = obj.runEngineThreads('PRACHPERF', {'ImplementationType', 'srs', 'TestType', 'False Alarm'}, ...
+                snr, 100, @(pp) pp.Detected);
+            pp = sims{1};
+
+            obj.assertEqual(pp.SNRrange, snr, 'Wrong SNR range.');
+            obj.assertEqual(pp.Occasions, 100, 'Wrong number of occasions.');
+            obj.assertLessThanOrEqual(pp.ProbabilityFalseAlarm, 0.04, 'Wrong probability of false alarm.');
+
+            % The detection counters cannot increase with the detection threshold and the timing
+            % error histogram must count all detections within its range.
+            carrier = nrCarrierConfig(NSizeGrid=25);
+            prach = srsLib.phy.helpers.srsConfigurePRACH('0', SequenceIndex=22, PreambleIndex=32, ...
+                FrequencyRange='FR1', SubcarrierSpacing=1.25, DuplexMode='FDD');
+            [waveform, ~, winfo] = srsLib.phy.upper.channel_processors.srsPRACHgenerator(carrier, prach);
+            prach.NPRACHSlot = winfo.NPRACHSlot;
+            [engineConfig, detectorConfig] = srsMEX.phy.srsPRACHDemodulator.getMEXConfig(carrier, prach, 1);
+            engineConfig.SequenceIndex = detectorConfig.SequenceIndex;
+            engineConfig.RestrictedSet = detectorConfig.RestrictedSet;
+            engineConfig.ZeroCorrelationZone = detectorConfig.ZeroCorrelationZone;
+            ofdmInfo = nrOFDMInfo(carrier);
+            engineConfig.SampleRate = ofdmInfo.SampleRate;
+            engineConfig.Nfft = ofdmInfo.Nfft;
+            engineConfig.PreambleIndex = prach.PreambleIndex;
+            engineConfig.NRxPorts = 2;
+            engineConfig.TimingOffsets = (0:9)/10;
+            engineConfig.TimeErrorTolerance = 1.04;
+            engineConfig.DelayProfile = 'TDLC300';
+            engineConfig.DelaySpread = 0;
+            engineConfig.MaximumDopplerShift = 100;
+            engineConfig.FrequencyOffset = 400;
+            engineConfig.DetectionTest = true;
+            engineConfig.Seed = 0;
+
+            thresholds = [1 1.5 2 4];
+            edges = 0:0.25:2;
+            engine = srsMEX.simulators.srsPRACHPERFEngine;
+            engineCounters = engine(engineConfig, waveform, [-10 -6], 50, 0, thresholds, edges);
+
+            for counters = engineCounters.'
+                obj.assertEqual(counters.NumOccasions, 50, 'Wrong number of occasions.');
+                obj.assertTrue(all(diff(counters.Detected) <= 0), 'Detections increase with the threshold.');
+                obj.assertTrue(all(counters.DetectedPerfect <= counters.Detected), 'Wrong number of perfect detections.');
+                obj.assertSize(counters.TimingErrorHistogram, [numel(edges) - 1, numel(thresholds)], ...
+                    'Wrong size of the timing error histogram.');
+                obj.assertTrue(all(sum(counters.TimingErrorHistogram, 1).' <= counters.Detected), ...
+                    'Wrong timing error histogram.');
+            end
+        end % of function testPRACHPERFengine(obj)
     end % of methods (Test, TestTags = {'mex code'})
+
+    methods (Access = private)
+        function sims = runEngineThreads(obj, simulatorName, properties, snrs, nFrames, getCounters)
+        %Runs a simulator with the native engine, first with one thread and then with four threads, and verifies
+        %   that the counters do not depend on the number of threads. The simulator objects are created from their
+        %   class name and configured with the name-value pairs in the cell array properties. The function handle
+        %   getCounters extracts the counters from a simulator object. The two simulator objects are returned in
+        %   the cell array sims, for further checks of their results.
+
+            numThreads = [1 4];
+            sims = cell(1, 2);
+            for iRun = 1:2
+                try
+                    pp = feval(simulatorName);
+                catch ME
+                    obj.assertFail(['Could not create a ', simulatorName, ' object because of exception: ', ...
+                        ME.message]);
+                end
+
+                obj.assertClass(pp, simulatorName, ['The created object is not a ', simulatorName, ' object.']);
+
+                for iProperty = 1:2:numel(properties)
+                    pp.(properties{iProperty}) = properties{iProperty + 1};
+                end
+                pp.SimulationEngineType = 'MEX';
+                pp.NumThreads = numThreads(iRun);
+
+                try
+                    pp(snrs, nFrames);
+                catch ME
+                    obj.assertFail([simulatorName, ' could not run because of exception: ', ...
+                        ME.message]);
+                end
+                sims{iRun} = pp;
+            end
+
+            obj.assertEqual(getCounters(sims{2}), getCounters(sims{1}), ...
+                'The counters depend on the number of threads.');
+        end % of function runEngineThreads(obj, simulatorName, properties, snrs, nFrames, getCounters)
+    end % of methods (Access = private)
 end % of classdef CheckSimulators < matlab.unittest.TestCase